@@ -14,6 +14,17 @@
     #define SUPPORT_UNICODE 1
 #endif
 
+/* Enable JIT on the architectures where it is well-tested, it is only used
+   for the regexes compiled with wxRE_JIT and PCRE falls back to the
+   interpreter if JIT compilation fails at run-time. Don't enable it under
+   Apple platforms where executable memory may require special entitlements. */
+#if !defined(__APPLE__) && \
+    (defined(__i386__) || defined(__x86_64__) || \
+     defined(_M_IX86) || defined(_M_X64) || \
+     defined(__aarch64__) || defined(_M_ARM64))
+    #define SUPPORT_JIT 1
+#endif
+
 /* src/config.h.  Generated from config.h.in by configure.  */
 /* src/config.h.in.  Generated from configure.ac by autoheader.  */
 
@@ -100,6 +100,7 @@ mark_as_advanced(wxBUILD_INSTALL_PDB)
 wx_option(wxUSE_STL "use standard C++ classes for everything" OFF)
 set(wxTHIRD_PARTY_LIBRARIES ${wxTHIRD_PARTY_LIBRARIES} wxUSE_STL "use C++ STL classes")
 wx_dependent_option(wxUSE_STD_CONTAINERS "use standard C++ container classes" ON "wxUSE_STL" OFF)
+wx_option(wxUSE_FLAT_HASH_MAP "use open addressing wxHashMap implementation" OFF)
 
 wx_option(wxUSE_UNICODE "compile with Unicode support (NOT RECOMMENDED to be turned off)")
 if(NOT WIN32)
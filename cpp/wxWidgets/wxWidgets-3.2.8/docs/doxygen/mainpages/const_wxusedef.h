@@ -121,6 +121,7 @@ library:
 @itemdef{wxUSE_FILEPICKERCTRL, Use wxFilePickerCtrl class.}
 @itemdef{wxUSE_FILESYSTEM, Use wxFileSystem and related classes.}
 @itemdef{wxUSE_FINDREPLDLG, Use wxFindReplaceDialog class.}
+@itemdef{wxUSE_FLAT_HASH_MAP, Use open addressing implementation of wxHashMap and wxHashSet classes, see wxHashMap documentation for more details.}
 @itemdef{wxUSE_FONTDLG, Use wxFontDialog class.}
 @itemdef{wxUSE_FONTENUM, Use wxFontEnumerator class.}
 @itemdef{wxUSE_FONTMAP, Use wxFontMapper class.}
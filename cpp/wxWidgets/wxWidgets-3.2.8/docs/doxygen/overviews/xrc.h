@@ -264,6 +264,10 @@ switches and options:
 @li -u (\--uncompressed): Do not compress XML files (C++ only).
 @li -g (\--gettext): Output underscore-wrapped strings that poEdit or gettext
     can scan. Outputs to stdout, or a file if -o is used.
+@li -b (\--binary): Store the XRC files in the binary format produced by
+    wxXmlDocument::SaveBinary() which is loaded faster than XML (since
+    wxWidgets 3.2.9). If used together with -p, the generated Python code
+    stores the data in bytes literals.
 @li -n (\--function) @<name@>: Specify C++ function name (use with -c).
 @li -o (\--output) @<filename@>: Specify the output file, such as resource.xrs
     or resource.cpp.
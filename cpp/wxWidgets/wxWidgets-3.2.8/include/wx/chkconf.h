@@ -330,6 +330,14 @@
 #   endif
 #endif /* !defined(wxUSE_STD_CONTAINERS_COMPATIBLY) */
 
+#ifndef wxUSE_FLAT_HASH_MAP
+#   ifdef wxABORT_ON_CONFIG_ERROR
+#       error "wxUSE_FLAT_HASH_MAP must be defined, please read comment near the top of this file."
+#   else
+#       define wxUSE_FLAT_HASH_MAP 0
+#   endif
+#endif /* !defined(wxUSE_FLAT_HASH_MAP) */
+
 #ifndef wxUSE_STD_STRING_CONV_IN_WXSTRING
 #   ifdef wxABORT_ON_CONFIG_ERROR
 #       error "wxUSE_STD_STRING_CONV_IN_WXSTRING must be defined, please read comment near the top of this file."
@@ -553,6 +553,28 @@ private:
 #define wxDV_ROW_LINES               0x0010     // alternating colour in rows
 #define wxDV_VARIABLE_LINE_HEIGHT    0x0020     // variable line height
 
+#if wxABI_VERSION >= 30209
+
+// Rows measured to compute the best width of the auto-sized columns, see
+// wxDataViewCtrlBase::SetBestColumnWidthMode().
+enum wxDataViewBestColumnWidthMode
+{
+    // First and last rows measured in a limited time and the visible rows.
+    wxDATAVIEW_BEST_WIDTH_DEFAULT,
+
+    // Only the rows visible when the width is computed.
+    wxDATAVIEW_BEST_WIDTH_VISIBLE,
+
+    // The visible rows and a fixed number of rows evenly spread over all of
+    // them.
+    wxDATAVIEW_BEST_WIDTH_SAMPLED,
+
+    // The visible rows immediately and all the other ones in idle time.
+    wxDATAVIEW_BEST_WIDTH_FULL
+};
+
+#endif // wxABI_VERSION >= 3.2.9
+
 class WXDLLIMPEXP_CORE wxDataViewCtrlBase: public wxSystemThemedControl<wxControl>
 {
 public:
@@ -717,6 +739,13 @@ public:
     int GetIndent() const
         { return m_indent; }
 
+#if wxABI_VERSION >= 30209
+    // Choose the rows used for computing the best width of the columns using
+    // wxCOL_WIDTH_AUTOSIZE. Only the generic version uses this.
+    void SetBestColumnWidthMode(wxDataViewBestColumnWidthMode mode);
+    wxDataViewBestColumnWidthMode GetBestColumnWidthMode() const;
+#endif // wxABI_VERSION >= 3.2.9
+
     // Current item is the one used by the keyboard navigation, it is the same
     // as the (unique) selected item in single selection mode so these
     // functions are mostly useful for controls with wxDV_MULTIPLE style.
@@ -32,6 +32,9 @@ enum wxDirFlags
     wxDIR_HIDDEN    = 0x0004,       // include hidden files
     wxDIR_DOTDOT    = 0x0008,       // include '.' and '..'
     wxDIR_NO_FOLLOW = 0x0010,       // don't dereference any symlink
+#if wxABI_VERSION >= 30209
+    wxDIR_PARALLEL  = 0x0020,       // Traverse() subdirectories in parallel
+#endif // wxABI_VERSION >= 3.2.9
 
     // by default, enumerate everything except '.' and '..'
     wxDIR_DEFAULT   = wxDIR_FILES | wxDIR_DIRS | wxDIR_HIDDEN
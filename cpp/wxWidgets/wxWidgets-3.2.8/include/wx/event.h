@@ -4050,10 +4050,14 @@ protected:
     typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
     DynamicEvents* m_dynamicEvents;
 
+    // Events posted by QueueEvent() and not processed yet: this is actually
+    // an object of a class private to event.cpp, allocated on demand, and
+    // not a real list, so it must not be used outside of it.
     wxList*             m_pendingEvents;
 
 #if wxUSE_THREADS
-    // critical section protecting m_pendingEvents
+    // critical section protecting m_pendingEvents pointer and serializing the
+    // processing of the events in it (but not adding new events to it)
     wxCriticalSection m_pendingEventsLock;
 #endif // wxUSE_THREADS
 
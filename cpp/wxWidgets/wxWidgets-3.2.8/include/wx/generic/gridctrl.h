@@ -55,6 +55,14 @@ protected:
     wxSize DoGetBestSize(const wxGridCellAttr& attr,
                          wxDC& dc,
                          const wxString& text);
+
+#if wxABI_VERSION >= 30209
+    // same as above, but can use the text extents cached by the grid
+    wxSize DoGetBestSize(const wxGrid& grid,
+                         const wxGridCellAttr& attr,
+                         wxDC& dc,
+                         const wxString& text);
+#endif // wxABI_VERSION >= 3.2.9
 };
 
 // the default renderer for the cells containing numeric (long) data
@@ -155,6 +155,21 @@ public:
     bool ScrollList( int dx, int dy );
     bool SortItems( wxListCtrlCompare fn, wxIntPtr data );
 
+#if wxABI_VERSION >= 30209
+    // Maintain an index of the item texts in the given column to speed up
+    // searching for the items in it in big controls.
+    void EnableSearchIndex( int col = 0, bool enable = true );
+    bool IsSearchIndexEnabled( int col = 0 ) const;
+
+    // Find an item by its text in the given column, like FindItem() does for
+    // the first one.
+    long FindItemInColumn( long start, int col, const wxString& str,
+                           bool partial = false );
+
+    // Sort the items by their text in the given column, case-insensitively.
+    bool SortItemsByText( int col, bool ascending = true );
+#endif // wxABI_VERSION >= 3.2.9
+
     // do we have a header window?
     bool HasHeader() const
         { return InReportView() && !HasFlag(wxLC_NO_HEADER); }
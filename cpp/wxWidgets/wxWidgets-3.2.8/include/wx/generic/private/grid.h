@@ -372,6 +372,76 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxGridCornerLabelWindow);
 };
 
+// ----------------------------------------------------------------------------
+// wxGridTextExtentCache: cache for the extents of the text drawn in the grid
+// ----------------------------------------------------------------------------
+
+WX_DECLARE_STRING_HASH_MAP(wxSize, wxGridTextExtentsMap);
+
+// Measuring text is relatively expensive in some ports, while the same
+// strings are typically drawn in many cells and are measured several times
+// when drawing each of them, so cache their extents while painting the grid
+// window.
+class wxGridTextExtentCache
+{
+public:
+    wxGridTextExtentCache() { m_dc = NULL; }
+
+    // Return the extent of the given single line of text drawn on the given DC
+    // using its current font.
+    //
+    // This uses the cache of the grid window if it is currently active for
+    // this DC or just measures the text directly otherwise.
+    static wxSize GetTextExtent(const wxGrid& grid,
+                                const wxDC& dc,
+                                const wxString& line);
+
+    // Forget all the previously cached extents.
+    void Clear() { m_fonts.clear(); }
+
+    // Objects of this class make the cache active for the given DC during
+    // their life time.
+    class Activator
+    {
+    public:
+        Activator(wxGridTextExtentCache& cache, const wxDC& dc)
+            : m_cache(cache),
+              m_dcOld(cache.m_dc)
+        {
+            m_cache.m_dc = &dc;
+        }
+
+        ~Activator()
+        {
+            m_cache.m_dc = m_dcOld;
+        }
+
+    private:
+        wxGridTextExtentCache& m_cache;
+        const wxDC* const m_dcOld;
+
+        wxDECLARE_NO_COPY_CLASS(Activator);
+    };
+
+private:
+    wxSize DoGetTextExtent(const wxDC& dc, const wxString& line);
+
+    // The extents are cached separately for each font, there are typically
+    // very few of them.
+    struct FontExtents
+    {
+        wxFont font;
+        wxGridTextExtentsMap extents;
+    };
+
+    wxVector<FontExtents> m_fonts;
+
+    // The DC this cache is currently active for, if any.
+    const wxDC* m_dc;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridTextExtentCache);
+};
+
 class WXDLLIMPEXP_ADV wxGridWindow : public wxGridSubwindow
 {
 public:
@@ -401,9 +471,13 @@ public:
 
     wxGridWindowType GetType() const { return m_type; }
 
+    wxGridTextExtentCache& GetTextExtentCache() { return m_textExtentCache; }
+
 private:
     const wxGridWindowType m_type;
 
+    wxGridTextExtentCache m_textExtentCache;
+
     void OnPaint( wxPaintEvent &event );
     void OnMouseWheel( wxMouseEvent& event );
     void OnMouseEvent( wxMouseEvent& event );
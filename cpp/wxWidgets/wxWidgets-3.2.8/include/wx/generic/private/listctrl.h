@@ -328,6 +328,100 @@ public:
     ~wxListLineDataArray() { Clear(); }
 };
 
+//-----------------------------------------------------------------------------
+//  wxListSearchIndex (internal)
+//-----------------------------------------------------------------------------
+
+// Index of the case-folded texts of the items in one column of a non-virtual
+// control, allowing to find items by their text without examining all of
+// them. It is built lazily on first use after being invalidated and then
+// updated when the items are inserted, deleted or their text changes.
+class wxListSearchIndex
+{
+public:
+    wxListSearchIndex() { m_valid = false; m_updates = 0; }
+    ~wxListSearchIndex() { Invalidate(); }
+
+    // Return the string as used for the keys of the index.
+    static wxString Fold(const wxString& s) { return s.Upper(); }
+
+    bool IsValid() const { return m_valid; }
+    void Invalidate();
+    void Build(const wxListLineDataArray& lines, int col);
+
+    // Must be called when the index is used for searching, see m_updates.
+    void OnUsed() { m_updates = 0; }
+
+    // These functions must only be called if the index is valid. They may
+    // invalidate it if it's being updated much more often than used.
+    void OnItemInserted(size_t row, const wxString& text);
+    void OnItemDeleted(size_t row, const wxString& text);
+    void OnItemChanged(size_t row,
+                       const wxString& textOld,
+                       const wxString& textNew);
+
+    // Update the index after reordering the items: the array contains the
+    // old rows of the items in their new order.
+    void OnItemsReordered(const wxVector<size_t>& rows);
+
+    // Return the first row at or after start whose folded text is equal to
+    // or, if partial is true, starts with the given folded string or -1.
+    size_t Find(size_t start, const wxString& folded, bool partial) const;
+
+    // Fill the array with all rows sorted by their texts, rows with the same
+    // text remaining in their original order.
+    void GetSortedRows(wxVector<size_t>& rows, bool ascending);
+
+private:
+    struct Entry
+    {
+        const wxString *key;
+        size_t row;
+    };
+
+    struct EntryLess
+    {
+        bool operator()(const Entry& e1, const Entry& e2) const
+        {
+            const int rc = e1.key->compare(*e2.key);
+            return rc < 0 || (rc == 0 && e1.row < e2.row);
+        }
+    };
+
+    // Return the position of the entry for the given row and folded text in
+    // m_entries or the position where it should be inserted.
+    size_t FindEntry(size_t row, const wxString& folded) const;
+
+    // Return the position of the entry for the given row in m_pending or -1.
+    size_t FindPending(size_t row) const;
+
+    // Add the entries from m_pending to m_entries.
+    void MergePending();
+
+    // Adjust the rows of all entries at or after the given one.
+    void ShiftRows(size_t row, int delta);
+
+    // Return false and invalidate the index if it was updated too many times
+    // without being used, as it's cheaper to rebuild it when it's needed
+    // again than to keep updating it in this case.
+    bool CanUpdate();
+
+    // Entries sorted by their keys and then by rows: we store pointers to the
+    // keys rather than the keys themselves to make moving them around cheap.
+    wxVector<Entry> m_entries;
+
+    // Entries for the appended items which are not in m_entries yet, as
+    // inserting them there one by one would take quadratic time.
+    wxVector<Entry> m_pending;
+
+    // Number of updates which took linear time since the index was last used.
+    unsigned m_updates;
+
+    bool m_valid;
+
+    wxDECLARE_NO_COPY_CLASS(wxListSearchIndex);
+};
+
 //-----------------------------------------------------------------------------
 //  wxListHeaderWindow (internal)
 //-----------------------------------------------------------------------------
@@ -713,6 +807,7 @@ public:
     void DeleteEverything();
     void EnsureVisible( long index );
     long FindItem( long start, const wxString& str, bool partial = false );
+    long FindItemInColumn( long start, int col, const wxString& str, bool partial );
     long FindItem( long start, wxUIntPtr data);
     long FindItem( const wxPoint& pt );
     long HitTest( int x, int y, int &flags ) const;
@@ -720,6 +815,10 @@ public:
     long InsertColumn( long col, const wxListItem &item );
     int GetItemWidthWithImage(wxListItem * item);
     void SortItems( wxListCtrlCompare fn, wxIntPtr data );
+    void SortItemsByText( int col, bool ascending );
+
+    void EnableSearchIndex( int col, bool enable );
+    bool IsSearchIndexEnabled( int col ) const;
 
     size_t GetItemCount() const;
     bool IsEmpty() const { return GetItemCount() == 0; }
@@ -894,6 +993,17 @@ protected:
     // find the first item starting with the given prefix after the given item
     size_t PrefixFindItem(size_t item, const wxString& prefix) const;
 
+    // get the search index for the given column, building it if necessary,
+    // or NULL if it's not enabled for this column
+    wxListSearchIndex *GetSearchIndex(int col) const;
+
+    // invalidate all search indices, e.g. after deleting all items
+    void InvalidateSearchIndices();
+
+    // reorder the lines, the array contains the old indices of the lines in
+    // their new order
+    void ReorderLines(const wxVector<size_t>& rows);
+
     // get the colour to be used for drawing the rules
     wxColour GetRuleColour() const
     {
@@ -957,6 +1067,10 @@ private:
     // rulers on empty rows
     bool m_extendRulesAndAlternateColour;
 
+    // the search indices of the columns, NULL for the columns without them
+    // and not necessarily containing elements for all the columns
+    wxVector<wxListSearchIndex*> m_searchIndices;
+
     wxDECLARE_EVENT_TABLE();
 
     friend class wxGenericListCtrl;
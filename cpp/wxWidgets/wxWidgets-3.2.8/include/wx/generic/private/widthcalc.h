@@ -111,6 +111,78 @@ public:
         }
     }
 
+    // Only measure the rows in [first, last) range, e.g. the visible ones.
+    void ComputeBestColumnWidthOfRows(size_t first, size_t last)
+    {
+        for ( size_t row = first; row < last; row++ )
+            UpdateWithRow(row);
+    }
+
+    // Measure the rows in [first_visible, last_visible) range and the given
+    // number of rows sampled from all the other ones: the rows are divided
+    // into this number of equal parts and one row is taken from each of them,
+    // at a different position in each part to avoid missing periodic data.
+    void
+    ComputeSampledColumnWidth(size_t count,
+                              size_t samples,
+                              size_t first_visible,
+                              size_t last_visible)
+    {
+        last_visible = wxMin(last_visible, count);
+        ComputeBestColumnWidthOfRows(first_visible, last_visible);
+
+        if ( count <= samples )
+        {
+            ComputeBestColumnWidthOfRows(0, first_visible);
+            ComputeBestColumnWidthOfRows(last_visible, count);
+            return;
+        }
+
+        // Use a simple LCG to choose the rows: we don't need good randomness
+        // here, but want to get the same result every time.
+        wxUint32 seed = 1;
+        for ( size_t n = 0; n < samples; n++ )
+        {
+            const size_t start = static_cast<size_t>(double(count)*n/samples);
+            const size_t end = static_cast<size_t>(double(count)*(n + 1)/samples);
+
+            seed = seed*1103515245u + 12345u;
+            const size_t row = start + (seed >> 8) % (end - start);
+            if ( row < first_visible || row >= last_visible )
+                UpdateWithRow(row);
+        }
+
+        wxLogTrace("items container",
+                   "determined best size from %zu sampled plus %zu visible "
+                   "items out of %zu total",
+                   samples, last_visible - first_visible, count);
+    }
+
+#if wxUSE_STOPWATCH
+    // Measure the rows starting from the given one until either all of them
+    // are measured or the given time (in ms) elapses, return the first row
+    // which wasn't measured, i.e. count if all of them were.
+    size_t
+    ComputeBestColumnWidthInTime(size_t first, size_t count, long maxTime)
+    {
+        // don't call wxStopWatch::Time() too often
+        static const unsigned CALC_CHECK_FREQ = 100;
+        wxStopWatch timer;
+
+        size_t row;
+        for ( row = first; row < count; row++ )
+        {
+            if ( (row - first) % CALC_CHECK_FREQ == CALC_CHECK_FREQ-1 &&
+                 timer.Time() > maxTime )
+                break;
+
+            UpdateWithRow(row);
+        }
+
+        return row;
+    }
+#endif // wxUSE_STOPWATCH
+
 private:
     const size_t m_column;
     int m_width;
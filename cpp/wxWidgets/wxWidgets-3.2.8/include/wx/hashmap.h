@@ -122,9 +122,9 @@ protected:
     }
 };
 
-#define _WX_DECLARE_HASHTABLE( VALUE_T, KEY_T, HASH_T, KEY_EX_T, KEY_EQ_T,\
-                               PTROPERATOR, CLASSNAME, CLASSEXP, \
-                               SHOULD_GROW, SHOULD_SHRINK ) \
+#define _WX_DECLARE_CHAINED_HASHTABLE( VALUE_T, KEY_T, HASH_T, KEY_EX_T, KEY_EQ_T,\
+                                       PTROPERATOR, CLASSNAME, CLASSEXP, \
+                                       SHOULD_GROW, SHOULD_SHRINK ) \
 CLASSEXP CLASSNAME : protected _wxHashTableBase2 \
 { \
 public: \
@@ -460,6 +460,605 @@ inline bool grow_lf70( size_t buckets, size_t items )
     return float(items)/float(buckets) >= 0.85f;
 }
 
+// ----------------------------------------------------------------------------
+// Open addressing hash table implementation, used by default instead of the
+// one above if wxUSE_FLAT_HASH_MAP is on.
+// ----------------------------------------------------------------------------
+
+// The elements are stored directly in a single array of slots and each slot
+// has a control byte, stored in a separate array, which is either empty,
+// deleted or contains 7 bits of the hash of the element stored in it. The
+// control bytes are examined by groups of 16 at once, using SIMD instructions
+// if available. This is the same approach as used by the "Swiss tables".
+//
+// Notice that, unlike with the other implementation, inserting elements into
+// the table can invalidate the pointers and references to the existing ones.
+
+#include <new>                  // for placement new
+#include <stdlib.h>             // for malloc() and free()
+#include <string.h>             // for memset() and memcpy()
+
+#ifdef wxHAS_RVALUE_REF
+    #include <utility>          // for std::move()
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define wxHASHTABLE_USE_SSE2
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__GNUC__)
+    #include <arm_neon.h>
+    #define wxHASHTABLE_USE_NEON
+#endif
+
+#if defined(_MSC_VER) && !defined(__GNUC__)
+    #include <intrin.h>         // for _BitScanForward()
+#endif
+
+// private
+class _wxFlatHashTableBase
+{
+protected:
+    enum
+    {
+        // Special control bytes values: both of them have the high bit set,
+        // while it's never set for the full slots.
+        Ctrl_Empty = 0x80,
+        Ctrl_Deleted = 0xfe,
+
+        // The number of control bytes examined at once.
+        GroupSize = 16
+    };
+
+    // Bit mask with the bits corresponding to the matching slots of a group
+    // set: there is one bit per slot for SSE2 and generic implementations,
+    // but four of them (of which only the highest one is used) for NEON.
+#ifdef wxHASHTABLE_USE_NEON
+    typedef wxUint64 GroupMask;
+#else
+    typedef unsigned GroupMask;
+#endif
+
+    _wxFlatHashTableBase()
+        : m_ctrl(NULL),
+          m_capacity(0),
+          m_items(0),
+          m_growthLeft(0)
+    {
+    }
+
+    // Mix the bits of the hash value returned by the hash functor, which can
+    // be quite bad (e.g. identity for integers), and split it into the part
+    // used for finding the position of the element and the 7 bits stored in
+    // the control bytes.
+    static wxUint64 MixHash( wxUint64 hash )
+    {
+        hash *= wxULL(0x9e3779b97f4a7c15);
+        return hash ^ ( hash >> 32 );
+    }
+    static size_t GetH1( wxUint64 hash ) { return static_cast<size_t>(hash); }
+    static unsigned char GetH2( wxUint64 hash )
+        { return static_cast<unsigned char>(hash >> 57); }
+
+    static bool IsFull( unsigned char ctrl ) { return ctrl < Ctrl_Empty; }
+
+#if defined(wxHASHTABLE_USE_SSE2)
+    static GroupMask MatchByte( const unsigned char* group, unsigned char b )
+    {
+        const __m128i ctrl = _mm_loadu_si128( (const __m128i*)group );
+        return static_cast<GroupMask>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8( ctrl, _mm_set1_epi8( static_cast<char>(b) ) ) ));
+    }
+    static GroupMask MatchFull( const unsigned char* group )
+    {
+        const __m128i ctrl = _mm_loadu_si128( (const __m128i*)group );
+        return static_cast<GroupMask>(~_mm_movemask_epi8( ctrl ) & 0xffff);
+    }
+    static GroupMask MatchEmptyOrDeleted( const unsigned char* group )
+    {
+        const __m128i ctrl = _mm_loadu_si128( (const __m128i*)group );
+        return static_cast<GroupMask>(_mm_movemask_epi8( ctrl ));
+    }
+#elif defined(wxHASHTABLE_USE_NEON)
+    static GroupMask NarrowMask( uint8x16_t eq )
+    {
+        const uint8x8_t
+            nibbles = vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 );
+        return vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 ) &
+                    wxULL(0x8888888888888888);
+    }
+    static GroupMask MatchByte( const unsigned char* group, unsigned char b )
+    {
+        return NarrowMask( vceqq_u8( vld1q_u8( group ), vdupq_n_u8( b ) ) );
+    }
+    static GroupMask MatchFull( const unsigned char* group )
+    {
+        return NarrowMask( vcltq_u8( vld1q_u8( group ),
+                                     vdupq_n_u8( Ctrl_Empty ) ) );
+    }
+    static GroupMask MatchEmptyOrDeleted( const unsigned char* group )
+    {
+        return NarrowMask( vcgeq_u8( vld1q_u8( group ),
+                                     vdupq_n_u8( Ctrl_Empty ) ) );
+    }
+#else // generic implementation
+    static GroupMask MatchByte( const unsigned char* group, unsigned char b )
+    {
+        GroupMask mask = 0;
+        for ( int n = 0; n < GroupSize; n++ )
+        {
+            if ( group[n] == b )
+                mask |= 1u << n;
+        }
+        return mask;
+    }
+    static GroupMask MatchFull( const unsigned char* group )
+    {
+        GroupMask mask = 0;
+        for ( int n = 0; n < GroupSize; n++ )
+        {
+            if ( IsFull( group[n] ) )
+                mask |= 1u << n;
+        }
+        return mask;
+    }
+    static GroupMask MatchEmptyOrDeleted( const unsigned char* group )
+    {
+        return ~MatchFull( group ) & 0xffff;
+    }
+#endif // SIMD implementations
+
+    static GroupMask MatchEmpty( const unsigned char* group )
+        { return MatchByte( group, Ctrl_Empty ); }
+
+    // Return the index of the first slot in the mask, which must be non-zero.
+    static size_t LowestBit( GroupMask mask )
+    {
+#if defined(wxHASHTABLE_USE_NEON)
+        return static_cast<size_t>(__builtin_ctzll( mask )) >> 2;
+#elif defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctz( mask ));
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward( &index, mask );
+        return index;
+#else
+        size_t index = 0;
+        while ( !(mask & 1) )
+        {
+            mask >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+    static GroupMask ClearLowestBit( GroupMask mask ) { return mask & (mask - 1); }
+
+    // Allocate memory for the given number of slots of the given size, which
+    // must be a power of 2, followed by the control bytes, and return the
+    // slots pointer. The control bytes are duplicated at the end, so that a
+    // group starting at any position can be loaded without wrapping around.
+    void* AllocTable( size_t capacity, size_t slotSize )
+    {
+        char* const table = (char*)malloc( capacity*slotSize +
+                                           capacity + GroupSize );
+        m_ctrl = (unsigned char*)table + capacity*slotSize;
+        m_capacity = capacity;
+        ResetCtrl();
+        return table;
+    }
+    static void FreeTable( void* table ) { free( table ); }
+
+    // Mark all slots as empty.
+    void ResetCtrl()
+    {
+        memset( m_ctrl, Ctrl_Empty, m_capacity + GroupSize );
+
+        // Keep the load factor under 7/8.
+        m_growthLeft = m_capacity - m_capacity/8 - m_items;
+    }
+
+    void SetCtrl( size_t pos, unsigned char ctrl )
+    {
+        m_ctrl[pos] = ctrl;
+        if ( pos < GroupSize )
+            m_ctrl[m_capacity + pos] = ctrl;
+    }
+
+    // Return the position of the first full slot at or after the given one or
+    // m_capacity if there are none.
+    size_t FindFullFrom( size_t pos ) const
+    {
+        for ( ; pos < m_capacity; pos += GroupSize )
+        {
+            const GroupMask full = MatchFull( m_ctrl + pos );
+            if ( full )
+            {
+                pos += LowestBit( full );
+                return pos < m_capacity ? pos : m_capacity;
+            }
+        }
+
+        return m_capacity;
+    }
+
+    // Return the position of the first empty or deleted slot in the probe
+    // sequence for the given hash: there is always at least one.
+    size_t FindInsertPos( size_t h1 ) const
+    {
+        const size_t mask = m_capacity - 1;
+        size_t pos = h1 & mask;
+        for ( size_t step = GroupSize; ; step += GroupSize )
+        {
+            const GroupMask avail = MatchEmptyOrDeleted( m_ctrl + pos );
+            if ( avail )
+                return ( pos + LowestBit( avail ) ) & mask;
+
+            pos = ( pos + step ) & mask;
+        }
+    }
+
+    unsigned char* m_ctrl;
+    size_t m_capacity;
+    size_t m_items;
+    size_t m_growthLeft;
+};
+
+// Placement new can't be used directly in the macro below as "new" may be
+// redefined as WXDEBUG_NEW by the time it is expanded, so use these helpers
+// defined with the original "new" instead, as wxAny does.
+#ifdef WXDEBUG_NEW
+    #undef new
+#endif
+
+template <typename T, typename A>
+inline T* wxFlatHashTableConstruct(void* place, const A& arg)
+{
+    return ::new(place) T(arg);
+}
+
+template <typename T>
+inline T* wxFlatHashTableMoveConstruct(void* place, T& src)
+{
+#ifdef wxHAS_RVALUE_REF
+    return ::new(place) T(std::move(src));
+#else
+    return ::new(place) T(src);
+#endif
+}
+
+#ifdef WXDEBUG_NEW
+    #define new WXDEBUG_NEW
+#endif
+
+#define _WX_DECLARE_FLAT_HASHTABLE( VALUE_T, KEY_T, HASH_T, KEY_EX_T, KEY_EQ_T,\
+                                    PTROPERATOR, CLASSNAME, CLASSEXP, \
+                                    SHOULD_GROW, SHOULD_SHRINK ) \
+CLASSEXP CLASSNAME : protected _wxFlatHashTableBase \
+{ \
+public: \
+    typedef KEY_T key_type; \
+    typedef VALUE_T value_type; \
+    typedef HASH_T hasher; \
+    typedef KEY_EQ_T key_equal; \
+ \
+    typedef size_t size_type; \
+    typedef ptrdiff_t difference_type; \
+    typedef value_type* pointer; \
+    typedef const value_type* const_pointer; \
+    typedef value_type& reference; \
+    typedef const value_type& const_reference; \
+    /* should these be protected? */ \
+    typedef const KEY_T const_key_type; \
+    typedef const VALUE_T const_mapped_type; \
+public: \
+    typedef KEY_EX_T key_extractor; \
+    typedef CLASSNAME Self; \
+ \
+    struct Node \
+    { \
+    public: \
+        Node( const value_type& value ) \
+            : m_value( value ) {} \
+ \
+        value_type m_value; \
+    }; \
+ \
+protected: \
+    Node* m_slots; \
+    hasher m_hasher; \
+    key_equal m_equals; \
+    key_extractor m_getKey; \
+ \
+public: \
+    /*                  */ \
+    /* forward iterator */ \
+    /*                  */ \
+    CLASSEXP Iterator \
+    { \
+    public: \
+        Node* m_node; \
+        Self* m_ht; \
+ \
+        Iterator() : m_node(NULL), m_ht(NULL) {} \
+        Iterator( Node* node, const Self* ht ) \
+            : m_node(node), m_ht(const_cast<Self*>(ht)) {} \
+        bool operator ==( const Iterator& it ) const \
+            { return m_node == it.m_node; } \
+        bool operator !=( const Iterator& it ) const \
+            { return m_node != it.m_node; } \
+    protected: \
+        void PlusPlus() \
+        { \
+            m_node = m_ht->GetFirstNodeFrom( \
+                        static_cast<size_t>(m_node - m_ht->m_slots) + 1 ); \
+        } \
+    }; \
+    friend class Iterator; \
+ \
+public: \
+    CLASSEXP iterator : public Iterator \
+    { \
+    public: \
+        iterator() : Iterator() {} \
+        iterator( Node* node, Self* ht ) : Iterator( node, ht ) {} \
+        iterator& operator++() { PlusPlus(); return *this; } \
+        iterator operator++(int) { iterator it=*this;PlusPlus();return it; } \
+        reference operator *() const { return m_node->m_value; } \
+        PTROPERATOR(pointer) \
+    }; \
+ \
+    CLASSEXP const_iterator : public Iterator \
+    { \
+    public: \
+        const_iterator() : Iterator() {} \
+        const_iterator(iterator i) : Iterator(i) {} \
+        const_iterator( Node* node, const Self* ht ) \
+            : Iterator(node, const_cast<Self*>(ht)) {} \
+        const_iterator& operator++() { PlusPlus();return *this; } \
+        const_iterator operator++(int) { const_iterator it=*this;PlusPlus();return it; } \
+        const_reference operator *() const { return m_node->m_value; } \
+        PTROPERATOR(const_pointer) \
+    }; \
+ \
+    /* the size hint is not used: the table is allocated on the first */ \
+    /* insertion and grows as needed after it */ \
+    CLASSNAME( size_type WXUNUSED(sz) = 10, const hasher& hfun = hasher(), \
+               const key_equal& k_eq = key_equal(), \
+               const key_extractor& k_ex = key_extractor() ) \
+        : m_slots( NULL ), \
+          m_hasher( hfun ), \
+          m_equals( k_eq ), \
+          m_getKey( k_ex ) \
+    { \
+    } \
+ \
+    CLASSNAME( const Self& ht ) \
+        : _wxFlatHashTableBase(), \
+          m_slots( NULL ), \
+          m_hasher( ht.m_hasher ), \
+          m_equals( ht.m_equals ), \
+          m_getKey( ht.m_getKey ) \
+    { \
+        HashCopy( ht ); \
+    } \
+ \
+    const Self& operator=( const Self& ht ) \
+    { \
+         if (&ht != this) \
+         { \
+             clear(); \
+             m_hasher = ht.m_hasher; \
+             m_equals = ht.m_equals; \
+             m_getKey = ht.m_getKey; \
+             HashCopy( ht ); \
+         } \
+         return *this; \
+    } \
+ \
+    ~CLASSNAME() \
+    { \
+        clear(); \
+ \
+        FreeTable(m_slots); \
+    } \
+ \
+    hasher hash_funct() { return m_hasher; } \
+    key_equal key_eq() { return m_equals; } \
+ \
+    /* removes all elements from the hash table, but does not */ \
+    /* shrink it ( perhaps it should ) */ \
+    void clear() \
+    { \
+        if ( !m_items ) \
+            return; \
+ \
+        for ( size_t n = 0; n < m_capacity; ++n ) \
+        { \
+            if ( IsFull( m_ctrl[n] ) ) \
+                m_slots[n].~Node(); \
+        } \
+        m_items = 0; \
+        ResetCtrl(); \
+    } \
+ \
+    size_type size() const { return m_items; } \
+    size_type max_size() const { return size_type(-1); } \
+    bool empty() const { return size() == 0; } \
+ \
+    const_iterator end() const { return const_iterator(NULL, this); } \
+    iterator end() { return iterator(NULL, this); } \
+    const_iterator begin() const \
+        { return const_iterator(GetFirstNodeFrom(0), this); } \
+    iterator begin() \
+        { return iterator(GetFirstNodeFrom(0), this); } \
+ \
+    size_type erase( const const_key_type& key ) \
+    { \
+        Node* const node = GetNode( key ); \
+        if( !node ) \
+            return 0; \
+ \
+        node->~Node(); \
+        --m_items; \
+        if ( m_items ) \
+        { \
+            /* the slot can't be just marked as empty as it could be in */ \
+            /* the middle of a probe sequence for another element */ \
+            SetCtrl( static_cast<size_t>(node - m_slots), Ctrl_Deleted ); \
+        } \
+        else \
+        { \
+            /* this is cheap and gets rid of all deleted slots */ \
+            ResetCtrl(); \
+        } \
+        return 1; \
+    } \
+ \
+protected: \
+    Node* GetFirstNodeFrom( size_t pos ) const \
+    { \
+        pos = FindFullFrom( pos ); \
+        return pos < m_capacity ? m_slots + pos : NULL; \
+    } \
+ \
+    wxUint64 GetHash( const const_key_type& key ) const \
+    { \
+        return MixHash( m_hasher( key ) ); \
+    } \
+ \
+    Node* GetOrCreateNode( const value_type& value, bool& created ) \
+    { \
+        const const_key_type& key = m_getKey( value ); \
+        const wxUint64 hash = GetHash( key ); \
+        Node* node = FindNode( key, hash ); \
+        if ( node ) \
+        { \
+            created = false; \
+            return node; \
+        } \
+        created = true; \
+        return CreateNode( value, hash ); \
+    } \
+    Node* CreateNode( const value_type& value, wxUint64 hash ) \
+    { \
+        if ( !m_growthLeft ) \
+            Rehash(); \
+ \
+        const size_t pos = FindInsertPos( GetH1( hash ) ); \
+        Node* const node = wxFlatHashTableConstruct<Node>( m_slots + pos, value ); \
+ \
+        /* must be after the node is constructed in case it throws */ \
+        if ( m_ctrl[pos] == Ctrl_Empty ) \
+            --m_growthLeft; \
+        SetCtrl( pos, GetH2( hash ) ); \
+        ++m_items; \
+ \
+        return node; \
+    } \
+    void CreateNode( const value_type& value ) \
+    { \
+        CreateNode( value, GetHash( m_getKey( value ) ) ); \
+    } \
+ \
+    /* returns NULL if not found */ \
+    Node* FindNode( const const_key_type& key, wxUint64 hash ) const \
+    { \
+        if ( !m_items ) \
+            return NULL; \
+ \
+        const size_t mask = m_capacity - 1; \
+        const unsigned char h2 = GetH2( hash ); \
+        size_t pos = GetH1( hash ) & mask; \
+        for ( size_t step = GroupSize; ; step += GroupSize ) \
+        { \
+            const unsigned char* const group = m_ctrl + pos; \
+            for ( GroupMask match = MatchByte( group, h2 ); \
+                  match; \
+                  match = ClearLowestBit( match ) ) \
+            { \
+                Node* const \
+                    node = m_slots + ( ( pos + LowestBit( match ) ) & mask ); \
+                if( m_equals( m_getKey( node->m_value ), key ) ) \
+                    return node; \
+            } \
+ \
+            if ( MatchEmpty( group ) ) \
+                return NULL; \
+ \
+            pos = ( pos + step ) & mask; \
+        } \
+    } \
+ \
+    /* returns NULL if not found */ \
+    Node* GetNode( const const_key_type& key ) const \
+    { \
+        return FindNode( key, GetHash( key ) ); \
+    } \
+ \
+    /* called when there is no more space for new elements */ \
+    void Rehash() \
+    { \
+        if ( !m_capacity ) \
+            ResizeTable( GroupSize ); \
+        else if ( m_items < m_capacity*7/16 ) \
+            ResizeTable( m_capacity ); /* just get rid of deleted slots */ \
+        else \
+            ResizeTable( m_capacity*2 ); \
+    } \
+ \
+    void ResizeTable( size_t newCapacity ) \
+    { \
+        Node* const srcSlots = m_slots; \
+        const unsigned char* const srcCtrl = m_ctrl; \
+        const size_t srcCapacity = m_capacity; \
+ \
+        m_slots = static_cast<Node*>( AllocTable( newCapacity, sizeof(Node) ) ); \
+        for ( size_t n = 0; n < srcCapacity; ++n ) \
+        { \
+            if ( !IsFull( srcCtrl[n] ) ) \
+                continue; \
+ \
+            Node* const src = srcSlots + n; \
+            const wxUint64 hash = GetHash( m_getKey( src->m_value ) ); \
+            const size_t pos = FindInsertPos( GetH1( hash ) ); \
+            wxFlatHashTableMoveConstruct( m_slots + pos, *src ); \
+            src->~Node(); \
+            SetCtrl( pos, GetH2( hash ) ); \
+        } \
+ \
+        FreeTable( srcSlots ); \
+    } \
+ \
+    /* this must be called _after_ the table has been cleared */ \
+    void HashCopy( const Self& ht ) \
+    { \
+        if ( !ht.m_items ) \
+            return; \
+ \
+        if ( m_capacity != ht.m_capacity ) \
+        { \
+            FreeTable( m_slots ); \
+            m_slots = static_cast<Node*>( AllocTable( ht.m_capacity, sizeof(Node) ) ); \
+        } \
+ \
+        memcpy( m_ctrl, ht.m_ctrl, m_capacity + GroupSize ); \
+        for ( size_t n = 0; n < m_capacity; ++n ) \
+        { \
+            if ( IsFull( m_ctrl[n] ) ) \
+                wxFlatHashTableConstruct<Node>( m_slots + n, ht.m_slots[n] ); \
+        } \
+        m_items = ht.m_items; \
+        m_growthLeft = ht.m_growthLeft; \
+    } \
+};
+
+#if wxUSE_FLAT_HASH_MAP
+    #define _WX_DECLARE_HASHTABLE _WX_DECLARE_FLAT_HASHTABLE
+#else
+    #define _WX_DECLARE_HASHTABLE _WX_DECLARE_CHAINED_HASHTABLE
+#endif
+
 #endif // various hash map implementations
 
 // ----------------------------------------------------------------------------
@@ -605,10 +1204,12 @@ struct WXDLLIMPEXP_BASE wxStringEqual
     pointer operator ->() const { return &(m_node->m_value); }
 #define wxPTROP_NOP(pointer)
 
-#define _WX_DECLARE_HASH_MAP( KEY_T, VALUE_T, HASH_T, KEY_EQ_T, CLASSNAME, CLASSEXP ) \
+// HASHTABLE is the name of the macro defining the hash table class used by
+// the map, normally _WX_DECLARE_HASHTABLE
+#define _WX_DECLARE_HASH_MAP_WITH_TABLE( HASHTABLE, KEY_T, VALUE_T, HASH_T, KEY_EQ_T, CLASSNAME, CLASSEXP ) \
 _WX_DECLARE_PAIR( KEY_T, VALUE_T, CLASSNAME##_wxImplementation_Pair, CLASSEXP ) \
 _WX_DECLARE_HASH_MAP_KEY_EX( KEY_T, CLASSNAME##_wxImplementation_Pair, CLASSNAME##_wxImplementation_KeyEx, CLASSEXP ) \
-_WX_DECLARE_HASHTABLE( CLASSNAME##_wxImplementation_Pair, KEY_T, HASH_T, \
+HASHTABLE( CLASSNAME##_wxImplementation_Pair, KEY_T, HASH_T, \
     CLASSNAME##_wxImplementation_KeyEx, KEY_EQ_T, wxPTROP_NORMAL, \
     CLASSNAME##_wxImplementation_HashTable, CLASSEXP, grow_lf70, never_shrink ) \
 CLASSEXP CLASSNAME:public CLASSNAME##_wxImplementation_HashTable \
@@ -660,6 +1261,10 @@ public: \
     } \
 }
 
+#define _WX_DECLARE_HASH_MAP( KEY_T, VALUE_T, HASH_T, KEY_EQ_T, CLASSNAME, CLASSEXP ) \
+    _WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_HASHTABLE, KEY_T, VALUE_T, \
+                                     HASH_T, KEY_EQ_T, CLASSNAME, CLASSEXP )
+
 #endif // wxNEEDS_WX_HASH_MAP
 
 // these macros are to be used in the user code
@@ -424,6 +424,11 @@ class WXDLLIMPEXP_HTML wxHtmlWordCell : public wxHtmlCell
 {
 public:
     wxHtmlWordCell(const wxString& word, const wxDC& dc);
+#if wxABI_VERSION >= 30209
+    // create the cell for a word whose extent is already known
+    wxHtmlWordCell(const wxString& word,
+                   wxCoord width, wxCoord height, wxCoord descent);
+#endif // wxABI_VERSION >= 3.2.9
     void Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
               wxHtmlRenderingInfo& info) wxOVERRIDE;
     virtual wxCursor GetMouseCursor(wxHtmlWindowInterface *window) const wxOVERRIDE;
@@ -502,6 +507,14 @@ public:
     // with it to attach it elsewhere).
     void Detach(wxHtmlCell *cell);
 
+#if wxABI_VERSION >= 30209
+    // Discards the cached layout of this container and of all its parents,
+    // so that the next call to Layout() really lays them out again. This is
+    // done automatically when inserting or detaching cells, but must be
+    // called after changing the children of a container in any other way.
+    void InvalidateLayout();
+#endif // wxABI_VERSION >= 3.2.9
+
     // sets horizontal/vertical alignment
     void SetAlignHor(int al) {m_AlignHor = al; m_LastLayout = -1;}
     int GetAlignHor() const {return m_AlignHor;}
@@ -591,7 +604,7 @@ protected:
             // borders color of this container
     int m_LastLayout;
             // if != -1 then call to Layout may be no-op
-            // if previous call to Layout has same argument
+            // if previous call to Layout resulted in the same width
     int m_MaxTotalWidth;
             // Maximum possible length if ignoring line wrap
 
@@ -46,6 +46,15 @@ public:
     virtual void DoneParser() wxOVERRIDE;
     virtual wxObject* GetProduct() wxOVERRIDE;
 
+#if wxABI_VERSION >= 30209
+    // Parses the given source as if it were appended to the source passed to
+    // the last call to Parse() and adds the resulting cells to the product
+    // returned by it. Returns false, without changing anything, if this can't
+    // be done and the entire source must be parsed again instead.
+    bool AppendToProduct(const wxString& source,
+                         wxHtmlContainerCell *product);
+#endif // wxABI_VERSION >= 3.2.9
+
     virtual wxFSFile *OpenURL(wxHtmlURLType type, const wxString& url) const wxOVERRIDE;
 
     // Set's the DC used for parsing. If SetDC() is not called,
@@ -184,6 +184,83 @@ private:
     wxDECLARE_CLASS(wxImageHandler);
 };
 
+#if wxABI_VERSION >= 30209 && wxUSE_STREAMS
+
+//-----------------------------------------------------------------------------
+// wxImageRowSink: receives the rows decoded by wxImage::LoadRows()
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageRowSink
+{
+public:
+    wxImageRowSink() { }
+    virtual ~wxImageRowSink() { }
+
+    // called once before the first row with the size of the image being
+    // decoded, which is smaller than the original one when scaling it down,
+    // return false to cancel decoding
+    virtual bool Begin(int WXUNUSED(width), int WXUNUSED(height),
+                       bool WXUNUSED(hasAlpha))
+        { return true; }
+
+    // called for every row, from top to bottom, with its RGB data and alpha
+    // values or NULL if the image has no alpha, return false to stop decoding
+    // the rest of the image
+    virtual bool ProcessRow(int y,
+                            const unsigned char* data,
+                            const unsigned char* alpha) = 0;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(wxImageRowSink);
+};
+
+//-----------------------------------------------------------------------------
+// wxImageBufferRowSink: stores the decoded rows in caller-provided buffers
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageBufferRowSink : public wxImageRowSink
+{
+public:
+    // the data buffer must be big enough for height rows of stride bytes
+    // each, where stride is 3*width by default, images bigger than
+    // width*height are not decoded at all
+    wxImageBufferRowSink(unsigned char* data, int width, int height,
+                         int stride = 0);
+
+    // also store the alpha values in the given buffer, with the rows of
+    // stride (width by default) bytes each, filling it with opaque values if
+    // the image doesn't have alpha
+    void SetAlphaBuffer(unsigned char* alpha, int stride = 0);
+
+    // get the size of the decoded image, valid once decoding started
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    bool HasAlpha() const { return m_hasAlpha; }
+
+    // get the number of rows stored in the buffer so far
+    int GetRowsCount() const { return m_rows; }
+
+    virtual bool Begin(int width, int height, bool hasAlpha) wxOVERRIDE;
+    virtual bool ProcessRow(int y,
+                            const unsigned char* data,
+                            const unsigned char* alpha) wxOVERRIDE;
+
+private:
+    unsigned char* const m_data;
+    unsigned char* m_alpha;
+    const int m_maxWidth,
+              m_maxHeight,
+              m_stride;
+    int m_alphaStride;
+
+    int m_width,
+        m_height,
+        m_rows;
+    bool m_hasAlpha;
+};
+
+#endif // wxABI_VERSION >= 3.2.9 && wxUSE_STREAMS
+
 //-----------------------------------------------------------------------------
 // wxImageHistogram
 //-----------------------------------------------------------------------------
@@ -370,6 +447,13 @@ public:
     wxImage ResampleBilinear(int width, int height) const;
     wxImage ResampleBicubic(int width, int height) const;
 
+#if wxABI_VERSION >= 30209
+    // maximal number of threads used by Scale() for the filtering resampling
+    // methods, 0 (default) means to use all CPUs and 1 disables threading
+    static void SetMaxResampleThreads(int numThreads);
+    static int GetMaxResampleThreads();
+#endif // wxABI_VERSION >= 3.2.9
+
     // blur the image according to the specified pixel radius
     wxImage Blur(int radius) const;
     wxImage BlurHorizontal(int radius) const;
@@ -481,6 +565,15 @@ public:
     virtual bool LoadFile( wxInputStream& stream, const wxString& mimetype, int index = -1 );
 #endif
 
+#if wxABI_VERSION >= 30209 && wxUSE_STREAMS
+    // decode the image row by row without creating wxImage for it, scaling
+    // it down by the given factor (1, 2, 4 or 8) at the same time
+    static bool LoadRows( wxInputStream& stream, wxImageRowSink& sink,
+                          wxBitmapType type = wxBITMAP_TYPE_ANY, int scale = 1 );
+    static bool LoadRows( const wxString& name, wxImageRowSink& sink,
+                          wxBitmapType type = wxBITMAP_TYPE_ANY, int scale = 1 );
+#endif // wxABI_VERSION >= 3.2.9 && wxUSE_STREAMS
+
     virtual bool SaveFile( const wxString& name ) const;
     virtual bool SaveFile( const wxString& name, wxBitmapType type ) const;
     virtual bool SaveFile( const wxString& name, const wxString& mimetype ) const;
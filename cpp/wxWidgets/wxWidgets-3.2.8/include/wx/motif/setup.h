@@ -350,6 +350,19 @@
 // build and/or the existing code is a concern.
 #define wxUSE_STD_CONTAINERS 0
 
+// Use open addressing implementation of wxHashMap and wxHashSet classes which
+// stores all the elements in a single array instead of allocating a separate
+// node for each of them. This is faster and uses less memory, but, unlike the
+// default implementation and the standard containers, doesn't keep the
+// pointers and references to the elements valid when inserting new ones.
+// This option has no effect if wxUSE_STD_CONTAINERS is on.
+//
+// Default is 0 for compatibility reasons.
+//
+// Recommended setting: 1 if the code using these classes doesn't rely on the
+// stability of the references to their elements.
+#define wxUSE_FLAT_HASH_MAP 0
+
 // Use standard C++ streams if 1 instead of wx streams in some places. If
 // disabled, wx streams are used everywhere and wxWidgets doesn't depend on the
 // standard streams library.
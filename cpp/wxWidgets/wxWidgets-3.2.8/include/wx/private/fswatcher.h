@@ -96,6 +96,26 @@ public:
         return ret;
     }
 
+    // Add a watch for the given canonical path to the associated watcher or
+    // just increment its reference count if it's already watched.
+    bool AddWatch(const wxString& path,
+                  int events,
+                  wxFSWPathType type,
+                  const wxString& filespec = wxString());
+
+    // Decrement the reference count of the watch for the given canonical path
+    // and remove it when it reaches zero.
+    bool RemoveWatch(const wxString& path);
+
+    // Add (or remove) tree watches for the directory with the given canonical
+    // path and all directories under it. Unlike adding them one by one, this
+    // doesn't need to canonicalize the path of each of them.
+    bool AddTree(const wxString& path,
+                 int events,
+                 const wxString& filespec,
+                 int dirFlags);
+    bool RemoveTree(const wxString& path, int dirFlags);
+
     // Check whether any filespec matches the file's ext (if present)
     bool MatchesFilespec(const wxFileName& fn, const wxString& filespec) const
     {
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/imagerows.h
+// Purpose:     Row by row decoding functions used by wxImage::LoadRows()
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IMAGEROWS_H_
+#define _WX_PRIVATE_IMAGEROWS_H_
+
+#include "wx/image.h"
+
+#if wxUSE_STREAMS
+
+// These functions decode the image from the stream, scaled down by the given
+// factor which must be one of 1, 2, 4 or 8, passing its rows to the sink.
+//
+// They return true if the image was successfully decoded or if decoding was
+// stopped by wxImageRowSink::ProcessRow() returning false and false if an
+// error occurred or if wxImageRowSink::Begin() returned false.
+
+#if wxUSE_LIBPNG
+bool wxPNGLoadRows(wxInputStream& stream, wxImageRowSink& sink,
+                   int scale, bool verbose);
+#endif // wxUSE_LIBPNG
+
+#if wxUSE_LIBJPEG
+bool wxJPEGLoadRows(wxInputStream& stream, wxImageRowSink& sink,
+                    int scale, bool verbose);
+#endif // wxUSE_LIBJPEG
+
+#endif // wxUSE_STREAMS
+
+#endif // _WX_PRIVATE_IMAGEROWS_H_
@@ -52,6 +52,14 @@ public:
     wxLocaleUntranslatedStrings untranslatedStrings;
 #endif
 
+#if wxUSE_REGEX
+    // The stack used by PCRE JIT for the regexes compiled with wxRE_JIT in
+    // this thread, allocated on first use or NULL.
+    void *regexJITStack;
+#endif
+
+    ~wxThreadSpecificInfo();
+
 #if wxUSE_THREADS
     // Cleans up storage for the current thread. Should be called when a thread
     // is being destroyed. If it's not called, the only bad thing that happens
@@ -60,7 +68,12 @@ public:
 #endif
 
 private:
-    wxThreadSpecificInfo() : logger(NULL), loggingDisabled(false) {}
+    wxThreadSpecificInfo() : logger(NULL), loggingDisabled(false)
+    {
+#if wxUSE_REGEX
+        regexJITStack = NULL;
+#endif
+    }
 };
 
 #define wxThreadInfo wxThreadSpecificInfo::Get()
@@ -69,6 +69,27 @@ public:
 
     wxWebRequest::Storage GetStorage() const { return m_storage; }
 
+    void SetStorageStream(wxScopedPtr<wxOutputStream>& stream);
+
+    wxOutputStream* GetStorageStream() const { return m_storageStream.get(); }
+
+    // Called by wxWebSession when creating the request.
+    void SetURL(const wxString& url) { m_url = url; }
+
+    const wxString& GetURL() const { return m_url; }
+
+    // Called by wxWebRequest before calling Start() to add the conditional
+    // request headers if the response is cached by the session.
+    void PrepareCache();
+
+    // Returns the path of the cache entry, without extension, if the response
+    // to this request should be cached or empty string otherwise.
+    const wxString& GetCachePath() const { return m_cachePath; }
+
+    // Returns true if the request was sent with the headers allowing the
+    // server to reply with "304 Not Modified" to it.
+    bool IsRevalidatingCache() const { return m_cacheRevalidating; }
+
     // Precondition for this method checked by caller: current state is idle.
     virtual void Start() = 0;
 
@@ -121,6 +142,7 @@ protected:
     wxWebRequestHeaderMap m_headers;
     wxFileOffset m_dataSize;
     wxScopedPtr<wxInputStream> m_dataStream;
+    wxScopedPtr<wxOutputStream> m_storageStream;
     bool m_peerVerifyDisabled;
 
     wxWebRequestImpl(wxWebSession& session,
@@ -144,6 +166,9 @@ private:
     wxWebRequest::State m_state;
     wxFileOffset m_bytesReceived;
     wxCharBuffer m_dataText;
+    wxString m_url;
+    wxString m_cachePath;
+    bool m_cacheRevalidating;
 
     // Initially false, set to true after the first call to Cancel().
     bool m_cancelled;
@@ -192,7 +217,13 @@ protected:
 
     void* GetDataBuffer(size_t sizeNeeded);
 
-    void ReportDataReceived(size_t sizeReceived);
+    // Returns false if the data couldn't be stored, the request shouldn't
+    // receive any more data then and will fail when it completes.
+    bool ReportDataReceived(size_t sizeReceived);
+
+    // Returns the message describing the error which happened when storing
+    // the data or empty string if none did.
+    const wxString& GetStorageError() const { return m_storageError; }
 
     // This function can optionally be called to preallocate the read buffer,
     // if the total amount of data to be downloaded is known in advance.
@@ -203,10 +234,32 @@ private:
     friend class wxWebRequestImpl;
     void Finalize();
 
+    // Called by wxWebRequestImpl before setting the final state: stores the
+    // response in the cache or, for "304 Not Modified" response, uses the
+    // data from the cache as the response data.
+    void FinalizeCache();
+
+    // Store the data accumulated in m_readBuffer according to the request
+    // storage type.
+    bool StoreData();
+
+    // Write the given data to the temporary cache file, if we use one.
+    void WriteToCache(const void* data, size_t size);
+
     wxMemoryBuffer m_readBuffer;
     mutable wxFFile m_file;
     mutable wxScopedPtr<wxInputStream> m_stream;
 
+    // Temporary file used for the cache entry while receiving the data and
+    // the number of bytes written to it.
+    wxFFile m_cacheFile;
+    wxFileOffset m_cacheSize;
+
+    // Set to true after checking whether the response should be cached.
+    bool m_cacheChecked;
+
+    wxString m_storageError;
+
     wxDECLARE_NO_COPY_CLASS(wxWebResponseImpl);
 };
 
@@ -248,6 +301,10 @@ public:
 
     wxString GetTempDir() const;
 
+    void SetCacheDir(const wxString& dir) { m_cacheDir = dir; }
+
+    const wxString& GetCacheDir() const { return m_cacheDir; }
+
     const wxWebRequestHeaderMap& GetHeaders() const { return m_headers; }
 
     virtual wxWebSessionHandle GetNativeHandle() const = 0;
@@ -261,6 +318,7 @@ private:
 
     wxWebRequestHeaderMap m_headers;
     wxString m_tempDir;
+    wxString m_cacheDir;
 
     wxDECLARE_NO_COPY_CLASS(wxWebSessionImpl);
 };
@@ -49,6 +49,16 @@ enum
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
 
+#if wxABI_VERSION >= 30209
+// additional flags for regex compilation
+enum
+{
+    // compile the regex into machine code, if supported by the regex library,
+    // to speed up matching it
+    wxRE_JIT      = 256
+};
+#endif // wxABI_VERSION >= 3.2.9
+
 // flags for regex matching: these can be used with Matches()
 //
 // these flags are mainly useful when doing several matches in a long string,
@@ -102,6 +112,13 @@ public:
     bool Matches(const wxChar *text, int flags, size_t len) const
         { return Matches(wxString(text, len), flags); }
 
+#if wxABI_VERSION >= 30209
+    // matches the precompiled regular expression against UTF-8 text of the
+    // given length without converting it to wxString first, the offsets
+    // returned by GetMatch() after calling this function are in bytes
+    bool MatchesUTF8(const char *text, size_t len, int flags = 0) const;
+#endif // wxABI_VERSION >= 3.2.9
+
     // get the start index and the length of the match of the expression
     // (index 0) or a bracketed subexpression (index != 0)
     //
@@ -3794,6 +3794,27 @@ public:
     */
     bool IsDirty() const { return m_invalidRange != wxRICHTEXT_NONE; }
 
+#if wxABI_VERSION >= 30209
+    /**
+        Lays out the box like Layout(), but only lays out the invalid
+        paragraphs located above @a bottom and, if @a maxTime is positive, the
+        following ones until this number of milliseconds elapses. The sizes of
+        the other invalid paragraphs are only estimated and they remain invalid
+        and without any lines, so that they are laid out by the next call to
+        this function or to Layout(). At least one invalid paragraph is always
+        laid out, so that repeatedly calling this function eventually lays out
+        all of them.
+
+        If this box is the buffer of a wxRichTextCtrl, the layout is done by
+        wxRichTextCtrl::DoLayoutBuffer(), which is expected to call Layout().
+
+        Returns @true if there are no invalid paragraphs left.
+    */
+    bool LayoutLazily(wxDC& dc, wxRichTextDrawingContext& context,
+                      const wxRect& rect, const wxRect& parentRect, int style,
+                      int bottom, long maxTime = 0);
+#endif // wxABI_VERSION >= 3.2.9
+
     /**
         Returns the wxRichTextFloatCollector of this object.
     */
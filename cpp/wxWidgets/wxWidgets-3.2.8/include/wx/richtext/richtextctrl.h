@@ -79,6 +79,8 @@ class WXDLLIMPEXP_FWD_RICHTEXT wxRichTextStyleDefinition;
 #define wxRICHTEXT_DEFAULT_DELAYED_LAYOUT_THRESHOLD 20000
 // Milliseconds before layout occurs after resize
 #define wxRICHTEXT_DEFAULT_LAYOUT_INTERVAL 50
+// Milliseconds spent laying out a large buffer in each idle event
+#define wxRICHTEXT_DEFAULT_LAYOUT_SLICE 20
 // Milliseconds before delayed image processing occurs
 #define wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL 200
 
@@ -346,6 +348,8 @@ public:
     /**
         Sets the size of the buffer beyond which layout is delayed during resizing.
         This optimizes sizing for large buffers. The default is 20000.
+        Since wxWidgets 3.2.9, only the visible part of such buffers is laid out
+        immediately and the rest of them is laid out in idle time.
     */
     void SetDelayedLayoutThreshold(long threshold) { m_delayedLayoutThreshold = threshold; }
 
@@ -1420,6 +1424,10 @@ public:
 
     /**
         Implements layout. An application may override this to perform operations before or after layout.
+
+        For buffers bigger than GetDelayedLayoutThreshold(), this function is
+        called several times, including in idle time, and each call only lays
+        out a part of the buffer, see wxRichTextParagraphLayoutBox::LayoutLazily().
     */
     virtual void DoLayoutBuffer(wxRichTextBuffer& buffer, wxDC& dc, wxRichTextDrawingContext& context, const wxRect& rect, const wxRect& parentRect, int flags);
 
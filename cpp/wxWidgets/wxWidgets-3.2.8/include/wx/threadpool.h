@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool and related classes
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+
+#include "wx/atomic.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+class wxThreadPoolImpl;
+
+// Priority of the tasks: tasks with higher priority are always started before
+// the tasks with lower one.
+enum wxThreadPoolPriority
+{
+    wxTHREAD_POOL_PRIORITY_HIGH,
+    wxTHREAD_POOL_PRIORITY_NORMAL,
+    wxTHREAD_POOL_PRIORITY_LOW,
+
+    wxTHREAD_POOL_PRIORITY_MAX
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask: base class for the tasks executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPoolTask
+{
+public:
+    wxThreadPoolTask();
+
+    // Return true if cancelling the task was requested: this should be
+    // checked periodically by long running tasks which should return from
+    // Run() as soon as possible if it returns true.
+    bool IsCancelled() const { return m_cancelled != 0; }
+
+protected:
+    // The tasks are reference-counted and deleted by the pool once they are
+    // not needed any more, so the dtor is not public.
+    virtual ~wxThreadPoolTask();
+
+    // Override this function to perform the task, it is called in one of the
+    // pool worker threads.
+    virtual void Run() = 0;
+
+private:
+    // The state of the task.
+    enum State
+    {
+        State_Queued,
+        State_Running,
+        State_Done,
+        State_Cancelled
+    };
+
+    void IncRef() { wxAtomicInc(m_refCount); }
+    void DecRef();
+
+    // Functions used by wxThreadPoolImpl, all of them are thread-safe.
+    bool IsFinished() const;
+    bool StartRunning();
+    bool CancelIfQueued();
+    void Finish(State state);
+
+    // Queue the given event, calling the completion callback, to the given
+    // handler when the task finishes, or immediately if it already did.
+    void AddCompletion(wxEvtHandler* handler, wxAsyncMethodCallEvent* event);
+
+
+    wxAtomicInt m_refCount;
+    wxAtomicInt m_cancelled;
+
+    // Protects m_state and m_completions.
+    mutable wxCriticalSection m_cs;
+    State m_state;
+
+    struct Completion
+    {
+        wxEvtHandler* handler;
+        wxAsyncMethodCallEvent* event;
+    };
+    wxVector<Completion> m_completions;
+
+    friend class wxThreadPoolImpl;
+    friend class wxThreadPoolFuture;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolTask);
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolFunctorTask: task calling the given functor
+// ----------------------------------------------------------------------------
+
+template <typename F>
+class wxThreadPoolFunctorTask : public wxThreadPoolTask
+{
+public:
+    explicit wxThreadPoolFunctorTask(const F& fn) : m_fn(fn) { }
+
+protected:
+    virtual void Run() wxOVERRIDE { m_fn(); }
+
+private:
+    F m_fn;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolFuture: allows to wait for or cancel the submitted task
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPoolFuture
+{
+public:
+    wxThreadPoolFuture() : m_pool(NULL), m_task(NULL) { }
+    wxThreadPoolFuture(const wxThreadPoolFuture& other);
+    wxThreadPoolFuture& operator=(const wxThreadPoolFuture& other);
+    ~wxThreadPoolFuture();
+
+    // Return true if this object is associated with a task.
+    bool IsOk() const { return m_task != NULL; }
+
+    // Return the associated task.
+    wxThreadPoolTask* GetTask() const { return m_task; }
+
+    // Return true if the task has finished running or was cancelled.
+    bool IsDone() const;
+
+    // Return true if the task was cancelled before it could run.
+    bool IsCancelled() const;
+
+    // Request cancelling the task: if it hasn't started running yet, it won't
+    // run at all and true is returned, otherwise its IsCancelled() starts
+    // returning true, but it's up to the task itself to check for it.
+    bool Cancel();
+
+    // Wait until the task finishes. When called from a pool worker thread,
+    // other tasks are executed while waiting, so that waiting for the tasks
+    // submitted from another task can't result in a deadlock.
+    void Wait();
+
+    // Wait until the task finishes or the timeout expires, return true if
+    // the task finished.
+    bool WaitTimeout(unsigned long timeoutMillis);
+
+    // Call the given functor in the thread processing the events of the given
+    // handler, typically the main one, after the task finishes, whether it
+    // ran or was cancelled. If it already did, the call is still done
+    // asynchronously.
+    template <typename T>
+    void CallAfter(wxEvtHandler* handler, const T& fn)
+    {
+        wxCHECK_RET( m_task, "no task" );
+
+        m_task->AddCompletion(handler,
+                              new wxAsyncMethodCallEventFunctor<T>(handler, fn));
+    }
+
+private:
+    wxThreadPoolFuture(wxThreadPoolImpl* pool, wxThreadPoolTask* task);
+
+    wxThreadPoolImpl* m_pool;
+    wxThreadPoolTask* m_task;
+
+    friend class wxThreadPool;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolLoopBody: body of the loop executed by wxThreadPool::ParallelFor
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPoolLoopBody
+{
+public:
+    wxThreadPoolLoopBody() { }
+    virtual ~wxThreadPoolLoopBody() { }
+
+    // Process the items in [begin, end) range, this function is called
+    // concurrently from several threads for different ranges.
+    virtual void Process(int begin, int end) = 0;
+
+private:
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolLoopBody);
+};
+
+template <typename F>
+class wxThreadPoolFunctorLoopBody : public wxThreadPoolLoopBody
+{
+public:
+    explicit wxThreadPoolFunctorLoopBody(const F& fn) : m_fn(fn) { }
+
+    virtual void Process(int begin, int end) wxOVERRIDE { m_fn(begin, end); }
+
+private:
+    const F& m_fn;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: executes tasks using a fixed number of worker threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of worker threads, by default
+    // as many as there are CPUs.
+    explicit wxThreadPool(int numThreads = 0);
+
+    // The dtor cancels all the tasks which haven't started yet and waits for
+    // the running ones to finish.
+    ~wxThreadPool();
+
+    // Return the global pool shared by all the library and application code,
+    // creating it if necessary. It is destroyed when the library is cleaned
+    // up.
+    static wxThreadPool& GetDefault();
+
+    // Return the number of worker threads.
+    int GetThreadCount() const;
+
+    // Return the number of tasks which haven't started running yet.
+    int GetPendingCount() const;
+
+    // Return true if called from one of this pool threads.
+    bool IsWorkerThread() const;
+
+    // Submit a task allocated with new for execution, the pool takes
+    // ownership of it.
+    wxThreadPoolFuture
+    Submit(wxThreadPoolTask* task,
+           wxThreadPoolPriority priority = wxTHREAD_POOL_PRIORITY_NORMAL);
+
+    // Submit a task calling the given functor, taking no arguments.
+    template <typename F>
+    wxThreadPoolFuture
+    SubmitFunctor(const F& fn,
+                  wxThreadPoolPriority priority = wxTHREAD_POOL_PRIORITY_NORMAL)
+    {
+        return Submit(new wxThreadPoolFunctorTask<F>(fn), priority);
+    }
+
+    // Process the [begin, end) range in chunks of the given size, using at
+    // most maxThreads threads (or all pool threads by default) in addition
+    // to the calling one, which participates in processing it too. Returns
+    // only when the entire range has been processed.
+    void ParallelFor(int begin, int end,
+                     wxThreadPoolLoopBody& body,
+                     int chunkSize = 1,
+                     int maxThreads = 0);
+
+    // Same as ParallelFor() but with a functor taking the range boundaries.
+    template <typename F>
+    void ParallelForFunctor(int begin, int end,
+                            const F& fn,
+                            int chunkSize = 1,
+                            int maxThreads = 0)
+    {
+        wxThreadPoolFunctorLoopBody<F> body(fn);
+        ParallelFor(begin, end, body, chunkSize, maxThreads);
+    }
+
+private:
+    wxThreadPoolImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
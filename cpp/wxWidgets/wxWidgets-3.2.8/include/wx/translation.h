@@ -145,6 +145,13 @@ public:
     // sets current translations object (takes ownership; may be NULL)
     static void Set(wxTranslations *t);
 
+#if wxABI_VERSION >= 30209
+    // use the catalogs loaded from now on directly instead of converting all
+    // their strings when loading them
+    static void EnableMappedCatalogs(bool enable = true);
+    static bool AreMappedCatalogsEnabled();
+#endif // wxABI_VERSION >= 3.2.9
+
     // changes loader to non-default one; takes ownership of 'loader'
     void SetLoader(wxTranslationsLoader *loader);
 
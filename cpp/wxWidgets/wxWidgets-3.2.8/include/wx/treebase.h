@@ -129,6 +129,10 @@ static const int wxTREE_ITEMSTATE_PREV  = -3;   // cycle to the previous state
 
 #define wxTR_HAS_VARIABLE_ROW_HEIGHT 0x0080     // what it says
 
+#if wxABI_VERSION >= 30209
+#define wxTR_UNIFORM_ROW_HEIGHT      0x0100     // don't measure items for layout
+#endif // wxABI_VERSION >= 3.2.9
+
 #define wxTR_EDIT_LABELS             0x0200     // can edit item labels
 #define wxTR_ROW_LINES               0x0400     // put border around items
 #define wxTR_HIDE_ROOT               0x0800     // don't display root node
@@ -19,12 +19,55 @@
 
 class wxFSWatcherImplUNIX;
 
-class wxFSWatchEntry : public wxFSWatchInfo
+class wxFSWatchEntry
 {
 public:
-    wxFSWatchEntry(const wxFSWatchInfo& winfo) :
-        wxFSWatchInfo(winfo)
+    // The entries of the subdirectories of watched directories don't store
+    // their full path, which would duplicate the path of their parent, but
+    // only their name and a reference keeping the parent entry alive.
+    wxFSWatchEntry(const wxFSWatchInfo& winfo,
+                   const wxSharedPtr<wxFSWatchEntry>& parent =
+                        wxSharedPtr<wxFSWatchEntry>()) :
+        m_parent(parent),
+        m_filespec(winfo.GetFilespec()),
+        m_events(winfo.GetFlags()),
+        m_type(winfo.GetType()),
+        m_wd(-1)
     {
+        if ( m_parent )
+            m_name = winfo.GetPath().substr(m_parent->GetPathLength());
+        else
+            m_name = winfo.GetPath();
+
+        m_pathLength = winfo.GetPath().length();
+    }
+
+    wxString GetPath() const
+    {
+        wxString path;
+        path.reserve(m_pathLength);
+        AppendPath(path);
+        return path;
+    }
+
+    size_t GetPathLength() const
+    {
+        return m_pathLength;
+    }
+
+    const wxString& GetFilespec() const
+    {
+        return m_filespec;
+    }
+
+    int GetFlags() const
+    {
+        return m_events;
+    }
+
+    wxFSWPathType GetType() const
+    {
+        return m_type;
     }
 
     int GetWatchDescriptor() const
@@ -38,6 +81,20 @@ public:
     }
 
 private:
+    void AppendPath(wxString& path) const
+    {
+        if ( m_parent )
+            m_parent->AppendPath(path);
+
+        path += m_name;
+    }
+
+    const wxSharedPtr<wxFSWatchEntry> m_parent;
+    wxString m_name;
+    const wxString m_filespec;
+    size_t m_pathLength;
+    const int m_events;
+    const wxFSWPathType m_type;
     int m_wd;
 
     wxDECLARE_NO_COPY_CLASS(wxFSWatchEntry);
@@ -13,6 +13,7 @@
 #if wxUSE_TIMER
 
 #include "wx/private/timer.h"
+#include "wx/vector.h"
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -45,6 +46,12 @@ public:
 
 private:
     bool m_isRunning;
+
+    // the index of this timer in wxTimerScheduler heap, only valid while the
+    // timer is running
+    size_t m_heapIndex;
+
+    friend class wxTimerScheduler;
 };
 
 // ----------------------------------------------------------------------------
@@ -53,10 +60,22 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    wxUint64 order)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_order(order)
+    {
+    }
+
+    // return true if this timer must be notified before the other one
+    bool IsBefore(const wxTimerSchedule& other) const
     {
+        if ( m_expiration != other.m_expiration )
+            return m_expiration < other.m_expiration;
+
+        return m_order < other.m_order;
     }
 
     // the timer itself (we don't own this pointer)
@@ -64,10 +83,11 @@ struct wxTimerSchedule
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
-};
 
-// the linked list of all active timers, we keep it sorted by expiration time
-WX_DECLARE_LIST(wxTimerSchedule, wxTimerList);
+    // sequential number of this schedule, used to notify the timers expiring
+    // at the same time in the order in which they had been added
+    wxUint64 m_order;
+};
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -101,6 +121,13 @@ public:
     // remove timer from the list, called automatically from timer dtor
     void RemoveTimer(wxUnixTimerImpl *timer);
 
+    // set the maximal delay, in usec, by which the timers expiration can be
+    // postponed in order to notify them together with the timers expiring
+    // later, which reduces the number of wake ups; the default slack is 0
+    // unless overridden by "unix.timer-slack" system option (in ms)
+    void SetSlack(wxUsecClock_t slack) { m_slack = slack; }
+    wxUsecClock_t GetSlack() const { return m_slack; }
+
 
     // the functions below are used by the event loop implementation to monitor
     // and notify timers:
@@ -118,17 +145,42 @@ public:
 private:
     // ctor and dtor are private, this is a singleton class only created by
     // Get() and destroyed by Shutdown()
-    wxTimerScheduler() { }
-    ~wxTimerScheduler();
+    wxTimerScheduler();
+    ~wxTimerScheduler() { }
 
-    // add the given timer schedule to the list in the right place
-    //
-    // we take ownership of the pointer "s" which must be heap-allocated
-    void DoAddTimer(wxTimerSchedule *s);
+    // add the given timer schedule to the heap
+    void DoAddTimer(const wxTimerSchedule& s);
+
+    // remove the timer schedule at the given position from the heap
+    void DoRemoveAt(size_t n);
+
+    // store the timer schedule at the given position in the heap
+    void DoPlaceAt(size_t n, const wxTimerSchedule& s)
+    {
+        m_timers[n] = s;
+        s.m_timer->m_heapIndex = n;
+    }
+
+    // move the timer schedule at the given position up or down the heap
+    // until the heap property is restored
+    void DoSiftUp(size_t n);
+    void DoSiftDown(size_t n);
+
+
+    // all currently active timers stored as a binary heap, with the timer
+    // expiring first always at the top
+    wxVector<wxTimerSchedule> m_timers;
+
+    // the order of the next timer schedule added to the heap
+    wxUint64 m_nextOrder;
 
+    // see SetSlack()
+    wxUsecClock_t m_slack;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // the number of NotifyExpired() calls and of the timers notified by them,
+    // only used for logging
+    unsigned long m_numIterations,
+                  m_numNotified;
 
     static wxTimerScheduler *ms_instance;
 };
@@ -145,6 +145,9 @@ public:
         Storage_Memory,
         Storage_File,
         Storage_None
+#if wxABI_VERSION >= 30209
+      , Storage_Stream
+#endif // wxABI_VERSION >= 3.2.9
     };
 
     wxWebRequest();
@@ -166,6 +169,10 @@ public:
 
     Storage GetStorage() const;
 
+#if wxABI_VERSION >= 30209
+    void SetStorageStream(wxOutputStream* stream);
+#endif // wxABI_VERSION >= 3.2.9
+
     void Start();
 
     void Cancel();
@@ -240,6 +247,11 @@ public:
     void SetTempDir(const wxString& dir);
     wxString GetTempDir() const;
 
+#if wxABI_VERSION >= 30209
+    void SetCacheDir(const wxString& dir);
+    wxString GetCacheDir() const;
+#endif // wxABI_VERSION >= 3.2.9
+
     bool IsOpened() const;
 
     void Close();
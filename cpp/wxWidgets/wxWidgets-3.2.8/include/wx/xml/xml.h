@@ -305,6 +305,13 @@ public:
     virtual bool Save(const wxString& filename, int indentstep = 2) const;
     virtual bool Save(wxOutputStream& stream, int indentstep = 2) const;
 
+#if wxABI_VERSION >= 30209
+    // Saves document in a compact binary format which is recognized and
+    // loaded much faster than XML by Load().
+    bool SaveBinary(const wxString& filename) const;
+    bool SaveBinary(wxOutputStream& stream) const;
+#endif // wxABI_VERSION >= 3.2.9
+
     bool IsOk() const { return GetRoot() != NULL; }
 
     // Returns root node of the document.
@@ -361,6 +368,157 @@ private:
     wxDECLARE_CLASS(wxXmlDocument);
 };
 
+#if wxABI_VERSION >= 30209
+
+class wxXmlReaderImpl;
+class wxXmlArenaData;
+struct wxXmlArenaNodeData;
+
+// Streaming XML parser: instead of building the whole tree in memory, it
+// returns the document items one by one, allowing to process arbitrarily
+// large documents using a fixed amount of memory.
+
+class WXDLLIMPEXP_XML wxXmlReader
+{
+public:
+    enum Event
+    {
+        Event_None,             // end of document or parsing error
+        Event_StartElement,
+        Event_EndElement,
+        Event_Text,
+        Event_CData,
+        Event_Comment,
+        Event_PI
+    };
+
+    // The stream must remain valid for as long as this object exists.
+    explicit wxXmlReader(wxInputStream& stream,
+                         const wxString& encoding = wxS("UTF-8"),
+                         int flags = wxXMLDOC_NONE);
+    ~wxXmlReader();
+
+    // Advances to the next item and returns its type.
+    Event Next();
+
+    Event GetEvent() const;
+    bool IsOk() const;
+
+    // Name of the element or PI target, strings are shared by all items
+    // with the same name.
+    const wxString& GetName() const;
+
+    // Content of text, CDATA, comment or PI items, the UTF-8 version remains
+    // valid until the next call to Next() only.
+    wxString GetText() const;
+    wxScopedCharBuffer GetTextUTF8() const;
+
+    size_t GetAttributeCount() const;
+    const wxString& GetAttributeName(size_t n) const;
+    wxString GetAttributeValue(size_t n) const;
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+    bool HasAttribute(const wxString& attrName) const;
+
+    // Number of elements containing the current item.
+    int GetDepth() const;
+    int GetLineNumber() const;
+
+    // Skips all items until the end of the current element.
+    bool SkipElement();
+
+    // Returns the current item, including all children of an element, as a
+    // new node which must be deleted by the caller.
+    wxXmlNode *ReadNode();
+
+private:
+    wxXmlReaderImpl *m_impl;
+
+    friend class wxXmlArenaDocument;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReader);
+};
+
+
+// Lightweight read-only reference to a node of wxXmlArenaDocument, only valid
+// as long as the document itself.
+
+class WXDLLIMPEXP_XML wxXmlArenaNode
+{
+public:
+    wxXmlArenaNode() : m_data(NULL), m_node(NULL) {}
+
+    bool IsOk() const { return m_node != NULL; }
+
+    wxXmlNodeType GetType() const;
+    const wxString& GetName() const;
+    wxString GetContent() const;
+    wxScopedCharBuffer GetContentUTF8() const;
+    wxString GetNodeContent() const;
+
+    wxXmlArenaNode GetParent() const;
+    wxXmlArenaNode GetChildren() const;
+    wxXmlArenaNode GetNext() const;
+
+    size_t GetAttributeCount() const;
+    const wxString& GetAttributeName(size_t n) const;
+    wxString GetAttributeValue(size_t n) const;
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+    bool HasAttribute(const wxString& attrName) const;
+
+    int GetLineNumber() const;
+
+    // Creates a copy of this node and all its children as a wxXmlNode tree,
+    // which must be deleted by the caller.
+    wxXmlNode *ToXmlNode() const;
+
+    bool operator==(const wxXmlArenaNode& other) const
+        { return m_node == other.m_node; }
+    bool operator!=(const wxXmlArenaNode& other) const
+        { return m_node != other.m_node; }
+
+private:
+    wxXmlArenaNode(const wxXmlArenaData *data, const wxXmlArenaNodeData *node)
+        : m_data(data), m_node(node) {}
+
+    const wxXmlArenaData *m_data;
+    const wxXmlArenaNodeData *m_node;
+
+    friend class wxXmlArenaDocument;
+};
+
+
+// Read-only alternative to wxXmlDocument: all nodes are allocated in a few
+// big memory blocks freed together, element and attribute names are shared
+// and text is kept in UTF-8 and only converted when it is accessed.
+
+class WXDLLIMPEXP_XML wxXmlArenaDocument
+{
+public:
+    wxXmlArenaDocument() : m_data(NULL) {}
+    ~wxXmlArenaDocument();
+
+    bool Load(const wxString& filename,
+              const wxString& encoding = wxS("UTF-8"), int flags = wxXMLDOC_NONE);
+    bool Load(wxInputStream& stream,
+              const wxString& encoding = wxS("UTF-8"), int flags = wxXMLDOC_NONE);
+
+    bool IsOk() const { return m_data != NULL; }
+
+    wxXmlArenaNode GetRoot() const;
+    wxXmlArenaNode GetDocumentNode() const;
+
+private:
+    wxXmlArenaData *m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlArenaDocument);
+};
+
+#endif // wxABI_VERSION >= 3.2.9
+
 #endif // wxUSE_XML
 
 #endif // _WX_XML_H_
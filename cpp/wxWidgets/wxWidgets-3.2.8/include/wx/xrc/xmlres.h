@@ -306,6 +306,14 @@ public:
     const wxString& GetDomain() const { return m_domain; }
     void SetDomain(const wxString& domain);
 
+#if wxABI_VERSION >= 30209
+    // Get/Set the directory used for caching the XRC files loaded later in
+    // binary form which is faster to load, caching is disabled if it's empty
+    // (default).
+    wxString GetCacheDir() const;
+    void SetCacheDir(const wxString& dir);
+#endif // wxABI_VERSION >= 3.2.9
+
 
     // This function returns the wxXmlNode containing the definition of the
     // object with the given name or NULL.
@@ -279,6 +279,8 @@ private:
 
     friend class wxZipInputStream;
     friend class wxZipOutputStream;
+    friend class wxZipParallelOutputStream;
+    friend class wxZipIndexData;
 
     wxDECLARE_DYNAMIC_CLASS(wxZipEntry);
 };
@@ -324,6 +326,13 @@ public:
     void SetFormat(wxZipArchiveFormat format)   { m_format = format; }
     wxZipArchiveFormat GetFormat() const        { return m_format; }
 
+#if wxABI_VERSION >= 30209
+    // compress the entries using the given number of threads, 0 means to use
+    // as many threads as there are CPUs and 1 disables parallel compression
+    void WXZIPFIX SetThreadCount(int numThreads);
+    int WXZIPFIX GetThreadCount() const;
+#endif // wxABI_VERSION >= 3.2.9
+
 protected:
     virtual size_t WXZIPFIX OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
     virtual wxFileOffset OnSysTell() const wxOVERRIDE      { return m_entrySize; }
@@ -370,6 +379,8 @@ private:
     bool m_endrecWritten;
     wxZipArchiveFormat m_format;
 
+    friend class wxZipParallelOutputStream;
+
     wxDECLARE_NO_COPY_CLASS(wxZipOutputStream);
 };
 
@@ -451,10 +462,74 @@ private:
     friend bool wxZipOutputStream::CopyArchiveMetaData(
                     wxZipInputStream& inputStream);
 
+    friend class wxZipIndexData;
+
     wxDECLARE_NO_COPY_CLASS(wxZipInputStream);
 };
 
 
+#if wxABI_VERSION >= 30209
+
+/////////////////////////////////////////////////////////////////////////////
+// wxZipIndex - index of the entries of a zip allowing to open any of them
+// directly, without reading the preceding ones.
+//
+// The index is built from the central directory which is read at once and
+// only contains the data needed for finding and opening the entries. Copies
+// of the index share the same data, which is immutable, so they can be used
+// from different threads.
+
+class WXDLLIMPEXP_BASE wxZipIndex
+{
+public:
+    wxZipIndex() : m_data(NULL) { }
+    explicit wxZipIndex(const wxString& filename,
+                        wxMBConv& conv = wxConvLocal);
+    explicit wxZipIndex(wxInputStream& stream,
+                        wxMBConv& conv = wxConvLocal);
+
+    wxZipIndex(const wxZipIndex& index);
+    wxZipIndex& operator=(const wxZipIndex& index);
+
+    ~wxZipIndex();
+
+    bool Create(const wxString& filename, wxMBConv& conv = wxConvLocal);
+    bool Create(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    bool IsOk() const { return m_data != NULL; }
+
+    size_t GetCount() const;
+    wxString GetComment() const;
+
+    // Find the entry with the given name in the format returned by
+    // wxZipEntry::GetName(wxPATH_UNIX), i.e. with a trailing slash for the
+    // directories. Returns wxNOT_FOUND if there is no such entry.
+    int Find(const wxString& name) const;
+
+    // Accessors for the n-th entry, in the order of the central directory.
+    wxString GetName(size_t n) const;
+    bool IsDir(size_t n) const;
+    wxFileOffset GetSize(size_t n) const;
+    wxDateTime GetDateTime(size_t n) const;
+
+    // Create a new entry object for the n-th entry. Its comment and extra
+    // fields are not filled in, as they're not stored in the index.
+    wxZipEntry *GetEntry(size_t n) const;
+
+    // Return a stream for reading the n-th entry data, reading the zip from
+    // the file the index was created from or from the given stream, which
+    // must be seekable and is owned by the returned object. Returns NULL on
+    // error.
+    wxZipInputStream *OpenEntry(size_t n) const;
+    wxZipInputStream *OpenEntry(wxInputStream *stream, size_t n) const;
+
+private:
+    class wxZipIndexData *m_data;
+};
+
+#endif // wxABI_VERSION >= 3.2.9
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Iterators
 
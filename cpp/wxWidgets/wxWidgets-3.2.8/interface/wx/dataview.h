@@ -1478,6 +1478,15 @@ public:
      */
     wxDataViewColumn *GetCurrentColumn() const;
 
+    /**
+        Returns the mode used for computing the best width of the columns.
+
+        @see SetBestColumnWidthMode()
+
+        @since 3.2.9
+    */
+    wxDataViewBestColumnWidthMode GetBestColumnWidthMode() const;
+
     /**
         Returns indentation.
     */
@@ -1688,6 +1697,29 @@ public:
     */
     bool SetHeaderAttr(const wxItemAttr& attr);
 
+    /**
+        Sets the mode used for computing the best width of the columns.
+
+        The best width is used for the columns with ::wxCOL_WIDTH_AUTOSIZE
+        width and when the user double clicks the column separator in the
+        header. By default, the rows at the beginning and the end of the
+        control are measured for a limited time, in addition to the visible
+        rows, and the width is computed again whenever any item is added,
+        deleted or changed. This may be too slow for the controls with many
+        rows, especially virtual ones, and the other modes can be used to
+        measure fewer rows or measure them in idle time.
+
+        In all modes other than ::wxDATAVIEW_BEST_WIDTH_DEFAULT, adding or
+        changing an item only measures this item, possibly making the column
+        wider, and deleting an item never makes the column narrower.
+
+        Currently this is only used by the generic implementation and does
+        nothing in the native ones.
+
+        @since 3.2.9
+    */
+    void SetBestColumnWidthMode(wxDataViewBestColumnWidthMode mode);
+
     /**
         Sets the indentation.
     */
@@ -1865,6 +1897,41 @@ public:
 };
 
 
+/**
+    The rows used for computing the best width of the columns, see
+    wxDataViewCtrl::SetBestColumnWidthMode().
+
+    @since 3.2.9
+*/
+enum wxDataViewBestColumnWidthMode
+{
+    /**
+        Measure as many rows at the beginning and at the end of the control
+        as possible in a limited time and the visible rows.
+
+        This is the default mode.
+     */
+    wxDATAVIEW_BEST_WIDTH_DEFAULT,
+
+    /**
+        Only measure the rows visible at the moment when the best width is
+        computed.
+     */
+    wxDATAVIEW_BEST_WIDTH_VISIBLE,
+
+    /**
+        Measure the visible rows and a fixed number of rows (currently 1000)
+        evenly spread over all of them.
+     */
+    wxDATAVIEW_BEST_WIDTH_SAMPLED,
+
+    /**
+        Measure the visible rows immediately and all the other rows in idle
+        time, making the column wider if necessary.
+     */
+    wxDATAVIEW_BEST_WIDTH_FULL
+};
+
 /**
     The mode of a data-view cell; see wxDataViewRenderer for more info.
 */
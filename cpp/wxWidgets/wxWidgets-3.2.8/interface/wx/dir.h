@@ -57,6 +57,11 @@ wxULongLong wxInvalidSize;
     dir.Traverse(traverser);
     @endcode
 
+    Note that if ::wxDIR_PARALLEL flag is used, the functions of this class
+    may be called concurrently from several threads and must be thread-safe.
+    For example, the class above would need to protect @c m_files with a
+    critical section to be usable with this flag.
+
     @library{wxbase}
     @category{file}
 */
@@ -122,6 +127,23 @@ enum wxDirFlags
      */
     wxDIR_NO_FOLLOW = 0x0010,
 
+    /**
+        Traverse the subdirectories in parallel.
+
+        This flag is only used by wxDir::Traverse() and makes it process the
+        subdirectories in the worker threads of wxThreadPool::GetDefault(), so
+        that wxDirTraverser functions may be called concurrently from several
+        threads and in unspecified order. The traversal is still stopped as
+        soon as possible if any of them returns ::wxDIR_STOP.
+
+        This flag is ignored if wxWidgets was built without threads support,
+        if the pool has only a single thread or if Traverse() is called from
+        one of the pool threads.
+
+        @since 3.2.9
+     */
+    wxDIR_PARALLEL  = 0x0020,
+
     /**
         Default directory traversal flags include both files and directories,
         even hidden.
@@ -368,6 +390,9 @@ public:
         The function returns the total number of files found or @c "(size_t)-1"
         on error.
 
+        Big directory trees can be traversed faster by using ::wxDIR_PARALLEL
+        flag, but only if @a sink is thread-safe.
+
         See ::wxDirFlags for the full list of the possible flags.
 
         @see GetAllFiles()
@@ -416,8 +416,9 @@ public:
         moment).
 
         QueueEvent() can be used for inter-thread communication from the worker
-        threads to the main thread, it is safe in the sense that it uses
-        locking internally and avoids the problem mentioned in AddPendingEvent()
+        threads to the main thread, it is safe in the sense that it can be
+        called from any number of threads concurrently (and, since wxWidgets
+        3.2.9, with only minimal locking) and avoids the problem mentioned in AddPendingEvent()
         documentation by ensuring that the @a event object is not used by the
         calling thread any more. Care should still be taken to avoid that some
         fields of this object are used by it, notably any wxString members of
@@ -672,9 +673,13 @@ public:
 
     /**
         Processes the pending events previously queued using QueueEvent() or
-        AddPendingEvent(); you must call this function only if you are sure
-        there are pending events for this handler, otherwise a @c wxCHECK
-        will fail.
+        AddPendingEvent().
+
+        All the events queued before this function was called and which can be
+        processed now are processed, unless this handler itself is destroyed
+        while doing it. Notice that before wxWidgets 3.2.9 only a single event
+        was processed and that a @c wxCHECK failed if there were no pending
+        events at all, while now the function simply does nothing then.
 
         The real processing still happens in ProcessEvent() which is called by this
         function.
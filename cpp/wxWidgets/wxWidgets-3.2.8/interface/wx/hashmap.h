@@ -150,6 +150,21 @@
     it + 3, it1 - it2.
 
 
+    @section hashmap_impl Implementation
+
+    When @c wxUSE_STD_CONTAINERS is 1, wxHashMap is just a typedef for
+    @c std::unordered_map. Otherwise wxWidgets uses its own implementation,
+    which allocates a separate node for each element by default. If the
+    library is built with @c wxUSE_FLAT_HASH_MAP set to 1, open addressing
+    implementation storing all elements in a single array is used instead.
+    It is faster and uses less memory, especially for small keys and values,
+    but inserting new elements into the map invalidates all the iterators,
+    pointers and references to the existing elements, so the code using this
+    option must not rely on them remaining valid. Erasing elements only
+    invalidates the iterators referring to them, as with the other
+    implementations. This option is available since wxWidgets 3.2.9.
+
+
     @section hashmap_predef Predefined hashmap types
 
     wxWidgets defines the following hashmap types:
@@ -526,6 +526,18 @@ public:
     */
     void InsertCell(wxHtmlCell* cell);
 
+    /**
+        Forces the container and all of its parents to be laid out again.
+
+        Containers don't lay out their contents again if their width didn't
+        change since the last call to Layout(). This function must be called
+        if the cells inside the container were changed in any other way than
+        by using InsertCell() or Detach(), which call it automatically.
+
+        @since 3.2.9
+    */
+    void InvalidateLayout();
+
     /**
         Sets the container's alignment (both horizontal and vertical) according to
         the values stored in @e tag. (Tags @c ALIGN parameter is extracted.)
@@ -777,7 +789,21 @@ public:
 class wxHtmlWordCell : public wxHtmlCell
 {
 public:
+    /**
+        Creates the cell for the given word, measuring it using @a dc.
+    */
     wxHtmlWordCell(const wxString& word, const wxDC& dc);
+
+    /**
+        Creates the cell for the given word with the already known extent.
+
+        This constructor can be used to avoid measuring the same word again
+        if its extent, as returned by wxDC::GetTextExtent(), is known.
+
+        @since 3.2.9
+    */
+    wxHtmlWordCell(const wxString& word,
+                   wxCoord width, wxCoord height, wxCoord descent);
 };
 
 
@@ -187,6 +187,13 @@ public:
     /**
         Appends HTML fragment to currently displayed text and refreshes the window.
 
+        Since wxWidgets 3.2.9, only the new fragment is parsed and the cells
+        created for the existing text are preserved whenever possible, which
+        makes calling this function repeatedly, e.g. to show a log, much more
+        efficient than calling SetPage() with the entire text. This is not
+        done if any wxHtmlProcessor is used, however, as they need to process
+        the entire page.
+
         @param source
             HTML code fragment
 
@@ -103,6 +103,35 @@ public:
     */
     static void AddModule(wxHtmlTagsModule* module);
 
+    /**
+        Parses more HTML code and adds the resulting cells to the existing
+        cell tree.
+
+        The result is the same as if @a source were appended to the source
+        passed to the last call to Parse() and the whole page were parsed
+        again, but only the new source is parsed and the previously created
+        cells are reused.
+
+        This is not always possible, e.g. if the previous source ended in the
+        middle of a word or if @a source contains closing tags for the tags
+        opened before it, and this function returns @false without doing
+        anything in this case, so the entire page needs to be parsed again.
+
+        A DC must be set using SetDC() before calling this function.
+
+        @param source
+            HTML code to append.
+        @param product
+            The container returned by the last call to Parse().
+        @return
+            @true if the cells were added to @a product or @false if
+            incremental parsing couldn't be used.
+
+        @since 3.2.9
+    */
+    bool AppendToProduct(const wxString& source,
+                         wxHtmlContainerCell* product);
+
     /**
         Closes the container, sets actual container to the parent one
         and returns pointer to it (see @ref overview_html_cells).
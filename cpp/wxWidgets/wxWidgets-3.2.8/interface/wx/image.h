@@ -381,6 +381,156 @@ protected:
 };
 
 
+/**
+    @class wxImageRowSink
+
+    Abstract base class for the objects receiving the rows of the image
+    decoded by wxImage::LoadRows().
+
+    Derive from this class and override its ProcessRow() method, and possibly
+    Begin(), to process the image data as it's being decoded.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxImageBufferRowSink
+
+    @since 3.2.9
+*/
+class wxImageRowSink
+{
+public:
+    /// Default constructor.
+    wxImageRowSink();
+
+    /// Trivial but virtual destructor.
+    virtual ~wxImageRowSink();
+
+    /**
+        Called once before the first row is decoded.
+
+        The image size passed to this function takes into account the scale
+        factor passed to wxImage::LoadRows(), i.e. it is the size of the
+        image which will be passed to ProcessRow().
+
+        Default implementation simply returns @true.
+
+        @param width
+            Width of the decoded image.
+        @param height
+            Height of the decoded image.
+        @param hasAlpha
+            @true if the image has alpha channel, in which case the alpha
+            values are passed to ProcessRow().
+        @return @false to cancel decoding, in which case wxImage::LoadRows()
+            returns @false.
+    */
+    virtual bool Begin(int width, int height, bool hasAlpha);
+
+    /**
+        Called for every row of the image, in order from top to bottom.
+
+        @param y
+            Index of the row, from 0 to the image height passed to Begin().
+        @param data
+            RGB data of the row, 3 bytes per pixel. This pointer is only valid
+            during this function execution.
+        @param alpha
+            Alpha values of the row, 1 byte per pixel, or @NULL if the image
+            doesn't have alpha channel.
+        @return @false to stop decoding the rest of the image, this is not
+            considered to be an error.
+    */
+    virtual bool ProcessRow(int y,
+                            const unsigned char* data,
+                            const unsigned char* alpha) = 0;
+};
+
+/**
+    @class wxImageBufferRowSink
+
+    Row sink storing the decoded image rows in the buffers provided by the
+    caller.
+
+    This class can be used to decode the image directly into an existing
+    buffer, e.g. a texture, without allocating any memory for wxImage:
+    @code
+    std::vector<unsigned char> data(3*maxWidth*maxHeight);
+    wxImageBufferRowSink sink(&data[0], maxWidth, maxHeight);
+    if ( wxImage::LoadRows("big.jpg", sink, wxBITMAP_TYPE_JPEG, 4) )
+    {
+        ... use sink.GetWidth() x sink.GetHeight() image in data ...
+    }
+    @endcode
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.2.9
+*/
+class wxImageBufferRowSink : public wxImageRowSink
+{
+public:
+    /**
+        Constructor taking the buffer to store RGB data in.
+
+        The buffer must be big enough to contain @a height rows of @a stride
+        bytes each. Images bigger than @a width by @a height pixels are not
+        decoded at all.
+
+        @param data
+            The buffer, must be non-@NULL.
+        @param width
+            Maximal width of the image.
+        @param height
+            Maximal height of the image.
+        @param stride
+            Offset between the rows in the buffer, in bytes. If 0, the default,
+            @c 3*width is used.
+    */
+    wxImageBufferRowSink(unsigned char* data, int width, int height,
+                         int stride = 0);
+
+    /**
+        Sets the buffer to store the alpha values in.
+
+        If the image doesn't have alpha channel, the rows of this buffer are
+        filled with ::wxIMAGE_ALPHA_OPAQUE values.
+
+        @param alpha
+            The buffer, must contain at least @a height rows of @a stride bytes.
+        @param stride
+            Offset between the rows in the buffer. If 0, the default, the
+            width passed to the constructor is used.
+    */
+    void SetAlphaBuffer(unsigned char* alpha, int stride = 0);
+
+    /**
+        Returns the width of the decoded image.
+
+        This is only valid after decoding the image started.
+    */
+    int GetWidth() const;
+
+    /**
+        Returns the height of the decoded image.
+
+        This is only valid after decoding the image started.
+    */
+    int GetHeight() const;
+
+    /**
+        Returns @true if the decoded image has alpha channel.
+    */
+    bool HasAlpha() const;
+
+    /**
+        Returns the number of rows stored in the buffer so far.
+    */
+    int GetRowsCount() const;
+};
+
+
 /**
     Constant used to indicate the alpha value conventionally defined as
     the complete transparency.
@@ -961,6 +1111,11 @@ public:
         image and will therefore remove the mask partially. Using the alpha channel
         will work.
 
+        All the methods except for @c wxIMAGE_QUALITY_NEAREST resample the
+        image in two separate horizontal and vertical passes and, for
+        sufficiently big images, split the work between several threads, see
+        SetMaxResampleThreads().
+
         Example:
         @code
         // get the bitmap from somewhere
@@ -988,6 +1143,32 @@ public:
     wxImage Scale(int width, int height,
                    wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL) const;
 
+    /**
+        Sets the maximal number of threads used by Scale() and Rescale().
+
+        By default, resampling big images with any quality other than @c
+        wxIMAGE_QUALITY_NEAREST uses as many threads as there are CPUs in the
+        system. This function can be used to limit the number of threads used,
+        e.g. if the application already performs scaling from several threads
+        itself. Passing 1 disables the use of threads completely, while 0
+        restores the default behaviour.
+
+        Note that the results of scaling don't depend on the number of
+        threads used.
+
+        @see GetMaxResampleThreads()
+
+        @since 3.2.9
+     */
+    static void SetMaxResampleThreads(int numThreads);
+
+    /**
+        Returns the value set by SetMaxResampleThreads().
+
+        @since 3.2.9
+     */
+    static int GetMaxResampleThreads();
+
     /**
         Returns a resized version of this image without scaling it by adding either a
         border with the given colour or cropping as necessary.
@@ -1581,6 +1762,61 @@ public:
     virtual bool LoadFile(wxInputStream& stream, const wxString& mimetype,
                           int index = -1);
 
+    /**
+        Decodes the image from the given stream row by row, passing the rows to
+        the provided sink instead of storing the entire image in memory.
+
+        This function is useful for loading big images when only a part of
+        them or a smaller version of them is needed, as the rows are passed to
+        the sink as soon as they're decoded and decoding can be stopped at any
+        moment by returning @false from wxImageRowSink::ProcessRow().
+
+        The image can also be scaled down while decoding it by passing @a scale
+        different from 1. In this case only every @a scale-th pixel of every
+        @a scale-th row of the original image is passed to the sink, i.e. the
+        image is scaled using nearest neighbour algorithm, except for JPEG
+        images for which libjpeg built-in DCT scaling is used instead. The
+        latter is much faster than decoding the full image and also produces
+        better quality results. For interlaced PNG images loaded with @a scale
+        of 8, only the first pass of the image is decoded.
+
+        Row by row decoding is only implemented for PNG and JPEG images, the
+        images in all the other formats are fully loaded in memory first and
+        then passed to the sink row by row, so using this function doesn't
+        have any advantages for them.
+
+        @param stream
+            Opened input stream from which to load the image. If @a type is
+            wxBITMAP_TYPE_ANY, it must be seekable.
+        @param sink
+            The object receiving the decoded rows.
+        @param type
+            The image type, see LoadFile() for the possible values.
+        @param scale
+            The factor to scale down the image by, must be 1, 2, 4 or 8.
+
+        @return @true if the image was decoded successfully or if decoding
+            was stopped by the sink, @false if an error occurred or
+            wxImageRowSink::Begin() returned @false.
+
+        @since 3.2.9
+    */
+    static bool LoadRows(wxInputStream& stream, wxImageRowSink& sink,
+                         wxBitmapType type = wxBITMAP_TYPE_ANY,
+                         int scale = 1);
+
+    /**
+        Decodes the image from the given file row by row.
+
+        This is the same as LoadRows(wxInputStream&, wxImageRowSink&, wxBitmapType, int)
+        overload, but takes the name of the file to load the image from.
+
+        @since 3.2.9
+    */
+    static bool LoadRows(const wxString& name, wxImageRowSink& sink,
+                         wxBitmapType type = wxBITMAP_TYPE_ANY,
+                         int scale = 1);
+
     /**
         Saves an image in the given stream.
 
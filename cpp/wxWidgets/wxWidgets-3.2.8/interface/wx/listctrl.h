@@ -490,6 +490,34 @@ public:
     */
     void EnableBellOnNoMatch(bool on = true);
 
+    /**
+        Enable or disable the search index for the given column.
+
+        The search index contains the texts of all items in the column and
+        makes FindItem(), FindItemInColumn() and searching for the items from
+        keyboard (which uses the first column) much faster for the controls
+        with many items. It also speeds up SortItemsByText() for this column.
+
+        The index is built when it's used for the first time and then updated
+        when the items are inserted, deleted or their text changes, so using
+        it takes some extra memory and makes these operations slightly slower.
+        It is mostly worth enabling for the controls with thousands of items.
+
+        This function can't be used with virtual controls.
+
+        @note This method is only available in the generic version of this
+            control, i.e. not in wxMSW and wxQt.
+
+        @param col The column index, 0 for the column used in list and icon
+            views.
+        @param enable Whether to enable or disable the index.
+
+        @see IsSearchIndexEnabled()
+
+        @since 3.2.9
+    */
+    void EnableSearchIndex(int col = 0, bool enable = true);
+
     /**
         Finish editing the label.
 
@@ -553,6 +581,25 @@ public:
     */
     long FindItem(long start, const wxPoint& pt, int direction);
 
+    /**
+        Find an item whose text in the given column matches this string,
+        starting from start or the beginning if start is @c -1. The string
+        comparison is case insensitive.
+
+        This is the same as FindItem() taking a string for the column 0.
+
+        @note This method is only available in the generic version of this
+            control, i.e. not in wxMSW and wxQt.
+
+        @return The next matching item if any or @c -1 (wxNOT_FOUND) otherwise.
+
+        @see EnableSearchIndex()
+
+        @since 3.2.9
+    */
+    long FindItemInColumn(long start, int col, const wxString& str,
+                          bool partial = false);
+
     /**
         Gets information about this column.
         See SetItem() for more information.
@@ -1015,6 +1062,18 @@ public:
      */
     bool IsVirtual() const;
 
+    /**
+        Returns true if the search index is enabled for the given column.
+
+        @note This method is only available in the generic version of this
+            control, i.e. not in wxMSW and wxQt.
+
+        @see EnableSearchIndex()
+
+        @since 3.2.9
+    */
+    bool IsSearchIndexEnabled(int col = 0) const;
+
     /**
         Redraws the given @e item.
 
@@ -1349,6 +1408,30 @@ public:
     */
     bool SortItems(wxListCtrlCompare fnSortCallBack, wxIntPtr data);
 
+    /**
+        Sort the items by their text in the given column.
+
+        The texts are compared case-insensitively, but without taking the
+        current locale into account, and the items with the same text keep
+        their relative order. Big controls are sorted using multiple threads
+        and sorting them is faster if the search index is enabled for this
+        column, see EnableSearchIndex().
+
+        Notice that all items are unselected after sorting them.
+
+        This function can't be used with virtual controls.
+
+        @note This method is only available in the generic version of this
+            control, i.e. not in wxMSW and wxQt.
+
+        @param col The column index.
+        @param ascending Whether to sort the items in ascending or descending
+            order.
+
+        @since 3.2.9
+    */
+    bool SortItemsByText(int col, bool ascending = true);
+
     /**
         Returns true if checkboxes are enabled for list items.
 
@@ -54,6 +54,22 @@ enum
     */
     wxRE_NEWLINE  = 16,
 
+    /**
+        Compile the regex into machine code to make matching it faster.
+
+        This uses PCRE JIT compiler, if it is available, and silently falls
+        back to the default interpreter if it isn't or if JIT compilation
+        fails for the given expression, so it is always safe to use. Compiling
+        the regex takes longer when this flag is used, so it is only
+        worthwhile for expressions which are matched many times.
+
+        The JIT stack used for matching is allocated on demand for each thread
+        using such regexes and freed when the thread terminates.
+
+        @since 3.2.9
+     */
+    wxRE_JIT      = 256,
+
     /** Default flags.*/
     wxRE_DEFAULT  = wxRE_EXTENDED
 };
@@ -308,6 +324,29 @@ public:
     */
     bool Matches(const wxString& text, int flags = 0) const;
 
+    /**
+        Matches the precompiled regular expression against UTF-8 encoded text.
+
+        This function is similar to Matches() but takes the text as UTF-8
+        buffer of the given length, which doesn't need to be NUL-terminated,
+        and avoids creating a temporary wxString from it. When wxWidgets is
+        built with @c wxUSE_UNICODE_UTF8, the text is passed to PCRE without
+        any copying at all, otherwise it is converted into an internal buffer
+        reused by the subsequent calls.
+
+        After a successful match, the offsets returned by
+        GetMatch(size_t*, size_t*, size_t) are in bytes, i.e. can be used to
+        index @a text directly. The overloads of GetMatch() taking wxString
+        must not be used after calling this function.
+
+        If @a text is not valid UTF-8, @false is returned.
+
+        May only be called after successful call to Compile().
+
+        @since 3.2.9
+    */
+    bool MatchesUTF8(const char* text, size_t len, int flags = 0) const;
+
     /**
         Replaces the current regular expression in the string pointed to by
         @a text, with the text in @a replacement and return number of matches
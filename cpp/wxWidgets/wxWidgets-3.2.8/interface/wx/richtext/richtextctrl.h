@@ -319,6 +319,11 @@ public:
     /**
         Sets the size of the buffer beyond which layout is delayed during resizing.
         This optimizes sizing for large buffers. The default is 20000.
+
+        Since wxWidgets 3.2.9, only the visible part of such buffers is laid
+        out immediately, e.g. after loading a file, and the rest of them is
+        laid out in idle time, using estimated heights for the paragraphs which
+        are not laid out yet until then.
     */
     void SetDelayedLayoutThreshold(long threshold);
 
@@ -1376,6 +1381,10 @@ public:
 
     /**
         Implements layout. An application may override this to perform operations before or after layout.
+
+        For buffers bigger than GetDelayedLayoutThreshold(), this function is
+        called several times, including in idle time, and each call only lays
+        out a part of the buffer, see wxRichTextParagraphLayoutBox::LayoutLazily().
     */
     virtual void DoLayoutBuffer(wxRichTextBuffer& buffer, wxDC& dc, wxRichTextDrawingContext& context, const wxRect& rect, const wxRect& parentRect, int flags);
 
@@ -120,6 +120,21 @@
     @endFlagTable
 
 
+    @section sysopt_unix Unix
+
+    @beginFlagTable
+    @flag{unix.timer-slack}
+        The maximal delay, in milliseconds, by which the expiration of wxTimer
+        can be postponed in order to notify it together with the other timers
+        expiring soon after it, reducing the number of the event loop wake ups
+        when using many timers. Default: 0, i.e. timers are notified as soon
+        as they expire. This option is only used by the ports not using the
+        native timers, i.e. Unix console applications and wxDFB, and must be
+        set before starting the first timer. This option is new since
+        wxWidgets 3.2.9.
+    @endFlagTable
+
+
     @section sysopt_motif Motif
 
     @beginFlagTable
@@ -0,0 +1,346 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     interface of wxThreadPool and related classes
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    Priority of the tasks submitted to wxThreadPool.
+
+    Tasks with higher priority are always started before the tasks with lower
+    priority, tasks with the same priority are started in the order of their
+    submission, unless they are submitted from a task running in the pool
+    itself, see wxThreadPool::Submit().
+
+    @since 3.2.9
+    @category{threading}
+ */
+enum wxThreadPoolPriority
+{
+    /// Highest priority, used by wxThreadPool::ParallelFor().
+    wxTHREAD_POOL_PRIORITY_HIGH,
+
+    /// Default priority.
+    wxTHREAD_POOL_PRIORITY_NORMAL,
+
+    /// Low priority, e.g. for the background tasks.
+    wxTHREAD_POOL_PRIORITY_LOW,
+
+    /// Number of priorities, not a valid priority itself.
+    wxTHREAD_POOL_PRIORITY_MAX
+};
+
+/**
+    Base class for the tasks executed by wxThreadPool.
+
+    Derive from this class and override its Run() function to define a task,
+    then pass a heap-allocated object of the derived class to
+    wxThreadPool::Submit(). The tasks are reference-counted and deleted by
+    the pool when they are not needed any more, i.e. when they finished and
+    there are no wxThreadPoolFuture objects referring to them, so they must
+    never be deleted by the application code.
+
+    For simple tasks, wxThreadPool::SubmitFunctor() can be used instead.
+
+    @since 3.2.9
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool, wxThreadPoolFuture
+*/
+class wxThreadPoolTask
+{
+public:
+    /**
+        Default constructor.
+    */
+    wxThreadPoolTask();
+
+    /**
+        Return @true if cancelling the task was requested.
+
+        This function can be called from Run() to check if the task should
+        stop: wxThreadPoolFuture::Cancel() can't interrupt the task once it
+        started running, so long running tasks should check it periodically
+        and return as soon as possible if it returns @true.
+    */
+    bool IsCancelled() const;
+
+protected:
+    /**
+        Protected destructor.
+
+        The tasks are deleted by the pool.
+    */
+    virtual ~wxThreadPoolTask();
+
+    /**
+        Override this function to perform the task.
+
+        It is called in one of the pool worker threads and so must not use
+        any GUI functions.
+
+        Exceptions thrown by this function are passed to
+        wxApp::OnUnhandledException().
+    */
+    virtual void Run() = 0;
+};
+
+/**
+    Object allowing to wait for or cancel a task submitted to wxThreadPool.
+
+    Objects of this class are returned by wxThreadPool::Submit(), they can be
+    freely copied and keep the task object alive as long as they exist.
+
+    @since 3.2.9
+
+    @library{wxbase}
+    @category{threading}
+*/
+class wxThreadPoolFuture
+{
+public:
+    /**
+        Default constructor creates an invalid object.
+
+        The only functions that can be used with it are IsOk() and GetTask().
+    */
+    wxThreadPoolFuture();
+
+    /**
+        Return @true if this object is associated with a task.
+    */
+    bool IsOk() const;
+
+    /**
+        Return the associated task or @NULL.
+    */
+    wxThreadPoolTask* GetTask() const;
+
+    /**
+        Return @true if the task has finished running or was cancelled.
+    */
+    bool IsDone() const;
+
+    /**
+        Return @true if the task was cancelled before it could start running.
+    */
+    bool IsCancelled() const;
+
+    /**
+        Cancel the task.
+
+        If the task hasn't started running yet, it won't run at all and this
+        function returns @true. Otherwise it returns @false and the task
+        keeps running, but its wxThreadPoolTask::IsCancelled() starts
+        returning @true.
+    */
+    bool Cancel();
+
+    /**
+        Wait until the task finishes.
+
+        If this function is called from a task running in the same pool, the
+        calling thread executes the other pending tasks while waiting, so
+        waiting for the tasks submitted from another task doesn't deadlock
+        even if all the pool threads are busy.
+    */
+    void Wait();
+
+    /**
+        Wait until the task finishes or the timeout expires.
+
+        @param timeoutMillis
+            Timeout in milliseconds.
+        @return
+            @true if the task finished or @false if the timeout expired.
+    */
+    bool WaitTimeout(unsigned long timeoutMillis);
+
+    /**
+        Call the given functor after the task finishes.
+
+        The functor is called in the thread processing the events of the
+        given handler, i.e. typically in the main thread, after the task
+        finishes running or is cancelled. If the task has already finished,
+        it is still called asynchronously.
+
+        This is convenient for updating the UI with the results of the task,
+        e.g. with a C++11 lambda:
+        @code
+        wxThreadPoolFuture future = pool.SubmitFunctor(...);
+        future.CallAfter(this, [=]() { m_text->SetValue(...); });
+        @endcode
+
+        @param handler
+            The event handler, it must not be destroyed before the functor
+            is called.
+        @param fn
+            Functor taking no arguments.
+    */
+    template <typename T>
+    void CallAfter(wxEvtHandler* handler, const T& fn);
+};
+
+/**
+    Body of the loop executed by wxThreadPool::ParallelFor().
+
+    @since 3.2.9
+
+    @library{wxbase}
+    @category{threading}
+*/
+class wxThreadPoolLoopBody
+{
+public:
+    /**
+        Process the items in [begin, end) range.
+
+        This function is called concurrently from several threads for
+        different, non-overlapping, ranges.
+    */
+    virtual void Process(int begin, int end) = 0;
+};
+
+/**
+    Thread pool executing tasks using a fixed number of worker threads.
+
+    Tasks can be submitted to the pool from any thread, including from the
+    tasks running in the pool itself. Each worker thread has its own queue of
+    tasks submitted from it and the idle threads take the tasks from the
+    queues of the busy ones, so that recursively splitting the work into
+    smaller tasks is efficient.
+
+    The global pool returned by GetDefault() should be normally used instead
+    of creating separate pools, to avoid creating more threads than there are
+    CPUs. It is also used by wxWidgets itself, e.g. by wxImage::Scale().
+
+    Example of using it:
+    @code
+    struct ComputeTask : wxThreadPoolTask
+    {
+        virtual void Run() { ... long computation ... }
+    };
+
+    wxThreadPoolFuture f = wxThreadPool::GetDefault().Submit(new ComputeTask);
+    ... do something else ...
+    f.Wait();
+    @endcode
+
+    This class is only available if @c wxUSE_THREADS is 1.
+
+    @since 3.2.9
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThread
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Create the pool with the given number of worker threads.
+
+        @param numThreads
+            Number of the threads to use, if it is 0, wxThread::GetCPUCount()
+            threads are used.
+    */
+    explicit wxThreadPool(int numThreads = 0);
+
+    /**
+        Destroy the pool.
+
+        All the tasks which haven't started running yet are cancelled and the
+        destructor waits until the running ones finish.
+    */
+    ~wxThreadPool();
+
+    /**
+        Return the global pool.
+
+        The pool is created on the first call to this function and destroyed
+        when the library is shut down.
+    */
+    static wxThreadPool& GetDefault();
+
+    /**
+        Return the number of worker threads.
+    */
+    int GetThreadCount() const;
+
+    /**
+        Return the number of tasks which haven't started running yet.
+    */
+    int GetPendingCount() const;
+
+    /**
+        Return @true if called from one of the worker threads of this pool.
+    */
+    bool IsWorkerThread() const;
+
+    /**
+        Submit the task for execution.
+
+        @param task
+            Task allocated with @c new, the pool takes ownership of it.
+        @param priority
+            Priority of the task.
+        @return
+            Object which can be used to wait for the task or cancel it.
+    */
+    wxThreadPoolFuture
+    Submit(wxThreadPoolTask* task,
+           wxThreadPoolPriority priority = wxTHREAD_POOL_PRIORITY_NORMAL);
+
+    /**
+        Submit a task calling the given functor.
+
+        The functor, taking no arguments, is copied and called in a worker
+        thread.
+    */
+    template <typename F>
+    wxThreadPoolFuture
+    SubmitFunctor(const F& fn,
+                  wxThreadPoolPriority priority = wxTHREAD_POOL_PRIORITY_NORMAL);
+
+    /**
+        Process the given range in parallel.
+
+        The range is split in chunks of the given size which are processed by
+        calling wxThreadPoolLoopBody::Process() from the pool threads and the
+        calling thread, which participates in processing too. This function
+        returns only when the entire range has been processed.
+
+        @param begin
+            Start of the range.
+        @param end
+            End of the range, not included in it.
+        @param body
+            Object processing the chunks of the range.
+        @param chunkSize
+            Maximal number of items passed to a single Process() call, must
+            be strictly positive.
+        @param maxThreads
+            Maximal number of threads to use, including the calling one, or 0
+            to use all the pool threads.
+    */
+    void ParallelFor(int begin, int end,
+                     wxThreadPoolLoopBody& body,
+                     int chunkSize = 1,
+                     int maxThreads = 0);
+
+    /**
+        Process the given range in parallel using a functor.
+
+        This is the same as ParallelFor() but uses a functor taking the range
+        boundaries as @c int arguments instead of wxThreadPoolLoopBody.
+    */
+    template <typename F>
+    void ParallelForFunctor(int begin, int end,
+                            const F& fn,
+                            int chunkSize = 1,
+                            int maxThreads = 0);
+};
@@ -52,6 +52,40 @@ public:
      */
     static void Set(wxTranslations *t);
 
+    /**
+        Enables or disables using the message catalogs directly.
+
+        By default, all the strings of a message catalog are converted to
+        wxString and stored in a hash map when it is loaded. When this option
+        is enabled, the catalogs loaded from files are mapped in memory
+        instead, if possible, or read into it without any conversion
+        otherwise, and the translations are looked up using the hash table
+        of the catalog. Only the translations actually requested are
+        converted and they are cached in this case, which makes loading the
+        catalogs much faster and reduces the memory used by them when only a
+        small part of the strings is used.
+
+        Note that, under MSW, mapped catalog files can't be modified or
+        deleted while they remain loaded.
+
+        This option only affects the catalogs loaded after changing it and
+        is not available in non-Unicode build.
+
+        @see AreMappedCatalogsEnabled()
+
+        @since 3.2.9
+     */
+    static void EnableMappedCatalogs(bool enable = true);
+
+    /**
+        Returns @true if the message catalogs are used directly.
+
+        @see EnableMappedCatalogs()
+
+        @since 3.2.9
+     */
+    static bool AreMappedCatalogsEnabled();
+
     /**
         Changes loader use to read catalogs to a non-default one.
 
@@ -143,6 +143,7 @@ static const int wxTREE_ITEMSTATE_PREV  = -3;   // cycle to the previous state
 #define wxTR_MULTIPLE                0x0020     // can select multiple items
 
 #define wxTR_HAS_VARIABLE_ROW_HEIGHT 0x0080     // what it says
+#define wxTR_UNIFORM_ROW_HEIGHT      0x0100     // don't measure items for layout
 
 #define wxTR_EDIT_LABELS             0x0200     // can edit item labels
 #define wxTR_ROW_LINES               0x0400     // put border around items
@@ -81,6 +81,14 @@
         Use this style to cause row heights to be just big enough to fit the
         content. If not set, all rows use the largest row height. The default is
         that this flag is unset. Generic only.
+    @style{wxTR_UNIFORM_ROW_HEIGHT}
+        Use this style to make all rows use the height determined by the
+        control font and its images without measuring the items. This makes
+        expanding big branches much faster as the items are only measured
+        when they are shown, but the items using a bigger font than the
+        control one may be truncated. This style is ignored if
+        @c wxTR_HAS_VARIABLE_ROW_HEIGHT is used. Generic only, this style is
+        new since wxWidgets 3.2.9.
     @style{wxTR_SINGLE}
         For convenience to document that only one item may be selected at a
         time. Selecting another item causes the current selection, if any, to be
@@ -209,7 +209,19 @@ public:
             wxWebRequestEvent::GetDataSize() methods from wxEVT_WEBREQUEST_DATA
             handler.
         */
-        Storage_None
+        Storage_None,
+
+        /**
+            The data is written to the stream specified by SetStorageStream()
+            as it is received.
+
+            The stream is written to from the thread receiving the data, which
+            may be different from the main one, and is destroyed, and so
+            closed, before the final state change event is generated.
+
+            @since 3.2.9
+        */
+        Storage_Stream
     };
 
     /**
@@ -400,9 +412,34 @@ public:
         With this storage method the data is only available during the
         @c wxEVT_WEBREQUEST_DATA event calls as soon as it's received from the
         server.
+
+        If the data has to be written to a file at a known location or
+        otherwise consumed sequentially, it is more efficient to use
+        SetStorageStream() instead.
     */
     void SetStorage(Storage storage);
 
+    /**
+        Sets the stream to write the response data to.
+
+        This function sets the storage to @c Storage_Stream and makes the
+        request write all the response data to the given stream as soon as it
+        is received, without keeping it in memory or using a temporary file,
+        which is especially useful for big downloads, e.g.
+        @code
+        request.SetStorageStream(new wxFileOutputStream(path));
+        @endcode
+
+        If writing to the stream fails, the request doesn't receive any more
+        data and fails.
+
+        @param stream The stream to write the data to, must be non-null. The
+            request takes ownership of it and deletes it when it terminates.
+
+        @since 3.2.9
+    */
+    void SetStorageStream(wxOutputStream* stream);
+
     /**
         Disable SSL certificate verification.
 
@@ -712,6 +749,42 @@ public:
     */
     wxString GetTempDir() const;
 
+    /**
+        Enables caching of the responses on disk in the given directory.
+
+        When the cache directory is set, the successful responses to @c GET
+        requests having @c ETag or @c Last-Modified headers are stored in it
+        and the subsequent requests to the same URL are sent with
+        @c If-None-Match and @c If-Modified-Since headers. If the server
+        replies with "304 Not Modified" to them, the data from the cache is
+        used as the response data, using the storage method selected for the
+        request, as if it were received from the server. Note that the status
+        of the response, as returned by wxWebResponse::GetStatus(), is still
+        304 in this case, allowing to check whether the cached data was used.
+
+        Requests for which the application sets any of the conditional request
+        headers, or @c Range header, itself are never cached.
+
+        The directory is created if it doesn't exist yet. By default, no cache
+        is used.
+
+        @param dir The directory to use for the cache or empty string to stop
+            using it. Any existing cache entries are not removed in the latter
+            case.
+
+        @since 3.2.9
+    */
+    void SetCacheDir(const wxString& dir);
+
+    /**
+        Returns the directory used for caching the responses.
+
+        @see SetCacheDir()
+
+        @since 3.2.9
+    */
+    wxString GetCacheDir() const;
+
     /**
         Returns the default session
     */
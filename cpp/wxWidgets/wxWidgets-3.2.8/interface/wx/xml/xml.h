@@ -840,6 +840,10 @@ public:
         less memory however makes impossible to recreate exactly the loaded text with a
         Save() call later. Read the initial description of this class for more info.
 
+        Since wxWidgets 3.2.9 this function also recognizes the documents
+        saved by SaveBinary() and loads them without parsing XML, in which
+        case @a flags are ignored.
+
         Returns true on success, false otherwise.
     */
     virtual bool Load(const wxString& filename,
@@ -869,6 +873,30 @@ public:
     */
     virtual bool Save(wxOutputStream& stream, int indentstep = 2) const;
 
+    /**
+        Saves the document in a compact binary format.
+
+        The binary format preserves the entire document tree, including the
+        line numbers of the nodes, and can be loaded back by Load() several
+        times faster than XML as no parsing is needed. It is meant to be used
+        as a cache of the XML documents loaded by the same program and is not
+        guaranteed to be compatible with the other versions of wxWidgets.
+
+        @see wxXmlResource::SetCacheDir()
+
+        @since 3.2.9
+    */
+    bool SaveBinary(const wxString& filename) const;
+
+    /**
+        Saves the document in a compact binary format to the given stream.
+
+        See SaveBinary(const wxString&) for more information.
+
+        @since 3.2.9
+    */
+    bool SaveBinary(wxOutputStream& stream) const;
+
     /**
         Sets the document node of this document.
 
@@ -934,3 +962,367 @@ public:
     */
     static wxVersionInfo GetLibraryVersionInfo();
 };
+
+
+
+/**
+    @class wxXmlReader
+
+    Streaming XML parser returning the document items one by one.
+
+    Unlike wxXmlDocument, this class doesn't build the tree of the entire
+    document in memory, so it can be used to process arbitrarily big documents
+    using a fixed amount of memory. It is also significantly faster than
+    loading the document into wxXmlDocument if only a part of its contents is
+    needed.
+
+    The items are returned in document order by Next(), whose return value
+    indicates the kind of the current item, which can then be examined using
+    the other methods of this class. Adjacent text is always returned as a
+    single item and, just as with wxXmlDocument::Load(), whitespace-only text
+    items are skipped unless ::wxXMLDOC_KEEP_WHITESPACE_NODES is used.
+
+    Example of processing a big document consisting of many records:
+
+    @code
+    wxFileInputStream stream("export.xml");
+    wxXmlReader reader(stream);
+    while ( reader.Next() != wxXmlReader::Event_None )
+    {
+        if ( reader.GetEvent() == wxXmlReader::Event_StartElement &&
+                reader.GetDepth() == 1 )
+        {
+            // Get just this record as a small XML tree.
+            wxScopedPtr<wxXmlNode> record(reader.ReadNode());
+            ...
+        }
+    }
+
+    if ( !reader.IsOk() )
+        ... handle the parsing error ...
+    @endcode
+
+    @library{wxxml}
+    @category{xml}
+
+    @see wxXmlDocument, wxXmlArenaDocument
+
+    @since 3.2.9
+*/
+class wxXmlReader
+{
+public:
+    /**
+        Kinds of the items returned by Next().
+    */
+    enum Event
+    {
+        /// No current item: end of document was reached or an error occurred.
+        Event_None,
+
+        /// Start of an element, its attributes can be retrieved.
+        Event_StartElement,
+
+        /// End of an element, with the same depth as its start.
+        Event_EndElement,
+
+        /// Text, possibly combined from several chunks and references.
+        Event_Text,
+
+        /// CDATA section.
+        Event_CData,
+
+        /// Comment.
+        Event_Comment,
+
+        /// Processing instruction, GetName() returns its target.
+        Event_PI
+    };
+
+    /**
+        Creates the reader for the given stream.
+
+        The stream must remain valid during the entire lifetime of this object,
+        but it is only read when Next() is called.
+
+        @param stream
+            The stream to read the XML document from.
+        @param encoding
+            The encoding of the strings returned by this object in non-Unicode
+            builds, ignored in Unicode ones.
+        @param flags
+            Only ::wxXMLDOC_KEEP_WHITESPACE_NODES is currently supported.
+    */
+    explicit wxXmlReader(wxInputStream& stream,
+                         const wxString& encoding = "UTF-8",
+                         int flags = wxXMLDOC_NONE);
+
+    /**
+        Advances to the next item and returns its kind.
+
+        Returns ::Event_None at the end of the document or if an error
+        occurred, use IsOk() to distinguish between these cases.
+    */
+    Event Next();
+
+    /**
+        Returns the kind of the current item.
+
+        This is the same value as was returned by the last call to Next().
+    */
+    Event GetEvent() const;
+
+    /**
+        Returns @false if a parsing error occurred.
+
+        Errors are logged using wxLogError(), just as by wxXmlDocument::Load().
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the name of the current item.
+
+        This is the element name for the start and end element items and the
+        target for processing instructions. For the other items, the names used
+        by wxXmlDocument for the corresponding nodes are returned, e.g. "text".
+
+        The same string object is returned for all items with the same name,
+        so this function is very cheap to call.
+    */
+    const wxString& GetName() const;
+
+    /**
+        Returns the contents of text, CDATA, comment or PI item.
+
+        The string is converted from UTF-8 each time this function is called,
+        use GetTextUTF8() to avoid the conversion.
+    */
+    wxString GetText() const;
+
+    /**
+        Returns the contents of the current item in UTF-8.
+
+        The returned buffer is only valid until the next call to Next().
+    */
+    wxScopedCharBuffer GetTextUTF8() const;
+
+    /**
+        Returns the number of attributes of the current element.
+    */
+    size_t GetAttributeCount() const;
+
+    /**
+        Returns the name of the attribute with the given index.
+    */
+    const wxString& GetAttributeName(size_t n) const;
+
+    /**
+        Returns the value of the attribute with the given index.
+    */
+    wxString GetAttributeValue(size_t n) const;
+
+    /**
+        Returns @true if the current element has the attribute with the given
+        name and fills @a value with its value if it's non-@NULL.
+    */
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+
+    /**
+        Returns the value of the attribute or @a defaultVal if the current
+        element doesn't have this attribute.
+    */
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+
+    /**
+        Returns @true if the current element has the attribute with the given
+        name.
+    */
+    bool HasAttribute(const wxString& attrName) const;
+
+    /**
+        Returns the number of elements containing the current item.
+
+        The depth of the root element, as well as of any items outside of it,
+        is 0.
+    */
+    int GetDepth() const;
+
+    /**
+        Returns the line number at which the current item starts.
+    */
+    int GetLineNumber() const;
+
+    /**
+        Skips all the items until the end of the current element.
+
+        Does nothing and returns @false if the current item is not
+        ::Event_StartElement. Otherwise returns @true if the matching end of
+        the element was found and it is the current item now.
+    */
+    bool SkipElement();
+
+    /**
+        Returns the current item as a new wxXmlNode.
+
+        For ::Event_StartElement, all the children of the element are read
+        and added to the returned node and the end of the element becomes the
+        current item. The returned node is the same as would be created by
+        wxXmlDocument::Load().
+
+        Returns @NULL if there is no current item, it is ::Event_EndElement or
+        if the end of the element couldn't be found. Otherwise the returned
+        pointer must be deleted by the caller.
+    */
+    wxXmlNode *ReadNode();
+};
+
+
+
+/**
+    @class wxXmlArenaNode
+
+    Read-only reference to a node of wxXmlArenaDocument.
+
+    Objects of this class are small and cheap to copy and should be passed
+    around by value. They remain valid for as long as the document they come
+    from exists and is not reloaded.
+
+    The methods of this class have the same meaning as the methods of
+    wxXmlNode with the same names.
+
+    @library{wxxml}
+    @category{xml}
+
+    @since 3.2.9
+*/
+class wxXmlArenaNode
+{
+public:
+    /**
+        Creates an invalid node.
+    */
+    wxXmlArenaNode();
+
+    /**
+        Returns @true if this object refers to a node.
+
+        The functions returning other nodes, such as GetNext(), return invalid
+        objects if there is no such node.
+    */
+    bool IsOk() const;
+
+    wxXmlNodeType GetType() const;
+
+    /**
+        Returns the name of the node.
+
+        The same string object is returned for all the nodes with the same
+        name.
+    */
+    const wxString& GetName() const;
+
+    /**
+        Returns the contents of the node, converting it from UTF-8.
+    */
+    wxString GetContent() const;
+
+    /**
+        Returns the contents of the node without conversion.
+    */
+    wxScopedCharBuffer GetContentUTF8() const;
+
+    wxString GetNodeContent() const;
+
+    wxXmlArenaNode GetParent() const;
+    wxXmlArenaNode GetChildren() const;
+    wxXmlArenaNode GetNext() const;
+
+    size_t GetAttributeCount() const;
+    const wxString& GetAttributeName(size_t n) const;
+    wxString GetAttributeValue(size_t n) const;
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxEmptyString) const;
+    bool HasAttribute(const wxString& attrName) const;
+
+    int GetLineNumber() const;
+
+    /**
+        Creates a wxXmlNode tree with the same contents as this node and all
+        of its children.
+
+        The returned pointer must be deleted by the caller.
+    */
+    wxXmlNode *ToXmlNode() const;
+
+    bool operator==(const wxXmlArenaNode& other) const;
+    bool operator!=(const wxXmlArenaNode& other) const;
+};
+
+
+
+/**
+    @class wxXmlArenaDocument
+
+    Read-only XML document using less memory and faster to load than
+    wxXmlDocument.
+
+    Instead of allocating each node separately, this class allocates all of
+    them from a few big memory blocks which are freed together when the
+    document is destroyed. Element and attribute names are stored only once
+    and shared by all nodes using them, while the text and attribute values
+    are kept in UTF-8 and only converted to wxString when they are accessed.
+
+    The document contents is the same as would be loaded by wxXmlDocument,
+    except for the information from the prolog, such as the version, encoding
+    and the DOCTYPE declaration, which is not preserved. The nodes can't be
+    modified, but wxXmlArenaNode::ToXmlNode() can be used to create a normal
+    wxXmlNode tree from any part of the document.
+
+    @library{wxxml}
+    @category{xml}
+
+    @see wxXmlReader
+
+    @since 3.2.9
+*/
+class wxXmlArenaDocument
+{
+public:
+    /**
+        Creates an empty document, use Load() to fill it.
+    */
+    wxXmlArenaDocument();
+
+    /**
+        Loads the document from the given file.
+
+        The parameters have the same meaning as for wxXmlDocument::Load().
+        If loading fails, the previous document contents is preserved.
+    */
+    bool Load(const wxString& filename,
+              const wxString& encoding = "UTF-8", int flags = wxXMLDOC_NONE);
+
+    /**
+        Loads the document from the given stream.
+    */
+    bool Load(wxInputStream& stream,
+              const wxString& encoding = "UTF-8", int flags = wxXMLDOC_NONE);
+
+    /**
+        Returns @true if the document was successfully loaded.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the root element node of the document.
+    */
+    wxXmlArenaNode GetRoot() const;
+
+    /**
+        Returns the document node, containing the root element and any other
+        nodes outside of it.
+    */
+    wxXmlArenaNode GetDocumentNode() const;
+};
@@ -150,6 +150,15 @@ public:
     */
     static wxXmlResource* Get();
 
+    /**
+        Returns the directory used for caching the loaded XRC files.
+
+        @see SetCacheDir()
+
+        @since 3.2.9
+    */
+    wxString GetCacheDir() const;
+
     /**
         Returns the domain (message catalog) that will be used to load
         translatable strings in the XRC.
@@ -421,6 +430,28 @@ public:
     */
     static wxXmlResource* Set(wxXmlResource* res);
 
+    /**
+        Sets the directory used for caching the XRC files loaded later.
+
+        If the cache directory is set, the contents of each XRC file is saved
+        in it in the binary format produced by wxXmlDocument::SaveBinary()
+        after loading the file for the first time. Subsequent loads of the
+        same file, including those done by later runs of the program, use the
+        cached version instead of parsing XML, as long as the file
+        modification time hasn't changed. The directory is created if it
+        doesn't exist yet and any errors when writing to it are ignored.
+
+        Notice that the resources can also be compiled into the binary format
+        in advance using @c wxrc @c \--binary.
+
+        Caching is disabled by default, pass an empty string to disable it
+        again. A typical cache directory would be a subdirectory of
+        wxStandardPaths::GetUserDir(wxStandardPaths::Dir_Cache).
+
+        @since 3.2.9
+    */
+    void SetCacheDir(const wxString& dir);
+
     /**
         Sets the domain (message catalog) that will be used to load
         translatable strings in the XRC.
@@ -438,6 +438,191 @@ public:
 
 
 
+/**
+    @class wxZipIndex
+
+    Index of the entries of a zip file allowing to find and open any of them
+    directly.
+
+    Unlike wxZipInputStream::GetNextEntry(), which needs to be called for all
+    the entries preceding the one being looked for, the index reads the
+    central directory of the zip once and builds a hash table of the entry
+    names, so that Find() and OpenEntry() take constant time independently of
+    the number of entries in the zip. Only the information needed for opening
+    the entries is kept in memory, which makes the index much more compact
+    than a collection of wxZipEntry objects.
+
+    The index is reference counted, so copying it is cheap, and its data is
+    never modified after creating it, so it can be used from several threads
+    concurrently. Each stream returned by OpenEntry() must only be used by a
+    single thread, however.
+
+    Example of reading a single file from a zip:
+    @code
+    wxZipIndex index("data.zip");
+    int n = index.Find("images/logo.png");
+    if ( n != wxNOT_FOUND )
+    {
+        wxScopedPtr<wxZipInputStream> stream(index.OpenEntry(n));
+        if ( stream )
+            ... read the entry data from the stream ...
+    }
+    @endcode
+
+    This class is used by wxArchiveFSHandler for the zip files read from
+    seekable streams.
+
+    @since 3.2.9
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see @ref overview_archive, wxZipInputStream, wxZipEntry
+*/
+class wxZipIndex
+{
+public:
+    /**
+        Default constructor creates an invalid index.
+
+        Call Create() to initialize it later.
+    */
+    wxZipIndex();
+
+    /**
+        Constructor creating the index of the given file.
+
+        Use IsOk() to check if creating it succeeded.
+    */
+    explicit wxZipIndex(const wxString& filename,
+                        wxMBConv& conv = wxConvLocal);
+
+    /**
+        Constructor creating the index of the zip read from the given stream.
+
+        Use IsOk() to check if creating it succeeded.
+    */
+    explicit wxZipIndex(wxInputStream& stream,
+                        wxMBConv& conv = wxConvLocal);
+
+    /**
+        Copy constructor, the copy shares the data with the original object.
+    */
+    wxZipIndex(const wxZipIndex& index);
+
+    /**
+        Assignment operator, the object shares the data with the other one.
+    */
+    wxZipIndex& operator=(const wxZipIndex& index);
+
+    /**
+        Create the index of the given file.
+
+        The entries can then be opened using OpenEntry() overload taking just
+        the index of the entry, which opens the file again.
+
+        @param filename The name of the zip file.
+        @param conv Used to translate the entry names into Unicode, as in
+            wxZipInputStream constructor.
+        @return @true if the index was successfully created.
+    */
+    bool Create(const wxString& filename, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Create the index of the zip read from the given stream.
+
+        The stream must be seekable, as the central directory is at the end of
+        the zip. It is only used while creating the index and the entries have
+        to be opened using OpenEntry() overload taking a stream.
+
+        @return @true if the index was successfully created.
+    */
+    bool Create(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Returns @true if the index was successfully created.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the number of entries in the index.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the comment of the zip as a whole.
+    */
+    wxString GetComment() const;
+
+    /**
+        Returns the index of the entry with the given name.
+
+        The name must be in the same format as returned by
+        wxZipEntry::GetName() for @c wxPATH_UNIX, i.e. use slashes as path
+        separators, without any leading slash, and have a trailing slash for
+        the directory entries.
+
+        If there are several entries with the same name, the first one is
+        returned.
+
+        @return The index of the entry, or @c wxNOT_FOUND.
+    */
+    int Find(const wxString& name) const;
+
+    /**
+        Returns the name of the entry with the given index, in the format
+        described in Find().
+    */
+    wxString GetName(size_t n) const;
+
+    /**
+        Returns @true if the entry with the given index is a directory.
+    */
+    bool IsDir(size_t n) const;
+
+    /**
+        Returns the uncompressed size of the entry with the given index.
+    */
+    wxFileOffset GetSize(size_t n) const;
+
+    /**
+        Returns the modification time of the entry with the given index.
+    */
+    wxDateTime GetDateTime(size_t n) const;
+
+    /**
+        Returns a new wxZipEntry object for the entry with the given index.
+
+        Note that the entry comment and extra fields are not stored in the
+        index and so are not available in the returned object. The caller is
+        responsible for deleting it.
+    */
+    wxZipEntry* GetEntry(size_t n) const;
+
+    /**
+        Returns a stream for reading the data of the entry with the given
+        index from the file the index was created from.
+
+        This overload can only be used if the index was created from a file.
+
+        @return New stream to be deleted by the caller or @NULL on error.
+    */
+    wxZipInputStream* OpenEntry(size_t n) const;
+
+    /**
+        Returns a stream for reading the data of the entry with the given
+        index from the given stream.
+
+        The stream must be seekable and contain the same zip as the one the
+        index was created from. The returned object takes ownership of it,
+        and deletes it even if @NULL is returned.
+
+        @return New stream to be deleted by the caller or @NULL on error.
+    */
+    wxZipInputStream* OpenEntry(wxInputStream* stream, size_t n) const;
+};
+
+
 /**
     @class wxZipClassFactory
 
@@ -619,5 +804,43 @@ public:
         @since 3.1.1
     */
     wxZipArchiveFormat GetFormat() const;
+
+    /**
+        Set the number of threads used for compressing the entries.
+
+        By default, the entries are compressed in the calling thread. When
+        more than one thread is used, the data of the entries is split into
+        chunks compressed concurrently by the tasks executed by the default
+        wxThreadPool, which can make creating archives with big or many
+        entries significantly faster on multi-core machines. The resulting
+        archive is still a standard zip file which can be read by any
+        program, but it may be slightly bigger than when using a single
+        thread.
+
+        Note that the compressed entries are written to the underlying stream
+        asynchronously, i.e. not necessarily by the time CloseEntry() or
+        PutNextEntry() for the next entry returns, but only by the time Close()
+        does. Also, only wxZIP_METHOD_STORE and wxZIP_METHOD_DEFLATE methods
+        are supported for the entries compressed in parallel, even in the
+        derived classes overriding the protected OpenCompressor() function.
+
+        This function can't be called while an entry is being written.
+
+        @param numThreads The number of threads to use, 0 means to use as many
+            threads as there are CPUs and 1, which is the default, disables
+            parallel compression.
+
+        @since 3.2.9
+    */
+    void SetThreadCount(int numThreads);
+
+    /**
+        Returns the number of threads used for compressing the entries.
+
+        @see SetThreadCount()
+
+        @since 3.2.9
+    */
+    int GetThreadCount() const;
 };
 
@@ -24,6 +24,7 @@
 
 #include "wx/datectrl.h"
 #include "wx/except.h"
+#include "wx/hashmap.h"
 #include "wx/spinctrl.h"
 #include "wx/choice.h"
 #include "wx/imaglist.h"
@@ -1231,6 +1232,20 @@ wxDataViewColumnBase::~wxDataViewColumnBase()
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxDataViewCtrlBase, wxControl);
 
+namespace
+{
+
+// The best column width mode can't be stored in wxDataViewCtrlBase itself
+// without breaking ABI, so keep it here for the controls not using the
+// default one.
+WX_DECLARE_HASH_MAP(wxDataViewCtrlBase*, wxDataViewBestColumnWidthMode,
+                    wxPointerHash, wxPointerEqual,
+                    wxDataViewBestColumnWidthModes);
+
+wxDataViewBestColumnWidthModes gs_bestColumnWidthModes;
+
+} // anonymous namespace
+
 wxDataViewCtrlBase::wxDataViewCtrlBase()
 {
     m_model = NULL;
@@ -1240,6 +1255,8 @@ wxDataViewCtrlBase::wxDataViewCtrlBase()
 
 wxDataViewCtrlBase::~wxDataViewCtrlBase()
 {
+    gs_bestColumnWidthModes.erase(this);
+
     if (m_model)
     {
         m_model->DecRef();
@@ -1312,6 +1329,24 @@ void wxDataViewCtrlBase::ExpandAncestors( const wxDataViewItem & item )
     }
 }
 
+void
+wxDataViewCtrlBase::SetBestColumnWidthMode(wxDataViewBestColumnWidthMode mode)
+{
+    if ( mode == wxDATAVIEW_BEST_WIDTH_DEFAULT )
+        gs_bestColumnWidthModes.erase(this);
+    else
+        gs_bestColumnWidthModes[this] = mode;
+}
+
+wxDataViewBestColumnWidthMode wxDataViewCtrlBase::GetBestColumnWidthMode() const
+{
+    const wxDataViewBestColumnWidthModes::const_iterator
+        it = gs_bestColumnWidthModes.find(const_cast<wxDataViewCtrlBase*>(this));
+
+    return it == gs_bestColumnWidthModes.end() ? wxDATAVIEW_BEST_WIDTH_DEFAULT
+                                               : it->second;
+}
+
 wxDataViewItem wxDataViewCtrlBase::GetCurrentItem() const
 {
     return HasFlag(wxDV_MULTIPLE) ? DoGetCurrentItem()
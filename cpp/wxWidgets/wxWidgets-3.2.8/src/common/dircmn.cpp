@@ -31,6 +31,10 @@
 #include "wx/dir.h"
 #include "wx/filename.h"
 
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif // wxUSE_THREADS
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -94,6 +98,246 @@ wxString wxDir::GetNameWithSep() const
 // wxDir::Traverse()
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// Open the directory with the given name, asking the sink what to do if we
+// can't do it. Returns wxDIR_CONTINUE if the directory was opened or
+// wxDIR_IGNORE or wxDIR_STOP if it should be skipped or if the traversal
+// should be stopped entirely.
+wxDirTraverseResult
+OpenForTraversal(wxDir& dir, const wxString& dirname, wxDirTraverser& sink)
+{
+    for ( ;; )
+    {
+        // don't give the error messages for the directories which we can't
+        // open: there can be all sorts of good reason for this (e.g.
+        // insufficient privileges) and this shouldn't be treated as an error
+        // -- instead let the user code decide what to do
+        wxLogNull noLog;
+        if ( dir.Open(dirname) )
+            return wxDIR_CONTINUE;
+
+        // ask the user code what to do
+        switch ( sink.OnOpenError(dirname) )
+        {
+            default:
+                wxFAIL_MSG(wxT("unexpected OnOpenError() return value") );
+                wxFALLTHROUGH;
+
+            case wxDIR_STOP:
+                return wxDIR_STOP;
+
+            case wxDIR_IGNORE:
+                return wxDIR_IGNORE;
+
+            case wxDIR_CONTINUE:
+                // try again
+                break;
+        }
+    }
+}
+
+#if wxUSE_THREADS
+
+// State shared by all the tasks used by the parallel version of Traverse().
+class wxDirParallelTraversal
+{
+public:
+    wxDirParallelTraversal(wxDirTraverser& sink,
+                           const wxString& filespec,
+                           int flags)
+        : m_sink(sink),
+          m_filespec(filespec),
+          m_flags(flags),
+          m_pool(wxThreadPool::GetDefault()),
+          m_stopped(0),
+          m_cond(m_mutex),
+          m_pending(0),
+          m_nFiles(0)
+    {
+    }
+
+    wxDirTraverser& GetSink() const { return m_sink; }
+
+    bool IsStopped() const { return m_stopped != 0; }
+    void Stop() { wxAtomicInc(m_stopped); }
+
+    // Traverse the given directory itself, queuing its subdirectories for
+    // traversing them in the pool threads, and return the number of files
+    // in it.
+    size_t TraverseDir(const wxDir& dir);
+
+    // Called by the tasks when they finish traversing their directory.
+    void OnDirDone(size_t nFiles);
+
+    // Wait until all the queued directories are traversed and return the
+    // total number of files found in them.
+    size_t Wait();
+
+private:
+    void QueueDir(const wxString& dirname);
+
+    wxDirTraverser& m_sink;
+    const wxString m_filespec;
+    const int m_flags;
+
+    wxThreadPool& m_pool;
+
+    wxAtomicInt m_stopped;
+
+    // Protects m_pending and m_nFiles.
+    wxMutex m_mutex;
+    wxCondition m_cond;
+
+    // The number of directories queued but not traversed yet.
+    int m_pending;
+    size_t m_nFiles;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirParallelTraversal);
+};
+
+class wxDirTraverseTask : public wxThreadPoolTask
+{
+public:
+    wxDirTraverseTask(wxDirParallelTraversal& traversal,
+                      const wxString& dirname)
+        : m_traversal(traversal),
+          m_dirname(dirname)
+    {
+    }
+
+protected:
+    virtual void Run() wxOVERRIDE
+    {
+        size_t nFiles = 0;
+
+        if ( !m_traversal.IsStopped() )
+        {
+            wxDir dir;
+            switch ( OpenForTraversal(dir, m_dirname, m_traversal.GetSink()) )
+            {
+                case wxDIR_STOP:
+                    m_traversal.Stop();
+                    break;
+
+                case wxDIR_CONTINUE:
+                    nFiles = m_traversal.TraverseDir(dir);
+                    break;
+
+                case wxDIR_IGNORE:
+                    break;
+            }
+        }
+
+        // Note that m_traversal may be destroyed as soon as we return from
+        // this call, so it must be the last thing we do.
+        m_traversal.OnDirDone(nFiles);
+    }
+
+private:
+    wxDirParallelTraversal& m_traversal;
+    const wxString m_dirname;
+};
+
+size_t wxDirParallelTraversal::TraverseDir(const wxDir& dir)
+{
+    const wxString prefix = dir.GetNameWithSep();
+
+    // first, queue the subdirectories, so that they're traversed while we
+    // process our own files
+    if ( m_flags & wxDIR_DIRS )
+    {
+        wxString dirname;
+        for ( bool cont = dir.GetFirst(&dirname, wxEmptyString,
+                                       (m_flags & ~(wxDIR_FILES | wxDIR_DOTDOT))
+                                       | wxDIR_DIRS);
+              cont && !IsStopped();
+              cont = dir.GetNext(&dirname) )
+        {
+            const wxString fulldirname = prefix + dirname;
+
+            switch ( m_sink.OnDir(fulldirname) )
+            {
+                default:
+                    wxFAIL_MSG(wxT("unexpected OnDir() return value") );
+                    wxFALLTHROUGH;
+
+                case wxDIR_STOP:
+                    Stop();
+                    break;
+
+                case wxDIR_CONTINUE:
+                    QueueDir(fulldirname);
+                    break;
+
+                case wxDIR_IGNORE:
+                    // nothing to do
+                    ;
+            }
+        }
+    }
+
+    size_t nFiles = 0;
+
+    if ( m_flags & wxDIR_FILES )
+    {
+        wxString filename;
+        for ( bool cont = dir.GetFirst(&filename, m_filespec,
+                                       m_flags & ~wxDIR_DIRS);
+              cont && !IsStopped();
+              cont = dir.GetNext(&filename) )
+        {
+            wxDirTraverseResult res = m_sink.OnFile(prefix + filename);
+            if ( res == wxDIR_STOP )
+            {
+                Stop();
+                break;
+            }
+
+            wxASSERT_MSG( res == wxDIR_CONTINUE,
+                          wxT("unexpected OnFile() return value") );
+
+            nFiles++;
+        }
+    }
+
+    return nFiles;
+}
+
+void wxDirParallelTraversal::QueueDir(const wxString& dirname)
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_pending++;
+    }
+
+    m_pool.Submit(new wxDirTraverseTask(*this, dirname));
+}
+
+void wxDirParallelTraversal::OnDirDone(size_t nFiles)
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_nFiles += nFiles;
+    if ( !--m_pending )
+        m_cond.Signal();
+}
+
+size_t wxDirParallelTraversal::Wait()
+{
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_pending )
+        m_cond.Wait();
+
+    return m_nFiles;
+}
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
 size_t wxDir::Traverse(wxDirTraverser& sink,
                        const wxString& filespec,
                        int flags) const
@@ -101,6 +345,26 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
     wxCHECK_MSG( IsOpened(), (size_t)-1,
                  wxT("dir must be opened before traversing it") );
 
+    if ( flags & wxDIR_PARALLEL )
+    {
+        flags &= ~wxDIR_PARALLEL;
+
+#if wxUSE_THREADS
+        // Blocking a pool thread while waiting for the other tasks could
+        // result in a deadlock, so just do everything in it directly then,
+        // and there is no point in using the pool if it has a single thread.
+        wxThreadPool& pool = wxThreadPool::GetDefault();
+        if ( pool.GetThreadCount() > 1 && !pool.IsWorkerThread() )
+        {
+            wxDirParallelTraversal traversal(sink, filespec, flags);
+
+            const size_t nFiles = traversal.TraverseDir(*this);
+
+            return nFiles + traversal.Wait();
+        }
+#endif // wxUSE_THREADS
+    }
+
     // the total number of files found
     size_t nFiles = 0;
 
@@ -132,48 +396,18 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
                 case wxDIR_CONTINUE:
                     {
                         wxDir subdir;
-
-                        // don't give the error messages for the directories
-                        // which we can't open: there can be all sorts of good
-                        // reason for this (e.g. insufficient privileges) and
-                        // this shouldn't be treated as an error -- instead
-                        // let the user code decide what to do
-                        bool ok;
-                        do
+                        switch ( OpenForTraversal(subdir, fulldirname, sink) )
                         {
-                            wxLogNull noLog;
-                            ok = subdir.Open(fulldirname);
-                            if ( !ok )
-                            {
-                                // ask the user code what to do
-                                bool tryagain;
-                                switch ( sink.OnOpenError(fulldirname) )
-                                {
-                                    default:
-                                        wxFAIL_MSG(wxT("unexpected OnOpenError() return value") );
-                                        wxFALLTHROUGH;
-
-                                    case wxDIR_STOP:
-                                        cont = false;
-                                        wxFALLTHROUGH;
-
-                                    case wxDIR_IGNORE:
-                                        tryagain = false;
-                                        break;
-
-                                    case wxDIR_CONTINUE:
-                                        tryagain = true;
-                                }
-
-                                if ( !tryagain )
-                                    break;
-                            }
-                        }
-                        while ( !ok );
+                            case wxDIR_STOP:
+                                cont = false;
+                                break;
 
-                        if ( ok )
-                        {
-                            nFiles += subdir.Traverse(sink, filespec, flags);
+                            case wxDIR_CONTINUE:
+                                nFiles += subdir.Traverse(sink, filespec, flags);
+                                break;
+
+                            case wxDIR_IGNORE:
+                                break;
                         }
                     }
                     break;
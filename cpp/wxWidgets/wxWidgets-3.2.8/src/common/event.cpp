@@ -44,8 +44,17 @@
 
 #include "wx/thread.h"
 
+// Use lock-free operations for posting the events if the compiler provides
+// them, otherwise protect the list of posted events with a critical section.
+#if wxUSE_THREADS && wxCHECK_CXX_STD(201103L)
+    #define wxHAS_LOCKFREE_EVENT_QUEUE
+
+    #include <atomic>
+#endif
+
 #if wxUSE_BASE
     #include "wx/scopedptr.h"
+    #include "wx/weakref.h"
 
     wxDECLARE_SCOPED_PTR(wxEvent, wxEventPtr)
     wxDEFINE_SCOPED_PTR(wxEvent, wxEventPtr)
@@ -1197,6 +1206,252 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxPendingEventQueue
+// ----------------------------------------------------------------------------
+
+// This class stores the events queued for a single wxEvtHandler.
+//
+// New events can be posted to it from any thread without waiting for the
+// events processing to finish: they are pushed on a lock-free stack, which is
+// taken over as a whole by the thread processing the events and appended, in
+// the right order, to the vector of ready events. The latter is only used by the processing thread, i.e. with
+// the handler m_pendingEventsLock locked.
+//
+// This class also remembers whether the handler was already scheduled, i.e.
+// added to the list of the handlers with pending events in wxApp, to avoid
+// doing it (and waking up the event loop) again for every new event.
+//
+// It derives from wxList only to be stored in wxEvtHandler::m_pendingEvents,
+// the base class list itself is never used.
+class wxPendingEventQueue : public wxList
+{
+public:
+    wxPendingEventQueue()
+        : m_posted(NULL),
+          m_scheduled(false)
+    {
+        m_firstReady = 0;
+    }
+
+    ~wxPendingEventQueue()
+    {
+        DeleteAll();
+    }
+
+    // Add a new event, this can be called from any thread.
+    //
+    // Returns true if the handler must be scheduled by the caller.
+    bool Post(wxEvent* event)
+    {
+        Node* const node = new Node(event);
+
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+        node->m_next = m_posted.load(std::memory_order_relaxed);
+        while ( !m_posted.compare_exchange_weak(node->m_next, node) )
+            ;
+
+        return !m_scheduled.exchange(true);
+#else // !wxHAS_LOCKFREE_EVENT_QUEUE
+        wxCRIT_SECT_LOCKER(lock, m_postedLock);
+
+        node->m_next = m_posted;
+        m_posted = node;
+
+        const bool wasScheduled = m_scheduled;
+        m_scheduled = true;
+
+        return !wasScheduled;
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE/!wxHAS_LOCKFREE_EVENT_QUEUE
+    }
+
+    // All the other functions can only be called by the thread processing the
+    // events.
+
+    // Move all the events posted until now to the end of the ready events.
+    void TakePosted()
+    {
+        Node* node = TakePostedNodes();
+        if ( !node )
+            return;
+
+        // Get rid of the already processed events first.
+        if ( m_firstReady )
+        {
+            m_ready.erase(m_ready.begin(), m_ready.begin() + m_firstReady);
+            m_firstReady = 0;
+        }
+
+        // The posted events are stored in LIFO order, so fill the new part of
+        // the vector starting from its end.
+        size_t n = m_ready.size();
+        for ( const Node* p = node; p; p = p->m_next )
+            n++;
+
+        m_ready.resize(n);
+        while ( node )
+        {
+            Node* const next = node->m_next;
+            m_ready[--n] = node->m_event;
+            delete node;
+            node = next;
+        }
+    }
+
+    bool HasReady() const { return m_firstReady < m_ready.size(); }
+
+    bool HasPosted() const
+    {
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+        return m_posted.load() != NULL;
+#else
+        wxCRIT_SECT_LOCKER(lock, m_postedLock);
+
+        return m_posted != NULL;
+#endif
+    }
+
+    // Remove and return the first ready event which can be processed inside
+    // the given event loop if it's non-NULL or just the first one otherwise.
+    //
+    // Returns NULL if there are no such events.
+    wxEvent* PopReady(wxEventLoopBase* yieldingLoop)
+    {
+        for ( size_t n = m_firstReady; n < m_ready.size(); n++ )
+        {
+            wxEvent* const event = m_ready[n];
+            if ( yieldingLoop &&
+                    !yieldingLoop->IsEventAllowedInsideYield(event->GetEventCategory()) )
+                continue;
+
+            if ( n == m_firstReady )
+                m_firstReady++;
+            else
+                m_ready.erase(m_ready.begin() + n);
+
+            if ( m_firstReady == m_ready.size() )
+            {
+                // Don't use clear() to avoid freeing the memory.
+                m_ready.resize(0);
+                m_firstReady = 0;
+            }
+
+            return event;
+        }
+
+        return NULL;
+    }
+
+    // Reset the scheduled flag after removing the handler from the list of
+    // the handlers with pending events.
+    //
+    // Returns false if new events were posted in the meanwhile and the
+    // handler must be scheduled again by the caller.
+    bool Unschedule()
+    {
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+        m_scheduled.store(false);
+        if ( !m_posted.load() )
+            return true;
+
+        // If the flag was set again, it was done by Post() after we had reset
+        // it, and then its caller will schedule the handler, so we must not.
+        return m_scheduled.exchange(true);
+#else // !wxHAS_LOCKFREE_EVENT_QUEUE
+        wxCRIT_SECT_LOCKER(lock, m_postedLock);
+
+        if ( m_posted )
+            return false;
+
+        m_scheduled = false;
+
+        return true;
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE/!wxHAS_LOCKFREE_EVENT_QUEUE
+    }
+
+    // Delete all the events, posted or ready, and reset the scheduled flag.
+    void DeleteAll()
+    {
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+        // Reset the flag before taking the events, so that any events posted
+        // after this are not lost.
+        m_scheduled.store(false);
+#else
+        {
+            wxCRIT_SECT_LOCKER(lock, m_postedLock);
+            m_scheduled = false;
+        }
+#endif
+
+        for ( Node* node = TakePostedNodes(); node; )
+        {
+            Node* const next = node->m_next;
+            delete node->m_event;
+            delete node;
+            node = next;
+        }
+
+        for ( size_t n = m_firstReady; n < m_ready.size(); n++ )
+            delete m_ready[n];
+
+        m_ready.resize(0);
+        m_firstReady = 0;
+    }
+
+private:
+    struct Node
+    {
+        explicit Node(wxEvent* event) : m_event(event), m_next(NULL) { }
+
+        wxEvent* const m_event;
+        Node* m_next;
+    };
+
+    Node* TakePostedNodes()
+    {
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+        return m_posted.exchange(NULL);
+#else
+        wxCRIT_SECT_LOCKER(lock, m_postedLock);
+
+        Node* const node = m_posted;
+        m_posted = NULL;
+
+        return node;
+#endif
+    }
+
+
+#ifdef wxHAS_LOCKFREE_EVENT_QUEUE
+    // The stack of the posted events, in LIFO order.
+    std::atomic<Node*> m_posted;
+
+    // True if the handler is, or is about to be, in wxApp list.
+    std::atomic<bool> m_scheduled;
+#else // !wxHAS_LOCKFREE_EVENT_QUEUE
+    Node* m_posted;
+    bool m_scheduled;
+
+#if wxUSE_THREADS
+    // Protects both fields above.
+    mutable wxCriticalSection m_postedLock;
+#endif // wxUSE_THREADS
+#endif // wxHAS_LOCKFREE_EVENT_QUEUE/!wxHAS_LOCKFREE_EVENT_QUEUE
+
+    // The events which can be processed, starting at m_firstReady index.
+    wxVector<wxEvent*> m_ready;
+    size_t m_firstReady;
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventQueue);
+};
+
+// wxEvtHandler::m_pendingEvents is declared as wxList in the public header
+// for compatibility, but it always points to wxPendingEventQueue.
+static inline wxPendingEventQueue* wxGetPendingEventQueue(wxList* list)
+{
+    return static_cast<wxPendingEventQueue*>(list);
+}
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
@@ -1250,6 +1505,7 @@ wxEvtHandler::~wxEvtHandler()
         wxTheApp->RemovePendingEventHandler(this);
 
     DeletePendingEvents();
+    delete wxGetPendingEventQueue(m_pendingEvents);
 
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
@@ -1346,37 +1602,40 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
-    // 1) Add this event to our list of pending events
+    // 1) Add this event to our queue of pending events, creating it first if
+    //    necessary. We only need to lock for accessing the queue pointer, the
+    //    event itself is added to it without locking, so that we don't block
+    //    while ProcessPendingEvents() is running.
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
     if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
+        m_pendingEvents = new wxPendingEventQueue;
 
-    m_pendingEvents->Append(event);
+    wxPendingEventQueue* const queue = wxGetPendingEventQueue(m_pendingEvents);
 
-    // 2) Add this event handler to list of event handlers that
-    //    have pending events.
-
-    wxTheApp->AppendPendingEventHandler(this);
-
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
     wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-    // 3) Inform the system that new pending events are somewhere,
-    //    and that these should be processed in idle time.
-    wxWakeUpIdle();
+    // 2) Unless it had been already done for a previous event, add this event
+    //    handler to the list of event handlers that have pending events and
+    //    inform the system that these should be processed in idle time.
+    //
+    //    Notice that the event can be processed by ProcessPendingEvents()
+    //    before we get to AppendPendingEventHandler() here, in which case our
+    //    handler will stay in the list of the handlers with pending events
+    //    without having any (see ticket #9093 for the original problem). This
+    //    is harmless as ProcessPendingEvents() will just remove it later.
+    if ( queue->Post(event) )
+    {
+        wxTheApp->AppendPendingEventHandler(this);
+
+        wxWakeUpIdle();
+    }
 }
 
 void wxEvtHandler::DeletePendingEvents()
 {
     if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
-    wxDELETE(m_pendingEvents);
+        wxGetPendingEventQueue(m_pendingEvents)->DeleteAll();
 }
 
 void wxEvtHandler::ProcessPendingEvents()
@@ -1389,68 +1648,72 @@ void wxEvtHandler::ProcessPendingEvents()
         return;
     }
 
-    // we need to process only a single pending event in this call because
-    // each call to ProcessEvent() could result in the destruction of this
-    // same event handler (see the comment at the end of this function)
+    // we process all the events queued so far in a single call, but each call
+    // to ProcessEvent() could result in the destruction of this same event
+    // handler, so we need to check for it after processing every event
+    wxEvtHandlerRef self(this);
 
     wxENTER_CRIT_SECT( m_pendingEventsLock );
 
-    // this method is only called by wxApp if this handler does have
-    // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+    wxPendingEventQueue* const queue = wxGetPendingEventQueue(m_pendingEvents);
+    if ( queue )
+        queue->TakePosted();
 
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
-
-    // find the first event which can be processed now:
-    wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
-    if (evtLoop && evtLoop->IsYielding())
+    for ( ;; )
     {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
-        {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : NULL;
-        }
+        // find the first event which can be processed now:
+        wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
+        if ( evtLoop && !evtLoop->IsYielding() )
+            evtLoop = NULL;
 
-        if (!node)
+        wxEvent* const pEvent = queue ? queue->PopReady(evtLoop) : NULL;
+        if ( !pEvent )
         {
-            // all our events are NOT processable now... signal this:
-            wxTheApp->DelayPendingEventHandler(this);
+            if ( queue && queue->HasReady() )
+            {
+                // all our events are NOT processable now... signal this:
+                wxTheApp->DelayPendingEventHandler(this);
 
-            // see the comment at the beginning of evtloop.h header for the
-            // logic behind YieldFor() and behind DelayPendingEventHandler()
+                // see the comment at the beginning of evtloop.h header for the
+                // logic behind YieldFor() and behind DelayPendingEventHandler()
+            }
+            else if ( !queue || !queue->HasPosted() )
+            {
+                // if there are no more pending events left, we don't need to
+                // stay in this list
+                wxTheApp->RemovePendingEventHandler(this);
 
-            wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+                if ( queue && !queue->Unschedule() )
+                    wxTheApp->AppendPendingEventHandler(this);
+            }
+            //else: more events were queued while we were processing the
+            //      previous ones, they will be processed during the next call
 
-            return;
+            break;
         }
-    }
 
-    wxEventPtr event(pEvent);
+        // notice that the event has been already removed from the queue,
+        // which is important as otherwise a nested event loop, for example
+        // from a modal dialog, might process the same event again.
+        wxEventPtr event(pEvent);
 
-    // it's important we remove event from list before processing it, else a
-    // nested event loop, for example from a modal dialog, might process the
-    // same event again.
-    m_pendingEvents->Erase(node);
+        wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 
-    if ( m_pendingEvents->IsEmpty() )
-    {
-        // if there are no more pending events left, we don't need to
-        // stay in this list
-        wxTheApp->RemovePendingEventHandler(this);
-    }
+        // We must not let exceptions escape from here, there is no outer
+        // exception handler to catch them and so letting them do it would
+        // just terminate the program.
+        SafelyProcessEvent(*event);
 
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+        // careful: this object could have been deleted by the event handler
+        // executed by the above ProcessEvent() call, so we can't access any
+        // fields of this object any more in this case
+        if ( !self )
+            return;
 
-    // We must not let exceptions escape from here, there is no outer exception
-    // handler to catch them and so letting them do it would just terminate the
-    // program.
-    SafelyProcessEvent(*event);
+        wxENTER_CRIT_SECT( m_pendingEventsLock );
+    }
 
-    // careful: this object could have been deleted by the event handler
-    // executed by the above ProcessEvent() call, so we can't access any fields
-    // of this object any more
+    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
 }
 
 /* static */
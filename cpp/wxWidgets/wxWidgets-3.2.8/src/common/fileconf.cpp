@@ -21,6 +21,7 @@
 
 #ifndef   WX_PRECOMP
     #include  "wx/dynarray.h"
+    #include  "wx/hashmap.h"
     #include  "wx/string.h"
     #include  "wx/intl.h"
     #include  "wx/log.h"
@@ -60,8 +61,11 @@
 // ----------------------------------------------------------------------------
 
 // compare functions for sorting the arrays
-static int LINKAGEMODE CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
-static int LINKAGEMODE CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+static int LINKAGEMODE CompareEntries(wxFileConfigEntry **p1, wxFileConfigEntry **p2);
+static int LINKAGEMODE CompareGroups(wxFileConfigGroup **p1, wxFileConfigGroup **p2);
+
+// return the key used for the entry or group with the given name in the index
+static inline wxString GetIndexKey(const wxString& name);
 
 // filter strings
 static wxString FilterInValue(const wxString& str);
@@ -75,18 +79,22 @@ static wxString FilterOutEntryName(const wxString& str);
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// "template" array types
+// "template" array and hash types
 // ----------------------------------------------------------------------------
 
-#ifdef WXMAKINGDLL_BASE
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigEntry *, ArrayEntries,
-                                         WXDLLIMPEXP_BASE);
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigGroup *, ArrayGroups,
-                                         WXDLLIMPEXP_BASE);
-#else
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigEntry *, ArrayEntries);
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
-#endif
+// The arrays are not kept sorted all the time, as inserting into a sorted
+// array is too slow when reading files with many entries, but only sorted
+// when they need to be enumerated.
+WX_DEFINE_ARRAY_PTR(wxFileConfigEntry *, ArrayEntries);
+WX_DEFINE_ARRAY_PTR(wxFileConfigGroup *, ArrayGroups);
+
+// Maps the entries and groups keys, as returned by GetIndexKey(), to them.
+WX_DECLARE_STRING_HASH_MAP(wxFileConfigEntry *, IndexEntries);
+WX_DECLARE_STRING_HASH_MAP(wxFileConfigGroup *, IndexGroups);
+
+// Maps the lines to the groups starting at them.
+WX_DECLARE_HASH_MAP(wxFileConfigLineList *, wxFileConfigGroup *,
+                    wxPointerHash, wxPointerEqual, GroupsByLine);
 
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
@@ -172,6 +180,10 @@ private:
   wxFileConfigGroup  *m_pParent;    // parent group (NULL for root group)
   ArrayEntries  m_aEntries;         // entries in this group
   ArrayGroups   m_aSubgroups;       // subgroups
+  IndexEntries  m_indexEntries;     // the same entries and subgroups indexed
+  IndexGroups   m_indexSubgroups;   // by their names for fast lookup
+  bool          m_entriesSorted:1,  // true if the corresponding array is
+                m_subgroupsSorted:1;// currently sorted
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
@@ -195,9 +207,10 @@ public:
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
-  const ArrayGroups&  Groups()  const { return m_aSubgroups; }
-  bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
+  // these functions return sorted arrays
+  const ArrayEntries& Entries();
+  const ArrayGroups&  Groups();
+  bool  IsEmpty() const { return m_aEntries.IsEmpty() && m_aSubgroups.IsEmpty(); }
 
   // find entry/subgroup (NULL if not found)
   wxFileConfigGroup *FindSubgroup(const wxString& name) const;
@@ -671,6 +684,11 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         return true;
     }
 
+    // Nothing to do if the path doesn't change, as is often the case when the
+    // application sets the same path before reading every entry.
+    if ( strPath == m_strPath )
+        return true;
+
     if ( strPath[0] == wxCONFIG_PATH_SEPARATOR ) {
         // absolute path
         wxSplitPath(aParts, strPath);
@@ -1153,21 +1171,44 @@ bool wxFileConfig::DeleteAll()
 // linked list functions
 // ----------------------------------------------------------------------------
 
-    // append a new line to the end of the list
+// Return true if tracing of wxFileConfig operations is enabled: this is used
+// to avoid constructing the arguments of wxLogTrace() in the functions called
+// for every line when parsing the file, which is surprisingly expensive.
+static inline bool IsTraceEnabled()
+{
+#if wxUSE_LOG_TRACE
+    return wxLog::IsAllowedTraceMask(FILECONF_TRACE_MASK);
+#else
+    return false;
+#endif
+}
 
-wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
+// Log the first and the last lines of the list.
+static void
+LogLineListEnds(wxFileConfigLineList *head, wxFileConfigLineList *tail)
 {
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("    ** Adding Line '%s'"),
-                str );
+    if ( !IsTraceEnabled() )
+        return;
+
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
+                head ? head->Text() : wxString() );
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+                tail ? tail->Text() : wxString() );
+}
+
+    // append a new line to the end of the list
+
+wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
+{
+    if ( IsTraceEnabled() )
+    {
+        wxLogTrace( FILECONF_TRACE_MASK,
+                    wxT("    ** Adding Line '%s'"),
+                    str );
+    }
+    LogLineListEnds(m_linesHead, m_linesTail);
 
     wxFileConfigLineList *pLine = new wxFileConfigLineList(str);
 
@@ -1185,14 +1226,7 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
 
     m_linesTail = pLine;
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    LogLineListEnds(m_linesHead, m_linesTail);
 
     return m_linesTail;
 }
@@ -1206,14 +1240,7 @@ wxFileConfigLineList *wxFileConfig::LineListInsert(const wxString& str,
                 str,
                 ((pLine) ? pLine->Text()
                          : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    LogLineListEnds(m_linesHead, m_linesTail);
 
     if ( pLine == m_linesTail )
         return LineListAppend(str);
@@ -1236,14 +1263,7 @@ wxFileConfigLineList *wxFileConfig::LineListInsert(const wxString& str,
         pLine->SetNext(pNewLine);
     }
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    LogLineListEnds(m_linesHead, m_linesTail);
 
     return pNewLine;
 }
@@ -1253,14 +1273,7 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("    ** Removing Line '%s'"),
                 pLine->Text() );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    LogLineListEnds(m_linesHead, m_linesTail);
 
     wxFileConfigLineList    *pPrev = pLine->Prev(),
                             *pNext = pLine->Next();
@@ -1279,14 +1292,7 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
     else
         pNext->SetPrev(pPrev);
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    LogLineListEnds(m_linesHead, m_linesTail);
 
     delete pLine;
 }
@@ -1308,10 +1314,11 @@ bool wxFileConfig::LineListIsEmpty()
 wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
                                        const wxString& strName,
                                        wxFileConfig *pConfig)
-                         : m_aEntries(CompareEntries),
-                           m_aSubgroups(CompareGroups),
-                           m_strName(strName)
+                         : m_strName(strName)
 {
+  m_entriesSorted =
+  m_subgroupsSorted = true;
+
   m_pConfig = pConfig;
   m_pParent = pParent;
   m_pLine   = NULL;
@@ -1506,13 +1513,14 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     if ( newName == m_strName )
         return;
 
-    // we need to remove the group from the parent and it back under the new
-    // name to keep the parents array of subgroups alphabetically sorted
-    m_pParent->m_aSubgroups.Remove(this);
+    // update the parent index and let it know that its subgroups need to be
+    // sorted again
+    m_pParent->m_indexSubgroups.erase(GetIndexKey(m_strName));
 
     m_strName = newName;
 
-    m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_indexSubgroups[GetIndexKey(m_strName)] = this;
+    m_pParent->m_subgroupsSorted = false;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1531,67 +1539,46 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+  const IndexEntries::const_iterator it = m_indexEntries.find(GetIndexKey(name));
 
-  return NULL;
+  return it == m_indexEntries.end() ? NULL : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
+  const IndexGroups::const_iterator it = m_indexSubgroups.find(GetIndexKey(name));
+
+  return it == m_indexSubgroups.end() ? NULL : it->second;
+}
+
+// ----------------------------------------------------------------------------
+// sorted access
+// ----------------------------------------------------------------------------
+
+const ArrayEntries& wxFileConfigGroup::Entries()
+{
+  if ( !m_entriesSorted )
+  {
+    m_aEntries.Sort(CompareEntries);
+    m_entriesSorted = true;
   }
 
-  return NULL;
+  return m_aEntries;
+}
+
+const ArrayGroups& wxFileConfigGroup::Groups()
+{
+  if ( !m_subgroupsSorted )
+  {
+    m_aSubgroups.Sort(CompareGroups);
+    m_subgroupsSorted = true;
+  }
+
+  return m_aSubgroups;
 }
 
 // ----------------------------------------------------------------------------
@@ -1605,7 +1592,14 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
 
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
+    // the array remains sorted if the entries are added in order, as is
+    // usually the case for the files written by wxFileConfig itself
+    if ( m_entriesSorted && !m_aEntries.IsEmpty() &&
+            CompareEntries(&m_aEntries.Last(), &pEntry) > 0 )
+        m_entriesSorted = false;
+
     m_aEntries.Add(pEntry);
+    m_indexEntries[GetIndexKey(pEntry->Name())] = pEntry;
     return pEntry;
 }
 
@@ -1616,7 +1610,12 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
 
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
+    if ( m_subgroupsSorted && !m_aSubgroups.IsEmpty() &&
+            CompareGroups(&m_aSubgroups.Last(), &pGroup) > 0 )
+        m_subgroupsSorted = false;
+
     m_aSubgroups.Add(pGroup);
+    m_indexSubgroups[GetIndexKey(strName)] = pGroup;
     return pGroup;
 }
 
@@ -1715,22 +1714,24 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
             // group line
             const size_t nSubgroups = m_aSubgroups.GetCount();
 
+            // do _not_ call GetGroupLine! we don't want to add it to the
+            // local file if it's not already there
+            GroupsByLine groupsByLine(nSubgroups);
+            for ( size_t n = 0; n < nSubgroups; n++ )
+            {
+                if ( m_aSubgroups[n]->m_pLine )
+                    groupsByLine[m_aSubgroups[n]->m_pLine] = m_aSubgroups[n];
+            }
+
             m_pLastGroup = NULL;
             for ( wxFileConfigLineList *pl = pLine->Prev();
                   pl && !m_pLastGroup;
                   pl = pl->Prev() )
             {
                 // does this line belong to our subgroup?
-                for ( size_t n = 0; n < nSubgroups; n++ )
-                {
-                    // do _not_ call GetGroupLine! we don't want to add it to
-                    // the local file if it's not already there
-                    if ( m_aSubgroups[n]->m_pLine == pl )
-                    {
-                        m_pLastGroup = m_aSubgroups[n];
-                        break;
-                    }
-                }
+                const GroupsByLine::const_iterator it = groupsByLine.find(pl);
+                if ( it != groupsByLine.end() )
+                    m_pLastGroup = it->second;
 
                 if ( pl == m_pLine )
                     break;
@@ -1747,6 +1748,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     m_aSubgroups.Remove(pGroup);
+    m_indexSubgroups.erase(GetIndexKey(pGroup->Name()));
     delete pGroup;
 
     return true;
@@ -1795,6 +1797,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
   }
 
   m_aEntries.Remove(pEntry);
+  m_indexEntries.erase(GetIndexKey(pEntry->Name()));
   delete pEntry;
 
   return true;
@@ -1901,21 +1904,34 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 // compare functions for array sorting
 // ----------------------------------------------------------------------------
 
-int CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
+int CompareEntries(wxFileConfigEntry **p1, wxFileConfigEntry **p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return (*p1)->Name().compare((*p2)->Name());
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return (*p1)->Name().CmpNoCase((*p2)->Name());
 #endif
 }
 
-int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
+int CompareGroups(wxFileConfigGroup **p1, wxFileConfigGroup **p2)
+{
+#if wxCONFIG_CASE_SENSITIVE
+    return (*p1)->Name().compare((*p2)->Name());
+#else
+    return (*p1)->Name().CmpNoCase((*p2)->Name());
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// index key
+// ----------------------------------------------------------------------------
+
+static inline wxString GetIndexKey(const wxString& name)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return name;
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return name.Lower();
 #endif
 }
 
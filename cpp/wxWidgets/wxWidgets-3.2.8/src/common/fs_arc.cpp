@@ -20,6 +20,10 @@
 #include "wx/archive.h"
 #include "wx/private/fileback.h"
 
+#if wxUSE_ZIPSTREAM
+    #include "wx/zipstrm.h"
+#endif
+
 //---------------------------------------------------------------------------
 // wxArchiveFSCacheDataImpl
 //
@@ -30,6 +34,10 @@
 // wxArchiveFSCacheData class below. It was done that way to allow sharing
 // between instances of wxFileSystem, though that's a feature not used in this
 // version.
+//
+// For the zips read from seekable streams, the entries are looked up and
+// opened using wxZipIndex instead of reading the catalog sequentially, which
+// is much faster for the big archives.
 //---------------------------------------------------------------------------
 
 WX_DECLARE_STRING_HASH_MAP(wxArchiveEntry*, wxArchiveFSEntryHash);
@@ -56,6 +64,10 @@ public:
     wxArchiveEntry *Get(const wxString& name);
     wxInputStream *NewStream() const;
 
+    wxArchiveInputStream *OpenEntry(const wxArchiveClassFactory& factory,
+                                    wxArchiveEntry& entry,
+                                    wxInputStream *stream) const;
+
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse);
 
 private:
@@ -71,6 +83,11 @@ private:
     wxBackingFile m_backer;
     wxInputStream *m_stream;
     wxArchiveInputStream *m_archive;
+
+#if wxUSE_ZIPSTREAM
+    wxZipIndex m_zipIndex;
+    wxArchiveFSEntryHash m_indexed;
+#endif
 };
 
 wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
@@ -94,11 +111,22 @@ wxArchiveFSCacheDataImpl::wxArchiveFSCacheDataImpl(
     m_stream(stream),
     m_archive(factory.NewStream(*m_stream))
 {
+#if wxUSE_ZIPSTREAM
+    if (wxDynamicCast(&factory, wxZipClassFactory))
+    {
+        // any errors are reported when falling back to reading the catalog
+        wxLogNull nolog;
+        m_zipIndex.Create(*m_stream, factory.GetConv());
+    }
+#endif
 }
 
 wxArchiveFSCacheDataImpl::~wxArchiveFSCacheDataImpl()
 {
     WX_CLEAR_HASH_MAP(wxArchiveFSEntryHash, m_hash);
+#if wxUSE_ZIPSTREAM
+    WX_CLEAR_HASH_MAP(wxArchiveFSEntryHash, m_indexed);
+#endif
 
     wxArchiveFSEntry *entry = m_begin;
 
@@ -131,6 +159,23 @@ void wxArchiveFSCacheDataImpl::CloseStreams()
 
 wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
 {
+#if wxUSE_ZIPSTREAM
+    if (m_zipIndex.IsOk())
+    {
+        wxArchiveFSEntryHash::iterator it = m_indexed.find(name);
+        if (it != m_indexed.end())
+            return it->second;
+
+        int n = m_zipIndex.Find(name);
+        if (n == wxNOT_FOUND)
+            return NULL;
+
+        wxArchiveEntry *entry = m_zipIndex.GetEntry(n);
+        m_indexed[name] = entry;
+        return entry;
+    }
+#endif // wxUSE_ZIPSTREAM
+
     wxArchiveFSEntryHash::iterator it = m_hash.find(name);
 
     if (it != m_hash.end())
@@ -162,6 +207,35 @@ wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
         return NULL;
 }
 
+wxArchiveInputStream *wxArchiveFSCacheDataImpl::OpenEntry(
+        const wxArchiveClassFactory& factory,
+        wxArchiveEntry& entry,
+        wxInputStream *stream) const
+{
+#if wxUSE_ZIPSTREAM
+    if (m_zipIndex.IsOk())
+    {
+        int n = m_zipIndex.Find(entry.GetName(wxPATH_UNIX));
+        if (n != wxNOT_FOUND)
+            return m_zipIndex.OpenEntry(stream, n);
+    }
+#endif // wxUSE_ZIPSTREAM
+
+    wxArchiveInputStream *s = factory.NewStream(stream);
+    if ( !s )
+        return NULL;
+
+    s->OpenEntry(entry);
+
+    if (!s->IsOk())
+    {
+        delete s;
+        return NULL;
+    }
+
+    return s;
+}
+
 wxArchiveFSEntry *wxArchiveFSCacheDataImpl::GetNext(wxArchiveFSEntry *fse)
 {
     wxArchiveFSEntry *next = fse ? fse->next : m_begin;
@@ -203,6 +277,10 @@ public:
 
     wxArchiveEntry *Get(const wxString& name) { return m_impl->Get(name); }
     wxInputStream *NewStream() const { return m_impl->NewStream(); }
+    wxArchiveInputStream *OpenEntry(const wxArchiveClassFactory& factory,
+                                    wxArchiveEntry& entry,
+                                    wxInputStream *stream) const
+        { return m_impl->OpenEntry(factory, entry, stream); }
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse)
         { return m_impl->GetNext(fse); }
 
@@ -381,18 +459,10 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
         delete leftFile;
     }
 
-    wxArchiveInputStream *s = factory->NewStream(leftStream);
+    wxArchiveInputStream *s = cached->OpenEntry(*factory, *entry, leftStream);
     if ( !s )
         return NULL;
 
-    s->OpenEntry(*entry);
-
-    if (!s->IsOk())
-    {
-        delete s;
-        return NULL;
-    }
-
     return new wxFSFile(s,
                         key + right,
                         wxEmptyString,
@@ -121,29 +121,7 @@ wxFileSystemWatcherBase::AddAny(const wxFileName& path,
     if (canonical.IsEmpty())
         return false;
 
-    // Check if the patch isn't already being watched.
-    wxFSWatchInfoMap::iterator it = m_watches.find(canonical);
-    if ( it == m_watches.end() )
-    {
-        // It isn't, so start watching it in a platform specific way:
-        wxFSWatchInfo watch(canonical, events, type, filespec);
-        if ( !m_service->Add(watch) )
-            return false;
-
-        wxFSWatchInfoMap::value_type val(canonical, watch);
-        m_watches.insert(val);
-    }
-    else
-    {
-        wxFSWatchInfo& watch2 = it->second;
-        const int count = watch2.IncRef();
-
-        wxLogTrace(wxTRACE_FSWATCHER,
-                   "'%s' is now watched %d times", canonical, count);
-
-        wxUnusedVar(count); // could be unused if debug tracing is disabled
-    }
-    return true;
+    return m_service->AddWatch(canonical, events, type, filespec);
 }
 
 bool wxFileSystemWatcherBase::Remove(const wxFileName& path)
@@ -153,149 +131,63 @@ bool wxFileSystemWatcherBase::Remove(const wxFileName& path)
     if (canonical.IsEmpty())
         return false;
 
-    wxFSWatchInfoMap::iterator it = m_watches.find(canonical);
-    wxCHECK_MSG(it != m_watches.end(), false,
-                wxString::Format("Path '%s' is not watched", canonical));
-
-    // Decrement the watch's refcount and remove from watch-list if 0
-    bool ret = true;
-    wxFSWatchInfo& watch = it->second;
-    if ( !watch.DecRef() )
-    {
-        // remove in a platform specific way
-        ret = m_service->Remove(watch);
-
-        m_watches.erase(it);
-    }
-    return ret;
+    return m_service->RemoveWatch(canonical);
 }
 
-bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
-                                      const wxString& filespec)
+// Return the flags to use for traversing the tree rooted at the given path.
+static int GetTreeTraverseFlags(const wxFileName& path)
 {
-    if (!path.DirExists())
-        return false;
-
-    // OPT could be optimised if we stored information about relationships
-    // between paths
-    class AddTraverser : public wxDirTraverser
-    {
-    public:
-        AddTraverser(wxFileSystemWatcherBase* watcher, int events,
-                     const wxString& filespec) :
-            m_watcher(watcher), m_events(events), m_filespec(filespec)
-        {
-        }
-
-        virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) wxOVERRIDE
-        {
-            // There is no need to watch individual files as we watch the
-            // parent directory which will notify us about any changes in them.
-            return wxDIR_CONTINUE;
-        }
-
-        virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
-        {
-            if ( m_watcher->AddAny(wxFileName::DirName(dirname),
-                                   m_events, wxFSWPath_Tree, m_filespec) )
-            {
-                wxLogTrace(wxTRACE_FSWATCHER,
-                   "--- AddTree adding directory '%s' ---", dirname);
-            }
-            return wxDIR_CONTINUE;
-        }
-
-    private:
-        wxFileSystemWatcherBase* m_watcher;
-        int m_events;
-        wxString m_filespec;
-    };
-
-    wxDir dir(path.GetFullPath());
     // Prevent asserts or infinite loops in trees containing symlinks
     int flags = wxDIR_DIRS | wxDIR_HIDDEN;
     if ( !path.ShouldFollowLink() )
     {
         flags |= wxDIR_NO_FOLLOW;
     }
-    AddTraverser traverser(this, events, filespec);
-    dir.Traverse(traverser, filespec, flags);
 
-    // Add the path itself explicitly as Traverse() doesn't return it.
-    AddAny(path.GetPathWithSep(), events, wxFSWPath_Tree, filespec);
-
-    return true;
+    return flags;
 }
 
-bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
+bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
+                                      const wxString& filespec)
 {
     if (!path.DirExists())
         return false;
 
-    // OPT could be optimised if we stored information about relationships
-    // between paths
-    class RemoveTraverser : public wxDirTraverser
-    {
-    public:
-        RemoveTraverser(wxFileSystemWatcherBase* watcher,
-                        const wxString& filespec) :
-            m_watcher(watcher), m_filespec(filespec)
-        {
-        }
-
-        virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) wxOVERRIDE
-        {
-            // We never watch the individual files when watching the tree, so
-            // nothing to do here.
-            return wxDIR_CONTINUE;
-        }
+    const wxString
+        canonical = GetCanonicalPath(wxFileName::DirName(path.GetFullPath()));
+    if (canonical.IsEmpty())
+        return false;
 
-        virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
-        {
-            m_watcher->Remove(wxFileName::DirName(dirname));
-            return wxDIR_CONTINUE;
-        }
+    return m_service->AddTree(canonical, events, filespec,
+                              GetTreeTraverseFlags(path));
+}
 
-    private:
-        wxFileSystemWatcherBase* m_watcher;
-        wxString m_filespec;
-    };
+bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
+{
+    if (!path.DirExists())
+        return false;
 
-    // If AddTree() used a filespec, we must use the same one
-    wxString canonical = GetCanonicalPath(path);
+    const wxString
+        canonical = GetCanonicalPath(wxFileName::DirName(path.GetFullPath()));
     wxFSWatchInfoMap::iterator it = m_watches.find(canonical);
     wxCHECK_MSG( it != m_watches.end(), false,
                  wxString::Format("Path '%s' is not watched", canonical) );
-    wxFSWatchInfo watch = it->second;
-    const wxString filespec = watch.GetFilespec();
 
 #if defined(__WINDOWS__)
     // When there's no filespec, the wxMSW AddTree() would have set a watch
     // on only the passed 'path'. We must therefore remove only this
-    if (filespec.empty())
+    if (it->second.GetFilespec().empty())
     {
         return Remove(path);
     }
     // Otherwise fall through to the generic implementation
 #endif // __WINDOWS__
 
-    wxDir dir(path.GetFullPath());
     // AddTree() might have used the wxDIR_NO_FOLLOW to prevent asserts or
     // infinite loops in trees containing symlinks. We need to do the same
     // or we'll try to remove unwatched items. Let's hope the caller used
     // the same ShouldFollowLink() setting as in AddTree()...
-    int flags = wxDIR_DIRS | wxDIR_HIDDEN;
-    if ( !path.ShouldFollowLink() )
-    {
-        flags |= wxDIR_NO_FOLLOW;
-    }
-    RemoveTraverser traverser(this, filespec);
-    dir.Traverse(traverser, filespec, flags);
-
-    // As in AddTree() above, handle the path itself explicitly.
-    Remove(path);
-
-    return true;
+    return m_service->RemoveTree(canonical, GetTreeTraverseFlags(path));
 }
 
 bool wxFileSystemWatcherBase::RemoveAll()
@@ -323,4 +215,149 @@ int wxFileSystemWatcherBase::GetWatchedPaths(wxArrayString* paths) const
     return m_watches.size();
 }
 
+// ============================================================================
+// wxFSWatcherImpl implementation
+// ============================================================================
+
+namespace
+{
+
+// Traverser adding or removing the watches for all the directories of a tree.
+//
+// As wxDir::Traverse() constructs the paths of the directories by appending
+// their names to the path of the root one, they are already canonical if the
+// latter is and so can be used directly, without creating a wxFileName for
+// each of them and normalizing it as AddAny() and Remove() do.
+class wxFSWatchTreeTraverser : public wxDirTraverser
+{
+public:
+    // Ctor for adding the watches.
+    wxFSWatchTreeTraverser(wxFSWatcherImpl* service, int events,
+                           const wxString& filespec) :
+        m_service(service), m_add(true), m_events(events), m_filespec(filespec)
+    {
+    }
+
+    // Ctor for removing them.
+    explicit wxFSWatchTreeTraverser(wxFSWatcherImpl* service) :
+        m_service(service), m_add(false), m_events(0)
+    {
+    }
+
+    virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) wxOVERRIDE
+    {
+        // There is no need to watch individual files as we watch the
+        // parent directory which will notify us about any changes in them.
+        return wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
+    {
+        // Reuse the same string to avoid reallocating it for every directory.
+        m_path = dirname;
+        m_path += wxFILE_SEP_PATH;
+
+        if ( !m_add )
+        {
+            m_service->RemoveWatch(m_path);
+        }
+        else if ( m_service->AddWatch(m_path, m_events,
+                                      wxFSWPath_Tree, m_filespec) )
+        {
+            wxLogTrace(wxTRACE_FSWATCHER,
+               "--- AddTree adding directory '%s' ---", dirname);
+        }
+        return wxDIR_CONTINUE;
+    }
+
+private:
+    wxFSWatcherImpl* const m_service;
+    const bool m_add;
+    const int m_events;
+    const wxString m_filespec;
+    wxString m_path;
+};
+
+} // anonymous namespace
+
+bool
+wxFSWatcherImpl::AddWatch(const wxString& path,
+                          int events,
+                          wxFSWPathType type,
+                          const wxString& filespec)
+{
+    wxFSWatchInfoMap& watches = m_watcher->m_watches;
+
+    // Check if the path isn't already being watched.
+    wxFSWatchInfoMap::iterator it = watches.find(path);
+    if ( it == watches.end() )
+    {
+        // It isn't, so start watching it in a platform specific way:
+        wxFSWatchInfo watch(path, events, type, filespec);
+        if ( !Add(watch) )
+            return false;
+
+        wxFSWatchInfoMap::value_type val(path, watch);
+        watches.insert(val);
+    }
+    else
+    {
+        wxFSWatchInfo& watch2 = it->second;
+        const int count = watch2.IncRef();
+
+        wxLogTrace(wxTRACE_FSWATCHER,
+                   "'%s' is now watched %d times", path, count);
+
+        wxUnusedVar(count); // could be unused if debug tracing is disabled
+    }
+    return true;
+}
+
+bool wxFSWatcherImpl::RemoveWatch(const wxString& path)
+{
+    wxFSWatchInfoMap& watches = m_watcher->m_watches;
+
+    wxFSWatchInfoMap::iterator it = watches.find(path);
+    wxCHECK_MSG(it != watches.end(), false,
+                wxString::Format("Path '%s' is not watched", path));
+
+    // Decrement the watch's refcount and remove from watch-list if 0
+    bool ret = true;
+    wxFSWatchInfo& watch = it->second;
+    if ( !watch.DecRef() )
+    {
+        // remove in a platform specific way
+        ret = Remove(watch);
+
+        watches.erase(it);
+    }
+    return ret;
+}
+
+bool
+wxFSWatcherImpl::AddTree(const wxString& path,
+                         int events,
+                         const wxString& filespec,
+                         int dirFlags)
+{
+    // Add the root itself first, so that the implementation can find it when
+    // adding its subdirectories.
+    if ( !AddWatch(path, events, wxFSWPath_Tree, filespec) )
+        return false;
+
+    wxFSWatchTreeTraverser traverser(this, events, filespec);
+    wxDir(path).Traverse(traverser, wxString(), dirFlags);
+
+    return true;
+}
+
+bool wxFSWatcherImpl::RemoveTree(const wxString& path, int dirFlags)
+{
+    wxFSWatchTreeTraverser traverser(this);
+    wxDir(path).Traverse(traverser, wxString(), dirFlags);
+
+    // As in AddTree(), handle the path itself explicitly.
+    return RemoveWatch(path);
+}
+
 #endif // wxUSE_FSWATCHER
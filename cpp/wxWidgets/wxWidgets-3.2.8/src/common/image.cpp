@@ -25,12 +25,30 @@
     #include "wx/colour.h"
 #endif
 
+#include "wx/threadpool.h"
+#include "wx/vector.h"
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
 
+#include "wx/private/imagerows.h"
+
 // For memcpy
 #include <string.h>
 
+// For the SIMD intrinsics used by the resampling code.
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define wxRESAMPLE_USE_AVX
+    #define wxRESAMPLE_USE_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define wxRESAMPLE_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define wxRESAMPLE_USE_NEON
+#endif
+
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
 #define HAS_FILE_STREAMS (wxUSE_STREAMS && (wxUSE_FILE || wxUSE_FFILE))
 
@@ -580,6 +598,749 @@ wxImage wxImage::ResampleNearest(int width, int height) const
     return image;
 }
 
+// ----------------------------------------------------------------------------
+// Separable resampling engine used by ResampleBox(), ResampleBilinear() and
+// ResampleBicubic()
+// ----------------------------------------------------------------------------
+
+// All the non-trivial resampling algorithms used by wxImage use filters which
+// are separable, i.e. the weight of the source pixel (i, j) for the
+// destination pixel (x, y) is the product of the horizontal weight of i for x
+// and the vertical weight of j for y. This allows to compute the result in two
+// passes: first a weighted sum of the source rows is computed for each
+// destination row and then this temporary row is resampled horizontally,
+// which is much cheaper than applying the full 2D filter to each destination
+// pixel. Doing the vertical pass first is advantageous because it works on
+// contiguous data and so can be easily vectorized.
+
+namespace
+{
+
+// Resampling filter along a single axis: for each destination pixel, contains
+// "taps" pairs of source pixel index and weight. Indices may repeat (this
+// happens when clamping at the edges) and unused taps have zero weight.
+class ResampleKernel
+{
+public:
+    ResampleKernel(int dstDim, int taps)
+        : m_taps(taps),
+          m_offsets(dstDim*taps, 0),
+          m_weights(dstDim*taps, 0.0f)
+    {
+    }
+
+    int GetTaps() const { return m_taps; }
+    int GetDstDim() const { return m_offsets.size() / m_taps; }
+
+    void Set(int dst, int tap, int offset, double weight)
+    {
+        m_offsets[dst*m_taps + tap] = offset;
+        m_weights[dst*m_taps + tap] = static_cast<float>(weight);
+    }
+
+    const int* GetOffsets(int dst) const { return &m_offsets[dst*m_taps]; }
+    const float* GetWeights(int dst) const { return &m_weights[dst*m_taps]; }
+
+    // Return the range of source pixels used by the given destination pixels.
+    void GetSourceRange(int dstStart, int dstEnd, int& srcFirst, int& srcLast) const
+    {
+        srcFirst = INT_MAX;
+        srcLast = -1;
+        for ( int n = dstStart*m_taps; n < dstEnd*m_taps; n++ )
+        {
+            if ( m_weights[n] == 0.0f )
+                continue;
+
+            if ( m_offsets[n] < srcFirst )
+                srcFirst = m_offsets[n];
+            if ( m_offsets[n] > srcLast )
+                srcLast = m_offsets[n];
+        }
+
+        // This can only happen if all weights are 0, which shouldn't be the
+        // case, but don't crash even if it does.
+        if ( srcLast < srcFirst )
+            srcFirst = srcLast = m_offsets[dstStart*m_taps];
+    }
+
+private:
+    const int m_taps;
+    wxVector<int> m_offsets;
+    wxVector<float> m_weights;
+};
+
+// How the resampled values are converted back to bytes.
+enum ResampleMode
+{
+    // Colour values are premultiplied by alpha (if any) before filtering and
+    // all the resulting values are truncated: used for box averaging.
+    Resample_Premultiply_Truncate,
+
+    // Colour values are premultiplied by alpha (if any), the colours are
+    // rounded but alpha is truncated: used for bicubic interpolation.
+    Resample_Premultiply_Round,
+
+    // Colour and alpha values are filtered independently and rounded: used
+    // for bilinear interpolation.
+    Resample_Independent_Round
+};
+
+// The horizontal pass processes all channels of a pixel at once using SIMD
+// instructions, if available. ResamplePixel is the type used for doing this
+// and the functions below implement the operations on it.
+#if defined(wxRESAMPLE_USE_SSE2)
+
+typedef __m128 ResamplePixel;
+
+inline ResamplePixel ResamplePixelZero() { return _mm_setzero_ps(); }
+
+inline ResamplePixel ResamplePixelSplat(float w) { return _mm_set1_ps(w); }
+
+inline ResamplePixel ResamplePixelSet(float rgb, float a)
+{
+    return _mm_setr_ps(rgb, rgb, rgb, a);
+}
+
+inline ResamplePixel ResamplePixelLoad(const float* in)
+{
+    return _mm_loadu_ps(in);
+}
+
+inline ResamplePixel ResamplePixelLoad(const unsigned char* rgb, unsigned char a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const unsigned bytes = rgb[0] | (rgb[1] << 8) | (rgb[2] << 16) |
+                           (static_cast<unsigned>(a) << 24);
+    __m128i v = _mm_cvtsi32_si128(static_cast<int>(bytes));
+    v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+    return _mm_cvtepi32_ps(v);
+}
+
+inline void ResamplePixelStore(float* out, ResamplePixel p)
+{
+    _mm_storeu_ps(out, p);
+}
+
+inline float ResamplePixelGetAlpha(ResamplePixel p)
+{
+    return _mm_cvtss_f32(_mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+inline ResamplePixel
+ResamplePixelMulAdd(ResamplePixel acc, ResamplePixel p, ResamplePixel w)
+{
+    return _mm_add_ps(acc, _mm_mul_ps(p, w));
+}
+
+// Convert the pixel to bytes after multiplying it by the given factors and
+// adding the given biases: this is used to both divide colours by alpha and
+// to round or truncate the values.
+inline void ResamplePixelToBytes(ResamplePixel p,
+                                 ResamplePixel scale,
+                                 ResamplePixel bias,
+                                 unsigned char* rgb,
+                                 unsigned char* alpha)
+{
+    const __m128 f = _mm_add_ps(_mm_mul_ps(p, scale), bias);
+
+    // Note that the packing operations saturate, so there is no need to clamp
+    // the values explicitly.
+    __m128i v = _mm_cvttps_epi32(f);
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+
+    const wxUint32 bytes = static_cast<wxUint32>(_mm_cvtsi128_si32(v));
+    rgb[0] = static_cast<unsigned char>(bytes);
+    rgb[1] = static_cast<unsigned char>(bytes >> 8);
+    rgb[2] = static_cast<unsigned char>(bytes >> 16);
+    if ( alpha )
+        *alpha = static_cast<unsigned char>(bytes >> 24);
+}
+
+#elif defined(wxRESAMPLE_USE_NEON)
+
+typedef float32x4_t ResamplePixel;
+
+inline ResamplePixel ResamplePixelZero() { return vdupq_n_f32(0.0f); }
+
+inline ResamplePixel ResamplePixelSplat(float w) { return vdupq_n_f32(w); }
+
+inline ResamplePixel ResamplePixelSet(float rgb, float a)
+{
+    return vsetq_lane_f32(a, vdupq_n_f32(rgb), 3);
+}
+
+inline ResamplePixel ResamplePixelLoad(const float* in)
+{
+    return vld1q_f32(in);
+}
+
+inline ResamplePixel ResamplePixelLoad(const unsigned char* rgb, unsigned char a)
+{
+    uint16x4_t v = vdup_n_u16(a);
+    v = vset_lane_u16(rgb[0], v, 0);
+    v = vset_lane_u16(rgb[1], v, 1);
+    v = vset_lane_u16(rgb[2], v, 2);
+    return vcvtq_f32_u32(vmovl_u16(v));
+}
+
+inline void ResamplePixelStore(float* out, ResamplePixel p)
+{
+    vst1q_f32(out, p);
+}
+
+inline float ResamplePixelGetAlpha(ResamplePixel p)
+{
+    return vgetq_lane_f32(p, 3);
+}
+
+inline ResamplePixel
+ResamplePixelMulAdd(ResamplePixel acc, ResamplePixel p, ResamplePixel w)
+{
+    return vmlaq_f32(acc, p, w);
+}
+
+inline void ResamplePixelToBytes(ResamplePixel p,
+                                 ResamplePixel scale,
+                                 ResamplePixel bias,
+                                 unsigned char* rgb,
+                                 unsigned char* alpha)
+{
+    const float32x4_t f = vmlaq_f32(bias, p, scale);
+
+    // Conversion to unsigned integers saturates negative values to 0 and the
+    // narrowing operations saturate the values greater than 255.
+    const uint16x4_t w = vqmovn_u32(vcvtq_u32_f32(f));
+    const uint8x8_t v = vqmovn_u16(vcombine_u16(w, w));
+
+    rgb[0] = vget_lane_u8(v, 0);
+    rgb[1] = vget_lane_u8(v, 1);
+    rgb[2] = vget_lane_u8(v, 2);
+    if ( alpha )
+        *alpha = vget_lane_u8(v, 3);
+}
+
+#else // no SIMD
+
+struct ResamplePixel
+{
+    float v[4];
+};
+
+inline ResamplePixel ResamplePixelSet(float rgb, float a)
+{
+    ResamplePixel p = { { rgb, rgb, rgb, a } };
+    return p;
+}
+
+inline ResamplePixel ResamplePixelZero() { return ResamplePixelSet(0, 0); }
+
+inline ResamplePixel ResamplePixelSplat(float w) { return ResamplePixelSet(w, w); }
+
+inline ResamplePixel ResamplePixelLoad(const float* in)
+{
+    ResamplePixel p;
+    memcpy(p.v, in, sizeof(p.v));
+    return p;
+}
+
+inline ResamplePixel ResamplePixelLoad(const unsigned char* rgb, unsigned char a)
+{
+    ResamplePixel p = { { rgb[0], rgb[1], rgb[2], a } };
+    return p;
+}
+
+inline void ResamplePixelStore(float* out, ResamplePixel p)
+{
+    memcpy(out, p.v, sizeof(p.v));
+}
+
+inline float ResamplePixelGetAlpha(ResamplePixel p) { return p.v[3]; }
+
+inline ResamplePixel
+ResamplePixelMulAdd(ResamplePixel acc, ResamplePixel p, ResamplePixel w)
+{
+    for ( int n = 0; n < 4; n++ )
+        acc.v[n] += p.v[n]*w.v[n];
+    return acc;
+}
+
+inline unsigned char ResampleToByte(float value)
+{
+    if ( value <= 0.0f )
+        return 0;
+    if ( value >= 255.0f )
+        return 255;
+
+    return static_cast<unsigned char>(value);
+}
+
+inline void ResamplePixelToBytes(ResamplePixel p,
+                                 ResamplePixel scale,
+                                 ResamplePixel bias,
+                                 unsigned char* rgb,
+                                 unsigned char* alpha)
+{
+    for ( int n = 0; n < 3; n++ )
+        rgb[n] = ResampleToByte(p.v[n]*scale.v[n] + bias.v[n]);
+    if ( alpha )
+        *alpha = ResampleToByte(p.v[3]*scale.v[3] + bias.v[3]);
+}
+
+#endif // SIMD
+
+// Add w*row[i] to acc[i] for all i in [0, n): this is where the bulk of the
+// time is spent in the vertical pass, so use the widest available vectors.
+inline void ResampleMulAdd(float* acc, const float* row, float w, size_t n)
+{
+    size_t i = 0;
+
+#ifdef wxRESAMPLE_USE_AVX
+    const __m256 w8 = _mm256_set1_ps(w);
+    for ( ; i + 8 <= n; i += 8 )
+    {
+        const __m256 r = _mm256_mul_ps(w8, _mm256_loadu_ps(row + i));
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), r));
+    }
+#endif // wxRESAMPLE_USE_AVX
+
+#if defined(wxRESAMPLE_USE_SSE2)
+    const __m128 w4 = _mm_set1_ps(w);
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        const __m128 r = _mm_mul_ps(w4, _mm_loadu_ps(row + i));
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), r));
+    }
+#elif defined(wxRESAMPLE_USE_NEON)
+    for ( ; i + 4 <= n; i += 4 )
+    {
+        vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), vld1q_f32(row + i), w));
+    }
+#endif // SSE2/NEON
+
+    for ( ; i < n; i++ )
+        acc[i] += w*row[i];
+}
+
+// Same as above but for a row of bytes.
+inline void
+ResampleMulAdd(float* acc, const unsigned char* row, float w, size_t n)
+{
+    size_t i = 0;
+
+#if defined(wxRESAMPLE_USE_SSE2)
+    const __m128 w4 = _mm_set1_ps(w);
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; i + 16 <= n; i += 16 )
+    {
+        const __m128i
+            b16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        const __m128i lo = _mm_unpacklo_epi8(b16, zero),
+                      hi = _mm_unpackhi_epi8(b16, zero);
+        const __m128i v[4] =
+        {
+            _mm_unpacklo_epi16(lo, zero),
+            _mm_unpackhi_epi16(lo, zero),
+            _mm_unpacklo_epi16(hi, zero),
+            _mm_unpackhi_epi16(hi, zero),
+        };
+
+        for ( int k = 0; k < 4; k++ )
+        {
+            const __m128 r = _mm_mul_ps(w4, _mm_cvtepi32_ps(v[k]));
+            float* const p = acc + i + 4*k;
+            _mm_storeu_ps(p, _mm_add_ps(_mm_loadu_ps(p), r));
+        }
+    }
+#elif defined(wxRESAMPLE_USE_NEON)
+    for ( ; i + 16 <= n; i += 16 )
+    {
+        const uint8x16_t b16 = vld1q_u8(row + i);
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(b16)),
+                         hi = vmovl_u8(vget_high_u8(b16));
+        const uint32x4_t v[4] =
+        {
+            vmovl_u16(vget_low_u16(lo)),
+            vmovl_u16(vget_high_u16(lo)),
+            vmovl_u16(vget_low_u16(hi)),
+            vmovl_u16(vget_high_u16(hi)),
+        };
+
+        for ( int k = 0; k < 4; k++ )
+        {
+            float* const p = acc + i + 4*k;
+            vst1q_f32(p, vmlaq_n_f32(vld1q_f32(p), vcvtq_f32_u32(v[k]), w));
+        }
+    }
+#endif // SSE2/NEON
+
+    for ( ; i < n; i++ )
+        acc[i] += w*row[i];
+}
+
+// Same as above but for a row of pixels with separate alpha: this computes
+// the values that would be produced by ResampleJob::DoConvertRow() for this
+// row on the fly.
+inline void ResampleMulAdd(float* acc,
+                           const unsigned char* row,
+                           const unsigned char* alpha,
+                           float w,
+                           bool premultiply,
+                           size_t n)
+{
+    const ResamplePixel wp = ResamplePixelSplat(w);
+    for ( size_t i = 0; i < n; i++, row += 3, acc += 4 )
+    {
+        const unsigned char a = alpha[i];
+
+        // When premultiplying, use (r, g, b, 1) pixel and multiply it by
+        // w*a to get the desired (w*a*r, w*a*g, w*a*b, w*a) result.
+        const ResamplePixel p = premultiply
+            ? ResamplePixelMulAdd(ResamplePixelLoad(acc),
+                                  ResamplePixelLoad(row, 1),
+                                  ResamplePixelSplat(w*a))
+            : ResamplePixelMulAdd(ResamplePixelLoad(acc),
+                                  ResamplePixelLoad(row, a),
+                                  wp);
+        ResamplePixelStore(acc, p);
+    }
+}
+
+// Number of destination rows processed at once when using the cache of
+// converted source rows, see ResampleJob::ProcessRows().
+const int RESAMPLE_CHUNK_ROWS = 16;
+
+// Do the actual resampling of a band of destination rows. The object of this
+// class is shared between all the threads resampling the same image, so it
+// must not be modified after creation.
+class ResampleJob
+{
+public:
+    ResampleJob(const unsigned char* srcData,
+                const unsigned char* srcAlpha,
+                int srcWidth,
+                int srcHeight,
+                const ResampleKernel& hKernel,
+                const ResampleKernel& vKernel,
+                ResampleMode mode,
+                unsigned char* dstData,
+                unsigned char* dstAlpha)
+        : m_srcData(srcData),
+          m_srcAlpha(srcAlpha),
+          m_srcWidth(srcWidth),
+          m_hKernel(hKernel),
+          m_vKernel(vKernel),
+          m_mode(mode),
+          m_dstData(dstData),
+          m_dstAlpha(dstAlpha),
+          m_dstWidth(hKernel.GetDstDim()),
+          m_channels(srcAlpha ? 4 : 3),
+          m_cacheRows(srcAlpha &&
+                      vKernel.GetTaps()*vKernel.GetDstDim() > 2*srcHeight)
+    {
+    }
+
+    int GetDstWidth() const { return m_dstWidth; }
+    int GetDstHeight() const { return m_vKernel.GetDstDim(); }
+
+    void ProcessRows(int yStart, int yEnd) const;
+
+private:
+    // Convert the source row with alpha to floats, premultiplying the colours
+    // by alpha if necessary.
+    void DoConvertRow(int srcRow, float* out) const;
+
+    // Resample the row produced by the vertical pass horizontally and store
+    // the result in the given destination row.
+    void DoResampleRow(const float* in, int dstRow) const;
+
+
+    const unsigned char* const m_srcData;
+    const unsigned char* const m_srcAlpha;
+    const int m_srcWidth;
+    const ResampleKernel& m_hKernel;
+    const ResampleKernel& m_vKernel;
+    const ResampleMode m_mode;
+    unsigned char* const m_dstData;
+    unsigned char* const m_dstAlpha;
+    const int m_dstWidth;
+
+    // Number of floats per pixel in the rows produced by the vertical pass.
+    const int m_channels;
+
+    // If true, use the cache of converted source rows: this is only done for
+    // the images with alpha and only if the same source rows are used for
+    // several destination rows, as otherwise it's faster to convert them on
+    // the fly.
+    const bool m_cacheRows;
+
+    wxDECLARE_NO_COPY_CLASS(ResampleJob);
+};
+
+void ResampleJob::DoConvertRow(int srcRow, float* out) const
+{
+    const size_t rowStart = static_cast<size_t>(srcRow)*m_srcWidth;
+    const unsigned char* src = m_srcData + 3*rowStart;
+    const unsigned char* srcAlpha = m_srcAlpha + rowStart;
+
+    if ( m_mode == Resample_Independent_Round )
+    {
+        for ( int x = 0; x < m_srcWidth; x++, src += 3, out += 4 )
+        {
+            out[0] = src[0];
+            out[1] = src[1];
+            out[2] = src[2];
+            out[3] = *srcAlpha++;
+        }
+    }
+    else
+    {
+        for ( int x = 0; x < m_srcWidth; x++, src += 3, out += 4 )
+        {
+            const float a = *srcAlpha++;
+            out[0] = src[0]*a;
+            out[1] = src[1]*a;
+            out[2] = src[2]*a;
+            out[3] = a;
+        }
+    }
+}
+
+void ResampleJob::DoResampleRow(const float* in, int dstRow) const
+{
+    const size_t rowStart = static_cast<size_t>(dstRow)*m_dstWidth;
+    unsigned char* dst = m_dstData + 3*rowStart;
+    unsigned char* alpha = m_dstAlpha ? m_dstAlpha + rowStart : NULL;
+
+    // When truncating, add a tiny bias to avoid getting e.g. 99 instead of
+    // 100 because of floating point errors accumulated during filtering.
+    static const float BIAS_ROUND = 0.5f;
+    static const float BIAS_TRUNCATE = 1.0f/512;
+
+    const ResamplePixel bias = ResamplePixelSet
+                               (
+                                m_mode == Resample_Premultiply_Truncate
+                                    ? BIAS_TRUNCATE : BIAS_ROUND,
+                                m_mode == Resample_Independent_Round
+                                    ? BIAS_ROUND : BIAS_TRUNCATE
+                               );
+
+    // Colours need to be divided by alpha if they were premultiplied by it.
+    const bool unpremultiply = alpha && m_mode != Resample_Independent_Round;
+    const ResamplePixel one = ResamplePixelSplat(1.0f);
+
+    const int taps = m_hKernel.GetTaps();
+    for ( int x = 0; x < m_dstWidth; x++, dst += 3 )
+    {
+        const int* const offsets = m_hKernel.GetOffsets(x);
+        const float* const weights = m_hKernel.GetWeights(x);
+
+        // Note that if there is no alpha, the last component of the pixel
+        // contains garbage (red component of the next pixel), but this
+        // doesn't matter as we don't use it.
+        ResamplePixel p = ResamplePixelZero();
+        for ( int t = 0; t < taps; t++ )
+        {
+            p = ResamplePixelMulAdd(p,
+                                    ResamplePixelLoad(in + m_channels*offsets[t]),
+                                    ResamplePixelSplat(weights[t]));
+        }
+
+        ResamplePixel scale = one;
+        if ( unpremultiply )
+        {
+            const float a = ResamplePixelGetAlpha(p);
+            scale = ResamplePixelSet(a != 0 ? 1.0f / a : 0.0f, 1.0f);
+        }
+
+        ResamplePixelToBytes(p, scale, bias, dst, alpha);
+        if ( alpha )
+            alpha++;
+    }
+}
+
+void ResampleJob::ProcessRows(int yStart, int yEnd) const
+{
+    const size_t rowLen = m_channels*m_srcWidth;
+
+    // The extra element is needed because we always load 4 floats for each
+    // pixel in DoResampleRow(), even if we only have 3 channels.
+    wxVector<float> acc(rowLen + 1);
+
+    // Cache of converted source rows in [cacheFirst, cacheLast] range, only
+    // used if m_cacheRows is true.
+    wxVector<float> cache;
+    int cacheFirst = 0,
+        cacheLast = -1;
+
+    const int taps = m_vKernel.GetTaps();
+
+    for ( int y0 = yStart; y0 < yEnd; y0 += RESAMPLE_CHUNK_ROWS )
+    {
+        const int y1 = wxMin(y0 + RESAMPLE_CHUNK_ROWS, yEnd);
+
+        if ( m_cacheRows )
+        {
+            int srcFirst, srcLast;
+            m_vKernel.GetSourceRange(y0, y1, srcFirst, srcLast);
+
+            // Reuse the rows converted for the previous chunk, if possible:
+            // the vertical kernels are monotonic, so we only need to check
+            // whether the start of the new range overlaps with the end of the
+            // old one.
+            int reuseCount = 0;
+            if ( srcFirst >= cacheFirst && srcFirst <= cacheLast )
+            {
+                reuseCount = wxMin(cacheLast, srcLast) - srcFirst + 1;
+                memmove(&cache[0], &cache[(srcFirst - cacheFirst)*rowLen],
+                        reuseCount*rowLen*sizeof(float));
+            }
+
+            const size_t needed = (srcLast - srcFirst + 1)*rowLen;
+            if ( cache.size() < needed )
+                cache.resize(needed);
+
+            for ( int n = srcFirst + reuseCount; n <= srcLast; n++ )
+                DoConvertRow(n, &cache[(n - srcFirst)*rowLen]);
+
+            cacheFirst = srcFirst;
+            cacheLast = srcLast;
+        }
+
+        for ( int y = y0; y < y1; y++ )
+        {
+            const int* const offsets = m_vKernel.GetOffsets(y);
+            const float* const weights = m_vKernel.GetWeights(y);
+
+            memset(&acc[0], 0, acc.size()*sizeof(float));
+            for ( int t = 0; t < taps; t++ )
+            {
+                if ( weights[t] == 0.0f )
+                    continue;
+
+                if ( !m_srcAlpha )
+                {
+                    ResampleMulAdd(&acc[0],
+                                   m_srcData + offsets[t]*rowLen,
+                                   weights[t],
+                                   rowLen);
+                }
+                else if ( m_cacheRows )
+                {
+                    ResampleMulAdd(&acc[0],
+                                   &cache[(offsets[t] - cacheFirst)*rowLen],
+                                   weights[t],
+                                   rowLen);
+                }
+                else
+                {
+                    const size_t start = static_cast<size_t>(offsets[t])*m_srcWidth;
+                    ResampleMulAdd(&acc[0],
+                                   m_srcData + 3*start,
+                                   m_srcAlpha + start,
+                                   weights[t],
+                                   m_mode != Resample_Independent_Round,
+                                   m_srcWidth);
+                }
+            }
+
+            DoResampleRow(&acc[0], y);
+        }
+    }
+}
+
+#if wxUSE_THREADS
+
+// Loop body processing the rows of the job in the thread pool.
+class ResampleLoopBody : public wxThreadPoolLoopBody
+{
+public:
+    explicit ResampleLoopBody(const ResampleJob& job) : m_job(job) { }
+
+    virtual void Process(int begin, int end) wxOVERRIDE
+    {
+        m_job.ProcessRows(begin, end);
+    }
+
+private:
+    const ResampleJob& m_job;
+
+    wxDECLARE_NO_COPY_CLASS(ResampleLoopBody);
+};
+
+#endif // wxUSE_THREADS
+
+// Maximal number of threads to use, 0 means to use all CPUs.
+int gs_maxResampleThreads = 0;
+
+// Don't bother with threads for the images smaller than this (in pixels).
+const int RESAMPLE_MIN_PIXELS_FOR_THREADS = 256*256;
+
+void RunResampleJob(const ResampleJob& job)
+{
+    const int height = job.GetDstHeight();
+
+#if wxUSE_THREADS
+    int numThreads = gs_maxResampleThreads;
+    if ( numThreads <= 0 )
+        numThreads = wxThread::GetCPUCount();
+
+    // Each thread should have at least a few chunks to process.
+    numThreads = wxMin(numThreads, height / (4*RESAMPLE_CHUNK_ROWS));
+
+    // And don't use threads at all for small images.
+    if ( job.GetDstWidth()*height < RESAMPLE_MIN_PIXELS_FOR_THREADS )
+        numThreads = 1;
+
+    if ( numThreads > 1 )
+    {
+        // Use a few bands per thread to balance the load if some of the pool
+        // threads are busy with something else.
+        const int bands = 4*numThreads;
+        ResampleLoopBody body(job);
+        wxThreadPool::GetDefault().ParallelFor(0, height, body,
+                                               (height + bands - 1) / bands,
+                                               numThreads);
+
+        return;
+    }
+#endif // wxUSE_THREADS
+
+    job.ProcessRows(0, height);
+}
+
+// Resample the image using the given horizontal and vertical kernels, whose
+// sizes determine the size of the returned image.
+wxImage ResampleWithKernels(const wxImage& image,
+                            const ResampleKernel& hKernel,
+                            const ResampleKernel& vKernel,
+                            ResampleMode mode)
+{
+    wxImage ret_image(hKernel.GetDstDim(), vKernel.GetDstDim(), false);
+
+    unsigned char* dst_data = ret_image.GetData();
+    unsigned char* dst_alpha = NULL;
+
+    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+
+    const unsigned char* src_alpha = image.GetAlpha();
+    if ( src_alpha )
+    {
+        ret_image.SetAlpha();
+        dst_alpha = ret_image.GetAlpha();
+    }
+
+    const ResampleJob job(image.GetData(), src_alpha,
+                          image.GetWidth(), image.GetHeight(),
+                          hKernel, vKernel, mode,
+                          dst_data, dst_alpha);
+    RunResampleJob(job);
+
+    return ret_image;
+}
+
+} // anonymous namespace
+
 namespace
 {
 
@@ -632,106 +1393,44 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
     }
 }
 
-} // anonymous namespace
-
-wxImage wxImage::ResampleBox(int width, int height) const
+// Each destination pixel is the average of all the source pixels in its box.
+ResampleKernel ResampleBoxKernel(int newDim, int oldDim)
 {
-    // This function implements a simple pre-blur/box averaging method for
-    // downsampling that gives reasonably smooth results To scale the image
-    // down we will need to gather a grid of pixels of the size of the scale
-    // factor in each direction and then do an averaging of the pixels.
-
-    wxImage ret_image(width, height, false);
-
-    wxVector<BoxPrecalc> vPrecalcs(height);
-    wxVector<BoxPrecalc> hPrecalcs(width);
-
-    ResampleBoxPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBoxPrecalc(hPrecalcs, M_IMGDATA->m_width);
-
+    wxVector<BoxPrecalc> boxes(newDim);
+    ResampleBoxPrecalc(boxes, oldDim);
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
-
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
-
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
-
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
-
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
-    {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
-
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
-        {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
-
-            // Box of pixels to average
-            averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
-                                * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
-            sum_r = sum_g = sum_b = sum_a = 0.0;
-
-            for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
-            {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
-                {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
-
-                    if (src_alpha)
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
-                    }
-                }
-            }
+    int taps = 1;
+    for ( int dst = 0; dst < newDim; dst++ )
+        taps = wxMax(taps, boxes[dst].boxEnd - boxes[dst].boxStart + 1);
 
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
-            {
-                if (sum_a != 0)
-                {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
-                }
-                else
-                {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
-                }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
-            }
-            dst_data += 3;
-        }
+    ResampleKernel kernel(newDim, taps);
+    for ( int dst = 0; dst < newDim; dst++ )
+    {
+        const BoxPrecalc& box = boxes[dst];
+        const int count = box.boxEnd - box.boxStart + 1;
+        for ( int i = 0; i < count; i++ )
+            kernel.Set(dst, i, box.boxStart + i, 1.0 / count);
     }
 
-    return ret_image;
+    return kernel;
+}
+
+} // anonymous namespace
+
+wxImage wxImage::ResampleBox(int width, int height) const
+{
+    // This function implements a simple pre-blur/box averaging method for
+    // downsampling that gives reasonably smooth results To scale the image
+    // down we will need to gather a grid of pixels of the size of the scale
+    // factor in each direction and then do an averaging of the pixels.
+    //
+    // The averaging is done separately in each direction, see the comment
+    // before ResampleKernel.
+
+    return ResampleWithKernels(*this,
+                               ResampleBoxKernel(width, M_IMGDATA->m_width),
+                               ResampleBoxKernel(height, M_IMGDATA->m_height),
+                               Resample_Premultiply_Truncate);
 }
 
 namespace
@@ -792,87 +1491,31 @@ void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
     }
 }
 
-} // anonymous namespace
-
-wxImage wxImage::ResampleBilinear(int width, int height) const
+ResampleKernel ResampleBilinearKernel(int newDim, int oldDim)
 {
-    // This function implements a Bilinear algorithm for resampling.
-    wxImage ret_image(width, height, false);
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
-
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
+    wxVector<BilinearPrecalc> precalcs(newDim);
+    ResampleBilinearPrecalc(precalcs, oldDim);
 
-    if ( src_alpha )
+    ResampleKernel kernel(newDim, 2);
+    for ( int dst = 0; dst < newDim; dst++ )
     {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
+        const BilinearPrecalc& precalc = precalcs[dst];
+        kernel.Set(dst, 0, precalc.offset1, precalc.dd1);
+        kernel.Set(dst, 1, precalc.offset2, precalc.dd);
     }
 
-    wxVector<BilinearPrecalc> vPrecalcs(height);
-    wxVector<BilinearPrecalc> hPrecalcs(width);
-    ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
-
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
-
-    for ( int dsty = 0; dsty < height; dsty++ )
-    {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
-
-
-        for ( int dstx = 0; dstx < width; dstx++ )
-        {
-            // X-axis of pixel to interpolate from
-            const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
-            const double dx = hPrecalc.dd;
-            const double dx1 = hPrecalc.dd1;
-
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
-
-            // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
-
-            // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
-            if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
-
-            // result lines
-
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
+    return kernel;
+}
 
-            if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
-        }
-    }
+} // anonymous namespace
 
-    return ret_image;
+wxImage wxImage::ResampleBilinear(int width, int height) const
+{
+    // This function implements a Bilinear algorithm for resampling.
+    return ResampleWithKernels(*this,
+                               ResampleBilinearKernel(width, M_IMGDATA->m_width),
+                               ResampleBilinearKernel(height, M_IMGDATA->m_height),
+                               Resample_Independent_Round);
 }
 
 // The following two local functions are for the B-spline weighting of the
@@ -944,6 +1587,22 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
     }
 }
 
+ResampleKernel ResampleBicubicKernel(int newDim, int oldDim)
+{
+    wxVector<BicubicPrecalc> precalcs(newDim);
+    ResampleBicubicPrecalc(precalcs, oldDim);
+
+    ResampleKernel kernel(newDim, 4);
+    for ( int dst = 0; dst < newDim; dst++ )
+    {
+        const BicubicPrecalc& precalc = precalcs[dst];
+        for ( int k = 0; k < 4; k++ )
+            kernel.Set(dst, k, precalc.offset[k], precalc.weight[k]);
+    }
+
+    return kernel;
+}
+
 } // anonymous namespace
 
 // This is the bicubic resampling algorithm
@@ -972,116 +1631,29 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
     // - (Clamp)     Choose the nearest pixel along the border. This takes the
     // border pixels and extends them out to infinity.
     //
-    // NOTE: below the y_offset and x_offset variables are being set for edge
-    // pixels using the "Mirror" method mentioned above
-
-    wxImage ret_image;
-
-    ret_image.Create(width, height, false);
-
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_data = ret_image.GetData();
-    unsigned char* dst_alpha = NULL;
+    // NOTE: the offsets are being set for edge pixels using the "Mirror"
+    // method mentioned above
 
-    wxCHECK_MSG( dst_data, ret_image, wxS("unable to create image") );
-
-    if ( src_alpha )
-    {
-        ret_image.SetAlpha();
-        dst_alpha = ret_image.GetAlpha();
-    }
-
-    // Precalculate weights
-    wxVector<BicubicPrecalc> vPrecalcs(height);
-    wxVector<BicubicPrecalc> hPrecalcs(width);
-
-    ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
-    ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
-
-    for ( int dsty = 0; dsty < height; dsty++ )
-    {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
-
-        for ( int dstx = 0; dstx < width; dstx++ )
-        {
-            // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            // Sums for each color channel
-            double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
-
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
-            {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+    return ResampleWithKernels(*this,
+                               ResampleBicubicKernel(width, M_IMGDATA->m_width),
+                               ResampleBicubicKernel(height, M_IMGDATA->m_height),
+                               Resample_Premultiply_Round);
+}
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
-                {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
-
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
-
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
-
-                    // Create a sum of all velues for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
-                    {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
-                    }
-                }
-            }
+// ----------------------------------------------------------------------------
+// resampling options
+// ----------------------------------------------------------------------------
 
-            // Put the data into the destination image.  The summed values are
-            // of double data type and are rounded here for accuracy
-            if ( src_alpha )
-            {
-                if (sum_a != 0)
-                {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
-                }
-                else
-                {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
-                }
-                *dst_alpha++ = (unsigned char)sum_a;
-            }
-            else
-            {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
-            }
-            dst_data += 3;
-        }
-    }
+/* static */
+void wxImage::SetMaxResampleThreads(int numThreads)
+{
+    gs_maxResampleThreads = numThreads;
+}
 
-    return ret_image;
+/* static */
+int wxImage::GetMaxResampleThreads()
+{
+    return gs_maxResampleThreads;
 }
 
 // Blur in the horizontal direction
@@ -3010,6 +3582,240 @@ bool wxImage::LoadFile( wxInputStream& stream, const wxString& mimetype, int ind
     return DoLoad(*handler, stream, index);
 }
 
+// ----------------------------------------------------------------------------
+// row by row loading
+// ----------------------------------------------------------------------------
+
+wxImageBufferRowSink::wxImageBufferRowSink(unsigned char* data,
+                                           int width,
+                                           int height,
+                                           int stride)
+    : m_data(data),
+      m_maxWidth(width),
+      m_maxHeight(height),
+      m_stride(stride ? stride : 3*width)
+{
+    wxASSERT_MSG( data, wxS("NULL data buffer") );
+    wxASSERT_MSG( m_stride >= 3*width, wxS("stride too small") );
+
+    m_alpha = NULL;
+    m_alphaStride = 0;
+
+    m_width =
+    m_height =
+    m_rows = 0;
+    m_hasAlpha = false;
+}
+
+void wxImageBufferRowSink::SetAlphaBuffer(unsigned char* alpha, int stride)
+{
+    wxASSERT_MSG( !stride || stride >= m_maxWidth, wxS("stride too small") );
+
+    m_alpha = alpha;
+    m_alphaStride = stride ? stride : m_maxWidth;
+}
+
+bool wxImageBufferRowSink::Begin(int width, int height, bool hasAlpha)
+{
+    if ( width > m_maxWidth || height > m_maxHeight )
+    {
+        wxLogDebug(wxS("Image of size %dx%d doesn't fit into %dx%d buffer."),
+                   width, height, m_maxWidth, m_maxHeight);
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_hasAlpha = hasAlpha;
+    m_rows = 0;
+
+    return true;
+}
+
+bool wxImageBufferRowSink::ProcessRow(int y,
+                                      const unsigned char* data,
+                                      const unsigned char* alpha)
+{
+    memcpy(m_data + static_cast<size_t>(y)*m_stride, data, 3*m_width);
+
+    if ( m_alpha )
+    {
+        unsigned char* const
+            dstAlpha = m_alpha + static_cast<size_t>(y)*m_alphaStride;
+        if ( alpha )
+            memcpy(dstAlpha, alpha, m_width);
+        else
+            memset(dstAlpha, wxIMAGE_ALPHA_OPAQUE, m_width);
+    }
+
+    m_rows++;
+
+    return true;
+}
+
+namespace
+{
+
+// Load the image using the given handler normally and pass its rows to the
+// sink: this is used for the handlers which don't support decoding the image
+// row by row themselves.
+bool
+DoLoadRowsFromImage(wxImageHandler& handler,
+                    wxInputStream& stream,
+                    wxImageRowSink& sink,
+                    int scale,
+                    bool verbose)
+{
+    wxImage image;
+    if ( !handler.LoadFile(&image, stream, verbose) )
+        return false;
+
+    // convert the mask, if any, to alpha as the sink doesn't support masks
+    if ( image.HasMask() && !image.HasAlpha() )
+        image.InitAlpha();
+
+    const int widthOrig = image.GetWidth();
+    const int width = (widthOrig + scale - 1) / scale,
+              height = (image.GetHeight() + scale - 1) / scale;
+
+    const unsigned char* const data = image.GetData();
+    const unsigned char* const alpha = image.GetAlpha();
+
+    if ( !sink.Begin(width, height, alpha != NULL) )
+        return false;
+
+    wxVector<unsigned char> rowData, rowAlpha;
+    if ( scale != 1 )
+    {
+        rowData.resize(3*width);
+        if ( alpha )
+            rowAlpha.resize(width);
+    }
+
+    for ( int y = 0; y < height; y++ )
+    {
+        const size_t start = static_cast<size_t>(y)*scale*widthOrig;
+
+        const unsigned char* srcData = data + 3*start;
+        const unsigned char* srcAlpha = alpha ? alpha + start : NULL;
+
+        if ( scale != 1 )
+        {
+            for ( int x = 0; x < width; x++ )
+            {
+                const size_t n = static_cast<size_t>(x)*scale;
+                rowData[3*x    ] = srcData[3*n    ];
+                rowData[3*x + 1] = srcData[3*n + 1];
+                rowData[3*x + 2] = srcData[3*n + 2];
+
+                if ( srcAlpha )
+                    rowAlpha[x] = srcAlpha[n];
+            }
+
+            srcData = &rowData[0];
+            if ( srcAlpha )
+                srcAlpha = &rowAlpha[0];
+        }
+
+        if ( !sink.ProcessRow(y, srcData, srcAlpha) )
+            break;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+/* static */
+bool wxImage::LoadRows( wxInputStream& stream, wxImageRowSink& sink,
+                        wxBitmapType type, int scale )
+{
+    wxCHECK_MSG( scale == 1 || scale == 2 || scale == 4 || scale == 8, false,
+                 wxS("unsupported scale factor") );
+
+    const bool verbose = (GetDefaultLoadFlags() & Load_Verbose) != 0;
+
+    wxImageHandler* handler = NULL;
+    if ( type == wxBITMAP_TYPE_ANY )
+    {
+        if ( !stream.IsSeekable() )
+        {
+            if ( verbose )
+            {
+                wxLogError(_("Can't automatically determine the image format "
+                             "for non-seekable input."));
+            }
+            return false;
+        }
+
+        const wxList& list = GetHandlers();
+        for ( wxList::compatibility_iterator node = list.GetFirst();
+              node;
+              node = node->GetNext() )
+        {
+            wxImageHandler* const h = (wxImageHandler*)node->GetData();
+            if ( h->CanRead(stream) )
+            {
+                handler = h;
+                break;
+            }
+        }
+
+        if ( !handler )
+        {
+            if ( verbose )
+            {
+                wxLogWarning( _("Unknown image data format.") );
+            }
+            return false;
+        }
+    }
+    else
+    {
+        handler = FindHandler(type);
+        if ( !handler )
+        {
+            if ( verbose )
+            {
+                wxLogWarning( _("No image handler for type %d defined."), type );
+            }
+            return false;
+        }
+    }
+
+#if wxUSE_LIBPNG
+    if ( wxDynamicCast(handler, wxPNGHandler) )
+        return wxPNGLoadRows(stream, sink, scale, verbose);
+#endif // wxUSE_LIBPNG
+
+#if wxUSE_LIBJPEG
+    if ( wxDynamicCast(handler, wxJPEGHandler) )
+        return wxJPEGLoadRows(stream, sink, scale, verbose);
+#endif // wxUSE_LIBJPEG
+
+    return DoLoadRowsFromImage(*handler, stream, sink, scale, verbose);
+}
+
+/* static */
+bool wxImage::LoadRows( const wxString& WXUNUSED_UNLESS_STREAMS(filename),
+                        wxImageRowSink& WXUNUSED_UNLESS_STREAMS(sink),
+                        wxBitmapType WXUNUSED_UNLESS_STREAMS(type),
+                        int WXUNUSED_UNLESS_STREAMS(scale) )
+{
+#if HAS_FILE_STREAMS
+    wxImageFileInputStream stream(filename);
+    if ( stream.IsOk() )
+    {
+        wxBufferedInputStream bstream( stream );
+        return LoadRows(bstream, sink, type, scale);
+    }
+
+    wxLogError(_("Failed to load image from file \"%s\"."), filename);
+#endif // HAS_FILE_STREAMS
+
+    return false;
+}
+
 bool wxImage::DoSave(wxImageHandler& handler, wxOutputStream& stream) const
 {
     wxImage * const self = const_cast<wxImage *>(this);
@@ -14,6 +14,7 @@
 
 #include "wx/imagjpeg.h"
 #include "wx/versioninfo.h"
+#include "wx/private/imagerows.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -348,6 +349,103 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxJPEGLoadRows(wxInputStream& stream,
+                    wxImageRowSink& sink,
+                    int scale,
+                    bool verbose)
+{
+    struct jpeg_decompress_struct cinfo;
+    wx_error_mgr jerr;
+
+    cinfo.err = jpeg_std_error( &jerr );
+    jerr.error_exit = wx_error_exit;
+
+    if (!verbose)
+        cinfo.err->output_message = wx_ignore_message;
+
+    /* Establish the setjmp return context for wx_error_exit to use. */
+    if (setjmp(jerr.setjmp_buffer)) {
+      if (verbose)
+      {
+        wxLogError(_("JPEG: Couldn't load - file is probably corrupted."));
+      }
+      (cinfo.src->term_source)(&cinfo);
+      jpeg_destroy_decompress(&cinfo);
+      return false;
+    }
+
+    jpeg_create_decompress( &cinfo );
+    wx_jpeg_io_src( &cinfo, stream );
+    jpeg_read_header( &cinfo, TRUE );
+
+    int bytesPerPixel;
+    if ((cinfo.out_color_space == JCS_CMYK) || (cinfo.out_color_space == JCS_YCCK))
+    {
+        cinfo.out_color_space = JCS_CMYK;
+        bytesPerPixel = 4;
+    }
+    else // all the rest is treated as RGB
+    {
+        cinfo.out_color_space = JCS_RGB;
+        bytesPerPixel = 3;
+    }
+
+    // let libjpeg scale the image down while decoding it, which is much
+    // faster than decoding it at full size as it skips most of the IDCT work
+    cinfo.scale_denom = scale;
+    jpeg_calc_output_dimensions( &cinfo );
+
+    if ( !sink.Begin(cinfo.output_width, cinfo.output_height, false) )
+    {
+        (cinfo.src->term_source)(&cinfo);
+        jpeg_destroy_decompress( &cinfo );
+        return false;
+    }
+
+    jpeg_start_decompress( &cinfo );
+
+    // both buffers are freed by jpeg_destroy_decompress()
+    unsigned stride = cinfo.output_width * bytesPerPixel;
+    JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
+                            ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, 1 );
+    JSAMPARRAY rgbbuf = bytesPerPixel == 3
+                            ? tempbuf
+                            : (*cinfo.mem->alloc_sarray)
+                                ((j_common_ptr) &cinfo, JPOOL_IMAGE,
+                                 cinfo.output_width * 3, 1 );
+
+    while ( cinfo.output_scanline < cinfo.output_height )
+    {
+        const int y = cinfo.output_scanline;
+        jpeg_read_scanlines( &cinfo, tempbuf, 1 );
+
+        if (cinfo.out_color_space == JCS_CMYK)
+        {
+            unsigned char* ptr = rgbbuf[0];
+            const unsigned char* inptr = (const unsigned char*) tempbuf[0];
+            for (size_t i = 0; i < cinfo.output_width; i++)
+            {
+                wx_cmyk_to_rgb(ptr, inptr);
+                ptr += 3;
+                inptr += 4;
+            }
+        }
+
+        if ( !sink.ProcessRow(y, rgbbuf[0], NULL) )
+        {
+            // jpeg_destroy_decompress() below aborts decompression, but we
+            // still need to release our source manager ourselves.
+            (cinfo.src->term_source)(&cinfo);
+            jpeg_destroy_decompress( &cinfo );
+            return true;
+        }
+    }
+
+    jpeg_finish_decompress( &cinfo );
+    jpeg_destroy_decompress( &cinfo );
+    return true;
+}
+
 typedef struct {
     struct jpeg_destination_mgr pub;
 
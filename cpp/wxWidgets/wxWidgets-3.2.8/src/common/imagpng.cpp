@@ -22,6 +22,7 @@
 
 #include "wx/imagpng.h"
 #include "wx/versioninfo.h"
+#include "wx/private/imagerows.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -160,6 +161,58 @@ struct wxPNGImageData
     bool ok;
 };
 
+// Similar helper struct used by wxPNGLoadRows().
+struct wxPNGRowsData
+{
+    wxPNGRowsData()
+    {
+        lines = NULL;
+        buf =
+        rgb =
+        alpha = NULL;
+        info_ptr = (png_infop) NULL;
+        png_ptr = (png_structp) NULL;
+        ok =
+        cancelled = false;
+    }
+
+    ~wxPNGRowsData()
+    {
+        free(alpha);
+        free(rgb);
+        free(buf);
+        free(lines);
+
+        if ( png_ptr )
+        {
+            if ( info_ptr )
+                png_destroy_read_struct( &png_ptr, &info_ptr, (png_infopp) NULL );
+            else
+                png_destroy_read_struct( &png_ptr, (png_infopp) NULL, (png_infopp) NULL );
+        }
+    }
+
+    void DoLoadPNGRows(wxPNGInfoStruct& wxinfo,
+                       wxImageRowSink& sink,
+                       int scale);
+
+    // pass every scale-th pixel of the given RGB or RGBA row to the sink
+    bool SendRow(wxImageRowSink& sink,
+                 int y,
+                 const unsigned char* src,
+                 int scale);
+
+    unsigned char** lines;
+    unsigned char* buf;
+    unsigned char* rgb;
+    unsigned char* alpha;
+    png_uint_32 outWidth;
+    png_infop info_ptr;
+    png_structp png_ptr;
+    bool ok;
+    bool cancelled;
+};
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -448,6 +501,200 @@ wxPNGHandler::LoadFile(wxImage *image,
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// reading PNGs row by row
+// ----------------------------------------------------------------------------
+
+bool
+wxPNGRowsData::SendRow(wxImageRowSink& sink,
+                       int y,
+                       const unsigned char* src,
+                       int scale)
+{
+    // we can pass the data to the sink directly if it's already in the
+    // right format
+    if ( !alpha && scale == 1 )
+        return sink.ProcessRow(y, src, NULL);
+
+    const int step = (alpha ? 4 : 3)*scale;
+
+    unsigned char* dst = rgb;
+    unsigned char* dstAlpha = alpha;
+    for ( png_uint_32 x = 0; x < outWidth; x++, src += step )
+    {
+        *dst++ = src[0];
+        *dst++ = src[1];
+        *dst++ = src[2];
+
+        if ( dstAlpha )
+            *dstAlpha++ = src[3];
+    }
+
+    return sink.ProcessRow(y, rgb, alpha);
+}
+
+void
+wxPNGRowsData::DoLoadPNGRows(wxPNGInfoStruct& wxinfo,
+                             wxImageRowSink& sink,
+                             int scale)
+{
+    png_uint_32 width, height = 0;
+    int bit_depth, color_type, interlace_type;
+
+    png_ptr = png_create_read_struct
+                          (
+                            PNG_LIBPNG_VER_STRING,
+                            NULL,
+                            wx_PNG_error,
+                            wx_PNG_warning
+                          );
+    if (!png_ptr)
+        return;
+
+    // NB: please see the comment near wxPNGInfoStruct declaration for
+    //     explanation why this line is mandatory
+    png_set_read_fn( png_ptr, &wxinfo, wx_PNG_stream_reader);
+
+    info_ptr = png_create_info_struct( png_ptr );
+    if (!info_ptr)
+        return;
+
+    if (setjmp(wxinfo.jmpbuf))
+        return;
+
+    png_read_info( png_ptr, info_ptr );
+    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type,
+                  &interlace_type, NULL, NULL );
+
+    png_set_expand(png_ptr);
+    png_set_gray_to_rgb(png_ptr);
+    png_set_strip_16( png_ptr );
+    png_set_packing( png_ptr );
+
+    const bool hasAlpha =
+        (color_type & PNG_COLOR_MASK_ALPHA) ||
+        png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+    const size_t channels = hasAlpha ? 4 : 3;
+
+    // The first pass of an interlaced image contains exactly every 8th pixel
+    // of every 8th row, so when scaling it down by 8 we only need to read it,
+    // which is why we don't ask libpng to combine the passes in this case.
+    const bool interlaced = interlace_type != PNG_INTERLACE_NONE;
+    const bool firstPassOnly = interlaced && scale == 8;
+    const int passes = interlaced && !firstPassOnly
+                        ? png_set_interlace_handling(png_ptr)
+                        : 1;
+
+    png_read_update_info( png_ptr, info_ptr );
+
+    outWidth = (width + scale - 1) / scale;
+    const png_uint_32 outHeight = (height + scale - 1) / scale;
+
+    if ( !sink.Begin((int)outWidth, (int)outHeight, hasAlpha) )
+    {
+        cancelled = true;
+        return;
+    }
+
+    if ( hasAlpha || scale != 1 )
+    {
+        rgb = static_cast<unsigned char*>(malloc(3 * outWidth));
+        if ( !rgb )
+            return;
+
+        if ( hasAlpha )
+        {
+            alpha = static_cast<unsigned char*>(malloc(outWidth));
+            if ( !alpha )
+                return;
+        }
+    }
+
+    if ( firstPassOnly )
+    {
+        // Without interlace handling, libpng returns the rows of the first
+        // pass as a reduced image of exactly the size we need. Note that it
+        // still may write up to the full row width into the buffer, however.
+        buf = static_cast<unsigned char*>(malloc(channels * width));
+        if ( !buf )
+            return;
+
+        for ( png_uint_32 y = 0; y < outHeight; y++ )
+        {
+            png_read_row( png_ptr, buf, NULL );
+            if ( !SendRow(sink, (int)y, buf, 1) )
+                break;
+        }
+
+        // Don't read the remaining passes we're not interested in.
+    }
+    else if ( passes > 1 )
+    {
+        // None of the rows of an interlaced image is complete before the
+        // last pass, so we do need to keep all the rows we're going to use in
+        // memory, but we can still avoid storing the other ones by reading
+        // all of them into the same scratch row.
+        const size_t rowBytes = channels * width;
+        buf = static_cast<unsigned char*>(malloc(rowBytes * (outHeight + 1)));
+        lines = static_cast<unsigned char**>(malloc(height * sizeof(unsigned char*)));
+        if ( !buf || !lines )
+            return;
+
+        unsigned char* const scratch = buf + rowBytes * outHeight;
+        for ( png_uint_32 y = 0; y < height; y++ )
+            lines[y] = y % scale ? scratch : buf + rowBytes * (y / scale);
+
+        for ( int pass = 0; pass < passes; pass++ )
+            png_read_rows( png_ptr, lines, NULL, height );
+
+        for ( png_uint_32 y = 0; y < outHeight; y++ )
+        {
+            if ( !SendRow(sink, (int)y, buf + rowBytes * y, scale) )
+                break;
+        }
+    }
+    else // not interlaced
+    {
+        buf = static_cast<unsigned char*>(malloc(channels * width));
+        if ( !buf )
+            return;
+
+        for ( png_uint_32 y = 0; y < height; y++ )
+        {
+            png_read_row( png_ptr, buf, NULL );
+
+            if ( y % scale == 0 && !SendRow(sink, (int)(y / scale), buf, scale) )
+                break;
+        }
+    }
+
+    // Note that we don't call png_read_end() as we're not interested in
+    // anything following the image data and, if we stopped early, it would
+    // fail anyhow.
+
+    ok = true;
+}
+
+bool wxPNGLoadRows(wxInputStream& stream,
+                   wxImageRowSink& sink,
+                   int scale,
+                   bool verbose)
+{
+    wxPNGInfoStruct wxinfo;
+    wxinfo.verbose = verbose;
+    wxinfo.stream.in = &stream;
+
+    wxPNGRowsData data;
+    data.DoLoadPNGRows(wxinfo, sink, scale);
+
+    if ( !data.ok && !data.cancelled && verbose )
+    {
+        wxLogError(_("Couldn't load a PNG image - file is corrupted or not enough memory."));
+    }
+
+    return data.ok;
+}
+
 // ----------------------------------------------------------------------------
 // SaveFile() palette helpers
 // ----------------------------------------------------------------------------
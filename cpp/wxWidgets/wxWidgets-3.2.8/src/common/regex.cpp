@@ -32,6 +32,10 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/vector.h"
+
+#include "wx/private/threadinfo.h"
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -98,6 +102,7 @@ namespace
 #define REG_NOTEOL    0x0008    // Same as PCRE2_NOTEOL.
 #define REG_NOSUB     0x0020    // Don't return matches.
 #define REG_NOTEMPTY  0x0100    // Same as PCRE2_NOTEMPTY.
+#define REG_JIT       0x0200    // Use JIT compilation if possible.
 
 enum
 {
@@ -118,6 +123,9 @@ struct regex_t
     pcre2_code* code;
     pcre2_match_data* match_data;
 
+    // Only non-NULL if JIT compilation was used.
+    pcre2_match_context* match_context;
+
     int errorcode;
     regoff_t erroroffset;
 };
@@ -128,6 +136,20 @@ struct regmatch_t
     regoff_t rm_eo;
 };
 
+// Return the JIT stack to use in the current thread, creating it if necessary.
+pcre2_jit_stack* wxGetRegExJITStack(void* WXUNUSED(data))
+{
+    void*& stack = wxThreadInfo.regexJITStack;
+    if ( !stack )
+    {
+        // If this fails, PCRE falls back to using a small stack on the
+        // machine stack, which is still enough for most regexes.
+        stack = pcre2_jit_stack_create(32*1024, 512*1024, NULL);
+    }
+
+    return static_cast<pcre2_jit_stack*>(stack);
+}
+
 int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
 {
     // PCRE2_UTF is required in order to handle non-ASCII characters when using
@@ -170,6 +192,18 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
 
     preg->match_data = pcre2_match_data_create_from_pattern(preg->code, NULL);
 
+    preg->match_context = NULL;
+    if ( cflags & REG_JIT )
+    {
+        // JIT compilation fails if it's not supported by the PCRE library or
+        // the current platform, just use the interpreter in this case.
+        if ( pcre2_jit_compile(preg->code, PCRE2_JIT_COMPLETE) == 0 )
+        {
+            preg->match_context = pcre2_match_context_create(NULL);
+            pcre2_jit_stack_assign(preg->match_context, wxGetRegExJITStack, NULL);
+        }
+    }
+
     return REG_NOERROR;
 }
 
@@ -194,7 +228,7 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
                         0,                      // start offset
                         options,
                         preg->match_data,
-                        NULL                    // use default context
+                        preg->match_context     // NULL unless using JIT
                    );
 
     if ( rc == PCRE2_ERROR_NOMATCH )
@@ -253,12 +287,20 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
 
 void wx_regfree(regex_t* preg)
 {
+    pcre2_match_context_free(preg->match_context);
     pcre2_match_data_free(preg->match_data);
     pcre2_code_free(preg->code);
 }
 
 } // anonymous namespace
 
+// This is called from wxThreadSpecificInfo dtor to free the stack allocated by
+// wxGetRegExJITStack() above.
+void wxFreeRegExJITStack(void* stack)
+{
+    pcre2_jit_stack_free(static_cast<pcre2_jit_stack*>(stack));
+}
+
 #else // !wxUSE_PCRE
 
 #include <regex.h>
@@ -371,6 +413,7 @@ public:
     // RE operations
     bool Compile(wxString expr, int flags = 0);
     bool Matches(const wxRegChar *str, int flags, size_t len) const;
+    bool MatchesUTF8(const char *str, size_t len, int flags) const;
     bool GetMatch(size_t *start, size_t *len, size_t index = 0) const;
     size_t GetMatchCount() const;
     int Replace(wxString *pattern, const wxString& replacement,
@@ -415,6 +458,12 @@ private:
 
     // true if m_RegEx is valid
     bool            m_isCompiled;
+
+#if PCRE2_CODE_UNIT_WIDTH != 8
+    // the buffer used by MatchesUTF8() for converting the text to wxRegChar,
+    // reused between the calls to avoid reallocating it every time
+    wxVector<wxRegChar> m_textBuf;
+#endif
 };
 
 
@@ -1038,7 +1087,8 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
     wxASSERT_MSG( (flags & FLAVORS) != FLAVORS,
                   wxT("incompatible flags in wxRegEx::Compile") );
 #endif
-    wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
+    wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE |
+                              wxRE_JIT)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
 #if wxUSE_PCRE
@@ -1075,6 +1125,10 @@ bool wxRegExImpl::Compile(wxString expr, int flags)
         flagsRE |= REG_NOSUB;
     if ( flags & wxRE_NEWLINE )
         flagsRE |= REG_NEWLINE;
+#if wxUSE_PCRE
+    if ( flags & wxRE_JIT )
+        flagsRE |= REG_JIT;
+#endif // wxUSE_PCRE
 
 #ifndef WXREGEX_CONVERT_TO_MB
     const wxChar *exprstr = expr.c_str();
@@ -1201,6 +1255,88 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     }
 }
 
+#if PCRE2_CODE_UNIT_WIDTH != 8
+
+// Return the offset in bytes in the given UTF-8 string corresponding to the
+// given offset in code units of the same string converted to wxRegChar.
+static size_t
+UTF8OffsetFromRegChars(const char *str, size_t len, size_t offset)
+{
+    size_t pos = 0;
+    while ( offset && pos < len )
+    {
+        const unsigned char c = static_cast<unsigned char>(str[pos]);
+
+        size_t lenSeq;
+        if ( c < 0x80 )
+            lenSeq = 1;
+        else if ( c < 0xe0 )
+            lenSeq = 2;
+        else if ( c < 0xf0 )
+            lenSeq = 3;
+        else
+            lenSeq = 4;
+
+        // Characters outside of the BMP use surrogate pairs in UTF-16.
+        const size_t units = sizeof(wxRegChar) == 2 && lenSeq == 4 ? 2 : 1;
+        if ( offset < units )
+            break;
+
+        offset -= units;
+        pos += lenSeq;
+    }
+
+    return pos < len ? pos : len;
+}
+
+#endif // PCRE2_CODE_UNIT_WIDTH != 8
+
+bool wxRegExImpl::MatchesUTF8(const char *str, size_t len, int flags) const
+{
+#if PCRE2_CODE_UNIT_WIDTH == 8
+    // PCRE works with UTF-8 directly, no need to copy anything.
+    return Matches(str, flags, len);
+#else // PCRE2_CODE_UNIT_WIDTH != 8
+    // We need to convert the text, but at least avoid allocating a new buffer
+    // for it every time: as UTF-8 never uses fewer bytes than the number of
+    // UTF-16 or UTF-32 code units, a buffer of the same length is enough.
+    wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
+    if ( m_textBuf.size() < len + 1 )
+        self->m_textBuf.resize(len + 1);
+
+    size_t lenConv = 0;
+    if ( len )
+    {
+        lenConv = wxConvUTF8.ToWChar(&self->m_textBuf[0], len, str, len);
+        if ( lenConv == wxCONV_FAILED )
+        {
+            // invalid UTF-8 can't match anything
+            return false;
+        }
+    }
+
+    if ( !Matches(&m_textBuf[0], flags, lenConv) )
+        return false;
+
+    // Translate the match offsets to bytes.
+    if ( m_Matches )
+    {
+        regmatch_t* const matches = m_Matches->get();
+        for ( size_t n = 0; n < m_nMatches; n++ )
+        {
+            regmatch_t& m = matches[n];
+            if ( m.rm_so == static_cast<regoff_t>(-1) )
+                continue;
+
+            m.rm_so = UTF8OffsetFromRegChars(str, len, m.rm_so);
+            m.rm_eo = UTF8OffsetFromRegChars(str, len, m.rm_eo);
+        }
+    }
+
+    return true;
+#endif // PCRE2_CODE_UNIT_WIDTH == 8/!= 8
+}
+
 bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -1403,6 +1539,13 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
     return m_impl->Matches(textstr, flags, textlen);
 }
 
+bool wxRegEx::MatchesUTF8(const char *text, size_t len, int flags) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+    return m_impl->MatchesUTF8(text, len, flags);
+}
+
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -49,6 +49,20 @@
 #include "wx/osx/core/private/strconv_cf.h"
 #endif //def __DARWIN__
 
+// For the SIMD intrinsics used by the fast paths of UTF conversions.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define wxSTRCONV_USE_AVX2
+    #define wxSTRCONV_USE_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define wxSTRCONV_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define wxSTRCONV_USE_NEON
+#endif
+
 
 #define TRACE_STRCONV wxT("strconv")
 
@@ -76,7 +90,7 @@ static bool NotAllNULs(const char *p, size_t n)
 // UTF-16 en/decoding to/from UCS-4 with surrogates handling
 // ----------------------------------------------------------------------------
 
-static size_t encode_utf16(wxUint32 input, wxUint16 *output)
+static inline size_t encode_utf16(wxUint32 input, wxUint16 *output)
 {
     if (wxUniChar::IsBMP(input))
     {
@@ -107,7 +121,8 @@ static size_t encode_utf16(wxUint32 input, wxUint16 *output)
 //
 // If an invalid or incomplete character is found, *pSrc is set to NULL, the
 // caller must check for this.
-static wxUint32 wxDecodeSurrogate(const wxChar16 **pSrc, const wxChar16* end)
+static inline wxUint32
+wxDecodeSurrogate(const wxChar16 **pSrc, const wxChar16* end)
 {
     const wxChar16*& src = *pSrc;
 
@@ -141,6 +156,519 @@ static wxUint32 wxDecodeSurrogate(const wxChar16 **pSrc, const wxChar16* end)
     return ((u - 0xd7c0) << 10) + (u2 - 0xdc00);
 }
 
+// ----------------------------------------------------------------------------
+// fast paths for the runs of characters not needing any special handling
+// ----------------------------------------------------------------------------
+
+// All the functions in this section, except for the byte swapping ones,
+// convert as many characters from the beginning of the input as possible,
+// stopping at the first character which needs to be handled by the general
+// code, and return their number. The output buffer may be NULL if the
+// characters only need to be counted.
+//
+// The wxDoXXX() functions check the input in blocks of 16 (or 32) characters
+// at once using SIMD instructions if available and fall back to the scalar
+// code for the remaining characters. The inline wrappers calling them only do
+// it if at least the first two characters can be handled, to avoid slowing
+// down the conversion of the text in which such characters are rare, e.g.
+// CJK or emoji.
+
+// Copy the leading ASCII characters of UTF-8 input to the output.
+static size_t
+wxDoDecodeASCIIRun(wchar_t *dst, const char *src, size_t srcLen)
+{
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_AVX2)
+    for ( ; n + 32 <= srcLen; n += 32 )
+    {
+        const __m256i
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + n));
+        if ( _mm256_movemask_epi8(v) )
+            break;
+
+        if ( dst )
+        {
+#ifdef WC_UTF16
+            for ( size_t k = 0; k < 32; k += 16 )
+            {
+                const __m128i
+                    b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n + k));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n + k),
+                                    _mm256_cvtepu8_epi16(b));
+            }
+#else // !WC_UTF16
+            for ( size_t k = 0; k < 32; k += 8 )
+            {
+                const __m128i
+                    b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + n + k));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n + k),
+                                    _mm256_cvtepu8_epi32(b));
+            }
+#endif // WC_UTF16/!WC_UTF16
+        }
+    }
+#elif defined(wxSTRCONV_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= srcLen; n += 16 )
+    {
+        const __m128i
+            v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + n));
+        if ( _mm_movemask_epi8(v) )
+            break;
+
+        if ( dst )
+        {
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            __m128i* const out = reinterpret_cast<__m128i*>(dst + n);
+#ifdef WC_UTF16
+            _mm_storeu_si128(out, lo);
+            _mm_storeu_si128(out + 1, hi);
+#else // !WC_UTF16
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+#endif // WC_UTF16/!WC_UTF16
+        }
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    for ( ; n + 16 <= srcLen; n += 16 )
+    {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + n));
+        const uint8x8_t any = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+        if ( vget_lane_u64(vreinterpret_u64_u8(any), 0) & wxULL(0x8080808080808080) )
+            break;
+
+        if ( dst )
+        {
+            const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+            const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+#ifdef WC_UTF16
+            uint16_t* const out = reinterpret_cast<uint16_t*>(dst + n);
+            vst1q_u16(out, lo);
+            vst1q_u16(out + 8, hi);
+#else // !WC_UTF16
+            uint32_t* const out = reinterpret_cast<uint32_t*>(dst + n);
+            vst1q_u32(out, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(out + 4, vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(out + 12, vmovl_u16(vget_high_u16(hi)));
+#endif // WC_UTF16/!WC_UTF16
+        }
+    }
+#else // no SIMD
+    // Still check 8 bytes at once.
+    for ( ; n + 8 <= srcLen; n += 8 )
+    {
+        wxUint64 v;
+        memcpy(&v, src + n, sizeof(v));
+        if ( v & wxULL(0x8080808080808080) )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t k = n; k < n + 8; k++ )
+                dst[k] = static_cast<unsigned char>(src[k]);
+        }
+    }
+#endif // SIMD
+
+    for ( ; n < srcLen; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c & 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = c;
+    }
+
+    return n;
+}
+
+static inline size_t
+wxDecodeASCIIRun(wchar_t *dst, const char *src, size_t srcLen)
+{
+    if ( srcLen < 2 || (src[0] & 0x80) || (src[1] & 0x80) )
+        return 0;
+
+    return wxDoDecodeASCIIRun(dst, src, srcLen);
+}
+
+// Copy the leading ASCII characters of wide input to UTF-8 output.
+static size_t
+wxDoEncodeASCIIRun(char *dst, const wchar_t *src, size_t srcLen)
+{
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i* const in = reinterpret_cast<const __m128i*>(src);
+#ifdef WC_UTF16
+    const __m128i nonASCII = _mm_set1_epi16(static_cast<short>(0xff80));
+    for ( ; n + 16 <= srcLen; n += 16 )
+    {
+        const __m128i a = _mm_loadu_si128(in + n/8);
+        const __m128i b = _mm_loadu_si128(in + n/8 + 1);
+        const __m128i
+            high = _mm_and_si128(_mm_or_si128(a, b), nonASCII);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff )
+            break;
+
+        if ( dst )
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n),
+                             _mm_packus_epi16(a, b));
+        }
+    }
+#else // !WC_UTF16
+    const __m128i nonASCII = _mm_set1_epi32(~0x7f);
+    for ( ; n + 16 <= srcLen; n += 16 )
+    {
+        const __m128i a = _mm_loadu_si128(in + n/4);
+        const __m128i b = _mm_loadu_si128(in + n/4 + 1);
+        const __m128i c = _mm_loadu_si128(in + n/4 + 2);
+        const __m128i d = _mm_loadu_si128(in + n/4 + 3);
+        const __m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b),
+                                                        _mm_or_si128(c, d)),
+                                           nonASCII);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xffff )
+            break;
+
+        if ( dst )
+        {
+            // All values are in 0..0x7f range, so saturation doesn't matter.
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n),
+                             _mm_packus_epi16(_mm_packs_epi32(a, b),
+                                              _mm_packs_epi32(c, d)));
+        }
+    }
+#endif // WC_UTF16/!WC_UTF16
+#elif defined(wxSTRCONV_USE_NEON)
+#ifdef WC_UTF16
+    const uint16x8_t nonASCII = vdupq_n_u16(0xff80);
+    for ( ; n + 16 <= srcLen; n += 16 )
+    {
+        const uint16_t* const in = reinterpret_cast<const uint16_t*>(src + n);
+        const uint16x8_t a = vld1q_u16(in);
+        const uint16x8_t b = vld1q_u16(in + 8);
+        const uint16x8_t high = vandq_u16(vorrq_u16(a, b), nonASCII);
+        const uint16x4_t any = vorr_u16(vget_low_u16(high), vget_high_u16(high));
+        if ( vget_lane_u64(vreinterpret_u64_u16(any), 0) )
+            break;
+
+        if ( dst )
+        {
+            uint8_t* const out = reinterpret_cast<uint8_t*>(dst + n);
+            vst1_u8(out, vmovn_u16(a));
+            vst1_u8(out + 8, vmovn_u16(b));
+        }
+    }
+#else // !WC_UTF16
+    const uint32x4_t nonASCII = vdupq_n_u32(~0x7fu);
+    for ( ; n + 16 <= srcLen; n += 16 )
+    {
+        const uint32_t* const in = reinterpret_cast<const uint32_t*>(src + n);
+        const uint32x4_t a = vld1q_u32(in);
+        const uint32x4_t b = vld1q_u32(in + 4);
+        const uint32x4_t c = vld1q_u32(in + 8);
+        const uint32x4_t d = vld1q_u32(in + 12);
+        const uint32x4_t high = vandq_u32(vorrq_u32(vorrq_u32(a, b),
+                                                    vorrq_u32(c, d)),
+                                          nonASCII);
+        const uint32x2_t any = vorr_u32(vget_low_u32(high), vget_high_u32(high));
+        if ( vget_lane_u64(vreinterpret_u64_u32(any), 0) )
+            break;
+
+        if ( dst )
+        {
+            uint8_t* const out = reinterpret_cast<uint8_t*>(dst + n);
+            vst1_u8(out, vmovn_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b))));
+            vst1_u8(out + 8, vmovn_u16(vcombine_u16(vmovn_u32(c), vmovn_u32(d))));
+        }
+    }
+#endif // WC_UTF16/!WC_UTF16
+#endif // SIMD
+
+    for ( ; n < srcLen; n++ )
+    {
+        const wxUint32 c = static_cast<wxUint32>(src[n]);
+        if ( c > 0x7f )
+            break;
+
+        if ( dst )
+            dst[n] = static_cast<char>(c);
+    }
+
+    return n;
+}
+
+static inline size_t
+wxEncodeASCIIRun(char *dst, const wchar_t *src, size_t srcLen)
+{
+    if ( srcLen < 2 ||
+            static_cast<wxUint32>(src[0]) > 0x7f ||
+                static_cast<wxUint32>(src[1]) > 0x7f )
+        return 0;
+
+    return wxDoEncodeASCIIRun(dst, src, srcLen);
+}
+
+#ifndef WC_UTF16
+
+// Copy the leading BMP characters, i.e. not surrogates, of UTF-16 input,
+// which may be in the opposite byte order, to UTF-32 wchar_t output.
+static size_t
+wxDoDecodeUTF16Run(wchar_t *dst, const char *src, size_t srcLen, bool swap)
+{
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i surrogateMask = _mm_set1_epi16(static_cast<short>(0xf800));
+    const __m128i surrogate = _mm_set1_epi16(static_cast<short>(0xd800));
+    for ( ; n + 8 <= srcLen; n += 8 )
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2*n));
+        if ( swap )
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+        const __m128i
+            isSurrogate = _mm_cmpeq_epi16(_mm_and_si128(v, surrogateMask),
+                                          surrogate);
+        if ( _mm_movemask_epi8(isSurrogate) )
+            break;
+
+        if ( dst )
+        {
+            __m128i* const out = reinterpret_cast<__m128i*>(dst + n);
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(v, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(v, zero));
+        }
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    const uint16x8_t surrogateMask = vdupq_n_u16(0xf800);
+    const uint16x8_t surrogate = vdupq_n_u16(0xd800);
+    for ( ; n + 8 <= srcLen; n += 8 )
+    {
+        uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(src + 2*n));
+        if ( swap )
+            bytes = vrev16q_u8(bytes);
+
+        const uint16x8_t v = vreinterpretq_u16_u8(bytes);
+        const uint16x8_t
+            isSurrogate = vceqq_u16(vandq_u16(v, surrogateMask), surrogate);
+        const uint16x4_t
+            any = vorr_u16(vget_low_u16(isSurrogate), vget_high_u16(isSurrogate));
+        if ( vget_lane_u64(vreinterpret_u64_u16(any), 0) )
+            break;
+
+        if ( dst )
+        {
+            uint32_t* const out = reinterpret_cast<uint32_t*>(dst + n);
+            vst1q_u32(out, vmovl_u16(vget_low_u16(v)));
+            vst1q_u32(out + 4, vmovl_u16(vget_high_u16(v)));
+        }
+    }
+#endif // SIMD
+
+    for ( ; n < srcLen; n++ )
+    {
+        wxUint16 u;
+        memcpy(&u, src + 2*n, sizeof(u));
+        if ( swap )
+            u = wxUINT16_SWAP_ALWAYS(u);
+
+        if ( u >= 0xd800 && u <= 0xdfff )
+            break;
+
+        if ( dst )
+            dst[n] = u;
+    }
+
+    return n;
+}
+
+static inline size_t
+wxDecodeUTF16Run(wchar_t *dst, const char *src, size_t srcLen, bool swap)
+{
+    if ( srcLen < 2 )
+        return 0;
+
+    wxUint16 first[2];
+    memcpy(first, src, sizeof(first));
+    if ( swap )
+    {
+        first[0] = wxUINT16_SWAP_ALWAYS(first[0]);
+        first[1] = wxUINT16_SWAP_ALWAYS(first[1]);
+    }
+
+    if ( (first[0] & 0xf800) == 0xd800 || (first[1] & 0xf800) == 0xd800 )
+        return 0;
+
+    return wxDoDecodeUTF16Run(dst, src, srcLen, swap);
+}
+
+// Copy the leading BMP characters of UTF-32 wchar_t input to UTF-16 output,
+// possibly swapping its bytes.
+static size_t
+wxDoEncodeUTF16Run(char *dst, const wchar_t *src, size_t srcLen, bool swap)
+{
+    size_t n = 0;
+
+#if defined(wxSTRCONV_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonBMP = _mm_set1_epi32(~0xffff);
+    for ( ; n + 8 <= srcLen; n += 8 )
+    {
+        const __m128i* const in = reinterpret_cast<const __m128i*>(src + n);
+        const __m128i a = _mm_loadu_si128(in);
+        const __m128i b = _mm_loadu_si128(in + 1);
+        const __m128i high = _mm_and_si128(_mm_or_si128(a, b), nonBMP);
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xffff )
+            break;
+
+        if ( dst )
+        {
+            // There is no unsigned 32 to 16 bit packing in SSE2, so sign
+            // extend the low halves to make the signed saturation a no-op.
+            __m128i v = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                        _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+            if ( swap )
+                v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2*n), v);
+        }
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    const uint32x4_t nonBMP = vdupq_n_u32(~0xffffu);
+    for ( ; n + 8 <= srcLen; n += 8 )
+    {
+        const uint32_t* const in = reinterpret_cast<const uint32_t*>(src + n);
+        const uint32x4_t a = vld1q_u32(in);
+        const uint32x4_t b = vld1q_u32(in + 4);
+        const uint32x4_t high = vandq_u32(vorrq_u32(a, b), nonBMP);
+        const uint32x2_t any = vorr_u32(vget_low_u32(high), vget_high_u32(high));
+        if ( vget_lane_u64(vreinterpret_u64_u32(any), 0) )
+            break;
+
+        if ( dst )
+        {
+            uint8x16_t
+                v = vreinterpretq_u8_u16(vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+            if ( swap )
+                v = vrev16q_u8(v);
+
+            vst1q_u8(reinterpret_cast<uint8_t*>(dst + 2*n), v);
+        }
+    }
+#endif // SIMD
+
+    for ( ; n < srcLen; n++ )
+    {
+        const wxUint32 c = static_cast<wxUint32>(src[n]);
+        if ( c > 0xffff )
+            break;
+
+        if ( dst )
+        {
+            wxUint16 u = static_cast<wxUint16>(c);
+            if ( swap )
+                u = wxUINT16_SWAP_ALWAYS(u);
+
+            memcpy(dst + 2*n, &u, sizeof(u));
+        }
+    }
+
+    return n;
+}
+
+static inline size_t
+wxEncodeUTF16Run(char *dst, const wchar_t *src, size_t srcLen, bool swap)
+{
+    if ( srcLen < 2 ||
+            static_cast<wxUint32>(src[0]) > 0xffff ||
+                static_cast<wxUint32>(src[1]) > 0xffff )
+        return 0;
+
+    return wxDoEncodeUTF16Run(dst, src, srcLen, swap);
+}
+
+// Reverse the byte order of the given number of 32 bit values, the input
+// and output don't need to be aligned.
+static void wxSwapBytes32(void *dst, const void *src, size_t count)
+{
+    char* const out = static_cast<char*>(dst);
+    const char* const in = static_cast<const char*>(src);
+
+    size_t n = 0;
+#if defined(wxSTRCONV_USE_SSE2)
+    for ( ; n + 4 <= count; n += 4 )
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4*n));
+
+        // Swap the bytes in each 16 bit half and then the halves themselves.
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4*n), v);
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    for ( ; n + 4 <= count; n += 4 )
+    {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(in + 4*n));
+        vst1q_u8(reinterpret_cast<uint8_t*>(out + 4*n), vrev32q_u8(v));
+    }
+#endif // SIMD
+
+    for ( ; n < count; n++ )
+    {
+        wxUint32 u;
+        memcpy(&u, in + 4*n, sizeof(u));
+        u = wxUINT32_SWAP_ALWAYS(u);
+        memcpy(out + 4*n, &u, sizeof(u));
+    }
+}
+
+#else // WC_UTF16
+
+// Reverse the byte order of the given number of 16 bit values, the input
+// and output don't need to be aligned.
+static void wxSwapBytes16(void *dst, const void *src, size_t count)
+{
+    char* const out = static_cast<char*>(dst);
+    const char* const in = static_cast<const char*>(src);
+
+    size_t n = 0;
+#if defined(wxSTRCONV_USE_SSE2)
+    for ( ; n + 8 <= count; n += 8 )
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2*n));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*n),
+                         _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#elif defined(wxSTRCONV_USE_NEON)
+    for ( ; n + 8 <= count; n += 8 )
+    {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(in + 2*n));
+        vst1q_u8(reinterpret_cast<uint8_t*>(out + 2*n), vrev16q_u8(v));
+    }
+#endif // SIMD
+
+    for ( ; n < count; n++ )
+    {
+        wxUint16 u;
+        memcpy(&u, in + 2*n, sizeof(u));
+        u = wxUINT16_SWAP_ALWAYS(u);
+        memcpy(out + 2*n, &u, sizeof(u));
+    }
+}
+
+#endif // !WC_UTF16/WC_UTF16
+
 // ----------------------------------------------------------------------------
 // wxMBConv
 // ----------------------------------------------------------------------------
@@ -999,6 +1527,27 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
             if ( srcLen != wxNO_LEN )
                 srcLen--;
 
+            // ASCII characters usually come in runs, so try to convert all
+            // the following ones at once, this is much faster than doing it
+            // one by one.
+            const size_t
+                n = wxDecodeASCIIRun(out ? out + 1 : NULL, p + 1,
+                                     out && dstLen < srcLen ? dstLen : srcLen);
+            if ( n )
+            {
+                if ( out )
+                {
+                    *out = c;
+                    out += n + 1;
+                    dstLen -= n;
+                }
+
+                written += n + 1;
+                srcLen -= n;
+                p += n;
+                continue;
+            }
+
             code = c;
         }
         else
@@ -1075,10 +1624,13 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     char *out = dstLen ? dst : NULL;
     size_t written = 0;
 
-    const wchar_t* const end = srcLen == wxNO_LEN ? NULL : src + srcLen;
+    // Find the end of NUL-terminated input too, to be able to use the fast
+    // path below for it.
+    const wchar_t* const
+        end = src + (srcLen == wxNO_LEN ? wxWcslen(src) : srcLen);
     for ( const wchar_t *wp = src; ; )
     {
-        if ( end ? wp == end : !*wp )
+        if ( wp == end )
         {
             // all done successfully, just add the trailing NULL if we are not
             // using explicit length
@@ -1107,7 +1659,7 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
         code = *wp++ & 0x7fffffff;
 #endif
 
-        unsigned len;
+        size_t len;
         if ( code <= 0x7F )
         {
             len = 1;
@@ -1118,6 +1670,17 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
 
                 out[0] = (char)code;
             }
+
+            // ASCII characters usually come in runs, so try to convert all
+            // the following ones at once, this is much faster than doing it
+            // one by one.
+            size_t n = end - wp;
+            if ( out && dstLen - len < n )
+                n = dstLen - len;
+
+            n = wxEncodeASCIIRun(out ? out + len : NULL, wp, n);
+            wp += n;
+            len += n;
         }
         else if ( code <= 0x07FF )
         {
@@ -1190,8 +1753,33 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
     // The length can be either given explicitly or computed implicitly for the
     // NUL-terminated strings.
     const bool isNulTerminated = srcLen == wxNO_LEN;
+
+    // ASCII characters can be copied in bulk unless they need escaping.
+    const bool canCopyASCII = !isNulTerminated &&
+                                !(m_options & MAP_INVALID_UTF8_TO_OCTAL);
+
     while ((isNulTerminated ? *psz : srcLen--) && ((!buf) || (len < n)))
     {
+        if ( canCopyASCII )
+        {
+            // Notice that srcLen was already decremented for this character.
+            size_t count = srcLen + 1;
+            if ( buf && n - len < count )
+                count = n - len;
+
+            count = wxDecodeASCIIRun(buf, psz, count);
+            if ( count )
+            {
+                psz += count;
+                srcLen -= count - 1;
+                len += count;
+                if ( buf )
+                    buf += count;
+
+                continue;
+            }
+        }
+
         const char *opsz = psz;
         unsigned char cc = *psz++, fc = cc;
         unsigned cnt;
@@ -1363,8 +1951,30 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
     // The length can be either given explicitly or computed implicitly for the
     // NUL-terminated strings.
     const wchar_t* const end = srcLen == wxNO_LEN ? NULL : psz + srcLen;
+
+    // ASCII characters can be copied in bulk unless they need escaping.
+    const bool canCopyASCII = end && !(m_options & MAP_INVALID_UTF8_TO_OCTAL);
+
     while ((end ? psz < end : *psz) && ((!buf) || (len < n)))
     {
+        if ( canCopyASCII )
+        {
+            size_t count = end - psz;
+            if ( buf && n - len < count )
+                count = n - len;
+
+            count = wxEncodeASCIIRun(buf, psz, count);
+            if ( count )
+            {
+                psz += count;
+                len += count;
+                if ( buf )
+                    buf += count;
+
+                continue;
+            }
+        }
+
         wxUint32 cc;
 
 #ifdef WC_UTF16
@@ -1546,11 +2156,7 @@ wxMBConvUTF16swap::ToWChar(wchar_t *dst, size_t dstLen,
         if ( dstLen < srcLen )
             return wxCONV_FAILED;
 
-        const wxUint16 *inBuff = reinterpret_cast<const wxUint16 *>(src);
-        for ( size_t n = 0; n < srcLen; n++, inBuff++ )
-        {
-            *dst++ = wxUINT16_SWAP_ALWAYS(*inBuff);
-        }
+        wxSwapBytes16(dst, src, srcLen);
     }
 
     return srcLen;
@@ -1570,11 +2176,7 @@ wxMBConvUTF16swap::FromWChar(char *dst, size_t dstLen,
         if ( dstLen < srcLen )
             return wxCONV_FAILED;
 
-        wxUint16 *outBuff = reinterpret_cast<wxUint16 *>(dst);
-        for ( size_t n = 0; n < srcLen; n += BYTES_PER_CHAR, src++ )
-        {
-            *outBuff++ = wxUINT16_SWAP_ALWAYS(*src);
-        }
+        wxSwapBytes16(dst, src, srcLen / BYTES_PER_CHAR);
     }
 
     return srcLen;
@@ -1612,8 +2214,23 @@ wxMBConvUTF16straight::ToWChar(wchar_t *dst, size_t dstLen,
 
             *dst++ = ch;
         }
-    }
 
+        // BMP characters usually come in runs, so try to convert all the
+        // following ones up to the next surrogate at once.
+        if ( ch < 0x10000 )
+        {
+            size_t n = inEnd - inBuff;
+            if ( dst && dstLen - outLen < n )
+                n = dstLen - outLen;
+
+            n = wxDecodeUTF16Run(dst, reinterpret_cast<const char *>(inBuff),
+                                 n, false);
+            inBuff += n;
+            outLen += n;
+            if ( dst )
+                dst += n;
+        }
+    }
 
     return outLen;
 }
@@ -1627,7 +2244,7 @@ wxMBConvUTF16straight::FromWChar(char *dst, size_t dstLen,
 
     size_t outLen = 0;
     wxUint16 *outBuff = reinterpret_cast<wxUint16 *>(dst);
-    for ( size_t n = 0; n < srcLen; n++ )
+    for ( const wchar_t * const srcEnd = src + srcLen; src < srcEnd; )
     {
         wxUint16 cc[2] = { 0 };
         const size_t numChars = encode_utf16(*src++, cc);
@@ -1647,6 +2264,21 @@ wxMBConvUTF16straight::FromWChar(char *dst, size_t dstLen,
                 *outBuff++ = cc[1];
             }
         }
+
+        // Convert all the following BMP characters at once too.
+        if ( numChars == 1 )
+        {
+            size_t n = srcEnd - src;
+            if ( outBuff && (dstLen - outLen) / BYTES_PER_CHAR < n )
+                n = (dstLen - outLen) / BYTES_PER_CHAR;
+
+            n = wxEncodeUTF16Run(reinterpret_cast<char *>(outBuff), src, n,
+                                 false);
+            src += n;
+            outLen += n * BYTES_PER_CHAR;
+            if ( outBuff )
+                outBuff += n;
+        }
     }
 
     return outLen;
@@ -1699,8 +2331,23 @@ wxMBConvUTF16swap::ToWChar(wchar_t *dst, size_t dstLen,
 
             *dst++ = ch;
         }
-    }
 
+        // BMP characters usually come in runs, so try to convert all the
+        // following ones up to the next surrogate at once.
+        if ( ch < 0x10000 )
+        {
+            size_t n = inEnd - inBuff;
+            if ( dst && dstLen - outLen < n )
+                n = dstLen - outLen;
+
+            n = wxDecodeUTF16Run(dst, reinterpret_cast<const char *>(inBuff),
+                                 n, true);
+            inBuff += n;
+            outLen += n;
+            if ( dst )
+                dst += n;
+        }
+    }
 
     return outLen;
 }
@@ -1714,10 +2361,10 @@ wxMBConvUTF16swap::FromWChar(char *dst, size_t dstLen,
 
     size_t outLen = 0;
     wxUint16 *outBuff = reinterpret_cast<wxUint16 *>(dst);
-    for ( const wchar_t *srcEnd = src + srcLen; src < srcEnd; src++ )
+    for ( const wchar_t * const srcEnd = src + srcLen; src < srcEnd; )
     {
         wxUint16 cc[2] = { 0 };
-        const size_t numChars = encode_utf16(*src, cc);
+        const size_t numChars = encode_utf16(*src++, cc);
         if ( numChars == wxCONV_FAILED )
             return wxCONV_FAILED;
 
@@ -1734,6 +2381,21 @@ wxMBConvUTF16swap::FromWChar(char *dst, size_t dstLen,
                 *outBuff++ = wxUINT16_SWAP_ALWAYS(cc[1]);
             }
         }
+
+        // Convert all the following BMP characters at once too.
+        if ( numChars == 1 )
+        {
+            size_t n = srcEnd - src;
+            if ( outBuff && (dstLen - outLen) / BYTES_PER_CHAR < n )
+                n = (dstLen - outLen) / BYTES_PER_CHAR;
+
+            n = wxEncodeUTF16Run(reinterpret_cast<char *>(outBuff), src, n,
+                                 true);
+            src += n;
+            outLen += n * BYTES_PER_CHAR;
+            if ( outBuff )
+                outBuff += n;
+        }
     }
 
     return outLen;
@@ -1987,11 +2649,7 @@ wxMBConvUTF32swap::ToWChar(wchar_t *dst, size_t dstLen,
         if ( dstLen < srcLen )
             return wxCONV_FAILED;
 
-        const wxUint32 *inBuff = reinterpret_cast<const wxUint32 *>(src);
-        for ( size_t n = 0; n < srcLen; n++, inBuff++ )
-        {
-            *dst++ = wxUINT32_SWAP_ALWAYS(*inBuff);
-        }
+        wxSwapBytes32(dst, src, srcLen);
     }
 
     return srcLen;
@@ -2011,11 +2669,7 @@ wxMBConvUTF32swap::FromWChar(char *dst, size_t dstLen,
         if ( dstLen < srcLen )
             return wxCONV_FAILED;
 
-        wxUint32 *outBuff = reinterpret_cast<wxUint32 *>(dst);
-        for ( size_t n = 0; n < srcLen; n += BYTES_PER_CHAR, src++ )
-        {
-            *outBuff++ = wxUINT32_SWAP_ALWAYS(*src);
-        }
+        wxSwapBytes32(dst, src, srcLen / BYTES_PER_CHAR);
     }
 
     return srcLen;
@@ -13,6 +13,19 @@
 
 #include "wx/private/threadinfo.h"
 
+#if wxUSE_REGEX
+// Defined in src/common/regex.cpp.
+extern void wxFreeRegExJITStack(void* stack);
+#endif
+
+wxThreadSpecificInfo::~wxThreadSpecificInfo()
+{
+#if wxUSE_REGEX
+    if ( regexJITStack )
+        wxFreeRegExJITStack(regexJITStack);
+#endif
+}
+
 #if wxUSE_THREADS
 
 #include "wx/tls.h"
@@ -0,0 +1,821 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#if wxUSE_THREADS
+
+#include "wx/threadpool.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include "wx/except.h"
+#include "wx/stopwatch.h"
+#include "wx/tls.h"
+
+#include "wx/beforestd.h"
+#include <deque>
+#include "wx/afterstd.h"
+
+namespace
+{
+
+// The tasks queue: the tasks are added to its back and taken from its front
+// by the other threads, but the worker owning the queue takes the tasks from
+// the back too, to process the most recently submitted (and hence most likely
+// still in cache) tasks first.
+class TaskQueue
+{
+public:
+    TaskQueue() { }
+
+    void PushBack(wxThreadPoolTask* task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        m_tasks.push_back(task);
+    }
+
+    wxThreadPoolTask* PopFront()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        if ( m_tasks.empty() )
+            return NULL;
+
+        wxThreadPoolTask* const task = m_tasks.front();
+        m_tasks.pop_front();
+        return task;
+    }
+
+    wxThreadPoolTask* PopBack()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        if ( m_tasks.empty() )
+            return NULL;
+
+        wxThreadPoolTask* const task = m_tasks.back();
+        m_tasks.pop_back();
+        return task;
+    }
+
+private:
+    wxCriticalSection m_cs;
+    std::deque<wxThreadPoolTask*> m_tasks;
+
+    wxDECLARE_NO_COPY_CLASS(TaskQueue);
+};
+
+class WorkerThread;
+
+// Return the pool worker thread corresponding to the current thread, if any.
+WorkerThread*& CurrentWorker()
+{
+    static wxTLS_TYPE(WorkerThread*) s_currentWorker;
+
+    return wxTLS_VALUE(s_currentWorker);
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolImpl: the real implementation of wxThreadPool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolImpl
+{
+public:
+    explicit wxThreadPoolImpl(int numThreads);
+    ~wxThreadPoolImpl();
+
+    int GetThreadCount() const { return static_cast<int>(m_workers.size()); }
+    int GetPendingCount() const { return m_queued; }
+
+    void Submit(wxThreadPoolTask* task, wxThreadPoolPriority priority);
+
+    // Return true if the current thread is one of our workers.
+    bool IsWorkerThread() const;
+
+    // Wait until the task finishes or the timeout, which may be -1, expires.
+    bool Wait(wxThreadPoolTask* task, long timeoutMillis);
+
+    // Wake up the threads waiting for a task to finish.
+    void NotifyWaiters();
+
+    // Main loop of the worker thread.
+    void WorkerMain(WorkerThread* worker);
+
+private:
+    // Find the next task to execute, with the highest priority.
+    wxThreadPoolTask* FindTask(WorkerThread* worker);
+
+    // Execute the task found by FindTask().
+    void Execute(wxThreadPoolTask* task);
+
+
+    wxVector<WorkerThread*> m_workers;
+
+    // Queues for the tasks submitted from outside the worker threads.
+    TaskQueue m_queues[wxTHREAD_POOL_PRIORITY_MAX];
+
+    // Number of the tasks in all queues, including the local ones.
+    wxAtomicInt m_queued;
+
+    // Used for sleeping when there are no tasks and waiting for the tasks to
+    // finish, all the fields below are protected by it.
+    wxMutex m_mutex;
+    wxCondition m_condWork,
+                m_condDone;
+    int m_sleepingWorkers,
+        m_waiters;
+    bool m_stop;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolImpl);
+};
+
+namespace
+{
+
+class WorkerThread : public wxThread
+{
+public:
+    WorkerThread(wxThreadPoolImpl* pool, int index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool),
+          m_index(index)
+    {
+    }
+
+    wxThreadPoolImpl* GetPool() const { return m_pool; }
+    int GetIndex() const { return m_index; }
+
+    // The tasks submitted from this thread, they are taken from here by this
+    // thread first but can be also stolen by the other ones.
+    TaskQueue m_queues[wxTHREAD_POOL_PRIORITY_MAX];
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        CurrentWorker() = this;
+
+        m_pool->WorkerMain(this);
+
+        return NULL;
+    }
+
+private:
+    wxThreadPoolImpl* const m_pool;
+    const int m_index;
+
+    wxDECLARE_NO_COPY_CLASS(WorkerThread);
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask
+// ----------------------------------------------------------------------------
+
+wxThreadPoolTask::wxThreadPoolTask()
+    : m_refCount(1),
+      m_cancelled(0),
+      m_state(State_Queued)
+{
+}
+
+wxThreadPoolTask::~wxThreadPoolTask()
+{
+    // Normally the completions are dispatched when the task finishes, but a
+    // task which was never submitted could still have some.
+    for ( size_t n = 0; n < m_completions.size(); n++ )
+        delete m_completions[n].event;
+}
+
+void wxThreadPoolTask::DecRef()
+{
+    if ( wxAtomicDec(m_refCount) == 0 )
+        delete this;
+}
+
+bool wxThreadPoolTask::IsFinished() const
+{
+    wxCriticalSectionLocker lock(m_cs);
+
+    return m_state == State_Done || m_state == State_Cancelled;
+}
+
+bool wxThreadPoolTask::StartRunning()
+{
+    wxCriticalSectionLocker lock(m_cs);
+
+    if ( m_state != State_Queued )
+        return false;
+
+    m_state = State_Running;
+    return true;
+}
+
+bool wxThreadPoolTask::CancelIfQueued()
+{
+    wxAtomicInc(m_cancelled);
+
+    wxCriticalSectionLocker lock(m_cs);
+
+    if ( m_state != State_Queued )
+        return false;
+
+    // Mark it as cancelled while still holding the lock to ensure that it is
+    // not started by a worker thread: it will still remain in the queue, but
+    // will be just skipped when it's taken from it.
+    m_state = State_Cancelled;
+
+    return true;
+}
+
+void wxThreadPoolTask::Finish(State state)
+{
+    wxVector<Completion> completions;
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        m_state = state;
+        completions.swap(m_completions);
+    }
+
+    for ( size_t n = 0; n < completions.size(); n++ )
+        completions[n].handler->QueueEvent(completions[n].event);
+}
+
+void wxThreadPoolTask::AddCompletion(wxEvtHandler* handler,
+                                     wxAsyncMethodCallEvent* event)
+{
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_state != State_Done && m_state != State_Cancelled )
+        {
+            const Completion completion = { handler, event };
+            m_completions.push_back(completion);
+            return;
+        }
+    }
+
+    handler->QueueEvent(event);
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolFuture
+// ----------------------------------------------------------------------------
+
+wxThreadPoolFuture::wxThreadPoolFuture(wxThreadPoolImpl* pool,
+                                       wxThreadPoolTask* task)
+    : m_pool(pool),
+      m_task(task)
+{
+    m_task->IncRef();
+}
+
+wxThreadPoolFuture::wxThreadPoolFuture(const wxThreadPoolFuture& other)
+    : m_pool(other.m_pool),
+      m_task(other.m_task)
+{
+    if ( m_task )
+        m_task->IncRef();
+}
+
+wxThreadPoolFuture&
+wxThreadPoolFuture::operator=(const wxThreadPoolFuture& other)
+{
+    if ( other.m_task )
+        other.m_task->IncRef();
+    if ( m_task )
+        m_task->DecRef();
+
+    m_pool = other.m_pool;
+    m_task = other.m_task;
+
+    return *this;
+}
+
+wxThreadPoolFuture::~wxThreadPoolFuture()
+{
+    if ( m_task )
+        m_task->DecRef();
+}
+
+bool wxThreadPoolFuture::IsDone() const
+{
+    wxCHECK_MSG( m_task, true, "no task" );
+
+    return m_task->IsFinished();
+}
+
+bool wxThreadPoolFuture::IsCancelled() const
+{
+    wxCHECK_MSG( m_task, false, "no task" );
+
+    wxCriticalSectionLocker lock(m_task->m_cs);
+
+    return m_task->m_state == wxThreadPoolTask::State_Cancelled;
+}
+
+bool wxThreadPoolFuture::Cancel()
+{
+    wxCHECK_MSG( m_task, false, "no task" );
+
+    if ( !m_task->CancelIfQueued() )
+        return false;
+
+    // Notify about the task completion.
+    m_task->Finish(wxThreadPoolTask::State_Cancelled);
+    m_pool->NotifyWaiters();
+
+    return true;
+}
+
+void wxThreadPoolFuture::Wait()
+{
+    wxCHECK_RET( m_task, "no task" );
+
+    m_pool->Wait(m_task, -1);
+}
+
+bool wxThreadPoolFuture::WaitTimeout(unsigned long timeoutMillis)
+{
+    wxCHECK_MSG( m_task, false, "no task" );
+
+    return m_pool->Wait(m_task, static_cast<long>(timeoutMillis));
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolImpl
+// ----------------------------------------------------------------------------
+
+wxThreadPoolImpl::wxThreadPoolImpl(int numThreads)
+    : m_queued(0),
+      m_condWork(m_mutex),
+      m_condDone(m_mutex),
+      m_sleepingWorkers(0),
+      m_waiters(0),
+      m_stop(false)
+{
+    if ( numThreads <= 0 )
+        numThreads = wxThread::GetCPUCount();
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    m_workers.reserve(numThreads);
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        WorkerThread* const worker = new WorkerThread(this, n);
+        if ( worker->Run() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to start thread pool worker thread.");
+            delete worker;
+            break;
+        }
+
+        m_workers.push_back(worker);
+    }
+}
+
+wxThreadPoolImpl::~wxThreadPoolImpl()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stop = true;
+        m_condWork.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        m_workers[n]->Wait();
+        delete m_workers[n];
+    }
+
+    // Cancel all the remaining tasks, e.g. if we couldn't create any threads
+    // or if the tasks were submitted by the other tasks while we were
+    // stopping.
+    for ( int prio = 0; prio < wxTHREAD_POOL_PRIORITY_MAX; prio++ )
+    {
+        while ( wxThreadPoolTask* const task = m_queues[prio].PopFront() )
+        {
+            if ( task->CancelIfQueued() )
+            {
+                task->Finish(wxThreadPoolTask::State_Cancelled);
+                NotifyWaiters();
+            }
+
+            task->DecRef();
+        }
+    }
+}
+
+bool wxThreadPoolImpl::IsWorkerThread() const
+{
+    WorkerThread* const worker = CurrentWorker();
+
+    return worker && worker->GetPool() == this;
+}
+
+void wxThreadPoolImpl::Submit(wxThreadPoolTask* task,
+                              wxThreadPoolPriority priority)
+{
+    // Keep the tasks submitted by the other tasks in the current thread
+    // queue, they will be processed by it unless they are stolen by the other
+    // threads which are idle.
+    WorkerThread* const worker = CurrentWorker();
+    if ( worker && worker->GetPool() == this )
+        worker->m_queues[priority].PushBack(task);
+    else
+        m_queues[priority].PushBack(task);
+
+    wxAtomicInc(m_queued);
+
+    wxMutexLocker lock(m_mutex);
+    if ( m_sleepingWorkers )
+        m_condWork.Signal();
+}
+
+wxThreadPoolTask* wxThreadPoolImpl::FindTask(WorkerThread* worker)
+{
+    const int numWorkers = static_cast<int>(m_workers.size());
+
+    for ( int prio = 0; prio < wxTHREAD_POOL_PRIORITY_MAX; prio++ )
+    {
+        wxThreadPoolTask* task = NULL;
+        if ( worker )
+            task = worker->m_queues[prio].PopBack();
+
+        if ( !task )
+            task = m_queues[prio].PopFront();
+
+        // Try to steal a task from another worker, starting with the next
+        // one to avoid all threads trying to steal from the first one.
+        const int start = worker ? worker->GetIndex() + 1 : 0;
+        for ( int n = 0; !task && n < numWorkers; n++ )
+        {
+            WorkerThread* const other = m_workers[(start + n) % numWorkers];
+            if ( other != worker )
+                task = other->m_queues[prio].PopFront();
+        }
+
+        if ( task )
+        {
+            wxAtomicDec(m_queued);
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+void wxThreadPoolImpl::Execute(wxThreadPoolTask* task)
+{
+    // The task could have been cancelled while it was in the queue.
+    if ( task->StartRunning() )
+    {
+        wxTRY
+        {
+            task->Run();
+        }
+        wxCATCH_ALL
+        (
+            if ( wxTheApp )
+                wxTheApp->OnUnhandledException();
+        )
+
+        task->Finish(wxThreadPoolTask::State_Done);
+
+        NotifyWaiters();
+    }
+
+    // Release the reference held by the queue.
+    task->DecRef();
+}
+
+void wxThreadPoolImpl::NotifyWaiters()
+{
+    wxMutexLocker lock(m_mutex);
+    if ( m_waiters )
+        m_condDone.Broadcast();
+}
+
+void wxThreadPoolImpl::WorkerMain(WorkerThread* worker)
+{
+    for ( ;; )
+    {
+        wxThreadPoolTask* const task = FindTask(worker);
+        if ( task )
+        {
+            Execute(task);
+            continue;
+        }
+
+        wxMutexLocker lock(m_mutex);
+        if ( m_stop )
+            break;
+
+        // Submit() increments m_queued before locking the mutex, so if it's
+        // still 0 now, it will find us sleeping and wake us up.
+        if ( m_queued )
+            continue;
+
+        m_sleepingWorkers++;
+        m_condWork.Wait();
+        m_sleepingWorkers--;
+    }
+
+    // Don't leave any tasks submitted to this worker unprocessed: they will
+    // be cancelled in the pool dtor.
+    for ( int prio = 0; prio < wxTHREAD_POOL_PRIORITY_MAX; prio++ )
+    {
+        while ( wxThreadPoolTask* const task = worker->m_queues[prio].PopFront() )
+            m_queues[prio].PushBack(task);
+    }
+}
+
+bool wxThreadPoolImpl::Wait(wxThreadPoolTask* task, long timeoutMillis)
+{
+    if ( task->IsFinished() )
+        return true;
+
+    wxStopWatch sw;
+
+    WorkerThread* const worker = CurrentWorker();
+    if ( worker && worker->GetPool() == this )
+    {
+        // Execute the other tasks while waiting, this is not only more
+        // efficient but also avoids deadlocks if all worker threads wait for
+        // the tasks which can't be started because there are no free threads.
+        for ( ;; )
+        {
+            if ( task->IsFinished() )
+                return true;
+
+            long remaining = -1;
+            if ( timeoutMillis >= 0 )
+            {
+                remaining = timeoutMillis - sw.Time();
+                if ( remaining <= 0 )
+                    return false;
+            }
+
+            wxThreadPoolTask* const other = FindTask(worker);
+            if ( other )
+            {
+                Execute(other);
+                continue;
+            }
+
+            // Wait for something to happen, but not for too long as we won't
+            // be notified about new tasks submitted in the meanwhile.
+            wxMutexLocker lock(m_mutex);
+            if ( task->IsFinished() )
+                return true;
+
+            m_waiters++;
+            m_condDone.WaitTimeout(remaining >= 0 && remaining < 10 ? remaining
+                                                                    : 10);
+            m_waiters--;
+        }
+    }
+
+    wxMutexLocker lock(m_mutex);
+    while ( !task->IsFinished() )
+    {
+        m_waiters++;
+        if ( timeoutMillis < 0 )
+        {
+            m_condDone.Wait();
+        }
+        else
+        {
+            const long remaining = timeoutMillis - sw.Time();
+            if ( remaining > 0 )
+                m_condDone.WaitTimeout(remaining);
+        }
+        m_waiters--;
+
+        if ( timeoutMillis >= 0 && sw.Time() >= timeoutMillis )
+            return task->IsFinished();
+    }
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPool
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxThreadPool* gs_defaultPool = NULL;
+wxCriticalSection gs_defaultPoolCS;
+
+// Task used by ParallelFor(): processes the chunks of the range until there
+// are none left.
+class ParallelForTask : public wxThreadPoolTask
+{
+public:
+    class Range
+    {
+    public:
+        Range(int begin, int end, int chunkSize, wxThreadPoolLoopBody& body)
+            : m_next(begin),
+              m_end(end),
+              m_chunkSize(chunkSize),
+              m_body(body)
+        {
+        }
+
+        // Process the chunks until there are none left.
+        void Process()
+        {
+            for ( ;; )
+            {
+                int begin;
+                {
+                    wxCriticalSectionLocker lock(m_cs);
+                    if ( m_next >= m_end )
+                        break;
+
+                    begin = m_next;
+                    m_next = m_end - begin > m_chunkSize ? begin + m_chunkSize
+                                                         : m_end;
+                }
+
+                m_body.Process(begin, wxMin(begin + m_chunkSize, m_end));
+            }
+        }
+
+    private:
+        wxCriticalSection m_cs;
+        int m_next;
+        const int m_end,
+                  m_chunkSize;
+        wxThreadPoolLoopBody& m_body;
+
+        wxDECLARE_NO_COPY_CLASS(Range);
+    };
+
+    explicit ParallelForTask(Range& range) : m_range(range) { }
+
+protected:
+    virtual void Run() wxOVERRIDE { m_range.Process(); }
+
+private:
+    Range& m_range;
+};
+
+} // anonymous namespace
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_impl(new wxThreadPoolImpl(numThreads))
+{
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    delete m_impl;
+}
+
+/* static */
+wxThreadPool& wxThreadPool::GetDefault()
+{
+    wxCriticalSectionLocker lock(gs_defaultPoolCS);
+
+    if ( !gs_defaultPool )
+        gs_defaultPool = new wxThreadPool();
+
+    return *gs_defaultPool;
+}
+
+int wxThreadPool::GetThreadCount() const
+{
+    return m_impl->GetThreadCount();
+}
+
+int wxThreadPool::GetPendingCount() const
+{
+    return m_impl->GetPendingCount();
+}
+
+bool wxThreadPool::IsWorkerThread() const
+{
+    return m_impl->IsWorkerThread();
+}
+
+wxThreadPoolFuture
+wxThreadPool::Submit(wxThreadPoolTask* task, wxThreadPoolPriority priority)
+{
+    wxCHECK_MSG( task, wxThreadPoolFuture(), "NULL task" );
+    wxCHECK_MSG( priority >= 0 && priority < wxTHREAD_POOL_PRIORITY_MAX,
+                 wxThreadPoolFuture(), "invalid priority" );
+
+    // Take the reference for the future before the task can be executed and
+    // deleted. The initial reference is owned by the queue.
+    wxThreadPoolFuture future(m_impl, task);
+
+    m_impl->Submit(task, priority);
+
+    return future;
+}
+
+void wxThreadPool::ParallelFor(int begin, int end,
+                               wxThreadPoolLoopBody& body,
+                               int chunkSize,
+                               int maxThreads)
+{
+    wxCHECK_RET( chunkSize > 0, "invalid chunk size" );
+
+    if ( begin >= end )
+        return;
+
+    const int numChunks = static_cast<int>
+        ((static_cast<wxLongLong_t>(end) - begin + chunkSize - 1) / chunkSize);
+
+    int numTasks = GetThreadCount();
+    if ( maxThreads > 0 && maxThreads - 1 < numTasks )
+        numTasks = maxThreads - 1;
+
+    // The current thread processes one chunk too.
+    if ( numTasks > numChunks - 1 )
+        numTasks = numChunks - 1;
+
+    ParallelForTask::Range range(begin, end, chunkSize, body);
+
+    wxVector<wxThreadPoolFuture> futures;
+    futures.reserve(numTasks);
+    for ( int n = 0; n < numTasks; n++ )
+    {
+        futures.push_back(Submit(new ParallelForTask(range),
+                                 wxTHREAD_POOL_PRIORITY_HIGH));
+    }
+
+    range.Process();
+
+    // All chunks are being processed now, so the tasks which haven't started
+    // yet would have nothing to do anyhow, just cancel them. We still need to
+    // wait for the ones which did start and may still be running.
+    for ( size_t n = 0; n < futures.size(); n++ )
+    {
+        if ( !futures[n].Cancel() )
+            futures[n].Wait();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule: destroys the default pool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule()
+    {
+        // The worker threads must be stopped before threads support is
+        // cleaned up.
+        AddDependency("wxThreadModule");
+    }
+
+    virtual bool OnInit() wxOVERRIDE { return true; }
+
+    virtual void OnExit() wxOVERRIDE
+    {
+        wxCriticalSectionLocker lock(gs_defaultPoolCS);
+
+        wxDELETE(gs_defaultPool);
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
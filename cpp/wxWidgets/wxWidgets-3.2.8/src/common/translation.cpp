@@ -43,8 +43,10 @@
 #include "wx/filename.h"
 #include "wx/tokenzr.h"
 #include "wx/fontmap.h"
+#include "wx/hashset.h"
 #include "wx/scopedptr.h"
 #include "wx/stdpaths.h"
+#include "wx/thread.h"
 #include "wx/version.h"
 #include "wx/private/threadinfo.h"
 #include "wx/uilocale.h"
@@ -56,6 +58,9 @@
     #include "wx/scopedarray.h"
     #include "wx/msw/wrapwin.h"
     #include "wx/msw/missing.h"
+    #include "wx/msw/private.h"
+#elif defined(__UNIX__)
+    #include <sys/mman.h>
 #endif
 
 // ----------------------------------------------------------------------------
@@ -88,6 +93,9 @@ namespace
 wxStringToStringHashMap gs_msgIdCharset;
 #endif
 
+// Set by wxTranslations::EnableMappedCatalogs().
+bool gs_mappedCatalogs = false;
+
 // ----------------------------------------------------------------------------
 // Platform specific helpers
 // ----------------------------------------------------------------------------
@@ -502,10 +510,12 @@ wxPluralFormsNode::evaluate(wxPluralFormsToken::Number n) const
 }
 
 
+class wxMsgCatalogFile;
+
 class wxPluralFormsCalculator
 {
 public:
-    wxPluralFormsCalculator() : m_nplurals(0), m_plural(0) {}
+    wxPluralFormsCalculator() : m_nplurals(0), m_plural(0), m_file(NULL) {}
 
     // input: number, returns msgstr index
     int evaluate(int n) const;
@@ -515,13 +525,24 @@ public:
     // returns 0 if error
     static wxPluralFormsCalculator* make(const char* s = 0);
 
-    ~wxPluralFormsCalculator() {}
+    ~wxPluralFormsCalculator();
 
     void  init(wxPluralFormsToken::Number nplurals, wxPluralFormsNode* plural);
 
+    // The catalogs looking up their strings directly in the catalog file,
+    // see wxTranslations::EnableMappedCatalogs(), keep the file here: it
+    // logically belongs to wxMsgCatalog, but adding a field to it would break
+    // the ABI compatibility within 3.2 branch, while each catalog already has
+    // its own calculator, which is private to this source file. This object
+    // takes ownership of the file and deletes it when the catalog is
+    // destroyed.
+    void SetCatalogFile(wxMsgCatalogFile* file);
+    wxMsgCatalogFile* GetCatalogFile() const { return m_file; }
+
 private:
     wxPluralFormsToken::Number m_nplurals;
     wxPluralFormsNodePtr m_plural;
+    wxMsgCatalogFile* m_file;
 };
 
 wxDEFINE_SCOPED_PTR(wxPluralFormsCalculator, wxPluralFormsCalculatorPtr)
@@ -886,6 +907,18 @@ wxPluralFormsCalculator* wxPluralFormsCalculator::make(const char* s)
 
 
 
+#if wxUSE_UNICODE
+
+// The translations looked up by wxMsgCatalogFile::GetString() are allocated
+// individually, as the pointers to them must remain valid when more of them
+// are added, which is not the case for the values stored in the map itself
+// when using wxUSE_FLAT_HASH_MAP.
+WX_DECLARE_STRING_HASH_MAP(wxString *, wxMsgCatalogTranslations);
+
+WX_DECLARE_HASH_SET(wxString, wxStringHash, wxStringEqual, wxMsgCatalogMisses);
+
+#endif // wxUSE_UNICODE
+
 // ----------------------------------------------------------------------------
 // wxMsgCatalogFile corresponds to one disk-file message catalog.
 //
@@ -904,15 +937,31 @@ public:
     wxMsgCatalogFile();
     ~wxMsgCatalogFile();
 
-    // load the catalog from disk
+    // load the catalog from disk, mapping it in memory instead of reading it
+    // if mapFile is true and this is supported
     bool LoadFile(const wxString& filename,
-                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
+                  wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                  bool mapFile = false);
     bool LoadData(const DataBuffer& data,
                   wxPluralFormsCalculatorPtr& rPluralFormsCalculator);
 
     // fills the hash with string-translation pairs
     bool FillHash(wxStringToStringHashMap& hash, const wxString& domain) const;
 
+#if wxUSE_UNICODE
+    // prepare for using GetString() instead of FillHash(): this only checks
+    // that the catalog tables are valid and doesn't convert any strings
+    bool InitLookup();
+
+    // get the translation directly from the catalog data, converting it on
+    // first use, or return NULL if there is no translation; the returned
+    // pointer remains valid as long as this object exists and this function
+    // is thread-safe
+    const wxString *GetString(const wxString& str,
+                              int index,
+                              const wxString& context);
+#endif // wxUSE_UNICODE
+
     // return the charset of the strings in this catalog or empty string if
     // none/unknown
     wxString GetCharset() const { return m_charset; }
@@ -975,6 +1024,44 @@ private:
 
     bool m_bSwapped;   // wrong endianness?
 
+    // map the given file in memory, return NULL on failure or if mapping is
+    // not supported
+    void *MapFile(const wxFile& file, size_t size);
+
+    // address and size of the mapped file or NULL if it's not mapped
+    void *m_mapAddr;
+    size_t m_mapSize;
+
+#if wxUSE_UNICODE
+    // find the index of the original string msgid, in the catalog encoding,
+    // using the catalog hash table or binary search if it doesn't have one
+    bool FindString(const char *msgid, size_t32 *pn) const;
+
+    // return the NUL-terminated string at the given index of the table and
+    // its length, or NULL if the string is not entirely inside the data
+    const char *StringAtOfs(const wxMsgTableEntry *pTable,
+                            size_t32 n,
+                            size_t32 *pLen) const;
+
+    // hash table used by FindString() or NULL if the catalog doesn't have it
+    const size_t32 *m_pHashTable;
+    size_t32 m_nHashSize;
+
+    // conversion from the catalog charset, used by GetString()
+    const wxMBConv *m_conv;
+    wxScopedPtr<wxMBConv> m_convOwned;
+
+    // the translations already converted by GetString(), owned by us
+    wxMsgCatalogTranslations m_translations;
+
+    // the strings which were not found by GetString(), to avoid looking them
+    // up again, this is emptied when it becomes too big
+    wxMsgCatalogMisses m_misses;
+
+    // protects m_translations and m_misses
+    wxCRIT_SECT_DECLARE_MEMBER(m_csCache);
+#endif // wxUSE_UNICODE
+
     wxDECLARE_NO_COPY_CLASS(wxMsgCatalogFile);
 };
 
@@ -983,16 +1070,69 @@ private:
 // ----------------------------------------------------------------------------
 
 wxMsgCatalogFile::wxMsgCatalogFile()
+    : m_mapAddr(NULL),
+      m_mapSize(0)
+#if wxUSE_UNICODE
+    , m_pHashTable(NULL),
+      m_nHashSize(0),
+      m_conv(NULL)
+#endif // wxUSE_UNICODE
 {
 }
 
 wxMsgCatalogFile::~wxMsgCatalogFile()
 {
+#if wxUSE_UNICODE
+    for ( wxMsgCatalogTranslations::iterator i = m_translations.begin();
+          i != m_translations.end();
+          ++i )
+    {
+        delete i->second;
+    }
+#endif // wxUSE_UNICODE
+
+    if ( m_mapAddr )
+    {
+#if defined(__WINDOWS__)
+        ::UnmapViewOfFile(m_mapAddr);
+#elif defined(__UNIX__)
+        munmap(m_mapAddr, m_mapSize);
+#endif
+    }
+}
+
+void *wxMsgCatalogFile::MapFile(const wxFile& file, size_t size)
+{
+    // empty files can't be mapped, but they're not valid catalogs anyhow
+    if ( !size )
+        return NULL;
+
+    void *addr = NULL;
+
+#if defined(__WINDOWS__) && defined(wxGetOSFHandle)
+    HANDLE hMapping = ::CreateFileMapping(wxGetOSFHandle(file.fd()), NULL,
+                                         PAGE_READONLY, 0, 0, NULL);
+    if ( hMapping )
+    {
+        // the view keeps the mapping alive, we don't need its handle any more
+        addr = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(hMapping);
+    }
+#elif defined(__UNIX__)
+    addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file.fd(), 0);
+    if ( addr == MAP_FAILED )
+        addr = NULL;
+#else
+    wxUnusedVar(file);
+#endif
+
+    return addr;
 }
 
 // open disk file and read in its contents
 bool wxMsgCatalogFile::LoadFile(const wxString& filename,
-                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator)
+                                wxPluralFormsCalculatorPtr& rPluralFormsCalculator,
+                                bool mapFile)
 {
     wxFile fileMsg(filename);
     if ( !fileMsg.IsOpened() )
@@ -1006,19 +1146,30 @@ bool wxMsgCatalogFile::LoadFile(const wxString& filename,
     size_t nSize = wx_truncate_cast(size_t, lenFile);
     wxASSERT_MSG( nSize == lenFile + size_t(0), wxS("message catalog bigger than 4GB?") );
 
-    wxMemoryBuffer filedata;
+    DataBuffer data;
 
-    // read the whole file in memory
-    if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
-        return false;
+    // the mapping remains valid after closing the file
+    void * const addr = mapFile ? MapFile(fileMsg, nSize) : NULL;
+    if ( addr )
+    {
+        m_mapAddr = addr;
+        m_mapSize = nSize;
+
+        data = DataBuffer::CreateNonOwned(static_cast<char *>(addr), nSize);
+    }
+    else // read the whole file in memory
+    {
+        wxMemoryBuffer filedata;
 
-    filedata.UngetWriteBuf(nSize);
+        if ( fileMsg.Read(filedata.GetWriteBuf(nSize), nSize) != lenFile )
+            return false;
 
-    bool ok = LoadData
-              (
-                  DataBuffer::CreateOwned((char*)filedata.release(), nSize),
-                  rPluralFormsCalculator
-              );
+        filedata.UngetWriteBuf(nSize);
+
+        data = DataBuffer::CreateOwned((char*)filedata.release(), nSize);
+    }
+
+    bool ok = LoadData(data, rPluralFormsCalculator);
     if ( !ok )
     {
         wxLogWarning(_("'%s' is not a valid message catalog."), filename);
@@ -1220,6 +1371,245 @@ bool wxMsgCatalogFile::FillHash(wxStringToStringHashMap& hash,
     return true;
 }
 
+#if wxUSE_UNICODE
+
+// the hash function used for the hash table of .mo files by GNU gettext
+static size_t32 GetMsgCatalogHash(const char *str)
+{
+    size_t32 hval = 0;
+    while ( *str )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*str++);
+
+        const size_t32 g = hval & 0xf0000000;
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+const char *wxMsgCatalogFile::StringAtOfs(const wxMsgTableEntry *pTable,
+                                          size_t32 n,
+                                          size_t32 *pLen) const
+{
+    const wxMsgTableEntry * const ent = pTable + n;
+
+    // unlike the other overload, also check that the string is terminated
+    // by NUL, as it is used directly
+    const size_t32 ofsString = Swap(ent->ofsString);
+    const size_t32 len = Swap(ent->nLen);
+    if ( ofsString >= m_data.length() || len >= m_data.length() - ofsString )
+        return NULL;
+
+    const char * const str = m_data.data() + ofsString;
+    if ( str[len] != '\0' )
+        return NULL;
+
+    *pLen = len;
+    return str;
+}
+
+bool wxMsgCatalogFile::InitLookup()
+{
+    const size_t size = m_data.length();
+    const wxMsgCatalogHeader * const
+        pHeader = reinterpret_cast<const wxMsgCatalogHeader *>(m_data.data());
+
+    // the strings themselves are only checked when they are used, but the
+    // tables must be entirely inside the data
+    if ( m_numStrings > size / sizeof(wxMsgTableEntry) )
+        return false;
+
+    const size_t sizeTable = m_numStrings * sizeof(wxMsgTableEntry);
+    if ( Swap(pHeader->ofsOrigTable) > size - sizeTable ||
+            Swap(pHeader->ofsTransTable) > size - sizeTable )
+        return false;
+
+    // GNU gettext doesn't use the hash table if it's this small neither
+    m_nHashSize = Swap(pHeader->nHashSize);
+    if ( m_nHashSize > 2 )
+    {
+        if ( m_nHashSize > size / sizeof(size_t32) )
+            return false;
+
+        const size_t32 ofsHashTable = Swap(pHeader->ofsHashTable);
+        if ( ofsHashTable > size - m_nHashSize * sizeof(size_t32) )
+            return false;
+
+        m_pHashTable = reinterpret_cast<const size_t32 *>(m_data.data() +
+                                                          ofsHashTable);
+    }
+
+    // see FillHash()
+    if ( !m_charset.empty() )
+    {
+        m_convOwned.reset(new wxCSConv(m_charset));
+        m_conv = m_convOwned.get();
+    }
+    else
+    {
+        m_conv = wxConvCurrent;
+    }
+
+    return true;
+}
+
+bool wxMsgCatalogFile::FindString(const char *msgid, size_t32 *pn) const
+{
+    size_t32 len;
+
+    if ( m_pHashTable )
+    {
+        // this is the same double hashing as used by GNU gettext
+        const size_t32 hval = GetMsgCatalogHash(msgid);
+        const size_t32 incr = 1 + hval % (m_nHashSize - 2);
+        size_t32 idx = hval % m_nHashSize;
+
+        // the table always has empty entries, but don't loop forever if it
+        // doesn't in a corrupted catalog
+        for ( size_t32 tries = 0; tries < m_nHashSize; tries++ )
+        {
+            const size_t32 nstr = Swap(m_pHashTable[idx]);
+            if ( !nstr )
+                return false;
+
+            // the strings are numbered from 1 in the hash table and the
+            // entries for plural forms contain both msgid and msgid_plural
+            // separated by NUL, so use strcmp() to compare with msgid only
+            const size_t32 n = nstr - 1;
+            if ( n < m_numStrings )
+            {
+                const char * const orig = StringAtOfs(m_pOrigTable, n, &len);
+                if ( orig && strcmp(orig, msgid) == 0 )
+                {
+                    *pn = n;
+                    return true;
+                }
+            }
+
+            if ( idx >= m_nHashSize - incr )
+                idx -= m_nHashSize - incr;
+            else
+                idx += incr;
+        }
+
+        return false;
+    }
+
+    // without the hash table, use the fact that the original strings are
+    // sorted
+    size_t32 lo = 0,
+             hi = m_numStrings;
+    while ( lo < hi )
+    {
+        const size_t32 mid = lo + (hi - lo) / 2;
+        const char * const orig = StringAtOfs(m_pOrigTable, mid, &len);
+        if ( !orig )
+            return false;
+
+        const int rc = strcmp(msgid, orig);
+        if ( rc == 0 )
+        {
+            *pn = mid;
+            return true;
+        }
+
+        if ( rc < 0 )
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+
+    return false;
+}
+
+const wxString *wxMsgCatalogFile::GetString(const wxString& str,
+                                            int index,
+                                            const wxString& context)
+{
+    // the original string in the catalog
+    wxString msgidWithContext;
+    if ( !context.empty() )
+        msgidWithContext << context << wxS('\x04') << str;
+    const wxString& msgid = context.empty() ? str : msgidWithContext;
+
+    // and the key used for the already looked up strings, which is the same
+    // one as in FillHash()
+    wxString keyWithIndex;
+    if ( index != 0 )
+        keyWithIndex << msgid << wxChar(index);
+    const wxString& key = index != 0 ? keyWithIndex : msgid;
+
+    wxCRIT_SECT_LOCKER(lock, m_csCache);
+
+    const wxMsgCatalogTranslations::const_iterator i = m_translations.find(key);
+    if ( i != m_translations.end() )
+        return i->second;
+
+    if ( m_misses.find(key) != m_misses.end() )
+        return NULL;
+
+    // This string is looked up for the first time, find it in the catalog.
+
+    // convert a copy as the conversion modifies the string internally and
+    // the result points to it, notice that it's empty if the conversion fails
+    const wxString msgidCopy(msgid);
+    const wxScopedCharBuffer buf(msgidCopy.mb_str(*m_conv));
+
+    size_t32 n,
+             len;
+    const char *data;
+    if ( (buf.length() || msgid.empty()) && FindString(buf.data(), &n) &&
+            (data = StringAtOfs(m_pTransTable, n, &len)) != NULL )
+    {
+        // skip the translations for the preceding plural forms
+        size_t offset = 0;
+        for ( int form = 0; form < index && offset < len; form++ )
+            offset += strlen(data + offset) + 1;
+
+        if ( offset < len )
+        {
+            const wxString msgstr(data + offset, *m_conv);
+            if ( !msgstr.empty() )
+            {
+                wxString * const trans = new wxString(msgstr);
+                m_translations[key] = trans;
+                return trans;
+            }
+        }
+    }
+
+    // Remember a limited number of the strings without translation, as
+    // they are typically looked up again when searching in all catalogs, but
+    // don't let the set grow without bounds if many different strings are
+    // used, e.g. when they're generated dynamically.
+    static const size_t MAX_MISSES = 4096;
+    if ( m_misses.size() >= MAX_MISSES )
+        m_misses.clear();
+
+    m_misses.insert(key);
+
+    return NULL;
+}
+
+#endif // wxUSE_UNICODE
+
+wxPluralFormsCalculator::~wxPluralFormsCalculator()
+{
+    delete m_file;
+}
+
+void wxPluralFormsCalculator::SetCatalogFile(wxMsgCatalogFile* file)
+{
+    delete m_file;
+    m_file = file;
+}
+
 
 // ----------------------------------------------------------------------------
 // wxMsgCatalog class
@@ -1242,12 +1632,49 @@ wxMsgCatalog::~wxMsgCatalog()
 }
 #endif // !wxUSE_UNICODE
 
+#if wxUSE_UNICODE
+
+// Make the catalog look up the strings directly in the already loaded file.
+static bool
+UseCatalogFile(wxPluralFormsCalculatorPtr& calculator,
+               wxScopedPtr<wxMsgCatalogFile>& file)
+{
+    if ( !file->InitLookup() )
+        return false;
+
+    // the file is stored in the calculator, so create one even if the
+    // catalog doesn't have any header
+    if ( !calculator.get() )
+        calculator.reset(wxPluralFormsCalculator::make());
+
+    calculator->SetCatalogFile(file.release());
+
+    return true;
+}
+
+#endif // wxUSE_UNICODE
+
 /* static */
 wxMsgCatalog *wxMsgCatalog::CreateFromFile(const wxString& filename,
                                            const wxString& domain)
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
+#if wxUSE_UNICODE
+    if ( gs_mappedCatalogs )
+    {
+        wxScopedPtr<wxMsgCatalogFile> mapped(new wxMsgCatalogFile);
+
+        if ( !mapped->LoadFile(filename, cat->m_pluralFormsCalculator, true) )
+            return NULL;
+
+        if ( !UseCatalogFile(cat->m_pluralFormsCalculator, mapped) )
+            return NULL;
+
+        return cat.release();
+    }
+#endif // wxUSE_UNICODE
+
     wxMsgCatalogFile file;
 
     if ( !file.LoadFile(filename, cat->m_pluralFormsCalculator) )
@@ -1265,6 +1692,26 @@ wxMsgCatalog *wxMsgCatalog::CreateFromData(const wxScopedCharBuffer& data,
 {
     wxScopedPtr<wxMsgCatalog> cat(new wxMsgCatalog(domain));
 
+#if wxUSE_UNICODE
+    if ( gs_mappedCatalogs )
+    {
+        // non-owned data is only guaranteed to remain valid during this call,
+        // so this makes a copy of it, which is still much cheaper than
+        // converting all the strings, but just shares the owned data
+        const wxCharBuffer copy(data);
+
+        wxScopedPtr<wxMsgCatalogFile> direct(new wxMsgCatalogFile);
+
+        if ( !direct->LoadData(copy, cat->m_pluralFormsCalculator) )
+            return NULL;
+
+        if ( !UseCatalogFile(cat->m_pluralFormsCalculator, direct) )
+            return NULL;
+
+        return cat.release();
+    }
+#endif // wxUSE_UNICODE
+
     wxMsgCatalogFile file;
 
     if ( !file.LoadData(data, cat->m_pluralFormsCalculator) )
@@ -1283,6 +1730,18 @@ const wxString *wxMsgCatalog::GetString(const wxString& str, unsigned n, const w
     {
         index = m_pluralFormsCalculator->evaluate(n);
     }
+
+#if wxUSE_UNICODE
+    // The file is owned by the calculator only to preserve ABI, see its
+    // SetCatalogFile(), and m_messages is not used for such catalogs.
+    if ( m_pluralFormsCalculator.get() )
+    {
+        wxMsgCatalogFile * const file = m_pluralFormsCalculator->GetCatalogFile();
+        if ( file )
+            return file->GetString(str, index, context);
+    }
+#endif // wxUSE_UNICODE
+
     wxStringToStringHashMap::const_iterator i;
     if (index != 0)
     {
@@ -1345,6 +1804,18 @@ void wxTranslations::SetNonOwned(wxTranslations *t)
     gs_translationsOwned = false;
 }
 
+/*static*/
+void wxTranslations::EnableMappedCatalogs(bool enable)
+{
+    gs_mappedCatalogs = enable;
+}
+
+/*static*/
+bool wxTranslations::AreMappedCatalogsEnabled()
+{
+    return gs_mappedCatalogs;
+}
+
 
 wxTranslations::wxTranslations()
 {
@@ -96,6 +96,7 @@ wxFLAGS_MEMBER(wxTR_LINES_AT_ROOT)
 wxFLAGS_MEMBER(wxTR_HIDE_ROOT)
 wxFLAGS_MEMBER(wxTR_ROW_LINES)
 wxFLAGS_MEMBER(wxTR_HAS_VARIABLE_ROW_HEIGHT)
+wxFLAGS_MEMBER(wxTR_UNIFORM_ROW_HEIGHT)
 wxFLAGS_MEMBER(wxTR_SINGLE)
 wxFLAGS_MEMBER(wxTR_MULTIPLE)
 #if WXWIN_COMPATIBILITY_2_8
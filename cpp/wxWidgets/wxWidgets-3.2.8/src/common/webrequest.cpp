@@ -13,6 +13,7 @@
 #if wxUSE_WEBREQUEST
 
 #include "wx/webrequest.h"
+#include "wx/arrstr.h"
 #include "wx/mstream.h"
 #include "wx/module.h"
 #include "wx/uri.h"
@@ -23,6 +24,7 @@
 
 #ifndef WX_PRECOMP
     #include "wx/app.h"
+    #include "wx/log.h"
     #include "wx/translation.h"
     #include "wx/utils.h"
 #endif
@@ -70,6 +72,7 @@ wxWebRequestImpl::wxWebRequestImpl(wxWebSession& session,
       m_id(id),
       m_state(wxWebRequest::State_Idle),
       m_bytesReceived(0),
+      m_cacheRevalidating(false),
       m_cancelled(false)
 {
 }
@@ -92,6 +95,9 @@ void wxWebRequestImpl::Cancel()
 void wxWebRequestImpl::SetFinalStateFromStatus()
 {
     const wxWebResponseImplPtr& resp = GetResponse();
+    if ( resp )
+        resp->FinalizeCache();
+
     if ( !resp || resp->GetStatus() >= 400 )
     {
         wxString err;
@@ -103,6 +109,10 @@ void wxWebRequestImpl::SetFinalStateFromStatus()
 
         SetState(wxWebRequest::State_Failed, err);
     }
+    else if ( !resp->GetStorageError().empty() )
+    {
+        SetState(wxWebRequest::State_Failed, resp->GetStorageError());
+    }
     else
     {
         SetState(wxWebRequest::State_Completed);
@@ -149,6 +159,12 @@ wxWebRequestImpl::SetData(wxScopedPtr<wxInputStream>& dataStream,
     return true;
 }
 
+void wxWebRequestImpl::SetStorageStream(wxScopedPtr<wxOutputStream>& stream)
+{
+    m_storageStream.reset(stream.release());
+    m_storage = wxWebRequest::Storage_Stream;
+}
+
 wxFileOffset wxWebRequestImpl::GetBytesReceived() const
 {
     return m_bytesReceived;
@@ -207,8 +223,131 @@ wxString StateName(wxWebRequest::State state)
 
 #endif // wxUSE_LOG_TRACE
 
+// Cache entries consist of two files in the cache directory using the same
+// name, derived from the request URL, and different extensions: the one with
+// the response data and the text one with the URL itself, to check for hash
+// collisions, and the values of the response validation headers.
+const wxStringCharType* const CACHE_DATA_EXT = wxS(".dat");
+const wxStringCharType* const CACHE_HEADERS_EXT = wxS(".hdr");
+
+// Returns the path of the cache entry for the given URL without extension.
+wxString GetCacheEntryPath(const wxString& dir, const wxString& url)
+{
+    // Use 64-bit FNV-1a hash of the URL as the file name.
+    wxUint64 hash = wxULL(0xcbf29ce484222325);
+
+    const wxScopedCharBuffer utf8 = url.utf8_str();
+    for ( const char* p = utf8.data(); *p; ++p )
+    {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= wxULL(0x100000001b3);
+    }
+
+    wxFileName fn;
+    fn.AssignDir(dir);
+    fn.SetName(wxString::Format("%016" wxLongLongFmtSpec "x", hash));
+
+    return fn.GetFullPath();
+}
+
+bool
+ReadCacheEntryHeaders(const wxString& path,
+                      const wxString& url,
+                      wxString& etag,
+                      wxString& lastModified)
+{
+    wxFFile file;
+    if ( !wxFileExists(path + CACHE_HEADERS_EXT) ||
+            !wxFileExists(path + CACHE_DATA_EXT) ||
+                !file.Open(path + CACHE_HEADERS_EXT) )
+        return false;
+
+    wxString contents;
+    if ( !file.ReadAll(&contents, wxConvUTF8) )
+        return false;
+
+    const wxArrayString lines = wxSplit(contents, '\n', '\0');
+    if ( lines.size() < 3 || lines[0] != url )
+        return false;
+
+    etag = lines[1];
+    lastModified = lines[2];
+
+    return !etag.empty() || !lastModified.empty();
+}
+
+bool
+WriteCacheEntryHeaders(const wxString& path,
+                       const wxString& url,
+                       const wxString& etag,
+                       const wxString& lastModified)
+{
+    wxFFile file(path + CACHE_HEADERS_EXT, "w");
+
+    return file.IsOpened() &&
+            file.Write(url + '\n' + etag + '\n' + lastModified + '\n',
+                       wxConvUTF8) &&
+                file.Close();
+}
+
+void RemoveCacheEntry(const wxString& path)
+{
+    if ( wxFileExists(path + CACHE_HEADERS_EXT) )
+        wxRemoveFile(path + CACHE_HEADERS_EXT);
+    if ( wxFileExists(path + CACHE_DATA_EXT) )
+        wxRemoveFile(path + CACHE_DATA_EXT);
+}
+
 } // anonymous namespace
 
+void wxWebRequestImpl::PrepareCache()
+{
+    m_cachePath.clear();
+    m_cacheRevalidating = false;
+
+    const wxString& dir = m_session.GetCacheDir();
+    if ( dir.empty() || m_url.empty() )
+        return;
+
+    // Only plain GET requests are cached.
+    if ( m_dataStream || (!m_method.empty() && m_method.CmpNoCase("GET") != 0) )
+        return;
+
+    // And we don't interfere with the application own use of conditional or
+    // partial requests.
+    for ( wxWebRequestHeaderMap::const_iterator it = m_headers.begin();
+          it != m_headers.end();
+          ++it )
+    {
+        const wxString& name = it->first;
+        if ( name.CmpNoCase("If-None-Match") == 0 ||
+                name.CmpNoCase("If-Modified-Since") == 0 ||
+                    name.CmpNoCase("Range") == 0 )
+            return;
+    }
+
+    if ( !wxDirExists(dir) &&
+            !wxFileName::Mkdir(dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL) )
+        return;
+
+    m_cachePath = GetCacheEntryPath(dir, m_url);
+
+    wxString etag,
+             lastModified;
+    if ( ReadCacheEntryHeaders(m_cachePath, m_url, etag, lastModified) )
+    {
+        wxLogTrace(wxTRACE_WEBREQUEST, "Request %p: revalidating cached %s",
+                   this, m_url);
+
+        if ( !etag.empty() )
+            SetHeader("If-None-Match", etag);
+        if ( !lastModified.empty() )
+            SetHeader("If-Modified-Since", lastModified);
+
+        m_cacheRevalidating = true;
+    }
+}
+
 void wxWebRequestImpl::SetState(wxWebRequest::State state, const wxString & failMsg)
 {
     wxCHECK_RET( state != m_state, "shouldn't switch to the same state" );
@@ -379,6 +518,10 @@ void wxWebRequestImpl::ProcessStateEvent(wxWebRequest::State state, const wxStri
             if ( response )
                 response->Finalize();
 
+            // Close the stream before notifying the application, which may
+            // want to use the data written to it.
+            m_storageStream.reset();
+
             release = true;
             break;
     }
@@ -471,6 +614,18 @@ wxWebRequest::Storage wxWebRequest::GetStorage() const
     return m_impl->GetStorage();
 }
 
+void wxWebRequest::SetStorageStream(wxOutputStream* stream)
+{
+    // Ensure that the stream is destroyed even we return below.
+    wxScopedPtr<wxOutputStream> streamPtr(stream);
+
+    wxCHECK_IMPL_VOID();
+
+    wxCHECK_RET( stream, "storage stream can't be null" );
+
+    m_impl->SetStorageStream(streamPtr);
+}
+
 void wxWebRequest::Start()
 {
     wxCHECK_IMPL_VOID();
@@ -478,6 +633,12 @@ void wxWebRequest::Start()
     wxCHECK_RET( m_impl->GetState() == wxWebRequest::State_Idle,
                  "Completed requests can not be restarted" );
 
+    wxCHECK_RET( m_impl->GetStorage() != Storage_Stream ||
+                    m_impl->GetStorageStream(),
+                 "SetStorageStream() must be used for Storage_Stream" );
+
+    m_impl->PrepareCache();
+
     m_impl->Start();
 }
 
@@ -621,7 +782,9 @@ wxWebAuthChallenge::SetCredentials(const wxWebCredentials& cred)
 
 wxWebResponseImpl::wxWebResponseImpl(wxWebRequestImpl& request) :
     m_request(request),
-    m_readSize(wxWEBREQUEST_BUFFER_SIZE)
+    m_readSize(wxWEBREQUEST_BUFFER_SIZE),
+    m_cacheSize(0),
+    m_cacheChecked(false)
 {
 }
 
@@ -629,6 +792,12 @@ wxWebResponseImpl::~wxWebResponseImpl()
 {
     if ( wxFileExists(m_file.GetName()) )
         wxRemoveFile(m_file.GetName());
+
+    if ( m_cacheFile.IsOpened() )
+    {
+        m_cacheFile.Close();
+        wxRemoveFile(m_cacheFile.GetName());
+    }
 }
 
 void wxWebResponseImpl::Init()
@@ -674,6 +843,7 @@ wxInputStream * wxWebResponseImpl::GetStream() const
                 m_stream->SeekI(0);
                 break;
             case wxWebRequest::Storage_None:
+            case wxWebRequest::Storage_Stream:
                 // No stream available
                 break;
         }
@@ -735,11 +905,61 @@ void wxWebResponseImpl::PreAllocBuffer(size_t sizeNeeded)
     m_readBuffer.SetBufSize(sizeNeeded);
 }
 
-void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
+bool wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
 {
     m_readBuffer.UngetAppendBuf(sizeReceived);
     m_request.ReportDataReceived(sizeReceived);
 
+    // Just drop the rest of the data if we couldn't store it already.
+    if ( !m_storageError.empty() )
+    {
+        m_readBuffer.Clear();
+        return false;
+    }
+
+    if ( !m_cacheChecked )
+    {
+        m_cacheChecked = true;
+
+        // Only cache successful responses which can be revalidated later.
+        const wxString& cachePath = m_request.GetCachePath();
+        if ( !cachePath.empty() &&
+                GetStatus() == 200 &&
+                    (!GetHeader("ETag").empty() ||
+                        !GetHeader("Last-Modified").empty()) &&
+                            !GetHeader("Cache-Control").Contains("no-store") )
+        {
+            wxLogNull noLog;
+            wxFileName::CreateTempFileName(cachePath, &m_cacheFile);
+        }
+    }
+
+    if ( m_cacheFile.IsOpened() )
+    {
+        WriteToCache(static_cast<const char*>(m_readBuffer.GetData())
+                        + m_readBuffer.GetDataLen() - sizeReceived,
+                     sizeReceived);
+    }
+
+    return StoreData();
+}
+
+void wxWebResponseImpl::WriteToCache(const void* data, size_t size)
+{
+    if ( m_cacheFile.Write(data, size) == size )
+    {
+        m_cacheSize += size;
+        return;
+    }
+
+    // Don't bother with the cache any more if we couldn't write to it, this
+    // is not an error for the request itself.
+    m_cacheFile.Close();
+    wxRemoveFile(m_cacheFile.GetName());
+}
+
+bool wxWebResponseImpl::StoreData()
+{
     switch ( m_request.GetStorage() )
     {
         case wxWebRequest::Storage_Memory:
@@ -751,6 +971,21 @@ void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
             m_readBuffer.Clear();
             break;
 
+        case wxWebRequest::Storage_Stream:
+            // Note that the stream is only written to from the thread
+            // receiving the data and is never accessed concurrently.
+            if ( !m_request.GetStorageStream()->WriteAll
+                    (
+                        m_readBuffer.GetData(),
+                        m_readBuffer.GetDataLen()
+                    ) )
+            {
+                m_storageError = _("Failed to write the response data.");
+            }
+
+            m_readBuffer.Clear();
+            break;
+
         case wxWebRequest::Storage_None:
             m_request.IncRef();
             const wxWebRequestImplPtr request(&m_request);
@@ -776,6 +1011,82 @@ void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
             m_readBuffer = wxMemoryBuffer();
             break;
     }
+
+    return m_storageError.empty();
+}
+
+void wxWebResponseImpl::FinalizeCache()
+{
+    const wxString& cachePath = m_request.GetCachePath();
+    if ( cachePath.empty() )
+        return;
+
+    switch ( GetStatus() )
+    {
+        case 200:
+            if ( m_cacheFile.IsOpened() )
+            {
+                const wxString tempPath = m_cacheFile.GetName();
+                const wxFileOffset len = GetContentLength();
+
+                // Don't cache incomplete responses.
+                if ( m_cacheFile.Close() &&
+                        m_storageError.empty() &&
+                            (len == -1 || len == m_cacheSize) )
+                {
+                    RemoveCacheEntry(cachePath);
+
+                    if ( wxRenameFile(tempPath, cachePath + CACHE_DATA_EXT) &&
+                            WriteCacheEntryHeaders(cachePath,
+                                                   m_request.GetURL(),
+                                                   GetHeader("ETag"),
+                                                   GetHeader("Last-Modified")) )
+                    {
+                        wxLogTrace(wxTRACE_WEBREQUEST,
+                                   "Request %p: cached response in %s",
+                                   &m_request, cachePath);
+                        break;
+                    }
+                }
+
+                if ( wxFileExists(tempPath) )
+                    wxRemoveFile(tempPath);
+            }
+
+            // The old cache entry, if any, is outdated now.
+            RemoveCacheEntry(cachePath);
+            break;
+
+        case 304:
+            if ( m_request.IsRevalidatingCache() )
+            {
+                wxLogTrace(wxTRACE_WEBREQUEST,
+                           "Request %p: using cached response from %s",
+                           &m_request, cachePath);
+
+                // Use the cached data as if it were received from the server.
+                wxFFile file(cachePath + CACHE_DATA_EXT, "rb");
+                if ( !file.IsOpened() )
+                {
+                    m_storageError = _("Failed to read the cached response data.");
+                    break;
+                }
+
+                for ( ;; )
+                {
+                    const size_t
+                        sizeRead = file.Read(GetDataBuffer(m_readSize), m_readSize);
+                    m_readBuffer.UngetAppendBuf(sizeRead);
+
+                    if ( !sizeRead || !StoreData() )
+                        break;
+                }
+
+                if ( file.Error() )
+                    m_storageError = _("Failed to read the cached response data.");
+            }
+            break;
+    }
 }
 
 wxString wxWebResponseImpl::GetDataFile() const
@@ -787,6 +1098,13 @@ void wxWebResponseImpl::Finalize()
 {
     if ( m_request.GetStorage() == wxWebRequest::Storage_File )
         m_file.Close();
+
+    // Get rid of the incomplete cache entry if the request didn't succeed.
+    if ( m_cacheFile.IsOpened() )
+    {
+        m_cacheFile.Close();
+        wxRemoveFile(m_cacheFile.GetName());
+    }
 }
 
 //
@@ -1033,7 +1351,11 @@ wxWebSession::CreateRequest(wxEvtHandler* handler, const wxString& url, int id)
 {
     wxCHECK_IMPL( wxWebRequest() );
 
-    return wxWebRequest(m_impl->CreateRequest(*this, handler, url, id));
+    const wxWebRequestImplPtr impl = m_impl->CreateRequest(*this, handler, url, id);
+    if ( impl )
+        impl->SetURL(url);
+
+    return wxWebRequest(impl);
 }
 
 wxVersionInfo wxWebSession::GetLibraryVersionInfo()
@@ -1064,6 +1386,20 @@ wxString wxWebSession::GetTempDir() const
     return m_impl->GetTempDir();
 }
 
+void wxWebSession::SetCacheDir(const wxString& dir)
+{
+    wxCHECK_IMPL_VOID();
+
+    m_impl->SetCacheDir(dir);
+}
+
+wxString wxWebSession::GetCacheDir() const
+{
+    wxCHECK_IMPL( wxString() );
+
+    return m_impl->GetCacheDir();
+}
+
 bool wxWebSession::IsOpened() const
 {
     return m_impl.get() != NULL;
@@ -127,8 +127,10 @@ size_t wxWebResponseCURL::CURLOnWrite(void* buffer, size_t size)
 {
     void* buf = GetDataBuffer(size);
     memcpy(buf, buffer, size);
-    ReportDataReceived(size);
-    return size;
+
+    // Returning a different value from the size of the data aborts the
+    // transfer, which is what we want to happen if we couldn't store it.
+    return ReportDataReceived(size) ? size : 0;
 }
 
 size_t wxWebResponseCURL::CURLOnHeader(const char * buffer, size_t size)
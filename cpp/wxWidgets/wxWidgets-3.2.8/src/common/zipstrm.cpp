@@ -21,6 +21,7 @@
     #include "wx/utils.h"
 #endif
 
+#include "wx/atomic.h"
 #include "wx/datstrm.h"
 #include "wx/zstream.h"
 #include "wx/mstream.h"
@@ -28,6 +29,10 @@
 #include "wx/wfstream.h"
 #include "zlib.h"
 
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif
+
 // value for the 'version needed to extract' field (20 means 2.0)
 enum {
     VERSION_NEEDED_TO_EXTRACT = 20,
@@ -322,7 +327,12 @@ class wxStoredOutputStream : public wxFilterOutputStream
 {
 public:
     wxStoredOutputStream(wxOutputStream& stream) :
-        wxFilterOutputStream(stream), m_pos(0) { }
+        wxFilterOutputStream(stream), m_pos(0)
+    {
+#if wxUSE_THREADS
+        m_parallel = NULL;
+#endif
+    }
 
     bool Close() wxOVERRIDE {
         m_pos = 0;
@@ -330,12 +340,25 @@ public:
         return true;
     }
 
+#if wxUSE_THREADS
+    // The object used for parallel compression by wxZipOutputStream owning
+    // this one, if any. It is stored here rather than in wxZipOutputStream
+    // itself only to preserve the layout of the latter.
+    class wxZipParallelOutputStream *GetParallel() const { return m_parallel; }
+    void SetParallel(wxZipParallelOutputStream *parallel) { m_parallel = parallel; }
+#endif
+
 protected:
     virtual size_t OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
     virtual wxFileOffset OnSysTell() const wxOVERRIDE { return m_pos; }
 
 private:
     wxFileOffset m_pos;
+
+#if wxUSE_THREADS
+    wxZipParallelOutputStream *m_parallel;
+#endif
+
     wxDECLARE_NO_COPY_CLASS(wxStoredOutputStream);
 };
 
@@ -547,13 +570,19 @@ class wxZlibOutputStream2 : public wxZlibOutputStream
 {
 public:
     wxZlibOutputStream2(wxOutputStream& stream, int level) :
-        wxZlibOutputStream(stream, level, wxZLIB_NO_HEADER) { }
+        wxZlibOutputStream(stream, level, wxZLIB_NO_HEADER), m_level(level) { }
 
-    bool Open(wxOutputStream& stream);
+    bool Open(wxOutputStream& stream, int level);
     bool Close() wxOVERRIDE { DoFlush(true); m_pos = wxInvalidOffset; return IsOk(); }
+
+private:
+    int m_level;
 };
 
-bool wxZlibOutputStream2::Open(wxOutputStream& stream)
+// Reuses the existing deflate state for the next entry, this is much cheaper
+// than creating a new one.
+//
+bool wxZlibOutputStream2::Open(wxOutputStream& stream, int level)
 {
     wxCHECK(m_pos == wxInvalidOffset, false);
 
@@ -569,6 +598,16 @@ bool wxZlibOutputStream2::Open(wxOutputStream& stream)
         return false;
     }
 
+    // Z_DEFAULT_COMPRESSION is -1, so the level can be passed to zlib as is
+    if (level != m_level) {
+        if (deflateParams(m_deflate, level, Z_DEFAULT_STRATEGY) != Z_OK) {
+            wxLogError(_("can't re-initialize zlib deflate stream"));
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+            return false;
+        }
+        m_level = level;
+    }
+
     return true;
 }
 
@@ -2160,195 +2199,1465 @@ size_t wxZipInputStream::OnSysRead(void *buffer, size_t size)
     return count;
 }
 
+#if wxABI_VERSION >= 30209
+
 /////////////////////////////////////////////////////////////////////////////
-// Output stream
+// wxZipIndexData
+//
+// The shared data of wxZipIndex: the fields of the central directory records
+// needed to open the entries, with the names stored in a single buffer and a
+// hash table of the indices of the entries for looking them up by name.
 
-#include "wx/listimpl.cpp"
-WX_DEFINE_LIST(wxZipEntryList_)
+class wxZipIndexData
+{
+public:
+    wxZipIndexData(wxMBConv& conv) : m_conv(conv), m_refCount(1) { }
 
-wxZipOutputStream::wxZipOutputStream(wxOutputStream& stream,
-                                     int level      /*=-1*/,
-                                     wxMBConv& conv /*=wxConvUTF8*/)
-  : wxArchiveOutputStream(stream, conv)
+    void IncRef() { wxAtomicInc(m_refCount); }
+    void DecRef() { if (wxAtomicDec(m_refCount) == 0) delete this; }
+
+    bool Load(wxInputStream& stream);
+
+    size_t GetCount() const { return m_entries.size(); }
+    const wxString& GetComment() const { return m_comment; }
+
+    int Find(const wxString& name) const;
+
+    wxString GetName(size_t n) const;
+    bool IsDir(size_t n) const;
+    wxFileOffset GetSize(size_t n) const { return m_entries[n].m_size; }
+    wxDateTime GetDateTime(size_t n) const;
+
+    wxZipEntry *GetEntry(size_t n) const;
+    wxZipInputStream *OpenEntry(wxInputStream *stream, size_t n) const;
+
+    wxString m_filename;
+
+private:
+    struct Entry
+    {
+        wxUint64 m_offset;
+        wxUint64 m_compressedSize;
+        wxUint64 m_size;
+        wxUint32 m_crc;
+        wxUint32 m_dosTime;
+        wxUint32 m_externalAttributes;
+        wxUint32 m_nameOffset;
+        wxUint16 m_nameLen;
+        wxUint16 m_versionNeeded;
+        wxUint16 m_flags;
+        wxUint16 m_method;
+        wxUint16 m_internalAttributes;
+        wxUint8 m_systemMadeBy;
+        wxUint8 m_versionMadeBy;
+    };
+
+    ~wxZipIndexData() { }
+
+    bool AddEntry(const char *record, wxFileOffset offsetAdjustment);
+    bool AddName(Entry& entry, const char *name, size_t len);
+    void BuildTable();
+
+    const char *GetNameData(const Entry& entry) const
+        { return static_cast<const char*>(m_names.GetData()) + entry.m_nameOffset; }
+
+    static wxUint32 Hash(const char *name, size_t len);
+
+    wxMBConv& m_conv;
+    wxAtomicInt m_refCount;
+
+    wxVector<Entry> m_entries;
+
+    // The names of all entries in UTF-8, in wxPATH_UNIX format.
+    wxMemoryBuffer m_names;
+
+    // Open addressing hash table containing the indices of the entries plus
+    // one, 0 is used for the empty slots.
+    wxVector<wxUint32> m_table;
+
+    wxString m_comment;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipIndexData);
+};
+
+bool wxZipIndexData::Load(wxInputStream& stream)
 {
-    Init(level);
+    wxFileOffset start, offsetAdjustment;
+
+    {
+        // Reuse the code finding the central directory, including for the
+        // zips appended to a self extractor.
+        wxZipInputStream zip(stream, m_conv);
+        if (!zip.LoadEndRecord() || !zip.m_parentSeekable)
+            return false;
+
+        start = zip.m_position;
+        offsetAdjustment = zip.m_offsetAdjustment;
+        m_comment = zip.m_Comment;
+        m_entries.reserve(zip.m_TotalEntries);
+    }
+
+    if (QuietSeek(stream, start) == wxInvalidOffset)
+        return false;
+
+    // Read everything from the start of the central directory in one go,
+    // this is much faster than reading each record from the stream, and
+    // the end records following it are small.
+    wxMemoryBuffer cd;
+    const wxFileOffset length = stream.GetLength();
+    size_t bufSize = length > start ? size_t(length - start) : 0x10000;
+    for (;;) {
+        void *buf = cd.GetAppendBuf(bufSize);
+        const size_t count = stream.Read(buf, bufSize).LastRead();
+        cd.UngetAppendBuf(count);
+        if (count < bufSize || !stream.IsOk())
+            break;
+        bufSize = 0x10000;
+    }
+
+    const char *p = static_cast<const char*>(cd.GetData());
+    const char *end = p + cd.GetDataLen();
+
+    while (end - p >= CENTRAL_SIZE && CrackUint32(p) == CENTRAL_MAGIC) {
+        size_t size = CENTRAL_SIZE + CrackUint16(p + 28)
+                                   + CrackUint16(p + 30)
+                                   + CrackUint16(p + 32);
+        if (size_t(end - p) < size) {
+            wxLogError(_("error reading zip central directory"));
+            return false;
+        }
+
+        if (!AddEntry(p, offsetAdjustment))
+            return false;
+
+        p += size;
+    }
+
+    BuildTable();
+    return true;
 }
 
-wxZipOutputStream::wxZipOutputStream(wxOutputStream *stream,
-                                     int level      /*=-1*/,
-                                     wxMBConv& conv /*=wxConvUTF8*/)
-  : wxArchiveOutputStream(stream, conv)
+// Parse the central directory record in the same way as
+// wxZipEntry::ReadCentral() does.
+//
+bool wxZipIndexData::AddEntry(const char *record, wxFileOffset offsetAdjustment)
+{
+    Entry entry;
+
+    entry.m_versionMadeBy = record[4];
+    entry.m_systemMadeBy = record[5];
+    entry.m_versionNeeded = CrackUint16(record + 6);
+    entry.m_flags = CrackUint16(record + 8);
+    entry.m_method = CrackUint16(record + 10);
+    entry.m_dosTime = CrackUint32(record + 12);
+    entry.m_crc = CrackUint32(record + 16);
+    entry.m_compressedSize = CrackUint32(record + 20);
+    entry.m_size = CrackUint32(record + 24);
+    entry.m_internalAttributes = CrackUint16(record + 36);
+    entry.m_externalAttributes = CrackUint32(record + 38);
+    entry.m_offset = CrackUint32(record + 42);
+
+    const wxUint16 nameLen = CrackUint16(record + 28);
+    const wxUint16 extraLen = CrackUint16(record + 30);
+    const char *name = record + CENTRAL_SIZE;
+    const char *extra = name + nameLen;
+
+    // Use the ZIP64 extra field if any, see wxZipEntry::LoadExtraInfo().
+    for (const char *p = extra; p + 4 <= extra + extraLen; ) {
+        wxUint16 fieldLen = CrackUint16(p + 2);
+        if (CrackUint16(p) == 1) {
+            if (p + 4 + fieldLen > extra + extraLen)
+                break;
+
+            const char *field = p + 4;
+            const char *fieldEnd = field + wxMin(fieldLen, 28);
+            if (entry.m_size == 0xffffffff && field + 8 <= fieldEnd) {
+                entry.m_size = CrackUint64(field);
+                field += 8;
+            }
+            if (entry.m_compressedSize == 0xffffffff && field + 8 <= fieldEnd) {
+                entry.m_compressedSize = CrackUint64(field);
+                field += 8;
+            }
+            if (entry.m_offset == 0xffffffff && field + 8 <= fieldEnd)
+                entry.m_offset = CrackUint64(field);
+            break;
+        }
+
+        p += fieldLen + 4;
+    }
+
+    if (offsetAdjustment) {
+        // See the comment in wxZipInputStream::ReadCentral().
+        wxUint64 ofs = wxUint32(entry.m_offset) + wxUint64(offsetAdjustment);
+        if (ofs > wxUINT32_MAX) {
+            wxLogError(_("error reading zip central directory"));
+            return false;
+        }
+        entry.m_offset = ofs;
+    }
+
+    if (!AddName(entry, name, nameLen))
+        return false;
+
+    m_entries.push_back(entry);
+    return true;
+}
+
+// Store the name of the entry in the same format as wxZipEntry::GetName()
+// returns it for wxPATH_UNIX, i.e. as the internal name, see GetInternalName(),
+// followed by a slash for the directories.
+//
+bool wxZipIndexData::AddName(Entry& entry, const char *name, size_t len)
 {
-    Init(level);
+    bool ascii = true;
+    for (size_t i = 0; i < len && ascii; i++)
+        ascii = (name[i] & 0x80) == 0;
+
+    // The names are almost always ASCII, so avoid the conversions for them,
+    // and also if they're already in UTF-8.
+    wxCharBuffer utf8;
+    if (!ascii && !(entry.m_flags & wxZIP_LANG_ENC_UTF8) && !m_conv.IsUTF8()) {
+#if wxUSE_UNICODE
+        utf8 = wxString(name, m_conv, len).utf8_str();
+#else
+        utf8 = wxString(name, len).utf8_str();
+#endif
+        name = utf8.data();
+        len = utf8.length();
+    }
+
+    const char *end = name + len;
+
+    const bool isDir = name != end && (end[-1] == '/' || end[-1] == '\\');
+    if (isDir)
+        end--;
+
+    while (name != end && (*name == '/' || *name == '\\'))
+        name++;
+    while (end - name >= 2 && name[0] == '.' && (name[1] == '/' || name[1] == '\\'))
+        name += 2;
+    if ((end - name == 1 && name[0] == '.') ||
+            (end - name == 2 && name[0] == '.' && name[1] == '.'))
+        name = end;
+
+    const size_t offset = m_names.GetDataLen();
+    if (offset > wxUINT32_MAX - 0x10000) {
+        wxLogError(_("error reading zip central directory"));
+        return false;
+    }
+
+    entry.m_nameOffset = static_cast<wxUint32>(offset);
+    entry.m_nameLen = static_cast<wxUint16>(end - name);
+    m_names.AppendData(name, end - name);
+
+    // wxZipEntry::SetName() uses the trailing separator to set the
+    // directory attribute, do the same.
+    entry.m_externalAttributes &= ~wxZIP_A_SUBDIR;
+    if (isDir) {
+        entry.m_externalAttributes |= wxZIP_A_SUBDIR;
+        if (entry.m_nameLen) {
+            m_names.AppendByte('/');
+            entry.m_nameLen++;
+        }
+    }
+
+    return true;
 }
 
-void wxZipOutputStream::Init(int level)
+wxUint32 wxZipIndexData::Hash(const char *name, size_t len)
 {
-    m_store = new wxStoredOutputStream(*m_parent_o_stream);
-    m_deflate = NULL;
-    m_backlink = NULL;
-    m_initialData = new char[OUTPUT_LATENCY];
-    m_initialSize = 0;
-    m_pending = NULL;
-    m_raw = false;
-    m_headerOffset = 0;
-    m_headerSize = 0;
-    m_entrySize = 0;
-    m_comp = NULL;
-    m_level = level;
-    m_offsetAdjustment = wxInvalidOffset;
-    m_endrecWritten = false;
-    m_format = wxZIP_FORMAT_DEFAULT;
+    // FNV-1a
+    wxUint32 hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-wxZipOutputStream::~wxZipOutputStream()
+void wxZipIndexData::BuildTable()
 {
-    Close();
-    WX_CLEAR_LIST(wxZipEntryList_, m_entries);
-    delete m_store;
-    delete m_deflate;
-    delete m_pending;
-    delete [] m_initialData;
-    if (m_backlink)
-        m_backlink->Release(this);
+    // Keep the table at most half full.
+    size_t size = 16;
+    while (size < 2 * m_entries.size())
+        size *= 2;
+
+    m_table.assign(size, 0);
+    const size_t mask = size - 1;
+
+    for (size_t n = 0; n < m_entries.size(); n++) {
+        const Entry& entry = m_entries[n];
+        const char *name = GetNameData(entry);
+
+        size_t i = Hash(name, entry.m_nameLen) & mask;
+        for (;;) {
+            const wxUint32 slot = m_table[i];
+            if (!slot) {
+                m_table[i] = static_cast<wxUint32>(n + 1);
+                break;
+            }
+
+            // If the same name occurs more than once, the first entry wins.
+            const Entry& other = m_entries[slot - 1];
+            if (other.m_nameLen == entry.m_nameLen &&
+                    memcmp(GetNameData(other), name, entry.m_nameLen) == 0)
+                break;
+
+            i = (i + 1) & mask;
+        }
+    }
 }
 
-bool wxZipOutputStream::PutNextEntry(
-    const wxString& name,
-    const wxDateTime& dt /*=wxDateTime::Now()*/,
-    wxFileOffset size    /*=wxInvalidOffset*/)
+int wxZipIndexData::Find(const wxString& name) const
 {
-    return PutNextEntry(new wxZipEntry(name, dt, size));
+    const wxScopedCharBuffer utf8 = name.utf8_str();
+    const size_t len = utf8.length();
+    if (len > 0xffff)
+        return wxNOT_FOUND;
+
+    const size_t mask = m_table.size() - 1;
+
+    for (size_t i = Hash(utf8.data(), len) & mask; m_table[i]; i = (i + 1) & mask) {
+        const size_t n = m_table[i] - 1;
+        const Entry& entry = m_entries[n];
+        if (entry.m_nameLen == len &&
+                memcmp(GetNameData(entry), utf8.data(), len) == 0)
+            return static_cast<int>(n);
+    }
+
+    return wxNOT_FOUND;
 }
 
-bool wxZipOutputStream::PutNextDirEntry(
-    const wxString& name,
-    const wxDateTime& dt /*=wxDateTime::Now()*/)
+wxString wxZipIndexData::GetName(size_t n) const
 {
-    wxZipEntry *entry = new wxZipEntry(name, dt);
-    entry->SetIsDir();
-    return PutNextEntry(entry);
+    const Entry& entry = m_entries[n];
+    return wxString::FromUTF8(GetNameData(entry), entry.m_nameLen);
 }
 
-bool wxZipOutputStream::CopyEntry(wxZipEntry *entry,
-                                  wxZipInputStream& inputStream)
+bool wxZipIndexData::IsDir(size_t n) const
 {
-    wxZipEntryPtr_ e(entry);
+    return (m_entries[n].m_externalAttributes & wxZIP_A_SUBDIR) != 0;
+}
 
-    return
-        inputStream.DoOpen(e.get(), true) &&
-        DoCreate(e.release(), true) &&
-        Write(inputStream).IsOk() && inputStream.Eof();
+wxDateTime wxZipIndexData::GetDateTime(size_t n) const
+{
+    return wxDateTime().SetFromDOS(m_entries[n].m_dosTime);
 }
 
-bool wxZipOutputStream::PutNextEntry(wxArchiveEntry *entry)
+wxZipEntry *wxZipIndexData::GetEntry(size_t n) const
 {
-    wxZipEntry *zipEntry = wxStaticCast(entry, wxZipEntry);
-    if (!zipEntry)
-        delete entry;
-    return PutNextEntry(zipEntry);
+    const Entry& index = m_entries[n];
+
+    wxZipEntry *entry = new wxZipEntry;
+
+    entry->m_VersionMadeBy = index.m_versionMadeBy;
+    entry->m_SystemMadeBy = index.m_systemMadeBy;
+    entry->SetVersionNeeded(index.m_versionNeeded);
+    entry->SetFlags(index.m_flags);
+    entry->SetMethod(index.m_method);
+    entry->SetDateTime(wxDateTime().SetFromDOS(index.m_dosTime));
+    entry->SetCrc(index.m_crc);
+    entry->SetCompressedSize(index.m_compressedSize);
+    entry->SetSize(index.m_size);
+    entry->SetInternalAttributes(index.m_internalAttributes);
+    entry->SetExternalAttributes(index.m_externalAttributes);
+    entry->SetOffset(index.m_offset);
+    entry->SetKey(index.m_offset);
+    entry->SetName(GetName(n), wxPATH_UNIX);
+
+    return entry;
 }
 
-bool wxZipOutputStream::CopyEntry(wxArchiveEntry *entry,
-                                  wxArchiveInputStream& stream)
+wxZipInputStream *wxZipIndexData::OpenEntry(wxInputStream *stream,
+                                            size_t n) const
 {
-    wxZipEntry *zipEntry = wxStaticCast(entry, wxZipEntry);
+    wxScopedPtr<wxZipInputStream> zip(new wxZipInputStream(stream, m_conv));
+    if (!zip->IsOk() || !stream->IsSeekable())
+        return NULL;
 
-    if (!zipEntry || !stream.OpenEntry(*zipEntry)) {
-        delete entry;
-        return false;
-    }
+    // The central directory was already read, so just mark the stream as
+    // seekable to allow opening the entry directly.
+    zip->m_position = 0;
+    zip->m_parentSeekable = true;
 
-    return CopyEntry(zipEntry, static_cast<wxZipInputStream&>(stream));
+    wxScopedPtr<wxZipEntry> entry(GetEntry(n));
+    if (!zip->OpenEntry(*entry))
+        return NULL;
+
+    return zip.release();
 }
 
-bool wxZipOutputStream::CopyArchiveMetaData(wxZipInputStream& inputStream)
+/////////////////////////////////////////////////////////////////////////////
+// wxZipIndex
+
+wxZipIndex::wxZipIndex(const wxString& filename, wxMBConv& conv)
+    : m_data(NULL)
 {
-    m_Comment = inputStream.GetComment();
-    if (m_backlink)
-        m_backlink->Release(this);
-    m_backlink = inputStream.MakeLink(this);
-    return true;
+    Create(filename, conv);
 }
 
-bool wxZipOutputStream::CopyArchiveMetaData(wxArchiveInputStream& stream)
+wxZipIndex::wxZipIndex(wxInputStream& stream, wxMBConv& conv)
+    : m_data(NULL)
 {
-    return CopyArchiveMetaData(static_cast<wxZipInputStream&>(stream));
+    Create(stream, conv);
 }
 
-void wxZipOutputStream::SetLevel(int level)
+wxZipIndex::wxZipIndex(const wxZipIndex& index)
+    : m_data(index.m_data)
 {
-    if (level != m_level) {
-        if (m_comp != m_deflate)
-            delete m_deflate;
-        m_deflate = NULL;
-        m_level = level;
+    if (m_data)
+        m_data->IncRef();
+}
+
+wxZipIndex& wxZipIndex::operator=(const wxZipIndex& index)
+{
+    if (index.m_data != m_data) {
+        if (m_data)
+            m_data->DecRef();
+        m_data = index.m_data;
+        if (m_data)
+            m_data->IncRef();
     }
+
+    return *this;
 }
 
-bool wxZipOutputStream::DoCreate(wxZipEntry *entry, bool raw /*=false*/)
+wxZipIndex::~wxZipIndex()
 {
-    CloseEntry();
+    if (m_data)
+        m_data->DecRef();
+}
 
-    m_pending = entry;
-    if (!m_pending)
+bool wxZipIndex::Create(const wxString& filename, wxMBConv& conv)
+{
+    wxFileInputStream stream(filename);
+    if (!stream.IsOk()) {
+        *this = wxZipIndex();
         return false;
+    }
 
-    // write the signature bytes right away
-    wxDataOutputStream ds(*m_parent_o_stream);
-    ds << LOCAL_MAGIC;
+    if (!Create(stream, conv))
+        return false;
 
-    // and if this is the first entry test for seekability
-    if (m_headerOffset == 0 && m_parent_o_stream->IsSeekable()) {
-#if wxUSE_LOG
-        bool logging = wxLog::IsEnabled();
-        wxLogNull nolog;
-#endif // wxUSE_LOG
-        wxFileOffset here = m_parent_o_stream->TellO();
+    m_data->m_filename = filename;
+    return true;
+}
 
-        if (here != wxInvalidOffset && here >= 4) {
-            if (m_parent_o_stream->SeekO(here - 4) == here - 4) {
-                m_offsetAdjustment = here - 4;
-#if wxUSE_LOG
-                wxLog::EnableLogging(logging);
-#endif // wxUSE_LOG
-                m_parent_o_stream->SeekO(here);
-            }
-        }
+bool wxZipIndex::Create(wxInputStream& stream, wxMBConv& conv)
+{
+    *this = wxZipIndex();
+
+    wxZipIndexData *data = new wxZipIndexData(conv);
+    if (!data->Load(stream)) {
+        data->DecRef();
+        return false;
     }
 
-    m_pending->SetOffset(m_headerOffset);
+    m_data = data;
+    return true;
+}
 
-    m_crcAccumulator = crc32(0, Z_NULL, 0);
+size_t wxZipIndex::GetCount() const
+{
+    return m_data ? m_data->GetCount() : 0;
+}
 
-    if (raw)
-        m_raw = true;
+wxString wxZipIndex::GetComment() const
+{
+    return m_data ? m_data->GetComment() : wxString();
+}
 
-    m_lasterror = wxSTREAM_NO_ERROR;
-    return true;
+int wxZipIndex::Find(const wxString& name) const
+{
+    return m_data ? m_data->Find(name) : wxNOT_FOUND;
 }
 
-// Can be overridden to add support for additional compression methods
-//
-wxOutputStream *wxZipOutputStream::OpenCompressor(
-    wxOutputStream& stream,
-    wxZipEntry& entry,
-    const Buffer bufs[])
+wxString wxZipIndex::GetName(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), wxString(), "invalid index" );
+
+    return m_data->GetName(n);
+}
+
+bool wxZipIndex::IsDir(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), false, "invalid index" );
+
+    return m_data->IsDir(n);
+}
+
+wxFileOffset wxZipIndex::GetSize(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), wxInvalidOffset, "invalid index" );
+
+    return m_data->GetSize(n);
+}
+
+wxDateTime wxZipIndex::GetDateTime(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), wxDateTime(), "invalid index" );
+
+    return m_data->GetDateTime(n);
+}
+
+wxZipEntry *wxZipIndex::GetEntry(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), NULL, "invalid index" );
+
+    return m_data->GetEntry(n);
+}
+
+wxZipInputStream *wxZipIndex::OpenEntry(size_t n) const
+{
+    wxCHECK_MSG( n < GetCount(), NULL, "invalid index" );
+    wxCHECK_MSG( !m_data->m_filename.empty(), NULL,
+                 "index not created from a file" );
+
+    return m_data->OpenEntry(new wxFileInputStream(m_data->m_filename), n);
+}
+
+wxZipInputStream *wxZipIndex::OpenEntry(wxInputStream *stream, size_t n) const
+{
+    if (n >= GetCount()) {
+        delete stream;
+        wxFAIL_MSG( "invalid index" );
+        return NULL;
+    }
+
+    return m_data->OpenEntry(stream, n);
+}
+
+#endif // wxABI_VERSION >= 3.2.9
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Output stream helpers
+
+// Choose the compression method for the entry, if it's not specified yet,
+// given the size of its data available so far.
+//
+static void ChooseMethod(wxZipEntry& entry,
+                         int level,
+                         bool seekable,
+                         size_t size)
 {
     if (entry.GetMethod() == wxZIP_METHOD_DEFAULT) {
-        if (GetLevel() == 0
-                && (IsParentSeekable()
+        if (level == 0
+                && (seekable
                     || entry.GetCompressedSize() != wxInvalidOffset
                     || entry.GetSize() != wxInvalidOffset)) {
             entry.SetMethod(wxZIP_METHOD_STORE);
         } else {
-            int size = 0;
-            for (int i = 0; bufs[i].m_data; ++i)
-                size += bufs[i].m_size;
             entry.SetMethod(size <= 6 ?
                             wxZIP_METHOD_STORE : wxZIP_METHOD_DEFLATE);
         }
     }
+}
+
+// Returns the deflate flags to use for the given compression level.
+//
+static int GetDeflateBits(int level)
+{
+    switch (level) {
+        case 0: case 1:
+            return wxZIP_DEFLATE_SUPERFAST;
+        case 2: case 3: case 4:
+            return wxZIP_DEFLATE_FAST;
+        case 8: case 9:
+            return wxZIP_DEFLATE_EXTRA;
+    }
+
+    return wxZIP_DEFLATE_NORMAL;
+}
+
+// Called after writing the signature of the first local header to check if
+// the stream is really seekable. Returns the offset of the signature in it if
+// it is or wxInvalidOffset otherwise.
+//
+static wxFileOffset GetSeekableOffset(wxOutputStream& stream)
+{
+#if wxUSE_LOG
+    bool logging = wxLog::IsEnabled();
+    wxLogNull nolog;
+#endif // wxUSE_LOG
+    wxFileOffset here = stream.TellO();
+
+    if (here != wxInvalidOffset && here >= 4) {
+        if (stream.SeekO(here - 4) == here - 4) {
+#if wxUSE_LOG
+            wxLog::EnableLogging(logging);
+#endif // wxUSE_LOG
+            stream.SeekO(here);
+            return here - 4;
+        }
+    }
+
+    return wxInvalidOffset;
+}
+
+#if wxUSE_THREADS
+
+/////////////////////////////////////////////////////////////////////////////
+// wxZipParallelOutputStream
+//
+// Used instead of the normal compressor when SetThreadCount() is used to
+// compress the entries using multiple threads. The data of each entry is
+// split into chunks which are compressed independently by the tasks running
+// in the default wxThreadPool, like pigz does it: each chunk uses the end of
+// the previous one as its dictionary and all of them except for the last one
+// end with a sync flush, so that concatenating them gives a valid deflate
+// stream.
+//
+// The entries are not written out immediately when they're closed but are
+// queued until all the previous ones are written, so that several small
+// entries can be compressed at once. As their sizes and crc are known by
+// then, their local headers can be written with the correct values, without
+// any data descriptors or seeking back. But if too much data accumulates in
+// memory, the current entry is written out as it is compressed, with its
+// header written in the same way as when not using threads.
+
+// The size of the chunks compressed by a single task and of the dictionary
+// taken from the end of the previous chunk.
+enum {
+    PARALLEL_CHUNK_SIZE = 128 * 1024,
+    PARALLEL_DICT_SIZE  = 32 * 1024
+};
+
+// The maximal number of chunks per thread kept in memory.
+static const size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+
+// Deflate state which is reused for compressing many chunks.
+struct wxZipDeflater
+{
+    z_stream m_stream;
+    int m_level;
+};
+
+class wxZipParallelOutputStream : public wxOutputStream
+{
+public:
+    wxZipParallelOutputStream(wxZipOutputStream& zip, int numThreads)
+        : m_zip(zip),
+          m_numThreads(numThreads),
+          m_current(NULL),
+          m_chunk(PARALLEL_CHUNK_SIZE),
+          m_numChunks(0)
+    { }
+
+    virtual ~wxZipParallelOutputStream();
+
+    void SetThreadCount(int numThreads) { m_numThreads = numThreads; }
+    int GetThreadCount() const          { return m_numThreads; }
+    bool IsEnabled() const              { return m_numThreads > 1; }
+
+    // Start a new entry, taking ownership of it. Returns NULL if its
+    // compression method is not supported.
+    wxOutputStream *OpenEntry(wxZipEntry *entry, size_t size);
+
+    // Finish the current entry. Returns false if it has been queued or true
+    // if it was being written out as it was compressed, in which case the
+    // caller must finish writing it.
+    bool CloseEntry();
+
+    // Write out all the queued entries.
+    void Flush();
+
+    virtual void Sync() wxOVERRIDE;
+
+    // Called by the tasks to get a deflate state to use for compressing a
+    // chunk and return it when they're done with it.
+    wxZipDeflater *AcquireDeflater(int level);
+    void ReleaseDeflater(wxZipDeflater *deflater);
+
+protected:
+    virtual size_t OnSysWrite(const void *buffer, size_t size) wxOVERRIDE;
+
+private:
+    // The chunk of data compressed by a task or stored as is.
+    struct Chunk
+    {
+        wxThreadPoolFuture m_future;
+        wxMemoryBuffer m_data;
+    };
+
+    struct Entry
+    {
+        Entry(wxZipEntry *entry, int level)
+            : m_entry(entry), m_method(entry->GetMethod()), m_level(level),
+              m_crc(0), m_size(0),
+              m_written(0), m_closed(false), m_streaming(false)
+        { }
+
+        ~Entry() { delete m_entry; }
+
+        wxZipEntry *m_entry;        // NULL once passed to wxZipOutputStream
+        int m_method;
+        int m_level;
+        wxUint32 m_crc;
+        wxFileOffset m_size;
+        wxVector<Chunk> m_chunks;
+        size_t m_written;           // number of chunks already written
+        bool m_closed;
+        bool m_streaming;           // header written, chunks written as ready
+    };
+
+    static bool IsDone(const Chunk& chunk);
+    const wxMemoryBuffer *GetChunkOutput(Chunk& chunk);
+
+    void SubmitChunk(bool last);
+    void WriteFront();
+    void WriteAvailable();
+    void WriteQueued(Entry& entry);
+    void StartStreaming(Entry& entry);
+    void WriteChunks(Entry& entry, bool waitAll);
+    void WriteSignature(wxZipEntry& entry);
+    void PopFront();
+
+    wxZipOutputStream& m_zip;
+    int m_numThreads;
+
+    // The entries not completely written out yet, the last one may be the
+    // current one.
+    wxVector<Entry*> m_queue;
+    Entry *m_current;
+
+    // The data of the current chunk and the end of the previous one.
+    wxMemoryBuffer m_chunk;
+    wxMemoryBuffer m_dict;
+
+    // The number of chunks in all the queued entries.
+    size_t m_numChunks;
+
+    // The futures of the recently submitted tasks, used to limit their number.
+    wxVector<wxThreadPoolFuture> m_running;
+
+    // The deflate states not currently used by any task.
+    wxVector<wxZipDeflater*> m_deflaters;
+    wxCriticalSection m_deflatersCS;
+
+    wxDECLARE_NO_COPY_CLASS(wxZipParallelOutputStream);
+};
+
+// Task compressing a single chunk.
+class wxZipDeflateTask : public wxThreadPoolTask
+{
+public:
+    // The task takes ownership of the input buffer, which must not be used
+    // by the caller any more, while the dictionary is copied.
+    wxZipDeflateTask(wxZipParallelOutputStream& owner,
+                     const wxMemoryBuffer& input,
+                     const wxMemoryBuffer& dict,
+                     int level,
+                     bool last)
+        : m_owner(owner), m_input(input), m_level(level), m_last(last),
+          m_ok(false)
+    {
+        if (!dict.IsEmpty())
+            m_dict.AppendData(dict.GetData(), dict.GetDataLen());
+    }
+
+    const wxMemoryBuffer& GetInput() const  { return m_input; }
+    const wxMemoryBuffer& GetOutput() const { return m_output; }
+    bool IsOk() const                       { return m_ok; }
+
+protected:
+    virtual void Run() wxOVERRIDE;
+
+private:
+    wxZipParallelOutputStream& m_owner;
+    wxMemoryBuffer m_input;
+    wxMemoryBuffer m_dict;
+    wxMemoryBuffer m_output;
+    int m_level;
+    bool m_last;
+    bool m_ok;
+};
+
+void wxZipDeflateTask::Run()
+{
+    wxZipDeflater *deflater = m_owner.AcquireDeflater(m_level);
+    if (!deflater)
+        return;
+
+    z_stream& z = deflater->m_stream;
+
+    if (!m_dict.IsEmpty())
+        deflateSetDictionary(&z, (Bytef*)m_dict.GetData(),
+                             (uInt)m_dict.GetDataLen());
+
+    z.next_in = (Bytef*)m_input.GetData();
+    z.avail_in = (uInt)m_input.GetDataLen();
+
+    // deflateBound() doesn't account for the sync flush marker, but we
+    // still loop below in case it's not enough
+    size_t size = deflateBound(&z, z.avail_in) + 16;
+
+    for (;;) {
+        z.next_out = (Bytef*)m_output.GetAppendBuf(size);
+        z.avail_out = (uInt)size;
+
+        int err = deflate(&z, m_last ? Z_FINISH : Z_SYNC_FLUSH);
+        m_output.UngetAppendBuf(size - z.avail_out);
+
+        if (err == Z_STREAM_END || (err == Z_OK && !m_last && z.avail_out)) {
+            m_ok = true;
+            break;
+        }
+
+        if (err != Z_OK && err != Z_BUF_ERROR)
+            break;
+    }
+
+    m_owner.ReleaseDeflater(deflater);
+}
+
+wxZipParallelOutputStream::~wxZipParallelOutputStream()
+{
+    // Normally all entries have been written by now, but if not, wait until
+    // the tasks using our deflate states finish.
+    for (size_t n = 0; n < m_queue.size(); n++) {
+        Entry *entry = m_queue[n];
+        for (size_t i = 0; i < entry->m_chunks.size(); i++) {
+            wxThreadPoolFuture& future = entry->m_chunks[i].m_future;
+            if (future.IsOk() && !future.Cancel())
+                future.Wait();
+        }
+        delete entry;
+    }
+
+    for (size_t n = 0; n < m_deflaters.size(); n++) {
+        deflateEnd(&m_deflaters[n]->m_stream);
+        delete m_deflaters[n];
+    }
+}
+
+wxZipDeflater *wxZipParallelOutputStream::AcquireDeflater(int level)
+{
+    wxZipDeflater *deflater = NULL;
+    {
+        wxCriticalSectionLocker lock(m_deflatersCS);
+        if (!m_deflaters.empty()) {
+            deflater = m_deflaters.back();
+            m_deflaters.pop_back();
+        }
+    }
+
+    if (!deflater) {
+        deflater = new wxZipDeflater;
+        memset(&deflater->m_stream, 0, sizeof(deflater->m_stream));
+        if (deflateInit2(&deflater->m_stream, level, Z_DEFLATED, -MAX_WBITS,
+                         8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            delete deflater;
+            return NULL;
+        }
+        deflater->m_level = level;
+    }
+    else if (deflater->m_level != level) {
+        if (deflateParams(&deflater->m_stream, level,
+                          Z_DEFAULT_STRATEGY) != Z_OK) {
+            ReleaseDeflater(deflater);
+            return NULL;
+        }
+        deflater->m_level = level;
+    }
+
+    return deflater;
+}
+
+void wxZipParallelOutputStream::ReleaseDeflater(wxZipDeflater *deflater)
+{
+    deflateReset(&deflater->m_stream);
+
+    wxCriticalSectionLocker lock(m_deflatersCS);
+    m_deflaters.push_back(deflater);
+}
+
+wxOutputStream *wxZipParallelOutputStream::OpenEntry(wxZipEntry *entry,
+                                                     size_t size)
+{
+    wxASSERT(!m_current);
+
+    const int level = m_zip.GetLevel();
+    ChooseMethod(*entry, level, m_zip.IsParentSeekable(), size);
+
+    switch (entry->GetMethod()) {
+        case wxZIP_METHOD_STORE:
+            if (entry->GetCompressedSize() == wxInvalidOffset)
+                entry->SetCompressedSize(entry->GetSize());
+            break;
+
+        case wxZIP_METHOD_DEFLATE:
+            entry->SetFlags((entry->GetFlags() & ~wxZIP_DEFLATE_MASK) |
+                            GetDeflateBits(level) | wxZIP_SUMS_FOLLOW);
+            break;
+
+        default:
+            wxLogError(_("unsupported Zip compression method"));
+            delete entry;
+            return NULL;
+    }
+
+    m_current = new Entry(entry, level);
+    m_queue.push_back(m_current);
+
+    return this;
+}
+
+size_t wxZipParallelOutputStream::OnSysWrite(const void *buffer, size_t size)
+{
+    const char *data = static_cast<const char*>(buffer);
+    size_t left = size;
+
+    while (left && IsOk()) {
+        size_t count = wxMin(left, PARALLEL_CHUNK_SIZE - m_chunk.GetDataLen());
+        m_chunk.AppendData(data, count);
+        data += count;
+        left -= count;
+
+        if (m_chunk.GetDataLen() == PARALLEL_CHUNK_SIZE)
+            SubmitChunk(false);
+    }
+
+    return IsOk() ? size : 0;
+}
+
+void wxZipParallelOutputStream::SubmitChunk(bool last)
+{
+    Entry& entry = *m_current;
+    Chunk chunk;
+
+    if (entry.m_method == wxZIP_METHOD_STORE) {
+        if (m_chunk.IsEmpty())
+            return;
+
+        chunk.m_data = m_chunk;
+        m_chunk = wxMemoryBuffer(PARALLEL_CHUNK_SIZE);
+    } else {
+        // Don't submit more tasks than we can use threads: as they're run in
+        // order, waiting for the oldest one is enough to ensure this.
+        if (m_running.size() >= static_cast<size_t>(m_numThreads)) {
+            m_running[0].Wait();
+            m_running.erase(m_running.begin());
+        }
+
+        wxZipDeflateTask *task =
+            new wxZipDeflateTask(*this, m_chunk, m_dict, entry.m_level, last);
+
+        // Remember the last part of the data to use it as the dictionary for
+        // the next chunk.
+        const char *data = static_cast<const char*>(m_chunk.GetData());
+        size_t len = m_chunk.GetDataLen();
+        if (len >= PARALLEL_DICT_SIZE) {
+            m_dict.Clear();
+            m_dict.AppendData(data + len - PARALLEL_DICT_SIZE,
+                              PARALLEL_DICT_SIZE);
+        } else {
+            wxMemoryBuffer dict(PARALLEL_DICT_SIZE);
+            size_t keep = wxMin(m_dict.GetDataLen(), PARALLEL_DICT_SIZE - len);
+            dict.AppendData(static_cast<const char*>(m_dict.GetData()) +
+                                m_dict.GetDataLen() - keep, keep);
+            dict.AppendData(data, len);
+            m_dict = dict;
+        }
+
+        // The task now owns the data, don't share it with it, as the
+        // reference count of wxMemoryBuffer is not thread-safe.
+        m_chunk = wxMemoryBuffer(PARALLEL_CHUNK_SIZE);
+
+        chunk.m_future = wxThreadPool::GetDefault().Submit(task);
+        m_running.push_back(chunk.m_future);
+    }
+
+    entry.m_chunks.push_back(chunk);
+    m_numChunks++;
+
+    // Don't keep too much data in memory.
+    while (IsOk()
+           && m_numChunks > PARALLEL_CHUNKS_PER_THREAD * m_numThreads)
+        WriteFront();
+
+    WriteAvailable();
+}
+
+bool wxZipParallelOutputStream::IsDone(const Chunk& chunk)
+{
+    return !chunk.m_future.IsOk() || chunk.m_future.IsDone();
+}
+
+// Waits for the chunk to be compressed if necessary and returns its data or
+// NULL if compressing it failed.
+const wxMemoryBuffer *wxZipParallelOutputStream::GetChunkOutput(Chunk& chunk)
+{
+    if (!chunk.m_future.IsOk())
+        return &chunk.m_data;
+
+    chunk.m_future.Wait();
+
+    const wxZipDeflateTask *task =
+        static_cast<wxZipDeflateTask*>(chunk.m_future.GetTask());
+    if (!task->IsOk()) {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+        return NULL;
+    }
+
+    return &task->GetOutput();
+}
+
+// Write out the first entry in the queue, or at least some of its chunks if
+// it's the current one.
+void wxZipParallelOutputStream::WriteFront()
+{
+    Entry& entry = *m_queue[0];
+
+    if (entry.m_closed) {
+        WriteQueued(entry);
+    } else {
+        if (!entry.m_streaming)
+            StartStreaming(entry);
+        WriteChunks(entry, false);
+    }
+}
+
+// Write out the entries at the front of the queue which are ready, without
+// waiting for anything.
+void wxZipParallelOutputStream::WriteAvailable()
+{
+    while (IsOk() && !m_queue.empty()) {
+        Entry& entry = *m_queue[0];
+        if (!entry.m_closed)
+            break;
+
+        for (size_t n = 0; n < entry.m_chunks.size(); n++) {
+            if (!IsDone(entry.m_chunks[n]))
+                return;
+        }
+
+        WriteQueued(entry);
+    }
+}
+
+void wxZipParallelOutputStream::Flush()
+{
+    while (IsOk() && !m_queue.empty() && m_queue[0]->m_closed)
+        WriteQueued(*m_queue[0]);
+}
+
+void wxZipParallelOutputStream::PopFront()
+{
+    Entry *entry = m_queue[0];
+    m_numChunks -= entry->m_chunks.size() - entry->m_written;
+    m_queue.erase(m_queue.begin());
+    delete entry;
+}
+
+// Write the local header signature, this is done separately from the rest of
+// the header as in wxZipOutputStream::DoCreate().
+void wxZipParallelOutputStream::WriteSignature(wxZipEntry& entry)
+{
+    wxOutputStream& stream = *m_zip.m_parent_o_stream;
+
+    wxDataOutputStream ds(stream);
+    ds << LOCAL_MAGIC;
+
+    if (m_zip.m_headerOffset == 0 && stream.IsSeekable()) {
+        wxFileOffset offset = GetSeekableOffset(stream);
+        if (offset != wxInvalidOffset)
+            m_zip.m_offsetAdjustment = offset;
+    }
+
+    entry.SetOffset(m_zip.m_headerOffset);
+}
+
+// Write out the queued entry with all its data.
+void wxZipParallelOutputStream::WriteQueued(Entry& queued)
+{
+    wxZipEntry& entry = *queued.m_entry;
+    wxFileOffset compressedSize = 0;
+
+    for (size_t n = 0; n < queued.m_chunks.size() && IsOk(); n++) {
+        const wxMemoryBuffer *output = GetChunkOutput(queued.m_chunks[n]);
+        if (output)
+            compressedSize += output->GetDataLen();
+    }
+
+    if (!IsOk()) {
+        PopFront();
+        return;
+    }
+
+    // Store the data as is if compressing it didn't help, like it's done for
+    // the small entries when not using threads.
+    bool stored = false;
+    if (queued.m_method == wxZIP_METHOD_DEFLATE
+            && compressedSize >= queued.m_size) {
+        stored = true;
+        entry.SetMethod(wxZIP_METHOD_STORE);
+        compressedSize = queued.m_size;
+    }
+
+    entry.SetCrc(queued.m_crc);
+    entry.SetSize(queued.m_size);
+    entry.SetCompressedSize(compressedSize);
+    entry.m_Flags &= ~wxZIP_SUMS_FOLLOW;
+
+    WriteSignature(entry);
+
+    wxOutputStream& stream = *m_zip.m_parent_o_stream;
+    size_t headerSize = entry.WriteLocal(stream, m_zip.GetConv(),
+                                         m_zip.m_format);
+
+    for (size_t n = 0; n < queued.m_chunks.size() && stream.IsOk(); n++) {
+        const wxMemoryBuffer *data = GetChunkOutput(queued.m_chunks[n]);
+        if (stored)
+            data = &static_cast<wxZipDeflateTask*>(
+                        queued.m_chunks[n].m_future.GetTask())->GetInput();
+        stream.Write(data->GetData(), data->GetDataLen());
+    }
+
+    if (stream.IsOk()) {
+        m_zip.m_headerOffset += headerSize + compressedSize;
+        m_zip.m_entries.push_back(queued.m_entry);
+        queued.m_entry = NULL;
+    } else {
+        wxLogError(_("error writing zip entry '%s'"), entry.GetName().c_str());
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+    }
+
+    PopFront();
+}
+
+// Start writing out the current entry, when it is at the front of the queue,
+// in the same way as wxZipOutputStream::CreatePendingEntry() does it.
+void wxZipParallelOutputStream::StartStreaming(Entry& current)
+{
+    wxZipEntry& entry = *current.m_entry;
+
+    WriteSignature(entry);
+
+    if (m_zip.IsParentSeekable()
+        || (entry.m_Crc
+            && entry.m_CompressedSize != wxInvalidOffset
+            && entry.m_Size != wxInvalidOffset))
+        entry.m_Flags &= ~wxZIP_SUMS_FOLLOW;
+    else
+        if (entry.m_CompressedSize != wxInvalidOffset)
+            entry.m_Flags |= wxZIP_SUMS_FOLLOW;
+
+    m_zip.m_headerSize = entry.WriteLocal(*m_zip.m_parent_o_stream,
+                                          m_zip.GetConv(), m_zip.m_format);
+
+    if (m_zip.m_parent_o_stream->IsOk()) {
+        m_zip.m_entries.push_back(current.m_entry);
+        current.m_entry = NULL;
+    } else {
+        m_lasterror = wxSTREAM_WRITE_ERROR;
+    }
+
+    current.m_streaming = true;
+}
+
+// Write the chunks of the entry being streamed, waiting for all of them or
+// only for the first one and then writing those that are already done.
+void wxZipParallelOutputStream::WriteChunks(Entry& entry, bool waitAll)
+{
+    for (bool first = true;
+         IsOk() && entry.m_written < entry.m_chunks.size();
+         first = false) {
+        Chunk& chunk = entry.m_chunks[entry.m_written];
+        if (!waitAll && !first && !IsDone(chunk))
+            break;
+
+        const wxMemoryBuffer *output = GetChunkOutput(chunk);
+        if (!output)
+            break;
+
+        wxStoredOutputStream& store = *m_zip.m_store;
+        if (store.Write(output->GetData(), output->GetDataLen()).LastWrite()
+                != output->GetDataLen())
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+
+        // Free the memory used by the chunk as soon as possible.
+        chunk = Chunk();
+        entry.m_written++;
+        m_numChunks--;
+    }
+}
+
+bool wxZipParallelOutputStream::CloseEntry()
+{
+    wxASSERT(m_current);
+
+    SubmitChunk(true);
+    m_dict.Clear();
+
+    Entry *entry = m_current;
+    m_current = NULL;
+
+    entry->m_crc = m_zip.m_crcAccumulator;
+    entry->m_size = m_zip.m_entrySize;
+    entry->m_closed = true;
+
+    if (!entry->m_streaming) {
+        WriteAvailable();
+        return false;
+    }
+
+    WriteChunks(*entry, true);
+    PopFront();
+
+    return true;
+}
+
+void wxZipParallelOutputStream::Sync()
+{
+    if (!m_current)
+        return;
+
+    // Everything written so far must be written out, so we need to write all
+    // the previous entries and start writing this one.
+    while (IsOk() && m_queue[0] != m_current)
+        WriteFront();
+
+    if (!IsOk())
+        return;
+
+    if (!m_current->m_streaming)
+        StartStreaming(*m_current);
+
+    // This works because all the chunks are terminated by a sync flush.
+    SubmitChunk(false);
+    WriteChunks(*m_current, true);
+
+    m_zip.m_store->Sync();
+}
+
+#endif // wxUSE_THREADS
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Output stream
+
+#include "wx/listimpl.cpp"
+WX_DEFINE_LIST(wxZipEntryList_)
+
+wxZipOutputStream::wxZipOutputStream(wxOutputStream& stream,
+                                     int level      /*=-1*/,
+                                     wxMBConv& conv /*=wxConvUTF8*/)
+  : wxArchiveOutputStream(stream, conv)
+{
+    Init(level);
+}
+
+wxZipOutputStream::wxZipOutputStream(wxOutputStream *stream,
+                                     int level      /*=-1*/,
+                                     wxMBConv& conv /*=wxConvUTF8*/)
+  : wxArchiveOutputStream(stream, conv)
+{
+    Init(level);
+}
+
+void wxZipOutputStream::Init(int level)
+{
+    m_store = new wxStoredOutputStream(*m_parent_o_stream);
+    m_deflate = NULL;
+    m_backlink = NULL;
+    m_initialData = new char[OUTPUT_LATENCY];
+    m_initialSize = 0;
+    m_pending = NULL;
+    m_raw = false;
+    m_headerOffset = 0;
+    m_headerSize = 0;
+    m_entrySize = 0;
+    m_comp = NULL;
+    m_level = level;
+    m_offsetAdjustment = wxInvalidOffset;
+    m_endrecWritten = false;
+    m_format = wxZIP_FORMAT_DEFAULT;
+}
+
+wxZipOutputStream::~wxZipOutputStream()
+{
+    Close();
+    WX_CLEAR_LIST(wxZipEntryList_, m_entries);
+#if wxUSE_THREADS
+    delete m_store->GetParallel();
+#endif
+    delete m_store;
+    delete m_deflate;
+    delete m_pending;
+    delete [] m_initialData;
+    if (m_backlink)
+        m_backlink->Release(this);
+}
+
+bool wxZipOutputStream::PutNextEntry(
+    const wxString& name,
+    const wxDateTime& dt /*=wxDateTime::Now()*/,
+    wxFileOffset size    /*=wxInvalidOffset*/)
+{
+    return PutNextEntry(new wxZipEntry(name, dt, size));
+}
+
+bool wxZipOutputStream::PutNextDirEntry(
+    const wxString& name,
+    const wxDateTime& dt /*=wxDateTime::Now()*/)
+{
+    wxZipEntry *entry = new wxZipEntry(name, dt);
+    entry->SetIsDir();
+    return PutNextEntry(entry);
+}
+
+bool wxZipOutputStream::CopyEntry(wxZipEntry *entry,
+                                  wxZipInputStream& inputStream)
+{
+    wxZipEntryPtr_ e(entry);
+
+    return
+        inputStream.DoOpen(e.get(), true) &&
+        DoCreate(e.release(), true) &&
+        Write(inputStream).IsOk() && inputStream.Eof();
+}
+
+bool wxZipOutputStream::PutNextEntry(wxArchiveEntry *entry)
+{
+    wxZipEntry *zipEntry = wxStaticCast(entry, wxZipEntry);
+    if (!zipEntry)
+        delete entry;
+    return PutNextEntry(zipEntry);
+}
+
+bool wxZipOutputStream::CopyEntry(wxArchiveEntry *entry,
+                                  wxArchiveInputStream& stream)
+{
+    wxZipEntry *zipEntry = wxStaticCast(entry, wxZipEntry);
+
+    if (!zipEntry || !stream.OpenEntry(*zipEntry)) {
+        delete entry;
+        return false;
+    }
+
+    return CopyEntry(zipEntry, static_cast<wxZipInputStream&>(stream));
+}
+
+bool wxZipOutputStream::CopyArchiveMetaData(wxZipInputStream& inputStream)
+{
+    m_Comment = inputStream.GetComment();
+    if (m_backlink)
+        m_backlink->Release(this);
+    m_backlink = inputStream.MakeLink(this);
+    return true;
+}
+
+bool wxZipOutputStream::CopyArchiveMetaData(wxArchiveInputStream& stream)
+{
+    return CopyArchiveMetaData(static_cast<wxZipInputStream&>(stream));
+}
+
+void wxZipOutputStream::SetLevel(int level)
+{
+    // the deflate stream is reused with the new level when opened again
+    m_level = level;
+}
+
+void wxZipOutputStream::SetThreadCount(int numThreads)
+{
+#if wxUSE_THREADS
+    wxCHECK_RET( numThreads >= 0, "invalid number of threads" );
+    wxCHECK_RET( !IsOpened(), "can't change the number of threads now" );
+
+    if (numThreads == 0)
+        numThreads = wxThread::GetCPUCount();
+
+    wxZipParallelOutputStream *parallel = m_store->GetParallel();
+    if (parallel)
+        parallel->SetThreadCount(numThreads);
+    else if (numThreads > 1)
+        m_store->SetParallel(new wxZipParallelOutputStream(*this, numThreads));
+#else
+    wxUnusedVar(numThreads);
+#endif
+}
+
+int wxZipOutputStream::GetThreadCount() const
+{
+#if wxUSE_THREADS
+    if (m_store->GetParallel())
+        return m_store->GetParallel()->GetThreadCount();
+#endif
+    return 1;
+}
+
+#if wxUSE_THREADS
+
+// Returns the object used for parallel compression if it's enabled.
+//
+static inline wxZipParallelOutputStream *
+wxGetZipParallel(const wxStoredOutputStream *store)
+{
+    wxZipParallelOutputStream *parallel = store->GetParallel();
+    return parallel && parallel->IsEnabled() ? parallel : NULL;
+}
+
+#endif // wxUSE_THREADS
+
+bool wxZipOutputStream::DoCreate(wxZipEntry *entry, bool raw /*=false*/)
+{
+    CloseEntry();
+
+    m_pending = entry;
+    if (!m_pending)
+        return false;
+
+#if wxUSE_THREADS
+    if (wxZipParallelOutputStream *parallel = m_store->GetParallel()) {
+        // the entry is written later when it's compressed, but the previous
+        // ones need to be written out first when copying it
+        if (!raw && parallel->IsEnabled()) {
+            m_crcAccumulator = crc32(0, Z_NULL, 0);
+            m_lasterror = parallel->IsOk() ? wxSTREAM_NO_ERROR
+                                           : wxSTREAM_WRITE_ERROR;
+            return true;
+        }
+
+        parallel->Flush();
+    }
+#endif // wxUSE_THREADS
+
+    // write the signature bytes right away
+    wxDataOutputStream ds(*m_parent_o_stream);
+    ds << LOCAL_MAGIC;
+
+    // and if this is the first entry test for seekability
+    if (m_headerOffset == 0 && m_parent_o_stream->IsSeekable()) {
+        wxFileOffset offset = GetSeekableOffset(*m_parent_o_stream);
+        if (offset != wxInvalidOffset)
+            m_offsetAdjustment = offset;
+    }
+
+    m_pending->SetOffset(m_headerOffset);
+
+    m_crcAccumulator = crc32(0, Z_NULL, 0);
+
+    if (raw)
+        m_raw = true;
+
+    m_lasterror = wxSTREAM_NO_ERROR;
+    return true;
+}
+
+// Can be overridden to add support for additional compression methods
+//
+wxOutputStream *wxZipOutputStream::OpenCompressor(
+    wxOutputStream& stream,
+    wxZipEntry& entry,
+    const Buffer bufs[])
+{
+    size_t size = 0;
+    for (int i = 0; bufs[i].m_data; ++i)
+        size += bufs[i].m_size;
+
+    ChooseMethod(entry, GetLevel(), IsParentSeekable(), size);
 
     switch (entry.GetMethod()) {
         case wxZIP_METHOD_STORE:
@@ -2357,29 +3666,15 @@ wxOutputStream *wxZipOutputStream::OpenCompressor(
             return m_store;
 
         case wxZIP_METHOD_DEFLATE:
-        {
-            int defbits = wxZIP_DEFLATE_NORMAL;
-            switch (GetLevel()) {
-                case 0: case 1:
-                    defbits = wxZIP_DEFLATE_SUPERFAST;
-                    break;
-                case 2: case 3: case 4:
-                    defbits = wxZIP_DEFLATE_FAST;
-                    break;
-                case 8: case 9:
-                    defbits = wxZIP_DEFLATE_EXTRA;
-                    break;
-            }
             entry.SetFlags((entry.GetFlags() & ~wxZIP_DEFLATE_MASK) |
-                            defbits | wxZIP_SUMS_FOLLOW);
+                            GetDeflateBits(GetLevel()) | wxZIP_SUMS_FOLLOW);
 
             if (!m_deflate)
                 m_deflate = new wxZlibOutputStream2(stream, GetLevel());
             else
-                m_deflate->Open(stream);
+                m_deflate->Open(stream, GetLevel());
 
             return m_deflate;
-        }
 
         default:
             wxLogError(_("unsupported Zip compression method"));
@@ -2403,6 +3698,22 @@ bool wxZipOutputStream::CloseCompressor(wxOutputStream *comp)
 void wxZipOutputStream::CreatePendingEntry(const void *buffer, size_t size)
 {
     wxASSERT(IsOk() && m_pending && !m_comp);
+
+#if wxUSE_THREADS
+    if (wxZipParallelOutputStream *parallel = wxGetZipParallel(m_store)) {
+        if (!m_raw) {
+            m_comp = parallel->OpenEntry(m_pending, m_initialSize + size);
+            m_pending = NULL;
+            if (m_comp)
+                OnSysWrite(m_initialData, m_initialSize);
+            else
+                m_lasterror = wxSTREAM_WRITE_ERROR;
+            m_initialSize = 0;
+            return;
+        }
+    }
+#endif // wxUSE_THREADS
+
     wxZipEntryPtr_ spPending(m_pending);
     m_pending = NULL;
 
@@ -2498,6 +3809,14 @@ bool wxZipOutputStream::Close()
 {
     CloseEntry();
 
+#if wxUSE_THREADS
+    if (wxZipParallelOutputStream *parallel = m_store->GetParallel()) {
+        parallel->Flush();
+        if (IsOk() && !parallel->IsOk())
+            m_lasterror = wxSTREAM_WRITE_ERROR;
+    }
+#endif // wxUSE_THREADS
+
     if (m_lasterror == wxSTREAM_WRITE_ERROR
         || (m_entries.size() == 0 && m_endrecWritten))
     {
@@ -2537,6 +3856,12 @@ bool wxZipOutputStream::Close()
 //
 bool wxZipOutputStream::CloseEntry()
 {
+#if wxUSE_THREADS
+    wxZipParallelOutputStream *parallel = wxGetZipParallel(m_store);
+    if (IsOk() && m_pending && parallel && !m_raw)
+        CreatePendingEntry(NULL, 0);
+#endif // wxUSE_THREADS
+
     if (IsOk() && m_pending)
         CreatePendingEntry();
     if (!IsOk())
@@ -2544,8 +3869,28 @@ bool wxZipOutputStream::CloseEntry()
     if (!m_comp)
         return true;
 
-    CloseCompressor(m_comp);
-    m_comp = NULL;
+#if wxUSE_THREADS
+    if (parallel && m_comp == parallel) {
+        m_comp = NULL;
+
+        // unless the entry was written out while it was being compressed,
+        // it is queued now and written later
+        if (!parallel->CloseEntry()) {
+            m_entrySize = 0;
+            m_lasterror = parallel->GetLastError();
+            return IsOk();
+        }
+
+        m_lasterror = parallel->GetLastError();
+        if (!IsOk())
+            return false;
+    }
+    else
+#endif // wxUSE_THREADS
+    {
+        CloseCompressor(m_comp);
+        m_comp = NULL;
+    }
 
     wxFileOffset compressedSize = m_store->TellO();
 
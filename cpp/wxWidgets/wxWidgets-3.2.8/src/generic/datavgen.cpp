@@ -18,8 +18,8 @@
 #ifdef wxHAS_GENERIC_DATAVIEWCTRL
 
 #ifndef WX_PRECOMP
+    #include "wx/app.h"              // wxWakeUpIdle(), GetRegisteredClassName()
     #ifdef __WXMSW__
-        #include "wx/app.h"          // GetRegisteredClassName()
         #include "wx/msw/private.h"
         #include "wx/msw/wrapwin.h"
         #include "wx/msw/wrapcctl.h" // include <commctrl.h> "properly"
@@ -52,6 +52,7 @@
 #include "wx/generic/private/markuptext.h"
 #include "wx/generic/private/rowheightcache.h"
 #include "wx/generic/private/widthcalc.h"
+#include "wx/hashmap.h"
 #if wxUSE_ACCESSIBILITY
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
@@ -74,11 +75,11 @@ static const int PADDING_RIGHTLEFT = 3;
 namespace
 {
 
-// Flags for Walker() function defined below.
+// Flags for wxDataViewMainWindow::GetRowByItem() defined below.
 enum WalkFlags
 {
-    Walk_All,               // Visit all items.
-    Walk_ExpandedOnly       // Visit only expanded items.
+    Walk_All,               // Consider all items.
+    Walk_ExpandedOnly       // Consider only expanded items.
 };
 
 // The column is either the index of the column to be used for sorting or one
@@ -478,6 +479,10 @@ class wxDataViewTreeNode;
 
 typedef wxVector<wxDataViewTreeNode*> wxDataViewTreeNodes;
 
+// Maps the items of the children of a branch node to their positions.
+WX_DECLARE_HASH_MAP(void*, unsigned, wxPointerHash, wxPointerEqual,
+                    wxDataViewItemIndexMap);
+
 // Note: this class is not used at all for virtual list models, so all code
 // using it, i.e. any functions taking or returning objects of this type,
 // including wxDataViewMainWindow::m_root, can only be called after checking
@@ -541,6 +546,14 @@ public:
 
         const wxDataViewTreeNodes& nodes = m_branchData->children;
         const int len = nodes.size();
+        if ( len >= BranchNodeData::MIN_CHILDREN_TO_INDEX )
+        {
+            const wxDataViewItemIndexMap& index = m_branchData->GetItemIndex();
+            const wxDataViewItemIndexMap::const_iterator
+                it = index.find(item.GetID());
+            return it == index.end() ? wxNOT_FOUND : static_cast<int>(it->second);
+        }
+
         for ( int i = 0; i < len; i++ )
         {
             if ( nodes[i]->m_item == item )
@@ -549,8 +562,82 @@ public:
         return wxNOT_FOUND;
     }
 
+    // Returns the number of rows occupied by the children preceding the one
+    // with the given index, i.e. the row of this child relative to the row of
+    // the first child. Notice that the subtrees of closed children are still
+    // counted if they're open themselves, as Walk_All does it too.
+    int GetChildRowOffset(unsigned index) const
+    {
+        wxASSERT( m_branchData != NULL );
+
+        const wxDataViewTreeNodes& nodes = m_branchData->children;
+        if ( (int)nodes.size() >= BranchNodeData::MIN_CHILDREN_TO_INDEX )
+            return m_branchData->GetRowOffsets()[index];
+
+        int offset = 0;
+        for ( unsigned i = 0; i < index; i++ )
+            offset += 1 + nodes[i]->GetSubTreeCount();
+        return offset;
+    }
+
+    // Returns the index of the child whose subtree contains the given row,
+    // relative to the row of the first child, and its row offset (as returned
+    // by GetChildRowOffset()) or wxNOT_FOUND if there is no such child.
+    int FindChildByRow(int row, int* offset) const
+    {
+        wxASSERT( m_branchData != NULL );
+
+        const wxDataViewTreeNodes& nodes = m_branchData->children;
+        const int len = nodes.size();
+        if ( row < 0 || !len )
+            return wxNOT_FOUND;
+
+        if ( len >= BranchNodeData::MIN_CHILDREN_TO_INDEX )
+        {
+            // Find the last child starting at or before this row.
+            const wxVector<int>& offsets = m_branchData->GetRowOffsets();
+            int lo = 0,
+                hi = len;
+            while ( hi - lo > 1 )
+            {
+                const int mid = lo + (hi - lo) / 2;
+                if ( offsets[mid] <= row )
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+
+            *offset = offsets[lo];
+            if ( row > *offset + nodes[lo]->GetSubTreeCount() )
+                return wxNOT_FOUND;
+
+            return lo;
+        }
+
+        int current = 0;
+        for ( int i = 0; i < len; i++ )
+        {
+            const int next = current + 1 + nodes[i]->GetSubTreeCount();
+            if ( row < next )
+            {
+                *offset = current;
+                return i;
+            }
+
+            current = next;
+        }
+
+        return wxNOT_FOUND;
+    }
+
     const wxDataViewItem & GetItem() const { return m_item; }
-    void SetItem( const wxDataViewItem & item ) { m_item = item; }
+    void SetItem( const wxDataViewItem & item )
+    {
+        m_item = item;
+
+        if ( m_parent && m_parent->m_branchData )
+            m_parent->m_branchData->InvalidateItemIndex();
+    }
 
     int GetIndentLevel() const
     {
@@ -632,6 +719,10 @@ public:
     {
         wxASSERT( m_branchData != NULL );
 
+        // The offsets of the children change even if this node is closed, as
+        // they are used for Walk_All lookups too.
+        m_branchData->rowOffsetsValid = false;
+
         if( !m_branchData->open )
             return;
 
@@ -670,20 +761,90 @@ private:
     // separate struct in order to conserve memory.
     struct BranchNodeData
     {
+        // Branches with fewer children than this are searched linearly,
+        // without building rowOffsets and itemIndex for them.
+        enum { MIN_CHILDREN_TO_INDEX = 64 };
+
         BranchNodeData()
             : open(false),
-              subTreeCount(0)
+              subTreeCount(0),
+              rowOffsetsValid(false),
+              itemIndex(NULL)
+        {
+        }
+
+        ~BranchNodeData()
         {
+            delete itemIndex;
         }
 
         void InsertChild(wxDataViewTreeNode* node, unsigned index)
         {
+            // Appending children is by far the most common case, so update
+            // the index instead of rebuilding it later if possible.
+            if ( itemIndex && index == children.size() )
+            {
+                void* const id = node->GetItem().GetID();
+                if ( itemIndex->find(id) == itemIndex->end() )
+                    (*itemIndex)[id] = index;
+            }
+            else
+            {
+                InvalidateItemIndex();
+            }
+
             children.insert(children.begin() + index, node);
+            rowOffsetsValid = false;
         }
 
         void RemoveChild(unsigned index)
         {
+            InvalidateItemIndex();
+
             children.erase(children.begin() + index);
+            rowOffsetsValid = false;
+        }
+
+        // Must be called whenever the order or the items of the children
+        // change.
+        void InvalidateItemIndex()
+        {
+            wxDELETE(itemIndex);
+        }
+
+        const wxDataViewItemIndexMap& GetItemIndex()
+        {
+            if ( !itemIndex )
+            {
+                itemIndex = new wxDataViewItemIndexMap(children.size());
+
+                // Iterate backwards for the first child with the given item
+                // to win in the (normally impossible) case of duplicates.
+                for ( unsigned n = children.size(); n > 0; n-- )
+                    (*itemIndex)[children[n - 1]->GetItem().GetID()] = n - 1;
+            }
+
+            return *itemIndex;
+        }
+
+        const wxVector<int>& GetRowOffsets()
+        {
+            if ( !rowOffsetsValid )
+            {
+                const unsigned len = children.size();
+                rowOffsets.resize(len);
+
+                int offset = 0;
+                for ( unsigned n = 0; n < len; n++ )
+                {
+                    rowOffsets[n] = offset;
+                    offset += 1 + children[n]->GetSubTreeCount();
+                }
+
+                rowOffsetsValid = true;
+            }
+
+            return rowOffsets;
         }
 
         // Child nodes. Note that this may be empty even if m_hasChildren in
@@ -701,6 +862,16 @@ private:
         // 0 for leaves and is the number of rows the subtree occupies for
         // branch nodes.
         int                  subTreeCount;
+
+        // The rest of the fields are only used for the branches with at least
+        // MIN_CHILDREN_TO_INDEX children and are computed on demand.
+
+        // Row of each child relative to the first one, see GetRowOffsets().
+        wxVector<int>        rowOffsets;
+        bool                 rowOffsetsValid;
+
+        // Positions of the children indexed by their items, may be NULL.
+        wxDataViewItemIndexMap* itemIndex;
     };
 
     BranchNodeData *m_branchData;
@@ -942,6 +1113,28 @@ public:
     // Adjust last column to window size
     void UpdateColumnSizes();
 
+    // Support for wxDataViewCtrl::GetBestColumnWidth(): the mode used for the
+    // currently cached best widths.
+    wxDataViewBestColumnWidthMode GetBestWidthMode() const
+        { return m_bestWidthMode; }
+    void SetBestWidthMode(wxDataViewBestColumnWidthMode mode)
+        { m_bestWidthMode = mode; }
+
+    // Measure all rows of the given column in idle time, starting with the
+    // given width (without padding) already determined from some of them.
+    void StartBestWidthScan(const wxDataViewColumn* column, int width);
+
+    // Stop measuring the given column or all of them if it is NULL.
+    void CancelBestWidthScans(const wxDataViewColumn* column = NULL);
+
+    // Called from idle time handler to continue measuring the rows.
+    void ContinueBestWidthScans();
+
+    // Update the cached best widths of the given column or all of them if
+    // view_column is wxNOT_FOUND after the item changed, without measuring
+    // all the other rows again. Only used in non-default modes.
+    void UpdateBestWidthsForItem(const wxDataViewItem& item, int view_column);
+
     // Called by wxDataViewCtrl and our own OnRenameTimer() to start edit the
     // specified item in the given column.
     void StartEditing(const wxDataViewItem& item, const wxDataViewColumn* col);
@@ -1066,6 +1259,19 @@ private:
     // Id m_editorCtrl is non-NULL, pointer to the associated renderer.
     wxDataViewRenderer* m_editorRenderer;
 
+    // The mode used for the best widths currently cached by wxDataViewCtrl.
+    wxDataViewBestColumnWidthMode m_bestWidthMode;
+
+    // The columns being measured in idle time in wxDATAVIEW_BEST_WIDTH_FULL
+    // mode, see StartBestWidthScan().
+    struct BestWidthScan
+    {
+        const wxDataViewColumn* column;
+        unsigned int nextRow;
+        int width;
+    };
+    wxVector<BestWidthScan> m_bestWidthScans;
+
 private:
     wxDECLARE_DYNAMIC_CLASS(wxDataViewMainWindow);
     wxDECLARE_EVENT_TABLE();
@@ -1951,6 +2157,9 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
                       m_branchData->children.end(),
                       wxGenericTreeModelNodeCmp(window, sortOrder));
 
+            m_branchData->InvalidateItemIndex();
+            m_branchData->rowOffsetsValid = false;
+
             m_branchData->sortOrder = sortOrder;
         }
 
@@ -2092,6 +2301,8 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
 
     m_editorRenderer = NULL;
 
+    m_bestWidthMode = wxDATAVIEW_BEST_WIDTH_DEFAULT;
+
     m_lastOnSame = false;
     m_renameTimer = new wxDataViewRenameTimer( this );
 
@@ -3047,63 +3258,6 @@ void wxDataViewHeaderWindow::FinishEditing()
     win->FinishEditing();
 }
 
-//-----------------------------------------------------------------------------
-// Helper class for do operation on the tree node
-//-----------------------------------------------------------------------------
-
-namespace
-{
-
-class DoJob
-{
-public:
-    DoJob() { }
-    virtual ~DoJob() { }
-
-    // The return value control how the tree-walker tranverse the tree
-    enum
-    {
-        DONE,          // Job done, stop traversing and return
-        SKIP_SUBTREE,  // Ignore the current node's subtree and continue
-        CONTINUE       // Job not done, continue
-    };
-
-    virtual int operator() ( wxDataViewTreeNode * node ) = 0;
-};
-
-bool
-Walker(wxDataViewTreeNode * node, DoJob & func, WalkFlags flags = Walk_All)
-{
-    wxCHECK_MSG( node, false, "can't walk NULL node" );
-
-    switch( func( node ) )
-    {
-        case DoJob::DONE:
-            return true;
-        case DoJob::SKIP_SUBTREE:
-            return false;
-        case DoJob::CONTINUE:
-            break;
-    }
-
-    if ( node->HasChildren() && (flags != Walk_ExpandedOnly || node->IsOpen()) )
-    {
-        const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-
-        for ( wxDataViewTreeNodes::const_iterator i = nodes.begin();
-              i != nodes.end();
-              ++i )
-        {
-            if ( Walker(*i, func, flags) )
-                return true;
-        }
-    }
-
-    return false;
-}
-
-} // anonymous namespace
-
 bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxDataViewItem & item)
 {
     if (IsVirtualList())
@@ -3213,7 +3367,10 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
 
     m_selection.OnItemsInserted(GetRowByItem(item), 1);
 
-    GetOwner()->InvalidateColBestWidths();
+    if ( m_bestWidthMode == wxDATAVIEW_BEST_WIDTH_DEFAULT )
+        GetOwner()->InvalidateColBestWidths();
+    else
+        UpdateBestWidthsForItem(item, wxNOT_FOUND);
     UpdateDisplay();
 
     return true;
@@ -3254,18 +3411,10 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
         // removed from the model by the time ItemDeleted() is called, so we
         // have to do it manually. We keep track of its position as well for
         // later use.
-        int itemPosInNode = 0;
-        wxDataViewTreeNode *itemNode = NULL;
-        for ( wxDataViewTreeNodes::const_iterator i = parentsChildren.begin();
-              i != parentsChildren.end();
-              ++i, ++itemPosInNode )
-        {
-            if( (*i)->GetItem() == item )
-            {
-                itemNode = *i;
-                break;
-            }
-        }
+        const int itemPosInNode = parentNode->FindChildByItem(item);
+        wxDataViewTreeNode *itemNode = itemPosInNode == wxNOT_FOUND
+                                        ? NULL
+                                        : parentsChildren[itemPosInNode];
 
         // If the parent wasn't expanded, it's possible that we didn't have a
         // node corresponding to 'item' and so there's nothing left to do.
@@ -3336,7 +3485,18 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     if ( HasCurrentRow() && m_currentRow >= GetRowCount() )
         ChangeCurrentRow(m_count - 1);
 
-    GetOwner()->InvalidateColBestWidths();
+    if ( m_bestWidthMode == wxDATAVIEW_BEST_WIDTH_DEFAULT )
+    {
+        GetOwner()->InvalidateColBestWidths();
+    }
+    else
+    {
+        // We don't make the columns narrower in the other modes, but the rows
+        // being measured in idle time have shifted, so start from scratch to
+        // avoid skipping any of them.
+        for ( size_t n = 0; n < m_bestWidthScans.size(); n++ )
+            m_bestWidthScans[n].nextRow = 0;
+    }
     UpdateDisplay();
 
     return true;
@@ -3369,14 +3529,21 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
     if ( view_column == wxNOT_FOUND )
     {
         column = NULL;
-        GetOwner()->InvalidateColBestWidths();
+        if ( m_bestWidthMode == wxDATAVIEW_BEST_WIDTH_DEFAULT )
+            GetOwner()->InvalidateColBestWidths();
     }
     else
     {
         column = m_owner->GetColumn(view_column);
-        GetOwner()->InvalidateColBestWidth(view_column);
+        if ( m_bestWidthMode == wxDATAVIEW_BEST_WIDTH_DEFAULT )
+            GetOwner()->InvalidateColBestWidth(view_column);
     }
 
+    // In the other modes, measuring all rows again could take too long, so
+    // just take this one into account.
+    if ( m_bestWidthMode != wxDATAVIEW_BEST_WIDTH_DEFAULT )
+        UpdateBestWidthsForItem(item, view_column);
+
     // Update the displayed value(s).
     RefreshRow(GetRowByItem(item));
 
@@ -3867,73 +4034,34 @@ int wxDataViewMainWindow::QueryAndCacheLineHeight(unsigned int row, wxDataViewIt
 }
 
 
-namespace
+wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
 {
+    wxASSERT( !IsVirtualList() );
 
-class RowToTreeNodeJob: public DoJob
-{
-public:
-    // Note that we initialize m_current to -1 because the first node passed to
-    // our operator() will be the root node, which doesn't appear in the window
-    // and so doesn't count as a real row.
-    explicit RowToTreeNodeJob(int row)
-        : m_row(row), m_current(-1), m_ret(NULL)
-    {
-    }
+    if ( row == (unsigned)-1 )
+        return NULL;
 
-    virtual int operator() ( wxDataViewTreeNode * node ) wxOVERRIDE
+    // Descend into the tree, using the subtree counts to find the child
+    // containing the row at each level. The rows are relative to the first
+    // child of the current node.
+    wxDataViewTreeNode* node = m_root;
+    int rel = static_cast<int>(row);
+    for ( ;; )
     {
-        if( m_current == m_row)
-        {
-            m_ret = node;
-            return DoJob::DONE;
-        }
+        if ( !node->HasChildren() )
+            return NULL;
 
-        if( node->GetSubTreeCount() + m_current < m_row )
-        {
-            m_current += node->GetSubTreeCount() + 1;
-            return  DoJob::SKIP_SUBTREE;
-        }
-        else
-        {
-            // If the current node has only leaf children, we can find the
-            // desired node directly. This can speed up finding the node
-            // in some cases, and will have a very good effect for list views.
-            if ( node->HasChildren() &&
-                 (int)node->GetChildNodes().size() == node->GetSubTreeCount() )
-            {
-                const int index = m_row - m_current - 1;
-                m_ret = node->GetChildNodes()[index];
-                return DoJob::DONE;
-            }
+        int offset;
+        const int index = node->FindChildByRow(rel, &offset);
+        if ( index == wxNOT_FOUND )
+            return NULL;
 
-            m_current++;
+        node = node->GetChildNodes()[index];
+        if ( rel == offset )
+            return node;
 
-            return DoJob::CONTINUE;
-        }
+        rel -= offset + 1;
     }
-
-    wxDataViewTreeNode * GetResult() const
-        { return m_ret; }
-
-private:
-    const int m_row;
-    int m_current;
-    wxDataViewTreeNode* m_ret;
-};
-
-} // anonymous namespace
-  //
-wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
-{
-    wxASSERT( !IsVirtualList() );
-
-    if ( row == (unsigned)-1 )
-        return NULL;
-
-    RowToTreeNodeJob job(static_cast<int>(row));
-    Walker( m_root , job );
-    return job.GetResult();
 }
 
 wxDataViewItem wxDataViewMainWindow::GetItemByRow(unsigned int row) const
@@ -4181,27 +4309,18 @@ wxDataViewMainWindow::FindNode( const wxDataViewItem & item )
                 return result;
             }
 
-            const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-            bool found = false;
+            const int index = node->FindChildByItem(parentChain[iter]);
+            if ( index == wxNOT_FOUND )
+                return result;
 
-            for (unsigned i = 0; i < nodes.size(); ++i)
+            wxDataViewTreeNode* currentNode = node->GetChildNodes()[index];
+            if (currentNode->GetItem() == item)
             {
-                wxDataViewTreeNode* currentNode = nodes[i];
-                if (currentNode->GetItem() == parentChain[iter])
-                {
-                    if (currentNode->GetItem() == item)
-                    {
-                        result.m_node = currentNode;
-                        return result;
-                    }
-
-                    node = currentNode;
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
+                result.m_node = currentNode;
                 return result;
+            }
+
+            node = currentNode;
         }
         else
             return result;
@@ -4327,60 +4446,6 @@ int wxDataViewMainWindow::RecalculateCount() const
     }
 }
 
-namespace
-{
-
-class ItemToRowJob : public DoJob
-{
-public:
-    // As with RowToTreeNodeJob above, we initialize m_current to -1 because
-    // the first node passed to our operator() is the root node which is not
-    // visible on screen and so we should return 0 for its first child node and
-    // not for the root itself.
-    ItemToRowJob(const wxDataViewItem& item, wxVector<wxDataViewItem>::reverse_iterator iter)
-        : m_item(item), m_iter(iter), m_current(-1)
-    {
-    }
-
-    // Maybe binary search will help to speed up this process
-    virtual int operator() ( wxDataViewTreeNode * node) wxOVERRIDE
-    {
-        if( node->GetItem() == m_item )
-        {
-            return DoJob::DONE;
-        }
-
-        // Is this node the next (grand)parent of the item we're looking for?
-        if( node->GetItem() == *m_iter )
-        {
-            // Search for the next (grand)parent now and skip this item itself.
-            ++m_iter;
-            ++m_current;
-            return DoJob::CONTINUE;
-        }
-        else
-        {
-            // Skip this node and all its currently visible children.
-            m_current += node->GetSubTreeCount() + 1;
-            return DoJob::SKIP_SUBTREE;
-        }
-
-    }
-
-    int GetResult() const
-        { return m_current; }
-
-private:
-    const wxDataViewItem m_item;
-    wxVector<wxDataViewItem>::reverse_iterator m_iter;
-
-    // The row corresponding to the last node seen in our operator().
-    int m_current;
-
-};
-
-} // anonymous namespace
-
 int
 wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
                                    WalkFlags flags) const
@@ -4407,16 +4472,31 @@ wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
             it = model->GetParent(it);
         }
 
-        // add an 'invalid' item to represent our 'invisible' root node
-        parentChain.push_back(wxDataViewItem());
-
         // the parent chain was created by adding the deepest parent first.
-        // so if we want to start at the root node, we have to iterate backwards through the vector
-        ItemToRowJob job( item, parentChain.rbegin() );
-        if ( !Walker( m_root, job, flags ) )
-            return -1;
+        // so if we want to start at the root node, we have to iterate
+        // backwards through the vector, adding the offset of each node
+        // relative to its parent row.
+        const wxDataViewTreeNode* node = m_root;
+        int row = -1;
+        for ( wxVector<wxDataViewItem>::reverse_iterator iter = parentChain.rbegin();
+              iter != parentChain.rend();
+              ++iter )
+        {
+            if ( !node->HasChildren() )
+                return -1;
+
+            if ( flags == Walk_ExpandedOnly && !node->IsOpen() )
+                return -1;
+
+            const int index = node->FindChildByItem(*iter);
+            if ( index == wxNOT_FOUND )
+                return -1;
 
-        return job.GetResult();
+            row += node->GetChildRowOffset(index) + 1;
+            node = node->GetChildNodes()[index];
+        }
+
+        return row;
     }
 }
 
@@ -6118,8 +6198,24 @@ private:
 };
 
 
+// Number of rows measured in wxDATAVIEW_BEST_WIDTH_SAMPLED mode.
+static const size_t BEST_WIDTH_SAMPLES = 1000;
+
+#if wxUSE_STOPWATCH
+// Time spent measuring the rows in wxDATAVIEW_BEST_WIDTH_FULL mode during a
+// single idle event (in ms).
+static const long BEST_WIDTH_SCAN_TIME = 10;
+#endif // wxUSE_STOPWATCH
+
 unsigned int wxDataViewCtrl::GetBestColumnWidth(int idx) const
 {
+    const wxDataViewBestColumnWidthMode mode = GetBestColumnWidthMode();
+    if ( mode != m_clientArea->GetBestWidthMode() )
+    {
+        const_cast<wxDataViewCtrl*>(this)->InvalidateColBestWidths();
+        m_clientArea->SetBestWidthMode(mode);
+    }
+
     if ( m_colsBestWidths[idx].width != 0 )
         return m_colsBestWidths[idx].width;
 
@@ -6138,9 +6234,46 @@ unsigned int wxDataViewCtrl::GetBestColumnWidth(int idx) const
         calculator.UpdateWithWidth(m_headerArea->GetColumnTitleWidth(*column));
 
     const wxPoint origin = CalcUnscrolledPosition(wxPoint(0, 0));
-    calculator.ComputeBestColumnWidth(count,
-                                      m_clientArea->GetLineAt(origin.y),
-                                      m_clientArea->GetLineAt(origin.y + GetClientSize().y));
+    const unsigned int
+        first_visible = m_clientArea->GetLineAt(origin.y),
+        last_visible = m_clientArea->GetLineAt(origin.y + GetClientSize().y);
+
+    switch ( mode )
+    {
+        case wxDATAVIEW_BEST_WIDTH_DEFAULT:
+            calculator.ComputeBestColumnWidth(count, first_visible, last_visible);
+            break;
+
+        case wxDATAVIEW_BEST_WIDTH_VISIBLE:
+            calculator.ComputeBestColumnWidthOfRows
+                       (
+                        first_visible,
+                        wxMin(last_visible + 1, static_cast<unsigned>(count))
+                       );
+            break;
+
+        case wxDATAVIEW_BEST_WIDTH_SAMPLED:
+            calculator.ComputeSampledColumnWidth(count, BEST_WIDTH_SAMPLES,
+                                                 first_visible,
+                                                 last_visible + 1);
+            break;
+
+        case wxDATAVIEW_BEST_WIDTH_FULL:
+#if wxUSE_STOPWATCH
+            // Use the visible rows for now and measure all the others later.
+            calculator.ComputeBestColumnWidthOfRows
+                       (
+                        first_visible,
+                        wxMin(last_visible + 1, static_cast<unsigned>(count))
+                       );
+
+            if ( first_visible > 0 || last_visible + 1 < static_cast<unsigned>(count) )
+                m_clientArea->StartBestWidthScan(column, calculator.GetMaxWidth());
+#else // !wxUSE_STOPWATCH
+            calculator.ComputeBestColumnWidthOfRows(0, count);
+#endif // wxUSE_STOPWATCH/!wxUSE_STOPWATCH
+            break;
+    }
 
     int max_width = calculator.GetMaxWidth();
     if ( max_width > 0 )
@@ -6150,6 +6283,145 @@ unsigned int wxDataViewCtrl::GetBestColumnWidth(int idx) const
     return max_width;
 }
 
+void
+wxDataViewMainWindow::StartBestWidthScan(const wxDataViewColumn* column,
+                                         int width)
+{
+    CancelBestWidthScans(column);
+
+    BestWidthScan scan;
+    scan.column = column;
+    scan.nextRow = 0;
+    scan.width = width;
+    m_bestWidthScans.push_back(scan);
+
+    wxWakeUpIdle();
+}
+
+void wxDataViewMainWindow::CancelBestWidthScans(const wxDataViewColumn* column)
+{
+    if ( !column )
+    {
+        m_bestWidthScans.clear();
+        return;
+    }
+
+    for ( size_t n = 0; n < m_bestWidthScans.size(); n++ )
+    {
+        if ( m_bestWidthScans[n].column == column )
+        {
+            m_bestWidthScans.erase(m_bestWidthScans.begin() + n);
+            break;
+        }
+    }
+}
+
+void wxDataViewMainWindow::ContinueBestWidthScans()
+{
+#if wxUSE_STOPWATCH
+    if ( m_bestWidthScans.empty() )
+        return;
+
+    // Only measure one column per idle event to keep the UI responsive.
+    BestWidthScan& scan = m_bestWidthScans.back();
+
+    wxDataViewCtrl* const owner = GetOwner();
+    const int idx = owner->GetColumnIndex(scan.column);
+    const unsigned int count = GetRowCount();
+
+    // Also check that the column width wasn't invalidated, which can happen
+    // if the column was deleted and another one was created at the same
+    // address.
+    if ( idx != wxNOT_FOUND && owner->m_colsBestWidths[idx].width != 0 )
+    {
+        wxDataViewColumn* const column = owner->GetColumn(idx);
+        wxDataViewMaxWidthCalculator calculator(owner, this,
+                                                column->GetRenderer(),
+                                                GetModel(),
+                                                column->GetModelColumn(),
+                                                GetRowHeight());
+        calculator.UpdateWithWidth(scan.width);
+
+        scan.nextRow = calculator.ComputeBestColumnWidthInTime(scan.nextRow,
+                                                               count,
+                                                               BEST_WIDTH_SCAN_TIME);
+
+        const int width = calculator.GetMaxWidth();
+        if ( width > scan.width )
+        {
+            scan.width = width;
+
+            wxDataViewCtrl::CachedColWidthInfo& info = owner->m_colsBestWidths[idx];
+            if ( width + 2 * PADDING_RIGHTLEFT > info.width )
+            {
+                info.width = width + 2 * PADDING_RIGHTLEFT;
+                info.dirty = true;
+                owner->m_colsDirty = true;
+            }
+        }
+    }
+    else
+    {
+        scan.nextRow = count;
+    }
+
+    if ( scan.nextRow >= count )
+        m_bestWidthScans.pop_back();
+
+    if ( !m_bestWidthScans.empty() )
+        wxWakeUpIdle();
+#endif // wxUSE_STOPWATCH
+}
+
+void
+wxDataViewMainWindow::UpdateBestWidthsForItem(const wxDataViewItem& item,
+                                              int view_column)
+{
+    const int row = GetRowByItem(item, Walk_ExpandedOnly);
+    if ( row < 0 || static_cast<unsigned>(row) >= GetRowCount() )
+        return;
+
+    wxDataViewCtrl* const owner = GetOwner();
+
+    int first, last;
+    if ( view_column == wxNOT_FOUND )
+    {
+        first = 0;
+        last = owner->m_colsBestWidths.size();
+    }
+    else
+    {
+        first = view_column;
+        last = view_column + 1;
+    }
+
+    for ( int idx = first; idx < last; idx++ )
+    {
+        // Nothing to do if the width will be computed from scratch anyhow.
+        wxDataViewCtrl::CachedColWidthInfo& info = owner->m_colsBestWidths[idx];
+        if ( !info.width )
+            continue;
+
+        wxDataViewColumn* const column = owner->GetColumn(idx);
+        wxDataViewMaxWidthCalculator calculator(owner, this,
+                                                column->GetRenderer(),
+                                                GetModel(),
+                                                column->GetModelColumn(),
+                                                GetRowHeight());
+        calculator.UpdateWithRow(row);
+
+        // Notice that we never make the column narrower, even if this item
+        // was the widest one, as this would require measuring all the rows.
+        const int width = calculator.GetMaxWidth() + 2 * PADDING_RIGHTLEFT;
+        if ( width > info.width )
+        {
+            info.width = width;
+            info.dirty = true;
+            owner->m_colsDirty = true;
+        }
+    }
+}
+
 void wxDataViewCtrl::ColumnMoved(wxDataViewColumn *col, unsigned int new_pos)
 {
     // do _not_ reorder m_cols elements here, they should always be in the
@@ -6208,6 +6480,9 @@ void wxDataViewCtrl::InvalidateColBestWidth(int idx)
     m_colsBestWidths[idx].width = 0;
     m_colsBestWidths[idx].dirty = true;
     m_colsDirty = true;
+
+    if ( m_clientArea )
+        m_clientArea->CancelBestWidthScans(m_cols[idx]);
 }
 
 void wxDataViewCtrl::InvalidateColBestWidths()
@@ -6216,6 +6491,9 @@ void wxDataViewCtrl::InvalidateColBestWidths()
     m_colsBestWidths.clear();
     m_colsBestWidths.resize(m_cols.size());
     m_colsDirty = true;
+
+    if ( m_clientArea )
+        m_clientArea->CancelBestWidthScans();
 }
 
 void wxDataViewCtrl::UpdateColWidths()
@@ -6248,6 +6526,19 @@ void wxDataViewCtrl::OnInternalIdle()
 {
     wxDataViewCtrlBase::OnInternalIdle();
 
+    if ( m_clientArea )
+    {
+        // Update the widths computed using the previous mode if it changed.
+        const wxDataViewBestColumnWidthMode mode = GetBestColumnWidthMode();
+        if ( mode != m_clientArea->GetBestWidthMode() )
+        {
+            InvalidateColBestWidths();
+            m_clientArea->SetBestWidthMode(mode);
+        }
+
+        m_clientArea->ContinueBestWidthScans();
+    }
+
     if ( m_colsDirty )
         UpdateColWidths();
 }
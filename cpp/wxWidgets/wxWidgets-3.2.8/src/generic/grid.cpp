@@ -62,6 +62,14 @@ const char wxGridNameStr[] = "grid";
 WX_DECLARE_HASH_SET_WITH_DECL_PTR(int, wxIntegerHash, wxIntegerEqual,
                                   wxGridFixedIndicesSet, class WXDLLIMPEXP_ADV);
 
+// set of cells, using keys returned by CoordsToKey() defined below
+WX_DECLARE_HASH_SET(wxLongLong_t, wxIntegerHash, wxIntegerEqual,
+                    wxGridCellKeysSet);
+
+// map used to find the leftmost cell in the given row
+WX_DECLARE_HASH_MAP(int, int, wxIntegerHash, wxIntegerEqual,
+                    wxGridRowToColMap);
+
 
 // ----------------------------------------------------------------------------
 // globals
@@ -2286,6 +2294,82 @@ void wxGridCornerLabelWindow::OnMouseWheel( wxMouseEvent& event )
 
 //////////////////////////////////////////////////////////////////////
 
+/* static */
+wxSize wxGridTextExtentCache::GetTextExtent(const wxGrid& grid,
+                                            const wxDC& dc,
+                                            const wxString& line)
+{
+    // Use the cache of the grid window being painted using this DC, if any.
+    wxWindow* const windows[] =
+    {
+        grid.GetGridWindow(),
+        grid.GetFrozenRowGridWindow(),
+        grid.GetFrozenColGridWindow(),
+        grid.GetFrozenCornerGridWindow(),
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(windows); n++ )
+    {
+        if ( !windows[n] )
+            continue;
+
+        wxGridTextExtentCache&
+            cache = static_cast<wxGridWindow*>(windows[n])->GetTextExtentCache();
+        if ( cache.m_dc == &dc )
+            return cache.DoGetTextExtent(dc, line);
+    }
+
+    return dc.GetTextExtent(line);
+}
+
+wxSize wxGridTextExtentCache::DoGetTextExtent(const wxDC& dc,
+                                              const wxString& line)
+{
+    // Don't let the cache grow indefinitely if the grid shows many different
+    // strings, e.g. constantly changing numbers: just start anew when it
+    // becomes too big.
+    static const size_t MAX_EXTENTS_PER_FONT = 4096;
+    static const size_t MAX_FONTS = 8;
+
+    const wxFont& font = dc.GetFont();
+
+    FontExtents* fontExtents = NULL;
+    for ( size_t n = 0; n < m_fonts.size(); n++ )
+    {
+        if ( m_fonts[n].font == font )
+        {
+            fontExtents = &m_fonts[n];
+            break;
+        }
+    }
+
+    if ( !fontExtents )
+    {
+        if ( m_fonts.size() == MAX_FONTS )
+            m_fonts.clear();
+
+        m_fonts.push_back(FontExtents());
+        fontExtents = &m_fonts.back();
+        fontExtents->font = font;
+    }
+
+    wxGridTextExtentsMap& extents = fontExtents->extents;
+
+    const wxGridTextExtentsMap::const_iterator it = extents.find(line);
+    if ( it != extents.end() )
+        return it->second;
+
+    if ( extents.size() == MAX_EXTENTS_PER_FONT )
+        extents.clear();
+
+    const wxSize size = dc.GetTextExtent(line);
+    extents[line] = size;
+
+    return size;
+}
+
+//////////////////////////////////////////////////////////////////////
+
 wxBEGIN_EVENT_TABLE( wxGridWindow, wxGridSubwindow )
     EVT_PAINT( wxGridWindow::OnPaint )
     EVT_MOUSEWHEEL( wxGridWindow::OnMouseWheel )
@@ -2303,6 +2387,8 @@ void wxGridWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
     m_owner->PrepareDCFor( dc, this );
     wxRegion reg = GetUpdateRegion();
 
+    wxGridTextExtentCache::Activator activateCache(m_textExtentCache, dc);
+
     wxGridCellCoordsArray dirtyCells = m_owner->CalcCellsExposed( reg , this );
     m_owner->DrawGridCellArea( dc, dirtyCells );
 
@@ -3812,9 +3898,12 @@ wxGridCellCoordsArray wxGrid::CalcCellsExposed( const wxRegion& reg,
 
     wxGridCellCoordsArray  cellsExposed;
 
+    int numRects = 0;
     int left, top, right, bottom;
     for ( wxRegionIterator iter(reg); iter; ++iter )
     {
+        numRects++;
+
         r = iter.GetRect();
         r.Offset(GetGridWindowOffset(gridWindow));
 
@@ -3882,6 +3971,27 @@ wxGridCellCoordsArray wxGrid::CalcCellsExposed( const wxRegion& reg,
         }
     }
 
+    // The same cell can intersect several rectangles of a complex region, e.g.
+    // the one resulting from refreshing several cells, don't return it (and
+    // hence draw it) more than once in this case.
+    if ( numRects > 1 )
+    {
+        wxGridCellCoordsArray cellsUnique;
+        wxGridCellKeysSet cellsSeen;
+
+        const size_t count = cellsExposed.size();
+        for ( size_t n = 0; n < count; n++ )
+        {
+            const wxGridCellCoords& cell = cellsExposed[n];
+            if ( cellsSeen.insert(CoordsToKey(cell.GetRow(),
+                                              cell.GetCol())).second )
+                cellsUnique.Add(cell);
+        }
+
+        if ( cellsUnique.size() != count )
+            cellsExposed = cellsUnique;
+    }
+
     return cellsExposed;
 }
 
@@ -5883,6 +5993,15 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
 {
     InitPixelFields();
 
+    // The text extents are going to change too.
+    m_gridWin->GetTextExtentCache().Clear();
+    if ( m_frozenRowGridWin )
+        m_frozenRowGridWin->GetTextExtentCache().Clear();
+    if ( m_frozenColGridWin )
+        m_frozenColGridWin->GetTextExtentCache().Clear();
+    if ( m_frozenCornerGridWin )
+        m_frozenCornerGridWin->GetTextExtentCache().Clear();
+
     // If we have any non-default row sizes, we need to scale them (default
     // ones will be scaled due to the reinitialization of m_defaultRowHeight
     // inside InitPixelFields() above).
@@ -6467,6 +6586,40 @@ bool wxGrid::SetCurrentCell( const wxGridCellCoords& coords )
     return true;
 }
 
+namespace
+{
+
+// Helper of DrawGridCellArea(): adds the cell to redrawCells unless it is
+// already going to be drawn, i.e. is either in cells or in redrawCells. The
+// markedCells set is used to check for this and redrawLeftCols is updated to
+// contain the leftmost column of the cells in redrawCells in each row.
+void AddCellToRedraw(const wxGridCellCoords& cell,
+                     const wxGridCellCoordsArray& cells,
+                     wxGridCellKeysSet& markedCells,
+                     wxGridCellCoordsArray& redrawCells,
+                     wxGridRowToColMap& redrawLeftCols)
+{
+    if ( markedCells.empty() )
+    {
+        const size_t count = cells.size();
+        for ( size_t n = 0; n < count; n++ )
+            markedCells.insert(CoordsToKey(cells[n].GetRow(), cells[n].GetCol()));
+    }
+
+    if ( !markedCells.insert(CoordsToKey(cell.GetRow(), cell.GetCol())).second )
+        return;
+
+    redrawCells.Add(cell);
+
+    const wxGridRowToColMap::iterator it = redrawLeftCols.find(cell.GetRow());
+    if ( it == redrawLeftCols.end() )
+        redrawLeftCols[cell.GetRow()] = cell.GetCol();
+    else if ( cell.GetCol() < it->second )
+        it->second = cell.GetCol();
+}
+
+} // anonymous namespace
+
 // Note - this function only draws cells that are in the list of
 // exposed cells (usually set from the update region by
 // CalcExposedCells)
@@ -6479,6 +6632,14 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
     int i, numCells = cells.GetCount();
     wxGridCellCoordsArray redrawCells;
 
+    // Keys of all cells in either cells or redrawCells array: this set is
+    // only filled when it's needed, i.e. when there are any cells spanning
+    // or overflowing into others, to avoid searching both arrays.
+    wxGridCellKeysSet markedCells;
+
+    // The leftmost column of the cells in redrawCells in the given row.
+    wxGridRowToColMap redrawLeftCols;
+
     for ( i = numCells - 1; i >= 0; i-- )
     {
         int row, col, cell_rows, cell_cols;
@@ -6489,31 +6650,8 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
         if ( GetCellSize( row, col, &cell_rows, &cell_cols ) == CellSpan_Inside )
         {
             wxGridCellCoords cell( row + cell_rows, col + cell_cols );
-            bool marked = false;
-            for ( int j = 0; j < numCells; j++ )
-            {
-                if ( cell == cells[j] )
-                {
-                    marked = true;
-                    break;
-                }
-            }
-
-            if (!marked)
-            {
-                int count = redrawCells.GetCount();
-                for (int j = 0; j < count; j++)
-                {
-                    if ( cell == redrawCells[j] )
-                    {
-                        marked = true;
-                        break;
-                    }
-                }
-
-                if (!marked)
-                    redrawCells.Add( cell );
-            }
+            AddCellToRedraw(cell, cells, markedCells,
+                            redrawCells, redrawLeftCols);
 
             // don't bother drawing this cell
             continue;
@@ -6526,12 +6664,10 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
             {
                 // find a cell in this row to leave already marked for repaint
                 int left = col;
-                for (int k = 0; k < int(redrawCells.GetCount()); k++)
-                    if ((redrawCells[k].GetCol() < left) &&
-                        (redrawCells[k].GetRow() == row))
-                    {
-                        left = redrawCells[k].GetCol();
-                    }
+                const wxGridRowToColMap::const_iterator
+                    itLeft = redrawLeftCols.find(row);
+                if ( itLeft != redrawLeftCols.end() && itLeft->second < left )
+                    left = itLeft->second;
 
                 if (left == col)
                     left = 0; // oh well
@@ -6551,31 +6687,8 @@ void wxGrid::DrawGridCellArea( wxDC& dc, const wxGridCellCoordsArray& cells )
                         if ( attr->CanOverflow() )
                         {
                             wxGridCellCoords cell(row + l, j);
-                            bool marked = false;
-
-                            for (int k = 0; k < numCells; k++)
-                            {
-                                if ( cell == cells[k] )
-                                {
-                                    marked = true;
-                                    break;
-                                }
-                            }
-
-                            if (!marked)
-                            {
-                                int count = redrawCells.GetCount();
-                                for (int k = 0; k < count; k++)
-                                {
-                                    if ( cell == redrawCells[k] )
-                                    {
-                                        marked = true;
-                                        break;
-                                    }
-                                }
-                                if (!marked)
-                                    redrawCells.Add( cell );
-                            }
+                            AddCellToRedraw(cell, cells, markedCells,
+                                            redrawCells, redrawLeftCols);
                         }
                         break;
                     }
@@ -7315,13 +7428,31 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
 
     wxDCClipper clip(dc, rect);
 
-    long textWidth,
-         textHeight;
+    // Measure all lines only once, this is the most expensive part of drawing
+    // them. Notice that GetTextExtent() returns 0 for empty lines, but we
+    // still need to account for their height.
+    const size_t nLines = lines.GetCount();
+    wxVector<wxSize> lineSizes(nLines);
 
-    if ( textOrientation == wxHORIZONTAL )
-        GetTextBoxSize( dc, lines, &textWidth, &textHeight );
-    else
-        GetTextBoxSize( dc, lines, &textHeight, &textWidth );
+    long textWidth = 0,
+         textHeight = 0;
+    for ( size_t l = 0; l < nLines; l++ )
+    {
+        if ( lines[l].empty() )
+        {
+            lineSizes[l].y = dc.GetCharHeight();
+        }
+        else
+        {
+            lineSizes[l] = wxGridTextExtentCache::GetTextExtent(*this, dc, lines[l]);
+            textWidth = wxMax(textWidth, lineSizes[l].x);
+        }
+
+        textHeight += lineSizes[l].y;
+    }
+
+    if ( textOrientation != wxHORIZONTAL )
+        wxSwap(textWidth, textHeight);
 
     int x = 0,
         y = 0;
@@ -7351,20 +7482,18 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
     }
 
     // Align each line of a multi-line label
-    size_t nLines = lines.GetCount();
     for ( size_t l = 0; l < nLines; l++ )
     {
         const wxString& line = lines[l];
 
         if ( line.empty() )
         {
-            *(textOrientation == wxHORIZONTAL ? &y : &x) += dc.GetCharHeight();
+            *(textOrientation == wxHORIZONTAL ? &y : &x) += lineSizes[l].y;
             continue;
         }
 
-        wxCoord lineWidth = 0,
-             lineHeight = 0;
-        dc.GetTextExtent(line, &lineWidth, &lineHeight);
+        const wxCoord lineWidth = lineSizes[l].x,
+                      lineHeight = lineSizes[l].y;
 
         switch ( horizAlign )
         {
@@ -7413,13 +7542,29 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
 {
     attr.GetNonDefaultAlignment(&hAlign, &vAlign);
 
-    // This does nothing if there is no need to ellipsize.
+    const wxEllipsizeMode ellipsizeMode = attr.GetFitMode().GetEllipsizeMode();
+    const int maxWidth = rect.GetWidth() - 2 * GRID_TEXT_MARGIN;
+
+    // Avoid calling Ellipsize(), which always measures the text, if we can
+    // check that the text fits using the (possibly cached) extent. Notice
+    // that Ellipsize() also removes trailing spaces, so don't do it if there
+    // are any to keep the same behaviour.
+    if ( ellipsizeMode == wxELLIPSIZE_NONE ||
+            (!text.empty() &&
+             !wxIsspace(text.Last()) &&
+             text.find(wxS('\n')) == wxString::npos &&
+             wxGridTextExtentCache::GetTextExtent(*this, dc, text).x <= maxWidth) )
+    {
+        DrawTextRectangle(dc, text, rect, hAlign, vAlign);
+        return;
+    }
+
     const wxString& ellipsizedText = wxControl::Ellipsize
                                      (
                                          text,
                                          dc,
-                                         attr.GetFitMode().GetEllipsizeMode(),
-                                         rect.GetWidth() - 2 * GRID_TEXT_MARGIN,
+                                         ellipsizeMode,
+                                         maxWidth,
                                          wxELLIPSIZE_FLAGS_NONE
                                      );
 
@@ -7432,6 +7577,14 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
 // TODO: refactor wxTextFile::Read() and reuse the same code from here
 void wxGrid::StringToLines( const wxString& value, wxArrayString& lines ) const
 {
+    // Most cells contain a single line of text, handle this case quickly.
+    if ( value.find_first_of(wxS("\r\n")) == wxString::npos )
+    {
+        if ( !value.empty() )
+            lines.Add( value );
+        return;
+    }
+
     int startPos = 0;
     wxString eol = wxTextFile::GetEOL( wxTextFileType_Unix );
     wxString tVal = wxTextFile::Translate( value, wxTextFileType_Unix );
@@ -7468,7 +7621,6 @@ void wxGrid::GetTextBoxSize( const wxDC& dc,
 {
     wxCoord w = 0;
     wxCoord h = 0;
-    wxCoord lineW = 0, lineH = 0;
 
     size_t i;
     for ( i = 0; i < lines.GetCount(); i++ )
@@ -7481,9 +7633,9 @@ void wxGrid::GetTextBoxSize( const wxDC& dc,
         }
         else
         {
-            dc.GetTextExtent( lines[i], &lineW, &lineH );
-            w = wxMax( w, lineW );
-            h += lineH;
+            const wxSize size = wxGridTextExtentCache::GetTextExtent(*this, dc, lines[i]);
+            w = wxMax( w, size.x );
+            h += size.y;
         }
     }
 
@@ -10818,15 +10970,44 @@ void wxGrid::SetCellValue( int row, int col, const wxString& s )
 
     if ( m_table )
     {
+        // The text of the cells to the left of this one may overflow into it
+        // if it's empty, so remember whether it was.
+        const bool wasEmpty = m_table->IsEmptyCell(row, col);
+
         m_table->SetValue( row, col, s );
         if ( ShouldRefresh() )
         {
-            int dummy;
-            wxRect rect( CellToRect( row, col ) );
-            rect.x = 0;
-            rect.width = m_gridWin->GetClientSize().GetWidth();
-            CalcScrolledPosition(0, rect.y, &dummy, &rect.y);
-            m_gridWin->Refresh( false, &rect );
+            // If the cell is not empty, neither before nor after the change,
+            // the other cells can't overflow into it and only this cell and
+            // the empty cells to its right into which its text could overflow
+            // need to be refreshed, which is important for grids with many
+            // columns updated frequently. In the other cases, including the
+            // cells spanning others or columns being reordered, which would
+            // complicate things too much, just refresh the entire row.
+            int numRows, numCols;
+            if ( !wasEmpty && !m_table->IsEmptyCell(row, col) &&
+                    m_colAt.empty() &&
+                        GetCellSize(row, col, &numRows, &numCols) == CellSpan_None )
+            {
+                int lastCol = col;
+                if ( GetCellOverflow(row, col) )
+                {
+                    while ( lastCol < m_numCols - 1 &&
+                                m_table->IsEmptyCell(row, lastCol + 1) )
+                        lastCol++;
+                }
+
+                RefreshBlock(row, col, row, lastCol);
+            }
+            else
+            {
+                int dummy;
+                wxRect rect( CellToRect( row, col ) );
+                rect.x = 0;
+                rect.width = m_gridWin->GetClientSize().GetWidth();
+                CalcScrolledPosition(0, rect.y, &dummy, &rect.y);
+                m_gridWin->Refresh( false, &rect );
+            }
         }
 
         if ( m_currentCellCoords.GetRow() == row &&
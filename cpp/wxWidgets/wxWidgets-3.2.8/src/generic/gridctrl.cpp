@@ -216,7 +216,7 @@ wxSize wxGridCellDateRenderer::GetBestSize(wxGrid& grid,
                                            wxDC& dc,
                                            int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 wxSize wxGridCellDateRenderer::GetMaxBestSize(wxGrid& WXUNUSED(grid),
@@ -355,7 +355,7 @@ wxSize wxGridCellEnumRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 // ----------------------------------------------------------------------------
@@ -610,12 +610,27 @@ wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
     return dc.GetMultiLineTextExtent(text);
 }
 
+wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGrid& grid,
+                                               const wxGridCellAttr& attr,
+                                               wxDC& dc,
+                                               const wxString& text)
+{
+    dc.SetFont(attr.GetFont());
+
+    // This is called for every cell which can overflow when drawing it, so
+    // use the cached extent for the common case of single line text.
+    if ( !text.empty() && text.find(wxS('\n')) == wxString::npos )
+        return wxGridTextExtentCache::GetTextExtent(grid, dc, text);
+
+    return dc.GetMultiLineTextExtent(text);
+}
+
 wxSize wxGridCellStringRenderer::GetBestSize(wxGrid& grid,
                                              wxGridCellAttr& attr,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, grid.GetCellValue(row, col));
+    return DoGetBestSize(grid, attr, dc, grid.GetCellValue(row, col));
 }
 
 void wxGridCellStringRenderer::Draw(wxGrid& grid,
@@ -762,7 +777,7 @@ wxSize wxGridCellNumberRenderer::GetBestSize(wxGrid& grid,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 wxSize wxGridCellNumberRenderer::GetMaxBestSize(wxGrid& WXUNUSED(grid),
@@ -891,7 +906,7 @@ wxSize wxGridCellFloatRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 void wxGridCellFloatRenderer::SetParameters(const wxString& params)
@@ -35,6 +35,7 @@
 
 #include "wx/imaglist.h"
 #include "wx/renderer.h"
+#include "wx/threadpool.h"
 
 #include "wx/generic/private/drawbitmap.h"
 #include "wx/generic/private/listctrl.h"
@@ -945,6 +946,304 @@ void wxListLineData::ReverseHighlight( void )
     Highlight(!IsHighlighted());
 }
 
+//-----------------------------------------------------------------------------
+//  wxListSearchIndex
+//-----------------------------------------------------------------------------
+
+// Minimal number of the appended items to accumulate before adding them to
+// the sorted array, see wxListSearchIndex::OnItemInserted().
+static const size_t SEARCH_INDEX_MIN_PENDING = 64;
+
+// Maximal number of linear time updates of the index between its uses.
+static const unsigned SEARCH_INDEX_MAX_UPDATES = 32;
+
+void wxListSearchIndex::Invalidate()
+{
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+        delete m_entries[n].key;
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+        delete m_pending[n].key;
+
+    m_entries.clear();
+    m_pending.clear();
+    m_updates = 0;
+    m_valid = false;
+}
+
+void wxListSearchIndex::Build(const wxListLineDataArray& lines, int col)
+{
+    Invalidate();
+
+    const size_t count = lines.size();
+    m_entries.reserve(count);
+    for ( size_t row = 0; row < count; row++ )
+    {
+        Entry entry;
+        entry.key = new wxString(Fold(lines[row]->GetText(col)));
+        entry.row = row;
+        m_entries.push_back(entry);
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(), EntryLess());
+
+    m_valid = true;
+}
+
+size_t wxListSearchIndex::FindEntry(size_t row, const wxString& folded) const
+{
+    Entry entry;
+    entry.key = &folded;
+    entry.row = row;
+
+    return std::lower_bound(m_entries.begin(), m_entries.end(),
+                            entry, EntryLess()) - m_entries.begin();
+}
+
+size_t wxListSearchIndex::FindPending(size_t row) const
+{
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+    {
+        if ( m_pending[n].row == row )
+            return n;
+    }
+
+    return (size_t)-1;
+}
+
+void wxListSearchIndex::MergePending()
+{
+    if ( m_pending.empty() )
+        return;
+
+    std::sort(m_pending.begin(), m_pending.end(), EntryLess());
+
+    const size_t count = m_entries.size();
+    m_entries.reserve(count + m_pending.size());
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+        m_entries.push_back(m_pending[n]);
+    m_pending.clear();
+
+    std::inplace_merge(m_entries.begin(), m_entries.begin() + count,
+                       m_entries.end(), EntryLess());
+}
+
+void wxListSearchIndex::ShiftRows(size_t row, int delta)
+{
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+    {
+        if ( m_entries[n].row >= row )
+            m_entries[n].row += delta;
+    }
+
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+    {
+        if ( m_pending[n].row >= row )
+            m_pending[n].row += delta;
+    }
+}
+
+bool wxListSearchIndex::CanUpdate()
+{
+    if ( ++m_updates > SEARCH_INDEX_MAX_UPDATES )
+    {
+        Invalidate();
+        return false;
+    }
+
+    return true;
+}
+
+void wxListSearchIndex::OnItemInserted(size_t row, const wxString& text)
+{
+    wxASSERT_MSG( m_valid, "updating invalid search index" );
+
+    // Appending items is by far the most common case, so optimize it by
+    // accumulating the new entries and merging them with the existing ones
+    // only once there are enough of them, see Find() for the other half of
+    // this optimization.
+    const bool append = row == m_entries.size() + m_pending.size();
+    if ( !append && !CanUpdate() )
+        return;
+
+    Entry entry;
+    entry.key = new wxString(Fold(text));
+    entry.row = row;
+
+    if ( append )
+    {
+        m_pending.push_back(entry);
+
+        const size_t pending = m_pending.size();
+        if ( pending > SEARCH_INDEX_MIN_PENDING &&
+                pending*pending > m_entries.size() )
+            MergePending();
+    }
+    else
+    {
+        ShiftRows(row, 1);
+        m_entries.insert(m_entries.begin() + FindEntry(row, *entry.key), entry);
+    }
+}
+
+void wxListSearchIndex::OnItemDeleted(size_t row, const wxString& text)
+{
+    wxASSERT_MSG( m_valid, "updating invalid search index" );
+
+    const bool last = row == m_entries.size() + m_pending.size() - 1;
+
+    const size_t pos = FindPending(row);
+    if ( pos != (size_t)-1 )
+    {
+        delete m_pending[pos].key;
+        m_pending.erase(m_pending.begin() + pos);
+    }
+    else
+    {
+        if ( !CanUpdate() )
+            return;
+
+        const size_t n = FindEntry(row, Fold(text));
+        wxCHECK_RET( n < m_entries.size() && m_entries[n].row == row,
+                     "item not found in search index" );
+
+        delete m_entries[n].key;
+        m_entries.erase(m_entries.begin() + n);
+    }
+
+    if ( !last && CanUpdate() )
+        ShiftRows(row + 1, -1);
+}
+
+void wxListSearchIndex::OnItemChanged(size_t row,
+                                      const wxString& textOld,
+                                      const wxString& textNew)
+{
+    wxASSERT_MSG( m_valid, "updating invalid search index" );
+
+    const wxString foldedNew = Fold(textNew);
+
+    const size_t pos = FindPending(row);
+    if ( pos != (size_t)-1 )
+    {
+        delete m_pending[pos].key;
+        m_pending[pos].key = new wxString(foldedNew);
+        return;
+    }
+
+    const wxString foldedOld = Fold(textOld);
+    if ( foldedNew == foldedOld || !CanUpdate() )
+        return;
+
+    const size_t n = FindEntry(row, foldedOld);
+    wxCHECK_RET( n < m_entries.size() && m_entries[n].row == row,
+                 "item not found in search index" );
+
+    Entry entry = m_entries[n];
+    m_entries.erase(m_entries.begin() + n);
+
+    delete entry.key;
+    entry.key = new wxString(foldedNew);
+    m_entries.insert(m_entries.begin() + FindEntry(row, foldedNew), entry);
+}
+
+void wxListSearchIndex::OnItemsReordered(const wxVector<size_t>& rows)
+{
+    wxASSERT_MSG( m_valid, "updating invalid search index" );
+
+    MergePending();
+
+    wxCHECK_RET( rows.size() == m_entries.size(), "wrong number of rows" );
+
+    wxVector<size_t> newRows(rows.size());
+    for ( size_t n = 0; n < rows.size(); n++ )
+        newRows[rows[n]] = n;
+
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+        m_entries[n].row = newRows[m_entries[n].row];
+
+    // The entries with the same keys need to be sorted by their new rows,
+    // but we don't need to compute the keys again.
+    std::sort(m_entries.begin(), m_entries.end(), EntryLess());
+}
+
+size_t
+wxListSearchIndex::Find(size_t start, const wxString& folded, bool partial) const
+{
+    size_t found = (size_t)-1;
+
+    if ( !partial )
+    {
+        // As the entries with the same key are sorted by their rows, the
+        // first one at or after the given row is found directly.
+        const size_t n = FindEntry(start, folded);
+        if ( n < m_entries.size() && *m_entries[n].key == folded )
+            found = m_entries[n].row;
+    }
+    else
+    {
+        // All the keys starting with the given string follow it.
+        for ( size_t n = FindEntry(0, folded);
+              n < m_entries.size() && m_entries[n].key->StartsWith(folded);
+              n++ )
+        {
+            const size_t row = m_entries[n].row;
+            if ( row >= start && row < found )
+            {
+                found = row;
+                if ( found == start )
+                    return found;
+            }
+        }
+    }
+
+    for ( size_t n = 0; n < m_pending.size(); n++ )
+    {
+        const Entry& entry = m_pending[n];
+        if ( entry.row < start || entry.row >= found )
+            continue;
+
+        if ( partial ? entry.key->StartsWith(folded) : *entry.key == folded )
+            found = entry.row;
+    }
+
+    return found;
+}
+
+void wxListSearchIndex::GetSortedRows(wxVector<size_t>& rows, bool ascending)
+{
+    wxASSERT_MSG( m_valid, "using invalid search index" );
+
+    MergePending();
+
+    rows.clear();
+    rows.reserve(m_entries.size());
+
+    if ( ascending )
+    {
+        for ( size_t n = 0; n < m_entries.size(); n++ )
+            rows.push_back(m_entries[n].row);
+
+        return;
+    }
+
+    // Take the groups of entries with the same key in the reverse order, but
+    // preserve the order of the entries inside each group.
+    size_t end = m_entries.size();
+    while ( end > 0 )
+    {
+        const wxString& key = *m_entries[end - 1].key;
+
+        size_t start = end - 1;
+        while ( start > 0 && *m_entries[start - 1].key == key )
+            start--;
+
+        for ( size_t n = start; n < end; n++ )
+            rows.push_back(m_entries[n].row);
+
+        end = start;
+    }
+}
+
 //-----------------------------------------------------------------------------
 //  wxListHeaderWindow
 //-----------------------------------------------------------------------------
@@ -1656,6 +1955,9 @@ wxListMainWindow::~wxListMainWindow()
     WX_CLEAR_LIST(wxListHeaderDataList, m_columns);
     WX_CLEAR_ARRAY(m_aColWidths);
 
+    for ( size_t n = 0; n < m_searchIndices.size(); n++ )
+        delete m_searchIndices[n];
+
     delete m_highlightBrush;
     delete m_highlightUnfocusedBrush;
     delete m_renameTimer;
@@ -3576,8 +3878,24 @@ void wxListMainWindow::SetItem( wxListItem &item )
     if ( !IsVirtual() )
     {
         wxListLineData *line = GetLine((size_t)id);
+
+        wxListSearchIndex* index = NULL;
+        wxString textOld;
+        if ( (item.m_mask & wxLIST_MASK_TEXT) &&
+                (size_t)item.m_col < m_searchIndices.size() )
+        {
+            index = m_searchIndices[item.m_col];
+            if ( index && index->IsValid() )
+                textOld = line->GetText(item.m_col);
+            else
+                index = NULL;
+        }
+
         line->SetItem( item.m_col, item );
 
+        if ( index )
+            index->OnItemChanged(id, textOld, item.m_text);
+
         // Set item state if user wants
         if ( item.m_mask & wxLIST_MASK_STATE )
             SetItemState( item.m_itemId, item.m_state, item.m_state );
@@ -4364,6 +4682,13 @@ void wxListMainWindow::DeleteItem( long lindex )
         if ( m_lines[index]->IsHighlighted() )
             UpdateSelectionCount(false);
 
+        for ( size_t col = 0; col < m_searchIndices.size(); col++ )
+        {
+            wxListSearchIndex* const searchIndex = m_searchIndices[col];
+            if ( searchIndex && searchIndex->IsValid() )
+                searchIndex->OnItemDeleted(index, m_lines[index]->GetText(col));
+        }
+
         delete m_lines[index];
         m_lines.erase( m_lines.begin() + index );
     }
@@ -4391,6 +4716,12 @@ void wxListMainWindow::DeleteColumn( int col )
     delete node->GetData();
     m_columns.Erase( node );
 
+    if ( (size_t)col < m_searchIndices.size() )
+    {
+        delete m_searchIndices[col];
+        m_searchIndices.erase(m_searchIndices.begin() + col);
+    }
+
     if ( !IsVirtual() )
     {
         // update all the items
@@ -4466,6 +4797,8 @@ void wxListMainWindow::DoDeleteAllItems()
         ResetVisibleLinesRange();
 
     m_lines.Clear();
+
+    InvalidateSearchIndices();
 }
 
 void wxListMainWindow::DeleteAllItems()
@@ -4501,20 +4834,35 @@ void wxListMainWindow::EnsureVisible( long index )
 }
 
 long wxListMainWindow::FindItem(long start, const wxString& str, bool partial )
+{
+    return FindItemInColumn(start, 0, str, partial);
+}
+
+long
+wxListMainWindow::FindItemInColumn(long start,
+                                   int col,
+                                   const wxString& str,
+                                   bool partial)
 {
     if (str.empty())
         return wxNOT_FOUND;
 
     long pos = start;
-    wxString str_upper = str.Upper();
+    wxString str_upper = wxListSearchIndex::Fold(str);
     if (pos < 0)
         pos = 0;
 
+    if ( wxListSearchIndex* const index = GetSearchIndex(col) )
+    {
+        const size_t found = index->Find(pos, str_upper, partial);
+        return found == (size_t)-1 ? wxNOT_FOUND : (long)found;
+    }
+
     size_t count = GetItemCount();
     for ( size_t i = (size_t)pos; i < count; i++ )
     {
         wxListLineData *line = GetLine(i);
-        wxString line_upper = line->GetText(0).Upper();
+        wxString line_upper = wxListSearchIndex::Fold(line->GetText(col));
         if (!partial)
         {
             if (line_upper == str_upper )
@@ -4652,6 +5000,13 @@ void wxListMainWindow::InsertItem( wxListItem &item )
 
     m_lines.insert( m_lines.begin() + id, line );
 
+    for ( size_t col = 0; col < m_searchIndices.size(); col++ )
+    {
+        wxListSearchIndex* const index = m_searchIndices[col];
+        if ( index && index->IsValid() )
+            index->OnItemInserted(id, line->GetText(col));
+    }
+
     m_dirty = true;
 
     // If an item is selected at or below the point of insertion, we need to
@@ -4686,6 +5041,9 @@ long wxListMainWindow::InsertColumn( long col, const wxListItem &item )
             m_columns.Insert( node, column );
             m_aColWidths.Insert( colWidthInfo, col );
             idx = col;
+
+            if ( (size_t)col < m_searchIndices.size() )
+                m_searchIndices.insert(m_searchIndices.begin() + col, NULL);
         }
         else
         {
@@ -4742,29 +5100,169 @@ int wxListMainWindow::GetItemWidthWithImage(wxListItem * item)
 // sorting
 // ----------------------------------------------------------------------------
 
+// Compares the rows of the items using the user-defined function and the data
+// associated with the items, which is retrieved only once for all of them.
 struct wxListLineComparator
 {
-    wxListLineComparator(wxListCtrlCompare& f, wxIntPtr data)
+    wxListLineComparator(wxListCtrlCompare& f,
+                         wxIntPtr data,
+                         const wxVector<wxUIntPtr>& itemData)
         : m_f(f),
-          m_data(data)
+          m_data(data),
+          m_itemData(itemData)
     {
     }
 
-    bool operator()(wxListLineData* const& line1,
-                    wxListLineData* const& line2) const
+    bool operator()(size_t row1, size_t row2) const
     {
-        wxListItem item;
-        line1->GetItem( 0, item );
-        wxUIntPtr data1 = item.m_data;
-        line2->GetItem( 0, item );
-        wxUIntPtr data2 = item.m_data;
-        return m_f(data1, data2, m_data) < 0;
+        return m_f(m_itemData[row1], m_itemData[row2], m_data) < 0;
     }
 
     const wxListCtrlCompare m_f;
     const wxIntPtr          m_data;
+    const wxVector<wxUIntPtr>& m_itemData;
 };
 
+// Compares the rows of the items using their case-folded texts.
+struct wxListTextComparator
+{
+    wxListTextComparator(const wxVector<wxString>& keys, bool ascending)
+        : m_keys(keys),
+          m_ascending(ascending)
+    {
+    }
+
+    bool operator()(size_t row1, size_t row2) const
+    {
+        return m_ascending ? m_keys[row1].compare(m_keys[row2]) < 0
+                           : m_keys[row2].compare(m_keys[row1]) < 0;
+    }
+
+    const wxVector<wxString>& m_keys;
+    const bool m_ascending;
+};
+
+#if wxUSE_THREADS
+
+// Minimal number of items to sort using multiple threads.
+static const size_t PARALLEL_SORT_MIN_ITEMS = 10000;
+
+// Sorts the consecutive runs of the given length in parallel.
+class wxListSortRunsBody : public wxThreadPoolLoopBody
+{
+public:
+    wxListSortRunsBody(size_t* rows,
+                       size_t count,
+                       size_t runLength,
+                       const wxListTextComparator& cmp)
+        : m_rows(rows),
+          m_count(count),
+          m_runLength(runLength),
+          m_cmp(cmp)
+    {
+    }
+
+    virtual void Process(int begin, int end) wxOVERRIDE
+    {
+        for ( int n = begin; n < end; n++ )
+        {
+            const size_t first = n*m_runLength;
+            const size_t last = wxMin(first + m_runLength, m_count);
+            std::stable_sort(m_rows + first, m_rows + last, m_cmp);
+        }
+    }
+
+private:
+    size_t* const m_rows;
+    const size_t m_count;
+    const size_t m_runLength;
+    const wxListTextComparator& m_cmp;
+};
+
+// Merges the pairs of adjacent sorted runs of the given length in parallel.
+class wxListMergeRunsBody : public wxThreadPoolLoopBody
+{
+public:
+    wxListMergeRunsBody(const size_t* src,
+                        size_t* dst,
+                        size_t count,
+                        size_t runLength,
+                        const wxListTextComparator& cmp)
+        : m_src(src),
+          m_dst(dst),
+          m_count(count),
+          m_runLength(runLength),
+          m_cmp(cmp)
+    {
+    }
+
+    virtual void Process(int begin, int end) wxOVERRIDE
+    {
+        for ( int n = begin; n < end; n++ )
+        {
+            const size_t first = 2*n*m_runLength;
+            const size_t middle = wxMin(first + m_runLength, m_count);
+            const size_t last = wxMin(middle + m_runLength, m_count);
+
+            // Notice that std::merge() is stable, i.e. takes the elements
+            // from the first range if they're equal.
+            std::merge(m_src + first, m_src + middle,
+                       m_src + middle, m_src + last,
+                       m_dst + first, m_cmp);
+        }
+    }
+
+private:
+    const size_t* const m_src;
+    size_t* const m_dst;
+    const size_t m_count;
+    const size_t m_runLength;
+    const wxListTextComparator& m_cmp;
+};
+
+#endif // wxUSE_THREADS
+
+// Sort the rows stably, using multiple threads if there are many of them.
+static void
+wxListSortRowsByText(wxVector<size_t>& rows, const wxListTextComparator& cmp)
+{
+    const size_t count = rows.size();
+
+#if wxUSE_THREADS
+    wxThreadPool& pool = wxThreadPool::GetDefault();
+    if ( count >= PARALLEL_SORT_MIN_ITEMS && !pool.IsWorkerThread() )
+    {
+        // Sort one run in each thread, including the current one, and then
+        // merge them pairwise, also in parallel.
+        const size_t numRuns = pool.GetThreadCount() + 1;
+        size_t runLength = (count + numRuns - 1) / numRuns;
+
+        wxListSortRunsBody sortBody(&rows[0], count, runLength, cmp);
+        pool.ParallelFor(0, static_cast<int>((count + runLength - 1) / runLength),
+                         sortBody);
+
+        wxVector<size_t> buffer(count);
+        size_t* src = &rows[0];
+        size_t* dst = &buffer[0];
+        for ( ; runLength < count; runLength *= 2 )
+        {
+            wxListMergeRunsBody mergeBody(src, dst, count, runLength, cmp);
+            const size_t numPairs = (count + 2*runLength - 1) / (2*runLength);
+            pool.ParallelFor(0, static_cast<int>(numPairs), mergeBody);
+
+            wxSwap(src, dst);
+        }
+
+        if ( src != &rows[0] )
+            std::copy(src, src + count, &rows[0]);
+
+        return;
+    }
+#endif // wxUSE_THREADS
+
+    std::stable_sort(rows.begin(), rows.end(), cmp);
+}
+
 void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
 {
     // selections won't make sense any more after sorting the items so reset
@@ -4772,11 +5270,136 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     HighlightAll(false);
     ResetCurrent();
 
-    std::sort(m_lines.begin(), m_lines.end(), wxListLineComparator(fn, data));
+    // don't retrieve the item data again and again during each comparison
+    // and sort the rows instead of the lines themselves to be able to update
+    // the search indices later
+    const size_t count = m_lines.size();
+    wxVector<wxUIntPtr> itemData;
+    wxVector<size_t> rows;
+    itemData.reserve(count);
+    rows.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxListItemDataList::compatibility_iterator
+            node = m_lines[n]->m_items.GetFirst();
+        itemData.push_back(node ? node->GetData()->m_data : 0);
+        rows.push_back(n);
+    }
+
+    // use stable sort to avoid shuffling the items which compare equal
+    std::stable_sort(rows.begin(), rows.end(),
+                     wxListLineComparator(fn, data, itemData));
+
+    ReorderLines(rows);
+}
+
+void wxListMainWindow::SortItemsByText( int col, bool ascending )
+{
+    wxCHECK_RET( !IsVirtual(), wxT("can't be used with virtual control") );
+
+    HighlightAll(false);
+    ResetCurrent();
+
+    wxVector<size_t> rows;
+    if ( wxListSearchIndex* const index = GetSearchIndex(col) )
+    {
+        // the index already has the rows sorted by their texts
+        index->GetSortedRows(rows, ascending);
+    }
+    else
+    {
+        const size_t count = m_lines.size();
+        wxVector<wxString> keys;
+        keys.reserve(count);
+        rows.reserve(count);
+        for ( size_t n = 0; n < count; n++ )
+        {
+            keys.push_back(wxListSearchIndex::Fold(m_lines[n]->GetText(col)));
+            rows.push_back(n);
+        }
+
+        wxListSortRowsByText(rows, wxListTextComparator(keys, ascending));
+    }
+
+    ReorderLines(rows);
+}
+
+void wxListMainWindow::ReorderLines(const wxVector<size_t>& rows)
+{
+    const size_t count = m_lines.size();
+    wxCHECK_RET( rows.size() == count, wxT("wrong number of rows") );
+
+    wxVector<wxListLineData*> lines;
+    lines.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+        lines.push_back(m_lines[rows[n]]);
+
+    for ( size_t n = 0; n < count; n++ )
+        m_lines[n] = lines[n];
+
+    for ( size_t col = 0; col < m_searchIndices.size(); col++ )
+    {
+        wxListSearchIndex* const index = m_searchIndices[col];
+        if ( index && index->IsValid() )
+            index->OnItemsReordered(rows);
+    }
 
     m_dirty = true;
 }
 
+// ----------------------------------------------------------------------------
+// search index
+// ----------------------------------------------------------------------------
+
+void wxListMainWindow::EnableSearchIndex( int col, bool enable )
+{
+    wxCHECK_RET( !IsVirtual(), wxT("can't be used with virtual control") );
+    wxCHECK_RET( col >= 0, wxT("invalid column index") );
+
+    if ( enable )
+    {
+        if ( (size_t)col >= m_searchIndices.size() )
+            m_searchIndices.resize(col + 1, NULL);
+
+        // the index is only built when it's used for the first time
+        if ( !m_searchIndices[col] )
+            m_searchIndices[col] = new wxListSearchIndex;
+    }
+    else if ( (size_t)col < m_searchIndices.size() )
+    {
+        wxDELETE(m_searchIndices[col]);
+    }
+}
+
+bool wxListMainWindow::IsSearchIndexEnabled( int col ) const
+{
+    return col >= 0 && (size_t)col < m_searchIndices.size() &&
+                m_searchIndices[col] != NULL;
+}
+
+wxListSearchIndex *wxListMainWindow::GetSearchIndex(int col) const
+{
+    if ( IsVirtual() || !IsSearchIndexEnabled(col) )
+        return NULL;
+
+    wxListSearchIndex* const index = m_searchIndices[col];
+    if ( index->IsValid() )
+        index->OnUsed();
+    else
+        index->Build(m_lines, col);
+
+    return index;
+}
+
+void wxListMainWindow::InvalidateSearchIndices()
+{
+    for ( size_t col = 0; col < m_searchIndices.size(); col++ )
+    {
+        if ( m_searchIndices[col] )
+            m_searchIndices[col]->Invalidate();
+    }
+}
+
 // ----------------------------------------------------------------------------
 // scrolling
 // ----------------------------------------------------------------------------
@@ -4872,6 +5495,24 @@ wxListMainWindow::PrefixFindItem(size_t idParent,
         itemid += 1;
     }
 
+    // use the index if we have it: notice that it folds the case differently
+    // but this doesn't matter as we only need the match to be case-insensitive
+    if ( wxListSearchIndex* const index = GetSearchIndex(0) )
+    {
+        const wxString folded = wxListSearchIndex::Fold(prefixOrig);
+
+        itemid = index->Find(itemid, folded, true);
+        if ( itemid == (size_t)-1 )
+        {
+            // wrap to the beginning but don't go beyond the starting item
+            itemid = index->Find(0, folded, true);
+            if ( itemid != (size_t)-1 && itemid > idParent )
+                itemid = (size_t)-1;
+        }
+
+        return itemid;
+    }
+
     // look for the item starting with the given prefix after it
     while ( ( itemid < (size_t)GetItemCount() ) &&
             !GetLine(itemid)->GetText(0).Lower().StartsWith(prefix) )
@@ -5544,6 +6185,12 @@ long wxGenericListCtrl::FindItem( long start, const wxString& str, bool partial
     return m_mainWin->FindItem( start, str, partial );
 }
 
+long wxGenericListCtrl::FindItemInColumn( long start, int col,
+                                          const wxString& str, bool partial )
+{
+    return m_mainWin->FindItemInColumn( start, col, str, partial );
+}
+
 long wxGenericListCtrl::FindItem( long start, wxUIntPtr data )
 {
     return m_mainWin->FindItem( start, data );
@@ -5652,6 +6299,22 @@ bool wxGenericListCtrl::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     return true;
 }
 
+bool wxGenericListCtrl::SortItemsByText( int col, bool ascending )
+{
+    m_mainWin->SortItemsByText( col, ascending );
+    return true;
+}
+
+void wxGenericListCtrl::EnableSearchIndex( int col, bool enable )
+{
+    m_mainWin->EnableSearchIndex( col, enable );
+}
+
+bool wxGenericListCtrl::IsSearchIndexEnabled( int col ) const
+{
+    return m_mainWin->IsSearchIndexEnabled( col );
+}
+
 // ----------------------------------------------------------------------------
 // event handlers
 // ----------------------------------------------------------------------------
@@ -399,6 +399,153 @@ IsDescendantOf(const wxGenericTreeItem *parent, const wxGenericTreeItem *item)
     return false;
 }
 
+// check if all rows have the same height which doesn't depend on the items,
+// in which case we don't need to measure them to lay them out
+static bool HasUniformRowHeight(const wxGenericTreeCtrl *tree)
+{
+    return tree->HasFlag(wxTR_UNIFORM_ROW_HEIGHT) &&
+            !tree->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT);
+}
+
+// check if the item is currently shown, i.e. if all its ancestors are expanded
+// (the hidden root is always considered to be expanded)
+static bool
+IsItemShown(const wxGenericTreeCtrl *tree, const wxGenericTreeItem *item)
+{
+    for ( const wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          parent = parent->GetParent() )
+    {
+        if ( !parent->IsExpanded() &&
+                (parent->GetParent() || !tree->HasFlag(wxTR_HIDE_ROOT)) )
+            return false;
+    }
+
+    return true;
+}
+
+// return the last item shown in the subtree of the given one, i.e. either the
+// item itself if it's collapsed or its last shown descendant
+static wxGenericTreeItem *GetLastShownDescendant(wxGenericTreeItem *item)
+{
+    while ( item->IsExpanded() && item->HasChildren() )
+        item = item->GetChildren().Last();
+
+    return item;
+}
+
+// move the item and all its shown descendants vertically by the given amount
+static void OffsetSubtree(wxGenericTreeItem *item, int dy)
+{
+    item->SetY(item->GetY() + dy);
+
+    if ( item->IsExpanded() )
+    {
+        wxArrayGenericTreeItems& children = item->GetChildren();
+        const size_t count = children.GetCount();
+        for ( size_t n = 0; n < count; n++ )
+            OffsetSubtree(children[n], dy);
+    }
+}
+
+// move all the items shown below the subtree of the given item, this is used
+// when the height of this subtree changes to update their positions without
+// laying out the entire tree again
+static void OffsetItemsBelow(wxGenericTreeItem *item, int dy)
+{
+    if ( !dy )
+        return;
+
+    for ( wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          item = parent, parent = parent->GetParent() )
+    {
+        wxArrayGenericTreeItems& siblings = parent->GetChildren();
+        const size_t count = siblings.GetCount();
+        for ( size_t n = siblings.Index(item) + 1; n < count; n++ )
+            OffsetSubtree(siblings[n], dy);
+    }
+}
+
+// return the index of the child whose subtree contains the given vertical
+// position, or 0 if it is above all of them: this relies on the children
+// positions being up to date
+static size_t FindChildAtY(const wxArrayGenericTreeItems& children, int y)
+{
+    // find the first child below the given position using binary search
+    size_t lo = 0,
+           hi = children.GetCount();
+    while ( lo < hi )
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        if ( children[mid]->GetY() <= y )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo ? lo - 1 : 0;
+}
+
+// find the range [first, last) of the children whose subtrees intersect the
+// given vertical range, with the same precondition as FindChildAtY()
+static void GetChildrenInRange(const wxArrayGenericTreeItems& children,
+                               int top,
+                               int bottom,
+                               size_t& first,
+                               size_t& last)
+{
+    first =
+    last = FindChildAtY(children, top);
+
+    const size_t count = children.GetCount();
+    while ( last < count && children[last]->GetY() <= bottom )
+        last++;
+}
+
+// find the range [first, last) of the children of an item which need to be
+// repainted: if their positions are up to date, the ones outside of the update
+// region are skipped and y is set to the position of the first one to paint
+static void GetChildrenToPaint(const wxWindow *win,
+                               const wxDC& dc,
+                               const wxArrayGenericTreeItems& children,
+                               bool upToDate,
+                               size_t& first,
+                               size_t& last,
+                               int& y)
+{
+    first = 0;
+    last = children.GetCount();
+    if ( !upToDate )
+        return;
+
+    const wxRect rect = win->GetUpdateRegion().GetBox();
+    GetChildrenInRange(children,
+                       dc.DeviceToLogicalY(rect.y),
+                       dc.DeviceToLogicalY(rect.GetBottom()),
+                       first, last);
+    y = children[first]->GetY();
+}
+
+// update the right boundary with that of the items shown in the given vertical
+// range in the subtree of the given item, whose positions must be up to date
+static void
+UpdateRightOfItemsInRange(wxGenericTreeItem *item, int top, int bottom, int& right)
+{
+    if ( item->GetX() + item->GetWidth() > right )
+        right = item->GetX() + item->GetWidth();
+
+    if ( !item->IsExpanded() )
+        return;
+
+    wxArrayGenericTreeItems& children = item->GetChildren();
+
+    size_t first, last;
+    GetChildrenInRange(children, top, bottom, first, last);
+    for ( size_t n = first; n < last; n++ )
+        UpdateRightOfItemsInRange(children[n], top, bottom, right);
+}
+
 // -----------------------------------------------------------------------------
 // wxTreeRenameTimer (internal)
 // -----------------------------------------------------------------------------
@@ -756,6 +903,10 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
                 return this;
             }
 
+            // the item may have not been measured yet if the control uses
+            // wxTR_UNIFORM_ROW_HEIGHT
+            CalculateSize(wxConstCast(theCtrl, wxGenericTreeCtrl));
+
             if ((point.x >= m_x) && (point.x <= m_x+m_width))
             {
                 int image_w = -1;
@@ -807,6 +958,20 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
 
     // evaluate children
     size_t count = m_children.GetCount();
+    if ( count && !theCtrl->m_dirty &&
+            !theCtrl->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+    {
+        // the positions are up to date, so only the child whose subtree
+        // contains the point needs to be checked
+        return m_children[FindChildAtY(m_children, point.y)]->HitTest
+               (
+                    point,
+                    theCtrl,
+                    flags,
+                    level + 1
+               );
+    }
+
     for ( size_t n = 0; n < count; n++ )
     {
         wxGenericTreeItem *res = m_children[n]->HitTest( point,
@@ -924,9 +1089,17 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
     else
         m_height += m_height / 10;   // otherwise 10% extra spacing
 
-    if (m_height > control->m_lineHeight)
+    // the height of the rows doesn't depend on the items in the uniform mode
+    if ( m_height > control->m_lineHeight && !HasUniformRowHeight(control) )
+    {
         control->m_lineHeight = m_height;
 
+        // all the rows have this height, so the positions of the items laid
+        // out before are not valid any more
+        if ( !control->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+            control->m_dirty = true;
+    }
+
     m_width = state_w + image_w + m_widthText + 2;
 }
 
@@ -1339,6 +1512,10 @@ bool wxGenericTreeCtrl::SetFont( const wxFont &font )
     if (m_anchor)
         m_anchor->RecursiveResetTextSize();
 
+    // the row height depends on the font in the uniform mode
+    if ( HasUniformRowHeight(this) )
+        m_dirty = true;
+
     return true;
 }
 
@@ -1922,7 +2099,36 @@ void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
     item->Expand();
     if ( !IsFrozen() )
     {
-        CalculatePositions();
+        if ( m_dirty || HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+        {
+            CalculatePositions();
+        }
+        else if ( IsItemShown(this, item) )
+        {
+            // the positions of all the other items are up to date, so only
+            // lay out the new children and move the items below them
+            wxClientDC dc(this);
+            PrepareDC( dc );
+            dc.SetFont( m_normalFont );
+
+            int level = 1;
+            for ( wxGenericTreeItem *parent = item->GetParent();
+                  parent;
+                  parent = parent->GetParent() )
+            {
+                level++;
+            }
+
+            const int yOld = item->GetY() + GetLineHeight(item);
+            int y = yOld;
+            wxArrayGenericTreeItems& children = item->GetChildren();
+            const size_t count = children.GetCount();
+            for ( size_t n = 0; n < count; n++ )
+                CalculateLevel( children[n], dc, level, y );
+
+            OffsetItemsBelow(item, y - yOld);
+        }
+        //else: the item is not shown, so nothing changes on screen
 
         RefreshSubtree(item);
     }
@@ -1961,6 +2167,12 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
     }
 
     ChildrenClosing(item);
+
+    // the positions of the items shown below the collapsed subtree can be
+    // updated without laying out the entire tree in the common case
+    const bool layoutAll = m_dirty || HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT);
+    const int yLast = GetLastShownDescendant(item)->GetY();
+
     item->Collapse();
 
 #if 0  // TODO why should items be collapsed recursively?
@@ -1972,7 +2184,10 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
     }
 #endif
 
-    CalculatePositions();
+    if ( layoutAll )
+        CalculatePositions();
+    else if ( IsItemShown(this, item) )
+        OffsetItemsBelow(item, item->GetY() - yLast);
 
     RefreshSubtree(item);
 
@@ -2780,18 +2995,21 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int count = children.GetCount();
         if (count > 0)
         {
-            int n = 0, oldY;
-            do {
-                oldY = y;
+            const bool upToDate = !m_dirty &&
+                                    !HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT);
+
+            size_t first, last;
+            GetChildrenToPaint(this, dc, children, upToDate, first, last, y);
+            for ( size_t n = first; n < last; n++ )
                 PaintLevel(children[n], dc, 1, y);
-            } while (++n < count);
 
             if ( !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT)
                     && count > 0 )
             {
                 // draw line down to last child
                 origY += GetLineHeight(children[0])>>1;
-                oldY += GetLineHeight(children[n-1])>>1;
+                int oldY = children[count-1]->GetY() +
+                            (GetLineHeight(children[count-1])>>1);
                 dc.DrawLine(3, origY, 3, oldY);
             }
         }
@@ -2919,17 +3137,27 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         int count = children.GetCount();
         if (count > 0)
         {
-            int n = 0, oldY;
+            const bool upToDate = !m_dirty &&
+                                    !HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT);
+
+            size_t first, last;
+            GetChildrenToPaint(this, dc, children, upToDate, first, last, y);
             ++level;
-            do {
-                oldY = y;
+            for ( size_t n = first; n < last; n++ )
                 PaintLevel(children[n], dc, level, y);
-            } while (++n < count);
+
+            // skip the children below the update region too
+            if ( last < (size_t)count )
+            {
+                y = GetLastShownDescendant(children[count-1])->GetY() +
+                        m_lineHeight;
+            }
 
             if (!HasFlag(wxTR_NO_LINES) && count > 0)
             {
                 // draw line down to last child
-                oldY += GetLineHeight(children[n-1])>>1;
+                int oldY = children[count-1]->GetY() +
+                            (GetLineHeight(children[count-1])>>1);
                 if (HasButtons()) y_mid += 5;
 
                 // Only draw the portion of the line that is visible, in case
@@ -3051,6 +3279,20 @@ void wxGenericTreeCtrl::OnPaint( wxPaintEvent &WXUNUSED(event) )
 
     int y = 2;
     PaintLevel( m_anchor, dc, 0, y );
+
+    // the items are only measured when they're painted in the uniform mode,
+    // so make the scrollable area wider if any of them doesn't fit into it
+    if ( HasUniformRowHeight(this) && !m_dirty )
+    {
+        const wxRect rect = GetUpdateRegion().GetBox();
+        const wxPoint top = CalcUnscrolledPosition(rect.GetTopLeft());
+        const wxPoint bottom = CalcUnscrolledPosition(rect.GetBottomLeft());
+
+        int right = 0;
+        UpdateRightOfItemsInRange(m_anchor, top.y, bottom.y, right);
+        if ( right > GetVirtualSize().x )
+            CallAfter(&wxGenericTreeCtrl::AdjustMyScrollbars);
+    }
 }
 
 void wxGenericTreeCtrl::OnSetFocus( wxFocusEvent &event )
@@ -3501,6 +3743,10 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
                 state_w += MARGIN_BETWEEN_IMAGE_AND_TEXT;
         }
 
+        // the item may have not been measured yet if the control uses
+        // wxTR_UNIFORM_ROW_HEIGHT
+        i->CalculateSize(wxConstCast(this, wxGenericTreeCtrl));
+
         rect.x = i->GetX() + state_w + image_w;
         rect.width = i->GetWidth() - state_w - image_w;
 
@@ -4004,7 +4250,10 @@ wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
         goto Recurse;
     }
 
-    item->CalculateSize(this, dc);
+    // the items are only measured when they're shown if their size doesn't
+    // affect the layout
+    if ( !HasUniformRowHeight(this) )
+        item->CalculateSize(this, dc);
 
     // set its position
     item->SetX( x+m_spacing );
@@ -4029,6 +4278,11 @@ void wxGenericTreeCtrl::CalculatePositions()
 {
     if ( !m_anchor ) return;
 
+    // the row height is not updated when measuring the items in this case, so
+    // make sure it takes the current font and images into account
+    if ( HasUniformRowHeight(this) )
+        CalculateLineHeight();
+
     wxClientDC dc(this);
     PrepareDC( dc );
 
@@ -326,6 +326,18 @@ wxHtmlWordCell::wxHtmlWordCell(const wxString& word, const wxDC& dc) : wxHtmlCel
     m_allowLinebreak = true;
 }
 
+wxHtmlWordCell::wxHtmlWordCell(const wxString& word,
+                               wxCoord width, wxCoord height, wxCoord descent)
+    : wxHtmlCell()
+    , m_Word(word)
+{
+    m_Width = width;
+    m_Height = height;
+    m_Descent = descent;
+    SetCanLiveOnPagebreak(false);
+    m_allowLinebreak = true;
+}
+
 void wxHtmlWordCell::SetPreviousWord(wxHtmlWordCell *cell)
 {
     if ( cell && m_Parent == cell->m_Parent &&
@@ -698,11 +710,20 @@ wxHtmlContainerCell::~wxHtmlContainerCell()
 void wxHtmlContainerCell::SetIndent(int i, int what, int units)
 {
     int val = (units == wxHTML_UNITS_PIXELS) ? i : -i;
-    if (what & wxHTML_INDENT_LEFT) m_IndentLeft = val;
-    if (what & wxHTML_INDENT_RIGHT) m_IndentRight = val;
-    if (what & wxHTML_INDENT_TOP) m_IndentTop = val;
-    if (what & wxHTML_INDENT_BOTTOM) m_IndentBottom = val;
-    m_LastLayout = -1;
+    bool changed = false;
+    if ((what & wxHTML_INDENT_LEFT) && m_IndentLeft != val)
+        { m_IndentLeft = val; changed = true; }
+    if ((what & wxHTML_INDENT_RIGHT) && m_IndentRight != val)
+        { m_IndentRight = val; changed = true; }
+    if ((what & wxHTML_INDENT_TOP) && m_IndentTop != val)
+        { m_IndentTop = val; changed = true; }
+    if ((what & wxHTML_INDENT_BOTTOM) && m_IndentBottom != val)
+        { m_IndentBottom = val; changed = true; }
+
+    // Don't discard the cached layout needlessly, this is called every time
+    // the list items are laid out, for example.
+    if (changed)
+        InvalidateLayout();
 }
 
 
@@ -755,10 +776,6 @@ void wxHtmlContainerCell::Layout(int w)
 {
     wxHtmlCell::Layout(w);
 
-    if (m_LastLayout == w)
-        return;
-    m_LastLayout = w;
-
     // VS: Any attempt to layout with negative or zero width leads to hell,
     // but we can't ignore such attempts completely, since it sometimes
     // happen (e.g. when trying how small a table can be), so use at least one
@@ -766,33 +783,42 @@ void wxHtmlContainerCell::Layout(int w)
     if (w < 1)
         w = 1;
 
-    wxHtmlCell *nextCell;
-    long xpos = 0, ypos = m_IndentTop;
-    int xdelta = 0, ybasicpos = 0;
-    int s_width, s_indent;
-    int ysizeup = 0, ysizedown = 0;
-    int MaxLineWidth = 0;
-    int curLineWidth = 0;
-    m_MaxTotalWidth = 0;
-
-
     /*
 
     WIDTH ADJUSTING :
 
     */
 
+    int width;
     if (m_WidthFloatUnits == wxHTML_UNITS_PERCENT)
     {
-        if (m_WidthFloat < 0) m_Width = (100 + m_WidthFloat) * w / 100;
-        else m_Width = m_WidthFloat * w / 100;
+        if (m_WidthFloat < 0) width = (100 + m_WidthFloat) * w / 100;
+        else width = m_WidthFloat * w / 100;
     }
     else
     {
-        if (m_WidthFloat < 0) m_Width = w + m_WidthFloat;
-        else m_Width = m_WidthFloat;
+        if (m_WidthFloat < 0) width = w + m_WidthFloat;
+        else width = m_WidthFloat;
     }
 
+    // The layout of the contents depends only on our own width, so there is
+    // nothing to do if it didn't change since the last time, even if the
+    // width of the parent did (this is always the case for the containers of
+    // fixed width).
+    if (m_LastLayout == width && width != -1)
+        return;
+    m_LastLayout = width;
+    m_Width = width;
+
+    wxHtmlCell *nextCell;
+    long xpos = 0, ypos = m_IndentTop;
+    int xdelta = 0, ybasicpos = 0;
+    int s_width, s_indent;
+    int ysizeup = 0, ysizedown = 0;
+    int MaxLineWidth = 0;
+    int curLineWidth = 0;
+    m_MaxTotalWidth = 0;
+
     if (m_Cells)
     {
         int l = (m_IndentLeft < 0) ? (-m_IndentLeft * m_Width / 100) : m_IndentLeft;
@@ -1195,7 +1221,7 @@ void wxHtmlContainerCell::InsertCell(wxHtmlCell *f)
         if (m_LastCell) while (m_LastCell->GetNext()) m_LastCell = m_LastCell->GetNext();
     }
     f->SetParent(this);
-    m_LastLayout = -1;
+    InvalidateLayout();
 }
 
 
@@ -1233,6 +1259,16 @@ void wxHtmlContainerCell::Detach(wxHtmlCell *cell)
 
     cell->SetParent(NULL);
     cell->SetNext(NULL);
+
+    InvalidateLayout();
+}
+
+void wxHtmlContainerCell::InvalidateLayout()
+{
+    // Changing the contents of this container may change its size and hence
+    // the layout of all the containers containing it.
+    for ( wxHtmlContainerCell* cont = this; cont; cont = cont->GetParent() )
+        cont->m_LastLayout = -1;
 }
 
 
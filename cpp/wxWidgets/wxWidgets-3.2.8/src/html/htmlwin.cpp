@@ -517,6 +517,34 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
 
 bool wxHtmlWindow::AppendToPage(const wxString& source)
 {
+    // If there are no processors which could need to process the whole page,
+    // try to parse just the new source and add it to the existing cells,
+    // which is much faster than parsing the entire page again for long pages.
+    const bool hasProcessors = (m_Processors && !m_Processors->empty()) ||
+                               (m_GlobalProcessors && !m_GlobalProcessors->empty());
+    if ( m_Cell && !hasProcessors )
+    {
+        wxClientDC dc(this);
+        dc.SetMapMode(wxMM_TEXT);
+
+        double pixelScale = 1.0;
+#ifndef wxHAS_DPI_INDEPENDENT_PIXELS
+        pixelScale = GetDPIScaleFactor();
+#endif
+
+        m_Parser->SetDC(&dc, pixelScale, 1.0);
+        const bool appended = m_Parser->AppendToProduct(source, m_Cell);
+        m_Parser->SetDC(NULL);
+
+        if ( appended )
+        {
+            CreateLayout();
+            if (m_tmpCanDrawLocks == 0)
+                Refresh();
+            return true;
+        }
+    }
+
     return DoSetPage(*(GetParser()->GetSource()) + source);
 }
 
@@ -14,6 +14,7 @@
 #ifndef WX_PRECOMP
     #include "wx/intl.h"
     #include "wx/dc.h"
+    #include "wx/hashmap.h"
     #include "wx/log.h"
     #include "wx/settings.h"
 #endif
@@ -23,7 +24,443 @@
 #include "wx/html/htmlwin.h"
 #include "wx/html/styleparams.h"
 #include "wx/fontmap.h"
+#include "wx/thread.h"
+#include "wx/tls.h"
 #include "wx/uri.h"
+#include "wx/vector.h"
+
+
+//-----------------------------------------------------------------------------
+// wxHtmlWinParserData
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// Extent of a word, as returned by wxDC::GetTextExtent().
+struct wxHtmlWordExtent
+{
+    wxCoord width, height, descent;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxHtmlWordExtent, wxHtmlWordExtentsHash);
+
+// Extents of all the words measured using the given font: we keep a copy of
+// the font itself to ensure that its data, whose address is used to identify
+// it, remains alive as long as the extents are cached.
+struct wxHtmlFontWordExtents
+{
+    wxFont font;
+    wxHtmlWordExtentsHash extents;
+};
+
+// Vertical indents of a container, before RemoveExtraSpacing() was called.
+struct wxHtmlContainerSpacing
+{
+    wxHtmlContainerCell *cell;
+    int top, bottom;
+};
+
+// Parser state at the end of the last parsed document, used to resume parsing
+// from it in AppendToProduct().
+struct wxHtmlWinParserState
+{
+    wxHtmlWinParserState() { product = NULL; }
+
+    wxHtmlContainerCell *product, *container, *trailing;
+    wxVector<wxHtmlContainerSpacing> spacing;
+
+    double pixelScale, fontScale;
+    int fontBold, fontItalic, fontUnderlined, fontFixed, fontSize;
+    wxColour linkColor, actualColor, actualBackgroundColor;
+    int actualBackgroundMode;
+    wxHtmlLinkInfo link;
+    bool useLink;
+    int align;
+    wxHtmlScriptMode scriptMode;
+    long scriptBaseline;
+    wxHtmlWinParser::WhitespaceMode whitespaceMode;
+    bool lastWasSpace;
+    wxHtmlWordCell *lastWordCell;
+    int posColumn;
+    bool endsInComment;
+#if !wxUSE_UNICODE
+    wxFontEncoding inputEncoding;
+#endif
+};
+
+class wxHtmlWinParserData;
+
+// The parser currently parsing a document in this thread and its data.
+struct wxHtmlActiveParser
+{
+    wxHtmlWinParser *parser;
+    wxHtmlWinParserData *data;
+};
+
+// Data associated with a wxHtmlWinParser which can't be stored in the object
+// itself without breaking ABI compatibility.
+class wxHtmlWinParserData
+{
+public:
+    wxHtmlWinParserData()
+    {
+        m_dcChanged = true;
+        m_lastFontExtents = NULL;
+        m_prevActive.parser = NULL;
+        m_prevActive.data = NULL;
+    }
+
+    ~wxHtmlWinParserData()
+    {
+        ClearExtents();
+    }
+
+    // Must be called when the DC used by the parser changes.
+    void OnDCChanged() { m_dcChanged = true; }
+
+    // Returns the extent of the given word using the current font of the DC,
+    // which is only measured if it's not in the cache yet.
+    wxHtmlWordExtent GetWordExtent(const wxDC& dc, const wxString& word);
+
+    void ClearExtents()
+    {
+        for ( size_t n = 0; n < m_fontExtents.size(); n++ )
+            delete m_fontExtents[n];
+        m_fontExtents.clear();
+        m_lastFontExtents = NULL;
+    }
+
+    wxHtmlWinParserState m_state;
+
+    // The parser which was active before this one, if any, to be restored
+    // when this one becomes inactive.
+    wxHtmlActiveParser m_prevActive;
+
+private:
+    // Properties of the DC affecting the text extents.
+    struct DCInfo
+    {
+        bool operator==(const DCInfo& other) const
+        {
+            return classInfo == other.classInfo &&
+                   ppi == other.ppi &&
+                   contentScale == other.contentScale &&
+                   userScaleX == other.userScaleX &&
+                   userScaleY == other.userScaleY &&
+                   logicalScaleX == other.logicalScaleX &&
+                   logicalScaleY == other.logicalScaleY &&
+                   mapMode == other.mapMode;
+        }
+
+        wxClassInfo *classInfo;
+        wxSize ppi;
+        double contentScale;
+        double userScaleX, userScaleY;
+        double logicalScaleX, logicalScaleY;
+        wxMappingMode mapMode;
+    };
+
+    DCInfo m_dcInfo;
+    bool m_dcChanged;
+
+    wxVector<wxHtmlFontWordExtents*> m_fontExtents;
+    wxHtmlFontWordExtents *m_lastFontExtents;
+};
+
+wxHtmlWordExtent
+wxHtmlWinParserData::GetWordExtent(const wxDC& dc, const wxString& word)
+{
+    // Limits on the cache size, just to prevent it from growing indefinitely.
+    static const size_t MAX_CACHED_FONTS = 32;
+    static const size_t MAX_CACHED_WORDS = 10000;
+
+    wxHtmlWordExtent ext;
+
+    const wxFont& font = dc.GetFont();
+    if ( !font.IsOk() )
+    {
+        dc.GetTextExtent(word, &ext.width, &ext.height, &ext.descent);
+        return ext;
+    }
+
+    // The same DC object is typically reused for all the parsing, but check
+    // that the extents cached for the previously used one are still valid.
+    if ( m_dcChanged )
+    {
+        DCInfo info;
+        info.classInfo = dc.GetClassInfo();
+        info.ppi = dc.GetPPI();
+        info.contentScale = dc.GetContentScaleFactor();
+        dc.GetUserScale(&info.userScaleX, &info.userScaleY);
+        dc.GetLogicalScale(&info.logicalScaleX, &info.logicalScaleY);
+        info.mapMode = dc.GetMapMode();
+
+        if ( !(info == m_dcInfo) )
+        {
+            ClearExtents();
+            m_dcInfo = info;
+        }
+
+        m_dcChanged = false;
+    }
+
+    wxHtmlFontWordExtents *fontExtents = m_lastFontExtents;
+    if ( !fontExtents || fontExtents->font.GetRefData() != font.GetRefData() )
+    {
+        fontExtents = NULL;
+        for ( size_t n = 0; n < m_fontExtents.size(); n++ )
+        {
+            if ( m_fontExtents[n]->font.GetRefData() == font.GetRefData() )
+            {
+                fontExtents = m_fontExtents[n];
+                break;
+            }
+        }
+
+        if ( !fontExtents )
+        {
+            if ( m_fontExtents.size() == MAX_CACHED_FONTS )
+                ClearExtents();
+
+            fontExtents = new wxHtmlFontWordExtents;
+            fontExtents->font = font;
+            m_fontExtents.push_back(fontExtents);
+        }
+
+        m_lastFontExtents = fontExtents;
+    }
+
+    wxHtmlWordExtentsHash& extents = fontExtents->extents;
+    const wxHtmlWordExtentsHash::const_iterator it = extents.find(word);
+    if ( it != extents.end() )
+        return it->second;
+
+    if ( extents.size() == MAX_CACHED_WORDS )
+        extents.clear();
+
+    dc.GetTextExtent(word, &ext.width, &ext.height, &ext.descent);
+    extents[word] = ext;
+
+    return ext;
+}
+
+WX_DECLARE_HASH_MAP(wxHtmlWinParser*, wxHtmlWinParserData*,
+                    wxPointerHash, wxPointerEqual,
+                    wxHtmlWinParserDataMap);
+
+wxCRIT_SECT_DECLARE(gs_csParserData);
+
+wxHtmlWinParserDataMap& GetParserDataMap()
+{
+    static wxHtmlWinParserDataMap s_parserData;
+
+    return s_parserData;
+}
+
+wxHtmlActiveParser& GetActiveParser()
+{
+    static wxTLS_TYPE(wxHtmlActiveParser) s_activeParser;
+
+    return wxTLS_VALUE(s_activeParser);
+}
+
+// Returns the data associated with the given parser, creating it if necessary.
+wxHtmlWinParserData& GetParserData(wxHtmlWinParser *parser)
+{
+    // This is called for every word, so avoid locking and looking up the
+    // data of the parser which is currently parsing.
+    const wxHtmlActiveParser& active = GetActiveParser();
+    if ( active.parser == parser )
+        return *active.data;
+
+    wxCRIT_SECT_LOCKER(lock, gs_csParserData);
+
+    wxHtmlWinParserData*& data = GetParserDataMap()[parser];
+    if ( !data )
+        data = new wxHtmlWinParserData;
+
+    return *data;
+}
+
+void DeactivateParser(wxHtmlWinParser *parser)
+{
+    // Normally the parser is the active one, but it could also be deactivated
+    // (e.g. destroyed) while another one, activated after it, is still active.
+    for ( wxHtmlActiveParser* link = &GetActiveParser();
+          link->parser;
+          link = &link->data->m_prevActive )
+    {
+        if ( link->parser == parser )
+        {
+            *link = link->data->m_prevActive;
+            break;
+        }
+    }
+}
+
+// Make the data of the given parser quickly accessible until the matching
+// call to DeactivateParser(), this can be nested for different parsers.
+void ActivateParser(wxHtmlWinParser *parser)
+{
+    wxHtmlActiveParser& active = GetActiveParser();
+    if ( active.parser == parser )
+        return;
+
+    // It could have been activated before another parser, don't let it
+    // appear in the chain twice.
+    DeactivateParser(parser);
+
+    wxHtmlWinParserData& data = GetParserData(parser);
+    data.m_prevActive = active;
+    active.parser = parser;
+    active.data = &data;
+}
+
+void DeleteParserData(wxHtmlWinParser *parser)
+{
+    DeactivateParser(parser);
+
+    wxCRIT_SECT_LOCKER(lock, gs_csParserData);
+
+    wxHtmlWinParserDataMap& map = GetParserDataMap();
+    const wxHtmlWinParserDataMap::iterator it = map.find(parser);
+    if ( it != map.end() )
+    {
+        delete it->second;
+        map.erase(it);
+    }
+}
+
+// Creates the cell for the given word using the cached extent if possible.
+wxHtmlWordCell *
+CreateWordCell(wxHtmlWinParser *parser,
+               const wxDC& dc,
+               const wxString& word)
+{
+    const wxHtmlWordExtent
+        ext = GetParserData(parser).GetWordExtent(dc, word);
+
+    return new wxHtmlWordCell(word, ext.width, ext.height, ext.descent);
+}
+
+// Containers are empty if they don't contain anything but formatting cells,
+// this must be the same test as used by RemoveExtraSpacing().
+bool IsEmptyContainer(wxHtmlContainerCell *cell)
+{
+    for ( wxHtmlCell *c = cell->GetFirstChild(); c; c = c->GetNext() )
+    {
+        if ( !c->IsTerminalCell() || !c->IsFormattingCell() )
+            return false;
+    }
+    return true;
+}
+
+// Remember the vertical indents of all the containers that may be changed by
+// calling RemoveExtraSpacing(false, true) on the given one, i.e. the empty
+// containers at its end and the last non-empty one, recursively.
+void
+SaveBottomSpacing(wxHtmlContainerCell *cont,
+                  wxVector<wxHtmlContainerSpacing>& spacing)
+{
+    wxHtmlContainerSpacing s;
+    s.cell = cont;
+    s.top = cont->GetIndent(wxHTML_INDENT_TOP);
+    s.bottom = cont->GetIndent(wxHTML_INDENT_BOTTOM);
+    spacing.push_back(s);
+
+    wxVector<wxHtmlContainerCell*> children;
+    for ( wxHtmlCell *c = cont->GetFirstChild(); c; c = c->GetNext() )
+    {
+        if ( c->IsTerminalCell() )
+        {
+            if ( !c->IsFormattingCell() )
+                children.clear();
+        }
+        else
+        {
+            children.push_back(static_cast<wxHtmlContainerCell*>(c));
+        }
+    }
+
+    for ( size_t n = children.size(); n > 0; n-- )
+    {
+        wxHtmlContainerCell* const child = children[n - 1];
+        if ( !IsEmptyContainer(child) )
+        {
+            SaveBottomSpacing(child, spacing);
+            break;
+        }
+
+        s.cell = child;
+        s.top = child->GetIndent(wxHTML_INDENT_TOP);
+        s.bottom = child->GetIndent(wxHTML_INDENT_BOTTOM);
+        spacing.push_back(s);
+    }
+}
+
+// Check if the source ends inside a comment.
+bool HasUnterminatedComment(const wxString& source)
+{
+    const size_t commentStart = source.rfind(wxS("<!--"));
+    return commentStart != wxString::npos &&
+            source.find(wxS("-->"), commentStart + 4) == wxString::npos;
+}
+
+void SetRawIndent(wxHtmlContainerCell *cont, int indent, int what)
+{
+    // Negative values returned by GetIndent() are in percents.
+    if ( indent < 0 )
+        cont->SetIndent(-indent, what, wxHTML_UNITS_PERCENT);
+    else
+        cont->SetIndent(indent, what, wxHTML_UNITS_PIXELS);
+}
+
+// Check if the HTML appended to the given page can be parsed on its own and
+// still produce the same result as if the entire page were parsed again.
+bool CanParseAppended(const wxString& page)
+{
+    // If the page ends with some text, the first word of the appended source
+    // could be a continuation of its last word, and if it ends inside a tag
+    // or a comment, the appended source would be interpreted differently.
+    // The comment case is checked by HasUnterminatedComment() when the
+    // source is parsed, as doing it here would require scanning the entire
+    // page every time.
+    const size_t lastChar = page.find_last_not_of(wxS(" \t\r\n"));
+    return lastChar != wxString::npos && page[lastChar] == '>';
+}
+
+// Check that all the ending tags in the source correspond to the tags in the
+// tree created from it: otherwise they could match the tags opened before it.
+bool AreAllEndingTagsMatched(const wxString& source, const wxHtmlTag *tags)
+{
+    size_t numEndings = 0;
+    for ( size_t pos = source.find(wxS("</"));
+          pos != wxString::npos;
+          pos = source.find(wxS("</"), pos + 2) )
+    {
+        numEndings++;
+    }
+
+    for ( const wxHtmlTag *tag = tags; tag; tag = tag->GetNextTag() )
+    {
+        if ( tag->HasEnding() )
+        {
+            if ( !numEndings )
+                break;
+
+            numEndings--;
+        }
+    }
+
+    // Notice that this is conservative and "</" occurring in comments also
+    // results in returning false, which is fine, as it just prevents the
+    // optimization from being used.
+    return numEndings == 0;
+}
+
+} // anonymous namespace
+
 
 
 //-----------------------------------------------------------------------------
@@ -97,6 +534,8 @@ wxHtmlWinParser::~wxHtmlWinParser()
     delete m_EncConv;
 #endif
     delete[] m_tmpStrBuf;
+
+    DeleteParserData(this);
 }
 
 void wxHtmlWinParser::AddModule(wxHtmlTagsModule *module)
@@ -153,6 +592,9 @@ void wxHtmlWinParser::SetFonts(const wxString& normal_face,
     for (i = 0; i < 7; i++)
         m_FontsSizes[i] = sizes[i];
 
+    // The fonts are going to be recreated, no need to keep the old ones.
+    GetParserData(this).ClearExtents();
+
     m_FontFaceFixed = fixed_face;
     m_FontFaceNormal = normal_face;
 
@@ -195,6 +637,8 @@ void wxHtmlWinParser::InitParser(const wxString& source)
     wxHtmlParser::InitParser(source);
     wxASSERT_MSG(m_DC != NULL, wxT("no DC assigned to wxHtmlWinParser!!"));
 
+    ActivateParser(this);
+
     m_FontBold = m_FontItalic = m_FontUnderlined = m_FontFixed = FALSE;
     m_FontSize = 3; //default one
     CreateCurrentFont();           // we're selecting default font into
@@ -254,6 +698,8 @@ void wxHtmlWinParser::InitParser(const wxString& source)
 
 void wxHtmlWinParser::DoneParser()
 {
+    DeactivateParser(this);
+
     m_Container = NULL;
 #if !wxUSE_UNICODE
     SetInputEncoding(wxFONTENCODING_ISO8859_1); // for next call
@@ -265,16 +711,186 @@ wxObject* wxHtmlWinParser::GetProduct()
 {
     wxHtmlContainerCell *top;
 
+    // Remember the state at the end of the document to allow continuing
+    // parsing from it in AppendToProduct().
+    wxHtmlWinParserState& state = GetParserData(this).m_state;
+    state.product = NULL;
+
+    wxHtmlContainerCell* const container = m_Container;
+    state.lastWasSpace = m_tmpLastWasSpace;
+    state.posColumn = m_posColumn;
+
     CloseContainer();
     OpenContainer();
 
     top = m_Container;
     while (top->GetParent()) top = top->GetParent();
+
+    // If the current container was the top level one, the product is not
+    // really usable anyhow, so don't bother with it.
+    if ( container->GetParent() )
+    {
+        state.product = top;
+        state.container = container;
+        state.trailing = m_Container;
+        state.spacing.clear();
+        SaveBottomSpacing(top, state.spacing);
+
+        state.pixelScale = m_PixelScale;
+        state.fontScale = m_FontScale;
+        state.fontBold = m_FontBold;
+        state.fontItalic = m_FontItalic;
+        state.fontUnderlined = m_FontUnderlined;
+        state.fontFixed = m_FontFixed;
+        state.fontSize = m_FontSize;
+        state.linkColor = m_LinkColor;
+        state.actualColor = m_ActualColor;
+        state.actualBackgroundColor = m_ActualBackgroundColor;
+        state.actualBackgroundMode = m_ActualBackgroundMode;
+        state.link = m_Link;
+        state.useLink = m_UseLink;
+        state.align = m_Align;
+        state.scriptMode = m_ScriptMode;
+        state.scriptBaseline = m_ScriptBaseline;
+        state.whitespaceMode = m_whitespaceMode;
+        state.lastWordCell = m_lastWordCell;
+#if !wxUSE_UNICODE
+        state.inputEncoding = m_InputEnc;
+#endif
+
+        // When appending, only the new fragment needs to be checked as the
+        // previous page couldn't end inside a comment.
+        state.endsInComment = !m_Source || HasUnterminatedComment(*m_Source);
+    }
+
     top->RemoveExtraSpacing(true, true);
 
     return top;
 }
 
+bool wxHtmlWinParser::AppendToProduct(const wxString& source,
+                                      wxHtmlContainerCell *product)
+{
+    wxCHECK_MSG( product, false, wxS("NULL product") );
+    wxCHECK_MSG( m_DC, false, wxS("no DC assigned to wxHtmlWinParser") );
+
+    wxHtmlWinParserState& state = GetParserData(this).m_state;
+    if ( state.product != product || !m_Source )
+        return false;
+
+    // The fonts would be different if the scale changed.
+    if ( state.pixelScale != m_PixelScale || state.fontScale != m_FontScale )
+        return false;
+
+    // Check that the empty container opened by GetProduct() is still there.
+    wxHtmlContainerCell* const trailing = state.trailing;
+    wxHtmlContainerCell* const parent = state.container->GetParent();
+    if ( trailing->GetParent() != parent ||
+            parent->GetLastChild() != trailing ||
+                trailing->GetFirstChild() )
+        return false;
+
+    if ( state.endsInComment || !CanParseAppended(*m_Source) )
+        return false;
+
+#if !wxUSE_UNICODE
+    // The charset specified in the new fragment would apply to the entire
+    // page, so it must be parsed again.
+    if ( !ExtractCharsetInformation(source).empty() )
+        return false;
+#endif
+
+    // Create the tags tree for the new source only, but keep the old one to
+    // restore it if we can't use the new tree.
+    const wxString* const page = m_Source;
+    m_Source = NULL;
+    wxHtmlParser::InitParser(source);
+
+    if ( !AreAllEndingTagsMatched(source, m_Tags) )
+    {
+        DestroyDOMTree();
+        delete m_Source;
+        m_Source = page;
+        return false;
+    }
+
+    // DoneParser() below will deactivate it again.
+    ActivateParser(this);
+
+    // Undo the changes done at the end of the last parsing: remove the empty
+    // container and restore the spacing which was removed from the end of the
+    // document as it's not at the end any more.
+    parent->Detach(trailing);
+    delete trailing;
+
+    for ( size_t n = 0; n < state.spacing.size(); n++ )
+    {
+        const wxHtmlContainerSpacing& s = state.spacing[n];
+        if ( s.cell == product )
+            continue;
+
+        SetRawIndent(s.cell, s.top, wxHTML_INDENT_TOP);
+        SetRawIndent(s.cell, s.bottom, wxHTML_INDENT_BOTTOM);
+    }
+
+    // And restore the parser state.
+    m_Container = state.container;
+    m_FontBold = state.fontBold;
+    m_FontItalic = state.fontItalic;
+    m_FontUnderlined = state.fontUnderlined;
+    m_FontFixed = state.fontFixed;
+    m_FontSize = state.fontSize;
+    m_LinkColor = state.linkColor;
+    m_ActualColor = state.actualColor;
+    m_ActualBackgroundColor = state.actualBackgroundColor;
+    m_ActualBackgroundMode = state.actualBackgroundMode;
+    m_Link = state.link;
+    m_UseLink = state.useLink;
+    m_Align = state.align;
+    m_ScriptMode = state.scriptMode;
+    m_ScriptBaseline = state.scriptBaseline;
+    m_whitespaceMode = state.whitespaceMode;
+    m_tmpLastWasSpace = state.lastWasSpace;
+    m_lastWordCell = state.lastWordCell;
+    m_posColumn = state.posColumn;
+#if !wxUSE_UNICODE
+    SetInputEncoding(state.inputEncoding);
+#endif
+    CreateCurrentFont();
+
+    DoParsing();
+
+    // Preserve the indents of the product itself, which could have been
+    // changed since it was created, unlike those of the other containers.
+    int indents[4];
+    static const int indentKinds[4] =
+    {
+        wxHTML_INDENT_LEFT,
+        wxHTML_INDENT_RIGHT,
+        wxHTML_INDENT_TOP,
+        wxHTML_INDENT_BOTTOM
+    };
+    for ( size_t n = 0; n < WXSIZEOF(indentKinds); n++ )
+        indents[n] = product->GetIndent(indentKinds[n]);
+
+    wxObject* const top = GetProduct();
+    wxASSERT_MSG( top == product, wxS("unexpected product") );
+    wxUnusedVar(top);
+
+    for ( size_t n = 0; n < WXSIZEOF(indentKinds); n++ )
+        SetRawIndent(product, indents[n], indentKinds[n]);
+
+    DoneParser();
+
+    // Finally update the source to correspond to the entire page.
+    wxString* const all = const_cast<wxString*>(page);
+    all->append(source);
+    delete m_Source;
+    m_Source = all;
+
+    return true;
+}
+
 wxFSFile *wxHtmlWinParser::OpenURL(wxHtmlURLType type,
                                    const wxString& url) const
 {
@@ -444,7 +1060,7 @@ void wxHtmlWinParser::FlushWordBuf(wxChar *buf, int& len)
         m_EncConv->Convert(buf);
 #endif
 
-    AddWord(wxString(buf, len));
+    AddWord(CreateWordCell(this, *m_DC, wxString(buf, len)));
 
     len = 0;
 }
@@ -498,7 +1114,7 @@ void wxHtmlWinParser::AddPreBlock(const wxString& text)
     else
     {
         // no special formatting needed
-        AddWord(text);
+        AddWord(CreateWordCell(this, *m_DC, text));
         m_posColumn += text.length();
     }
 }
@@ -547,6 +1163,9 @@ void wxHtmlWinParser::SetDC(wxDC *dc, double pixel_scale, double font_scale)
     m_DC = dc;
     m_PixelScale = pixel_scale;
     m_FontScale = font_scale;
+
+    if ( dc )
+        GetParserData(this).OnDCChanged();
 }
 
 void wxHtmlWinParser::SetFontPointSize(int pt)
@@ -587,7 +587,13 @@ bool wxWebResponseWinHTTP::ReadData()
 
 bool wxWebResponseWinHTTP::ReportAvailableData(DWORD dataLen)
 {
-    ReportDataReceived(dataLen);
+    // Don't read any more data if we couldn't store it.
+    if ( !ReportDataReceived(dataLen) )
+    {
+        m_request.SetState(wxWebRequest::State_Failed, GetStorageError());
+        return true;
+    }
+
     return ReadData();
 }
 
@@ -34,6 +34,9 @@
 #include "wx/hashmap.h"
 #include "wx/dynarray.h"
 #include "wx/math.h"
+#include "wx/stopwatch.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
 
 #include "wx/richtext/richtextctrl.h"
 #include "wx/richtext/richtextstyles.h"
@@ -513,6 +516,253 @@ inline void wxCheckSetBrush(wxDC& dc, const wxBrush& brush)
     dc.SetBrush(brush);
 }
 
+struct wxRichTextTextExtent
+{
+    wxCoord width, height, descent;
+};
+
+WX_DECLARE_STRING_HASH_MAP(wxRichTextTextExtent, wxRichTextTextExtentHash);
+WX_DECLARE_STRING_HASH_MAP(wxArrayInt, wxRichTextPartialExtentsHash);
+
+// Cache of the text extents measured during layout: the same text is usually
+// measured several times, e.g. when a paragraph is laid out again using its
+// minimum width or when the entire buffer is laid out again after resizing the
+// control. It is only used while the buffer is being laid out, as the same DC
+// is used during the entire layout.
+class wxRichTextExtentCache
+{
+public:
+    wxRichTextExtentCache()
+    {
+        m_dc = NULL;
+        m_lastFontExtents = NULL;
+        m_numChars = 0;
+    }
+
+    ~wxRichTextExtentCache() { Clear(); }
+
+    // Start using the cache for the given DC, returns false if it's already
+    // being used, e.g. when laying out nested boxes. As the cache is global,
+    // it's only used in the main thread.
+    bool Start(const wxDC& dc);
+    void Stop() { m_dc = NULL; }
+
+    // Use the cache, if possible, to get the extents of the given text.
+    void GetTextExtent(const wxDC& dc, const wxString& text,
+                       wxCoord* width, wxCoord* height, wxCoord* descent = NULL);
+    void GetPartialTextExtents(const wxDC& dc, const wxString& text,
+                               wxArrayInt& widths);
+
+    void Clear();
+
+private:
+    struct FontExtents
+    {
+        wxFont font;
+        wxRichTextTextExtentHash extents;
+        wxRichTextPartialExtentsHash partialExtents;
+    };
+
+    // Properties of the DC affecting the text extents.
+    struct DCInfo
+    {
+        bool operator==(const DCInfo& other) const
+        {
+            return classInfo == other.classInfo &&
+                   ppi == other.ppi &&
+                   contentScale == other.contentScale &&
+                   userScaleX == other.userScaleX &&
+                   userScaleY == other.userScaleY &&
+                   logicalScaleX == other.logicalScaleX &&
+                   logicalScaleY == other.logicalScaleY &&
+                   mapMode == other.mapMode;
+        }
+
+        wxClassInfo* classInfo;
+        wxSize ppi;
+        double contentScale;
+        double userScaleX, userScaleY;
+        double logicalScaleX, logicalScaleY;
+        wxMappingMode mapMode;
+    };
+
+    // Returns the extents for the current DC font or NULL if the cache can't
+    // be used with this DC.
+    FontExtents* GetFontExtents(const wxDC& dc);
+
+    const wxDC* m_dc;
+    DCInfo m_dcInfo;
+    wxVector<FontExtents*> m_fontExtents;
+    FontExtents* m_lastFontExtents;
+
+    // Total number of characters in all the cached strings.
+    size_t m_numChars;
+};
+
+bool wxRichTextExtentCache::Start(const wxDC& dc)
+{
+    if (m_dc || !wxIsMainThread())
+        return false;
+
+    DCInfo info;
+    info.classInfo = dc.GetClassInfo();
+    info.ppi = dc.GetPPI();
+    info.contentScale = dc.GetContentScaleFactor();
+    dc.GetUserScale(&info.userScaleX, &info.userScaleY);
+    dc.GetLogicalScale(&info.logicalScaleX, &info.logicalScaleY);
+    info.mapMode = dc.GetMapMode();
+
+    if (m_fontExtents.empty() || !(info == m_dcInfo))
+    {
+        Clear();
+        m_dcInfo = info;
+    }
+
+    m_dc = &dc;
+
+    return true;
+}
+
+void wxRichTextExtentCache::Clear()
+{
+    for (size_t i = 0; i < m_fontExtents.size(); i++)
+        delete m_fontExtents[i];
+    m_fontExtents.clear();
+    m_lastFontExtents = NULL;
+    m_numChars = 0;
+}
+
+wxRichTextExtentCache::FontExtents* wxRichTextExtentCache::GetFontExtents(const wxDC& dc)
+{
+    // Limits on the cache size, just to prevent it from growing indefinitely.
+    static const size_t MAX_CACHED_FONTS = 32;
+    static const size_t MAX_CACHED_CHARS = 1000000;
+
+    if (&dc != m_dc)
+        return NULL;
+
+    const wxFont& font = dc.GetFont();
+    if (!font.IsOk())
+        return NULL;
+
+    // Note that the font stored in the cache keeps its data alive, so the
+    // pointers to the data can be compared safely.
+    FontExtents* fontExtents = m_lastFontExtents;
+    if (!fontExtents || fontExtents->font.GetRefData() != font.GetRefData())
+    {
+        fontExtents = NULL;
+        for (size_t i = 0; i < m_fontExtents.size(); i++)
+        {
+            if (m_fontExtents[i]->font.GetRefData() == font.GetRefData())
+            {
+                fontExtents = m_fontExtents[i];
+                break;
+            }
+        }
+
+        if (!fontExtents)
+        {
+            if (m_fontExtents.size() == MAX_CACHED_FONTS)
+                Clear();
+
+            fontExtents = new FontExtents;
+            fontExtents->font = font;
+            m_fontExtents.push_back(fontExtents);
+        }
+
+        m_lastFontExtents = fontExtents;
+    }
+
+    if (m_numChars > MAX_CACHED_CHARS)
+    {
+        for (size_t i = 0; i < m_fontExtents.size(); i++)
+        {
+            m_fontExtents[i]->extents.clear();
+            m_fontExtents[i]->partialExtents.clear();
+        }
+        m_numChars = 0;
+    }
+
+    return fontExtents;
+}
+
+void wxRichTextExtentCache::GetTextExtent(const wxDC& dc, const wxString& text,
+                                          wxCoord* width, wxCoord* height, wxCoord* descent)
+{
+    FontExtents* const fontExtents = GetFontExtents(dc);
+    if (!fontExtents)
+    {
+        dc.GetTextExtent(text, width, height, descent);
+        return;
+    }
+
+    wxRichTextTextExtentHash::const_iterator it = fontExtents->extents.find(text);
+    if (it == fontExtents->extents.end())
+    {
+        wxRichTextTextExtent ext;
+        dc.GetTextExtent(text, &ext.width, &ext.height, &ext.descent);
+        it = fontExtents->extents.insert(wxRichTextTextExtentHash::value_type(text, ext)).first;
+        m_numChars += text.length();
+    }
+
+    *width = it->second.width;
+    *height = it->second.height;
+    if (descent)
+        *descent = it->second.descent;
+}
+
+void wxRichTextExtentCache::GetPartialTextExtents(const wxDC& dc, const wxString& text,
+                                                  wxArrayInt& widths)
+{
+    FontExtents* const fontExtents = GetFontExtents(dc);
+    if (!fontExtents)
+    {
+        dc.GetPartialTextExtents(text, widths);
+        return;
+    }
+
+    wxRichTextPartialExtentsHash::const_iterator it = fontExtents->partialExtents.find(text);
+    if (it == fontExtents->partialExtents.end())
+    {
+        dc.GetPartialTextExtents(text, widths);
+        fontExtents->partialExtents[text] = widths;
+        m_numChars += text.length();
+    }
+    else
+    {
+        widths = it->second;
+    }
+}
+
+static wxRichTextExtentCache* gs_richTextExtentCache = NULL;
+
+static wxRichTextExtentCache& wxRichTextGetExtentCache()
+{
+    if (!gs_richTextExtentCache)
+        gs_richTextExtentCache = new wxRichTextExtentCache;
+
+    return *gs_richTextExtentCache;
+}
+
+// Get the text extents using the given cache, if it's not NULL.
+static void wxRichTextGetTextExtent(wxRichTextExtentCache* cache, const wxDC& dc, const wxString& text,
+                                    wxCoord* width, wxCoord* height, wxCoord* descent = NULL)
+{
+    if (cache)
+        cache->GetTextExtent(dc, text, width, height, descent);
+    else
+        dc.GetTextExtent(text, width, height, descent);
+}
+
+static void wxRichTextGetPartialTextExtents(wxRichTextExtentCache* cache, const wxDC& dc, const wxString& text,
+                                            wxArrayInt& widths)
+{
+    if (cache)
+        cache->GetPartialTextExtents(dc, text, widths);
+    else
+        dc.GetPartialTextExtents(text, widths);
+}
+
 /*!
  * wxRichTextObject
  * This is the base for drawable objects.
@@ -2136,11 +2386,69 @@ bool wxRichTextParagraphLayoutBox::Draw(wxDC& dc, wxRichTextDrawingContext& cont
     return true;
 }
 
+// Parameters of wxRichTextParagraphLayoutBox::LayoutLazily() used by Layout()
+// when it's called from it.
+struct wxRichTextLazyLayoutParams
+{
+    // Returns true if the time allotted for the layout has elapsed.
+    bool IsTimeUp() const
+    {
+#if wxUSE_STOPWATCH
+        return stopWatch.Time() >= maxTime;
+#else
+        return true;
+#endif
+    }
+
+    const wxRichTextParagraphLayoutBox* box;
+    int bottom;
+    long maxTime;
+#if wxUSE_STOPWATCH
+    wxStopWatch stopWatch;
+#endif
+
+    // Set by Layout() when it uses these parameters.
+    bool used;
+};
+
+static wxRichTextLazyLayoutParams* gs_richTextLazyLayoutParams = NULL;
+
+// Enables the use of the text extents cache during the top level layout.
+class wxRichTextExtentCacheUser
+{
+public:
+    wxRichTextExtentCacheUser(const wxDC& dc)
+    {
+        m_started = wxRichTextGetExtentCache().Start(dc);
+    }
+
+    ~wxRichTextExtentCacheUser()
+    {
+        if (m_started)
+            wxRichTextGetExtentCache().Stop();
+    }
+
+private:
+    bool m_started;
+
+    wxDECLARE_NO_COPY_CLASS(wxRichTextExtentCacheUser);
+};
+
 /// Lay the item out
 bool wxRichTextParagraphLayoutBox::Layout(wxDC& dc, wxRichTextDrawingContext& context, const wxRect& rect, const wxRect& parentRect, int style)
 {
     context.SetLayingOut(true);
 
+    wxRichTextExtentCacheUser extentCacheUser(dc);
+
+    // When called from LayoutLazily(), only lay out the paragraphs until the
+    // given position and time and just estimate the size of the others.
+    wxRichTextLazyLayoutParams* const lazy =
+        gs_richTextLazyLayoutParams && gs_richTextLazyLayoutParams->box == this
+            ? gs_richTextLazyLayoutParams : NULL;
+    if (lazy)
+        lazy->used = true;
+
     Move(rect.GetPosition());
 
     if (!IsShown())
@@ -2252,6 +2560,15 @@ bool wxRichTextParagraphLayoutBox::Layout(wxDC& dc, wxRichTextDrawingContext& co
     // A way to force speedy rest-of-buffer layout (the 'else' below)
     bool forceQuickLayout = false;
 
+    // Used for lazy layout only: whether the paragraphs needing layout are
+    // only given an estimated size, the range of these paragraphs and the
+    // statistics of the laid out paragraphs used for the estimation.
+    bool deferLayout = false;
+    wxRichTextRange deferredRange = wxRICHTEXT_NONE;
+    int laidOutHeight = 0;
+    long laidOutLength = 0;
+    int minParagraphHeight = 0;
+
     // First get the size of the paragraphs we won't be laying out
     wxRichTextObjectList::compatibility_iterator n = m_children.GetFirst();
     while (n && n != node)
@@ -2276,8 +2593,51 @@ bool wxRichTextParagraphLayoutBox::Layout(wxDC& dc, wxRichTextDrawingContext& co
 
         if (child && child->IsShown())
         {
+            // Always lay out at least one paragraph needing it, even if it is
+            // below the bottom and the time is already up, to make progress.
+            if (lazy && !deferLayout && !hasVerticalAlignment && laidOutLength > 0 &&
+                    availableSpace.y > lazy->bottom && lazy->IsTimeUp())
+            {
+                deferLayout = true;
+                if (!minParagraphHeight)
+                    minParagraphHeight = dc.GetCharHeight();
+            }
+
+            if (deferLayout)
+            {
+                if (layoutAll || child->GetLines().empty() || !child->GetRange().IsOutside(invalidRange))
+                {
+                    // Assume the same height per character as in the paragraphs
+                    // laid out so far, but at least a single line.
+                    int height = minParagraphHeight;
+                    if (laidOutLength > 0)
+                        height = wxMax(height, wxRound(double(laidOutHeight)*child->GetRange().GetLength()/laidOutLength));
+
+                    child->ClearLines();
+                    child->Move(wxPoint(availableSpace.x, availableSpace.y));
+                    child->SetCachedSize(wxSize(0, height));
+                    child->SetMinSize(wxSize(0, height));
+                    child->SetMaxSize(wxSize(0, height));
+
+                    if (deferredRange == wxRICHTEXT_NONE)
+                        deferredRange.SetStart(child->GetRange().GetStart());
+                    deferredRange.SetEnd(child->GetRange().GetEnd());
+                }
+                else
+                {
+                    if (wxRichTextBuffer::GetFloatingLayoutMode() && GetFloatCollector())
+                        GetFloatCollector()->CollectFloat(child);
+                    child->Move(wxPoint(child->GetPosition().x, availableSpace.y));
+
+                    maxWidth = wxMax(maxWidth, child->GetCachedSize().x);
+                    maxMinWidth = wxMax(maxMinWidth, child->GetMinSize().x);
+                    maxMaxWidth = wxMax(maxMaxWidth, child->GetMaxSize().x);
+                }
+
+                availableSpace.y += child->GetCachedSize().y;
+            }
             // TODO: what if the child hasn't been laid out (e.g. involved in Undo) but still has 'old' lines
-            if ( !forceQuickLayout &&
+            else if ( !forceQuickLayout &&
                     (layoutAll ||
                         child->GetLines().empty() ||
                             !child->GetRange().IsOutside(invalidRange)) )
@@ -2293,9 +2653,16 @@ bool wxRichTextParagraphLayoutBox::Layout(wxDC& dc, wxRichTextDrawingContext& co
                 maxMinWidth = wxMax(maxMinWidth, child->GetMinSize().x);
                 maxMaxWidth = wxMax(maxMaxWidth, child->GetMaxSize().x);
 
+                if (lazy)
+                {
+                    laidOutHeight += child->GetCachedSize().y;
+                    laidOutLength += child->GetRange().GetLength();
+                    if (!minParagraphHeight || child->GetCachedSize().y < minParagraphHeight)
+                        minParagraphHeight = child->GetCachedSize().y;
+                }
                 // If we're just formatting the visible part of the buffer,
                 // and we're now past the bottom of the window, start quick layout.
-                if (!hasVerticalAlignment && formatRect && child->GetPosition().y > rect.GetBottom())
+                else if (!hasVerticalAlignment && formatRect && child->GetPosition().y > rect.GetBottom())
                     forceQuickLayout = true;
             }
             else
@@ -2488,11 +2855,43 @@ bool wxRichTextParagraphLayoutBox::Layout(wxDC& dc, wxRichTextDrawingContext& co
         }
     }
 
-    m_invalidRange = wxRICHTEXT_NONE;
+    // The paragraphs which were not laid out still need to be.
+    m_invalidRange = deferredRange;
 
     return true;
 }
 
+bool wxRichTextParagraphLayoutBox::LayoutLazily(wxDC& dc, wxRichTextDrawingContext& context,
+                                                const wxRect& rect, const wxRect& parentRect, int style,
+                                                int bottom, long maxTime)
+{
+    wxRichTextLazyLayoutParams params;
+    params.box = this;
+    params.bottom = bottom;
+    params.maxTime = maxTime;
+    params.used = false;
+
+    wxRichTextLazyLayoutParams* const oldParams = gs_richTextLazyLayoutParams;
+    gs_richTextLazyLayoutParams = &params;
+
+    // Let the control customize the layout of its buffer, just as when it's
+    // laid out entirely.
+    wxRichTextCtrl* const ctrl = GetRichTextCtrl();
+    if (ctrl && &ctrl->GetBuffer() == this)
+        ctrl->DoLayoutBuffer(ctrl->GetBuffer(), dc, context, rect, parentRect, style);
+    else
+        Layout(dc, context, rect, parentRect, style);
+
+    gs_richTextLazyLayoutParams = oldParams;
+
+    // If DoLayoutBuffer() didn't call Layout(), it must have laid out the
+    // buffer in some other way, so consider it to be done.
+    if (!params.used)
+        Invalidate(wxRICHTEXT_NONE);
+
+    return !IsDirty();
+}
+
 /// Get/set the size for the given range.
 bool wxRichTextParagraphLayoutBox::GetRangeSize(const wxRichTextRange& range, wxSize& size, int& descent, wxDC& dc, wxRichTextDrawingContext& context, int flags, const wxPoint& position, const wxSize& parentSize, wxArrayInt* WXUNUSED(partialExtents)) const
 {
@@ -7254,6 +7653,10 @@ bool wxRichTextPlainText::GetRangeSize(const wxRichTextRange& range, wxSize& siz
         }
     }
 
+    // The fonts used for the scripts are created on the fly, so there is no
+    // point in caching the extents for them.
+    wxRichTextExtentCache* const extentCache = bScript ? NULL : &wxRichTextGetExtentCache();
+
     bool haveDescent = false;
     int startPos = range.GetStart() - GetRange().GetStart();
 
@@ -7321,7 +7724,7 @@ bool wxRichTextPlainText::GetRangeSize(const wxRichTextRange& range, wxSize& siz
 
                 // Add these partial extents
                 wxArrayInt p;
-                dc.GetPartialTextExtents(stringFragment, p);
+                wxRichTextGetPartialTextExtents(extentCache, dc, stringFragment, p);
                 size_t j;
                 for (j = 0; j < p.GetCount(); j++)
                     partialExtents->Add(oldWidth + p[j]);
@@ -7333,7 +7736,7 @@ bool wxRichTextPlainText::GetRangeSize(const wxRichTextRange& range, wxSize& siz
             }
             else
             {
-                dc.GetTextExtent(stringFragment, & w, & h);
+                wxRichTextGetTextExtent(extentCache, dc, stringFragment, & w, & h);
                 width += w;
                 absoluteWidth = width + relativeX;
                 haveDescent = true;
@@ -7378,14 +7781,14 @@ bool wxRichTextPlainText::GetRangeSize(const wxRichTextRange& range, wxSize& siz
 
             // Add these partial extents
             wxArrayInt p;
-            dc.GetPartialTextExtents(stringChunk, p);
+            wxRichTextGetPartialTextExtents(extentCache, dc, stringChunk, p);
             size_t j;
             for (j = 0; j < p.GetCount(); j++)
                 partialExtents->Add(oldWidth + p[j]);
         }
         else
         {
-            dc.GetTextExtent(stringChunk, & w, & h, & descent);
+            wxRichTextGetTextExtent(extentCache, dc, stringChunk, & w, & h, & descent);
             width += w;
             haveDescent = true;
         }
@@ -7406,7 +7809,7 @@ bool wxRichTextPlainText::GetRangeSize(const wxRichTextRange& range, wxSize& siz
     }
 
     if (!haveDescent)
-        dc.GetTextExtent(wxT("X"), & w, & h, & descent);
+        wxRichTextGetTextExtent(extentCache, dc, wxT("X"), & w, & h, & descent);
 
     if ( bScript )
         dc.SetFont(font);
@@ -11677,6 +12080,7 @@ public:
         wxRichTextParagraph::ClearDefaultTabs();
         wxRichTextCtrl::ClearAvailableFontNames();
         wxRichTextBuffer::SetRenderer(NULL);
+        wxDELETE(gs_richTextExtentCache);
     }
 };
 
@@ -151,6 +151,46 @@ private:
 };
 #endif
 
+// Lays out a large buffer lazily: only its visible part and the next page, to
+// allow moving the caret to it, are laid out immediately and the rest is done
+// in idle time, see wxRichTextCtrl::OnIdle(). Returns false if the buffer is
+// small enough to be laid out entirely instead.
+static bool wxRichTextLayoutLazily(wxRichTextCtrl& ctrl, wxDC& dc, wxRichTextDrawingContext& context, const wxRect& availableSpace, int flags)
+{
+    wxRichTextBuffer& buffer = ctrl.GetBuffer();
+    if (buffer.GetOwnRange().GetEnd() <= ctrl.GetDelayedLayoutThreshold())
+        return false;
+
+    const int pageHeight = ctrl.GetUnscaledSize(ctrl.GetClientSize()).y;
+    const int top = ctrl.GetUnscaledPoint(ctrl.GetLogicalPoint(wxPoint(0, 0))).y;
+
+    buffer.LayoutLazily(dc, context, availableSpace, availableSpace, flags, top + 2*pageHeight);
+
+    if (flags & wxRICHTEXT_LAYOUT_SPECIFIED_RECT)
+        return true;
+
+    // Also lay out the paragraph containing the caret, wherever it is.
+    wxRichTextParagraph* para = NULL;
+    if (ctrl.GetFocusObject() == &buffer)
+    {
+        para = buffer.GetParagraphAtPosition(wxMax(ctrl.GetCaretPosition(), 0));
+    }
+    else
+    {
+        wxRichTextObject* obj = ctrl.GetFocusObject();
+        while (obj && obj->GetParent() != &buffer)
+            obj = obj->GetParent();
+        para = wxDynamicCast(obj, wxRichTextParagraph);
+    }
+
+    while (para && para->GetLines().empty() && buffer.IsDirty())
+    {
+        buffer.LayoutLazily(dc, context, availableSpace, availableSpace, flags, para->GetPosition().y + pageHeight);
+    }
+
+    return true;
+}
+
 wxIMPLEMENT_DYNAMIC_CLASS(wxRichTextCtrl, wxControl);
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxRichTextEvent, wxNotifyEvent);
@@ -473,9 +513,13 @@ void wxRichTextCtrl::OnPaint(wxPaintEvent& WXUNUSED(event))
             GetBuffer().Defragment(context);
             GetBuffer().UpdateRanges();     // If items were deleted, ranges need recalculation
 
-            DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT);
+            const int flags = wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT;
+            if (!wxRichTextLayoutLazily(*this, dc, context, availableSpace, flags))
+            {
+                DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, flags);
 
-            GetBuffer().Invalidate(wxRICHTEXT_NONE);
+                GetBuffer().Invalidate(wxRICHTEXT_NONE);
+            }
 
             dc.SetUserScale(1.0, 1.0);
 
@@ -2886,6 +2930,49 @@ void wxRichTextCtrl::OnIdle(wxIdleEvent& event)
         ShowPosition(m_fullLayoutSavedPosition);
         Refresh(false);
     }
+    // Continue laying out the parts of a large buffer which were not laid out
+    // yet, see wxRichTextLayoutLazily().
+    else if (!m_fullLayoutRequired && !IsFrozen() && GetBuffer().IsDirty() &&
+                GetBuffer().GetOwnRange().GetEnd() > m_delayedLayoutThreshold)
+    {
+        wxRect availableSpace(GetUnscaledSize(GetClientSize()));
+        if (availableSpace.width == 0)
+            availableSpace.width = 10;
+        if (availableSpace.height == 0)
+            availableSpace.height = 10;
+
+        wxClientDC dc(this);
+
+        PrepareDC(dc);
+        dc.SetFont(GetFont());
+        dc.SetUserScale(GetScale(), GetScale());
+
+        wxRichTextDrawingContext context(& GetBuffer());
+        GetBuffer().Defragment(context);
+        GetBuffer().UpdateRanges();
+
+        // Only refresh the window if its visible part is affected.
+        const int visibleBottom = GetUnscaledPoint(GetLogicalPoint(wxPoint(0, GetClientSize().y))).y;
+        const wxRichTextRange invalidRange = GetBuffer().GetInvalidRange(true);
+        wxRichTextParagraph* const firstInvalid = invalidRange == wxRICHTEXT_ALL
+                                                    ? NULL
+                                                    : GetBuffer().GetParagraphAtPosition(invalidRange.GetStart());
+        const bool refresh = !firstInvalid || firstInvalid->GetPosition().y <= visibleBottom;
+
+        const bool done = GetBuffer().LayoutLazily(dc, context, availableSpace, availableSpace,
+                                                   wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT,
+                                                   -1, wxRICHTEXT_DEFAULT_LAYOUT_SLICE);
+
+        dc.SetUserScale(1.0, 1.0);
+
+        SetupScrollbars();
+
+        if (refresh)
+            Refresh(false);
+
+        if (!done)
+            event.RequestMore();
+    }
 
     const int imageProcessingInterval = wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL;
 
@@ -4305,8 +4392,11 @@ bool wxRichTextCtrl::LayoutContent(bool onlyVisibleRect)
         wxRichTextDrawingContext context(& GetBuffer());
         GetBuffer().Defragment(context);
         GetBuffer().UpdateRanges();     // If items were deleted, ranges need recalculation
-        DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, flags);
-        GetBuffer().Invalidate(wxRICHTEXT_NONE);
+        if (!wxRichTextLayoutLazily(*this, dc, context, availableSpace, flags))
+        {
+            DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, flags);
+            GetBuffer().Invalidate(wxRICHTEXT_NONE);
+        }
 
         dc.SetUserScale(1.0, 1.0);
 
@@ -31,10 +31,22 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 #include <dirent.h>
 
+// Use the type of the entry returned by readdir(), if available, to avoid
+// calling stat() for it and, if we still need to do it, use fstatat() to
+// avoid resolving the entire path again.
+#if defined(DT_DIR) && defined(DT_LNK) && defined(DT_UNKNOWN)
+    #define wxHAS_DIRENT_D_TYPE
+#endif
+
+#ifdef AT_SYMLINK_NOFOLLOW
+    #define wxHAS_FSTATAT
+#endif
+
 // ----------------------------------------------------------------------------
 // macros
 // ----------------------------------------------------------------------------
@@ -63,6 +75,10 @@ public:
     const wxString& GetName() const { return m_dirname; }
 
 private:
+    // Return true if the given entry is a directory, following it if it's a
+    // symlink unless wxDIR_NO_FOLLOW is specified.
+    bool IsDir(const dirent* de) const;
+
     DIR     *m_dir;
 
     wxString m_dirname;
@@ -110,77 +126,108 @@ wxDirData::~wxDirData()
     }
 }
 
-bool wxDirData::Read(wxString *filename)
+bool wxDirData::IsDir(const dirent* de) const
 {
-    dirent *de = NULL;    // just to silence compiler warnings
-    bool matches = false;
+#ifdef wxHAS_DIRENT_D_TYPE
+    switch ( de->d_type )
+    {
+        case DT_DIR:
+            return true;
+
+        case DT_LNK:
+            if ( m_flags & wxDIR_NO_FOLLOW )
+                return false;
+
+            // We need to check what does the link point to.
+            break;
+
+        case DT_UNKNOWN:
+            // Not all file systems fill in the type, so fall back to stat().
+            break;
+
+        default:
+            return false;
+    }
+#endif // wxHAS_DIRENT_D_TYPE
 
-    // speed up string concatenation in the loop a bit
-    wxString path = m_dirname;
-    path += wxT('/');
-    path.reserve(path.length() + 255);
+#ifdef wxHAS_FSTATAT
+    struct stat st;
+    if ( fstatat(dirfd(m_dir), de->d_name, &st,
+                 m_flags & wxDIR_NO_FOLLOW ? AT_SYMLINK_NOFOLLOW : 0) != 0 )
+        return false;
 
+    return S_ISDIR(st.st_mode);
+#else // !wxHAS_FSTATAT
+    wxFileName fn = wxFileName::DirName(m_dirname + wxT('/') +
+                                        wxString(de->d_name, *wxConvFileName));
+    if ( m_flags & wxDIR_NO_FOLLOW )
+    {
+        fn.DontFollowLink();
+    }
+
+    return fn.DirExists();
+#endif // wxHAS_FSTATAT/!wxHAS_FSTATAT
+}
+
+bool wxDirData::Read(wxString *filename)
+{
     wxString de_d_name;
 
-    while ( !matches )
+    for ( ;; )
     {
-        de = readdir(m_dir);
+        const dirent* const de = readdir(m_dir);
         if ( !de )
             return false;
 
-#if wxUSE_UNICODE
-        de_d_name = wxString(de->d_name, *wxConvFileName);
-#else
-        de_d_name = de->d_name;
-#endif
+        const char* const name = de->d_name;
 
         // don't return "." and ".." unless asked for
-        if ( de->d_name[0] == '.' &&
-             ((de->d_name[1] == '.' && de->d_name[2] == '\0') ||
-              (de->d_name[1] == '\0')) )
+        if ( name[0] == '.' &&
+             ((name[1] == '.' && name[2] == '\0') || (name[1] == '\0')) )
         {
             if ( !(m_flags & wxDIR_DOTDOT) )
                 continue;
 
             // we found a valid match
-            break;
+            *filename = wxString(name, *wxConvFileName);
+            return true;
         }
 
-        // check the type now: notice that we may want to check the type of
-        // the path itself and not whatever it points to in case of a symlink
-        wxFileName fn = wxFileName::DirName(path + de_d_name);
-        if ( m_flags & wxDIR_NO_FOLLOW )
+        // check the name first as it's much cheaper than checking the type
+        // which may require a system call
+        if ( m_filespec.empty() )
         {
-            fn.DontFollowLink();
-        }
+            if ( !(m_flags & wxDIR_HIDDEN) && name[0] == '.' )
+                continue;
 
-        if ( !(m_flags & wxDIR_FILES) && !fn.DirExists() )
-        {
-            // it's a file, but we don't want them
-            continue;
+            de_d_name = wxString(name, *wxConvFileName);
         }
-        else if ( !(m_flags & wxDIR_DIRS) && fn.DirExists() )
+        else
         {
-            // it's a dir, and we don't want it
-            continue;
-        }
+            de_d_name = wxString(name, *wxConvFileName);
 
-        // finally, check the name
-        if ( m_filespec.empty() )
-        {
-            matches = m_flags & wxDIR_HIDDEN ? true : de->d_name[0] != '.';
+            // test against the pattern
+            if ( !wxMatchWild(m_filespec, de_d_name,
+                              !(m_flags & wxDIR_HIDDEN)) )
+                continue;
         }
-        else
+
+        // check the type now, unless we want both files and directories:
+        // notice that we may want to check the type of the path itself and
+        // not whatever it points to in case of a symlink
+        if ( (m_flags & (wxDIR_FILES | wxDIR_DIRS)) != (wxDIR_FILES | wxDIR_DIRS) )
         {
-            // test against the pattern
-            matches = wxMatchWild(m_filespec, de_d_name,
-                                  !(m_flags & wxDIR_HIDDEN));
+            if ( !(m_flags & (IsDir(de) ? wxDIR_DIRS : wxDIR_FILES)) )
+            {
+                // we don't want this kind of entries
+                continue;
+            }
         }
-    }
 
-    *filename = de_d_name;
+        *filename = de_d_name;
 
-    return true;
+        return true;
+    }
 }
 
 #else // old VMS (TODO)
@@ -19,6 +19,7 @@
 
 #include <sys/inotify.h>
 #include <unistd.h>
+#include "wx/hashset.h"
 #include "wx/private/fswatcher.h"
 
 // ============================================================================
@@ -33,6 +34,46 @@ WX_DECLARE_HASH_MAP(int, wxFSWatchEntry*, wxIntegerHash, wxIntegerEqual,
 WX_DECLARE_HASH_MAP(int, inotify_event*, wxIntegerHash, wxIntegerEqual,
                                                       wxInotifyCookies);
 
+// set of recently removed inotify watch descriptors
+WX_DECLARE_HASH_SET(int, wxIntegerHash, wxIntegerEqual,
+                                              wxInotifyDescriptors);
+
+// Hash and compare inotify events by their watch descriptor, mask and name,
+// i.e. by everything but the cookie, which is only used by rename events.
+struct wxInotifyEventHash
+{
+    wxInotifyEventHash() { }
+
+    unsigned long operator()(const inotify_event* e) const
+    {
+        unsigned long hash = e->wd * 31 + e->mask;
+        for ( const char* p = e->len ? e->name : ""; *p; ++p )
+            hash = hash * 31 + static_cast<unsigned char>(*p);
+        return hash;
+    }
+};
+
+struct wxInotifyEventEqual
+{
+    wxInotifyEventEqual() { }
+
+    bool operator()(const inotify_event* a, const inotify_event* b) const
+    {
+        return a->wd == b->wd && a->mask == b->mask && a->len == b->len &&
+                memcmp(a->name, b->name, a->len) == 0;
+    }
+};
+
+// set of events, pointing into the read buffer, processed in the current batch
+typedef const inotify_event* wxInotifyEventPtr;
+WX_DECLARE_HASH_SET(wxInotifyEventPtr, wxInotifyEventHash, wxInotifyEventEqual,
+                                                         wxInotifyEvents);
+
+// Size of the buffer used for reading the events: this must be big enough to
+// allow reading many events at once, both because it's faster and because the
+// more events we get in a batch, the more of them can be coalesced.
+static const size_t wxINOTIFY_BUFFER_SIZE = 64*1024;
+
 /**
  * Helper class encapsulating inotify mechanism
  */
@@ -95,12 +136,41 @@ public:
         }
     }
 
+    virtual bool Add(const wxFSWatchInfo& winfo) wxOVERRIDE
+    {
+        const wxString& path = winfo.GetPath();
+        if ( m_watches.find(path) != m_watches.end() )
+        {
+            wxLogTrace(wxTRACE_FSWATCHER,
+                       "Path '%s' is already watched", path);
+            // This can happen if a dir is watched, then a parent tree added
+            return true;
+        }
+
+        // construct watch entry sharing the path with its parent, if possible
+        wxSharedPtr<wxFSWatchEntry> watch(new wxFSWatchEntry(winfo,
+                                                             FindParent(path)));
+
+        if (!DoAdd(watch, path))
+            return false;
+
+        // add watch to our map (always succeeds, checked above)
+        wxFSWatchEntries::value_type val(path, watch);
+        return m_watches.insert(val).second;
+    }
+
     virtual bool DoAdd(wxSharedPtr<wxFSWatchEntryUnix> watch) wxOVERRIDE
+    {
+        return DoAdd(watch, watch->GetPath());
+    }
+
+    bool DoAdd(const wxSharedPtr<wxFSWatchEntryUnix>& watch,
+               const wxString& path)
     {
         wxCHECK_MSG( IsOk(), false,
                     "Inotify not initialized or invalid inotify descriptor" );
 
-        int wd = DoAddInotify(watch.get());
+        int wd = DoAddInotify(watch.get(), path);
         if (wd == -1)
         {
             wxLogSysError( _("Unable to add inotify watch") );
@@ -111,7 +181,7 @@ public:
         if (!m_watchMap.insert(val).second)
         {
             wxFAIL_MSG( wxString::Format( "Path %s is already watched",
-                                           watch->GetPath()) );
+                                           path) );
             return false;
         }
 
@@ -148,7 +218,7 @@ public:
                                           watch->GetPath()) );
         }
         // Cache the wd in case any events arrive late
-        m_staleDescriptors.Add(watch->GetWatchDescriptor());
+        m_staleDescriptors.insert(watch->GetWatchDescriptor());
 
         watch->SetWatchDescriptor(-1);
         return true;
@@ -170,23 +240,27 @@ public:
         wxCHECK_MSG( IsOk(), -1,
                     "Inotify not initialized or invalid inotify descriptor" );
 
-        // read events
-        // TODO differentiate depending on params
-        char buf[128 * sizeof(inotify_event)];
-        int left = ReadEventsToBuf(buf, sizeof(buf));
+        // read events into a buffer which is allocated on every call, as
+        // this function is reentered if an event handler runs an event loop
+        wxMemoryBuffer buffer(wxINOTIFY_BUFFER_SIZE);
+        char* const buf = static_cast<char*>(buffer.GetData());
+        int left = ReadEventsToBuf(buf, buffer.GetBufSize());
         if (left == -1)
             return -1;
 
         // left > 0, we have events
         char* memory = buf;
         int event_count = 0;
+        wxInotifyEvents batchEvents;
         while (left > 0) // OPT checking 'memory' would suffice
         {
             event_count++;
             inotify_event* e = (inotify_event*)memory;
 
-            // process one inotify_event
-            ProcessNativeEvent(*e);
+            // process one inotify_event, unless it can be coalesced with an
+            // identical one that we've already processed
+            if ( !CoalesceNativeEvent(batchEvents, *e) )
+                ProcessNativeEvent(*e);
 
             int offset = sizeof(inotify_event) + e->len;
             left -= offset;
@@ -206,10 +280,31 @@ public:
     }
 
 protected:
-    int DoAddInotify(wxFSWatchEntry* watch)
+    // Find the entry of the directory containing the given path, if any.
+    wxSharedPtr<wxFSWatchEntry> FindParent(const wxString& path)
+    {
+        size_t len = path.length();
+        if ( len > 1 && path[len - 1] == '/' )
+            len--;
+
+        const size_t pos = len ? path.rfind('/', len - 1) : wxString::npos;
+        if ( pos == wxString::npos || pos + 1 >= len )
+            return wxSharedPtr<wxFSWatchEntry>();
+
+        // reuse the same string to avoid allocating it for every new entry
+        m_parentPath.assign(path, 0, pos + 1);
+
+        wxFSWatchEntries::const_iterator it = m_watches.find(m_parentPath);
+        if ( it == m_watches.end() )
+            return wxSharedPtr<wxFSWatchEntry>();
+
+        return it->second;
+    }
+
+    int DoAddInotify(wxFSWatchEntry* watch, const wxString& path)
     {
         int flags = Watcher2NativeFlags(watch->GetFlags());
-        int wd = inotify_add_watch(m_ifd, watch->GetPath().fn_str(), flags);
+        int wd = inotify_add_watch(m_ifd, path.fn_str(), flags);
         // finally we can set watch descriptor
         watch->SetWatchDescriptor(wd);
         return wd;
@@ -220,6 +315,32 @@ protected:
         return inotify_rm_watch(m_ifd, watch->GetWatchDescriptor());
     }
 
+    // Return true if this event is the same as an event already processed in
+    // the current batch and so doesn't need to be processed again.
+    //
+    // This is used to coalesce the bursts of events, such as IN_MODIFY ones,
+    // which are generated when a file is being written to. Only the events not
+    // changing the set of files are coalesced and any other event starts a new
+    // sequence of them, so that the order of events for any file is kept.
+    static bool CoalesceNativeEvent(wxInotifyEvents& batchEvents,
+                                    const inotify_event& inevt)
+    {
+        static const uint32_t coalescable = IN_ACCESS | IN_MODIFY | IN_ATTRIB |
+                                            IN_OPEN | IN_CLOSE | IN_ISDIR;
+
+        if ( inevt.wd == -1 || (inevt.mask & ~coalescable) )
+        {
+            batchEvents.clear();
+            return false;
+        }
+
+        if ( batchEvents.insert(&inevt).second )
+            return false;
+
+        wxLogTrace(wxTRACE_FSWATCHER, "Coalesced event for wd=%d", inevt.wd);
+        return true;
+    }
+
     void ProcessNativeEvent(const inotify_event& inevt)
     {
         wxLogTrace(wxTRACE_FSWATCHER, InotifyEventToString(inevt));
@@ -232,10 +353,8 @@ protected:
             // won't get any more events for it.
             // However if we're here because a dir that we're still watching
             // has just been deleted, its wd won't be on this list
-            const int pos = m_staleDescriptors.Index(inevt.wd);
-            if ( pos != wxNOT_FOUND )
+            if ( m_staleDescriptors.erase(inevt.wd) )
             {
-                m_staleDescriptors.RemoveAt(static_cast<size_t>(pos));
                 wxLogTrace(wxTRACE_FSWATCHER,
                        "Removed wd %i from the stale-wd cache", inevt.wd);
             }
@@ -251,7 +370,7 @@ protected:
             if (it == m_watchMap.end())
             {
                 // It's not in the map; check if was recently removed from it.
-                if (m_staleDescriptors.Index(inevt.wd) != wxNOT_FOUND)
+                if (m_staleDescriptors.count(inevt.wd))
                 {
                     wxLogTrace(wxTRACE_FSWATCHER,
                                "Got an event for stale wd %i", inevt.wd);
@@ -399,7 +518,7 @@ protected:
                 }
 
                 // Cache the wd in case any events arrive late
-                m_staleDescriptors.Add(inevt.wd);
+                m_staleDescriptors.insert(inevt.wd);
             }
 
             // Tell the owner, in case it's interested
@@ -546,7 +665,6 @@ protected:
         wxCHECK_MSG( IsOk(), false,
                     "Inotify not initialized or invalid inotify descriptor" );
 
-        memset(buf, 0, size);
         ssize_t left = read(m_ifd, buf, size);
         if (left == -1)
         {
@@ -579,12 +697,12 @@ protected:
                                    const inotify_event& inevt)
     {
         // only when dir is watched, we have non-empty e.name
-        wxFileName path = watch.GetPath();
-        if (path.IsDir() && inevt.len)
+        const wxString path = watch.GetPath();
+        if (inevt.len && !path.empty() && path.Last() == '/')
         {
-            path = wxFileName(path.GetPath(), inevt.name);
+            return wxFileName(path, inevt.name);
         }
-        return path;
+        return wxFileName(path);
     }
 
     static int Watcher2NativeFlags(int flags)
@@ -653,8 +771,9 @@ protected:
 
     wxFSWSourceHandler* m_handler;        // handler for inotify event source
     wxFSWatchEntryDescriptors m_watchMap; // inotify wd=>wxFSWatchEntry* map
-    wxArrayInt m_staleDescriptors;        // stores recently-removed watches
+    wxInotifyDescriptors m_staleDescriptors; // recently-removed watches
     wxInotifyCookies m_cookies;           // map to track renames
+    wxString m_parentPath;                // used by FindParent() only
     wxEventLoopSource* m_source;          // our event loop source
 
     // file descriptor created by inotify_init()
@@ -23,8 +23,6 @@
     #include "wx/log.h"
     #include "wx/module.h"
     #include "wx/app.h"
-    #include "wx/list.h"
-    #include "wx/hashmap.h"
     #include "wx/event.h"
 #endif
 
@@ -38,8 +36,9 @@
 
 #include "wx/unix/private/timer.h"
 
-#include "wx/listimpl.cpp"
-WX_DEFINE_LIST(wxTimerList)
+#if wxUSE_SYSTEM_OPTIONS
+    #include "wx/sysopt.h"
+#endif
 
 // trace mask for the debugging messages used here
 #define wxTrace_Timer wxT("timer")
@@ -50,58 +49,111 @@ WX_DEFINE_LIST(wxTimerList)
 
 wxTimerScheduler *wxTimerScheduler::ms_instance = NULL;
 
-wxTimerScheduler::~wxTimerScheduler()
+wxTimerScheduler::wxTimerScheduler()
 {
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
-    {
-        delete *node;
-    }
+    m_nextOrder = 0;
+    m_slack = 0;
+
+#if wxUSE_SYSTEM_OPTIONS
+    const int slackMs = wxSystemOptions::GetOptionInt("unix.timer-slack");
+    if ( slackMs > 0 )
+        m_slack = static_cast<wxUsecClock_t>(slackMs)*1000;
+#endif // wxUSE_SYSTEM_OPTIONS
+
+    m_numIterations =
+    m_numNotified = 0;
 }
 
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    DoAddTimer(new wxTimerSchedule(timer, expiration));
+    wxASSERT_MSG( timer->m_heapIndex >= m_timers.size() ||
+                    m_timers[timer->m_heapIndex].m_timer != timer,
+                  wxT("adding the same timer twice?") );
+
+    DoAddTimer(wxTimerSchedule(timer, expiration, m_nextOrder++));
+
+    wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
+               timer->GetId(),
+               expiration.ToString());
+}
+
+void wxTimerScheduler::DoAddTimer(const wxTimerSchedule& s)
+{
+    m_timers.push_back(s);
+    s.m_timer->m_heapIndex = m_timers.size() - 1;
+
+    DoSiftUp(m_timers.size() - 1);
 }
 
-void wxTimerScheduler::DoAddTimer(wxTimerSchedule *s)
+void wxTimerScheduler::DoRemoveAt(size_t n)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
+    const wxTimerSchedule last = m_timers.back();
+    m_timers.pop_back();
+
+    if ( n == m_timers.size() )
     {
-        wxASSERT_MSG( (*node)->m_timer != s->m_timer,
-                      wxT("adding the same timer twice?") );
+        // we removed the last element, nothing else to do
+        return;
+    }
+
+    // put the last element in place of the removed one and move it to its
+    // right place, which can be either above or below it
+    DoPlaceAt(n, last);
+
+    if ( n > 0 && last.IsBefore(m_timers[(n - 1) / 2]) )
+        DoSiftUp(n);
+    else
+        DoSiftDown(n);
+}
 
-        if ( (*node)->m_expiration > s->m_expiration )
+void wxTimerScheduler::DoSiftUp(size_t n)
+{
+    const wxTimerSchedule s = m_timers[n];
+    while ( n > 0 )
+    {
+        const size_t parent = (n - 1) / 2;
+        if ( !s.IsBefore(m_timers[parent]) )
             break;
+
+        DoPlaceAt(n, m_timers[parent]);
+        n = parent;
     }
 
-    m_timers.insert(node, s);
+    DoPlaceAt(n, s);
+}
 
-    wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
-               s->m_timer->GetId(),
-               s->m_expiration.ToString());
+void wxTimerScheduler::DoSiftDown(size_t n)
+{
+    const size_t count = m_timers.size();
+    const wxTimerSchedule s = m_timers[n];
+    for ( ;; )
+    {
+        size_t child = 2*n + 1;
+        if ( child >= count )
+            break;
+
+        if ( child + 1 < count && m_timers[child + 1].IsBefore(m_timers[child]) )
+            child++;
+
+        if ( !m_timers[child].IsBefore(s) )
+            break;
+
+        DoPlaceAt(n, m_timers[child]);
+        n = child;
+    }
+
+    DoPlaceAt(n, s);
 }
 
 void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
-    {
-        if ( (*node)->m_timer == timer )
-        {
-            delete *node;
-            m_timers.erase(node);
-            return;
-        }
-    }
+    const size_t n = timer->m_heapIndex;
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("removing inexistent timer?") );
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    DoRemoveAt(n);
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -111,7 +163,10 @@ bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
 
     wxCHECK_MSG( remaining, false, wxT("NULL pointer") );
 
-    *remaining = (*m_timers.begin())->m_expiration - wxGetUTCTimeUSec();
+    // notice that we can wait for up to m_slack after the first timer
+    // expiration, NotifyExpired() will then notify all the timers which
+    // have expired by then at once
+    *remaining = m_timers[0].m_expiration + m_slack - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -126,37 +181,35 @@ bool wxTimerScheduler::NotifyExpired()
     if ( m_timers.empty() )
       return false;
 
+    m_numIterations++;
+
     const wxUsecClock_t now = wxGetUTCTimeUSec();
 
+    // don't notify the periodic timers rescheduled by this loop again, this
+    // could happen if their interval is 0
+    const wxUint64 endOrder = m_nextOrder;
+
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() )
     {
-        wxTimerSchedule * const s = *cur;
-        if ( s->m_expiration > now )
+        wxTimerSchedule s = m_timers[0];
+        if ( s.m_expiration > now || s.m_order >= endOrder )
         {
-            // as the list is sorted by expiration time, we can skip the rest
+            // as the heap top is the timer expiring first, we can skip the rest
             break;
         }
 
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
-
-        m_timers.erase(cur);
-
         // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s->m_timer;
+        wxUnixTimerImpl * const timer = s.m_timer;
         if ( timer->IsOneShot() )
         {
+            DoRemoveAt(0);
+
             // the timer needs to be stopped but don't call its Stop() from
-            // here as it would attempt to remove the timer from our list and
+            // here as it would attempt to remove the timer from our heap and
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
-
-            // don't need it any more
-            delete s;
         }
         else // reschedule the next timer expiration
         {
@@ -164,20 +217,29 @@ bool wxTimerScheduler::NotifyExpired()
             // the current time instead of just offsetting it from the current
             // expiration time because it could happen that we're late and the
             // current expiration time is (far) in the past
-            s->m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
+            s.m_expiration = now + timer->GetInterval()*1000;
+            s.m_order = m_nextOrder++;
+
+            DoPlaceAt(0, s);
+            DoSiftDown(0);
         }
 
         // we can't notify the timer from this loop as the timer event handler
         // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
+        // timer), so do it after the loop end
         toNotify.push_back(timer);
     }
 
     if ( toNotify.empty() )
         return false;
 
+    m_numNotified += toNotify.size();
+
+    wxLogTrace(wxTrace_Timer,
+               wxT("Notifying %lu timers (%lu timers in %lu iterations so far)"),
+               static_cast<unsigned long>(toNotify.size()),
+               m_numNotified, m_numIterations);
+
     for ( TimerImpls::const_iterator i = toNotify.begin(),
                                      end = toNotify.end();
           i != end;
@@ -197,6 +259,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_heapIndex = static_cast<size_t>(-1);
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
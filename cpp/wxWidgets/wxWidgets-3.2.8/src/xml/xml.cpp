@@ -19,6 +19,7 @@
     #include "wx/intl.h"
     #include "wx/log.h"
     #include "wx/app.h"
+    #include "wx/hashmap.h"
 #endif
 
 #include "wx/wfstream.h"
@@ -877,6 +878,213 @@ static int UnknownEncodingHnd(void * WXUNUSED(encodingHandlerData),
 
 } // extern "C"
 
+#if wxABI_VERSION >= 30209
+
+//-----------------------------------------------------------------------------
+//  binary documents
+//-----------------------------------------------------------------------------
+
+// Documents saved by SaveBinary() consist of this signature, which can't
+// occur at the start of a valid XML document, followed by the format version
+// and the table of all strings used in the document. The strings are then
+// referred to by their indices in the tree of nodes which follows, each node
+// being followed by its attributes and children.
+//
+// All numbers are stored as little endian base 128 varints.
+static const char wxXmlBinarySignature[8] =
+    { '\x89', 'w', 'x', 'X', 'M', 'L', '\r', '\n' };
+static const size_t wxXmlBinaryVersion = 1;
+
+// Sequential reader of the binary data checking for its validity.
+class wxXmlBinaryReader
+{
+public:
+    wxXmlBinaryReader(const char *data, size_t len)
+        : m_ptr(reinterpret_cast<const unsigned char *>(data)),
+          m_end(m_ptr + len)
+    {
+    }
+
+    bool ReadNumber(size_t& value)
+    {
+        value = 0;
+        for ( unsigned shift = 0; m_ptr != m_end; shift += 7 )
+        {
+            if ( shift >= 8*sizeof(size_t) )
+                return false;
+
+            const unsigned char c = *m_ptr++;
+            value |= static_cast<size_t>(c & 0x7f) << shift;
+            if ( !(c & 0x80) )
+                return true;
+        }
+
+        return false;
+    }
+
+    bool ReadString(const wxVector<wxString>& strings, const wxString *& str)
+    {
+        size_t n;
+        if ( !ReadNumber(n) || n >= strings.size() )
+            return false;
+
+        str = &strings[n];
+        return true;
+    }
+
+    const char *ReadBytes(size_t len)
+    {
+        if ( static_cast<size_t>(m_end - m_ptr) < len )
+            return NULL;
+
+        const char * const p = reinterpret_cast<const char *>(m_ptr);
+        m_ptr += len;
+        return p;
+    }
+
+private:
+    const unsigned char *m_ptr;
+    const unsigned char * const m_end;
+};
+
+// Loads the document contents following the signature from the stream.
+static bool
+LoadBinaryDocument(wxXmlDocument& doc, wxInputStream& stream, wxMBConv *conv)
+{
+    wxMemoryBuffer data;
+    for ( ;; )
+    {
+        const size_t CHUNK_SIZE = 65536;
+        void * const buf = data.GetAppendBuf(CHUNK_SIZE);
+        const size_t len = stream.Read(buf, CHUNK_SIZE).LastRead();
+        data.UngetAppendBuf(len);
+        if ( !len )
+            break;
+    }
+
+    wxXmlBinaryReader reader(static_cast<const char *>(data.GetData()),
+                             data.GetDataLen());
+
+    size_t version, count;
+    if ( !reader.ReadNumber(version) || version != wxXmlBinaryVersion ||
+            !reader.ReadNumber(count) )
+        return false;
+
+    // every string takes at least one byte
+    if ( count > data.GetDataLen() )
+        return false;
+
+    wxVector<wxString> strings;
+    strings.reserve(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        size_t len;
+        const char *s;
+        if ( !reader.ReadNumber(len) || (s = reader.ReadBytes(len)) == NULL )
+            return false;
+
+        strings.push_back(len ? CharToString(conv, s, len) : wxString());
+    }
+
+    const wxString *docVersion, *fileEncoding, *rootName, *systemId, *publicId;
+    size_t fileType;
+    if ( !reader.ReadString(strings, docVersion) ||
+            !reader.ReadString(strings, fileEncoding) ||
+            !reader.ReadString(strings, rootName) ||
+            !reader.ReadString(strings, systemId) ||
+            !reader.ReadString(strings, publicId) ||
+            !reader.ReadNumber(fileType) ||
+            fileType > wxTextFileType_Os2 )
+        return false;
+
+    // read the nodes without recursion, keeping the number of children which
+    // remain to be read for all the nodes on the current path
+    wxScopedPtr<wxXmlNode> root(new wxXmlNode(wxXML_DOCUMENT_NODE, wxString()));
+    wxXmlNode *parent = NULL;
+    wxXmlNode *lastChild = NULL;
+    wxVector<size_t> remaining;
+    for ( ;; )
+    {
+        wxXmlNode *node;
+        if ( !parent )
+        {
+            node = root.get();
+        }
+        else
+        {
+            size_t type, noConversion, lineNo;
+            const wxString *name, *content;
+            if ( !reader.ReadNumber(type) ||
+                    type < wxXML_ELEMENT_NODE ||
+                    type > wxXML_HTML_DOCUMENT_NODE ||
+                    !reader.ReadNumber(noConversion) ||
+                    !reader.ReadString(strings, name) ||
+                    !reader.ReadString(strings, content) ||
+                    !reader.ReadNumber(lineNo) )
+                return false;
+
+            node = new wxXmlNode(static_cast<wxXmlNodeType>(type), *name,
+                                 *content, static_cast<int>(lineNo) - 1);
+            node->SetNoConversion(noConversion != 0);
+            parent->InsertChildAfter(node, lastChild);
+        }
+
+        size_t attrCount;
+        if ( !reader.ReadNumber(attrCount) )
+            return false;
+
+        wxXmlAttribute *lastAttr = NULL;
+        for ( size_t n = 0; n < attrCount; n++ )
+        {
+            const wxString *name, *value;
+            if ( !reader.ReadString(strings, name) ||
+                    !reader.ReadString(strings, value) )
+                return false;
+
+            wxXmlAttribute * const attr = new wxXmlAttribute(*name, *value);
+            if ( lastAttr )
+                lastAttr->SetNext(attr);
+            else
+                node->SetAttributes(attr);
+            lastAttr = attr;
+        }
+
+        size_t childCount;
+        if ( !reader.ReadNumber(childCount) )
+            return false;
+
+        if ( childCount )
+        {
+            remaining.push_back(childCount);
+            parent = node;
+            lastChild = NULL;
+            continue;
+        }
+
+        // go to the next sibling of this node or of its closest ancestor
+        lastChild = node;
+        while ( !remaining.empty() && !--remaining.back() )
+        {
+            remaining.pop_back();
+            lastChild = parent;
+            parent = parent->GetParent();
+        }
+
+        if ( remaining.empty() )
+            break;
+    }
+
+    doc.SetVersion(*docVersion);
+    doc.SetFileEncoding(*fileEncoding);
+    doc.SetDoctype(wxXmlDoctype(*rootName, *systemId, *publicId));
+    doc.SetFileType(static_cast<wxTextFileType>(fileType));
+    doc.SetDocumentNode(root.release());
+
+    return true;
+}
+
+#endif // wxABI_VERSION >= 3.2.9
+
 bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int flags)
 {
 #if wxUSE_UNICODE
@@ -885,74 +1093,1291 @@ bool wxXmlDocument::Load(wxInputStream& stream, const wxString& encoding, int fl
     m_encoding = encoding;
 #endif
 
-    const size_t BUFSIZE = 1024;
-    char buf[BUFSIZE];
-    wxXmlParsingContext ctx;
-    bool done;
-    XML_Parser parser = XML_ParserCreate(NULL);
-    wxXmlNode *root = new wxXmlNode(wxXML_DOCUMENT_NODE, wxEmptyString);
+#if wxABI_VERSION >= 30209
+    char sig[sizeof(wxXmlBinarySignature)];
+    const size_t sigLen = stream.Read(sig, sizeof(sig)).LastRead();
+    if ( sigLen == sizeof(sig) &&
+            memcmp(sig, wxXmlBinarySignature, sizeof(sig)) == 0 )
+    {
+        wxScopedPtr<wxMBConv> conv;
+#if !wxUSE_UNICODE
+        if ( encoding.CmpNoCase(wxS("UTF-8")) != 0 )
+            conv.reset(new wxCSConv(encoding));
+#endif
+
+        if ( !LoadBinaryDocument(*this, stream, conv.get()) )
+        {
+            wxLogError(_("Binary XML document is corrupted."));
+            return false;
+        }
+
+        return true;
+    }
+#endif // wxABI_VERSION >= 3.2.9
+
+    const size_t BUFSIZE = 1024;
+    char buf[BUFSIZE];
+    wxXmlParsingContext ctx;
+    bool done;
+    XML_Parser parser = XML_ParserCreate(NULL);
+    wxXmlNode *root = new wxXmlNode(wxXML_DOCUMENT_NODE, wxEmptyString);
+
+    ctx.encoding = wxS("UTF-8"); // default in absence of encoding=""
+    ctx.conv = NULL;
+#if !wxUSE_UNICODE
+    if ( encoding.CmpNoCase(wxS("UTF-8")) != 0 )
+        ctx.conv = new wxCSConv(encoding);
+#endif
+    ctx.doctype = &m_doctype;
+    ctx.removeWhiteOnlyNodes = (flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0;
+    ctx.parser = parser;
+    ctx.node = root;
+
+    XML_SetUserData(parser, (void*)&ctx);
+    XML_SetElementHandler(parser, StartElementHnd, EndElementHnd);
+    XML_SetCharacterDataHandler(parser, TextHnd);
+    XML_SetCdataSectionHandler(parser, StartCdataHnd, EndCdataHnd);
+    XML_SetCommentHandler(parser, CommentHnd);
+    XML_SetProcessingInstructionHandler(parser, PIHnd);
+    XML_SetDoctypeDeclHandler(parser, StartDoctypeHnd, EndDoctypeHnd);
+    XML_SetDefaultHandler(parser, DefaultHnd);
+    XML_SetUnknownEncodingHandler(parser, UnknownEncodingHnd, NULL);
+
+    // the bytes already read (if any) are parsed as XML together with the
+    // first chunk
+    size_t start = 0;
+#if wxABI_VERSION >= 30209
+    memcpy(buf, sig, sigLen);
+    start = sigLen;
+#endif // wxABI_VERSION >= 3.2.9
+
+    bool ok = true;
+    do
+    {
+        size_t len = start + stream.Read(buf + start, BUFSIZE - start).LastRead();
+        start = 0;
+        done = (len < BUFSIZE);
+        if (!XML_Parse(parser, buf, len, done))
+        {
+            wxString error(XML_ErrorString(XML_GetErrorCode(parser)),
+                           *wxConvCurrent);
+            wxLogError(_("XML parsing error: '%s' at line %d"),
+                       error.c_str(),
+                       (int)XML_GetCurrentLineNumber(parser));
+            ok = false;
+            break;
+        }
+    } while (!done);
+
+    if (ok)
+    {
+        if (!ctx.version.empty())
+            SetVersion(ctx.version);
+        if (!ctx.encoding.empty())
+            SetFileEncoding(ctx.encoding);
+        SetDocumentNode(root);
+    }
+    else
+    {
+        delete root;
+    }
+
+    XML_ParserFree(parser);
+#if !wxUSE_UNICODE
+    if ( ctx.conv )
+        delete ctx.conv;
+#endif
+
+    return ok;
+
+}
+
+
+#if wxABI_VERSION >= 30209
+
+//-----------------------------------------------------------------------------
+//  wxXmlReader
+//-----------------------------------------------------------------------------
+
+// returns the string used by the accessors when there is no current item
+static const wxString& GetEmptyXmlString()
+{
+    static const wxString s_empty;
+    return s_empty;
+}
+
+static wxMBConv *CreateXmlConv(const wxString& encoding)
+{
+#if !wxUSE_UNICODE
+    if ( encoding.CmpNoCase(wxS("UTF-8")) != 0 )
+        return new wxCSConv(encoding);
+#else
+    wxUnusedVar(encoding);
+#endif
+
+    return NULL;
+}
+
+// Table of the element and attribute names: as there are usually only a few
+// different ones, each of them is converted to wxString only once and shared
+// by all the items using it.
+class wxXmlNameTable
+{
+public:
+    explicit wxXmlNameTable(wxMBConv *conv)
+        : m_conv(conv),
+          m_count(0)
+    {
+        m_slots.resize(64);
+    }
+
+    ~wxXmlNameTable()
+    {
+        for ( size_t n = 0; n < m_slots.size(); n++ )
+        {
+            delete [] m_slots[n].key;
+            delete m_slots[n].name;
+        }
+    }
+
+    const wxString *Intern(const char *s, size_t len)
+    {
+        // FNV-1a hash
+        wxUint32 hash = 2166136261u;
+        for ( size_t n = 0; n < len; n++ )
+        {
+            hash ^= static_cast<unsigned char>(s[n]);
+            hash *= 16777619u;
+        }
+
+        const size_t mask = m_slots.size() - 1;
+        size_t n;
+        for ( n = hash & mask; m_slots[n].name; n = (n + 1) & mask )
+        {
+            const Slot& slot = m_slots[n];
+            if ( slot.hash == hash && slot.len == len &&
+                    memcmp(slot.key, s, len) == 0 )
+                return slot.name;
+        }
+
+        Slot& slot = m_slots[n];
+        slot.hash = hash;
+        slot.len = len;
+        slot.key = new char[len + 1];
+        memcpy(slot.key, s, len);
+        slot.name = new wxString(CharToString(m_conv, s, len));
+
+        const wxString * const name = slot.name;
+
+        // keep the table at most half full
+        if ( ++m_count * 2 > m_slots.size() )
+            Grow();
+
+        return name;
+    }
+
+    const wxString *Intern(const char *s)
+    {
+        return Intern(s, strlen(s));
+    }
+
+private:
+    struct Slot
+    {
+        Slot() : hash(0), len(0), key(NULL), name(NULL) {}
+
+        wxUint32 hash;
+        size_t len;
+        char *key;
+        wxString *name;
+    };
+
+    void Grow()
+    {
+        wxVector<Slot> slots(m_slots.size() * 2);
+        const size_t mask = slots.size() - 1;
+
+        for ( size_t n = 0; n < m_slots.size(); n++ )
+        {
+            const Slot& slot = m_slots[n];
+            if ( !slot.name )
+                continue;
+
+            size_t i = slot.hash & mask;
+            while ( slots[i].name )
+                i = (i + 1) & mask;
+
+            slots[i] = slot;
+        }
+
+        m_slots.swap(slots);
+    }
+
+    wxMBConv * const m_conv;
+    wxVector<Slot> m_slots;
+    size_t m_count;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlNameTable);
+};
+
+struct wxXmlReaderAttr
+{
+    const wxString *name;
+    size_t value;           // offset of the value in wxXmlReaderImpl::m_pool
+    size_t valueLen;
+};
+
+struct wxXmlReaderItem
+{
+    wxXmlReader::Event event;
+    const wxString *name;
+    size_t text;            // offset of the text in wxXmlReaderImpl::m_pool
+    size_t textLen;
+    size_t attrs;           // index of the first attribute in m_attrs
+    size_t attrCount;
+    int depth;
+    int lineNo;
+};
+
+static wxXmlNodeType GetXmlNodeType(wxXmlReader::Event event)
+{
+    switch ( event )
+    {
+        case wxXmlReader::Event_StartElement:
+            return wxXML_ELEMENT_NODE;
+
+        case wxXmlReader::Event_Text:
+            return wxXML_TEXT_NODE;
+
+        case wxXmlReader::Event_CData:
+            return wxXML_CDATA_SECTION_NODE;
+
+        case wxXmlReader::Event_Comment:
+            return wxXML_COMMENT_NODE;
+
+        case wxXmlReader::Event_PI:
+            return wxXML_PI_NODE;
+
+        case wxXmlReader::Event_None:
+        case wxXmlReader::Event_EndElement:
+            break;
+    }
+
+    wxFAIL_MSG( "no node corresponds to this item" );
+    return wxXML_ELEMENT_NODE;
+}
+
+extern "C" {
+static void ReaderStartElementHnd(void *userData, const char *name, const char **atts);
+static void ReaderEndElementHnd(void *userData, const char *name);
+static void ReaderTextHnd(void *userData, const char *s, int len);
+static void ReaderStartCdataHnd(void *userData);
+static void ReaderEndCdataHnd(void *userData);
+static void ReaderCommentHnd(void *userData, const char *data);
+static void ReaderPIHnd(void *userData, const char *target, const char *data);
+static void ReaderDefaultHnd(void *userData, const char *s, int len);
+}
+
+// The parser is fed with the input by big chunks and all the items found in
+// the chunk are queued, so that the memory used doesn't depend on the
+// document size but we still don't need to suspend expat after each item.
+class wxXmlReaderImpl
+{
+public:
+    wxXmlReaderImpl(wxInputStream& stream, const wxString& encoding, int flags)
+        : m_stream(stream),
+          m_conv(CreateXmlConv(encoding)),
+          m_ownNames(new wxXmlNameTable(m_conv)),
+          m_names(m_ownNames),
+          m_current(0),
+          m_depth(0),
+          m_textLine(-1),
+          m_hasText(false),
+          m_inCData(false),
+          m_removeWhiteOnlyNodes((flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0),
+          m_done(false),
+          m_ok(true)
+    {
+        m_parser = XML_ParserCreate(NULL);
+
+        XML_SetUserData(m_parser, this);
+        XML_SetElementHandler(m_parser, ReaderStartElementHnd, ReaderEndElementHnd);
+        XML_SetCharacterDataHandler(m_parser, ReaderTextHnd);
+        XML_SetCdataSectionHandler(m_parser, ReaderStartCdataHnd, ReaderEndCdataHnd);
+        XML_SetCommentHandler(m_parser, ReaderCommentHnd);
+        XML_SetProcessingInstructionHandler(m_parser, ReaderPIHnd);
+        XML_SetDefaultHandler(m_parser, ReaderDefaultHnd);
+        XML_SetUnknownEncodingHandler(m_parser, UnknownEncodingHnd, NULL);
+
+        m_textName = m_names->Intern("text");
+        m_cdataName = m_names->Intern("cdata");
+        m_commentName = m_names->Intern("comment");
+    }
+
+    ~wxXmlReaderImpl()
+    {
+        XML_ParserFree(m_parser);
+        delete m_ownNames;
+        delete m_conv;
+    }
+
+    // Use the given table for the names instead of our own one, must be
+    // called before starting parsing.
+    void UseNames(wxXmlNameTable *names)
+    {
+        wxDELETE(m_ownNames);
+        m_names = names;
+
+        m_textName = m_names->Intern("text");
+        m_cdataName = m_names->Intern("cdata");
+        m_commentName = m_names->Intern("comment");
+    }
+
+    wxXmlReader::Event Next()
+    {
+        if ( m_current + 1 < m_items.size() )
+            return m_items[++m_current].event;
+
+        // all the queued items were consumed, reuse the memory for new ones
+        m_items.clear();
+        m_attrs.clear();
+        m_pool.SetDataLen(0);
+        m_current = 0;
+
+        while ( m_items.empty() )
+        {
+            if ( m_done || !ParseMore() )
+                return wxXmlReader::Event_None;
+        }
+
+        return m_items[0].event;
+    }
+
+    bool IsOk() const { return m_ok; }
+
+    const wxXmlReaderItem *GetItem() const
+    {
+        return m_current < m_items.size() ? &m_items[m_current] : NULL;
+    }
+
+    const wxXmlReaderAttr& GetAttr(const wxXmlReaderItem& item, size_t n) const
+    {
+        return m_attrs[item.attrs + n];
+    }
+
+    const char *GetUTF8(size_t offset) const
+    {
+        return static_cast<const char *>(m_pool.GetData()) + offset;
+    }
+
+    wxString GetString(size_t offset, size_t len) const
+    {
+        if ( !len )
+            return wxString();
+
+        return CharToString(m_conv, GetUTF8(offset), len);
+    }
+
+    int FindAttr(const wxXmlReaderItem& item, const wxString& attrName) const
+    {
+        for ( size_t n = 0; n < item.attrCount; n++ )
+        {
+            if ( *GetAttr(item, n).name == attrName )
+                return static_cast<int>(n);
+        }
+
+        return wxNOT_FOUND;
+    }
+
+    // creates a node for the current item, without its children
+    wxXmlNode *CreateNode() const
+    {
+        const wxXmlReaderItem * const item = GetItem();
+        if ( !item || item->event == wxXmlReader::Event_EndElement )
+            return NULL;
+
+        wxXmlNode * const node = new wxXmlNode(GetXmlNodeType(item->event),
+                                               *item->name,
+                                               GetString(item->text, item->textLen),
+                                               item->lineNo);
+
+        // build the list directly as AddAttribute() needs to walk over it
+        wxXmlAttribute *last = NULL;
+        for ( size_t n = 0; n < item->attrCount; n++ )
+        {
+            const wxXmlReaderAttr& a = GetAttr(*item, n);
+            wxXmlAttribute * const
+                attr = new wxXmlAttribute(*a.name, GetString(a.value, a.valueLen));
+            if ( last )
+                last->SetNext(attr);
+            else
+                node->SetAttributes(attr);
+            last = attr;
+        }
+
+        return node;
+    }
+
+    // expat callbacks
+    void OnStartElement(const char *name, const char **atts)
+    {
+        FlushText();
+
+        const size_t attrs = m_attrs.size();
+        for ( const char **a = atts; *a; a += 2 )
+        {
+            wxXmlReaderAttr attr;
+            attr.name = m_names->Intern(a[0]);
+            attr.valueLen = strlen(a[1]);
+            attr.value = AddToPool(a[1], attr.valueLen);
+            m_attrs.push_back(attr);
+        }
+
+        wxXmlReaderItem& item = AddItem(wxXmlReader::Event_StartElement,
+                                        m_names->Intern(name));
+        item.attrs = attrs;
+        item.attrCount = m_attrs.size() - attrs;
+
+        m_depth++;
+    }
+
+    void OnEndElement()
+    {
+        FlushText();
+
+        m_depth--;
+        AddItem(wxXmlReader::Event_EndElement, m_names->Intern("", 0));
+    }
+
+    void OnText(const char *s, int len)
+    {
+        if ( !m_hasText )
+        {
+            m_hasText = true;
+            m_textLine = XML_GetCurrentLineNumber(m_parser);
+        }
+
+        m_text.AppendData(s, len);
+    }
+
+    void OnStartCData()
+    {
+        FlushText();
+
+        m_inCData = true;
+        m_hasText = true;
+        m_textLine = XML_GetCurrentLineNumber(m_parser);
+    }
+
+    void OnEndCData()
+    {
+        wxXmlReaderItem& item = AddItem(wxXmlReader::Event_CData, m_cdataName,
+                                        static_cast<const char *>(m_text.GetData()),
+                                        m_text.GetDataLen());
+        item.lineNo = m_textLine;
+
+        m_text.SetDataLen(0);
+        m_inCData = false;
+        m_hasText = false;
+    }
+
+    void OnComment(const char *data)
+    {
+        FlushText();
+
+        AddItem(wxXmlReader::Event_Comment, m_commentName, data, strlen(data));
+    }
+
+    void OnPI(const char *target, const char *data)
+    {
+        FlushText();
+
+        AddItem(wxXmlReader::Event_PI, m_names->Intern(target), data, strlen(data));
+    }
+
+private:
+    size_t AddToPool(const char *s, size_t len)
+    {
+        const size_t offset = m_pool.GetDataLen();
+        m_pool.AppendData(s, len);
+        m_pool.AppendByte('\0');
+        return offset;
+    }
+
+    wxXmlReaderItem& AddItem(wxXmlReader::Event event,
+                             const wxString *name,
+                             const char *text = NULL,
+                             size_t len = 0)
+    {
+        wxXmlReaderItem item;
+        item.event = event;
+        item.name = name;
+        item.text = text ? AddToPool(text, len) : 0;
+        item.textLen = len;
+        item.attrs = 0;
+        item.attrCount = 0;
+        item.depth = m_depth;
+        item.lineNo = XML_GetCurrentLineNumber(m_parser);
+
+        m_items.push_back(item);
+        return m_items.back();
+    }
+
+    // adds the text accumulated since the last item, as it may be split over
+    // several calls to OnText()
+    void FlushText()
+    {
+        if ( !m_hasText )
+            return;
+
+        const char * const text = static_cast<const char *>(m_text.GetData());
+        const size_t len = m_text.GetDataLen();
+
+        bool whiteOnly = m_removeWhiteOnlyNodes;
+        for ( size_t n = 0; whiteOnly && n < len; n++ )
+        {
+            switch ( text[n] )
+            {
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                    break;
+
+                default:
+                    whiteOnly = false;
+            }
+        }
+
+        if ( !whiteOnly )
+        {
+            wxXmlReaderItem& item = AddItem(wxXmlReader::Event_Text, m_textName,
+                                            text, len);
+            item.lineNo = m_textLine;
+        }
+
+        m_text.SetDataLen(0);
+        m_hasText = false;
+    }
+
+    bool ParseMore()
+    {
+        const size_t BUFSIZE = 65536;
+
+        void * const buf = XML_GetBuffer(m_parser, BUFSIZE);
+        if ( !buf )
+        {
+            m_ok = false;
+            m_done = true;
+            return false;
+        }
+
+        const size_t len = m_stream.Read(buf, BUFSIZE).LastRead();
+        m_done = len < BUFSIZE;
+
+        if ( !XML_ParseBuffer(m_parser, len, m_done) )
+        {
+            wxString error(XML_ErrorString(XML_GetErrorCode(m_parser)),
+                           *wxConvCurrent);
+            wxLogError(_("XML parsing error: '%s' at line %d"),
+                       error.c_str(),
+                       (int)XML_GetCurrentLineNumber(m_parser));
+
+            m_items.clear();
+            m_ok = false;
+            m_done = true;
+            return false;
+        }
+
+        return true;
+    }
+
+    wxInputStream& m_stream;
+    XML_Parser m_parser;
+    wxMBConv * const m_conv;
+
+    wxXmlNameTable *m_ownNames;
+    wxXmlNameTable *m_names;
+    const wxString *m_textName;
+    const wxString *m_cdataName;
+    const wxString *m_commentName;
+
+    // the queued items, their attributes and the strings used by both
+    wxVector<wxXmlReaderItem> m_items;
+    wxVector<wxXmlReaderAttr> m_attrs;
+    wxMemoryBuffer m_pool;
+    size_t m_current;
+
+    int m_depth;
+
+    // the text not added as an item yet
+    wxMemoryBuffer m_text;
+    int m_textLine;
+    bool m_hasText;
+    bool m_inCData;
+
+    const bool m_removeWhiteOnlyNodes;
+    bool m_done;
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReaderImpl);
+};
+
+extern "C" {
+static void ReaderStartElementHnd(void *userData, const char *name, const char **atts)
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnStartElement(name, atts);
+}
+
+static void ReaderEndElementHnd(void *userData, const char* WXUNUSED(name))
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnEndElement();
+}
+
+static void ReaderTextHnd(void *userData, const char *s, int len)
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnText(s, len);
+}
+
+static void ReaderStartCdataHnd(void *userData)
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnStartCData();
+}
+
+static void ReaderEndCdataHnd(void *userData)
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnEndCData();
+}
+
+static void ReaderCommentHnd(void *userData, const char *data)
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnComment(data);
+}
+
+static void ReaderPIHnd(void *userData, const char *target, const char *data)
+{
+    static_cast<wxXmlReaderImpl *>(userData)->OnPI(target, data);
+}
+
+static void ReaderDefaultHnd(void * WXUNUSED(userData),
+                             const char * WXUNUSED(s), int WXUNUSED(len))
+{
+    // having a default handler prevents expat from expanding the internal
+    // entities, just as in wxXmlDocument::Load()
+}
+} // extern "C"
+
+wxXmlReader::wxXmlReader(wxInputStream& stream, const wxString& encoding, int flags)
+    : m_impl(new wxXmlReaderImpl(stream, encoding, flags))
+{
+}
+
+wxXmlReader::~wxXmlReader()
+{
+    delete m_impl;
+}
+
+wxXmlReader::Event wxXmlReader::Next()
+{
+    return m_impl->Next();
+}
+
+wxXmlReader::Event wxXmlReader::GetEvent() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    return item ? item->event : Event_None;
+}
+
+bool wxXmlReader::IsOk() const
+{
+    return m_impl->IsOk();
+}
+
+const wxString& wxXmlReader::GetName() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    return item ? *item->name : GetEmptyXmlString();
+}
+
+wxString wxXmlReader::GetText() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    return item ? m_impl->GetString(item->text, item->textLen) : wxString();
+}
+
+wxScopedCharBuffer wxXmlReader::GetTextUTF8() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    if ( !item || !item->textLen )
+        return wxScopedCharBuffer::CreateNonOwned("", 0);
+
+    return wxScopedCharBuffer::CreateNonOwned(m_impl->GetUTF8(item->text),
+                                              item->textLen);
+}
+
+size_t wxXmlReader::GetAttributeCount() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    return item ? item->attrCount : 0;
+}
+
+const wxString& wxXmlReader::GetAttributeName(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributeCount(), GetEmptyXmlString(),
+                 "invalid attribute index" );
+
+    return *m_impl->GetAttr(*m_impl->GetItem(), n).name;
+}
+
+wxString wxXmlReader::GetAttributeValue(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributeCount(), wxString(),
+                 "invalid attribute index" );
+
+    const wxXmlReaderAttr& attr = m_impl->GetAttr(*m_impl->GetItem(), n);
+    return m_impl->GetString(attr.value, attr.valueLen);
+}
+
+bool wxXmlReader::GetAttribute(const wxString& attrName, wxString *value) const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    if ( !item )
+        return false;
+
+    const int n = m_impl->FindAttr(*item, attrName);
+    if ( n == wxNOT_FOUND )
+        return false;
+
+    if ( value )
+        *value = GetAttributeValue(n);
+
+    return true;
+}
+
+wxString wxXmlReader::GetAttribute(const wxString& attrName,
+                                   const wxString& defaultVal) const
+{
+    wxString value;
+    return GetAttribute(attrName, &value) ? value : defaultVal;
+}
+
+bool wxXmlReader::HasAttribute(const wxString& attrName) const
+{
+    return GetAttribute(attrName, NULL);
+}
+
+int wxXmlReader::GetDepth() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    return item ? item->depth : 0;
+}
+
+int wxXmlReader::GetLineNumber() const
+{
+    const wxXmlReaderItem * const item = m_impl->GetItem();
+    return item ? item->lineNo : -1;
+}
+
+bool wxXmlReader::SkipElement()
+{
+    if ( GetEvent() != Event_StartElement )
+        return false;
+
+    const int depth = GetDepth();
+    for ( ;; )
+    {
+        switch ( Next() )
+        {
+            case Event_None:
+                return false;
+
+            case Event_EndElement:
+                if ( GetDepth() == depth )
+                    return true;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+wxXmlNode *wxXmlReader::ReadNode()
+{
+    wxXmlNode * const node = m_impl->CreateNode();
+    if ( !node || node->GetType() != wxXML_ELEMENT_NODE )
+        return node;
+
+    const int depth = GetDepth();
+    wxXmlNode *parent = node;
+    wxXmlNode *lastChild = NULL;
+    for ( ;; )
+    {
+        const Event event = Next();
+        if ( event == Event_None )
+        {
+            // the document ended before the end of this element
+            delete node;
+            return NULL;
+        }
+
+        if ( event == Event_EndElement )
+        {
+            if ( GetDepth() == depth )
+                return node;
+
+            lastChild = parent;
+            parent = parent->GetParent();
+            continue;
+        }
+
+        wxXmlNode * const child = m_impl->CreateNode();
+        parent->InsertChildAfter(child, lastChild);
+
+        if ( event == Event_StartElement )
+        {
+            parent = child;
+            lastChild = NULL;
+        }
+        else
+        {
+            lastChild = child;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//  wxXmlArenaDocument
+//-----------------------------------------------------------------------------
+
+// Allocator handing out memory from big blocks which are only freed together.
+class wxXmlArena
+{
+public:
+    wxXmlArena() : m_current(NULL), m_left(0) {}
+
+    ~wxXmlArena()
+    {
+        for ( size_t n = 0; n < m_blocks.size(); n++ )
+            free(m_blocks[n]);
+    }
+
+    void *Alloc(size_t size)
+    {
+        static const size_t BLOCK_SIZE = 256*1024;
+
+        // keep all the allocations suitably aligned for the structs below
+        size = (size + 7) & ~static_cast<size_t>(7);
+
+        if ( size > m_left )
+        {
+            // don't waste the rest of the current block for big allocations
+            if ( size > BLOCK_SIZE / 4 )
+            {
+                void * const p = malloc(size);
+                m_blocks.push_back(p);
+                return p;
+            }
+
+            m_current = static_cast<char *>(malloc(BLOCK_SIZE));
+            m_blocks.push_back(m_current);
+            m_left = BLOCK_SIZE;
+        }
+
+        void * const p = m_current;
+        m_current += size;
+        m_left -= size;
+        return p;
+    }
+
+    const char *CopyString(const char *s, size_t len)
+    {
+        if ( !len )
+            return "";
+
+        char * const p = static_cast<char *>(Alloc(len + 1));
+        memcpy(p, s, len);
+        p[len] = '\0';
+        return p;
+    }
+
+private:
+    wxVector<void *> m_blocks;
+    char *m_current;
+    size_t m_left;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlArena);
+};
+
+struct wxXmlArenaAttr
+{
+    const wxString *name;
+    const char *value;
+    size_t valueLen;
+};
+
+struct wxXmlArenaNodeData
+{
+    wxXmlNodeType type;
+    int lineNo;
+    const wxString *name;
+    const char *content;
+    size_t contentLen;
+    const wxXmlArenaAttr *attrs;
+    size_t attrCount;
+    wxXmlArenaNodeData *parent;
+    wxXmlArenaNodeData *children;
+    wxXmlArenaNodeData *next;
+};
+
+class wxXmlArenaData
+{
+public:
+    explicit wxXmlArenaData(const wxString& encoding)
+        : conv(CreateXmlConv(encoding)),
+          names(conv),
+          docNode(NULL)
+    {
+    }
+
+    ~wxXmlArenaData()
+    {
+        delete conv;
+    }
+
+    wxXmlArenaNodeData *NewNode(wxXmlNodeType type, const wxString *name)
+    {
+        wxXmlArenaNodeData * const
+            node = static_cast<wxXmlArenaNodeData *>(arena.Alloc(sizeof(*node)));
+        node->type = type;
+        node->lineNo = -1;
+        node->name = name;
+        node->content = "";
+        node->contentLen = 0;
+        node->attrs = NULL;
+        node->attrCount = 0;
+        node->parent = NULL;
+        node->children = NULL;
+        node->next = NULL;
+        return node;
+    }
+
+    wxString GetString(const char *s, size_t len) const
+    {
+        if ( !len )
+            return wxString();
+
+        return CharToString(conv, s, len);
+    }
+
+    wxMBConv * const conv;
+    wxXmlNameTable names;
+    wxXmlArena arena;
+    wxXmlArenaNodeData *docNode;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlArenaData);
+};
+
+wxXmlArenaDocument::~wxXmlArenaDocument()
+{
+    delete m_data;
+}
+
+bool wxXmlArenaDocument::Load(const wxString& filename,
+                              const wxString& encoding,
+                              int flags)
+{
+    wxFileInputStream stream(filename);
+    if (!stream.IsOk())
+        return false;
+    return Load(stream, encoding, flags);
+}
 
-    ctx.encoding = wxS("UTF-8"); // default in absence of encoding=""
-    ctx.conv = NULL;
-#if !wxUSE_UNICODE
-    if ( encoding.CmpNoCase(wxS("UTF-8")) != 0 )
-        ctx.conv = new wxCSConv(encoding);
-#endif
-    ctx.doctype = &m_doctype;
-    ctx.removeWhiteOnlyNodes = (flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0;
-    ctx.parser = parser;
-    ctx.node = root;
+bool wxXmlArenaDocument::Load(wxInputStream& stream,
+                              const wxString& encoding,
+                              int flags)
+{
+    wxScopedPtr<wxXmlArenaData> data(new wxXmlArenaData(encoding));
 
-    XML_SetUserData(parser, (void*)&ctx);
-    XML_SetElementHandler(parser, StartElementHnd, EndElementHnd);
-    XML_SetCharacterDataHandler(parser, TextHnd);
-    XML_SetCdataSectionHandler(parser, StartCdataHnd, EndCdataHnd);
-    XML_SetCommentHandler(parser, CommentHnd);
-    XML_SetProcessingInstructionHandler(parser, PIHnd);
-    XML_SetDoctypeDeclHandler(parser, StartDoctypeHnd, EndDoctypeHnd);
-    XML_SetDefaultHandler(parser, DefaultHnd);
-    XML_SetUnknownEncodingHandler(parser, UnknownEncodingHnd, NULL);
+    wxXmlReader reader(stream, encoding, flags);
+    wxXmlReaderImpl * const impl = reader.m_impl;
+    impl->UseNames(&data->names);
 
-    bool ok = true;
-    do
+    wxXmlArena& arena = data->arena;
+    wxXmlArenaNodeData *parent = data->NewNode(wxXML_DOCUMENT_NODE,
+                                               data->names.Intern("", 0));
+    wxXmlArenaNodeData *lastChild = NULL;
+    data->docNode = parent;
+
+    wxXmlReader::Event event;
+    while ( (event = reader.Next()) != wxXmlReader::Event_None )
     {
-        size_t len = stream.Read(buf, BUFSIZE).LastRead();
-        done = (len < BUFSIZE);
-        if (!XML_Parse(parser, buf, len, done))
+        if ( event == wxXmlReader::Event_EndElement )
         {
-            wxString error(XML_ErrorString(XML_GetErrorCode(parser)),
-                           *wxConvCurrent);
-            wxLogError(_("XML parsing error: '%s' at line %d"),
-                       error.c_str(),
-                       (int)XML_GetCurrentLineNumber(parser));
-            ok = false;
-            break;
+            lastChild = parent;
+            parent = parent->parent;
+            continue;
         }
-    } while (!done);
 
-    if (ok)
+        const wxXmlReaderItem& item = *impl->GetItem();
+
+        wxXmlArenaNodeData * const
+            node = data->NewNode(GetXmlNodeType(event), item.name);
+        node->lineNo = item.lineNo;
+        node->content = arena.CopyString(impl->GetUTF8(item.text), item.textLen);
+        node->contentLen = item.textLen;
+
+        if ( item.attrCount )
+        {
+            wxXmlArenaAttr * const attrs = static_cast<wxXmlArenaAttr *>
+                (arena.Alloc(item.attrCount*sizeof(wxXmlArenaAttr)));
+            for ( size_t n = 0; n < item.attrCount; n++ )
+            {
+                const wxXmlReaderAttr& attr = impl->GetAttr(item, n);
+                attrs[n].name = attr.name;
+                attrs[n].value = arena.CopyString(impl->GetUTF8(attr.value),
+                                                  attr.valueLen);
+                attrs[n].valueLen = attr.valueLen;
+            }
+
+            node->attrs = attrs;
+            node->attrCount = item.attrCount;
+        }
+
+        node->parent = parent;
+        if ( lastChild )
+            lastChild->next = node;
+        else
+            parent->children = node;
+
+        if ( event == wxXmlReader::Event_StartElement )
+        {
+            parent = node;
+            lastChild = NULL;
+        }
+        else
+        {
+            lastChild = node;
+        }
+    }
+
+    if ( !reader.IsOk() )
+        return false;
+
+    delete m_data;
+    m_data = data.release();
+
+    return true;
+}
+
+wxXmlArenaNode wxXmlArenaDocument::GetDocumentNode() const
+{
+    return m_data ? wxXmlArenaNode(m_data, m_data->docNode) : wxXmlArenaNode();
+}
+
+wxXmlArenaNode wxXmlArenaDocument::GetRoot() const
+{
+    wxXmlArenaNode node = GetDocumentNode();
+    if ( node.IsOk() )
     {
-        if (!ctx.version.empty())
-            SetVersion(ctx.version);
-        if (!ctx.encoding.empty())
-            SetFileEncoding(ctx.encoding);
-        SetDocumentNode(root);
+        node = node.GetChildren();
+        while ( node.IsOk() && node.GetType() != wxXML_ELEMENT_NODE )
+            node = node.GetNext();
     }
-    else
+    return node;
+}
+
+//-----------------------------------------------------------------------------
+//  wxXmlArenaNode
+//-----------------------------------------------------------------------------
+
+wxXmlNodeType wxXmlArenaNode::GetType() const
+{
+    wxCHECK_MSG( m_node, wxXML_ELEMENT_NODE, "invalid node" );
+
+    return m_node->type;
+}
+
+const wxString& wxXmlArenaNode::GetName() const
+{
+    wxCHECK_MSG( m_node, GetEmptyXmlString(), "invalid node" );
+
+    return *m_node->name;
+}
+
+wxString wxXmlArenaNode::GetContent() const
+{
+    wxCHECK_MSG( m_node, wxString(), "invalid node" );
+
+    return m_data->GetString(m_node->content, m_node->contentLen);
+}
+
+wxScopedCharBuffer wxXmlArenaNode::GetContentUTF8() const
+{
+    wxCHECK_MSG( m_node, wxScopedCharBuffer::CreateNonOwned("", 0),
+                 "invalid node" );
+
+    return wxScopedCharBuffer::CreateNonOwned(m_node->content,
+                                              m_node->contentLen);
+}
+
+wxString wxXmlArenaNode::GetNodeContent() const
+{
+    for ( wxXmlArenaNode n = GetChildren(); n.IsOk(); n = n.GetNext() )
     {
-        delete root;
+        if ( n.m_node->type == wxXML_TEXT_NODE ||
+                n.m_node->type == wxXML_CDATA_SECTION_NODE )
+            return n.GetContent();
     }
 
-    XML_ParserFree(parser);
-#if !wxUSE_UNICODE
-    if ( ctx.conv )
-        delete ctx.conv;
-#endif
+    return wxString();
+}
 
-    return ok;
+wxXmlArenaNode wxXmlArenaNode::GetParent() const
+{
+    wxCHECK_MSG( m_node, wxXmlArenaNode(), "invalid node" );
+
+    return m_node->parent ? wxXmlArenaNode(m_data, m_node->parent)
+                          : wxXmlArenaNode();
+}
+
+wxXmlArenaNode wxXmlArenaNode::GetChildren() const
+{
+    wxCHECK_MSG( m_node, wxXmlArenaNode(), "invalid node" );
+
+    return m_node->children ? wxXmlArenaNode(m_data, m_node->children)
+                            : wxXmlArenaNode();
+}
+
+wxXmlArenaNode wxXmlArenaNode::GetNext() const
+{
+    wxCHECK_MSG( m_node, wxXmlArenaNode(), "invalid node" );
+
+    return m_node->next ? wxXmlArenaNode(m_data, m_node->next)
+                        : wxXmlArenaNode();
+}
+
+size_t wxXmlArenaNode::GetAttributeCount() const
+{
+    return m_node ? m_node->attrCount : 0;
+}
+
+const wxString& wxXmlArenaNode::GetAttributeName(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributeCount(), GetEmptyXmlString(),
+                 "invalid attribute index" );
+
+    return *m_node->attrs[n].name;
+}
 
+wxString wxXmlArenaNode::GetAttributeValue(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributeCount(), wxString(),
+                 "invalid attribute index" );
+
+    const wxXmlArenaAttr& attr = m_node->attrs[n];
+    return m_data->GetString(attr.value, attr.valueLen);
+}
+
+bool wxXmlArenaNode::GetAttribute(const wxString& attrName, wxString *value) const
+{
+    const size_t count = GetAttributeCount();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( *m_node->attrs[n].name == attrName )
+        {
+            if ( value )
+                *value = GetAttributeValue(n);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+wxString wxXmlArenaNode::GetAttribute(const wxString& attrName,
+                                      const wxString& defaultVal) const
+{
+    wxString value;
+    return GetAttribute(attrName, &value) ? value : defaultVal;
+}
+
+bool wxXmlArenaNode::HasAttribute(const wxString& attrName) const
+{
+    return GetAttribute(attrName, NULL);
+}
+
+int wxXmlArenaNode::GetLineNumber() const
+{
+    return m_node ? m_node->lineNo : -1;
+}
+
+// creates a node with the same contents as the given one, but no children
+static wxXmlNode *
+CreateXmlNode(const wxXmlArenaData *data, const wxXmlArenaNodeData *src)
+{
+    wxXmlNode * const node = new wxXmlNode(src->type, *src->name,
+                                           data->GetString(src->content,
+                                                           src->contentLen),
+                                           src->lineNo);
+
+    wxXmlAttribute *last = NULL;
+    for ( size_t n = 0; n < src->attrCount; n++ )
+    {
+        const wxXmlArenaAttr& a = src->attrs[n];
+        wxXmlAttribute * const
+            attr = new wxXmlAttribute(*a.name, data->GetString(a.value, a.valueLen));
+        if ( last )
+            last->SetNext(attr);
+        else
+            node->SetAttributes(attr);
+        last = attr;
+    }
+
+    return node;
+}
+
+wxXmlNode *wxXmlArenaNode::ToXmlNode() const
+{
+    wxCHECK_MSG( m_node, NULL, "invalid node" );
+
+    wxXmlNode * const root = CreateXmlNode(m_data, m_node);
+
+    // walk the tree without recursion as it can be arbitrarily deep
+    wxXmlNode *parent = root;
+    wxXmlNode *lastChild = NULL;
+    const wxXmlArenaNodeData *src = m_node->children;
+    while ( src )
+    {
+        wxXmlNode * const node = CreateXmlNode(m_data, src);
+        parent->InsertChildAfter(node, lastChild);
+
+        if ( src->children )
+        {
+            parent = node;
+            lastChild = NULL;
+            src = src->children;
+            continue;
+        }
+
+        lastChild = node;
+        while ( !src->next )
+        {
+            src = src->parent;
+            if ( src == m_node )
+                return root;
+
+            lastChild = parent;
+            parent = parent->GetParent();
+        }
+
+        src = src->next;
+    }
+
+    return root;
 }
 
+#endif // wxABI_VERSION >= 3.2.9
 
 
 //-----------------------------------------------------------------------------
@@ -1242,6 +2667,190 @@ bool wxXmlDocument::Save(wxOutputStream& stream, int indentstep) const
     return rc;
 }
 
+#if wxABI_VERSION >= 30209
+
+namespace
+{
+
+WX_DECLARE_STRING_HASH_MAP(size_t, wxXmlBinaryStringIndices);
+
+void WriteBinaryNumber(wxMemoryBuffer& buf, size_t value)
+{
+    unsigned char bytes[2*sizeof(size_t)];
+    size_t len = 0;
+    while ( value >= 0x80 )
+    {
+        bytes[len++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    bytes[len++] = static_cast<unsigned char>(value);
+
+    buf.AppendData(bytes, len);
+}
+
+// Collects the strings used by the document while writing its nodes, see
+// the description of the format in the loading code above.
+class wxXmlBinaryWriter
+{
+public:
+    explicit wxXmlBinaryWriter(wxMBConv *convMem)
+        : m_convMem(convMem)
+    {
+    }
+
+    void WriteNumber(size_t value)
+    {
+        WriteBinaryNumber(m_body, value);
+    }
+
+    void WriteString(const wxString& str)
+    {
+        wxXmlBinaryStringIndices::iterator it = m_indices.find(str);
+        if ( it == m_indices.end() )
+        {
+            it = m_indices.insert(
+                    wxXmlBinaryStringIndices::value_type(str, m_indices.size())
+                 ).first;
+
+            const wxScopedCharBuffer utf8(ToUTF8(str));
+            WriteBinaryNumber(m_strings, utf8.length());
+            m_strings.AppendData(utf8.data(), utf8.length());
+        }
+
+        WriteNumber(it->second);
+    }
+
+    void WriteNode(const wxXmlNode *node)
+    {
+        WriteNumber(node->GetType());
+        WriteNumber(node->GetNoConversion());
+        WriteString(node->GetName());
+        WriteString(node->GetContent());
+        WriteNumber(node->GetLineNumber() < 0 ? 0 : node->GetLineNumber() + 1);
+    }
+
+    void WriteAttributesAndChildCount(const wxXmlNode *node)
+    {
+        size_t count = 0;
+        const wxXmlAttribute *attr;
+        for ( attr = node->GetAttributes(); attr; attr = attr->GetNext() )
+            count++;
+
+        WriteNumber(count);
+        for ( attr = node->GetAttributes(); attr; attr = attr->GetNext() )
+        {
+            WriteString(attr->GetName());
+            WriteString(attr->GetValue());
+        }
+
+        count = 0;
+        for ( const wxXmlNode *child = node->GetChildren();
+              child;
+              child = child->GetNext() )
+            count++;
+
+        WriteNumber(count);
+    }
+
+    bool Flush(wxOutputStream& stream) const
+    {
+        wxMemoryBuffer header;
+        header.AppendData(wxXmlBinarySignature, sizeof(wxXmlBinarySignature));
+        WriteBinaryNumber(header, wxXmlBinaryVersion);
+        WriteBinaryNumber(header, m_indices.size());
+
+        return WriteBuffer(stream, header) &&
+                WriteBuffer(stream, m_strings) &&
+                WriteBuffer(stream, m_body);
+    }
+
+private:
+    static bool WriteBuffer(wxOutputStream& stream, const wxMemoryBuffer& buf)
+    {
+        const size_t len = buf.GetDataLen();
+        return stream.Write(buf.GetData(), len).LastWrite() == len;
+    }
+
+    wxScopedCharBuffer ToUTF8(const wxString& str) const
+    {
+#if !wxUSE_UNICODE
+        if ( m_convMem )
+        {
+            wxCharBuffer
+                buf(wxConvUTF8.cWC2MB(m_convMem->cMB2WC(str.c_str())));
+            const size_t len = strlen(buf);
+            return wxCharBuffer::CreateOwned(buf.release(), len);
+        }
+#endif // !wxUSE_UNICODE
+
+        return str.utf8_str();
+    }
+
+    wxMBConv * const m_convMem;
+    wxXmlBinaryStringIndices m_indices;
+    wxMemoryBuffer m_strings;
+    wxMemoryBuffer m_body;
+};
+
+} // anonymous namespace
+
+bool wxXmlDocument::SaveBinary(const wxString& filename) const
+{
+    wxFileOutputStream stream(filename);
+    if (!stream.IsOk())
+        return false;
+    return SaveBinary(stream);
+}
+
+bool wxXmlDocument::SaveBinary(wxOutputStream& stream) const
+{
+    if ( !IsOk() )
+        return false;
+
+    wxScopedPtr<wxMBConv> convMem;
+#if !wxUSE_UNICODE
+    if ( GetEncoding().CmpNoCase(wxS("UTF-8")) != 0 )
+        convMem.reset(new wxCSConv(GetEncoding()));
+#endif
+
+    wxXmlBinaryWriter writer(convMem.get());
+    writer.WriteString(GetVersion());
+    writer.WriteString(GetFileEncoding());
+    writer.WriteString(m_doctype.GetRootName());
+    writer.WriteString(m_doctype.GetSystemId());
+    writer.WriteString(m_doctype.GetPublicId());
+    writer.WriteNumber(GetFileType());
+
+    // write the nodes in the same order in which they are read, i.e. each
+    // node followed by its descendants, without recursion
+    const wxXmlNode * const docNode = GetDocumentNode();
+    const wxXmlNode *node = docNode;
+    for ( ;; )
+    {
+        if ( node != docNode )
+            writer.WriteNode(node);
+        writer.WriteAttributesAndChildCount(node);
+
+        if ( node->GetChildren() )
+        {
+            node = node->GetChildren();
+            continue;
+        }
+
+        while ( node != docNode && !node->GetNext() )
+            node = node->GetParent();
+
+        if ( node == docNode )
+            break;
+
+        node = node->GetNext();
+    }
+
+    return writer.Flush(stream);
+}
+
+#endif // wxABI_VERSION >= 3.2.9
+
 /*static*/ wxVersionInfo wxXmlDocument::GetLibraryVersionInfo()
 {
     return wxVersionInfo("expat",
@@ -31,6 +31,7 @@ wxTreeCtrlXmlHandler::wxTreeCtrlXmlHandler()
     XRC_ADD_STYLE(wxTR_HIDE_ROOT);
     XRC_ADD_STYLE(wxTR_ROW_LINES);
     XRC_ADD_STYLE(wxTR_HAS_VARIABLE_ROW_HEIGHT);
+    XRC_ADD_STYLE(wxTR_UNIFORM_ROW_HEIGHT);
     XRC_ADD_STYLE(wxTR_SINGLE);
     XRC_ADD_STYLE(wxTR_MULTIPLE);
     XRC_ADD_STYLE(wxTR_DEFAULT_STYLE);
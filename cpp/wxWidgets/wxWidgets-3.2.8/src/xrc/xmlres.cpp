@@ -39,7 +39,9 @@
 #include "wx/imaglist.h"
 #include "wx/dir.h"
 #include "wx/xml/xml.h"
+#include "wx/hashmap.h"
 #include "wx/hashset.h"
+#include "wx/datstrm.h"
 #include "wx/scopedptr.h"
 #include "wx/config.h"
 #include "wx/platinfo.h"
@@ -66,6 +68,93 @@ wxDateTime GetXRCFileModTime(const wxString& filename)
 #endif // wxUSE_FILESYSTEM
 }
 
+#if wxABI_VERSION >= 30209
+
+// The files in the cache directory start with this signature followed by the
+// URL and the modification time of the cached XRC file and then the document
+// itself in the binary format understood by wxXmlDocument::Load().
+const char XRC_CACHE_SIGNATURE[8] = { 'w', 'x', 'X', 'R', 'C', 'c', '1', '\n' };
+
+// Returns the name of the file caching the given URL in the cache directory.
+wxString GetXRCCacheFileName(const wxString& cacheDir, const wxString& url)
+{
+    // Use FNV-1a hash of the URL as it can contain characters not allowed in
+    // the file names, collisions are harmless as the URL is checked on load.
+    const wxScopedCharBuffer buf(url.utf8_str());
+    wxUint32 hash = 2166136261u;
+    for ( const char* p = buf.data(); *p; ++p )
+    {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 16777619u;
+    }
+
+    return wxFileName(cacheDir, wxString::Format("%08x", hash), "xrcb")
+                .GetFullPath();
+}
+
+// Loads the document from the cache file if it's up to date.
+bool LoadXRCCache(wxXmlDocument& doc,
+                  const wxString& cacheFile,
+                  const wxString& url,
+                  const wxDateTime& modTime,
+                  const wxString& encoding)
+{
+    if ( !wxFileName::FileExists(cacheFile) )
+        return false;
+
+    wxFileInputStream stream(cacheFile);
+    if ( !stream.IsOk() )
+        return false;
+
+    char sig[sizeof(XRC_CACHE_SIGNATURE)];
+    if ( stream.Read(sig, sizeof(sig)).LastRead() != sizeof(sig) ||
+            memcmp(sig, XRC_CACHE_SIGNATURE, sizeof(sig)) != 0 )
+        return false;
+
+    wxDataInputStream data(stream);
+    const wxString cachedURL = data.ReadString();
+    const wxUint64 cachedTime = data.Read64();
+    if ( !stream.IsOk() || cachedURL != url ||
+            cachedTime != static_cast<wxUint64>(modTime.GetValue().GetValue()) )
+        return false;
+
+    // Don't complain about invalid cache files, we'll just parse the XRC file
+    // and overwrite it.
+    wxLogNull noLog;
+    return doc.Load(stream, encoding);
+}
+
+// Saves the document to the cache file, errors are ignored as the cache is
+// just an optimization.
+void SaveXRCCache(const wxXmlDocument& doc,
+                  const wxString& cacheFile,
+                  const wxString& url,
+                  const wxDateTime& modTime)
+{
+    wxLogNull noLog;
+
+    if ( !wxFileName::Mkdir(wxPathOnly(cacheFile),
+                            wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL) )
+        return;
+
+    // Write to a temporary file first to avoid leaving a partially written
+    // cache file if anything goes wrong.
+    wxTempFileOutputStream stream(cacheFile);
+    if ( !stream.IsOk() )
+        return;
+
+    stream.Write(XRC_CACHE_SIGNATURE, sizeof(XRC_CACHE_SIGNATURE));
+
+    wxDataOutputStream data(stream);
+    data.WriteString(url);
+    data.Write64(static_cast<wxUint64>(modTime.GetValue().GetValue()));
+
+    if ( stream.IsOk() && doc.SaveBinary(stream) )
+        stream.Commit();
+}
+
+#endif // wxABI_VERSION >= 3.2.9
+
 #endif // wxUSE_DATETIME
 
 } // anonymous namespace
@@ -125,9 +214,45 @@ public:
     wxDECLARE_NO_COPY_CLASS(wxXmlResourceDataRecord);
 };
 
+// A top-level object node and the record containing it.
+struct wxXmlResourceNodeRef
+{
+    wxXmlResourceNodeRef(wxXmlResourceDataRecord *rec_, wxXmlNode *node_)
+        : rec(rec_), node(node_)
+    {
+    }
+
+    wxXmlResourceDataRecord *rec;
+    wxXmlNode *node;
+};
+
+typedef wxVector<wxXmlResourceNodeRef> wxXmlResourceNodeRefs;
+
+WX_DECLARE_STRING_HASH_MAP(wxXmlResourceNodeRefs, wxXmlResourceNameIndex);
+
 class wxXmlResourceDataRecords : public wxVector<wxXmlResourceDataRecord*>
 {
     // this is a class so that it can be forward-declared
+public:
+    wxXmlResourceDataRecords() : m_indexValid(false) { }
+
+    // Must be called whenever the records or their documents change.
+    void InvalidateIndex() { m_indexValid = false; }
+
+    // Returns the top-level object nodes with the given name in the same order
+    // in which they appear in the records or NULL if there are none.
+    const wxXmlResourceNodeRefs *FindTopLevel(const wxString& name) const;
+
+    wxString m_cacheDir;
+
+private:
+    void BuildIndex() const;
+
+    // Index of the top-level object nodes of all records by their names: as
+    // most resources are top-level, this avoids iterating over all of them
+    // every time one of them is loaded.
+    mutable wxXmlResourceNameIndex m_index;
+    mutable bool m_indexValid;
 };
 
 WX_DECLARE_HASH_SET_PTR(int, wxIntegerHash, wxIntegerEqual, wxHashSetInt);
@@ -246,8 +371,69 @@ GetFileNameFromNode(const wxXmlNode *node, const wxXmlResourceDataRecords& files
     return wxEmptyString; // not found
 }
 
+// helper used by DoFindResource() and elsewhere: returns true if the given
+// object node has the specified class or if the class is empty
+bool
+HasObjectClass(const wxXmlResource& res, wxXmlNode *node, const wxString& classname)
+{
+    // empty class name matches everything
+    if ( classname.empty() )
+        return true;
+
+    wxString cls(node->GetAttribute(wxS("class")));
+
+    // object_ref may not have 'class' attribute:
+    if (cls.empty() && node->GetName() == wxS("object_ref"))
+    {
+        wxString refName = node->GetAttribute(wxS("ref"));
+        if (refName.empty())
+            return false;
+
+        const wxXmlNode * const refNode = res.GetResourceNode(refName);
+        if ( refNode )
+            cls = refNode->GetAttribute(wxS("class"));
+    }
+
+    return cls == classname;
+}
+
 } // anonymous namespace
 
+void wxXmlResourceDataRecords::BuildIndex() const
+{
+    m_index.clear();
+
+    for ( const_iterator i = begin(); i != end(); ++i )
+    {
+        wxXmlResourceDataRecord * const rec = *i;
+        if ( !rec->Doc || !rec->Doc->GetRoot() )
+            continue;
+
+        for ( wxXmlNode *node = rec->Doc->GetRoot()->GetChildren();
+              node;
+              node = node->GetNext() )
+        {
+            if ( IsObjectNode(node) )
+            {
+                m_index[node->GetAttribute(wxS("name"))].push_back(
+                    wxXmlResourceNodeRef(rec, node));
+            }
+        }
+    }
+
+    m_indexValid = true;
+}
+
+const wxXmlResourceNodeRefs *
+wxXmlResourceDataRecords::FindTopLevel(const wxString& name) const
+{
+    if ( !m_indexValid )
+        BuildIndex();
+
+    wxXmlResourceNameIndex::const_iterator it = m_index.find(name);
+    return it == m_index.end() ? NULL : &it->second;
+}
+
 
 wxXmlResource *wxXmlResource::ms_instance = NULL;
 
@@ -299,6 +485,16 @@ void wxXmlResource::SetDomain(const wxString& domain)
     m_domain = domain;
 }
 
+wxString wxXmlResource::GetCacheDir() const
+{
+    return Data().m_cacheDir;
+}
+
+void wxXmlResource::SetCacheDir(const wxString& dir)
+{
+    Data().m_cacheDir = dir;
+}
+
 
 /* static */
 wxString wxXmlResource::ConvertFileNameToURL(const wxString& filename)
@@ -398,9 +594,14 @@ bool wxXmlResource::Load(const wxString& filemask_)
         {
             wxXmlDocument * const doc = DoLoadFile(fnd);
             if ( !doc )
+            {
                 thisOK = false;
+            }
             else
+            {
                 Data().push_back(new wxXmlResourceDataRecord(fnd, doc));
+                Data().InvalidateIndex();
+            }
         }
 
         if ( thisOK )
@@ -452,6 +653,7 @@ bool wxXmlResource::Unload(const wxString& filename)
             {
                 delete *i;
                 Data().erase(i);
+                Data().InvalidateIndex();
                 unloaded = true;
 
                 // no sense in continuing, there is only one file with this URL
@@ -721,6 +923,7 @@ bool wxXmlResource::UpdateResources()
         // Replace the old resource contents with the new one.
         delete rec->Doc;
         rec->Doc = doc;
+        Data().InvalidateIndex();
 
         // And, now that we loaded it successfully, update the last load time.
 #if wxUSE_DATETIME
@@ -735,28 +938,6 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
 {
     wxLogTrace(wxT("xrc"), wxT("opening file '%s'"), filename);
 
-    wxInputStream *stream = NULL;
-
-#if wxUSE_FILESYSTEM
-    wxFileSystem fsys;
-    wxScopedPtr<wxFSFile> file(fsys.OpenFile(filename));
-    if (file)
-    {
-        // Notice that we don't have ownership of the stream in this case, it
-        // remains owned by wxFSFile.
-        stream = file->GetStream();
-    }
-#else // !wxUSE_FILESYSTEM
-    wxFileInputStream fstream(filename);
-    stream = &fstream;
-#endif // wxUSE_FILESYSTEM/!wxUSE_FILESYSTEM
-
-    if ( !stream || !stream->IsOk() )
-    {
-        wxLogError(_("Cannot open resources file '%s'."), filename);
-        return NULL;
-    }
-
     wxString encoding(wxT("UTF-8"));
 #if !wxUSE_UNICODE && wxUSE_INTL
     if ( (GetFlags() & wxXRC_USE_LOCALE) == 0 )
@@ -769,10 +950,61 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
 #endif
 
     wxScopedPtr<wxXmlDocument> doc(new wxXmlDocument);
-    if (!doc->Load(*stream, encoding))
+
+#if wxUSE_DATETIME && wxABI_VERSION >= 30209
+    // Use the cached binary version of the file if it's up to date.
+    wxString cacheFile;
+    wxDateTime modTime;
+    if ( !Data().m_cacheDir.empty() )
     {
-        wxLogError(_("Cannot load resources from file '%s'."), filename);
-        return NULL;
+        modTime = GetXRCFileModTime(filename);
+        if ( modTime.IsValid() )
+            cacheFile = GetXRCCacheFileName(Data().m_cacheDir, filename);
+    }
+
+    if ( !cacheFile.empty() &&
+            LoadXRCCache(*doc, cacheFile, filename, modTime, encoding) )
+    {
+        wxLogTrace(wxT("xrc"), wxT("loaded '%s' from cache file '%s'"),
+                   filename, cacheFile);
+    }
+    else
+#endif // wxUSE_DATETIME && wxABI_VERSION >= 3.2.9
+    {
+        wxInputStream *stream = NULL;
+
+#if wxUSE_FILESYSTEM
+        wxFileSystem fsys;
+        wxScopedPtr<wxFSFile> file(fsys.OpenFile(filename));
+        if (file)
+        {
+            // Notice that we don't have ownership of the stream in this case,
+            // it remains owned by wxFSFile.
+            stream = file->GetStream();
+        }
+#else // !wxUSE_FILESYSTEM
+        wxFileInputStream fstream(filename);
+        stream = &fstream;
+#endif // wxUSE_FILESYSTEM/!wxUSE_FILESYSTEM
+
+        if ( !stream || !stream->IsOk() )
+        {
+            wxLogError(_("Cannot open resources file '%s'."), filename);
+            return NULL;
+        }
+
+        if (!doc->Load(*stream, encoding))
+        {
+            wxLogError(_("Cannot load resources from file '%s'."), filename);
+            return NULL;
+        }
+
+#if wxUSE_DATETIME && wxABI_VERSION >= 30209
+        // Notice that the document must be cached before DoLoadDocument()
+        // modifies it.
+        if ( !cacheFile.empty() )
+            SaveXRCCache(*doc, cacheFile, filename, modTime);
+#endif // wxUSE_DATETIME && wxABI_VERSION >= 3.2.9
     }
 
     if (!DoLoadDocument(*doc))
@@ -838,6 +1070,7 @@ bool wxXmlResource::LoadDocument(wxXmlDocument* doc, const wxString& name)
     }
 
     Data().push_back(new wxXmlResourceDataRecord(docname, doc, XRCWhence::From_Doc));
+    Data().InvalidateIndex();
 
     return true;
 }
@@ -853,29 +1086,10 @@ wxXmlNode *wxXmlResource::DoFindResource(wxXmlNode *parent,
     // where the resource is most commonly looked for):
     for (node = parent->GetChildren(); node; node = node->GetNext())
     {
-        if ( IsObjectNode(node) && node->GetAttribute(wxS("name")) == name )
-        {
-            // empty class name matches everything
-            if ( classname.empty() )
-                return node;
-
-            wxString cls(node->GetAttribute(wxS("class")));
-
-            // object_ref may not have 'class' attribute:
-            if (cls.empty() && node->GetName() == wxS("object_ref"))
-            {
-                wxString refName = node->GetAttribute(wxS("ref"));
-                if (refName.empty())
-                    continue;
-
-                const wxXmlNode * const refNode = GetResourceNode(refName);
-                if ( refNode )
-                    cls = refNode->GetAttribute(wxS("class"));
-            }
-
-            if ( cls == classname )
-                return node;
-        }
+        if ( IsObjectNode(node) &&
+                node->GetAttribute(wxS("name")) == name &&
+                    HasObjectClass(*this, node, classname) )
+            return node;
     }
 
     // then recurse in child nodes
@@ -938,6 +1152,30 @@ wxXmlResource::GetResourceNodeAndLocation(const wxString& name,
     // reloading of XRC files
     const_cast<wxXmlResource *>(this)->UpdateResources();
 
+    // Top-level resources can be found using the index directly, but when
+    // searching recursively we must look at the nodes in the same order as
+    // DoFindResource() does, so we can't use it.
+    if ( !recursive )
+    {
+        const wxXmlResourceNodeRefs * const refs = Data().FindTopLevel(name);
+        if ( !refs )
+            return NULL;
+
+        for ( wxXmlResourceNodeRefs::const_iterator i = refs->begin();
+              i != refs->end(); ++i )
+        {
+            if ( HasObjectClass(*this, i->node, classname) )
+            {
+                if ( path )
+                    *path = i->rec->File;
+
+                return i->node;
+            }
+        }
+
+        return NULL;
+    }
+
     for ( wxXmlResourceDataRecords::const_iterator f = Data().begin();
           f != Data().end(); ++f )
     {
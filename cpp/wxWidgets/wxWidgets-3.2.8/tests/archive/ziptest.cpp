@@ -16,6 +16,7 @@
 
 #include "archivetest.h"
 #include "wx/zipstrm.h"
+#include "wx/mstream.h"
 
 using std::string;
 
@@ -60,6 +61,9 @@ void ZipTestCase::OnCreateArchive(wxZipOutputStream& zip)
 {
     m_comment << wxT("Comment for test ") << m_id;
     zip.SetComment(m_comment);
+#if wxUSE_THREADS
+    zip.SetThreadCount(m_id % 2 ? 4 : 1);
+#endif
 }
 
 void ZipTestCase::OnArchiveExtracted(wxZipInputStream& zip, int expectedTotal)
@@ -201,6 +205,164 @@ void ZipPipeTestCase::runTest()
 }
 
 
+#if wxUSE_THREADS
+
+///////////////////////////////////////////////////////////////////////////////
+// Entries large enough to be split into several chunks when compressing them
+// in parallel, including one which is too big to be queued in memory.
+
+static wxCharBuffer MakeZipTestData(size_t size, unsigned seed)
+{
+    wxCharBuffer data(size);
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        // use a small alphabet to make the data compressible
+        data.data()[i] = "abcdefgh\n "[(seed >> 16) % 10];
+    }
+    return data;
+}
+
+TEST_CASE("wxZipOutputStream::SetThreadCount", "[archive][zip]")
+{
+    const size_t sizes[] = { 0, 5, 1000, 300000, 1300000, 200000 };
+    const size_t count = WXSIZEOF(sizes);
+
+    for (int options = 0; options <= PipeOut; options += PipeOut) {
+        INFO("Options: " << options);
+
+        TestOutputStream out(options);
+        {
+            wxZipOutputStream zip(out, 6);
+            zip.SetThreadCount(2);
+            CHECK( zip.GetThreadCount() == 2 );
+
+            for (size_t n = 0; n < count; n++) {
+                wxZipEntry *entry = new wxZipEntry(wxString::Format("%zu", n));
+                if (n == count - 1)
+                    entry->SetMethod(wxZIP_METHOD_STORE);
+                REQUIRE( zip.PutNextEntry(entry) );
+
+                wxCharBuffer data = MakeZipTestData(sizes[n], n);
+                REQUIRE( zip.Write(data, sizes[n]).IsOk() );
+            }
+
+            REQUIRE( zip.Close() );
+        }
+
+        TestInputStream in(out, 0);
+        wxZipInputStream zip(in);
+
+        for (size_t n = 0; n < count; n++) {
+            wxScopedPtr<wxZipEntry> entry(zip.GetNextEntry());
+            REQUIRE( entry );
+            CHECK( entry->GetName() == wxString::Format("%zu", n) );
+
+            wxMemoryOutputStream mem;
+            zip.Read(mem);
+            CHECK( zip.Eof() );
+
+            wxCharBuffer data = MakeZipTestData(sizes[n], n);
+            REQUIRE( mem.GetSize() == sizes[n] );
+            CHECK( memcmp(mem.GetOutputStreamBuffer()->GetBufferStart(),
+                          data, sizes[n]) == 0 );
+        }
+
+        wxScopedPtr<wxZipEntry> entry(zip.GetNextEntry());
+        CHECK( !entry );
+    }
+}
+
+#endif // wxUSE_THREADS
+
+///////////////////////////////////////////////////////////////////////////////
+// wxZipIndex
+
+TEST_CASE("wxZipIndex", "[archive][zip]")
+{
+    wxMemoryOutputStream out;
+
+    // Use a prefix to check that the offsets are adjusted correctly when the
+    // zip is appended to something else, e.g. a self extractor.
+    bool prefix = false;
+    SECTION("Plain") { }
+    SECTION("Prefix") { prefix = true; }
+
+    if (prefix)
+        out.Write("prefix", 6);
+
+    wxCharBuffer big(100000);
+    memset(big.data(), 'x', big.length());
+
+    {
+        wxZipOutputStream zip(out);
+        zip.SetComment("index test");
+
+        REQUIRE( zip.PutNextEntry("one.txt") );
+        zip.Write("first", 5);
+        REQUIRE( zip.PutNextDirEntry("dir") );
+        REQUIRE( zip.PutNextEntry(wxString::FromUTF8("dir/\xc3\xa9t\xc3\xa9.txt")) );
+        zip.Write(big, big.length());
+        REQUIRE( zip.PutNextEntry("one.txt") );
+        zip.Write("duplicate", 9);
+        REQUIRE( zip.Close() );
+    }
+
+    wxMemoryInputStream in(out);
+    wxZipIndex index(in);
+    REQUIRE( index.IsOk() );
+    CHECK( index.GetCount() == 4 );
+    CHECK( index.GetComment() == "index test" );
+
+    CHECK( index.Find("one.txt") == 0 );
+    CHECK( index.Find("dir/") == 1 );
+    CHECK( index.Find("dir") == wxNOT_FOUND );
+    CHECK( index.Find(wxString::FromUTF8("dir/\xc3\xa9t\xc3\xa9.txt")) == 2 );
+    CHECK( index.Find("missing") == wxNOT_FOUND );
+
+    CHECK( index.GetName(1) == "dir/" );
+    CHECK( index.IsDir(1) );
+    CHECK( !index.IsDir(2) );
+    CHECK( index.GetSize(2) == 100000 );
+
+    wxScopedPtr<wxZipEntry> entry(index.GetEntry(2));
+    REQUIRE( entry );
+    CHECK( entry->GetName(wxPATH_UNIX) == index.GetName(2) );
+    CHECK( entry->GetSize() == 100000 );
+    CHECK( entry->GetMethod() == wxZIP_METHOD_DEFLATE );
+
+    // Open the entries in reverse order, which is the worst case for reading
+    // them sequentially.
+    const char* const contents[] = { "first", "", NULL, "duplicate" };
+    for (int n = 3; n >= 0; n--) {
+        INFO("Entry " << n);
+
+        wxScopedPtr<wxZipInputStream>
+            zip(index.OpenEntry(new wxMemoryInputStream(out), n));
+        REQUIRE( zip );
+
+        wxMemoryOutputStream data;
+        zip->Read(data);
+        CHECK( zip->Eof() );
+
+        const size_t size = data.GetSize();
+        const char* const p =
+            static_cast<char*>(data.GetOutputStreamBuffer()->GetBufferStart());
+
+        if (contents[n]) {
+            CHECK( wxString(p, size) == contents[n] );
+        } else {
+            REQUIRE( size == big.length() );
+            CHECK( memcmp(p, big, size) == 0 );
+        }
+    }
+
+    // Copies share the same data.
+    wxZipIndex copy = index;
+    CHECK( copy.Find("dir/") == 1 );
+
+    CHECK( !wxZipIndex().IsOk() );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Zip suite
 
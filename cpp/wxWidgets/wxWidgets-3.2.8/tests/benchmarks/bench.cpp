@@ -15,11 +15,19 @@
 // headers
 // ----------------------------------------------------------------------------
 
-#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <new>
 
 #include "wx/app.h"
+#include "wx/atomic.h"
 #include "wx/cmdline.h"
+#include "wx/ffile.h"
 #include "wx/stopwatch.h"
+#include "wx/tokenzr.h"
+#include "wx/vector.h"
 
 #if wxUSE_GUI
     #include "wx/frame.h"
@@ -27,6 +35,61 @@
 
 #include "bench.h"
 
+// ----------------------------------------------------------------------------
+// CPU cycles and allocations counters
+// ----------------------------------------------------------------------------
+
+// Use the time stamp counter for counting CPU cycles where it's available.
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #define wxBENCH_HAS_CYCLES
+    static inline wxUint64 GetCPUCycles() { return __builtin_ia32_rdtsc(); }
+#elif defined(__VISUALC__) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+
+    #define wxBENCH_HAS_CYCLES
+    static inline wxUint64 GetCPUCycles() { return __rdtsc(); }
+#endif
+
+// Count the allocations by replacing the global operator new. This doesn't
+// work for the allocations done inside wx DLLs under Windows, as each module
+// has its own operators there, so don't report misleading numbers then.
+#if !defined(__WINDOWS__) || !defined(WXUSINGDLL)
+    #define wxBENCH_COUNT_ALLOCS
+
+    static wxUint32 gs_numAllocs = 0;
+
+    #if __cplusplus >= 201103L || wxCHECK_VISUALC_VERSION(14)
+        #define wxBENCH_THROW_BAD_ALLOC
+        #define wxBENCH_NOTHROW noexcept
+    #else
+        #define wxBENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+        #define wxBENCH_NOTHROW throw()
+    #endif
+
+    void* operator new(size_t size) wxBENCH_THROW_BAD_ALLOC
+    {
+        wxAtomicInc(gs_numAllocs);
+
+        void* const p = malloc(size ? size : 1);
+        if ( !p )
+            throw std::bad_alloc();
+
+        return p;
+    }
+
+    void operator delete(void* p) wxBENCH_NOTHROW
+    {
+        free(p);
+    }
+
+    #ifdef __cpp_sized_deallocation
+    void operator delete(void* p, size_t WXUNUSED(size)) wxBENCH_NOTHROW
+    {
+        free(p);
+    }
+    #endif // __cpp_sized_deallocation
+#endif // wxBENCH_COUNT_ALLOCS
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -39,6 +102,62 @@ static const char OPTION_NUM_RUNS = 'n';
 static const char OPTION_NUMERIC_PARAM = 'p';
 static const char OPTION_STRING_PARAM = 's';
 
+static const char OPTION_WARMUP = 'w';
+static const char OPTION_ITERATIONS = 'i';
+static const char OPTION_OUTPUT = 'o';
+static const char OPTION_COMPARE = 'c';
+static const char OPTION_THRESHOLD[] = "threshold";
+
+// minimal duration of a single sample, in microseconds, when the number of
+// iterations per sample is determined automatically
+static const double MIN_SAMPLE_TIME = 1000;
+
+// maximal number of iterations per sample used by automatic calibration
+static const long MAX_ITERATIONS = 1 << 24;
+
+// ----------------------------------------------------------------------------
+// BenchResult: results of running a single benchmark
+// ----------------------------------------------------------------------------
+
+struct BenchResult
+{
+    BenchResult()
+    {
+        samples =
+        iterations = 0;
+
+        mean =
+        median =
+        p95 =
+        stddev =
+        min =
+        max = 0;
+
+        cycles =
+        allocs = -1;
+    }
+
+    wxString name;
+
+    long samples,       // number of measured samples
+         iterations;    // number of benchmark runs in each sample
+
+    // statistics of the time per iteration, in microseconds
+    double mean,
+           median,
+           p95,
+           stddev,
+           min,
+           max;
+
+    // median number of CPU cycles and mean number of allocations per
+    // iteration or -1 if unknown
+    double cycles,
+           allocs;
+};
+
+typedef wxVector<BenchResult> BenchResults;
+
 // ----------------------------------------------------------------------------
 // BenchApp declaration
 // ----------------------------------------------------------------------------
@@ -70,6 +189,17 @@ private:
     // false if anything went wrong
     bool RunSingleBenchmark(Bench::Function* func);
 
+    // run the benchmark the given number of times and return the total time
+    // taken in microseconds or a negative value if it failed
+    double RunIterations(Bench::Function* func, long iterations);
+
+    // write m_results to m_outputFile in the format given by its extension
+    bool SaveResults() const;
+
+    // compare the results from m_compareFiles and return EXIT_FAILURE if
+    // there are any significant regressions
+    int CompareResults() const;
+
     // list all registered benchmarks
     void ListBenchmarks();
 
@@ -77,8 +207,17 @@ private:
     wxSortedArrayString m_toRun;
     long m_numRuns, // number of times to run a single benchmark or 0
          m_runTime, // minimum time to run a single benchmark if m_numRuns == 0
-         m_numParam;
+         m_numParam,
+         m_numWarmup, // number of unmeasured runs before the measured ones
+         m_numIterations; // iterations per sample or 0 to determine them
     wxString m_strParam;
+    wxString m_outputFile;
+    wxString m_compareFiles[2];
+    bool m_compare;
+    double m_threshold; // minimal change in percents reported by compare
+
+    // results of all the benchmarks run so far
+    BenchResults m_results;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -110,6 +249,10 @@ BenchApp::BenchApp()
     m_numRuns = 0; // this means to use m_runTime
     m_runTime = 500; // default minimum
     m_numParam = 0;
+    m_numWarmup = 1;
+    m_numIterations = 0; // this means to determine it automatically
+    m_compare = false;
+    m_threshold = 5;
 }
 
 bool BenchApp::OnInit()
@@ -172,8 +315,38 @@ void BenchApp::OnInitCmdLine(wxCmdLineParser& parser)
                      "string parameter used by some benchmark functions "
                      "(default: empty)",
                      wxCMD_LINE_VAL_STRING);
-
-    parser.AddParam("benchmark name",
+    parser.AddOption(OPTION_WARMUP,
+                     "warmup",
+                     wxString::Format
+                     (
+                         "number of unmeasured runs before measuring "
+                         "(default: %ld)",
+                         m_numWarmup
+                     ),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(OPTION_ITERATIONS,
+                     "iterations",
+                     "number of runs timed together as a single sample "
+                     "(default: chosen for each sample to take at least 1ms)",
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(OPTION_OUTPUT,
+                     "output",
+                     "also save the results to the given .json or .csv file",
+                     wxCMD_LINE_VAL_STRING);
+    parser.AddSwitch(OPTION_COMPARE,
+                     "compare",
+                     "compare the results from the two files given as "
+                     "parameters instead of running benchmarks");
+    parser.AddLongOption(OPTION_THRESHOLD,
+                         wxString::Format
+                         (
+                             "minimal significant change in percents for "
+                             "--compare (default: %g)",
+                             m_threshold
+                         ),
+                         wxCMD_LINE_VAL_DOUBLE);
+
+    parser.AddParam("benchmark name or results file",
                     wxCMD_LINE_VAL_STRING,
                     wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE);
 }
@@ -197,13 +370,45 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
         return false;
     }
 
+    parser.Found(OPTION_THRESHOLD, &m_threshold);
+    if ( parser.Found(OPTION_COMPARE) )
+    {
+        if ( count != WXSIZEOF(m_compareFiles) )
+        {
+            wxFprintf(stderr, "Exactly two results files must be given.\n");
+
+            return false;
+        }
+
+        for ( size_t n = 0; n < count; n++ )
+            m_compareFiles[n] = parser.GetParam(n);
+
+        m_compare = true;
+
+        return BenchAppBase::OnCmdLineParsed(parser);
+    }
+
+    if ( parser.Found(OPTION_OUTPUT, &m_outputFile) )
+    {
+        if ( !m_outputFile.EndsWith(".json") && !m_outputFile.EndsWith(".csv") )
+        {
+            wxFprintf(stderr, "Output file must have .json or .csv extension.\n");
+
+            return false;
+        }
+    }
+
     const bool runTimeSpecified = parser.Found(OPTION_RUN_TIME, &m_runTime);
     const bool numRunsSpecified = parser.Found(OPTION_NUM_RUNS, &m_numRuns);
+    const bool warmupSpecified = parser.Found(OPTION_WARMUP, &m_numWarmup);
+    const bool iterationsSpecified = parser.Found(OPTION_ITERATIONS,
+                                                  &m_numIterations);
     parser.Found(OPTION_NUMERIC_PARAM, &m_numParam);
     parser.Found(OPTION_STRING_PARAM, &m_strParam);
     if ( parser.Found(OPTION_SINGLE) )
     {
-        if ( runTimeSpecified || numRunsSpecified )
+        if ( runTimeSpecified || numRunsSpecified ||
+                warmupSpecified || iterationsSpecified )
         {
             wxFprintf(stderr, "Incompatible options specified.\n");
 
@@ -211,6 +416,14 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
         }
 
         m_numRuns = 1;
+        m_numWarmup = 0;
+        m_numIterations = 1;
+    }
+    else if ( m_numWarmup < 0 || m_numIterations < 0 )
+    {
+        wxFprintf(stderr, "Invalid number of warm-up runs or iterations.\n");
+
+        return false;
     }
     else if ( numRunsSpecified && !runTimeSpecified )
     {
@@ -244,6 +457,9 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
 
 int BenchApp::OnRun()
 {
+    if ( m_compare )
+        return CompareResults();
+
     int rc = EXIT_SUCCESS;
 
     wxString params;
@@ -273,9 +489,49 @@ int BenchApp::OnRun()
         }
     }
 
+    if ( !m_outputFile.empty() && !SaveResults() )
+    {
+        wxFprintf(stderr, "ERROR saving results to \"%s\"\n", m_outputFile);
+        rc = EXIT_FAILURE;
+    }
+
     return rc;
 }
 
+double BenchApp::RunIterations(Bench::Function* func, long iterations)
+{
+    wxStopWatch sw;
+    for ( long i = 0; i < iterations; i++ )
+    {
+        if ( !func->Run() )
+            return -1;
+    }
+
+    return sw.TimeInMicro().ToDouble();
+}
+
+namespace
+{
+
+// Format the time given in microseconds with a reasonable precision.
+wxString FormatTime(double us)
+{
+    return wxString::Format("%.*fus", us < 10 ? 3 : us < 100 ? 1 : 0, us);
+}
+
+// Return the value of the given percentile of the sorted values using the
+// nearest-rank method.
+double GetPercentile(const wxVector<double>& sorted, int percentile)
+{
+    size_t rank = (sorted.size()*percentile + 99) / 100;
+    if ( rank )
+        rank--;
+
+    return sorted[rank];
+}
+
+} // anonymous namespace
+
 bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 {
     if ( !func->Init() )
@@ -284,54 +540,59 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
     wxPrintf("Benchmarking %s: ", func->GetName());
     fflush(stdout);
 
-    // We use the algorithm for iteratively computing the mean and the
-    // standard deviation of the sequence of values described in Knuth's
-    // "The Art of Computer Programming, Volume 2: Seminumerical
-    // Algorithms", section 4.2.2.
-    //
-    // The algorithm defines the sequences M(k) and S(k) as follows:
-    //
-    //  M(1) = x(1), M(k) = M(k-1) + (x(k) - M(k-1)) / k
-    //  S(1) = 0,    S(k) = S(k-1) + (x(k) - M(k-1))*(x(k) - M(k))
-    //
-    // where x(k) is the k-th value. Then the mean is simply the last value
-    // of the first sequence M(N) and the standard deviation is
-    // sqrt(S(N)/(N-1)).
-
     wxStopWatch swTotal;
-    if ( !func->Run() )
-        return false;
-
-    double timeMin = DBL_MAX,
-           timeMax = 0;
 
-    double m = swTotal.TimeInMicro().ToDouble();
-    double s = 0;
-
-    long n = 0;
-    for ( ;; )
+    // Warm up the caches and let the benchmark perform any lazy
+    // initialization before measuring anything.
+    for ( long n = 0; n < m_numWarmup; n++ )
     {
-        // One termination condition is reaching the maximum number of runs.
-        if ( ++n == m_numRuns )
-            break;
+        if ( !func->Run() )
+            return false;
+    }
 
-        double t;
+    // Run the benchmark in batches of iterations long enough to be measured
+    // precisely, unless the number of iterations is given explicitly.
+    long iterations = m_numIterations;
+    if ( !iterations )
+    {
+        for ( iterations = 1; iterations < MAX_ITERATIONS; iterations *= 2 )
         {
-            wxStopWatch swThis;
-            if ( !func->Run() )
+            const double t = RunIterations(func, iterations);
+            if ( t < 0 )
                 return false;
 
-            t = swThis.TimeInMicro().ToDouble();
+            if ( t >= MIN_SAMPLE_TIME )
+                break;
         }
+    }
+
+    swTotal.Start();
+
+    wxVector<double> times;
+    wxVector<double> cycles;
+#ifdef wxBENCH_COUNT_ALLOCS
+    const wxUint32 allocsStart = gs_numAllocs;
+#endif
+
+    for ( ;; )
+    {
+#ifdef wxBENCH_HAS_CYCLES
+        const wxUint64 cyclesStart = GetCPUCycles();
+#endif
+
+        const double t = RunIterations(func, iterations);
+        if ( t < 0 )
+            return false;
+
+#ifdef wxBENCH_HAS_CYCLES
+        cycles.push_back(double(GetCPUCycles() - cyclesStart) / iterations);
+#endif
 
-        if ( t < timeMin )
-            timeMin = t;
-        if ( t > timeMax )
-            timeMax = t;
+        times.push_back(t / iterations);
 
-        const double lastM = m;
-        m += (t - lastM) / n;
-        s += (t - lastM)*(t - m);
+        // One termination condition is reaching the maximum number of runs.
+        if ( times.size() == static_cast<size_t>(m_numRuns) )
+            break;
 
         // The other termination condition is that we are running for at least
         // m_runTime milliseconds.
@@ -341,28 +602,371 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 
     func->Done();
 
-    // For a single run there is no standard deviation and min/max don't make
-    // much sense.
-    if ( n == 1 )
+    BenchResult res;
+    res.name = func->GetName();
+    res.samples = times.size();
+    res.iterations = iterations;
+
+    double sum = 0;
+    for ( size_t n = 0; n < times.size(); n++ )
+        sum += times[n];
+    res.mean = sum / times.size();
+
+    if ( times.size() > 1 )
     {
-        wxPrintf("single run took %.0fus\n", m);
+        double sumSq = 0;
+        for ( size_t n = 0; n < times.size(); n++ )
+            sumSq += (times[n] - res.mean)*(times[n] - res.mean);
+        res.stddev = sqrt(sumSq / (times.size() - 1));
     }
-    else
+
+    std::sort(times.begin(), times.end());
+    res.median = GetPercentile(times, 50);
+    res.p95 = GetPercentile(times, 95);
+    res.min = times.front();
+    res.max = times.back();
+
+    if ( !cycles.empty() )
     {
-        s = sqrt(s / (n - 1));
+        std::sort(cycles.begin(), cycles.end());
+        res.cycles = GetPercentile(cycles, 50);
+    }
+
+#ifdef wxBENCH_COUNT_ALLOCS
+    res.allocs = double(gs_numAllocs - allocsStart) / (res.samples*iterations);
+#endif
 
+    // For a single run there is no standard deviation and the other
+    // statistics don't make much sense.
+    if ( res.samples == 1 && iterations == 1 )
+    {
+        wxPrintf("single run took %s\n", FormatTime(res.mean));
+    }
+    else
+    {
         wxPrintf
         (
-            "%ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)\n",
-            n, m, s, timeMin, timeMax
+            "%ld runs of %ld, %s median, %s avg, %s p95, %s std dev "
+            "(%s/%s min/max)",
+            res.samples, res.iterations,
+            FormatTime(res.median), FormatTime(res.mean), FormatTime(res.p95),
+            FormatTime(res.stddev), FormatTime(res.min), FormatTime(res.max)
         );
+
+        if ( res.cycles >= 0 )
+            wxPrintf(", %.0f cycles", res.cycles);
+        if ( res.allocs >= 0 )
+            wxPrintf(", %.1f allocs", res.allocs);
+
+        wxPrintf("\n");
     }
 
     fflush(stdout);
 
+    m_results.push_back(res);
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// results files
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Names of the fields in the order in which they're written to CSV files.
+const char* const FIELD_NAMES[] =
+{
+    "name",
+    "samples",
+    "iterations",
+    "mean_us",
+    "median_us",
+    "p95_us",
+    "stddev_us",
+    "min_us",
+    "max_us",
+    "cycles",
+    "allocs",
+};
+
+// Return the values of all fields of the result as strings, with the unknown
+// values being empty.
+wxArrayString GetFieldValues(const BenchResult& res)
+{
+    wxArrayString values;
+    values.push_back(res.name);
+    values.push_back(wxString::Format("%ld", res.samples));
+    values.push_back(wxString::Format("%ld", res.iterations));
+    values.push_back(wxString::Format("%.4f", res.mean));
+    values.push_back(wxString::Format("%.4f", res.median));
+    values.push_back(wxString::Format("%.4f", res.p95));
+    values.push_back(wxString::Format("%.4f", res.stddev));
+    values.push_back(wxString::Format("%.4f", res.min));
+    values.push_back(wxString::Format("%.4f", res.max));
+    values.push_back(res.cycles >= 0 ? wxString::Format("%.0f", res.cycles)
+                                     : wxString());
+    values.push_back(res.allocs >= 0 ? wxString::Format("%.2f", res.allocs)
+                                     : wxString());
+
+    return values;
+}
+
+// Fill in the result from the field values read from a file.
+bool SetFieldValues(BenchResult& res, const wxArrayString& values)
+{
+    if ( values.size() != WXSIZEOF(FIELD_NAMES) )
+        return false;
+
+    res.name = values[0];
+    if ( res.name.empty() ||
+            !values[1].ToLong(&res.samples) ||
+                !values[2].ToLong(&res.iterations) ||
+                    !values[3].ToCDouble(&res.mean) ||
+                        !values[4].ToCDouble(&res.median) ||
+                            !values[5].ToCDouble(&res.p95) ||
+                                !values[6].ToCDouble(&res.stddev) ||
+                                    !values[7].ToCDouble(&res.min) ||
+                                        !values[8].ToCDouble(&res.max) )
+        return false;
+
+    if ( !values[9].empty() && !values[9].ToCDouble(&res.cycles) )
+        return false;
+    if ( !values[10].empty() && !values[10].ToCDouble(&res.allocs) )
+        return false;
+
     return true;
 }
 
+// Read the results from a file previously written by SaveResults().
+bool ReadResults(const wxString& filename, BenchResults& results)
+{
+    wxString text;
+    wxFFile file(filename);
+    if ( !file.IsOpened() || !file.ReadAll(&text) )
+        return false;
+
+    const bool isJSON = filename.EndsWith(".json");
+
+    wxStringTokenizer tkLines(text, "\r\n");
+    while ( tkLines.HasMoreTokens() )
+    {
+        const wxString line = tkLines.GetNextToken();
+
+        wxArrayString values;
+        if ( isJSON )
+        {
+            // We only need to parse the files in the format we write, with
+            // one object per line, and not arbitrary JSON.
+            if ( line.Find("\"name\":") == wxNOT_FOUND )
+                continue;
+
+            for ( size_t n = 0; n < WXSIZEOF(FIELD_NAMES); n++ )
+            {
+                const wxString key = wxString::Format("\"%s\": ", FIELD_NAMES[n]);
+                const int pos = line.Find(key);
+                if ( pos == wxNOT_FOUND )
+                    return false;
+
+                wxString value = line.Mid(pos + key.length());
+                value = value.BeforeFirst(',').BeforeFirst('}');
+                value.Trim();
+                if ( value == "null" )
+                    value.clear();
+                else if ( value.StartsWith("\"") )
+                    value = value.Mid(1).BeforeFirst('"');
+
+                values.push_back(value);
+            }
+        }
+        else
+        {
+            if ( line.StartsWith("name,") )
+                continue;
+
+            values = wxSplit(line, ',', '\0');
+        }
+
+        BenchResult res;
+        if ( !SetFieldValues(res, values) )
+            return false;
+
+        results.push_back(res);
+    }
+
+    return true;
+}
+
+// Return the critical value of Student's t distribution for the two-sided
+// test at 95% confidence level and the given number of degrees of freedom.
+double GetCriticalT(double df)
+{
+    static const double values[] =
+    {
+        12.71, 4.30, 3.18, 2.78, 2.57, 2.45, 2.36, 2.31, 2.26, 2.23,
+         2.20, 2.18, 2.16, 2.14, 2.13, 2.12, 2.11, 2.10, 2.09, 2.09,
+         2.08, 2.07, 2.07, 2.06, 2.06, 2.06, 2.05, 2.05, 2.05, 2.04,
+    };
+
+    const size_t n = static_cast<size_t>(df);
+    if ( n < 1 )
+        return values[0];
+
+    return n <= WXSIZEOF(values) ? values[n - 1] : 1.96;
+}
+
+} // anonymous namespace
+
+bool BenchApp::SaveResults() const
+{
+    wxFFile file(m_outputFile, "w");
+    if ( !file.IsOpened() )
+        return false;
+
+    wxString text;
+    if ( m_outputFile.EndsWith(".json") )
+    {
+        text << "{\n"
+             << "\"build\": \"" << WX_BUILD_OPTIONS_SIGNATURE << "\",\n"
+             << "\"num_param\": " << m_numParam << ",\n"
+             << "\"benchmarks\": [\n";
+
+        for ( size_t n = 0; n < m_results.size(); n++ )
+        {
+            const wxArrayString values = GetFieldValues(m_results[n]);
+
+            text << "{";
+            for ( size_t i = 0; i < values.size(); i++ )
+            {
+                if ( i )
+                    text << ", ";
+
+                text << "\"" << FIELD_NAMES[i] << "\": ";
+                if ( !i )
+                    text << "\"" << values[i] << "\"";
+                else if ( values[i].empty() )
+                    text << "null";
+                else
+                    text << values[i];
+            }
+            text << (n + 1 < m_results.size() ? "},\n" : "}\n");
+        }
+
+        text << "]\n"
+             << "}\n";
+    }
+    else // CSV
+    {
+        for ( size_t i = 0; i < WXSIZEOF(FIELD_NAMES); i++ )
+        {
+            if ( i )
+                text << ",";
+            text << FIELD_NAMES[i];
+        }
+        text << "\n";
+
+        for ( size_t n = 0; n < m_results.size(); n++ )
+            text << wxJoin(GetFieldValues(m_results[n]), ',', '\0') << "\n";
+    }
+
+    return file.Write(text) && file.Close();
+}
+
+int BenchApp::CompareResults() const
+{
+    BenchResults results[2];
+    for ( int n = 0; n < 2; n++ )
+    {
+        if ( !ReadResults(m_compareFiles[n], results[n]) )
+        {
+            wxFprintf(stderr, "Failed to read results from \"%s\".\n",
+                      m_compareFiles[n]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    wxPrintf("%-30s %12s %12s %8s\n", "Benchmark", "Old median", "New median",
+             "Change");
+
+    int rc = EXIT_SUCCESS;
+    for ( size_t n = 0; n < results[1].size(); n++ )
+    {
+        const BenchResult& resNew = results[1][n];
+
+        const BenchResult* resOld = NULL;
+        for ( size_t i = 0; i < results[0].size(); i++ )
+        {
+            if ( results[0][i].name == resNew.name )
+            {
+                resOld = &results[0][i];
+                break;
+            }
+        }
+
+        if ( !resOld )
+        {
+            wxPrintf("%-30s %12s %12s\n",
+                     resNew.name, "-", FormatTime(resNew.median));
+            continue;
+        }
+
+        const double change = resOld->median > 0
+                                ? 100*(resNew.median - resOld->median)/resOld->median
+                                : 0;
+
+        wxString verdict;
+        if ( resOld->samples < 2 || resNew.samples < 2 )
+        {
+            verdict = "not enough runs";
+        }
+        else if ( fabs(change) >= m_threshold )
+        {
+            // Use Welch's t-test to check if the difference of the means is
+            // statistically significant.
+            const double v1 = resOld->stddev*resOld->stddev / resOld->samples,
+                         v2 = resNew.stddev*resNew.stddev / resNew.samples;
+
+            bool significant;
+            if ( v1 + v2 > 0 )
+            {
+                const double t = (resNew.mean - resOld->mean) / sqrt(v1 + v2);
+                const double df = (v1 + v2)*(v1 + v2) /
+                                    (v1*v1/(resOld->samples - 1) +
+                                     v2*v2/(resNew.samples - 1));
+
+                significant = fabs(t) > GetCriticalT(df);
+            }
+            else // no variance at all, any difference is significant
+            {
+                significant = true;
+            }
+
+            if ( significant )
+            {
+                if ( change > 0 )
+                {
+                    verdict = "REGRESSION";
+                    rc = EXIT_FAILURE;
+                }
+                else
+                {
+                    verdict = "improvement";
+                }
+            }
+        }
+
+        wxPrintf("%-30s %12s %12s %+7.1f%% %s\n",
+                 resNew.name,
+                 FormatTime(resOld->median),
+                 FormatTime(resNew.median),
+                 change,
+                 verdict);
+    }
+
+    return rc;
+}
+
 int BenchApp::OnExit()
 {
 #if wxUSE_GUI
@@ -0,0 +1,214 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dataview.cpp
+// Purpose:     wxDataViewCtrl tree model benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/dataview.h"
+#include "wx/frame.h"
+
+#include "bench.h"
+
+#if wxUSE_DATAVIEWCTRL
+
+// ----------------------------------------------------------------------------
+// Benchmarks using a big tree model with 500 top level containers having 1000
+// children each, i.e. 500500 items when all of them are expanded. The numeric
+// parameter specifies the number of items selected, scrolled to or expanded
+// in each iteration (100 by default).
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const unsigned NUM_CONTAINERS = 500;
+const unsigned NUM_CHILDREN = 1000;
+
+// Items are identified by consecutive numbers starting from 1, with each
+// container immediately followed by its children.
+class BenchTreeModel : public wxDataViewModel
+{
+public:
+    BenchTreeModel() { }
+
+    static wxDataViewItem GetContainer(unsigned n)
+    {
+        return wxDataViewItem(wxUIntToPtr(n*(NUM_CHILDREN + 1) + 1));
+    }
+
+    static wxDataViewItem GetChild(unsigned n, unsigned child)
+    {
+        return wxDataViewItem(wxUIntToPtr(n*(NUM_CHILDREN + 1) + child + 2));
+    }
+
+    virtual unsigned int GetColumnCount() const wxOVERRIDE { return 1; }
+
+    virtual wxString GetColumnType(unsigned int WXUNUSED(col)) const wxOVERRIDE
+    {
+        return "string";
+    }
+
+    virtual void GetValue(wxVariant& variant,
+                          const wxDataViewItem& item,
+                          unsigned int WXUNUSED(col)) const wxOVERRIDE
+    {
+        variant = wxString::Format("Item %u", GetIndex(item));
+    }
+
+    virtual bool SetValue(const wxVariant& WXUNUSED(variant),
+                          const wxDataViewItem& WXUNUSED(item),
+                          unsigned int WXUNUSED(col)) wxOVERRIDE
+    {
+        return false;
+    }
+
+    virtual wxDataViewItem GetParent(const wxDataViewItem& item) const wxOVERRIDE
+    {
+        const unsigned index = GetIndex(item);
+        if ( index % (NUM_CHILDREN + 1) == 0 )
+            return wxDataViewItem();
+
+        return GetContainer(index / (NUM_CHILDREN + 1));
+    }
+
+    virtual bool IsContainer(const wxDataViewItem& item) const wxOVERRIDE
+    {
+        return !item.IsOk() || GetIndex(item) % (NUM_CHILDREN + 1) == 0;
+    }
+
+    virtual unsigned int GetChildren(const wxDataViewItem& item,
+                                     wxDataViewItemArray& children) const wxOVERRIDE
+    {
+        if ( !item.IsOk() )
+        {
+            for ( unsigned n = 0; n < NUM_CONTAINERS; n++ )
+                children.push_back(GetContainer(n));
+
+            return NUM_CONTAINERS;
+        }
+
+        const unsigned index = GetIndex(item);
+        if ( index % (NUM_CHILDREN + 1) )
+            return 0;
+
+        const unsigned n = index / (NUM_CHILDREN + 1);
+        for ( unsigned child = 0; child < NUM_CHILDREN; child++ )
+            children.push_back(GetChild(n, child));
+
+        return NUM_CHILDREN;
+    }
+
+private:
+    static unsigned GetIndex(const wxDataViewItem& item)
+    {
+        return wxPtrToUInt(item.GetID()) - 1;
+    }
+};
+
+wxFrame* gs_frame = NULL;
+wxDataViewCtrl* gs_dvc = NULL;
+
+bool InitDataView()
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxDataViewCtrl benchmark",
+                           wxDefaultPosition, wxSize(800, 600));
+    gs_dvc = new wxDataViewCtrl(gs_frame, wxID_ANY,
+                                wxDefaultPosition, wxDefaultSize,
+                                wxDV_MULTIPLE);
+    gs_dvc->AppendTextColumn("Item", 0);
+
+    wxObjectDataPtr<BenchTreeModel> model(new BenchTreeModel);
+    gs_dvc->AssociateModel(model.get());
+
+    gs_frame->Show();
+
+    return true;
+}
+
+bool InitDataViewExpanded()
+{
+    if ( !InitDataView() )
+        return false;
+
+    for ( unsigned n = 0; n < NUM_CONTAINERS; n++ )
+        gs_dvc->Expand(BenchTreeModel::GetContainer(n));
+
+    return gs_dvc->IsExpanded(BenchTreeModel::GetContainer(NUM_CONTAINERS - 1));
+}
+
+void DoneDataView()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_dvc = NULL;
+}
+
+// Returns a pseudo-random number less than the given one: we don't want to
+// use rand() to make the results reproducible.
+unsigned GetNext(unsigned& seed, unsigned max)
+{
+    seed = seed*1103515245u + 12345u;
+    return (seed >> 8) % max;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(DataViewExpandCollapse, InitDataViewExpanded, DoneDataView)
+{
+    static unsigned s_seed = 0;
+
+    const long count = Bench::GetNumericParameter(100);
+    for ( long n = 0; n < count; n++ )
+    {
+        const wxDataViewItem
+            item = BenchTreeModel::GetContainer(GetNext(s_seed, NUM_CONTAINERS));
+        gs_dvc->Collapse(item);
+        gs_dvc->Expand(item);
+    }
+
+    return gs_dvc->IsExpanded(BenchTreeModel::GetContainer(0));
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewSelections, InitDataViewExpanded, DoneDataView)
+{
+    static unsigned s_seed = 0;
+
+    // Setting the selection maps the items to rows and getting it back maps
+    // the rows to items.
+    wxDataViewItemArray items;
+    const long count = Bench::GetNumericParameter(100);
+    for ( long n = 0; n < count; n++ )
+    {
+        items.push_back(BenchTreeModel::GetChild(GetNext(s_seed, NUM_CONTAINERS),
+                                                 GetNext(s_seed, NUM_CHILDREN)));
+    }
+
+    gs_dvc->SetSelections(items);
+
+    wxDataViewItemArray selections;
+    return gs_dvc->GetSelections(selections) > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(DataViewScroll, InitDataViewExpanded, DoneDataView)
+{
+    static unsigned s_seed = 0;
+
+    const long count = Bench::GetNumericParameter(100);
+    for ( long n = 0; n < count; n++ )
+    {
+        const wxDataViewItem
+            item = BenchTreeModel::GetChild(GetNext(s_seed, NUM_CONTAINERS),
+                                            GetNext(s_seed, NUM_CHILDREN));
+        gs_dvc->EnsureVisible(item);
+        gs_dvc->SetCurrentItem(item);
+    }
+
+    gs_dvc->Update();
+
+    return gs_dvc->GetCurrentItem().IsOk();
+}
+
+#endif // wxUSE_DATAVIEWCTRL
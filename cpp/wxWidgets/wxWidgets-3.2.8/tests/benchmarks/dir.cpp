@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dir.cpp
+// Purpose:     wxDir enumeration and traversal benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/atomic.h"
+#include "wx/dir.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
+
+#include "bench.h"
+
+// ----------------------------------------------------------------------------
+// Benchmarks using a generated tree of 1110 directories, 10 in each of the 3
+// levels of nesting, containing files whose number is specified by the
+// numeric parameter (20 per directory by default).
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxString gs_root;
+
+bool CreateTree(const wxString& dir, int depth, long numFiles)
+{
+    if ( !wxFileName::Mkdir(dir) )
+        return false;
+
+    for ( long n = 0; n < numFiles; n++ )
+    {
+        wxFFile file(wxString::Format("%s/file%ld.dat", dir, n), "w");
+        if ( !file.IsOpened() )
+            return false;
+    }
+
+    if ( depth > 0 )
+    {
+        for ( int n = 0; n < 10; n++ )
+        {
+            if ( !CreateTree(wxString::Format("%s/dir%d", dir, n),
+                             depth - 1, numFiles) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool InitDirTree()
+{
+    wxFileName fn;
+    fn.AssignDir(wxFileName::GetTempDir());
+    fn.AppendDir(wxString::Format("wxbenchdir%lu", wxGetProcessId()));
+    gs_root = fn.GetPath();
+
+    return CreateTree(gs_root, 3, Bench::GetNumericParameter(20));
+}
+
+void DoneDirTree()
+{
+    wxFileName::Rmdir(gs_root, wxPATH_RMDIR_RECURSIVE);
+    gs_root.clear();
+}
+
+// This traverser is thread-safe and so can be used with wxDIR_PARALLEL.
+class CountingTraverser : public wxDirTraverser
+{
+public:
+    CountingTraverser() : m_numDirs(0) { }
+
+    virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) wxOVERRIDE
+    {
+        return wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnDir(const wxString& WXUNUSED(dirname)) wxOVERRIDE
+    {
+        wxAtomicInc(m_numDirs);
+        return wxDIR_CONTINUE;
+    }
+
+    int GetNumDirs() const { return m_numDirs; }
+
+private:
+    wxAtomicInt m_numDirs;
+};
+
+bool DoTraverse(int flags)
+{
+    wxDir dir(gs_root);
+
+    CountingTraverser traverser;
+    const size_t numFiles = dir.Traverse(traverser, wxString(), flags);
+
+    return traverser.GetNumDirs() == 1110 &&
+            numFiles == 1111 * static_cast<size_t>(Bench::GetNumericParameter(20));
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(DirGetFirstFiles, InitDirTree, DoneDirTree)
+{
+    wxDir dir(gs_root + "/dir0/dir0/dir0");
+
+    long count = 0;
+    wxString filename;
+    for ( bool cont = dir.GetFirst(&filename, wxString(), wxDIR_FILES);
+          cont;
+          cont = dir.GetNext(&filename) )
+    {
+        count++;
+    }
+
+    return count == Bench::GetNumericParameter(20);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirTraverse, InitDirTree, DoneDirTree)
+{
+    return DoTraverse(wxDIR_DEFAULT);
+}
+
+BENCHMARK_FUNC_WITH_INIT(DirTraverseParallel, InitDirTree, DoneDirTree)
+{
+    return DoTraverse(wxDIR_DEFAULT | wxDIR_PARALLEL);
+}
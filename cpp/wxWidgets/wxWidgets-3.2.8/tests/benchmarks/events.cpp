@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Benchmarks for queuing and processing pending events
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+namespace
+{
+
+// Number of events queued by each producer during a single benchmark run.
+const int NUM_EVENTS = 10000;
+
+// Event handler just counting the thread events it receives.
+class EventCounter : public wxEvtHandler
+{
+public:
+    EventCounter()
+    {
+        m_count = 0;
+
+        Bind(wxEVT_THREAD, &EventCounter::OnThreadEvent, this);
+    }
+
+    int GetCount() const { return m_count; }
+
+private:
+    void OnThreadEvent(wxThreadEvent& WXUNUSED(event)) { m_count++; }
+
+    int m_count;
+
+    wxDECLARE_NO_COPY_CLASS(EventCounter);
+};
+
+} // anonymous namespace
+
+// Queue the events from the main thread and process them all at once.
+BENCHMARK_FUNC(QueueEventMainThread)
+{
+    EventCounter counter;
+
+    for ( int n = 0; n < NUM_EVENTS; n++ )
+        counter.QueueEvent(new wxThreadEvent());
+
+    wxTheApp->ProcessPendingEvents();
+
+    return counter.GetCount() == NUM_EVENTS;
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+class EventProducerThread : public wxThread
+{
+public:
+    explicit EventProducerThread(wxEvtHandler* handler)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_handler(handler)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() wxOVERRIDE
+    {
+        for ( int n = 0; n < NUM_EVENTS; n++ )
+            m_handler->QueueEvent(new wxThreadEvent());
+
+        return 0;
+    }
+
+private:
+    wxEvtHandler* const m_handler;
+};
+
+} // anonymous namespace
+
+// Queue the events from the number of threads given by the numeric parameter
+// (4 by default) while processing them in the main thread as they arrive, as
+// a GUI application receiving notifications from its workers would do.
+//
+// Multiply the number of threads by NUM_EVENTS and divide it by the time
+// taken by a single run to get the number of events per second.
+BENCHMARK_FUNC(QueueEventThreads)
+{
+    const int numThreads = Bench::GetNumericParameter(4);
+
+    EventCounter counter;
+
+    wxVector<EventProducerThread*> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        EventProducerThread* const thread = new EventProducerThread(&counter);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    // Process the events posted by all the threads we managed to start, even
+    // if it's less than requested, before destroying the counter.
+    const int numEvents = static_cast<int>(threads.size())*NUM_EVENTS;
+    while ( counter.GetCount() < numEvents )
+        wxTheApp->ProcessPendingEvents();
+
+    for ( size_t n = 0; n < threads.size(); n++ )
+    {
+        threads[n]->Wait();
+        delete threads[n];
+    }
+
+    return threads.size() == static_cast<size_t>(numThreads) &&
+                counter.GetCount() == numEvents;
+}
+
+#endif // wxUSE_THREADS
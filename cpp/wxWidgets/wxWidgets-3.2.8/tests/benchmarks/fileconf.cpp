@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fileconf.cpp
+// Purpose:     wxFileConfig benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/fileconf.h"
+#include "wx/sstream.h"
+
+#if wxUSE_FILECONFIG
+
+namespace
+{
+
+// Number of groups in the test file, each containing the number of entries
+// given by the numeric parameter (1000 by default).
+const int NUM_GROUPS = 40;
+
+// Return the contents of a big config file with the entries in each group in
+// reverse alphabetical order.
+const wxString& GetConfigText()
+{
+    static wxString s_text;
+    if ( s_text.empty() )
+    {
+        const int numEntries = Bench::GetNumericParameter(1000);
+
+        for ( int g = 0; g < NUM_GROUPS; g++ )
+        {
+            s_text += wxString::Format("[Group%d]\n", g);
+            for ( int n = numEntries - 1; n >= 0; n-- )
+                s_text += wxString::Format("Entry%d=Value %d\n", n, n);
+        }
+    }
+
+    return s_text;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(FileConfigLoad)
+{
+    wxStringInputStream sis(GetConfigText());
+    wxFileConfig fc(sis);
+
+    return fc.GetNumberOfGroups() == NUM_GROUPS;
+}
+
+BENCHMARK_FUNC(FileConfigRead)
+{
+    static wxStringInputStream sis(GetConfigText());
+    static wxFileConfig fc(sis);
+
+    const int numEntries = Bench::GetNumericParameter(1000);
+
+    wxString value;
+    for ( int g = 0; g < NUM_GROUPS; g++ )
+    {
+        fc.SetPath(wxString::Format("/Group%d", g));
+        for ( int n = 0; n < numEntries; n += 10 )
+        {
+            if ( !fc.Read(wxString::Format("Entry%d", n), &value) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+#endif // wxUSE_FILECONFIG
@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fswatcher.cpp
+// Purpose:     wxFileSystemWatcher benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/evtloop.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
+#include "wx/fswatcher.h"
+
+#include "bench.h"
+
+#if wxUSE_FSWATCHER
+
+// ----------------------------------------------------------------------------
+// Benchmarks using a generated tree of 1110 directories, 10 in each of the 3
+// levels of nesting, and a directory with 10 files which are modified as many
+// times as specified by the numeric parameter (1000 by default).
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const int NUM_FILES = 10;
+
+wxString gs_root;
+wxEventLoopBase* gs_loop = NULL;
+
+bool CreateTree(const wxString& dir, int depth)
+{
+    if ( !wxFileName::Mkdir(dir) )
+        return false;
+
+    if ( depth > 0 )
+    {
+        for ( int n = 0; n < 10; n++ )
+        {
+            if ( !CreateTree(wxString::Format("%s/dir%d", dir, n), depth - 1) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool InitWatchDir(int depth)
+{
+    // The watcher can only be created when there is an active event loop.
+    gs_loop = new wxEventLoop;
+    wxEventLoopBase::SetActive(gs_loop);
+
+    wxFileName fn;
+    fn.AssignDir(wxFileName::GetTempDir());
+    fn.AppendDir(wxString::Format("wxbenchfsw%lu", wxGetProcessId()));
+    gs_root = fn.GetPath();
+
+    return CreateTree(gs_root, depth);
+}
+
+bool InitWatchTree()
+{
+    return InitWatchDir(3);
+}
+
+bool InitWatchFiles()
+{
+    return InitWatchDir(0);
+}
+
+void DoneWatchDir()
+{
+    wxFileName::Rmdir(gs_root, wxPATH_RMDIR_RECURSIVE);
+    gs_root.clear();
+
+    wxEventLoopBase::SetActive(NULL);
+    wxDELETE(gs_loop);
+}
+
+class EventCounter : public wxEvtHandler
+{
+public:
+    EventCounter() : m_numEvents(0)
+    {
+        Bind(wxEVT_FSWATCHER, &EventCounter::OnFileSystemEvent, this);
+    }
+
+    int GetNumEvents() const { return m_numEvents; }
+
+private:
+    void OnFileSystemEvent(wxFileSystemWatcherEvent& WXUNUSED(event))
+    {
+        m_numEvents++;
+    }
+
+    int m_numEvents;
+};
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(FSWatcherAddTree, InitWatchTree, DoneWatchDir)
+{
+    wxFileSystemWatcher watcher;
+
+    if ( !watcher.AddTree(wxFileName::DirName(gs_root)) )
+        return false;
+
+    return watcher.GetWatchedPathsCount() == 1111;
+}
+
+BENCHMARK_FUNC_WITH_INIT(FSWatcherEvents, InitWatchFiles, DoneWatchDir)
+{
+    EventCounter counter;
+
+    wxFileSystemWatcher watcher;
+    watcher.SetOwner(&counter);
+    if ( !watcher.Add(wxFileName::DirName(gs_root), wxFSW_EVENT_MODIFY) )
+        return false;
+
+    // Modify all files in turn, so that the kernel doesn't merge the
+    // successive events for the same file itself.
+    wxFFile files[NUM_FILES];
+    for ( int n = 0; n < NUM_FILES; n++ )
+    {
+        if ( !files[n].Open(wxString::Format("%s/file%d.txt", gs_root, n), "w") )
+            return false;
+    }
+
+    const long count = Bench::GetNumericParameter(1000);
+    for ( long n = 0; n < count; n++ )
+    {
+        wxFFile& file = files[n % NUM_FILES];
+        file.Write("x", 1);
+        file.Flush();
+    }
+
+    while ( gs_loop->DispatchTimeout(0) == 1 )
+        ;
+
+    return counter.GetNumEvents() > 0;
+}
+
+#endif // wxUSE_FSWATCHER
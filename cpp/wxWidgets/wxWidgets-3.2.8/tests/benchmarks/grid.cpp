@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid painting benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/frame.h"
+#include "wx/grid.h"
+
+#include "bench.h"
+
+// ----------------------------------------------------------------------------
+// Benchmarks using a big virtual grid: the numeric parameter specifies the
+// number of rows to scroll by or to update in each iteration (10 by default)
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Virtual table with many rows and columns containing numbers formatted on
+// demand, similar to what a real application showing live data would use.
+class BenchGridTable : public wxGridTableBase
+{
+public:
+    BenchGridTable() { m_generation = 0; }
+
+    virtual int GetNumberRows() wxOVERRIDE { return 1000000; }
+    virtual int GetNumberCols() wxOVERRIDE { return 200; }
+
+    virtual wxString GetValue(int row, int col) wxOVERRIDE
+    {
+        const unsigned n = (row*131u + col*17u + m_generation) % 100000;
+        return wxString::Format("%u.%02u", n / 100, n % 100);
+    }
+
+    virtual void SetValue(int WXUNUSED(row), int WXUNUSED(col),
+                          const wxString& WXUNUSED(value)) wxOVERRIDE
+    {
+        // Changing any value changes all of them, which is fine as only the
+        // refreshed cells are going to be repainted anyhow.
+        m_generation++;
+    }
+
+private:
+    unsigned m_generation;
+};
+
+wxFrame* gs_frame = NULL;
+wxGrid* gs_grid = NULL;
+
+bool InitGrid()
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxGrid benchmark",
+                           wxDefaultPosition, wxSize(1024, 768));
+    gs_grid = new wxGrid(gs_frame, wxID_ANY);
+    gs_grid->SetTable(new BenchGridTable, true /* take ownership */);
+    gs_frame->Show();
+
+    // Make sure the initial painting is done before starting measuring.
+    gs_grid->GetGridWindow()->Update();
+
+    return true;
+}
+
+void DoneGrid()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_grid = NULL;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(GridScroll, InitGrid, DoneGrid)
+{
+    static int s_row = 0;
+
+    const int step = Bench::GetNumericParameter(10);
+    s_row += step;
+    if ( s_row >= gs_grid->GetNumberRows() - step )
+        s_row = 0;
+
+    int unitX, unitY;
+    gs_grid->GetScrollPixelsPerUnit(&unitX, &unitY);
+    gs_grid->Scroll(-1, gs_grid->CellToRect(s_row, 0).GetTop() / unitY);
+    gs_grid->GetGridWindow()->Update();
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(GridUpdateCells, InitGrid, DoneGrid)
+{
+    static int s_col = 0;
+
+    // Update one cell in each of the first rows, as it happens when new data
+    // arrives for them, and repaint the grid.
+    const int rows = Bench::GetNumericParameter(10);
+    for ( int row = 0; row < rows; row++ )
+        gs_grid->SetCellValue(row, s_col, "0.00");
+
+    s_col = (s_col + 1) % 10;
+
+    gs_grid->GetGridWindow()->Update();
+
+    return true;
+}
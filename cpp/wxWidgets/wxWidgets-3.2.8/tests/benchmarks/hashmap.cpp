@@ -0,0 +1,206 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/hashmap.cpp
+// Purpose:     wxHashMap benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/hashmap.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+#if __cplusplus >= 201103L || wxCHECK_VISUALC_VERSION(10)
+    #include <unordered_map>
+    #define HAS_STD_UNORDERED_MAP
+#endif
+
+// ----------------------------------------------------------------------------
+// Compare the chained and open addressing implementations of wxHashMap, which
+// are only available if wxUSE_STD_CONTAINERS is off, with the standard
+// std::unordered_map. The numeric parameter specifies the number of elements
+// in the maps (10000 by default).
+// ----------------------------------------------------------------------------
+
+#ifdef wxNEEDS_WX_HASH_MAP
+
+_WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_CHAINED_HASHTABLE,
+                                 long, long, wxIntegerHash, wxIntegerEqual,
+                                 ChainedIntMap, class );
+_WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_CHAINED_HASHTABLE,
+                                 wxString, long, wxStringHash, wxStringEqual,
+                                 ChainedStringMap, class );
+
+_WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_FLAT_HASHTABLE,
+                                 long, long, wxIntegerHash, wxIntegerEqual,
+                                 FlatIntMap, class );
+_WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_FLAT_HASHTABLE,
+                                 wxString, long, wxStringHash, wxStringEqual,
+                                 FlatStringMap, class );
+
+#endif // wxNEEDS_WX_HASH_MAP
+
+#ifdef HAS_STD_UNORDERED_MAP
+
+typedef std::unordered_map<long, long> StdIntMap;
+typedef std::unordered_map<wxString, long, wxStringHash, wxStringEqual>
+    StdStringMap;
+
+#endif // HAS_STD_UNORDERED_MAP
+
+namespace
+{
+
+int GetNumElements()
+{
+    return Bench::GetNumericParameter(10000);
+}
+
+// Integer keys are spread out to make them less regular.
+long GetIntKey(int n)
+{
+    return n*7919L;
+}
+
+const wxVector<wxString>& GetStringKeys()
+{
+    static wxVector<wxString> s_keys;
+    if ( s_keys.empty() )
+    {
+        const int numElements = GetNumElements();
+
+        // Use twice as many keys to be able to look up the missing ones too.
+        s_keys.reserve(2*numElements);
+        for ( int n = 0; n < 2*numElements; n++ )
+            s_keys.push_back(wxString::Format("/Group%d/Entry%d", n % 97, n));
+    }
+
+    return s_keys;
+}
+
+template <typename Map>
+bool DoIntInsert()
+{
+    Map map;
+
+    const int numElements = GetNumElements();
+    for ( int n = 0; n < numElements; n++ )
+        map[GetIntKey(n)] = n;
+
+    return map.size() == static_cast<size_t>(numElements);
+}
+
+template <typename Map>
+bool DoIntFind()
+{
+    static Map s_map;
+
+    const int numElements = GetNumElements();
+    if ( s_map.empty() )
+    {
+        for ( int n = 0; n < numElements; n++ )
+            s_map[GetIntKey(n)] = n;
+    }
+
+    // Look up the elements present in the map and as many missing ones.
+    int found = 0;
+    for ( int n = 0; n < 2*numElements; n++ )
+    {
+        if ( s_map.find(GetIntKey(n)) != s_map.end() )
+            found++;
+    }
+
+    return found == numElements;
+}
+
+template <typename Map>
+bool DoStringInsert()
+{
+    Map map;
+
+    const wxVector<wxString>& keys = GetStringKeys();
+    const int numElements = GetNumElements();
+    for ( int n = 0; n < numElements; n++ )
+        map[keys[n]] = n;
+
+    return map.size() == static_cast<size_t>(numElements);
+}
+
+template <typename Map>
+bool DoStringFind()
+{
+    static Map s_map;
+
+    const wxVector<wxString>& keys = GetStringKeys();
+    const int numElements = GetNumElements();
+    if ( s_map.empty() )
+    {
+        for ( int n = 0; n < numElements; n++ )
+            s_map[keys[n]] = n;
+    }
+
+    int found = 0;
+    for ( int n = 0; n < 2*numElements; n++ )
+    {
+        if ( s_map.find(keys[n]) != s_map.end() )
+            found++;
+    }
+
+    return found == numElements;
+}
+
+template <typename Map>
+bool DoIntIterate()
+{
+    static Map s_map;
+
+    const int numElements = GetNumElements();
+    if ( s_map.empty() )
+    {
+        for ( int n = 0; n < numElements; n++ )
+            s_map[GetIntKey(n)] = n;
+    }
+
+    long sum = 0;
+    for ( typename Map::const_iterator it = s_map.begin();
+          it != s_map.end();
+          ++it )
+    {
+        sum += it->second;
+    }
+
+    return sum == static_cast<long>(numElements)*(numElements - 1)/2;
+}
+
+} // anonymous namespace
+
+#ifdef wxNEEDS_WX_HASH_MAP
+
+BENCHMARK_FUNC(HashMapIntInsertChained) { return DoIntInsert<ChainedIntMap>(); }
+BENCHMARK_FUNC(HashMapIntInsertFlat) { return DoIntInsert<FlatIntMap>(); }
+
+BENCHMARK_FUNC(HashMapIntFindChained) { return DoIntFind<ChainedIntMap>(); }
+BENCHMARK_FUNC(HashMapIntFindFlat) { return DoIntFind<FlatIntMap>(); }
+
+BENCHMARK_FUNC(HashMapIntIterateChained) { return DoIntIterate<ChainedIntMap>(); }
+BENCHMARK_FUNC(HashMapIntIterateFlat) { return DoIntIterate<FlatIntMap>(); }
+
+BENCHMARK_FUNC(HashMapStringInsertChained) { return DoStringInsert<ChainedStringMap>(); }
+BENCHMARK_FUNC(HashMapStringInsertFlat) { return DoStringInsert<FlatStringMap>(); }
+
+BENCHMARK_FUNC(HashMapStringFindChained) { return DoStringFind<ChainedStringMap>(); }
+BENCHMARK_FUNC(HashMapStringFindFlat) { return DoStringFind<FlatStringMap>(); }
+
+#endif // wxNEEDS_WX_HASH_MAP
+
+#ifdef HAS_STD_UNORDERED_MAP
+
+BENCHMARK_FUNC(HashMapIntInsertStd) { return DoIntInsert<StdIntMap>(); }
+BENCHMARK_FUNC(HashMapIntFindStd) { return DoIntFind<StdIntMap>(); }
+BENCHMARK_FUNC(HashMapIntIterateStd) { return DoIntIterate<StdIntMap>(); }
+BENCHMARK_FUNC(HashMapStringInsertStd) { return DoStringInsert<StdStringMap>(); }
+BENCHMARK_FUNC(HashMapStringFindStd) { return DoStringFind<StdStringMap>(); }
+
+#endif // HAS_STD_UNORDERED_MAP
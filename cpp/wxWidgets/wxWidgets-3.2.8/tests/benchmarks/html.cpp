@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/html.cpp
+// Purpose:     wxHtmlWindow parsing and layout benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/ffile.h"
+#include "wx/frame.h"
+#include "wx/html/htmlwin.h"
+
+#include "bench.h"
+
+#if wxUSE_HTML
+
+// ----------------------------------------------------------------------------
+// Benchmarks simulating a log window: the page initially contains the same
+// htmltest.html file as used by the string benchmarks and then the given
+// number of lines (200 by default) is added to it, either one by one using
+// AppendToPage() or all at once using SetPage().
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxFrame* gs_frame = NULL;
+wxHtmlWindow* gs_html = NULL;
+wxString gs_page;
+
+bool InitHtml()
+{
+    if ( !wxFFile("htmltest.html").ReadAll(&gs_page, wxConvUTF8) )
+        return false;
+
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxHtmlWindow benchmark",
+                           wxDefaultPosition, wxSize(800, 600));
+    gs_html = new wxHtmlWindow(gs_frame, wxID_ANY);
+    gs_frame->Show();
+
+    return true;
+}
+
+void DoneHtml()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_html = NULL;
+    gs_page.clear();
+}
+
+wxString GetLogLine(long n)
+{
+    return wxString::Format
+           (
+            "<font color=\"%s\">%05ld</font> <b>[worker %ld]</b> processed "
+            "item <a href=\"#item%ld\">%ld</a> in <i>%ld ms</i><br>\n",
+            n % 10 ? "gray" : "red", n, n % 4, n, n * 7, n % 100
+           );
+}
+
+wxString GetLogPage()
+{
+    wxString page(gs_page);
+
+    const long lines = Bench::GetNumericParameter(200);
+    for ( long n = 0; n < lines; n++ )
+        page += GetLogLine(n);
+
+    return page;
+}
+
+bool InitHtmlWithLog()
+{
+    if ( !InitHtml() )
+        return false;
+
+    gs_html->SetPage(GetLogPage());
+
+    return true;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(HtmlAppendToPage, InitHtml, DoneHtml)
+{
+    gs_html->SetPage(gs_page);
+
+    const long lines = Bench::GetNumericParameter(200);
+    for ( long n = 0; n < lines; n++ )
+        gs_html->AppendToPage(GetLogLine(n));
+
+    return gs_html->GetInternalRepresentation() != NULL;
+}
+
+BENCHMARK_FUNC_WITH_INIT(HtmlSetPage, InitHtml, DoneHtml)
+{
+    return gs_html->SetPage(GetLogPage());
+}
+
+BENCHMARK_FUNC_WITH_INIT(HtmlRelayout, InitHtmlWithLog, DoneHtml)
+{
+    // Alternate between two different widths, as happens when the user
+    // resizes the window.
+    static bool s_wide = false;
+    s_wide = !s_wide;
+
+    wxHtmlContainerCell* const cell = gs_html->GetInternalRepresentation();
+    cell->Layout(s_wide ? 800 : 600);
+
+    return cell->GetHeight() > 0;
+}
+
+#endif // wxUSE_HTML
@@ -43,6 +43,60 @@ BENCHMARK_FUNC(LoadPNG)
     return image.LoadFile("horse.png");
 }
 
+// ----------------------------------------------------------------------------
+// Decoding images row by row: the numeric parameter specifies the factor to
+// scale them down by (1 by default)
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Sink doing nothing with the rows except counting them.
+class CountingRowSink : public wxImageRowSink
+{
+public:
+    CountingRowSink() { m_rows = 0; }
+
+    int GetRowsCount() const { return m_rows; }
+
+    virtual bool ProcessRow(int WXUNUSED(y),
+                            const unsigned char* WXUNUSED(data),
+                            const unsigned char* WXUNUSED(alpha)) wxOVERRIDE
+    {
+        m_rows++;
+        return true;
+    }
+
+private:
+    int m_rows;
+};
+
+bool LoadRows(const wxString& filename, wxBitmapType type)
+{
+    CountingRowSink sink;
+    return wxImage::LoadRows(filename, sink, type,
+                             Bench::GetNumericParameter(1)) &&
+                sink.GetRowsCount() > 0;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(LoadRowsJPEG)
+{
+    if ( !wxImage::FindHandler(wxBITMAP_TYPE_JPEG) )
+        wxImage::AddHandler(new wxJPEGHandler);
+
+    return LoadRows("horse.jpg", wxBITMAP_TYPE_JPEG);
+}
+
+BENCHMARK_FUNC(LoadRowsPNG)
+{
+    if ( !wxImage::FindHandler(wxBITMAP_TYPE_PNG) )
+        wxImage::AddHandler(new wxPNGHandler);
+
+    return LoadRows("horse.png", wxBITMAP_TYPE_PNG);
+}
+
 #if wxUSE_LIBTIFF
 BENCHMARK_FUNC(LoadTIFF)
 {
@@ -118,3 +172,50 @@ BENCHMARK_FUNC(ShrinkHighQuality)
     return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
                        wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+// ----------------------------------------------------------------------------
+// Scaling of big images, e.g. creating thumbnails of photos: the numeric
+// parameter specifies the maximal number of threads to use (all by default)
+// ----------------------------------------------------------------------------
+
+static const wxImage& GetBigTestImage()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        // The exact contents doesn't matter, but use a 20MP image similar to
+        // the photos produced by typical cameras.
+        s_image = GetTestImage().Scale(5472, 3648, wxIMAGE_QUALITY_BILINEAR);
+    }
+
+    return s_image;
+}
+
+static wxImage ScaleBigTestImage(double factor, wxImageResizeQuality quality)
+{
+    wxImage::SetMaxResampleThreads(Bench::GetNumericParameter(0));
+
+    const wxImage& image = GetBigTestImage();
+    return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
+                       quality);
+}
+
+BENCHMARK_FUNC(ShrinkBigBoxAverage)
+{
+    return ScaleBigTestImage(0.1, wxIMAGE_QUALITY_BOX_AVERAGE).IsOk();
+}
+
+BENCHMARK_FUNC(ShrinkBigBilinear)
+{
+    return ScaleBigTestImage(0.4, wxIMAGE_QUALITY_BILINEAR).IsOk();
+}
+
+BENCHMARK_FUNC(ShrinkBigBicubic)
+{
+    return ScaleBigTestImage(0.4, wxIMAGE_QUALITY_BICUBIC).IsOk();
+}
+
+BENCHMARK_FUNC(EnlargeBigBicubic)
+{
+    return ScaleBigTestImage(1.5, wxIMAGE_QUALITY_BICUBIC).IsOk();
+}
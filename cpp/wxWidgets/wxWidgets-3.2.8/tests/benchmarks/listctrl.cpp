@@ -0,0 +1,160 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/listctrl.cpp
+// Purpose:     Generic wxListCtrl search and sort benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/frame.h"
+#include "wx/listctrl.h"
+#include "wx/generic/listctrl.h"
+
+#include "bench.h"
+
+#if wxUSE_LISTCTRL
+
+// ----------------------------------------------------------------------------
+// Benchmarks using the generic report view control with 100000 items. The
+// numeric parameter specifies the number of items searched for in each
+// iteration of the search benchmarks (100 by default).
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const unsigned NUM_ITEMS = 100000;
+
+wxFrame* gs_frame = NULL;
+wxGenericListCtrl* gs_list = NULL;
+
+// Returns a pseudo-random number less than the given one: we don't want to
+// use rand() to make the results reproducible.
+unsigned GetNext(unsigned& seed, unsigned max)
+{
+    seed = seed*1103515245u + 12345u;
+    return (seed >> 8) % max;
+}
+
+// Returns the text of the item with the given (original) index: the texts
+// are in random order and use different case to make searching for them and
+// sorting them less trivial.
+wxString GetItemText(unsigned n)
+{
+    unsigned seed = n;
+    return wxString::Format(n % 2 ? "Item %u" : "ITEM %u",
+                            GetNext(seed, NUM_ITEMS));
+}
+
+int wxCALLBACK CompareItems(wxIntPtr item1, wxIntPtr item2, wxIntPtr data)
+{
+    const int rc = item1 < item2 ? -1 : item1 > item2 ? 1 : 0;
+    return data ? rc : -rc;
+}
+
+bool InitListCtrl()
+{
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxListCtrl benchmark",
+                           wxDefaultPosition, wxSize(800, 600));
+    gs_list = new wxGenericListCtrl(gs_frame, wxID_ANY,
+                                    wxDefaultPosition, wxDefaultSize,
+                                    wxLC_REPORT);
+    gs_list->AppendColumn("Text");
+    gs_list->AppendColumn("Number");
+
+    for ( unsigned n = 0; n < NUM_ITEMS; n++ )
+    {
+        const wxString text = GetItemText(n);
+        gs_list->InsertItem(n, text);
+        gs_list->SetItem(n, 1, wxString::Format("%u", n));
+
+        unsigned seed = n;
+        gs_list->SetItemData(n, GetNext(seed, NUM_ITEMS));
+    }
+
+    gs_frame->Show();
+
+    return gs_list->GetItemCount() == NUM_ITEMS;
+}
+
+bool InitListCtrlIndexed()
+{
+    if ( !InitListCtrl() )
+        return false;
+
+    gs_list->EnableSearchIndex(0);
+    gs_list->EnableSearchIndex(1);
+
+    return gs_list->IsSearchIndexEnabled(0);
+}
+
+void DoneListCtrl()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_list = NULL;
+}
+
+// Search for random items by their full text and by a prefix of it.
+bool DoFindItems()
+{
+    static unsigned s_seed = 0;
+
+    long found = 0;
+    const long count = Bench::GetNumericParameter(100);
+    for ( long n = 0; n < count; n++ )
+    {
+        const unsigned item = GetNext(s_seed, NUM_ITEMS);
+        if ( gs_list->FindItem(-1, GetItemText(item).Lower()) != wxNOT_FOUND )
+            found++;
+
+        if ( gs_list->FindItemInColumn(item / 2, 1,
+                                       wxString::Format("%u", item / 10),
+                                       true) != wxNOT_FOUND )
+            found++;
+    }
+
+    return found > 0;
+}
+
+// Sort the items alternatively in ascending and descending order.
+bool DoSortItems(bool byText)
+{
+    static bool s_ascending = true;
+    s_ascending = !s_ascending;
+
+    if ( byText )
+        return gs_list->SortItemsByText(0, s_ascending);
+
+    return gs_list->SortItems(CompareItems, s_ascending);
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(ListCtrlFindItem, InitListCtrl, DoneListCtrl)
+{
+    return DoFindItems();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ListCtrlFindItemIndexed, InitListCtrlIndexed, DoneListCtrl)
+{
+    return DoFindItems();
+}
+
+BENCHMARK_FUNC_WITH_INIT(ListCtrlSortItems, InitListCtrl, DoneListCtrl)
+{
+    return DoSortItems(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(ListCtrlSortItemsByText, InitListCtrl, DoneListCtrl)
+{
+    return DoSortItems(true);
+}
+
+BENCHMARK_FUNC_WITH_INIT(ListCtrlSortItemsByTextIndexed, InitListCtrlIndexed, DoneListCtrl)
+{
+    return DoSortItems(true);
+}
+
+#endif // wxUSE_LISTCTRL
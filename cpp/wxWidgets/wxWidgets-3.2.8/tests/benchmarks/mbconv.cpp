@@ -9,6 +9,7 @@
 
 #include "wx/strconv.h"
 #include "wx/string.h"
+#include "wx/vector.h"
 
 #include "bench.h"
 
@@ -42,6 +43,109 @@ bool ConvertToMB(const wxMBConv& conv)
     return conv.FromWChar(buf.data(), outlen, TEST_STRING) == outlen;
 }
 
+// ----------------------------------------------------------------------------
+// Conversions of longer texts in different scripts
+// ----------------------------------------------------------------------------
+
+// Kinds of text used for the benchmarks below, they differ by the proportion
+// of ASCII and non-ASCII characters and the length of their UTF-8 encoding.
+enum Corpus
+{
+    Corpus_ASCII,   // only ASCII characters
+    Corpus_Latin,   // mostly ASCII with some accented letters
+    Corpus_CJK,     // BMP characters encoded with 3 bytes in UTF-8
+    Corpus_Emoji,   // mostly non-BMP characters encoded as UTF-16 surrogates
+    Corpus_Max
+};
+
+const wchar_t *const CORPUS_TEXTS[Corpus_Max] =
+{
+    // Corpus_ASCII
+    L"The quick brown fox jumps over the lazy dog, 0123456789 times. ",
+
+    // Corpus_Latin
+    L"Voix ambigu\u00eb d'un c\u0153ur qui au z\u00e9phyr pr\u00e9f\u00e8re "
+    L"les jattes de kiwis; \u00fcber gr\u00fcne Gew\u00e4sser flie\u00dft es. ",
+
+    // Corpus_CJK
+    L"\u65e5\u672c\u8a9e\u306e\u6587\u7ae0\u3068\u4e2d\u6587\u7684\u53e5"
+    L"\u5b50\u3001\ud55c\uad6d\uc5b4 \ubb38\uc7a5\u3002",
+
+    // Corpus_Emoji
+    L"\U0001F600\U0001F601\U0001F602 \U0001F44D\U0001F3FD\U0001F389"
+    L"\U0001F680 ok \U0001F30D\U0001F308\u2764\U0001F525 ",
+};
+
+// Return the text of the given kind, repeated enough times to make it long.
+const wxVector<wchar_t>& GetCorpus(Corpus corpus)
+{
+    static wxVector<wchar_t> s_corpora[Corpus_Max];
+
+    wxVector<wchar_t>& text = s_corpora[corpus];
+    if ( text.empty() )
+    {
+        // Use 100000 characters by default.
+        const size_t len = Bench::GetNumericParameter(100000);
+
+        // Always repeat the entire sample to avoid splitting surrogates.
+        while ( text.size() < len )
+        {
+            for ( const wchar_t* p = CORPUS_TEXTS[corpus]; *p; p++ )
+                text.push_back(*p);
+        }
+    }
+
+    return text;
+}
+
+// Buffer used for the conversion output, big enough for any encoding.
+template <typename T>
+T* GetOutputBuffer(Corpus corpus)
+{
+    static wxVector<T> s_buf;
+    s_buf.resize(4*GetCorpus(corpus).size());
+    return &s_buf[0];
+}
+
+bool EncodeCorpus(const wxMBConv& conv, Corpus corpus)
+{
+    const wxVector<wchar_t>& text = GetCorpus(corpus);
+    const size_t len = conv.FromWChar(NULL, 0, &text[0], text.size());
+    if ( len == wxCONV_FAILED )
+        return false;
+
+    return conv.FromWChar(GetOutputBuffer<char>(corpus), len,
+                          &text[0], text.size()) == len;
+}
+
+bool DecodeCorpus(const wxMBConv& conv, Corpus corpus)
+{
+    // Cache the encoded text for every conversion object used with it.
+    static wxVector<char> s_encoded[Corpus_Max];
+    static const wxMBConv* s_encodedConv[Corpus_Max];
+
+    wxVector<char>& encoded = s_encoded[corpus];
+    if ( s_encodedConv[corpus] != &conv )
+    {
+        const wxVector<wchar_t>& text = GetCorpus(corpus);
+        const size_t len = conv.FromWChar(NULL, 0, &text[0], text.size());
+        if ( len == wxCONV_FAILED )
+            return false;
+
+        encoded.resize(len);
+        conv.FromWChar(&encoded[0], len, &text[0], text.size());
+
+        s_encodedConv[corpus] = &conv;
+    }
+
+    const size_t len = conv.ToWChar(NULL, 0, &encoded[0], encoded.size());
+    if ( len == wxCONV_FAILED )
+        return false;
+
+    return conv.ToWChar(GetOutputBuffer<wchar_t>(corpus), len,
+                        &encoded[0], encoded.size()) == len;
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC(UTF16InitWX)
@@ -76,3 +180,35 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+// Note that the conversion objects used here must be global ones, as their
+// addresses are used to cache the encoded text in DecodeCorpus().
+namespace
+{
+
+wxMBConvUTF16LE gs_convUTF16LE;
+wxMBConvUTF16BE gs_convUTF16BE;
+wxMBConvUTF32BE gs_convUTF32BE;
+
+} // anonymous namespace
+
+#define CORPUS_BENCHMARKS(conv, name, corpus)                                 \
+    BENCHMARK_FUNC(name##Encode##corpus)                                      \
+    {                                                                         \
+        return EncodeCorpus(conv, Corpus_##corpus);                           \
+    }                                                                         \
+    BENCHMARK_FUNC(name##Decode##corpus)                                      \
+    {                                                                         \
+        return DecodeCorpus(conv, Corpus_##corpus);                           \
+    }
+
+#define CORPUS_BENCHMARKS_ALL(conv, name)                                     \
+    CORPUS_BENCHMARKS(conv, name, ASCII)                                      \
+    CORPUS_BENCHMARKS(conv, name, Latin)                                      \
+    CORPUS_BENCHMARKS(conv, name, CJK)                                        \
+    CORPUS_BENCHMARKS(conv, name, Emoji)
+
+CORPUS_BENCHMARKS_ALL(wxConvUTF8, UTF8)
+CORPUS_BENCHMARKS_ALL(gs_convUTF16LE, UTF16LE)
+CORPUS_BENCHMARKS_ALL(gs_convUTF16BE, UTF16BE)
+CORPUS_BENCHMARKS_ALL(gs_convUTF32BE, UTF32BE)
@@ -53,22 +53,75 @@ const wxString& GetTestText()
     return text;
 }
 
-} // anonymous namespace
+// This is too simplistic, but good enough for benchmarking.
+const char* const RE_TD = "<td>[^<]*</td>";
 
-BENCHMARK_FUNC(REFindTD)
-{
-    // This is too simplistic, but good enough for benchmarking.
-    static wxRegEx re("<td>[^<]*</td>", wxRE_ICASE | wxRE_NEWLINE);
+// Number of matches of RE_TD in the test file: this is one more than "grep -c"
+// finds because "[^<]" also matches new lines and one of the cells spans two
+// lines.
+const int NUM_TD = 22;
 
+int CountTD(const wxRegEx& re)
+{
     int matches = 0;
     for ( const wxChar* p = GetTestText().c_str(); re.Matches(p); ++matches )
     {
         size_t start, len;
         if ( !re.GetMatch(&start, &len) )
-            return false;
+            return -1;
+
+        p += start + len;
+    }
+
+    return matches;
+}
+
+int CountTDUTF8(const wxRegEx& re)
+{
+    static const wxScopedCharBuffer buf = GetTestText().utf8_str();
+
+    const char* p = buf.data();
+    const char* const end = p + buf.length();
+
+    int matches = 0;
+    for ( ; re.MatchesUTF8(p, end - p); ++matches )
+    {
+        size_t start, len;
+        if ( !re.GetMatch(&start, &len) )
+            return -1;
 
         p += start + len;
     }
 
-    return matches == 21; // result of "grep -c"
+    return matches;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(REFindTD)
+{
+    static wxRegEx re(RE_TD, wxRE_ICASE | wxRE_NEWLINE);
+
+    return CountTD(re) == NUM_TD;
+}
+
+BENCHMARK_FUNC(REFindTDJIT)
+{
+    static wxRegEx re(RE_TD, wxRE_ICASE | wxRE_NEWLINE | wxRE_JIT);
+
+    return CountTD(re) == NUM_TD;
+}
+
+BENCHMARK_FUNC(REFindTDUTF8)
+{
+    static wxRegEx re(RE_TD, wxRE_ICASE | wxRE_NEWLINE);
+
+    return CountTDUTF8(re) == NUM_TD;
+}
+
+BENCHMARK_FUNC(REFindTDUTF8JIT)
+{
+    static wxRegEx re(RE_TD, wxRE_ICASE | wxRE_NEWLINE | wxRE_JIT);
+
+    return CountTDUTF8(re) == NUM_TD;
 }
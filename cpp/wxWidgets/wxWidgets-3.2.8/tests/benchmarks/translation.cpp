@@ -0,0 +1,275 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/translation.cpp
+// Purpose:     wxTranslations catalog loading and lookup benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/ffile.h"
+#include "wx/filename.h"
+#include "wx/translation.h"
+
+#include "bench.h"
+
+#include <vector>
+
+#if wxUSE_INTL
+
+// ----------------------------------------------------------------------------
+// Benchmarks using a generated French catalog with the number of messages
+// specified by the numeric parameter (20000 by default).
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const char* const DOMAIN = "wxbench";
+
+wxString gs_root;
+wxTranslations* gs_trans = NULL;
+
+wxString GetMsgId(long n)
+{
+    return wxString::Format("Message number %06ld", n);
+}
+
+// the hash function used by GNU gettext for the .mo files hash tables
+wxUint32 GetHash(const char* str)
+{
+    wxUint32 hval = 0;
+    while ( *str )
+    {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*str++);
+
+        const wxUint32 g = hval & 0xf0000000;
+        if ( g )
+        {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+
+    return hval;
+}
+
+bool IsPrime(wxUint32 n)
+{
+    for ( wxUint32 d = 3; d*d <= n; d += 2 )
+    {
+        if ( n % d == 0 )
+            return false;
+    }
+
+    return true;
+}
+
+// Create a catalog with a hash table, as msgfmt does by default.
+bool CreateCatalog(const wxString& filename, long numMessages)
+{
+    std::vector<wxCharBuffer> orig,
+                              trans;
+
+    orig.push_back(wxCharBuffer(""));
+    trans.push_back(wxCharBuffer("Content-Type: text/plain; charset=UTF-8\n"));
+    for ( long n = 0; n < numMessages; n++ )
+    {
+        orig.push_back(GetMsgId(n).utf8_str());
+        trans.push_back(wxString::Format(wxString::FromUTF8("Message num\xc3\xa9ro %06ld"),
+                                         n).utf8_str());
+    }
+
+    const wxUint32 numStrings = orig.size();
+
+    wxUint32 hashSize = numStrings*4/3 | 1;
+    while ( !IsPrime(hashSize) )
+        hashSize += 2;
+
+    std::vector<wxUint32> hashTable(hashSize);
+    for ( wxUint32 n = 0; n < numStrings; n++ )
+    {
+        const wxUint32 hval = GetHash(orig[n]);
+        const wxUint32 incr = 1 + hval % (hashSize - 2);
+        wxUint32 idx = hval % hashSize;
+        while ( hashTable[idx] )
+        {
+            if ( idx >= hashSize - incr )
+                idx -= hashSize - incr;
+            else
+                idx += incr;
+        }
+
+        hashTable[idx] = n + 1;
+    }
+
+    const wxUint32 ofsOrigTable = 7*sizeof(wxUint32);
+    const wxUint32 ofsTransTable = ofsOrigTable + 2*sizeof(wxUint32)*numStrings;
+    const wxUint32 ofsHashTable = ofsTransTable + 2*sizeof(wxUint32)*numStrings;
+
+    std::vector<wxUint32> words;
+    words.push_back(0x950412de);
+    words.push_back(0);
+    words.push_back(numStrings);
+    words.push_back(ofsOrigTable);
+    words.push_back(ofsTransTable);
+    words.push_back(hashSize);
+    words.push_back(ofsHashTable);
+
+    wxUint32 ofsString = ofsHashTable + sizeof(wxUint32)*hashSize;
+    for ( int table = 0; table < 2; table++ )
+    {
+        const std::vector<wxCharBuffer>& strings = table ? trans : orig;
+        for ( wxUint32 n = 0; n < numStrings; n++ )
+        {
+            words.push_back(strings[n].length());
+            words.push_back(ofsString);
+            ofsString += strings[n].length() + 1;
+        }
+    }
+
+    words.insert(words.end(), hashTable.begin(), hashTable.end());
+
+    wxFFile file(filename, "wb");
+    if ( !file.IsOpened() ||
+            !file.Write(&words[0], words.size()*sizeof(wxUint32)) )
+        return false;
+
+    for ( int table = 0; table < 2; table++ )
+    {
+        const std::vector<wxCharBuffer>& strings = table ? trans : orig;
+        for ( wxUint32 n = 0; n < numStrings; n++ )
+        {
+            if ( !file.Write(strings[n].data(), strings[n].length() + 1) )
+                return false;
+        }
+    }
+
+    return file.Close();
+}
+
+bool InitCatalog()
+{
+    wxFileName fn;
+    fn.AssignDir(wxFileName::GetTempDir());
+    fn.AppendDir(wxString::Format("wxbenchintl%lu", wxGetProcessId()));
+    gs_root = fn.GetPath();
+
+    fn.AppendDir("fr");
+    if ( !fn.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL) )
+        return false;
+
+    fn.SetName(DOMAIN);
+    fn.SetExt("mo");
+    if ( !CreateCatalog(fn.GetFullPath(), Bench::GetNumericParameter(20000)) )
+        return false;
+
+    wxFileTranslationsLoader::AddCatalogLookupPathPrefix(gs_root);
+
+    return true;
+}
+
+void DoneCatalog()
+{
+    wxFileName::Rmdir(gs_root, wxPATH_RMDIR_RECURSIVE);
+    gs_root.clear();
+}
+
+wxTranslations* LoadCatalog(bool mapped)
+{
+    wxTranslations::EnableMappedCatalogs(mapped);
+
+    wxTranslations* trans = new wxTranslations;
+    trans->SetLanguage("fr");
+    if ( !trans->AddAvailableCatalog(DOMAIN) )
+        wxDELETE(trans);
+
+    wxTranslations::EnableMappedCatalogs(false);
+
+    return trans;
+}
+
+bool DoLoadCatalog(bool mapped)
+{
+    wxTranslations* const trans = LoadCatalog(mapped);
+    if ( !trans )
+        return false;
+
+    const bool ok = trans->GetTranslatedString(GetMsgId(42)) != NULL;
+
+    delete trans;
+
+    return ok;
+}
+
+bool DoInitLookup(bool mapped)
+{
+    if ( !InitCatalog() )
+        return false;
+
+    gs_trans = LoadCatalog(mapped);
+
+    return gs_trans != NULL;
+}
+
+bool InitLookup()
+{
+    return DoInitLookup(false);
+}
+
+bool InitLookupMapped()
+{
+    return DoInitLookup(true);
+}
+
+void DoneLookup()
+{
+    wxDELETE(gs_trans);
+
+    DoneCatalog();
+}
+
+// Look up 1000 translated and 100 untranslated strings, as happens when
+// searching in all the domains.
+bool DoLookup()
+{
+    const long numMessages = Bench::GetNumericParameter(20000);
+    for ( long n = 0; n < 1000; n++ )
+    {
+        if ( !gs_trans->GetTranslatedString(GetMsgId(n*7 % numMessages)) )
+            return false;
+    }
+
+    for ( long n = 0; n < 100; n++ )
+    {
+        if ( gs_trans->GetTranslatedString(GetMsgId(n) + "!") )
+            return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(TranslationsLoad, InitCatalog, DoneCatalog)
+{
+    return DoLoadCatalog(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TranslationsLoadMapped, InitCatalog, DoneCatalog)
+{
+    return DoLoadCatalog(true);
+}
+
+BENCHMARK_FUNC_WITH_INIT(TranslationsLookup, InitLookup, DoneLookup)
+{
+    return DoLookup();
+}
+
+BENCHMARK_FUNC_WITH_INIT(TranslationsLookupMapped, InitLookupMapped, DoneLookup)
+{
+    return DoLookup();
+}
+
+#endif // wxUSE_INTL
@@ -0,0 +1,150 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/xml.cpp
+// Purpose:     XML loading benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/mstream.h"
+#include "wx/xml/xml.h"
+
+#include "bench.h"
+
+#if wxUSE_XML
+
+// ----------------------------------------------------------------------------
+// Compare loading a document with the given number of records (10000 by
+// default) into wxXmlDocument, either from XML or from the binary format
+// produced by wxXmlDocument::SaveBinary(), and into wxXmlArenaDocument and
+// processing it using wxXmlReader. All benchmarks count the records with a
+// particular attribute value to ensure that the names and values are really
+// accessed.
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const wxCharBuffer& GetXmlData()
+{
+    static wxCharBuffer s_data;
+    if ( !s_data.length() )
+    {
+        wxString xml("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<export>\n");
+
+        const long numRecords = Bench::GetNumericParameter(10000);
+        for ( long n = 0; n < numRecords; n++ )
+        {
+            xml << wxString::Format(
+                "  <record id=\"%ld\" kind=\"%s\">\n"
+                "    <name>Record number %ld</name>\n"
+                "    <value unit=\"m\">%ld.%02ld</value>\n"
+                "    <!-- comment -->\n"
+                "    <description>Some longer text describing the record "
+                "and containing &quot;entities&quot; too</description>\n"
+                "  </record>\n",
+                n, n % 3 ? "normal" : "special", n, n / 7, n % 100
+            );
+        }
+
+        xml << "</export>\n";
+
+        s_data = xml.utf8_str();
+    }
+
+    return s_data;
+}
+
+const wxMemoryOutputStream& GetXmlBinaryData()
+{
+    static wxMemoryOutputStream s_out;
+    if ( !s_out.GetSize() )
+    {
+        const wxCharBuffer& data = GetXmlData();
+        wxMemoryInputStream mis(data.data(), data.length());
+
+        wxXmlDocument doc;
+        if ( doc.Load(mis) )
+            doc.SaveBinary(s_out);
+    }
+
+    return s_out;
+}
+
+long GetExpectedCount()
+{
+    return (Bench::GetNumericParameter(10000) + 2) / 3;
+}
+
+bool CheckDocument(const wxXmlDocument& doc)
+{
+    long count = 0;
+    for ( wxXmlNode* n = doc.GetRoot()->GetChildren(); n; n = n->GetNext() )
+    {
+        if ( n->GetName() == "record" && n->GetAttribute("kind") == "special" )
+            count++;
+    }
+
+    return count == GetExpectedCount();
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(XmlLoadDocument)
+{
+    const wxCharBuffer& data = GetXmlData();
+    wxMemoryInputStream mis(data.data(), data.length());
+
+    wxXmlDocument doc;
+    return doc.Load(mis) && CheckDocument(doc);
+}
+
+BENCHMARK_FUNC(XmlLoadBinary)
+{
+    wxMemoryInputStream mis(GetXmlBinaryData());
+
+    wxXmlDocument doc;
+    return doc.Load(mis) && CheckDocument(doc);
+}
+
+BENCHMARK_FUNC(XmlLoadArena)
+{
+    const wxCharBuffer& data = GetXmlData();
+    wxMemoryInputStream mis(data.data(), data.length());
+
+    wxXmlArenaDocument doc;
+    if ( !doc.Load(mis) )
+        return false;
+
+    long count = 0;
+    for ( wxXmlArenaNode n = doc.GetRoot().GetChildren(); n.IsOk(); n = n.GetNext() )
+    {
+        if ( n.GetName() == "record" && n.GetAttribute("kind") == "special" )
+            count++;
+    }
+
+    return count == GetExpectedCount();
+}
+
+BENCHMARK_FUNC(XmlReader)
+{
+    const wxCharBuffer& data = GetXmlData();
+    wxMemoryInputStream mis(data.data(), data.length());
+
+    wxXmlReader reader(mis);
+
+    long count = 0;
+    while ( reader.Next() != wxXmlReader::Event_None )
+    {
+        if ( reader.GetEvent() == wxXmlReader::Event_StartElement &&
+                reader.GetDepth() == 1 &&
+                    reader.GetName() == "record" &&
+                        reader.GetAttribute("kind") == "special" )
+            count++;
+    }
+
+    return reader.IsOk() && count == GetExpectedCount();
+}
+
+#endif // wxUSE_XML
@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/zip.cpp
+// Purpose:     wxZipOutputStream benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/mstream.h"
+#include "wx/scopedptr.h"
+#include "wx/thread.h"
+#include "wx/zipstrm.h"
+
+#include "bench.h"
+
+#if wxUSE_ZIPSTREAM
+
+// ----------------------------------------------------------------------------
+// Compress a mix of small and big entries using different numbers of threads.
+// The numeric parameter specifies the size of the big entries in KiB (1024 by
+// default), there are 4 of them and 256 small entries of 4KiB.
+//
+// Also compare finding and reading a single entry from a zip with many small
+// entries, whose number is given by the numeric parameter (10000 by default),
+// sequentially and using wxZipIndex.
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return somewhat compressible data of the given size.
+const wxCharBuffer& GetZipData(size_t size)
+{
+    static wxCharBuffer s_data;
+    if ( s_data.length() < size )
+    {
+        static const char* const words[] =
+        {
+            "zip ", "stream ", "entry ", "deflate ", "chunk ", "thread ",
+            "wxWidgets ", "compress ", "data ", "header ", "\n"
+        };
+
+        wxString text;
+        unsigned seed = 1;
+        while ( text.length() < size )
+        {
+            seed = seed * 1103515245 + 12345;
+            text += words[(seed >> 16) % WXSIZEOF(words)];
+            text << (seed >> 24);
+        }
+
+        s_data = text.utf8_str();
+    }
+
+    return s_data;
+}
+
+bool DoZip(int numThreads)
+{
+    const size_t bigSize = Bench::GetNumericParameter(1024) * 1024;
+    const size_t smallSize = 4096;
+    const wxCharBuffer& data = GetZipData(bigSize);
+
+    wxMemoryOutputStream out;
+    wxZipOutputStream zip(out);
+    zip.SetThreadCount(numThreads);
+
+    for ( int n = 0; n < 260; n++ )
+    {
+        const bool big = n % 65 == 0;
+        const size_t size = big ? bigSize : smallSize;
+
+        if ( !zip.PutNextEntry(wxString::Format("entry%d", n)) )
+            return false;
+
+        // Vary the data of the small entries.
+        zip.Write(data.data() + (big ? 0 : n * 67), size);
+    }
+
+    return zip.Close() && out.GetSize() > 0;
+}
+
+const wxMemoryOutputStream& GetManyEntriesZip()
+{
+    static wxMemoryOutputStream s_out;
+    if ( !s_out.GetSize() )
+    {
+        wxZipOutputStream zip(s_out);
+
+        const int numEntries = Bench::GetNumericParameter(10000);
+        for ( int n = 0; n < numEntries; n++ )
+        {
+            zip.PutNextEntry(wxString::Format("dir%d/entry%d.txt", n % 100, n));
+            zip.Write("some data", 9);
+        }
+    }
+
+    return s_out;
+}
+
+wxString GetLastEntryName()
+{
+    const int n = Bench::GetNumericParameter(10000) - 1;
+    return wxString::Format("dir%d/entry%d.txt", n % 100, n);
+}
+
+bool ReadEntry(wxZipInputStream& zip)
+{
+    char buf[16];
+    return zip.Read(buf, sizeof(buf)).LastRead() == 9;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(ZipFindSequential)
+{
+    wxMemoryInputStream in(GetManyEntriesZip());
+    wxZipInputStream zip(in);
+
+    const wxString name = GetLastEntryName();
+    wxZipEntry* entry;
+    while ( (entry = zip.GetNextEntry()) != NULL )
+    {
+        const bool found = entry->GetName(wxPATH_UNIX) == name;
+        delete entry;
+
+        if ( found )
+            return ReadEntry(zip);
+    }
+
+    return false;
+}
+
+BENCHMARK_FUNC(ZipFindIndex)
+{
+    wxMemoryInputStream in(GetManyEntriesZip());
+    wxZipIndex index(in);
+
+    const int n = index.Find(GetLastEntryName());
+    if ( n == wxNOT_FOUND )
+        return false;
+
+    wxScopedPtr<wxZipInputStream>
+        zip(index.OpenEntry(new wxMemoryInputStream(GetManyEntriesZip()), n));
+    return zip && ReadEntry(*zip);
+}
+
+BENCHMARK_FUNC(ZipThreads1)
+{
+    return DoZip(1);
+}
+
+BENCHMARK_FUNC(ZipThreads2)
+{
+    return DoZip(2);
+}
+
+BENCHMARK_FUNC(ZipThreads4)
+{
+    return DoZip(4);
+}
+
+BENCHMARK_FUNC(ZipThreadsAll)
+{
+    return DoZip(0);
+}
+
+#endif // wxUSE_ZIPSTREAM
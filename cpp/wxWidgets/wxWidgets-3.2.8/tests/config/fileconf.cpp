@@ -174,6 +174,61 @@ TEST_CASE("wxFileConfig::GetGroups", "[fileconfig][config]")
     CheckGroupSubgroups(fc, "/root/group2", 0);
 }
 
+TEST_CASE("wxFileConfig::ManyEntries", "[fileconfig][config]")
+{
+    // Use entries and groups in non-alphabetical order to check that they're
+    // still enumerated in the sorted order.
+    const int NUM_ENTRIES = 1000;
+
+    wxString text("[Group]\n");
+    for ( int n = NUM_ENTRIES - 1; n >= 0; n-- )
+        text += wxString::Format("Key%04d=%d\n", n, n);
+    text += "[Another]\n"
+            "Entry=value\n";
+
+    wxStringInputStream sis(text);
+    wxFileConfig fc(sis);
+
+    CHECK( fc.GetNumberOfEntries(true) == NUM_ENTRIES + 1 );
+    CheckGroupSubgroups(fc, "", 2, "Another", "Group");
+
+    fc.SetPath("/Group");
+
+    wxString name;
+    long cookie;
+    REQUIRE( fc.GetFirstEntry(name, cookie) );
+    CHECK( name == "Key0000" );
+    for ( int n = 1; n < NUM_ENTRIES; n++ )
+    {
+        REQUIRE( fc.GetNextEntry(name, cookie) );
+        CHECK( name == wxString::Format("Key%04d", n) );
+    }
+    CHECK( !fc.GetNextEntry(name, cookie) );
+
+    // Check that looking up entries works, whether case-sensitive or not.
+    CHECK( fc.Read("Key0123", 0L) == 123 );
+#if !wxCONFIG_CASE_SENSITIVE
+    CHECK( fc.Read("KEY0123", 0L) == 123 );
+    CHECK( fc.HasGroup("/another") );
+#endif
+
+    // And that modifying them preserves the file layout.
+    CHECK( fc.DeleteEntry("Key0500") );
+    CHECK( !fc.HasEntry("Key0500") );
+    CHECK( fc.RenameEntry("Key0999", "Key0500") );
+    CHECK( fc.Read("Key0500", 0L) == 999 );
+    CHECK( fc.GetNumberOfEntries() == NUM_ENTRIES - 1 );
+
+    fc.SetPath("/");
+    CHECK( fc.RenameGroup("Another", "AAA") );
+    CheckGroupSubgroups(fc, "", 2, "AAA", "Group");
+    CHECK( fc.Read("/AAA/Entry", "") == "value" );
+
+    const wxString dump = Dump(fc);
+    CHECK( dump.StartsWith("[Group]\nKey0998=998\n") );
+    CHECK( dump.EndsWith("Key0000=0\nKey0500=999\n[AAA]\nEntry=value\n") );
+}
+
 TEST_CASE("wxFileConfig::HasEntry", "[fileconfig][config]")
 {
     wxStringInputStream sis(testconfig);
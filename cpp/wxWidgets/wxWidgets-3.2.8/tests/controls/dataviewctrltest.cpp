@@ -590,6 +590,60 @@ TEST_CASE_METHOD(MultiSelectDataViewCtrlTestCase,
 #endif
 }
 
+TEST_CASE_METHOD(MultiSelectDataViewCtrlTestCase,
+                 "wxDVC::SelectionInBigTree",
+                 "[wxDataViewCtrl][select]")
+{
+    // Use enough items for the generic version to index the children of the
+    // containers instead of searching them linearly.
+    const int NUM_ITEMS = 200;
+
+    const wxDataViewItem top = m_dvc->AppendContainer(wxDataViewItem(), "big");
+
+    wxDataViewItemArray containers;
+    wxDataViewItemArray lastChildren;
+    for ( int n = 0; n < NUM_ITEMS; n++ )
+    {
+        const wxDataViewItem
+            container = m_dvc->AppendContainer(top, wxString::Format("%d", n));
+        for ( int i = 0; i < NUM_ITEMS; i++ )
+            m_dvc->AppendItem(container, wxString::Format("%d.%d", n, i));
+
+        containers.push_back(container);
+        lastChildren.push_back(m_dvc->GetNthChild(container, NUM_ITEMS - 1));
+    }
+
+    m_dvc->Expand(top);
+    for ( int n = 0; n < NUM_ITEMS; n += 2 )
+        m_dvc->Expand(containers[n]);
+
+    // Selecting the items maps them to the rows and getting the selection
+    // maps the rows back to the items, so check that we get the same items.
+    wxDataViewItemArray sel;
+    sel.push_back(m_grandchild);
+    sel.push_back(containers[1]);
+    sel.push_back(lastChildren[2]);
+    sel.push_back(lastChildren[NUM_ITEMS - 2]);
+    sel.push_back(containers[NUM_ITEMS - 1]);
+    m_dvc->SetSelections(sel);
+
+    wxDataViewItemArray sel2;
+    REQUIRE( m_dvc->GetSelections(sel2) == static_cast<int>(sel.size()) );
+    CHECK( sel2 == sel );
+
+    // Collapsing a container before the selected items must shift them.
+    m_dvc->Collapse(containers[0]);
+    m_dvc->SetSelections(sel);
+    REQUIRE( m_dvc->GetSelections(sel2) == static_cast<int>(sel.size()) );
+    CHECK( sel2 == sel );
+
+    // And so does deleting an item.
+    m_dvc->DeleteItem(m_dvc->GetNthChild(containers[2], 0));
+    m_dvc->SetSelections(sel);
+    REQUIRE( m_dvc->GetSelections(sel2) == static_cast<int>(sel.size()) );
+    CHECK( sel2 == sel );
+}
+
 void DataViewCtrlTestCase::TestSelectionFor0and1()
 {
     wxDataViewItemArray selections;
@@ -883,6 +937,44 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
+                 "wxDVC::BestColumnWidthMode",
+                 "[wxDataViewCtrl][column]")
+{
+    CHECK( m_dvc->GetBestColumnWidthMode() == wxDATAVIEW_BEST_WIDTH_DEFAULT );
+
+    m_dvc->SetBestColumnWidthMode(wxDATAVIEW_BEST_WIDTH_SAMPLED);
+    CHECK( m_dvc->GetBestColumnWidthMode() == wxDATAVIEW_BEST_WIDTH_SAMPLED );
+
+    // Use more rows than are sampled.
+    const int NUM_ROWS = 3000;
+
+    wxVector<wxVariant> values(2);
+    values[0] = "x";
+    for ( int n = 0; n < NUM_ROWS; n++ )
+        m_dvc->AppendItem(values);
+
+    m_firstColumn->SetWidth(wxCOL_WIDTH_AUTOSIZE);
+    const int width = m_firstColumn->GetWidth();
+
+    // Changing any row must make the column wider, even if it's not sampled.
+    m_dvc->SetTextValue(wxString('x', 100), NUM_ROWS / 2 + 1, 0);
+    const int widthChanged = m_firstColumn->GetWidth();
+    CHECK( widthChanged > width );
+
+    // But deleting it doesn't make it narrower in this mode.
+    m_dvc->DeleteItem(NUM_ROWS / 2 + 1);
+    CHECK( m_firstColumn->GetWidth() == widthChanged );
+
+    // Until the width is computed again using the new mode.
+    m_dvc->SetBestColumnWidthMode(wxDATAVIEW_BEST_WIDTH_VISIBLE);
+    CHECK( m_firstColumn->GetWidth() == width );
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
@@ -1699,6 +1699,22 @@ TEST_CASE_METHOD(GridTestCase, "Grid::DrawInvalidCell", "[grid][multicell]")
     wxYield();
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::CellsExposed", "[grid]")
+{
+    const wxRect rect00 = m_grid->CellToRect(0, 0);
+
+    // Two rectangles intersecting the same cell: it must be returned only
+    // once, as otherwise it would be drawn twice.
+    wxRegion reg(wxRect(rect00.x, rect00.y, rect00.width, 2));
+    reg.Union(wxRect(rect00.x, rect00.y + 4, rect00.width + 2, 2));
+
+    const wxGridCellCoordsArray
+        cells = m_grid->CalcCellsExposed(reg);
+    REQUIRE( cells.size() == 2 );
+    CHECK( cells[0] == wxGridCellCoords(0, 0) );
+    CHECK( cells[1] == wxGridCellCoords(0, 1) );
+}
+
 #define CHECK_ATTR_COUNT(n) CHECK( m_grid->GetCellAttrCount() == n )
 
 TEST_CASE_METHOD(GridTestCase, "Grid::CellAttribute", "[attr][cell][grid]")
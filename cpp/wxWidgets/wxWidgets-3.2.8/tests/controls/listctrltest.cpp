@@ -21,11 +21,13 @@
 #endif // WX_PRECOMP
 
 #include "wx/listctrl.h"
+#include "wx/generic/listctrl.h"
 #include "wx/artprov.h"
 #include "wx/imaglist.h"
 #include "listbasetest.h"
 #include "testableframe.h"
 #include "wx/uiaction.h"
+#include "wx/scopedptr.h"
 
 // ----------------------------------------------------------------------------
 // test class
@@ -232,4 +234,66 @@ void ListCtrlTestCase::ColumnClick()
 }
 #endif // wxUSE_UIACTIONSIMULATOR
 
+TEST_CASE("wxGenericListCtrl::SearchIndex", "[listctrl][generic]")
+{
+    const wxScopedPtr<wxGenericListCtrl>
+        list(new wxGenericListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                                   wxDefaultPosition, wxDefaultSize,
+                                   wxLC_REPORT));
+    list->AppendColumn("Text");
+
+    const char* const texts[] = { "foo", "Bar", "baz", "FOO", "bar" };
+    for ( unsigned n = 0; n < WXSIZEOF(texts); n++ )
+        list->InsertItem(n, texts[n]);
+
+    CHECK( !list->IsSearchIndexEnabled() );
+    list->EnableSearchIndex();
+    CHECK( list->IsSearchIndexEnabled() );
+
+    CHECK( list->FindItem(-1, "foo") == 0 );
+    CHECK( list->FindItem(1, "foo") == 3 );
+    CHECK( list->FindItem(-1, "ba", true) == 1 );
+    CHECK( list->FindItem(2, "BA", true) == 2 );
+    CHECK( list->FindItem(-1, "qux") == wxNOT_FOUND );
+
+    // The index must be updated when the items change.
+    list->InsertItem(0, "qux");
+    CHECK( list->FindItem(-1, "qux") == 0 );
+    CHECK( list->FindItem(-1, "foo") == 1 );
+
+    list->SetItemText(1, "quux");
+    CHECK( list->FindItem(-1, "foo") == 4 );
+    CHECK( list->FindItem(-1, "qu", true) == 0 );
+    CHECK( list->FindItem(1, "qu", true) == 1 );
+
+    list->DeleteItem(0);
+    CHECK( list->FindItem(-1, "qux") == wxNOT_FOUND );
+    CHECK( list->FindItem(-1, "foo") == 3 );
+
+    // Items with the same text must keep their relative order when sorting.
+    list->SortItemsByText(0);
+    CHECK( list->GetItemText(0) == "Bar" );
+    CHECK( list->GetItemText(1) == "bar" );
+    CHECK( list->GetItemText(2) == "baz" );
+    CHECK( list->GetItemText(3) == "FOO" );
+    CHECK( list->GetItemText(4) == "quux" );
+    CHECK( list->FindItem(-1, "foo") == 3 );
+
+    list->SortItemsByText(0, false);
+    CHECK( list->GetItemText(0) == "quux" );
+    CHECK( list->GetItemText(3) == "Bar" );
+    CHECK( list->GetItemText(4) == "bar" );
+    CHECK( list->FindItem(-1, "bar") == 3 );
+
+    // Without the index, the results must be the same.
+    list->EnableSearchIndex(0, false);
+    CHECK( !list->IsSearchIndexEnabled() );
+    CHECK( list->FindItem(-1, "bar") == 3 );
+
+    list->SortItemsByText(0);
+    CHECK( list->GetItemText(0) == "Bar" );
+    CHECK( list->GetItemText(1) == "bar" );
+    CHECK( list->GetItemText(4) == "quux" );
+}
+
 #endif // wxUSE_LISTCTRL
@@ -13,10 +13,12 @@
 
 #ifndef WX_PRECOMP
     #include "wx/app.h"
+    #include "wx/dcclient.h"
 #endif // WX_PRECOMP
 
 #include "wx/richtext/richtextctrl.h"
 #include "wx/richtext/richtextstyles.h"
+#include "wx/stopwatch.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -60,6 +62,8 @@ private:
         CPPUNIT_TEST( Delete );
         CPPUNIT_TEST( Url );
         CPPUNIT_TEST( Table );
+        CPPUNIT_TEST( LazyLayout );
+        CPPUNIT_TEST( LazyLayoutIdle );
     CPPUNIT_TEST_SUITE_END();
 
     void IsModified();
@@ -91,6 +95,8 @@ private:
     void Delete();
     void Url();
     void Table();
+    void LazyLayout();
+    void LazyLayoutIdle();
 
     wxRichTextCtrl* m_rich;
 
@@ -878,4 +884,125 @@ void RichTextCtrlTestCase::Table()
     m_rich->SetFocusObject(NULL);
 }
 
+void RichTextCtrlTestCase::LazyLayout()
+{
+    m_rich->SetDelayedLayoutThreshold(100);
+
+    m_rich->Freeze();
+    for ( int n = 0; n < 1000; n++ )
+        m_rich->AddParagraph(wxString::Format("Paragraph number %d", n));
+    m_rich->SetInsertionPoint(0);
+    m_rich->GetBuffer().Invalidate(wxRICHTEXT_ALL);
+    m_rich->Thaw();
+
+    // Only the beginning of the buffer should have been laid out.
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    wxRichTextParagraph* const first = buffer.GetParagraphAtPosition(0);
+    wxRichTextParagraph* const last = buffer.GetParagraphAtPosition(buffer.GetOwnRange().GetEnd());
+    CPPUNIT_ASSERT( first );
+    CPPUNIT_ASSERT( last );
+    CPPUNIT_ASSERT( !first->GetLines().empty() );
+    CPPUNIT_ASSERT( last->GetLines().empty() );
+    CPPUNIT_ASSERT( buffer.IsDirty() );
+
+    // But the size of the other paragraphs should still be estimated.
+    const int estimatedHeight = buffer.GetCachedSize().y;
+    CPPUNIT_ASSERT( estimatedHeight > 500*first->GetCachedSize().y );
+
+    // Lay out the rest of the buffer as it's done in idle time.
+    wxClientDC dc(m_rich);
+    dc.SetFont(m_rich->GetFont());
+    wxRichTextDrawingContext context(&buffer);
+    const wxRect rect(m_rich->GetClientSize());
+    // Even without any time for it, each call must lay out at least one of
+    // the remaining paragraphs.
+    int calls = 0;
+    while ( !buffer.LayoutLazily(dc, context, rect, rect,
+                                 wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT,
+                                 -1, 0) )
+    {
+        CPPUNIT_ASSERT( ++calls < 1000 );
+    }
+
+    CPPUNIT_ASSERT( !last->GetLines().empty() );
+    CPPUNIT_ASSERT( !buffer.IsDirty() );
+    CPPUNIT_ASSERT( last->GetPosition().y > first->GetPosition().y );
+}
+
+namespace
+{
+
+// Counts the calls to DoLayoutBuffer().
+class LayoutCountingRichTextCtrl : public wxRichTextCtrl
+{
+public:
+    explicit LayoutCountingRichTextCtrl(wxWindow* parent)
+        : wxRichTextCtrl(parent, wxID_ANY, "",
+                         wxDefaultPosition, wxSize(400, 200), wxWANTS_CHARS)
+    {
+        m_layoutCount = 0;
+    }
+
+    virtual void DoLayoutBuffer(wxRichTextBuffer& buffer, wxDC& dc,
+                                wxRichTextDrawingContext& context,
+                                const wxRect& rect, const wxRect& parentRect,
+                                int flags) wxOVERRIDE
+    {
+        m_layoutCount++;
+
+        wxRichTextCtrl::DoLayoutBuffer(buffer, dc, context, rect, parentRect, flags);
+    }
+
+    int GetLayoutCount() const { return m_layoutCount; }
+
+private:
+    int m_layoutCount;
+};
+
+} // anonymous namespace
+
+void RichTextCtrlTestCase::LazyLayoutIdle()
+{
+    LayoutCountingRichTextCtrl* const
+        rich = new LayoutCountingRichTextCtrl(wxTheApp->GetTopWindow());
+    delete m_rich;
+    m_rich = rich;
+
+    m_rich->SetDelayedLayoutThreshold(100);
+
+    m_rich->Freeze();
+    for ( int n = 0; n < 1000; n++ )
+        m_rich->AddParagraph(wxString::Format("Paragraph number %d", n));
+    m_rich->SetInsertionPoint(0);
+    m_rich->GetBuffer().Invalidate(wxRICHTEXT_ALL);
+    m_rich->Thaw();
+
+    // The partial layout must have been done by the overridden function.
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    wxRichTextParagraph* const last = buffer.GetParagraphAtPosition(buffer.GetOwnRange().GetEnd());
+    CPPUNIT_ASSERT( last );
+    CPPUNIT_ASSERT( last->GetLines().empty() );
+    CPPUNIT_ASSERT( buffer.IsDirty() );
+
+    const int layoutCount = rich->GetLayoutCount();
+    CPPUNIT_ASSERT( layoutCount > 0 );
+
+    // And the rest of the buffer must be laid out in idle time, by it too.
+    wxStopWatch sw;
+    while ( buffer.IsDirty() )
+    {
+        if ( sw.Time() > 10000 )
+        {
+            WARN("Timed out waiting for wxRichTextCtrl layout");
+            break;
+        }
+
+        wxYield();
+    }
+
+    CPPUNIT_ASSERT( !buffer.IsDirty() );
+    CPPUNIT_ASSERT( !last->GetLines().empty() );
+    CPPUNIT_ASSERT( rich->GetLayoutCount() > layoutCount );
+}
+
 #endif //wxUSE_RICHTEXT
@@ -59,6 +59,7 @@ private:
         CPPUNIT_TEST( Visible );
         CPPUNIT_TEST( Scroll );
         CPPUNIT_TEST( Sort );
+        CPPUNIT_TEST( UniformRowHeight );
         WXUISIM_TEST( KeyNavigation );
         CPPUNIT_TEST( HasChildren );
         CPPUNIT_TEST( SelectItemSingle );
@@ -88,6 +89,7 @@ private:
     void Visible();
     void Scroll();
     void Sort();
+    void UniformRowHeight();
     void KeyNavigation();
     void HasChildren();
     void GetCount();
@@ -620,6 +622,43 @@ void TreeCtrlTestCase::Sort()
     CPPUNIT_ASSERT_EQUAL(zitem, m_tree->GetNextChild(m_root, cookie));
 }
 
+void TreeCtrlTestCase::UniformRowHeight()
+{
+    m_tree->ToggleWindowStyle(wxTR_UNIFORM_ROW_HEIGHT);
+
+    // this lays out the tree again after changing the style
+    m_tree->ScrollTo(m_root);
+
+    wxRect rectRoot, rectChild1, rectGrandchild, rectChild2;
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_root, rectRoot) );
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child1, rectChild1) );
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_grandchild, rectGrandchild) );
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child2, rectChild2) );
+
+    const int height = rectRoot.height;
+    CPPUNIT_ASSERT( height > 0 );
+    CPPUNIT_ASSERT_EQUAL( height, rectGrandchild.height );
+    CPPUNIT_ASSERT_EQUAL( rectRoot.y + height, rectChild1.y );
+    CPPUNIT_ASSERT_EQUAL( rectChild1.y + height, rectGrandchild.y );
+    CPPUNIT_ASSERT_EQUAL( rectGrandchild.y + height, rectChild2.y );
+
+    // the items below the collapsed or expanded branch must be moved
+    m_tree->Collapse(m_child1);
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child2, rectChild2) );
+    CPPUNIT_ASSERT_EQUAL( rectChild1.y + height, rectChild2.y );
+
+    m_tree->Expand(m_child1);
+    CPPUNIT_ASSERT( m_tree->GetBoundingRect(m_child2, rectChild2) );
+    CPPUNIT_ASSERT_EQUAL( rectGrandchild.y + height, rectChild2.y );
+
+    // hit testing must find the items at their new positions
+    int flags = 0;
+    CPPUNIT_ASSERT_EQUAL( m_child2,
+                          m_tree->HitTest(rectChild2.GetLeftTop() +
+                                          wxPoint(1, height / 2),
+                                          flags) );
+}
+
 void TreeCtrlTestCase::KeyNavigation()
 {
 #if wxUSE_UIACTIONSIMULATOR
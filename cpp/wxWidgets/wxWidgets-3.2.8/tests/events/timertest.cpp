@@ -20,6 +20,7 @@
 
 #include "wx/evtloop.h"
 #include "wx/timer.h"
+#include "wx/vector.h"
 
 // --------------------------------------------------------------------------
 // helper class counting the number of timer events
@@ -142,3 +143,84 @@ void TimerEventTestCase::Multiple()
     CPPUNIT_ASSERT( numTicks > 1 );
 #endif // !(wxGTK Unicode)
 }
+
+namespace
+{
+
+const int NUM_TIMERS = 100;
+
+// Handler counting the events from each of the timers with the IDs from 0 to
+// NUM_TIMERS and exiting the event loop after getting the given number of
+// them or an event from the last timer, used as timeout.
+class CountPerTimerHandler : public wxEvtHandler
+{
+public:
+    CountPerTimerHandler(wxEventLoopBase& loop, int numExpected)
+        : m_loop(loop),
+          m_counts(NUM_TIMERS + 1, 0),
+          m_numExpected(numExpected),
+          m_numEvents(0)
+    {
+        Bind(wxEVT_TIMER, &CountPerTimerHandler::OnTimer, this);
+    }
+
+    int GetCount(int id) const { return m_counts[id]; }
+
+private:
+    void OnTimer(wxTimerEvent& event)
+    {
+        m_counts[event.GetId()]++;
+
+        if ( ++m_numEvents == m_numExpected || event.GetId() == NUM_TIMERS )
+            m_loop.Exit();
+    }
+
+    wxEventLoopBase& m_loop;
+    wxVector<int> m_counts;
+    const int m_numExpected;
+    int m_numEvents;
+
+    wxDECLARE_NO_COPY_CLASS(CountPerTimerHandler);
+};
+
+} // anonymous namespace
+
+// Check that many timers started, restarted and stopped in arbitrary order
+// are all notified exactly once unless they were stopped.
+TEST_CASE("wxTimer::Many", "[timer]")
+{
+    wxEventLoop loop;
+    CountPerTimerHandler handler(loop, NUM_TIMERS / 2);
+
+    wxVector<wxTimer*> timers;
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        wxTimer* const timer = new wxTimer(&handler, n);
+        timer->Start(10 + (n*37) % 50, wxTIMER_ONE_SHOT);
+        timers.push_back(timer);
+    }
+
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        if ( n % 2 )
+            timers[n]->Stop();
+        else if ( n % 3 == 0 )
+            timers[n]->Start(20 + (n*13) % 40, wxTIMER_ONE_SHOT);
+    }
+
+    wxTimer timeout(&handler, NUM_TIMERS);
+    timeout.Start(5000, wxTIMER_ONE_SHOT);
+
+    loop.Run();
+
+    CHECK( handler.GetCount(NUM_TIMERS) == 0 );
+
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        INFO("Timer #" << n);
+        CHECK( handler.GetCount(n) == (n % 2 ? 0 : 1) );
+        CHECK( !timers[n]->IsRunning() );
+
+        delete timers[n];
+    }
+}
@@ -16,6 +16,7 @@
 #include "wx/dir.h"
 #include "wx/filename.h"
 #include "wx/stdpaths.h"
+#include "wx/thread.h"
 
 #define DIRTEST_FOLDER      wxString("dirTest_folder")
 #define SEP                 wxFileName::GetPathSeparator()
@@ -180,6 +181,64 @@ TEST_CASE_METHOD(DirTestCase, "Dir::Traverse", "[dir]")
     CHECK( traverser.dirs.size() == 6 );
 }
 
+#if wxUSE_THREADS
+
+// Traverser which can be used with wxDIR_PARALLEL.
+class TestDirTraverserMT : public wxDirTraverser
+{
+public:
+    wxArrayString files,
+                  dirs;
+
+    virtual wxDirTraverseResult OnFile(const wxString& filename) wxOVERRIDE
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        files.push_back(filename);
+        return wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        dirs.push_back(dirname);
+        return wxDIR_CONTINUE;
+    }
+
+private:
+    wxCriticalSection m_cs;
+};
+
+TEST_CASE_METHOD(DirTestCase, "Dir::TraverseParallel", "[dir]")
+{
+    wxDir dir(DIRTEST_FOLDER);
+
+    TestDirTraverserMT traverser;
+    CHECK( dir.Traverse(traverser, wxEmptyString,
+                        wxDIR_DEFAULT | wxDIR_PARALLEL) == 4 );
+    CHECK( traverser.files.size() == 4 );
+    CHECK( traverser.dirs.size() == 6 );
+
+    // The order is unspecified, so compare with the sorted results of the
+    // normal traversal.
+    TestDirTraverserMT traverserSerial;
+    CHECK( dir.Traverse(traverserSerial) == 4 );
+
+    traverser.files.Sort();
+    traverserSerial.files.Sort();
+    CHECK( traverser.files == traverserSerial.files );
+
+    traverser.dirs.Sort();
+    traverserSerial.dirs.Sort();
+    CHECK( traverser.dirs == traverserSerial.dirs );
+
+    // Check that filespec is taken into account too.
+    TestDirTraverserMT traverserFoo;
+    CHECK( dir.Traverse(traverserFoo, "*.foo",
+                        wxDIR_DEFAULT | wxDIR_PARALLEL) == 1 );
+}
+
+#endif // wxUSE_THREADS
+
 TEST_CASE_METHOD(DirTestCase, "Dir::Exists", "[dir]")
 {
     struct
@@ -21,13 +21,35 @@
 
 #if wxUSE_FILESYSTEM
 
+#include "wx/fs_arc.h"
 #include "wx/fs_mem.h"
+#include "wx/mstream.h"
 #include "wx/scopedptr.h"
+#include "wx/zipstrm.h"
 
 // ----------------------------------------------------------------------------
 // helpers
 // ----------------------------------------------------------------------------
 
+// Install the given handler just for the lifetime of this object.
+class AutoFSHandler
+{
+public:
+    explicit AutoFSHandler(wxFileSystemHandler* handler)
+        : m_handler(handler)
+    {
+        wxFileSystem::AddHandler(m_handler.get());
+    }
+
+    ~AutoFSHandler()
+    {
+        wxFileSystem::RemoveHandler(m_handler.get());
+    }
+
+private:
+    wxScopedPtr<wxFileSystemHandler> const m_handler;
+};
+
 // a hack to let us use wxFileSystemHandler's protected methods:
 class UrlTester : public wxFileSystemHandler
 {
@@ -181,23 +203,7 @@ TEST_CASE("wxFileSystem::UnicodeFileNameToUrlConversion", "[filesys][url][filena
 TEST_CASE("wxFileSystem::MemoryFSHandler", "[filesys][memoryfshandler][find]")
 {
     // Install wxMemoryFSHandler just for the duration of this test.
-    class AutoMemoryFSHandler
-    {
-    public:
-        AutoMemoryFSHandler()
-            : m_handler(new wxMemoryFSHandler())
-        {
-            wxFileSystem::AddHandler(m_handler.get());
-        }
-
-        ~AutoMemoryFSHandler()
-        {
-            wxFileSystem::RemoveHandler(m_handler.get());
-        }
-
-    private:
-        wxScopedPtr<wxMemoryFSHandler> const m_handler;
-    } autoMemoryFSHandler;
+    AutoFSHandler autoMemoryFSHandler(new wxMemoryFSHandler());
 
     wxMemoryFSHandler::AddFile("foo.txt", "foo contents");
     wxMemoryFSHandler::AddFile("bar.txt", "bar contents");
@@ -224,4 +230,55 @@ TEST_CASE("wxFileSystem::MemoryFSHandler", "[filesys][memoryfshandler][find]")
     CHECK( fs.FindNext() == "" );
 }
 
+#if wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
+TEST_CASE("wxFileSystem::ArchiveFSHandler", "[filesys][archive]")
+{
+    AutoFSHandler autoMemoryFSHandler(new wxMemoryFSHandler());
+    AutoFSHandler autoArchiveFSHandler(new wxArchiveFSHandler());
+
+    wxMemoryOutputStream out;
+    {
+        wxZipOutputStream zip(out);
+        for ( int n = 0; n < 100; n++ )
+        {
+            REQUIRE( zip.PutNextEntry(wxString::Format("dir/file%d.txt", n)) );
+            zip.Write("contents", 8);
+            zip.Write(&n, sizeof(n));
+        }
+        REQUIRE( zip.Close() );
+    }
+
+    const wxStreamBuffer* const buf = out.GetOutputStreamBuffer();
+    wxMemoryFSHandler::AddFile("test.zip",
+                               buf->GetBufferStart(), buf->GetIntPosition());
+
+    wxFileSystem fs;
+
+    for ( int n = 99; n >= 0; n -= 33 )
+    {
+        INFO("Entry " << n);
+
+        wxScopedPtr<wxFSFile>
+            file(fs.OpenFile(wxString::Format("memory:test.zip#zip:dir/file%d.txt", n)));
+        REQUIRE( file );
+
+        char data[16];
+        wxInputStream* const stream = file->GetStream();
+        REQUIRE( stream->Read(data, sizeof(data)).LastRead() == 8 + sizeof(n) );
+        CHECK( memcmp(data, "contents", 8) == 0 );
+        CHECK( memcmp(data + 8, &n, sizeof(n)) == 0 );
+    }
+
+    wxScopedPtr<wxFSFile> file(fs.OpenFile("memory:test.zip#zip:dir/missing"));
+    CHECK( !file );
+
+    CHECK( fs.FindFirst("memory:test.zip#zip:dir/file1?.txt")
+            == "memory:test.zip#zip:dir/file10.txt" );
+
+    wxMemoryFSHandler::RemoveFile("test.zip");
+}
+
+#endif // wxUSE_FS_ARCHIVE && wxUSE_ZIPSTREAM
+
 #endif // wxUSE_FILESYSTEM
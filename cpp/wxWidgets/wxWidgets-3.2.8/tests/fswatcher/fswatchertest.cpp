@@ -614,6 +614,41 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
     EventTester tester;
     tester.Run();
 }
+
+// ----------------------------------------------------------------------------
+// TestEventModifyCoalesced: repeated modifications give a single event
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::EventModifyCoalesced", "[fsw]")
+{
+    class EventTester : public FSWTesterBase
+    {
+    public:
+        virtual void GenerateEvent() wxOVERRIDE
+        {
+            // Each of these opens and closes the file, so the kernel doesn't
+            // merge the modification events itself.
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() wxOVERRIDE
+        {
+            wxFileSystemWatcherEvent event(wxFSW_EVENT_MODIFY);
+            event.SetPath(eg.m_file);
+            event.SetNewPath(eg.m_file);
+            return event;
+        }
+    };
+
+    // we need to create a file to modify
+    EventGenerator::Get().CreateFile();
+
+    EventTester tester;
+    tester.Run();
+}
 #endif // wxHAS_INOTIFY
 
 // ----------------------------------------------------------------------------
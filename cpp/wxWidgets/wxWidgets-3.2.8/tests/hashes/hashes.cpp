@@ -79,6 +79,11 @@ private:
 #ifdef TEST_LONGLONG
         CPPUNIT_TEST( LLongHashMapTest );
         CPPUNIT_TEST( ULLongHashMapTest );
+#endif
+#ifdef wxNEEDS_WX_HASH_MAP
+        CPPUNIT_TEST( FlatStringHashMapTest );
+        CPPUNIT_TEST( FlatLongHashMapTest );
+        CPPUNIT_TEST( FlatHashMapEraseInsert );
 #endif
         CPPUNIT_TEST( wxHashSetTest );
     CPPUNIT_TEST_SUITE_END();
@@ -97,6 +102,11 @@ private:
 #ifdef TEST_LONGLONG
     void LLongHashMapTest();
     void ULLongHashMapTest();
+#endif
+#ifdef wxNEEDS_WX_HASH_MAP
+    void FlatStringHashMapTest();
+    void FlatLongHashMapTest();
+    void FlatHashMapEraseInsert();
 #endif
     void wxHashSetTest();
 
@@ -335,6 +345,19 @@ WX_DECLARE_STRING_HASH_MAP(wxString, myStringHashMap);
                          wxIntegerHash, wxIntegerEqual, myULLongHashMap );
 #endif
 
+#ifdef wxNEEDS_WX_HASH_MAP
+// Also test the open addressing implementation even if it's not used by
+// default.
+_WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_FLAT_HASHTABLE,
+                                 wxString, wxString,
+                                 wxStringHash, wxStringEqual,
+                                 myFlatStringHashMap, class );
+_WX_DECLARE_HASH_MAP_WITH_TABLE( _WX_DECLARE_FLAT_HASHTABLE,
+                                 long, long,
+                                 wxIntegerHash, wxIntegerEqual,
+                                 myFlatLongHashMap, class );
+#endif // wxNEEDS_WX_HASH_MAP
+
 // Helpers to generate a key value pair for item 'i', out of a total of 'count'
 void MakeKeyValuePair(size_t i, size_t /*count*/, wxString& key, wxString& val)
 {
@@ -472,6 +495,46 @@ void HashesTestCase::LLongHashMapTest()  { HashMapTest<myLLongHashMap>();    }
 void HashesTestCase::ULLongHashMapTest() { HashMapTest<myULLongHashMap>();   }
 #endif
 
+#ifdef wxNEEDS_WX_HASH_MAP
+void HashesTestCase::FlatStringHashMapTest() { HashMapTest<myFlatStringHashMap>(); }
+void HashesTestCase::FlatLongHashMapTest()   { HashMapTest<myFlatLongHashMap>();   }
+
+void HashesTestCase::FlatHashMapEraseInsert()
+{
+    // Erasing the elements leaves deleted slots in the table, check that they
+    // are reused correctly and don't prevent finding the other elements.
+    myFlatLongHashMap h;
+    for ( long n = 0; n < 1000; n++ )
+    {
+        h[n] = n;
+        if ( n >= 10 )
+            CPPUNIT_ASSERT_EQUAL( 1u, h.erase(n - 10) );
+
+        CPPUNIT_ASSERT( h.size() <= 10 );
+        for ( long m = wxMax(0, n - 9); m <= n; m++ )
+            CPPUNIT_ASSERT_EQUAL( m, h[m] );
+    }
+
+    // Erase the elements while iterating over them.
+    for ( myFlatLongHashMap::iterator it = h.begin(); it != h.end(); )
+    {
+        if ( it->first % 2 )
+            h.erase(it++);
+        else
+            ++it;
+    }
+    CPPUNIT_ASSERT_EQUAL( 5u, h.size() );
+
+    h.clear();
+    CPPUNIT_ASSERT( h.empty() );
+    CPPUNIT_ASSERT( h.begin() == h.end() );
+
+    h[17] = 42;
+    CPPUNIT_ASSERT_EQUAL( 1u, h.size() );
+    CPPUNIT_ASSERT_EQUAL( 42L, h[17] );
+}
+#endif // wxNEEDS_WX_HASH_MAP
+
 // test compilation of basic set types
 WX_DECLARE_HASH_SET( int*, wxPointerHash, wxPointerEqual, myPtrHashSet );
 WX_DECLARE_HASH_SET( long, wxIntegerHash, wxIntegerEqual, myLongHashSet );
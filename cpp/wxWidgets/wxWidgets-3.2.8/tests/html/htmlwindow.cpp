@@ -44,6 +44,7 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( AppendToPageMany );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +52,7 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void AppendToPageMany();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +168,31 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::AppendToPageMany()
+{
+#if wxUSE_CLIPBOARD
+    // Appending the fragments one by one must give the same result as setting
+    // the entire page at once.
+    wxString page = "<html><body><p>First line</p>";
+    m_win->SetPage(page);
+
+    for ( int n = 0; n < 10; n++ )
+    {
+        const wxString
+            fragment = wxString::Format("<p>Line <b>%d</b> <i>here</i></p>", n);
+        m_win->AppendToPage(fragment);
+        page += fragment;
+    }
+
+    const wxString text = m_win->ToText();
+    const int height = m_win->GetInternalRepresentation()->GetHeight();
+
+    m_win->SetPage(page);
+
+    CPPUNIT_ASSERT_EQUAL( m_win->ToText(), text );
+    CPPUNIT_ASSERT_EQUAL( m_win->GetInternalRepresentation()->GetHeight(),
+                          height );
+#endif // wxUSE_CLIPBOARD
+}
+
 #endif //wxUSE_HTML
@@ -2345,6 +2345,186 @@ TEST_CASE("wxImage::SizeLimits", "[image]")
 #endif // SIZEOF_VOID_P == 8
 }
 
+TEST_CASE("wxImage::ScaleThreads", "[image][scale]")
+{
+    wxImage original;
+    REQUIRE( original.LoadFile("horse.png") );
+
+    // Use non-trivial alpha to test its handling too.
+    original.InitAlpha();
+    unsigned char* alpha = original.GetAlpha();
+    const int numPixels = original.GetWidth()*original.GetHeight();
+    for ( int n = 0; n < numPixels; n++ )
+        alpha[n] = static_cast<unsigned char>(n % 251);
+
+    // Make the image big enough for the threads to be really used.
+    const wxImage image = original.Scale(1024, 1024, wxIMAGE_QUALITY_NEAREST);
+
+    const wxImageResizeQuality qualities[] =
+    {
+        wxIMAGE_QUALITY_BILINEAR,
+        wxIMAGE_QUALITY_BICUBIC,
+        wxIMAGE_QUALITY_BOX_AVERAGE,
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(qualities); n++ )
+    {
+        INFO("Quality " << qualities[n]);
+
+        wxImage::SetMaxResampleThreads(1);
+        const wxImage shrunk1 = image.Scale(500, 400, qualities[n]);
+        const wxImage enlarged1 = image.Scale(1500, 1200, qualities[n]);
+
+        wxImage::SetMaxResampleThreads(4);
+        CHECK_THAT( image.Scale(500, 400, qualities[n]), RGBASameAs(shrunk1) );
+        CHECK_THAT( image.Scale(1500, 1200, qualities[n]), RGBASameAs(enlarged1) );
+    }
+
+    wxImage::SetMaxResampleThreads(0);
+}
+
+namespace
+{
+
+// Decode the image row by row into a wxImage using wxImageBufferRowSink.
+wxImage LoadImageRows(const wxString& filename, int scale)
+{
+    wxImage image(200, 200);
+    image.SetAlpha();
+
+    wxImageBufferRowSink sink(image.GetData(), image.GetWidth(),
+                              image.GetHeight());
+    sink.SetAlphaBuffer(image.GetAlpha());
+    if ( !wxImage::LoadRows(filename, sink, wxBITMAP_TYPE_ANY, scale) )
+        return wxImage();
+
+    CHECK( sink.GetRowsCount() == sink.GetHeight() );
+
+    image = image.Size(wxSize(sink.GetWidth(), sink.GetHeight()), wxPoint());
+    if ( !sink.HasAlpha() )
+        image.ClearAlpha();
+
+    return image;
+}
+
+// Return the image consisting of every scale-th pixel of every scale-th row
+// of the original one, which is what LoadRows() returns for lossless formats.
+wxImage DecimateImage(const wxImage& image, int scale)
+{
+    const int width = (image.GetWidth() + scale - 1) / scale,
+              height = (image.GetHeight() + scale - 1) / scale;
+
+    wxImage result(width, height);
+    for ( int y = 0; y < height; y++ )
+    {
+        for ( int x = 0; x < width; x++ )
+        {
+            result.SetRGB(x, y,
+                          image.GetRed(x*scale, y*scale),
+                          image.GetGreen(x*scale, y*scale),
+                          image.GetBlue(x*scale, y*scale));
+        }
+    }
+
+    return result;
+}
+
+// Sink stopping after getting the given number of rows.
+class StopAfterRowSink : public wxImageRowSink
+{
+public:
+    explicit StopAfterRowSink(int rowsMax) : m_rowsMax(rowsMax) { m_rows = 0; }
+
+    int GetRowsCount() const { return m_rows; }
+
+    virtual bool ProcessRow(int y,
+                            const unsigned char* WXUNUSED(data),
+                            const unsigned char* WXUNUSED(alpha)) wxOVERRIDE
+    {
+        CHECK( y == m_rows );
+
+        return ++m_rows < m_rowsMax;
+    }
+
+private:
+    const int m_rowsMax;
+    int m_rows;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxImage::LoadRows", "[image][load]")
+{
+    wxImage expected;
+
+    SECTION("PNG")
+    {
+        // Note that this PNG is interlaced, so this tests the special code
+        // for handling such images too.
+        REQUIRE( expected.LoadFile("horse.png") );
+        REQUIRE( expected.GetSize() == wxSize(200, 200) );
+
+        for ( int scale = 1; scale <= 8; scale *= 2 )
+        {
+            INFO("Scale " << scale);
+
+            const wxImage image = LoadImageRows("horse.png", scale);
+            REQUIRE( image.IsOk() );
+            CHECK_THAT( image, RGBSameAs(DecimateImage(expected, scale)) );
+        }
+    }
+
+    SECTION("JPEG")
+    {
+        REQUIRE( expected.LoadFile("horse.jpg") );
+
+        CHECK_THAT( LoadImageRows("horse.jpg", 1), RGBSameAs(expected) );
+
+        // JPEG handler uses the same DCT scaling when max size is specified.
+        for ( int scale = 2; scale <= 8; scale *= 2 )
+        {
+            INFO("Scale " << scale);
+
+            expected = wxImage();
+            expected.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 200 / scale);
+            REQUIRE( expected.LoadFile("horse.jpg") );
+
+            CHECK_THAT( LoadImageRows("horse.jpg", scale), RGBSameAs(expected) );
+        }
+    }
+
+    SECTION("Other")
+    {
+        REQUIRE( expected.LoadFile("horse.bmp") );
+
+        CHECK_THAT( LoadImageRows("horse.bmp", 1), RGBSameAs(expected) );
+        CHECK_THAT( LoadImageRows("horse.bmp", 4),
+                    RGBSameAs(DecimateImage(expected, 4)) );
+    }
+
+    SECTION("Stop")
+    {
+        StopAfterRowSink sink(10);
+        CHECK( wxImage::LoadRows("horse.png", sink) );
+        CHECK( sink.GetRowsCount() == 10 );
+
+        StopAfterRowSink sinkJPEG(3);
+        CHECK( wxImage::LoadRows("horse.jpg", sinkJPEG, wxBITMAP_TYPE_JPEG, 2) );
+        CHECK( sinkJPEG.GetRowsCount() == 3 );
+    }
+
+    SECTION("TooBig")
+    {
+        unsigned char data[3*50*50];
+        wxImageBufferRowSink sink(data, 50, 50);
+        CHECK( !wxImage::LoadRows("horse.png", sink) );
+        CHECK( sink.GetRowsCount() == 0 );
+
+        CHECK( wxImage::LoadRows("horse.png", sink, wxBITMAP_TYPE_PNG, 4) );
+        CHECK( sink.GetRowsCount() == 50 );
+    }
+}
+
 // This can be used to test loading an arbitrary image file by setting the
 // environment variable WX_TEST_IMAGE_PATH to point to it.
 TEST_CASE("wxImage::LoadPath", "[.]")
@@ -23,6 +23,9 @@
 
 #include "wx/private/glibc.h"
 
+#include <string>
+#include <vector>
+
 #if wxUSE_INTL
 
 // ----------------------------------------------------------------------------
@@ -288,6 +291,193 @@ TEST_CASE("wxTranslations::AddCatalog", "[translations]")
     }
 }
 
+// Create a catalog without hash table from the given strings, which must be
+// sorted, in the .mo format.
+static wxCharBuffer
+CreateCatalogData(const std::vector<std::string>& orig,
+                  const std::vector<std::string>& trans)
+{
+    const wxUint32 numStrings = orig.size();
+    const wxUint32 ofsOrigTable = 7*sizeof(wxUint32);
+    const wxUint32 ofsTransTable = ofsOrigTable + 2*sizeof(wxUint32)*numStrings;
+
+    std::vector<wxUint32> words;
+    words.push_back(0x950412de);
+    words.push_back(0);
+    words.push_back(numStrings);
+    words.push_back(ofsOrigTable);
+    words.push_back(ofsTransTable);
+    words.push_back(0);
+    words.push_back(0);
+
+    std::string strings;
+    wxUint32 ofsString = ofsTransTable + 2*sizeof(wxUint32)*numStrings;
+    for ( int table = 0; table < 2; table++ )
+    {
+        const std::vector<std::string>& v = table ? trans : orig;
+        for ( size_t n = 0; n < v.size(); n++ )
+        {
+            words.push_back(v[n].length());
+            words.push_back(ofsString + strings.length());
+            strings += v[n];
+            strings += '\0';
+        }
+    }
+
+    const size_t sizeWords = words.size()*sizeof(wxUint32);
+    wxCharBuffer buf(sizeWords + strings.length());
+    memcpy(buf.data(), &words[0], sizeWords);
+    memcpy(buf.data() + sizeWords, strings.data(), strings.length());
+
+    return buf;
+}
+
+// Loader using the catalog data in memory for all domains.
+class DataTranslationsLoader : public wxTranslationsLoader
+{
+public:
+    explicit DataTranslationsLoader(const wxScopedCharBuffer& data)
+        : m_data(data)
+    {
+    }
+
+    virtual wxMsgCatalog *LoadCatalog(const wxString& domain,
+                                      const wxString& WXUNUSED(lang)) wxOVERRIDE
+    {
+        return wxMsgCatalog::CreateFromData(m_data, domain);
+    }
+
+    virtual wxArrayString
+    GetAvailableTranslations(const wxString& WXUNUSED(domain)) const wxOVERRIDE
+    {
+        wxArrayString langs;
+        langs.push_back("fr");
+        return langs;
+    }
+
+private:
+    const wxScopedCharBuffer m_data;
+};
+
+TEST_CASE("wxTranslations::MappedCatalogs", "[translations]")
+{
+    wxON_BLOCK_EXIT1(wxTranslations::EnableMappedCatalogs, false);
+    wxTranslations::EnableMappedCatalogs();
+
+    SECTION("File")
+    {
+        wxFileTranslationsLoader::AddCatalogLookupPathPrefix("./intl");
+
+        wxTranslations trans;
+        trans.SetLanguage(wxLANGUAGE_FRENCH);
+        REQUIRE( trans.AddAvailableCatalog("internat") );
+
+        const wxString* s = trans.GetTranslatedString("&Open bogus file");
+        REQUIRE( s );
+        CHECK( *s == "&Ouvrir un fichier" );
+
+        // Check that the translation is cached.
+        CHECK( trans.GetTranslatedString("&Open bogus file") == s );
+        CHECK( trans.IsLoaded("internat") );
+
+        s = trans.GetTranslatedString("Enter your number:", "internat");
+        REQUIRE( s );
+        CHECK( *s == wxString::FromUTF8("Entrez votre num\xc3\xa9ro:") );
+
+        // And that missing strings are not found, even when looked up again.
+        CHECK( !trans.GetTranslatedString("Not translated") );
+        CHECK( !trans.GetTranslatedString("Not translated") );
+
+        CHECK( trans.GetHeaderValue("Last-Translator") ==
+                "Vadim Zeitlin <zeitlin@dptmaths.ens-cachan.fr>" );
+    }
+
+    SECTION("Data")
+    {
+        std::vector<std::string> orig, trans;
+        orig.push_back("");
+        trans.push_back("Content-Type: text/plain; charset=UTF-8\n"
+                        "Plural-Forms: nplurals=2; plural=(n != 1);\n");
+        orig.push_back("ctx\x04string");
+        trans.push_back("string in context");
+        orig.push_back(std::string("file\0files", 10));
+        trans.push_back(std::string("fichier\0fichiers", 16));
+        orig.push_back("string");
+        trans.push_back("cha\xc3\xaene");
+        orig.push_back("untranslated");
+        trans.push_back("");
+
+        wxTranslations t;
+        t.SetLoader(new DataTranslationsLoader(CreateCatalogData(orig, trans)));
+        t.SetLanguage(wxLANGUAGE_FRENCH);
+        REQUIRE( t.AddAvailableCatalog("test") );
+
+        const wxString* s = t.GetTranslatedString("string");
+        REQUIRE( s );
+        CHECK( *s == wxString::FromUTF8("cha\xc3\xaene") );
+
+        s = t.GetTranslatedString("string", "test", "ctx");
+        REQUIRE( s );
+        CHECK( *s == "string in context" );
+
+        s = t.GetTranslatedString("file", 1);
+        REQUIRE( s );
+        CHECK( *s == "fichier" );
+
+        s = t.GetTranslatedString("file", 2);
+        REQUIRE( s );
+        CHECK( *s == "fichiers" );
+
+        CHECK( !t.GetTranslatedString("files") );
+        CHECK( !t.GetTranslatedString("untranslated") );
+        CHECK( !t.GetTranslatedString("string", "test", "other") );
+    }
+
+    SECTION("Stable")
+    {
+        // The translations are returned by reference by wxGetTranslation(),
+        // so check that looking up more strings doesn't invalidate them.
+        const int NUM_STRINGS = 1000;
+
+        std::vector<std::string> orig, trans;
+        orig.push_back("");
+        trans.push_back("Content-Type: text/plain; charset=UTF-8\n");
+        for ( int n = 0; n < NUM_STRINGS; n++ )
+        {
+            orig.push_back(wxString::Format("msg%04d", n).ToStdString());
+            trans.push_back(wxString::Format("trans%04d", n).ToStdString());
+        }
+
+        wxTranslations t;
+        t.SetLoader(new DataTranslationsLoader(CreateCatalogData(orig, trans)));
+        t.SetLanguage(wxLANGUAGE_FRENCH);
+        REQUIRE( t.AddAvailableCatalog("test") );
+
+        std::vector<const wxString*> translations;
+        for ( int n = 0; n < NUM_STRINGS / 2; n++ )
+        {
+            const wxString* const s =
+                t.GetTranslatedString(wxString::Format("msg%04d", n));
+            REQUIRE( s );
+            translations.push_back(s);
+        }
+
+        for ( int n = NUM_STRINGS / 2; n < NUM_STRINGS; n++ )
+        {
+            CHECK( t.GetTranslatedString(wxString::Format("msg%04d", n)) );
+            CHECK( !t.GetTranslatedString(wxString::Format("missing%04d", n)) );
+        }
+
+        for ( int n = 0; n < NUM_STRINGS / 2; n++ )
+        {
+            INFO( "n = " << n );
+            CHECK( *translations[n] == wxString::Format("trans%04d", n) );
+            CHECK( t.GetTranslatedString(wxString::Format("msg%04d", n))
+                    == translations[n] );
+        }
+    }
+}
+
 TEST_CASE("wxTranslations::GetBestTranslation", "[translations]")
 {
     wxFileTranslationsLoader::AddCatalogLookupPathPrefix("./intl");
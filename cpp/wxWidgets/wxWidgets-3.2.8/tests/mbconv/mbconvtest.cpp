@@ -24,6 +24,9 @@
 
 #include "wx/private/localeset.h"
 
+#include <string>
+#include <vector>
+
 #if defined wxHAVE_TCHAR_SUPPORT && !defined HAVE_WCHAR_H
     #define HAVE_WCHAR_H
 #endif
@@ -1508,3 +1511,251 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+// ----------------------------------------------------------------------------
+// tests for the runs of characters converted in bulk
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+typedef std::vector<wxUint32> CodePoints;
+typedef std::vector<wchar_t> WideChars;
+
+// Special code point value used for an invalid byte in UTF-8 strings.
+const wxUint32 INVALID_BYTE = 0xffffffff;
+
+// Create a string of ASCII characters of the given length with the special
+// character at the given position.
+CodePoints MakeRun(size_t len, size_t pos, wxUint32 special)
+{
+    static const char ascii[] = "The quick brown fox jumps over the lazy dog\x7f";
+
+    CodePoints cps;
+    for ( size_t n = 0; n < len; n++ )
+        cps.push_back(n == pos ? special : ascii[n % (WXSIZEOF(ascii) - 1)]);
+
+    return cps;
+}
+
+// Straightforward encoders used to check the results of the real ones.
+std::string EncodeUTF8(const CodePoints& cps)
+{
+    std::string s;
+    for ( size_t n = 0; n < cps.size(); n++ )
+    {
+        const wxUint32 c = cps[n];
+        if ( c == INVALID_BYTE )
+        {
+            s += '\xff';
+        }
+        else if ( c < 0x80 )
+        {
+            s += static_cast<char>(c);
+        }
+        else if ( c < 0x800 )
+        {
+            s += static_cast<char>(0xc0 | (c >> 6));
+            s += static_cast<char>(0x80 | (c & 0x3f));
+        }
+        else if ( c < 0x10000 )
+        {
+            s += static_cast<char>(0xe0 | (c >> 12));
+            s += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+            s += static_cast<char>(0x80 | (c & 0x3f));
+        }
+        else
+        {
+            s += static_cast<char>(0xf0 | (c >> 18));
+            s += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+            s += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+            s += static_cast<char>(0x80 | (c & 0x3f));
+        }
+    }
+
+    return s;
+}
+
+void AppendBytes(std::string& s, wxUint32 value, size_t size, bool bigEndian)
+{
+    for ( size_t n = 0; n < size; n++ )
+    {
+        const size_t shift = 8*(bigEndian ? size - 1 - n : n);
+        s += static_cast<char>((value >> shift) & 0xff);
+    }
+}
+
+// Notice that surrogate code points are stored as is by this function, which
+// allows to create invalid UTF-16 strings with it.
+std::string EncodeUTF16(const CodePoints& cps, bool bigEndian)
+{
+    std::string s;
+    for ( size_t n = 0; n < cps.size(); n++ )
+    {
+        const wxUint32 c = cps[n];
+        if ( c < 0x10000 )
+        {
+            AppendBytes(s, c, 2, bigEndian);
+        }
+        else
+        {
+            AppendBytes(s, 0xd800 + ((c - 0x10000) >> 10), 2, bigEndian);
+            AppendBytes(s, 0xdc00 + ((c - 0x10000) & 0x3ff), 2, bigEndian);
+        }
+    }
+
+    return s;
+}
+
+std::string EncodeUTF32(const CodePoints& cps, bool bigEndian)
+{
+    std::string s;
+    for ( size_t n = 0; n < cps.size(); n++ )
+        AppendBytes(s, cps[n], 4, bigEndian);
+
+    return s;
+}
+
+// Invalid bytes are mapped to PUA, as wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA
+// does.
+WideChars ToWide(const CodePoints& cps)
+{
+    WideChars wide;
+    for ( size_t n = 0; n < cps.size(); n++ )
+    {
+        wxUint32 c = cps[n];
+        if ( c == INVALID_BYTE )
+            c = 0x1000ff;
+
+#if SIZEOF_WCHAR_T == 2
+        if ( c >= 0x10000 )
+        {
+            wide.push_back(static_cast<wchar_t>(0xd800 + ((c - 0x10000) >> 10)));
+            wide.push_back(static_cast<wchar_t>(0xdc00 + ((c - 0x10000) & 0x3ff)));
+            continue;
+        }
+#endif // SIZEOF_WCHAR_T == 2
+
+        wide.push_back(static_cast<wchar_t>(c));
+    }
+
+    return wide;
+}
+
+// Check that the conversion works in both directions, including just
+// computing the required lengths.
+void CheckRoundTrip(const wxMBConv& conv,
+                    const std::string& mb,
+                    const WideChars& wide)
+{
+    // Add a dummy element to avoid taking the address of the first element of
+    // an empty vector.
+    WideChars buf(wide.size() + 1);
+
+    CHECK( conv.ToWChar(NULL, 0, mb.data(), mb.size()) == wide.size() );
+    REQUIRE( conv.ToWChar(&buf[0], wide.size(), mb.data(), mb.size())
+                == wide.size() );
+    buf.pop_back();
+    CHECK( buf == wide );
+
+    // Also check the length of NUL-terminated string.
+    const std::string mbz = mb + std::string(conv.GetMBNulLen(), '\0');
+    CHECK( conv.ToWChar(NULL, 0, mbz.data()) == wide.size() + 1 );
+
+    std::string out(mb.size() + 1, '\0');
+    CHECK( conv.FromWChar(NULL, 0, &wide[0], wide.size()) == mb.size() );
+    REQUIRE( conv.FromWChar(&out[0], mb.size(), &wide[0], wide.size())
+                == mb.size() );
+    out.resize(mb.size());
+    CHECK( out == mb );
+}
+
+void CheckToWCharFails(const wxMBConv& conv, const std::string& mb)
+{
+    CHECK( conv.ToWChar(NULL, 0, mb.data(), mb.size()) == wxCONV_FAILED );
+
+    WideChars buf(mb.size());
+    CHECK( conv.ToWChar(&buf[0], buf.size(), mb.data(), mb.size())
+            == wxCONV_FAILED );
+}
+
+// The lengths around the sizes of SIMD blocks used by the fast paths.
+const size_t runLengths[] = { 15, 16, 17, 31, 32, 33 };
+
+} // anonymous namespace
+
+TEST_CASE("wxMBConv::Runs", "[mbconv][runs]")
+{
+    // Characters encoded using 2, 3 and 4 bytes in UTF-8 and the latter one
+    // encoded as a surrogate pair in UTF-16.
+    static const wxUint32 specials[] =
+        { 0x80, 0xe9, 0x7ff, 0x800, 0x20ac, 0xfffd, 0x10000, 0x1f600, 0x10fffd };
+
+    const wxMBConvUTF8 convUTF8;
+    const wxMBConvUTF8 convUTF8PUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    const wxMBConvUTF16LE convUTF16LE;
+    const wxMBConvUTF16BE convUTF16BE;
+    const wxMBConvUTF32LE convUTF32LE;
+    const wxMBConvUTF32BE convUTF32BE;
+
+    for ( size_t l = 0; l < WXSIZEOF(runLengths); l++ )
+    {
+        const size_t len = runLengths[l];
+        for ( size_t pos = 0; pos < len; pos++ )
+        {
+            for ( size_t s = 0; s < WXSIZEOF(specials); s++ )
+            {
+                INFO("U+" << std::hex << specials[s] << std::dec
+                     << " at " << pos << " of " << len);
+
+                // Also check the same run repeated twice, to test resuming
+                // the bulk conversion after a special character.
+                CodePoints cps = MakeRun(len, pos, specials[s]);
+                for ( int repeat = 0; repeat < 2; repeat++ )
+                {
+                    if ( repeat )
+                        cps.insert(cps.end(), cps.begin(), cps.end());
+
+                    const WideChars wide = ToWide(cps);
+
+                    CheckRoundTrip(wxConvUTF8, EncodeUTF8(cps), wide);
+                    CheckRoundTrip(convUTF8, EncodeUTF8(cps), wide);
+                    CheckRoundTrip(convUTF8PUA, EncodeUTF8(cps), wide);
+                    CheckRoundTrip(convUTF16LE, EncodeUTF16(cps, false), wide);
+                    CheckRoundTrip(convUTF16BE, EncodeUTF16(cps, true), wide);
+                    CheckRoundTrip(convUTF32LE, EncodeUTF32(cps, false), wide);
+                    CheckRoundTrip(convUTF32BE, EncodeUTF32(cps, true), wide);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("wxMBConv::RunsInvalid", "[mbconv][runs]")
+{
+    const wxMBConvUTF8 convUTF8;
+    const wxMBConvUTF8 convUTF8PUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    const wxMBConvUTF16LE convUTF16LE;
+    const wxMBConvUTF16BE convUTF16BE;
+
+    for ( size_t l = 0; l < WXSIZEOF(runLengths); l++ )
+    {
+        const size_t len = runLengths[l];
+        for ( size_t pos = 0; pos < len; pos++ )
+        {
+            INFO("Invalid character at " << pos << " of " << len);
+
+            const CodePoints invalidUTF8 = MakeRun(len, pos, INVALID_BYTE);
+            const std::string mb = EncodeUTF8(invalidUTF8);
+            CheckToWCharFails(wxConvUTF8, mb);
+            CheckToWCharFails(convUTF8, mb);
+            CheckRoundTrip(convUTF8PUA, mb, ToWide(invalidUTF8));
+
+            // Lone high and low surrogates are invalid in UTF-16.
+            CheckToWCharFails(convUTF16LE,
+                              EncodeUTF16(MakeRun(len, pos, 0xd800), false));
+            CheckToWCharFails(convUTF16BE,
+                              EncodeUTF16(MakeRun(len, pos, 0xdc00), true));
+        }
+    }
+}
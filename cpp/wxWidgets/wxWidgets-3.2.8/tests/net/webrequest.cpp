@@ -296,6 +296,59 @@ TEST_CASE_METHOD(RequestFixture,
     CHECK( dataSize == processingSize );
 }
 
+TEST_CASE_METHOD(RequestFixture,
+                 "WebRequest::Get::Stream", "[net][webrequest][get]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    const wxString path = wxFileName::CreateTempFileName("wxwebrequest");
+    REQUIRE( !path.empty() );
+
+    int processingSize = 99 * 1024;
+    Create(wxString::Format("/bytes/%d", processingSize));
+    request.SetStorageStream(new wxFileOutputStream(path));
+    CHECK( request.GetStorage() == wxWebRequest::Storage_Stream );
+    Run();
+    CHECK( request.GetBytesReceived() == processingSize );
+    CHECK( !request.GetResponse().GetStream() );
+
+    // The stream must have been closed when the request completed.
+    CHECK( wxFileName::GetSize(path) == processingSize );
+
+    wxRemoveFile(path);
+}
+
+TEST_CASE_METHOD(RequestFixture,
+                 "WebRequest::Get::Cache", "[net][webrequest][get]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    wxFileName cacheDir;
+    cacheDir.AssignDir(wxFileName::GetTempDir());
+    cacheDir.AppendDir(wxString::Format("wxwebcache%lu", wxGetProcessId()));
+
+    wxWebSession& session = wxWebSession::GetDefault();
+    session.SetCacheDir(cacheDir.GetPath());
+    CHECK( session.GetCacheDir() == cacheDir.GetPath() );
+
+    Create("/etag/wxtest");
+    Run();
+
+    const wxString body = request.GetResponse().AsString();
+    CHECK( !body.empty() );
+
+    // The second request must be answered by "304 Not Modified" and use the
+    // data from the cache.
+    Create("/etag/wxtest");
+    Run(wxWebRequest::State_Completed, 304);
+    CHECK( request.GetResponse().AsString() == body );
+
+    session.SetCacheDir(wxString());
+    wxFileName::Rmdir(cacheDir.GetPath(), wxPATH_RMDIR_RECURSIVE);
+}
+
 TEST_CASE_METHOD(RequestFixture,
                  "WebRequest::Error::HTTP", "[net][webrequest][error]")
 {
@@ -199,6 +199,70 @@ TEST_CASE("wxRegEx::Unicode", "[regex][unicode]")
     CHECK( re.GetMatch(cyrillicSmallA) == cyrillicSmallA );
 }
 
+TEST_CASE("wxRegEx::JIT", "[regex][jit]")
+{
+    const char* const pattern = "([a-z]+)[^0-9]*([0-9]+)";
+    const char* const texts[] = { "foo123", "123foo", "x_42 and y_17", "" };
+
+    wxRegEx re(pattern);
+    wxRegEx reJIT(pattern, wxRE_JIT);
+    REQUIRE( reJIT.IsValid() );
+    REQUIRE( reJIT.GetMatchCount() == re.GetMatchCount() );
+
+    for ( size_t n = 0; n < WXSIZEOF(texts); n++ )
+    {
+        INFO("Matching \"" << texts[n] << "\"");
+
+        const bool matches = re.Matches(texts[n]);
+        CHECK( reJIT.Matches(texts[n]) == matches );
+        if ( !matches )
+            continue;
+
+        for ( size_t i = 0; i < re.GetMatchCount(); i++ )
+            CHECK( reJIT.GetMatch(texts[n], i) == re.GetMatch(texts[n], i) );
+    }
+
+    wxString text("foo1 bar2 baz3");
+    CHECK( reJIT.Replace(&text, "\\2\\1") == 3 );
+    CHECK( text == "1foo 2bar 3baz" );
+}
+
+TEST_CASE("wxRegEx::MatchesUTF8", "[regex][utf8]")
+{
+    wxRegEx re("b(.)r", wxRE_JIT);
+    REQUIRE( re.IsValid() );
+
+    size_t start, len;
+
+    const char* const ascii = "foo bar";
+    REQUIRE( re.MatchesUTF8(ascii, strlen(ascii)) );
+    CHECK( re.GetMatch(&start, &len) );
+    CHECK( start == 4 );
+    CHECK( len == 3 );
+
+    // Offsets must be returned in bytes, even if the text contains multibyte
+    // characters: "\u00e9t\u00e9 b\u00e4r" (with the last character outside
+    // of the BMP to check that surrogates are handled correctly too).
+    const char* const utf8 = "\xc3\xa9t\xc3\xa9 b\xc3\xa4r \xf0\x9f\x98\x80";
+    REQUIRE( re.MatchesUTF8(utf8, strlen(utf8)) );
+    CHECK( re.GetMatch(&start, &len) );
+    CHECK( start == 6 );
+    CHECK( len == 4 );
+    CHECK( re.GetMatch(&start, &len, 1) );
+    CHECK( start == 7 );
+    CHECK( len == 2 );
+
+    wxRegEx reEmoji("r (.)$");
+    REQUIRE( reEmoji.MatchesUTF8(utf8, strlen(utf8)) );
+    CHECK( reEmoji.GetMatch(&start, &len, 1) );
+    CHECK( start == 11 );
+    CHECK( len == 4 );
+
+    // Only the specified length of the text must be used.
+    CHECK_FALSE( re.MatchesUTF8(ascii, 6) );
+    CHECK_FALSE( re.MatchesUTF8("", 0) );
+}
+
 // This pseudo test can be used just to see the version of PCRE being used.
 TEST_CASE("wxRegEx::GetLibraryVersionInfo", "[.]")
 {
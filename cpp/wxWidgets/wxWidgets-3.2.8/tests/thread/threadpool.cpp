@@ -0,0 +1,333 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     wxThreadPool unit test
+// Author:      wxWidgets development team
+// Created:     2026-10-17
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/event.h"
+#endif // WX_PRECOMP
+
+#include "wx/threadpool.h"
+#include "wx/vector.h"
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Task incrementing the given counter.
+class IncTask : public wxThreadPoolTask
+{
+public:
+    explicit IncTask(wxAtomicInt& counter) : m_counter(counter) { }
+
+protected:
+    virtual void Run() wxOVERRIDE { wxAtomicInc(m_counter); }
+
+private:
+    wxAtomicInt& m_counter;
+};
+
+// Task blocking the thread executing it until the semaphore is posted.
+class BlockingTask : public wxThreadPoolTask
+{
+public:
+    BlockingTask(wxSemaphore& started, wxSemaphore& release)
+        : m_started(started), m_release(release)
+    {
+    }
+
+protected:
+    virtual void Run() wxOVERRIDE
+    {
+        m_started.Post();
+        m_release.Wait();
+    }
+
+private:
+    wxSemaphore& m_started;
+    wxSemaphore& m_release;
+};
+
+// Task appending its ID to the given vector.
+class RecordTask : public wxThreadPoolTask
+{
+public:
+    RecordTask(wxCriticalSection& cs, wxVector<int>& order, int id)
+        : m_cs(cs), m_order(order), m_id(id)
+    {
+    }
+
+protected:
+    virtual void Run() wxOVERRIDE
+    {
+        wxCriticalSectionLocker lock(m_cs);
+        m_order.push_back(m_id);
+    }
+
+private:
+    wxCriticalSection& m_cs;
+    wxVector<int>& m_order;
+    const int m_id;
+};
+
+// Functor storing the square of its argument.
+struct SquareFunctor
+{
+    SquareFunctor(int n, int* result) : m_n(n), m_result(result) { }
+
+    void operator()() const { *m_result = m_n*m_n; }
+
+    int m_n;
+    int* m_result;
+};
+
+// Loop body incrementing the items of the given array.
+struct IncRangeFunctor
+{
+    explicit IncRangeFunctor(wxVector<int>& items) : m_items(items) { }
+
+    void operator()(int begin, int end) const
+    {
+        for ( int n = begin; n < end; n++ )
+            m_items[n]++;
+    }
+
+    wxVector<int>& m_items;
+};
+
+// Task submitting other tasks to the same pool and waiting for them.
+class NestedTask : public wxThreadPoolTask
+{
+public:
+    NestedTask(wxThreadPool& pool, wxAtomicInt& counter, int depth)
+        : m_pool(pool), m_counter(counter), m_depth(depth)
+    {
+    }
+
+protected:
+    virtual void Run() wxOVERRIDE
+    {
+        wxAtomicInc(m_counter);
+
+        if ( !m_depth )
+            return;
+
+        wxThreadPoolFuture futures[4];
+        for ( int n = 0; n < 4; n++ )
+            futures[n] = m_pool.Submit(new NestedTask(m_pool, m_counter,
+                                                      m_depth - 1));
+
+        for ( int n = 0; n < 4; n++ )
+            futures[n].Wait();
+    }
+
+private:
+    wxThreadPool& m_pool;
+    wxAtomicInt& m_counter;
+    const int m_depth;
+};
+
+// Functor used with CallAfter().
+struct SetFlagFunctor
+{
+    explicit SetFlagFunctor(bool* flag) : m_flag(flag) { }
+
+    void operator()() const { *m_flag = true; }
+
+    bool* m_flag;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxThreadPool::Submit", "[threadpool]")
+{
+    wxThreadPool pool(4);
+    CHECK( pool.GetThreadCount() == 4 );
+    CHECK( !pool.IsWorkerThread() );
+
+    wxAtomicInt counter(0);
+
+    wxVector<wxThreadPoolFuture> futures;
+    for ( int n = 0; n < 100; n++ )
+        futures.push_back(pool.Submit(new IncTask(counter)));
+
+    for ( size_t n = 0; n < futures.size(); n++ )
+    {
+        futures[n].Wait();
+        CHECK( futures[n].IsDone() );
+        CHECK( !futures[n].IsCancelled() );
+    }
+
+    CHECK( counter == 100 );
+    CHECK( pool.GetPendingCount() == 0 );
+}
+
+TEST_CASE("wxThreadPool::SubmitFunctor", "[threadpool]")
+{
+    wxThreadPool pool(2);
+
+    int result = 0;
+    wxThreadPoolFuture future = pool.SubmitFunctor(SquareFunctor(17, &result));
+    REQUIRE( future.IsOk() );
+    CHECK( future.WaitTimeout(10000) );
+    CHECK( result == 289 );
+}
+
+TEST_CASE("wxThreadPool::Cancel", "[threadpool]")
+{
+    wxThreadPool pool(1);
+
+    wxSemaphore started, release;
+    wxThreadPoolFuture blocking = pool.Submit(new BlockingTask(started, release));
+    started.Wait();
+
+    wxAtomicInt counter(0);
+    wxThreadPoolFuture future = pool.Submit(new IncTask(counter));
+    CHECK( !future.IsDone() );
+    CHECK( !future.WaitTimeout(10) );
+
+    CHECK( future.Cancel() );
+    CHECK( future.IsDone() );
+    CHECK( future.IsCancelled() );
+
+    // The running task can't be cancelled, but can check if it should stop.
+    CHECK( !blocking.Cancel() );
+    CHECK( blocking.GetTask()->IsCancelled() );
+
+    release.Post();
+    blocking.Wait();
+    CHECK( !blocking.IsCancelled() );
+
+    // Check that the cancelled task is not executed.
+    pool.Submit(new IncTask(counter)).Wait();
+    CHECK( counter == 1 );
+}
+
+TEST_CASE("wxThreadPool::Priority", "[threadpool]")
+{
+    wxThreadPool pool(1);
+
+    wxSemaphore started, release;
+    pool.Submit(new BlockingTask(started, release));
+    started.Wait();
+
+    wxCriticalSection cs;
+    wxVector<int> order;
+    pool.Submit(new RecordTask(cs, order, 3), wxTHREAD_POOL_PRIORITY_LOW);
+    pool.Submit(new RecordTask(cs, order, 2), wxTHREAD_POOL_PRIORITY_NORMAL);
+    wxThreadPoolFuture last =
+        pool.Submit(new RecordTask(cs, order, 1), wxTHREAD_POOL_PRIORITY_HIGH);
+    CHECK( pool.GetPendingCount() == 3 );
+
+    release.Post();
+
+    // Wait for the task submitted last but executed first and then the
+    // others by submitting another low priority one.
+    last.Wait();
+    pool.Submit(new RecordTask(cs, order, 4), wxTHREAD_POOL_PRIORITY_LOW).Wait();
+
+    wxCriticalSectionLocker lock(cs);
+    REQUIRE( order.size() == 4 );
+    CHECK( order[0] == 1 );
+    CHECK( order[1] == 2 );
+    CHECK( order[2] == 3 );
+    CHECK( order[3] == 4 );
+}
+
+TEST_CASE("wxThreadPool::Nested", "[threadpool]")
+{
+    // Use fewer threads than the number of tasks waiting for the other ones
+    // to check that this doesn't deadlock.
+    wxThreadPool pool(2);
+
+    wxAtomicInt counter(0);
+    pool.Submit(new NestedTask(pool, counter, 3)).Wait();
+
+    // 1 + 4 + 16 + 64 tasks.
+    CHECK( counter == 85 );
+}
+
+TEST_CASE("wxThreadPool::ParallelFor", "[threadpool]")
+{
+    wxThreadPool pool(4);
+
+    wxVector<int> items(1000, 0);
+    const IncRangeFunctor inc(items);
+
+    SECTION("Default")
+    {
+        pool.ParallelForFunctor(0, 1000, inc);
+    }
+
+    SECTION("Chunks")
+    {
+        pool.ParallelForFunctor(0, 1000, inc, 37);
+    }
+
+    SECTION("Single thread")
+    {
+        pool.ParallelForFunctor(0, 1000, inc, 10, 1);
+    }
+
+    SECTION("Huge chunk")
+    {
+        pool.ParallelForFunctor(0, 1000, inc, 100000);
+    }
+
+    for ( int n = 0; n < 1000; n++ )
+    {
+        INFO("Item " << n);
+        CHECK( items[n] == 1 );
+    }
+
+    // Empty range must be handled too.
+    pool.ParallelForFunctor(10, 10, inc);
+    CHECK( items[10] == 1 );
+}
+
+TEST_CASE("wxThreadPool::CallAfter", "[threadpool]")
+{
+    wxThreadPool pool(1);
+
+    wxEvtHandler handler;
+
+    bool called = false;
+    int result = 0;
+    wxThreadPoolFuture future = pool.SubmitFunctor(SquareFunctor(3, &result));
+    future.CallAfter(&handler, SetFlagFunctor(&called));
+    future.Wait();
+
+    CHECK( result == 9 );
+    CHECK( !called );
+
+    handler.ProcessPendingEvents();
+    CHECK( called );
+
+    // Completion callback added after the task finishes is still called.
+    called = false;
+    future.CallAfter(&handler, SetFlagFunctor(&called));
+    CHECK( !called );
+    handler.ProcessPendingEvents();
+    CHECK( called );
+}
+
+#endif // wxUSE_THREADS
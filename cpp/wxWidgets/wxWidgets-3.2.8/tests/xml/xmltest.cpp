@@ -18,6 +18,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/xml/xml.h"
+#include "wx/mstream.h"
 #include "wx/scopedptr.h"
 #include "wx/sstream.h"
 
@@ -610,3 +611,200 @@ void XmlTestCase::Doctype()
     dt = wxXmlDoctype( "root", "O'Reilly (\"editor\")", "Public-ID" );
     CPPUNIT_ASSERT( !dt.IsValid() );
 }
+
+namespace
+{
+
+const char *xmlTextReader =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"<!-- Prolog comment -->\n"
+"<?xml-stylesheet href=\"style.css\" type=\"text/css\"?>\n"
+"<resource xmlns=\"http://www.wxwidgets.org/wxxrc\" version=\"2.3.0.1\">\n"
+"  <!-- Test comment -->\n"
+"  <object class=\"wxDialog\" name=\"my_dialog\">\n"
+"    <title>Hello &amp; goodbye</title>\n"
+"    <children>\n"
+"      <grandchild id=\"1\"/>\n"
+"      <grandchild id=\"2\"><![CDATA[<data>]]></grandchild>\n"
+"    </children>\n"
+"    <subobject/>\n"
+"  </object>\n"
+"</resource>\n"
+"<!-- Trailing comment -->\n"
+    ;
+
+} // anonymous namespace
+
+TEST_CASE("wxXmlReader", "[xml]")
+{
+    wxStringInputStream sis(xmlTextReader);
+    wxXmlReader reader(sis);
+
+    CHECK( reader.GetEvent() == wxXmlReader::Event_None );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_Comment );
+    CHECK( reader.GetText() == " Prolog comment " );
+    CHECK( reader.GetDepth() == 0 );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_PI );
+    CHECK( reader.GetName() == "xml-stylesheet" );
+    CHECK( reader.GetText() == "href=\"style.css\" type=\"text/css\"" );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_StartElement );
+    CHECK( reader.GetName() == "resource" );
+    CHECK( reader.GetLineNumber() == 4 );
+    REQUIRE( reader.GetAttributeCount() == 2 );
+    CHECK( reader.GetAttributeName(0) == "xmlns" );
+    CHECK( reader.GetAttributeValue(1) == "2.3.0.1" );
+    CHECK( reader.GetAttribute("version") == "2.3.0.1" );
+    CHECK( !reader.HasAttribute("class") );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_Comment );
+    CHECK( reader.GetDepth() == 1 );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_StartElement );
+    CHECK( reader.GetName() == "object" );
+    CHECK( reader.GetAttribute("name") == "my_dialog" );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_StartElement );
+    CHECK( reader.GetName() == "title" );
+    CHECK( reader.GetDepth() == 2 );
+
+    // Text split by the entity is returned as a single item.
+    REQUIRE( reader.Next() == wxXmlReader::Event_Text );
+    CHECK( reader.GetText() == "Hello & goodbye" );
+    CHECK( wxString(reader.GetTextUTF8()) == "Hello & goodbye" );
+    CHECK( reader.GetDepth() == 3 );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_EndElement );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_StartElement );
+    CHECK( reader.GetName() == "children" );
+
+    wxScopedPtr<wxXmlNode> node(reader.ReadNode());
+    REQUIRE( node );
+    CHECK( reader.GetEvent() == wxXmlReader::Event_EndElement );
+    CHECK( node->GetName() == "children" );
+
+    wxXmlNode* child = node->GetChildren();
+    REQUIRE( child );
+    CHECK( child->GetAttribute("id") == "1" );
+    child = child->GetNext();
+    REQUIRE( child );
+    CHECK( child->GetAttribute("id") == "2" );
+    REQUIRE( child->GetChildren() );
+    CHECK( child->GetChildren()->GetType() == wxXML_CDATA_SECTION_NODE );
+    CHECK( child->GetNodeContent() == "<data>" );
+    CHECK( !child->GetNext() );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_StartElement );
+    CHECK( reader.GetName() == "subobject" );
+    CHECK( reader.SkipElement() );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_EndElement );
+    CHECK( reader.GetDepth() == 1 );
+    REQUIRE( reader.Next() == wxXmlReader::Event_EndElement );
+    CHECK( reader.GetDepth() == 0 );
+
+    REQUIRE( reader.Next() == wxXmlReader::Event_Comment );
+    CHECK( reader.GetText() == " Trailing comment " );
+
+    CHECK( reader.Next() == wxXmlReader::Event_None );
+    CHECK( reader.IsOk() );
+
+    // Check that errors are detected too.
+    wxStringInputStream sisBad("<root><unclosed></root>");
+    wxXmlReader readerBad(sisBad);
+
+    wxLogNull noLog;
+    while ( readerBad.Next() != wxXmlReader::Event_None )
+        ;
+    CHECK( !readerBad.IsOk() );
+}
+
+TEST_CASE("wxXmlArenaDocument", "[xml]")
+{
+    wxStringInputStream sis(xmlTextReader);
+    wxXmlArenaDocument arena;
+    REQUIRE( arena.Load(sis) );
+
+    wxXmlArenaNode root = arena.GetRoot();
+    REQUIRE( root.IsOk() );
+    CHECK( root.GetName() == "resource" );
+    CHECK( root.GetAttribute("version") == "2.3.0.1" );
+    CHECK( root.GetParent() == arena.GetDocumentNode() );
+
+    wxXmlArenaNode object = root.GetChildren().GetNext();
+    REQUIRE( object.IsOk() );
+    CHECK( object.GetName() == "object" );
+    CHECK( object.GetLineNumber() == 6 );
+
+    wxXmlArenaNode title = object.GetChildren();
+    CHECK( title.GetNodeContent() == "Hello & goodbye" );
+    CHECK( wxString(title.GetChildren().GetContentUTF8()) == "Hello & goodbye" );
+
+    // Names are shared between all the nodes.
+    wxXmlArenaNode grandchild = title.GetNext().GetChildren();
+    CHECK( &grandchild.GetName() == &grandchild.GetNext().GetName() );
+
+    // Converting the document to wxXmlDocument must give the same result as
+    // loading it directly.
+    wxXmlDocument doc;
+    doc.SetDocumentNode(arena.GetDocumentNode().ToXmlNode());
+
+    wxStringOutputStream sosArena;
+    REQUIRE( doc.Save(sosArena) );
+
+    wxStringInputStream sis2(xmlTextReader);
+    REQUIRE( doc.Load(sis2) );
+
+    wxStringOutputStream sos;
+    REQUIRE( doc.Save(sos) );
+
+    CHECK( sosArena.GetString() == sos.GetString() );
+
+    wxStringInputStream sisBad("<root><unclosed></root>");
+    wxLogNull noLog;
+    CHECK( !arena.Load(sisBad) );
+    CHECK( arena.IsOk() );
+}
+
+TEST_CASE("wxXmlDocument::SaveBinary", "[xml]")
+{
+    wxStringInputStream sis(xmlTextReader);
+    wxXmlDocument doc;
+    REQUIRE( doc.Load(sis) );
+    doc.SetDoctype(wxXmlDoctype("resource", "resource.dtd"));
+    doc.GetRoot()->AddAttribute("text", wxString::FromUTF8("\xd0\x9f\xd1\x80\xd0\xb8"));
+
+    wxMemoryOutputStream mos;
+    REQUIRE( doc.SaveBinary(mos) );
+
+    // The binary document is recognized by Load() automatically.
+    wxMemoryInputStream mis(mos);
+    wxXmlDocument docBinary;
+    REQUIRE( docBinary.Load(mis) );
+
+    CHECK( docBinary.GetDoctype().GetFullString() ==
+            doc.GetDoctype().GetFullString() );
+    CHECK( docBinary.GetRoot()->GetLineNumber() == 4 );
+    CHECK( docBinary.GetRoot()->GetAttribute("text") ==
+            doc.GetRoot()->GetAttribute("text") );
+
+    wxStringOutputStream sos, sosBinary;
+    REQUIRE( doc.Save(sos) );
+    REQUIRE( docBinary.Save(sosBinary) );
+    CHECK( sosBinary.GetString() == sos.GetString() );
+
+    // Truncated binary documents must be rejected.
+    wxMemoryInputStream misBad(mos.GetOutputStreamBuffer()->GetBufferStart(),
+                               mos.GetSize() - 10);
+    wxLogNull noLog;
+    CHECK( !docBinary.Load(misBad) );
+
+    // And documents shorter than the signature are still parsed as XML.
+    wxStringInputStream sisShort("<a/>");
+    REQUIRE( docBinary.Load(sisShort) );
+    CHECK( docBinary.GetRoot()->GetName() == "a" );
+}
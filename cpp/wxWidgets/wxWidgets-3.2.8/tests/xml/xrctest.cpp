@@ -19,6 +19,8 @@
 
 #if wxUSE_XRC
 
+#include "wx/dir.h"
+#include "wx/filename.h"
 #include "wx/fs_inet.h"
 #include "wx/imagxpm.h"
 #include "wx/xml/xml.h"
@@ -300,6 +302,102 @@ TEST_CASE("XRC::EnvVarInPath", "[xrc]")
     CHECK( impl->GetBitmapBundle().IsOk() );
 }
 
+// Write a file used by the test below with the given class of the second
+// top-level object called "panel".
+static void WriteCachedXrc(const wxString& filename, const char* cls)
+{
+    wxFFile ff;
+    REQUIRE( ff.Open(filename, "w") );
+    REQUIRE( ff.Write(wxString::Format(
+        "<?xml version=\"1.0\" ?>"
+        "<resource>"
+        "  <object class=\"wxPanel\" name=\"panel\"/>"
+        "  <object class=\"wxDialog\" name=\"dialog\">"
+        "    <object class=\"wxPanel\" name=\"nested\"/>"
+        "  </object>"
+        "  <object class=\"%s\" name=\"panel\"/>"
+        "</resource>",
+        cls)) );
+    REQUIRE( ff.Close() );
+}
+
+// Derive from wxXmlResource to be able to use its FindResource().
+class CacheTestResource : public wxXmlResource
+{
+public:
+    explicit CacheTestResource(const wxString& cacheDir)
+        : wxXmlResource(wxXRC_NO_RELOADING)
+    {
+        SetCacheDir(cacheDir);
+    }
+
+    wxXmlNode* Find(const wxString& name, const wxString& classname)
+    {
+        return FindResource(name, classname);
+    }
+};
+
+TEST_CASE("XRC::CacheDir", "[xrc]")
+{
+    const wxString filename = "cached.xrc";
+    TempFile xrcFile(filename);
+
+    const wxString cacheDir = wxFileName(wxFileName::GetTempDir(),
+                                         "wxtest_xrc_cache").GetFullPath();
+    wxFileName::Rmdir(cacheDir, wxPATH_RMDIR_RECURSIVE);
+
+    WriteCachedXrc(filename, "wxFrame");
+
+    wxDateTime modTime;
+    REQUIRE( wxFileName(filename).GetTimes(NULL, &modTime, NULL) );
+
+    {
+        CacheTestResource res(cacheDir);
+        REQUIRE( res.Load(filename) );
+
+        wxArrayString files;
+        CHECK( wxDir::GetAllFiles(cacheDir, &files) == 1 );
+
+        // Check that the top-level resources are found in the right order.
+        wxXmlNode* node = res.Find("panel", "");
+        REQUIRE( node );
+        CHECK( node->GetAttribute("class") == "wxPanel" );
+
+        node = res.Find("panel", "wxFrame");
+        REQUIRE( node );
+        CHECK( node->GetAttribute("class") == "wxFrame" );
+
+        // Nested resources are only found when searching recursively.
+        CHECK( res.GetResourceNode("nested") );
+
+        wxLogNull noLog;
+        CHECK( !res.Find("nested", "wxPanel") );
+    }
+
+    // Change the file but keep its modification time to check that the
+    // cached contents is used.
+    WriteCachedXrc(filename, "wxMDIParentFrame");
+    REQUIRE( wxFileName(filename).SetTimes(NULL, &modTime, NULL) );
+
+    {
+        CacheTestResource res(cacheDir);
+        REQUIRE( res.Load(filename) );
+        CHECK( res.Find("panel", "wxFrame") );
+    }
+
+    // But not any more if the modification time changes too.
+    const wxDateTime newModTime = modTime + wxTimeSpan::Hour();
+    REQUIRE( wxFileName(filename).SetTimes(NULL, &newModTime, NULL) );
+
+    {
+        CacheTestResource res(cacheDir);
+        REQUIRE( res.Load(filename) );
+        CHECK( res.Find("panel", "wxMDIParentFrame") );
+    }
+
+    wxFileName::Rmdir(cacheDir, wxPATH_RMDIR_RECURSIVE);
+}
+
 // This test is disabled by default as it requires the environment variable
 // below to be defined to point to a HTTP URL with the file to load.
 //
@@ -241,7 +241,7 @@ private:
 
     bool Validate();
 
-    bool flagVerbose, flagCPP, flagPython, flagGettext, flagValidate, flagValidateOnly;
+    bool flagVerbose, flagCPP, flagPython, flagGettext, flagValidate, flagValidateOnly, flagBinary;
     wxString parOutput, parFuncname, parOutputPath, parSchemaFile;
     wxArrayString parFiles;
     int retCode;
@@ -263,6 +263,7 @@ int XmlResApp::OnRun()
         { wxCMD_LINE_SWITCH, "c", "cpp-code",  "output C++ source rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "p", "python-code",  "output wxPython source rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "g", "gettext",  "output list of translatable strings (to stdout or file if -o used)" },
+        { wxCMD_LINE_SWITCH, "b", "binary",  "store resources in binary form which is faster to load" },
         { wxCMD_LINE_OPTION, "n", "function",  "C++/Python function name (with -c or -p) [InitXmlResource]" },
         { wxCMD_LINE_OPTION, "o", "output",  "output file [resource.xrs/cpp]" },
         { wxCMD_LINE_SWITCH, "",  "validate", "check XRC correctness (in addition to other processing)" },
@@ -315,6 +316,7 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
     flagVerbose = cmdline.Found("v");
     flagCPP = cmdline.Found("c");
     flagPython = cmdline.Found("p");
+    flagBinary = cmdline.Found("b");
     flagH = flagCPP && cmdline.Found("e");
     flagValidateOnly = cmdline.Found("validate-only");
     flagValidate = flagValidateOnly || cmdline.Found("validate");
@@ -450,7 +452,10 @@ wxArrayString XmlResApp::PrepareTempFiles()
         }
         wxString internalName = GetInternalFileName(parFiles[i], flist);
 
-        doc.Save(parOutputPath + wxFILE_SEP_PATH + internalName);
+        if (flagBinary)
+            doc.SaveBinary(parOutputPath + wxFILE_SEP_PATH + internalName);
+        else
+            doc.Save(parOutputPath + wxFILE_SEP_PATH + internalName);
         flist.Add(internalName);
     }
 
@@ -777,7 +782,7 @@ void XmlResApp::GenCPPHeader()
                 + "();\n#endif\n");
 }
 
-static wxString FileToPythonArray(wxString filename, int num)
+static wxString FileToPythonArray(wxString filename, int num, bool binary)
 {
     wxString output;
     wxString tmp;
@@ -791,7 +796,10 @@ static wxString FileToPythonArray(wxString filename, int num)
                   wxT("Huge file not supported") );
 
     snum.Printf(wxT("%i"), num);
-    output = "    xml_res_file_" + snum + " = '''\\\n";
+    // Binary data must be stored as bytes and not as a string: otherwise the
+    // non-ASCII characters would be UTF-8-encoded when adding it to the
+    // memory file system.
+    output = "    xml_res_file_" + snum + " = " + (binary ? "b" : "") + "'''\\\n";
 
     unsigned char *buffer = new unsigned char[lng];
     file.Read(buffer, lng);
@@ -848,7 +856,8 @@ void XmlResApp::MakePackagePython(const wxArrayString& flist)
 
     for (i = 0; i < flist.GetCount(); i++)
         file.Write(
-          FileToPythonArray(parOutputPath + wxFILE_SEP_PATH + flist[i], i));
+          FileToPythonArray(parOutputPath + wxFILE_SEP_PATH + flist[i], i,
+                            flagBinary));
 
     file.Write(
         "    # check if the memory filesystem handler has been loaded yet, and load it if not\n"